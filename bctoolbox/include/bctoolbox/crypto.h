@@ -48,6 +48,10 @@
 #define BCTBX_EDDSA_25519 1
 #define BCTBX_EDDSA_448 2
 
+/* Self-signed certificate key types */
+#define BCTBX_CERTIFICATE_KEY_RSA_3072 0
+#define BCTBX_CERTIFICATE_KEY_ECDSA_P256 1
+
 #define BCTBX_VERIFY_SUCCESS 0
 #define BCTBX_VERIFY_FAILED -1
 
@@ -494,6 +498,28 @@ BCTBX_PUBLIC int32_t bctbx_x509_certificate_generate_selfsigned(const char *subj
                                                                 char *pem,
                                                                 size_t pem_length);
 
+/**
+ * @brief Generate a self-signed certificate using the given key type
+ *
+ * An ECDSA P-256 key is generated in a few milliseconds where a RSA 3072 bits one may take hundreds of them.
+ *
+ * @param[in]		subject		The certificate subject
+ * @param[in]		key_type	BCTBX_CERTIFICATE_KEY_RSA_3072 or BCTBX_CERTIFICATE_KEY_ECDSA_P256
+ * @param[in/out]	certificate	An empty intialised certificate pointer to hold the generated certificate
+ * @param[in/out]	pkey		An empty initialised signing key pointer to hold the key generated and used to sign the
+ * certificate
+ * @param[out]		pem		If not null, a buffer to hold a PEM string of the certificate and key
+ * @param[in]		pem_length	pem buffer length
+ *
+ * @return 0 on success, negative error code otherwise
+ */
+BCTBX_PUBLIC int32_t bctbx_x509_certificate_generate_selfsigned_with_key_type(const char *subject,
+                                                                             uint8_t key_type,
+                                                                             bctbx_x509_certificate_t *certificate,
+                                                                             bctbx_signing_key_t *pkey,
+                                                                             char *pem,
+                                                                             size_t pem_length);
+
 /**
  * @brief Convert underlying crypto library certificate flags into a printable string
  *
@@ -571,6 +597,42 @@ BCTBX_PUBLIC const char *bctbx_ssl_get_ciphersuite(bctbx_ssl_context_t *ssl_ctx)
 BCTBX_PUBLIC int bctbx_ssl_get_ciphersuite_id(const char *ciphersuite);
 BCTBX_PUBLIC const char *bctbx_ssl_get_version(bctbx_ssl_context_t *ssl_ctx);
 
+/***** Session resumption *****/
+typedef struct bctbx_ssl_session_struct bctbx_ssl_session_t;
+BCTBX_PUBLIC bctbx_ssl_session_t *bctbx_ssl_session_new(void);
+BCTBX_PUBLIC void bctbx_ssl_session_free(bctbx_ssl_session_t *session);
+
+/**
+ * @brief Save the session negotiated on a client context so that a later connection to the same server can resume it
+ * With TLS 1.3 the session becomes resumable only once the server's session ticket has been received, that is after
+ * some application data was read on the connection.
+ *
+ * @param[in]	ssl_ctx		A client context which completed its handshake
+ * @param[out]	session		Holds the saved session, any previously saved one is replaced
+ *
+ * @return 0 on success, negative error code if no resumable session is available yet
+ */
+BCTBX_PUBLIC int32_t bctbx_ssl_get_session(bctbx_ssl_context_t *ssl_ctx, bctbx_ssl_session_t *session);
+
+/**
+ * @brief Offer a previously saved session to the server during the next handshake of a client context
+ * If the server does not accept it, a full handshake is performed.
+ *
+ * @param[in/out]	ssl_ctx		A client context, set up but whose handshake has not started yet
+ * @param[in]		session		A session saved with bctbx_ssl_get_session()
+ *
+ * @return 0 on success, negative error code otherwise
+ */
+BCTBX_PUBLIC int32_t bctbx_ssl_set_session(bctbx_ssl_context_t *ssl_ctx, const bctbx_ssl_session_t *session);
+
+/**
+ * @brief Tell if the handshake of a client context resumed the session given to bctbx_ssl_set_session()
+ * With mbedTLS only the resumption of TLS 1.2 sessions is reported.
+ *
+ * @return 1 if the session was resumed, 0 otherwise
+ */
+BCTBX_PUBLIC int bctbx_ssl_session_reused(bctbx_ssl_context_t *ssl_ctx);
+
 BCTBX_PUBLIC bctbx_ssl_config_t *bctbx_ssl_config_new(void);
 BCTBX_PUBLIC int32_t bctbx_ssl_config_set_crypto_library_config(bctbx_ssl_config_t *ssl_config, void *internal_config);
 BCTBX_PUBLIC void bctbx_ssl_config_free(bctbx_ssl_config_t *ssl_config);
@@ -599,6 +661,21 @@ BCTBX_PUBLIC int32_t bctbx_ssl_config_set_ciphersuites(bctbx_ssl_config_t *ssl_c
  */
 BCTBX_PUBLIC int32_t bctbx_ssl_config_set_groups(bctbx_ssl_config_t *ssl_config, const bctbx_list_t *groups);
 
+/**
+ * @brief Enable or disable session tickets (RFC 5077 and TLS 1.3 NewSessionTicket)
+ * On a client configuration, tickets issued by the server are accepted and may be saved using bctbx_ssl_get_session().
+ * On a server configuration, tickets are issued to the clients, their encryption key being generated and rotated by
+ * the configuration itself: with mbedTLS the random number generator must be set beforehand using
+ * bctbx_ssl_config_set_rng().
+ * Tickets are disabled by default with mbedTLS, OpenSSL servers issue them by default.
+ *
+ * @param[in/out]	ssl_config	The configuration, endpoint must already be set
+ * @param[in]		enable		0 to disable session tickets, enable them otherwise
+ *
+ * @return 0 on success, negative error code otherwise
+ */
+BCTBX_PUBLIC int32_t bctbx_ssl_config_set_session_tickets(bctbx_ssl_config_t *ssl_config, int enable);
+
 /***** DTLS-SRTP functions *****/
 BCTBX_PUBLIC bctbx_dtls_srtp_profile_t bctbx_ssl_get_dtls_srtp_protection_profile(bctbx_ssl_context_t *ssl_ctx);
 BCTBX_PUBLIC int32_t bctbx_ssl_config_set_dtls_srtp_protection_profiles(bctbx_ssl_config_t *ssl_config,
@@ -455,7 +455,7 @@ typedef struct _BctoolboxMemoryFunctions {
 	void (*free_fun)(void *ptr);
 } BctoolboxMemoryFunctions;
 
-void bctbx_set_memory_functions(BctoolboxMemoryFunctions *functions);
+BCTBX_PUBLIC void bctbx_set_memory_functions(BctoolboxMemoryFunctions *functions);
 
 #define bctbx_new(type, count) (type *)bctbx_malloc(sizeof(type) * (count))
 #define bctbx_new0(type, count) (type *)bctbx_malloc0(sizeof(type) * (count))
@@ -26,6 +26,7 @@
 
 #include <mbedtls/base64.h>
 #include <mbedtls/ctr_drbg.h>
+#include <mbedtls/ecp.h>
 #include <mbedtls/entropy.h>
 #include <mbedtls/error.h>
 #include <mbedtls/gcm.h>
@@ -37,6 +38,7 @@
 #include <mbedtls/sha256.h>
 #include <mbedtls/sha512.h>
 #include <mbedtls/ssl.h>
+#include <mbedtls/ssl_ticket.h>
 #include <mbedtls/timing.h>
 #include <mbedtls/x509.h>
 
@@ -302,6 +304,16 @@ int32_t bctbx_x509_certificate_generate_selfsigned(const char *subject,
                                                    bctbx_signing_key_t *pkey,
                                                    char *pem,
                                                    size_t pem_length) {
+	return bctbx_x509_certificate_generate_selfsigned_with_key_type(subject, BCTBX_CERTIFICATE_KEY_RSA_3072, certificate,
+	                                                                pkey, pem, pem_length);
+}
+
+int32_t bctbx_x509_certificate_generate_selfsigned_with_key_type(const char *subject,
+                                                                uint8_t key_type,
+                                                                bctbx_x509_certificate_t *certificate,
+                                                                bctbx_signing_key_t *pkey,
+                                                                char *pem,
+                                                                size_t pem_length) {
 	mbedtls_entropy_context entropy;
 	mbedtls_ctr_drbg_context ctr_drbg;
 	int ret;
@@ -322,15 +334,32 @@ int32_t bctbx_x509_certificate_generate_selfsigned(const char *subject,
 		return BCTBX_ERROR_CERTIFICATE_GENERATION_FAIL;
 	}
 
-	/* generate 3072 bits RSA public/private key */
-	if ((ret = mbedtls_pk_setup((mbedtls_pk_context *)pkey, mbedtls_pk_info_from_type(MBEDTLS_PK_RSA))) != 0) {
-		bctbx_error("Certificate generation can't init pk_ctx: [-0x%x]", -ret);
-		return BCTBX_ERROR_CERTIFICATE_GENERATION_FAIL;
-	}
+	if (key_type == BCTBX_CERTIFICATE_KEY_ECDSA_P256) {
+		/* generate ECDSA public/private key on curve P-256 */
+		if ((ret = mbedtls_pk_setup((mbedtls_pk_context *)pkey, mbedtls_pk_info_from_type(MBEDTLS_PK_ECKEY))) != 0) {
+			bctbx_error("Certificate generation can't init pk_ctx: [-0x%x]", -ret);
+			return BCTBX_ERROR_CERTIFICATE_GENERATION_FAIL;
+		}
+
+		if ((ret = mbedtls_ecp_gen_key(MBEDTLS_ECP_DP_SECP256R1, mbedtls_pk_ec(*(mbedtls_pk_context *)pkey),
+		                               mbedtls_ctr_drbg_random, &ctr_drbg)) != 0) {
+			bctbx_error("Certificate generation can't generate ecdsa key: [-0x%x]", -ret);
+			return BCTBX_ERROR_CERTIFICATE_GENERATION_FAIL;
+		}
+	} else if (key_type == BCTBX_CERTIFICATE_KEY_RSA_3072) {
+		/* generate 3072 bits RSA public/private key */
+		if ((ret = mbedtls_pk_setup((mbedtls_pk_context *)pkey, mbedtls_pk_info_from_type(MBEDTLS_PK_RSA))) != 0) {
+			bctbx_error("Certificate generation can't init pk_ctx: [-0x%x]", -ret);
+			return BCTBX_ERROR_CERTIFICATE_GENERATION_FAIL;
+		}
 
-	if ((ret = mbedtls_rsa_gen_key(mbedtls_pk_rsa(*(mbedtls_pk_context *)pkey), mbedtls_ctr_drbg_random, &ctr_drbg,
-	                               3072, 65537)) != 0) {
-		bctbx_error("Certificate generation can't generate rsa key: [-0x%x]", -ret);
+		if ((ret = mbedtls_rsa_gen_key(mbedtls_pk_rsa(*(mbedtls_pk_context *)pkey), mbedtls_ctr_drbg_random,
+		                               &ctr_drbg, 3072, 65537)) != 0) {
+			bctbx_error("Certificate generation can't generate rsa key: [-0x%x]", -ret);
+			return BCTBX_ERROR_CERTIFICATE_GENERATION_FAIL;
+		}
+	} else {
+		bctbx_error("Certificate generation: unknown key type %d", key_type);
 		return BCTBX_ERROR_CERTIFICATE_GENERATION_FAIL;
 	}
 
@@ -885,6 +914,10 @@ struct bctbx_ssl_context_struct {
 	bctbx_dtls_srtp_keys_t dtls_srtp_keys; /**< Key material is stored during the handshake there and used after
 	                                          completion to generate the DTLS-SRTP shared secret */
 #endif
+#if defined(MBEDTLS_SSL_PROTO_TLS1_2)
+	uint8_t offered_session;       /**< a session was given to bctbx_ssl_set_session() */
+	uint8_t offered_master[48];    /**< master secret of that session, it is kept when the session is resumed */
+#endif
 };
 
 bctbx_ssl_context_t *bctbx_ssl_context_new(void) {
@@ -906,6 +939,9 @@ void bctbx_ssl_context_free(bctbx_ssl_context_t *ssl_ctx) {
 	bctbx_clean(ssl_ctx->dtls_srtp_keys.master_secret, sizeof(ssl_ctx->dtls_srtp_keys.master_secret));
 	bctbx_clean(ssl_ctx->dtls_srtp_keys.randoms, sizeof(ssl_ctx->dtls_srtp_keys.randoms));
 #endif /* HAVE_DTLS_SRTP */
+#if defined(MBEDTLS_SSL_PROTO_TLS1_2)
+	bctbx_clean(ssl_ctx->offered_master, sizeof(ssl_ctx->offered_master));
+#endif
 
 	bctbx_free(ssl_ctx);
 }
@@ -915,6 +951,9 @@ int32_t bctbx_ssl_close_notify(bctbx_ssl_context_t *ssl_ctx) {
 }
 
 int32_t bctbx_ssl_session_reset(bctbx_ssl_context_t *ssl_ctx) {
+#if defined(MBEDTLS_SSL_PROTO_TLS1_2)
+	ssl_ctx->offered_session = 0;
+#endif
 	return mbedtls_ssl_session_reset(&(ssl_ctx->ssl_ctx));
 }
 
@@ -1055,6 +1094,80 @@ int32_t bctbx_ssl_set_hostname(bctbx_ssl_context_t *ssl_ctx, const char *hostnam
 	return mbedtls_ssl_set_hostname(&(ssl_ctx->ssl_ctx), hostname);
 }
 
+/** session resumption **/
+struct bctbx_ssl_session_struct {
+	mbedtls_ssl_session session;
+	uint8_t is_set; /**< session holds a session saved from a connection */
+};
+
+bctbx_ssl_session_t *bctbx_ssl_session_new(void) {
+	bctbx_ssl_session_t *session = bctbx_malloc0(sizeof(bctbx_ssl_session_t));
+	mbedtls_ssl_session_init(&(session->session));
+	return session;
+}
+
+void bctbx_ssl_session_free(bctbx_ssl_session_t *session) {
+	if (session == NULL) return;
+	mbedtls_ssl_session_free(&(session->session));
+	bctbx_free(session);
+}
+
+int32_t bctbx_ssl_get_session(bctbx_ssl_context_t *ssl_ctx, bctbx_ssl_session_t *session) {
+	mbedtls_ssl_session saved_session;
+	int ret;
+	if (ssl_ctx == NULL) {
+		return BCTBX_ERROR_INVALID_SSL_CONTEXT;
+	}
+	if (session == NULL) {
+		return BCTBX_ERROR_INVALID_INPUT_DATA;
+	}
+	/* copy in a temporary session so that the previously saved one is kept on failure, which is always the case with
+	 * TLS 1.3 until a ticket is received */
+	mbedtls_ssl_session_init(&saved_session);
+	ret = mbedtls_ssl_get_session(&(ssl_ctx->ssl_ctx), &saved_session);
+	if (ret != 0) {
+		mbedtls_ssl_session_free(&saved_session);
+		return ret;
+	}
+	mbedtls_ssl_session_free(&(session->session));
+	memcpy(&(session->session), &saved_session, sizeof(mbedtls_ssl_session));
+	session->is_set = 1;
+	return 0;
+}
+
+int32_t bctbx_ssl_set_session(bctbx_ssl_context_t *ssl_ctx, const bctbx_ssl_session_t *session) {
+	int ret;
+	if (ssl_ctx == NULL) {
+		return BCTBX_ERROR_INVALID_SSL_CONTEXT;
+	}
+	if (session == NULL || session->is_set == 0) {
+		return BCTBX_ERROR_INVALID_INPUT_DATA;
+	}
+	ret = mbedtls_ssl_set_session(&(ssl_ctx->ssl_ctx), &(session->session));
+#if defined(MBEDTLS_SSL_PROTO_TLS1_2)
+	if (ret == 0) {
+		ssl_ctx->offered_session = 1;
+		memcpy(ssl_ctx->offered_master, session->session.MBEDTLS_PRIVATE(master), sizeof(ssl_ctx->offered_master));
+	}
+#endif
+	return ret;
+}
+
+int bctbx_ssl_session_reused(bctbx_ssl_context_t *ssl_ctx) {
+#if defined(MBEDTLS_SSL_PROTO_TLS1_2)
+	/* mbedtls does not tell whether the handshake was abbreviated: a resumed TLS 1.2 session keeps its master secret
+	 * where a full handshake derives a new one */
+	const mbedtls_ssl_session *session;
+	if (ssl_ctx == NULL || ssl_ctx->offered_session == 0) return 0;
+	if (mbedtls_ssl_get_version_number(&(ssl_ctx->ssl_ctx)) != MBEDTLS_SSL_VERSION_TLS1_2) return 0;
+	session = ssl_ctx->ssl_ctx.MBEDTLS_PRIVATE(session);
+	if (session == NULL) return 0;
+	return memcmp(session->MBEDTLS_PRIVATE(master), ssl_ctx->offered_master, sizeof(ssl_ctx->offered_master)) == 0;
+#else
+	return 0;
+#endif
+}
+
 /** DTLS SRTP functions **/
 #ifdef HAVE_DTLS_SRTP
 uint8_t bctbx_dtls_srtp_supported(void) {
@@ -1144,6 +1257,11 @@ struct bctbx_ssl_config_struct {
 	                                      list termination) */
 #endif                                 /* HAVE_DTLS_SRTP */
 	int *ciphersuites;                 /**< ciphersuites as mbedtls id's */
+	int (*rng_function)(void *, unsigned char *, size_t); /**< rng given to bctbx_ssl_config_set_rng() */
+	void *rng_context;                                    /**< and its context, used to generate the ticket keys */
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_context *ticket_ctx; /**< session ticket keys of a server config, NULL when tickets are off */
+#endif
 };
 
 bctbx_ssl_config_t *bctbx_ssl_config_new(void) {
@@ -1205,6 +1323,13 @@ void bctbx_ssl_config_free(bctbx_ssl_config_t *ssl_config) {
 		bctbx_free(ssl_config->ciphersuites);
 	}
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (ssl_config->ticket_ctx) {
+		mbedtls_ssl_ticket_free(ssl_config->ticket_ctx);
+		bctbx_free(ssl_config->ticket_ctx);
+	}
+#endif
+
 	bctbx_free(ssl_config);
 }
 
@@ -1365,6 +1490,8 @@ int32_t bctbx_ssl_config_set_rng(bctbx_ssl_config_t *ssl_config,
 	}
 
 	mbedtls_ssl_conf_rng(ssl_config->ssl_config, rng_function, rng_context);
+	ssl_config->rng_function = rng_function;
+	ssl_config->rng_context = rng_context;
 
 	return 0;
 }
@@ -1420,6 +1547,52 @@ int32_t bctbx_ssl_config_set_groups(BCTBX_UNUSED(bctbx_ssl_config_t *ssl_config)
 	return BCTBX_ERROR_UNAVAILABLE_FUNCTION;
 }
 
+/* Lifetime of the session tickets, which is also the rotation period of their encryption key */
+#define BCTBX_SSL_SESSION_TICKET_LIFETIME 86400
+
+int32_t bctbx_ssl_config_set_session_tickets(bctbx_ssl_config_t *ssl_config, int enable) {
+	if (ssl_config == NULL) {
+		return BCTBX_ERROR_INVALID_SSL_CONFIG;
+	}
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+	/* client side: send the session ticket extension and keep the tickets received */
+	mbedtls_ssl_conf_session_tickets(ssl_config->ssl_config, enable ? MBEDTLS_SSL_SESSION_TICKETS_ENABLED
+	                                                                : MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+#if defined(MBEDTLS_SSL_TICKET_C) && defined(MBEDTLS_SSL_SRV_C)
+	/* server side: tickets are issued as soon as the write and parse callbacks are set */
+	if (ssl_config->ssl_config->MBEDTLS_PRIVATE(endpoint) == MBEDTLS_SSL_IS_SERVER) {
+		if (enable && ssl_config->ticket_ctx == NULL) {
+			int ret;
+			if (ssl_config->rng_function == NULL) {
+				return BCTBX_ERROR_INVALID_SSL_CONFIG;
+			}
+			ssl_config->ticket_ctx = bctbx_malloc0(sizeof(mbedtls_ssl_ticket_context));
+			mbedtls_ssl_ticket_init(ssl_config->ticket_ctx);
+			ret = mbedtls_ssl_ticket_setup(ssl_config->ticket_ctx, ssl_config->rng_function, ssl_config->rng_context,
+			                               MBEDTLS_CIPHER_AES_256_GCM, BCTBX_SSL_SESSION_TICKET_LIFETIME);
+			if (ret != 0) {
+				mbedtls_ssl_ticket_free(ssl_config->ticket_ctx);
+				bctbx_free(ssl_config->ticket_ctx);
+				ssl_config->ticket_ctx = NULL;
+				return ret;
+			}
+			mbedtls_ssl_conf_session_tickets_cb(ssl_config->ssl_config, mbedtls_ssl_ticket_write,
+			                                    mbedtls_ssl_ticket_parse, ssl_config->ticket_ctx);
+		} else if (!enable && ssl_config->ticket_ctx != NULL) {
+			mbedtls_ssl_conf_session_tickets_cb(ssl_config->ssl_config, NULL, NULL, NULL);
+			mbedtls_ssl_ticket_free(ssl_config->ticket_ctx);
+			bctbx_free(ssl_config->ticket_ctx);
+			ssl_config->ticket_ctx = NULL;
+		}
+	}
+#endif /* MBEDTLS_SSL_TICKET_C && MBEDTLS_SSL_SRV_C */
+	return 0;
+#else
+	return enable ? BCTBX_ERROR_UNAVAILABLE_FUNCTION : 0;
+#endif /* MBEDTLS_SSL_SESSION_TICKETS */
+}
+
 /** DTLS SRTP functions **/
 #ifdef HAVE_DTLS_SRTP
 /* key derivation code */
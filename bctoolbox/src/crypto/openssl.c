@@ -435,11 +435,34 @@ int32_t bctbx_x509_certificate_generate_selfsigned(const char *subject,
                                                    bctbx_signing_key_t *pkey,
                                                    char *pem,
                                                    size_t pem_length) {
-	pkey->evp_pkey = EVP_RSA_gen(3072); // 'e' defaults to 65537
-	if (pkey->evp_pkey == NULL) {
-		bctbx_error("Couldn't generate an rsa key.");
+	return bctbx_x509_certificate_generate_selfsigned_with_key_type(subject, BCTBX_CERTIFICATE_KEY_RSA_3072, certificate,
+	                                                                pkey, pem, pem_length);
+}
+
+int32_t bctbx_x509_certificate_generate_selfsigned_with_key_type(const char *subject,
+                                                                uint8_t key_type,
+                                                                bctbx_x509_certificate_t *certificate,
+                                                                bctbx_signing_key_t *pkey,
+                                                                char *pem,
+                                                                size_t pem_length) {
+	EVP_PKEY *evp_pkey;
+	switch (key_type) {
+		case BCTBX_CERTIFICATE_KEY_RSA_3072:
+			evp_pkey = EVP_RSA_gen(3072); // 'e' defaults to 65537
+			break;
+		case BCTBX_CERTIFICATE_KEY_ECDSA_P256:
+			evp_pkey = EVP_EC_gen("P-256");
+			break;
+		default:
+			bctbx_error("Certificate generation: unknown key type %d", key_type);
+			return BCTBX_ERROR_CERTIFICATE_GENERATION_FAIL;
+	}
+	if (evp_pkey == NULL) {
+		bctbx_error("Couldn't generate a %s key.", key_type == BCTBX_CERTIFICATE_KEY_RSA_3072 ? "rsa" : "ecdsa");
 		return BCTBX_ERROR_CERTIFICATE_GENERATION_FAIL;
 	}
+	EVP_PKEY_free(pkey->evp_pkey);
+	pkey->evp_pkey = evp_pkey;
 	X509 *cert = X509_new();
 	generate_x509(cert, pkey->evp_pkey, subject);
 
@@ -450,24 +473,30 @@ int32_t bctbx_x509_certificate_generate_selfsigned(const char *subject,
 	char *self_signed_cert_pem = bctbx_x509_certificates_chain_get_pem((bctbx_x509_certificate_t *)certificate);
 	char *private_key_pem = bctbx_signing_key_get_pem((bctbx_signing_key_t *)pkey);
 
+	int32_t ret = 0;
 	if (self_signed_cert_pem == NULL || private_key_pem == NULL) {
 		bctbx_error("Couldn't write private key and/or certificate to pem format.");
-		return BCTBX_ERROR_CERTIFICATE_GENERATION_FAIL;
+		ret = BCTBX_ERROR_CERTIFICATE_GENERATION_FAIL;
+	} else if (pem != NULL) { /* if there is no pem pointer, don't save the key and certificate in pem format */
+		size_t pem_minimum_length = strlen(self_signed_cert_pem) + strlen(private_key_pem) + 1;
+
+		if (pem_length <= pem_minimum_length) {
+			bctbx_error(
+			    "Certificate generation can't copy the certificate to pem buffer: too short [%ld] but need [%ld] bytes",
+			    (long)pem_length, (long)pem_minimum_length);
+			ret = BCTBX_ERROR_OUTPUT_BUFFER_TOO_SMALL;
+		} else {
+			strncpy(pem, private_key_pem, pem_length);
+			strncat(pem, self_signed_cert_pem, pem_length);
+		}
 	}
 
-	size_t pem_minimum_length = strlen(self_signed_cert_pem) + strlen(private_key_pem) + 1;
-
-	if (pem_length <= pem_minimum_length) {
-		bctbx_error(
-		    "Certificate generation can't copy the certificate to pem buffer: too short [%ld] but need [%ld] bytes",
-		    (long)pem_length, (long)pem_minimum_length);
-		return BCTBX_ERROR_OUTPUT_BUFFER_TOO_SMALL;
+	if (self_signed_cert_pem != NULL) bctbx_free(self_signed_cert_pem);
+	if (private_key_pem != NULL) {
+		bctbx_clean(private_key_pem, strlen(private_key_pem));
+		bctbx_free(private_key_pem);
 	}
-
-	strncpy(pem, private_key_pem, pem_length);
-	strncat(pem, self_signed_cert_pem, pem_length);
-
-	return 0;
+	return ret;
 }
 
 static enum bctbx_md_type nid_to_bctbx_md_type(int nid) {
@@ -1132,6 +1161,59 @@ int32_t bctbx_ssl_set_hostname(bctbx_ssl_context_t *ssl_ctx, const char *hostnam
 	return SSL_set_tlsext_host_name(ssl_ctx->ssl, hostname) == 1 ? 0 : ERR_get_error();
 }
 
+/** session resumption **/
+struct bctbx_ssl_session_struct {
+	SSL_SESSION *session;
+};
+
+bctbx_ssl_session_t *bctbx_ssl_session_new(void) {
+	return bctbx_malloc0(sizeof(bctbx_ssl_session_t));
+}
+
+void bctbx_ssl_session_free(bctbx_ssl_session_t *session) {
+	if (session == NULL) return;
+	if (session->session) SSL_SESSION_free(session->session);
+	bctbx_free(session);
+}
+
+int32_t bctbx_ssl_get_session(bctbx_ssl_context_t *ssl_ctx, bctbx_ssl_session_t *session) {
+	SSL_SESSION *ssl_session;
+	if (ssl_ctx == NULL || ssl_ctx->ssl == NULL) {
+		return BCTBX_ERROR_INVALID_SSL_CONTEXT;
+	}
+	if (session == NULL) {
+		return BCTBX_ERROR_INVALID_INPUT_DATA;
+	}
+	/* With TLS 1.3 the session is replaced when a ticket is received, it is not resumable before */
+	ssl_session = SSL_get0_session(ssl_ctx->ssl);
+	if (ssl_session == NULL || !SSL_SESSION_is_resumable(ssl_session)) {
+		return BCTBX_ERROR_UNAVAILABLE_FUNCTION;
+	}
+	/* keep a copy: freeing a connection which was not shut down marks its session as not resumable */
+	ssl_session = SSL_SESSION_dup(ssl_session);
+	if (ssl_session == NULL) {
+		return BCTBX_ERROR_UNSPECIFIED_ERROR;
+	}
+	if (session->session) SSL_SESSION_free(session->session);
+	session->session = ssl_session;
+	return 0;
+}
+
+int32_t bctbx_ssl_set_session(bctbx_ssl_context_t *ssl_ctx, const bctbx_ssl_session_t *session) {
+	if (ssl_ctx == NULL || ssl_ctx->ssl == NULL) {
+		return BCTBX_ERROR_INVALID_SSL_CONTEXT;
+	}
+	if (session == NULL || session->session == NULL) {
+		return BCTBX_ERROR_INVALID_INPUT_DATA;
+	}
+	return SSL_set_session(ssl_ctx->ssl, session->session) == 1 ? 0 : BCTBX_ERROR_INVALID_INPUT_DATA;
+}
+
+int bctbx_ssl_session_reused(bctbx_ssl_context_t *ssl_ctx) {
+	if (ssl_ctx == NULL || ssl_ctx->ssl == NULL) return 0;
+	return SSL_session_reused(ssl_ctx->ssl) == 1;
+}
+
 /** DTLS SRTP functions **/
 uint8_t bctbx_dtls_srtp_supported(void) {
 	return 1;
@@ -1516,6 +1598,29 @@ int32_t bctbx_ssl_config_set_groups(bctbx_ssl_config_t *ssl_config, const bctbx_
 	return ret == 1 ? 0 : ERR_get_error();
 }
 
+int32_t bctbx_ssl_config_set_session_tickets(bctbx_ssl_config_t *ssl_config, int enable) {
+	static const unsigned char session_id_context[] = "bctoolbox";
+	if (ssl_config == NULL) {
+		return BCTBX_ERROR_INVALID_SSL_CONFIG;
+	}
+
+	if (enable) {
+		/* the ticket encryption keys are generated by openssl when the SSL_CTX is created and live as long as it */
+		SSL_CTX_clear_options(ssl_config->ssl_ctx, SSL_OP_NO_TICKET);
+		SSL_CTX_set_num_tickets(ssl_config->ssl_ctx, 2);
+		/* a server verifying its peers refuses to resume sessions when no session id context is set */
+		if (SSL_CTX_set_session_id_context(ssl_config->ssl_ctx, session_id_context, sizeof(session_id_context) - 1) !=
+		    1) {
+			return BCTBX_ERROR_INVALID_SSL_CONFIG;
+		}
+	} else {
+		/* without tickets, TLS 1.3 would fall back to stateful tickets that we do not want either */
+		SSL_CTX_set_options(ssl_config->ssl_ctx, SSL_OP_NO_TICKET);
+		SSL_CTX_set_num_tickets(ssl_config->ssl_ctx, 0);
+	}
+	return 0;
+}
+
 /** DTLS SRTP functions **/
 int32_t bctbx_ssl_get_dtls_srtp_key_material(bctbx_ssl_context_t *ssl_ctx, uint8_t *output, size_t *output_length) {
 	int ret = 0;
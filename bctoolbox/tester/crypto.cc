@@ -26,7 +26,9 @@
 #include "bctoolbox/exception.hh"
 #include "bctoolbox_tester.h"
 #include <array>
+#include <chrono>
 #include <cmath>
+#include <deque>
 #include <stdio.h>
 
 using namespace bctoolbox;
@@ -1446,6 +1448,157 @@ static void key_wrap_test() {
 	BC_ASSERT_TRUE(plaintext == unwrapped_pt);
 }
 
+/* One end of a TLS connection over an in-memory loopback: each end reads what the other one wrote */
+struct TlsLoopbackEnd {
+	bctbx_ssl_context_t *ctx = nullptr;
+	std::deque<uint8_t> *in = nullptr;
+	std::deque<uint8_t> *out = nullptr;
+};
+
+static int tls_loopback_send(void *data, const unsigned char *buf, size_t len) {
+	auto end = static_cast<TlsLoopbackEnd *>(data);
+	end->out->insert(end->out->end(), buf, buf + len);
+	return (int)len;
+}
+
+static int tls_loopback_recv(void *data, unsigned char *buf, size_t len) {
+	auto end = static_cast<TlsLoopbackEnd *>(data);
+	if (end->in->empty()) return BCTBX_ERROR_NET_WANT_READ;
+	len = std::min(len, end->in->size());
+	std::copy(end->in->begin(), end->in->begin() + len, buf);
+	end->in->erase(end->in->begin(), end->in->begin() + len);
+	return (int)len;
+}
+
+static int tls_loopback_rng(void *ctx, unsigned char *buf, size_t len) {
+	return bctbx_rng_get(static_cast<bctbx_rng_context_t *>(ctx), buf, len);
+}
+
+/**
+ * Connect a client to a server over the loopback, offering the given session if any, then save the session on the
+ * client side once some application data was received, as TLS 1.3 tickets are sent after the handshake.
+ * @return the handshake duration in microseconds, negative if the connection failed
+ */
+static int64_t tls_loopback_connect(bctbx_ssl_config_t *client_config,
+                                    bctbx_ssl_config_t *server_config,
+                                    const bctbx_ssl_session_t *offered_session,
+                                    bctbx_ssl_session_t *saved_session,
+                                    bool &reused) {
+	std::deque<uint8_t> toServer, toClient;
+	TlsLoopbackEnd client, server;
+	int64_t duration = -1;
+	int clientRet = BCTBX_ERROR_NET_WANT_READ, serverRet = BCTBX_ERROR_NET_WANT_READ;
+	const unsigned char ping[] = "ping";
+	unsigned char buf[16];
+	int ret = BCTBX_ERROR_NET_WANT_READ;
+
+	client.ctx = bctbx_ssl_context_new();
+	client.in = &toClient;
+	client.out = &toServer;
+	server.ctx = bctbx_ssl_context_new();
+	server.in = &toServer;
+	server.out = &toClient;
+	if (!BC_ASSERT_TRUE(bctbx_ssl_context_setup(client.ctx, client_config) == 0)) goto end;
+	if (!BC_ASSERT_TRUE(bctbx_ssl_context_setup(server.ctx, server_config) == 0)) goto end;
+	bctbx_ssl_set_io_callbacks(client.ctx, &client, tls_loopback_send, tls_loopback_recv);
+	bctbx_ssl_set_io_callbacks(server.ctx, &server, tls_loopback_send, tls_loopback_recv);
+	bctbx_ssl_set_hostname(client.ctx, "bctoolbox.tester");
+	if (offered_session != nullptr) {
+		if (!BC_ASSERT_TRUE(bctbx_ssl_set_session(client.ctx, offered_session) == 0)) goto end;
+	}
+
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < 100 && (clientRet != 0 || serverRet != 0); i++) {
+			if (clientRet != 0) clientRet = bctbx_ssl_handshake(client.ctx);
+			if (serverRet != 0) serverRet = bctbx_ssl_handshake(server.ctx);
+			if ((clientRet != 0 && clientRet != BCTBX_ERROR_NET_WANT_READ && clientRet != BCTBX_ERROR_NET_WANT_WRITE) ||
+			    (serverRet != 0 && serverRet != BCTBX_ERROR_NET_WANT_READ && serverRet != BCTBX_ERROR_NET_WANT_WRITE))
+				break;
+		}
+		auto stop = std::chrono::steady_clock::now();
+		if (!BC_ASSERT_TRUE(clientRet == 0) || !BC_ASSERT_TRUE(serverRet == 0)) goto end;
+		duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+	}
+	reused = bctbx_ssl_session_reused(client.ctx) != 0;
+
+	BC_ASSERT_EQUAL(bctbx_ssl_write(server.ctx, ping, sizeof(ping)), (int)sizeof(ping), int, "%d");
+	for (int i = 0; i < 10 && ret == BCTBX_ERROR_NET_WANT_READ; i++) {
+		ret = bctbx_ssl_read(client.ctx, buf, sizeof(buf));
+	}
+	BC_ASSERT_EQUAL(ret, (int)sizeof(ping), int, "%d");
+	if (saved_session != nullptr) {
+		BC_ASSERT_EQUAL(bctbx_ssl_get_session(client.ctx, saved_session), 0, int, "%x");
+	}
+
+end:
+	bctbx_ssl_context_free(client.ctx);
+	bctbx_ssl_context_free(server.ctx);
+	return duration;
+}
+
+static void tls_session_resumption(void) {
+	constexpr int connections = 20;
+	bctbx_rng_context_t *rng = bctbx_rng_context_new();
+	bctbx_x509_certificate_t *cert = bctbx_x509_certificate_new();
+	bctbx_signing_key_t *key = bctbx_signing_key_new();
+	bctbx_ssl_config_t *client_config = bctbx_ssl_config_new();
+	bctbx_ssl_config_t *server_config = bctbx_ssl_config_new();
+	bctbx_ssl_session_t *session = bctbx_ssl_session_new();
+	int64_t full_duration = 0, resumed_duration = 0;
+	int resumed_count = 0;
+	bool reused = false;
+
+	if (!BC_ASSERT_TRUE(bctbx_x509_certificate_generate_selfsigned_with_key_type(
+	                        "CN=bctoolbox.tester", BCTBX_CERTIFICATE_KEY_ECDSA_P256, cert, key, NULL, 0) == 0))
+		goto end;
+
+	bctbx_ssl_config_defaults(server_config, BCTBX_SSL_IS_SERVER, BCTBX_SSL_TRANSPORT_STREAM);
+	bctbx_ssl_config_set_authmode(server_config, BCTBX_SSL_VERIFY_NONE);
+	bctbx_ssl_config_set_rng(server_config, tls_loopback_rng, rng);
+	BC_ASSERT_EQUAL(bctbx_ssl_config_set_own_cert(server_config, cert, key), 0, int, "%x");
+	bctbx_ssl_config_defaults(client_config, BCTBX_SSL_IS_CLIENT, BCTBX_SSL_TRANSPORT_STREAM);
+	bctbx_ssl_config_set_authmode(client_config, BCTBX_SSL_VERIFY_NONE);
+	bctbx_ssl_config_set_rng(client_config, tls_loopback_rng, rng);
+
+	/* full handshakes, tickets are disabled */
+	BC_ASSERT_EQUAL(bctbx_ssl_config_set_session_tickets(server_config, 0), 0, int, "%x");
+	BC_ASSERT_EQUAL(bctbx_ssl_config_set_session_tickets(client_config, 0), 0, int, "%x");
+	for (int i = 0; i < connections; i++) {
+		int64_t duration = tls_loopback_connect(client_config, server_config, NULL, NULL, reused);
+		if (!BC_ASSERT_TRUE(duration >= 0)) goto end;
+		BC_ASSERT_FALSE(reused);
+		full_duration += duration;
+	}
+
+	/* a first full handshake gets a ticket, then every connection resumes the last saved session */
+	BC_ASSERT_EQUAL(bctbx_ssl_config_set_session_tickets(server_config, 1), 0, int, "%x");
+	BC_ASSERT_EQUAL(bctbx_ssl_config_set_session_tickets(client_config, 1), 0, int, "%x");
+	if (!BC_ASSERT_TRUE(tls_loopback_connect(client_config, server_config, NULL, session, reused) >= 0)) goto end;
+	for (int i = 0; i < connections; i++) {
+		int64_t duration = tls_loopback_connect(client_config, server_config, session, session, reused);
+		if (!BC_ASSERT_TRUE(duration >= 0)) goto end;
+		if (reused) resumed_count++;
+		resumed_duration += duration;
+	}
+	/* mbedtls reports TLS 1.2 resumptions only */
+	if (bctbx_ssl_get_implementation_type() == BCTBX_OPENSSL) {
+		BC_ASSERT_EQUAL(resumed_count, connections, int, "%d");
+	}
+
+	BCTBX_SLOGI << "TLS handshake over loopback: " << full_duration / connections << " us without resumption, "
+	            << resumed_duration / connections << " us with resumption (" << resumed_count << "/" << connections
+	            << " resumed)";
+
+end:
+	bctbx_ssl_session_free(session);
+	bctbx_ssl_config_free(client_config);
+	bctbx_ssl_config_free(server_config);
+	bctbx_signing_key_free(key);
+	bctbx_x509_certificate_free(cert);
+	bctbx_rng_context_free(rng);
+}
+
 static test_t crypto_tests[] = {
     TEST_NO_TAG("Diffie-Hellman Key exchange", DHM),
     TEST_NO_TAG("Elliptic Curve Diffie-Hellman Key exchange", ECDH),
@@ -1457,6 +1610,7 @@ static test_t crypto_tests[] = {
     TEST_NO_TAG("RNG", rng_test),
     TEST_NO_TAG("AEAD", AEAD),
     TEST_NO_TAG("Key wrap", key_wrap_test),
+    TEST_NO_TAG("TLS session resumption", tls_session_resumption),
 };
 
 test_suite_t crypto_test_suite = {"Crypto",     NULL, NULL, NULL, NULL, sizeof(crypto_tests) / sizeof(crypto_tests[0]),
@@ -185,6 +185,14 @@ typedef enum belle_sip_certificate_raw_format {
 	BELLE_SIP_CERTIFICATE_RAW_FORMAT_DER  /** ASN.1 raw format*/
 } belle_sip_certificate_raw_format_t;
 
+/**
+ * Type of the key of a generated self-signed certificate
+ **/
+typedef enum belle_sip_certificate_key_type {
+	BELLE_SIP_CERTIFICATE_KEY_RSA_3072,  /** RSA 3072 bits */
+	BELLE_SIP_CERTIFICATE_KEY_ECDSA_P256 /** ECDSA on curve P-256, much faster to generate */
+} belle_sip_certificate_key_type_t;
+
 /**
  * Parse a buffer containing either a certificate chain order in PEM format or a single DER cert
  * @param buff raw buffer
@@ -255,6 +263,23 @@ BELLESIP_EXPORT int belle_sip_generate_self_signed_certificate(const char *path,
                                                                belle_sip_certificates_chain_t **certificate,
                                                                belle_sip_signing_key_t **pkey);
 
+/**
+ * Generate a self signed certificate and key of the given type and save them in a file if a path is given, file will
+ * be <subject>.pem
+ *
+ * @param[in]	path		If not NULL a file will be written in the given directory. filename is <subject>.pem
+ * @param[in]	subject		used in the CN= field of issuer and subject name
+ * @param[in]	key_type	type of the key to generate
+ * @param[out]	certificate	the generated certificate. Must be destroyed using belle_sip_certificates_chain_destroy
+ * @param[out]	key			the generated key. Must be destroyed using belle_sip_signing_key_destroy
+ * @return 0 on success
+ */
+BELLESIP_EXPORT int belle_sip_generate_self_signed_certificate_with_key_type(const char *path,
+                                                                            const char *subject,
+                                                                            belle_sip_certificate_key_type_t key_type,
+                                                                            belle_sip_certificates_chain_t **certificate,
+                                                                            belle_sip_signing_key_t **pkey);
+
 /**
  * Convert a certificate into a its PEM format string
  *
@@ -405,6 +430,17 @@ BELLESIP_EXPORT void belle_tls_crypto_config_set_postcheck_callback(belle_tls_cr
  */
 BELLESIP_EXPORT void belle_tls_crypto_config_set_ssl_config(belle_tls_crypto_config_t *obj, void *ssl_config);
 
+/**
+ * Enable or disable TLS session resumption.
+ * When enabled, which is the default, the TLS session negotiated with a server is kept after the connection is closed
+ * and offered again to this server on the next connection, sparing the certificate exchange and verification if the
+ * server accepts it. Sessions are kept per destination and forgotten whenever the verification settings of this
+ * crypto configuration change. Connections using a client certificate do not resume sessions.
+ * @param[in/out]	obj		The crypto configuration object to set
+ * @param[in]		enable	TRUE to enable session resumption, FALSE to disable it and forget the saved sessions
+ */
+BELLESIP_EXPORT void belle_tls_crypto_config_enable_session_resumption(belle_tls_crypto_config_t *obj, int enable);
+
 BELLE_SIP_END_DECLS
 
 #endif /* AUTHENTICATION_HELPER_H_ */
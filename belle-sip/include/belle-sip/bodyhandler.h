@@ -138,6 +138,16 @@ belle_sip_buffering_file_body_handler_new(const char *filepath,
 BELLESIP_EXPORT size_t belle_sip_file_body_handler_get_file_size(belle_sip_file_body_handler_t *file_bh);
 BELLESIP_EXPORT void belle_sip_file_body_handler_set_user_body_handler(belle_sip_file_body_handler_t *file_bh,
                                                                        belle_sip_user_body_handler_t *user_bh);
+/**
+ * @brief Set the offset in the file at which received data is written.
+ * When non zero, the file is not truncated when the reception starts and the received body is written starting at this
+ * offset. This is meant to resume an interrupted download with an HTTP Range request, the received body being the
+ * missing part of the file. Offsets given to the user body handler, if any, are file offsets.
+ * Must be called before the transfer begins.
+ */
+BELLESIP_EXPORT void belle_sip_file_body_handler_set_recv_offset(belle_sip_file_body_handler_t *file_bh,
+                                                                 size_t offset);
+BELLESIP_EXPORT size_t belle_sip_file_body_handler_get_recv_offset(const belle_sip_file_body_handler_t *file_bh);
 
 /*
  * Multipart body handler
@@ -132,9 +132,21 @@ unsigned int belle_tls_verify_policy_get_exceptions(const belle_tls_verify_polic
 }
 /* end of deprecated on 2016/02/02 */
 
+/* Maximum number of destinations for which a TLS session is kept */
+#define BELLE_TLS_MAX_SSL_SESSIONS 64
+
+/* Saved sessions were established with the verification settings of their time, forget them when these change */
+static void crypto_config_clear_ssl_sessions(belle_tls_crypto_config_t *obj) {
+	if (obj->ssl_sessions) {
+		bctbx_mmap_cchar_delete_with_data(obj->ssl_sessions, (bctbx_map_free_func)bctbx_ssl_session_free);
+		obj->ssl_sessions = NULL;
+	}
+}
+
 static void crypto_config_uninit(belle_tls_crypto_config_t *obj) {
 	if (obj->root_ca) belle_sip_free(obj->root_ca);
 	if (obj->root_ca_data) belle_sip_free(obj->root_ca_data);
+	crypto_config_clear_ssl_sessions(obj);
 }
 
 BELLE_SIP_DECLARE_NO_IMPLEMENTED_INTERFACES(belle_tls_crypto_config_t);
@@ -159,11 +171,13 @@ belle_tls_crypto_config_t *belle_tls_crypto_config_new(void) {
 #endif
 	obj->ssl_config = NULL;
 	obj->exception_flags = BELLE_TLS_VERIFY_NONE;
+	obj->session_resumption_enabled = TRUE;
 
 	return obj;
 }
 
 int belle_tls_crypto_config_set_root_ca(belle_tls_crypto_config_t *obj, const char *path) {
+	crypto_config_clear_ssl_sessions(obj);
 	if (obj->root_ca) {
 		belle_sip_free(obj->root_ca);
 		obj->root_ca = NULL;
@@ -178,6 +192,7 @@ int belle_tls_crypto_config_set_root_ca(belle_tls_crypto_config_t *obj, const ch
 }
 
 int belle_tls_crypto_config_set_root_ca_data(belle_tls_crypto_config_t *obj, const char *data) {
+	crypto_config_clear_ssl_sessions(obj);
 	if (obj->root_ca) {
 		belle_sip_free(obj->root_ca);
 		obj->root_ca = NULL;
@@ -196,6 +211,7 @@ int belle_tls_crypto_config_set_root_ca_data(belle_tls_crypto_config_t *obj, con
 }
 
 void belle_tls_crypto_config_set_verify_exceptions(belle_tls_crypto_config_t *obj, int flags) {
+	crypto_config_clear_ssl_sessions(obj);
 	obj->exception_flags = flags;
 }
 
@@ -204,12 +220,14 @@ unsigned int belle_tls_crypto_config_get_verify_exceptions(const belle_tls_crypt
 }
 
 void belle_tls_crypto_config_set_ssl_config(belle_tls_crypto_config_t *obj, void *ssl_config) {
+	crypto_config_clear_ssl_sessions(obj);
 	obj->ssl_config = ssl_config;
 }
 
 void belle_tls_crypto_config_set_verify_callback(belle_tls_crypto_config_t *obj,
                                                  belle_tls_crypto_config_verify_callback_t cb,
                                                  void *cb_data) {
+	crypto_config_clear_ssl_sessions(obj);
 	obj->verify_cb = cb;
 	obj->verify_cb_data = cb_data;
 }
@@ -217,6 +235,80 @@ void belle_tls_crypto_config_set_verify_callback(belle_tls_crypto_config_t *obj,
 void belle_tls_crypto_config_set_postcheck_callback(belle_tls_crypto_config_t *obj,
                                                     belle_tls_crypto_config_postcheck_callback_t cb,
                                                     void *cb_data) {
+	crypto_config_clear_ssl_sessions(obj);
 	obj->postcheck_cb = cb;
 	obj->postcheck_cb_data = cb_data;
 }
+
+void belle_tls_crypto_config_enable_session_resumption(belle_tls_crypto_config_t *obj, int enable) {
+	obj->session_resumption_enabled = enable;
+	if (!enable) crypto_config_clear_ssl_sessions(obj);
+}
+
+const bctbx_ssl_session_t *belle_tls_crypto_config_get_ssl_session(const belle_tls_crypto_config_t *obj,
+                                                                   const char *destination) {
+	const bctbx_ssl_session_t *session = NULL;
+	bctbx_iterator_t *it, *end;
+
+	if (!obj->session_resumption_enabled || obj->ssl_sessions == NULL) return NULL;
+	it = bctbx_map_cchar_find_key(obj->ssl_sessions, destination);
+	end = bctbx_map_cchar_end(obj->ssl_sessions);
+	if (!bctbx_iterator_cchar_equals(it, end)) {
+		session = (const bctbx_ssl_session_t *)bctbx_pair_cchar_get_second(bctbx_iterator_cchar_get_pair(it));
+	}
+	bctbx_iterator_cchar_delete(it);
+	bctbx_iterator_cchar_delete(end);
+	return session;
+}
+
+int belle_tls_crypto_config_save_ssl_session(belle_tls_crypto_config_t *obj,
+                                             const char *destination,
+                                             bctbx_ssl_context_t *ssl_ctx) {
+	bctbx_ssl_session_t *session;
+	bctbx_iterator_t *it, *end;
+	int found, ret;
+
+	if (!obj->session_resumption_enabled) return -1;
+	if (obj->ssl_sessions == NULL) obj->ssl_sessions = bctbx_mmap_cchar_new();
+
+	it = bctbx_map_cchar_find_key(obj->ssl_sessions, destination);
+	end = bctbx_map_cchar_end(obj->ssl_sessions);
+	found = !bctbx_iterator_cchar_equals(it, end);
+	bctbx_iterator_cchar_delete(end);
+	if (found) {
+		/* the previously saved session is kept if no resumable one is available yet */
+		session = (bctbx_ssl_session_t *)bctbx_pair_cchar_get_second(bctbx_iterator_cchar_get_pair(it));
+		bctbx_iterator_cchar_delete(it);
+		return bctbx_ssl_get_session(ssl_ctx, session) == 0 ? 0 : -1;
+	}
+	bctbx_iterator_cchar_delete(it);
+
+	session = bctbx_ssl_session_new();
+	ret = bctbx_ssl_get_session(ssl_ctx, session);
+	if (ret != 0) {
+		bctbx_ssl_session_free(session);
+		return -1;
+	}
+	if (bctbx_map_cchar_size(obj->ssl_sessions) >= BELLE_TLS_MAX_SSL_SESSIONS) {
+		/* make room, there is no point in being smarter for a handful of destinations */
+		it = bctbx_map_cchar_begin(obj->ssl_sessions);
+		bctbx_ssl_session_free((bctbx_ssl_session_t *)bctbx_pair_cchar_get_second(bctbx_iterator_cchar_get_pair(it)));
+		bctbx_iterator_cchar_delete(bctbx_map_cchar_erase(obj->ssl_sessions, it));
+	}
+	bctbx_map_cchar_insert_and_delete(obj->ssl_sessions, (bctbx_pair_t *)bctbx_pair_cchar_new(destination, session));
+	return 0;
+}
+
+void belle_tls_crypto_config_remove_ssl_session(belle_tls_crypto_config_t *obj, const char *destination) {
+	bctbx_iterator_t *it, *end;
+
+	if (obj->ssl_sessions == NULL) return;
+	it = bctbx_map_cchar_find_key(obj->ssl_sessions, destination);
+	end = bctbx_map_cchar_end(obj->ssl_sessions);
+	if (!bctbx_iterator_cchar_equals(it, end)) {
+		bctbx_ssl_session_free((bctbx_ssl_session_t *)bctbx_pair_cchar_get_second(bctbx_iterator_cchar_get_pair(it)));
+		it = bctbx_map_cchar_erase(obj->ssl_sessions, it);
+	}
+	bctbx_iterator_cchar_delete(it);
+	bctbx_iterator_cchar_delete(end);
+}
@@ -676,6 +676,7 @@ struct belle_sip_file_body_handler {
 	belle_sip_user_body_handler_t *user_bh;
 	belle_sip_body_handler_buffer_t buffer;
 	belle_sip_direction_t direction;
+	size_t recv_offset; /* file offset of the first received byte, non zero when resuming a download */
 };
 
 static void belle_sip_file_body_handler_destroy(belle_sip_file_body_handler_t *obj) {
@@ -703,6 +704,7 @@ static void belle_sip_file_body_handler_clone(belle_sip_file_body_handler_t *obj
 	obj->filepath = belle_sip_strdup(orig->filepath);
 	obj->file = orig->file;
 	obj->user_bh = orig->user_bh;
+	obj->recv_offset = orig->recv_offset;
 	if (obj->user_bh) {
 		belle_sip_object_ref(obj->user_bh);
 	} else {
@@ -717,7 +719,8 @@ static void belle_sip_file_body_handler_begin_recv_transfer(belle_sip_body_handl
 	if (obj->direction != BELLE_SIP_DIRECTION_RECV)
 		bctbx_error("Attempting to receive a file with a body handler initialized for sending");
 	if (obj->filepath == NULL) return;
-	obj->file = bctbx_file_open(vfs, obj->filepath, "w");
+	/* when resuming, keep what was already received: open without truncating */
+	obj->file = bctbx_file_open(vfs, obj->filepath, obj->recv_offset > 0 ? "w+" : "w");
 	if (!obj->file) {
 		bctbx_error("Can't open file %s", obj->filepath);
 	}
@@ -760,12 +763,13 @@ static void belle_sip_file_body_handler_recv_chunk(
 
 		if (size > 0) {
 			obj->user_bh->recv_cb((belle_sip_user_body_handler_t *)&(obj->user_bh->base), msg,
-			                      obj->user_bh->base.user_data, offset, bufferized_data, size);
+			                      obj->user_bh->base.user_data, (size_t)offset + obj->recv_offset, bufferized_data,
+			                      size);
 		}
 	}
 
 	if (size > 0) {
-		ret = bctbx_file_write(obj->file, bufferized_data, size, offset);
+		ret = bctbx_file_write(obj->file, bufferized_data, size, offset + (off_t)obj->recv_offset);
 	}
 
 	if (free_output_flag == TRUE) {
@@ -863,6 +867,7 @@ BELLE_SIP_INSTANCIATE_CUSTOM_VPTR_BEGIN(belle_sip_file_body_handler_t){
 	obj->buffer.index = 0;
 	obj->buffer.data = NULL;
 	obj->buffer.next_offset = 0;
+	obj->recv_offset = 0;
 
 	return obj;
 }
@@ -893,6 +898,18 @@ void belle_sip_file_body_handler_set_user_body_handler(belle_sip_file_body_handl
 	}
 }
 
+void belle_sip_file_body_handler_set_recv_offset(belle_sip_file_body_handler_t *file_bh, size_t offset) {
+	if (file_bh->direction != BELLE_SIP_DIRECTION_RECV) {
+		belle_sip_error("belle_sip_file_body_handler_set_recv_offset(): body handler is not receiving");
+		return;
+	}
+	file_bh->recv_offset = offset;
+}
+
+size_t belle_sip_file_body_handler_get_recv_offset(const belle_sip_file_body_handler_t *file_bh) {
+	return file_bh->recv_offset;
+}
+
 /*
  * Multipart body handler implementation
  * TODO
@@ -289,8 +289,17 @@ struct belle_tls_crypto_config {
 	void *verify_cb_data;
 	belle_tls_crypto_config_postcheck_callback_t postcheck_cb;
 	void *postcheck_cb_data;
+	int session_resumption_enabled;
+	bctbx_map_t *ssl_sessions; /**< TLS sessions saved for resumption, bctbx_ssl_session_t indexed by destination */
 };
 
+const bctbx_ssl_session_t *belle_tls_crypto_config_get_ssl_session(const belle_tls_crypto_config_t *obj,
+                                                                   const char *destination);
+int belle_tls_crypto_config_save_ssl_session(belle_tls_crypto_config_t *obj,
+                                             const char *destination,
+                                             bctbx_ssl_context_t *ssl_ctx);
+void belle_tls_crypto_config_remove_ssl_session(belle_tls_crypto_config_t *obj, const char *destination);
+
 typedef struct _belle_sip_channel_bank belle_sip_channel_bank_t;
 
 #endif
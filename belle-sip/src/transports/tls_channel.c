@@ -257,6 +257,15 @@ int belle_sip_generate_self_signed_certificate(const char *path,
                                                const char *subject,
                                                belle_sip_certificates_chain_t **certificate,
                                                belle_sip_signing_key_t **pkey) {
+	return belle_sip_generate_self_signed_certificate_with_key_type(path, subject, BELLE_SIP_CERTIFICATE_KEY_RSA_3072,
+	                                                                certificate, pkey);
+}
+
+int belle_sip_generate_self_signed_certificate_with_key_type(const char *path,
+                                                             const char *subject,
+                                                             belle_sip_certificate_key_type_t key_type,
+                                                             belle_sip_certificates_chain_t **certificate,
+                                                             belle_sip_signing_key_t **pkey) {
 	char pem_buffer[8192];
 	int ret = 0;
 
@@ -264,8 +273,11 @@ int belle_sip_generate_self_signed_certificate(const char *path,
 	*pkey = belle_sip_signing_key_new();
 	*certificate = belle_sip_certificate_chain_new();
 
-	ret = bctbx_x509_certificate_generate_selfsigned(subject, (*certificate)->cert, (*pkey)->key,
-	                                                 (path == NULL) ? NULL : pem_buffer, (path == NULL) ? 0 : 8192);
+	ret = bctbx_x509_certificate_generate_selfsigned_with_key_type(
+	    subject,
+	    (key_type == BELLE_SIP_CERTIFICATE_KEY_ECDSA_P256) ? BCTBX_CERTIFICATE_KEY_ECDSA_P256
+	                                                       : BCTBX_CERTIFICATE_KEY_RSA_3072,
+	    (*certificate)->cert, (*pkey)->key, (path == NULL) ? NULL : pem_buffer, (path == NULL) ? 0 : 8192);
 	if (ret != 0) {
 		belle_sip_error("Unable to generate self signed certificate : -%x", -ret);
 		belle_sip_object_unref(*pkey);
@@ -366,6 +378,8 @@ struct belle_sip_tls_channel {
 	belle_tls_crypto_config_t *crypto_config;
 	int http_proxy_connected;
 	belle_sip_resolver_context_t *http_proxy_resolver_ctx;
+	char *ssl_session_key; /**< destination under which the TLS session is saved, NULL if it must not be */
+	int ssl_session_saved;
 };
 
 static void tls_channel_close(belle_sip_tls_channel_t *obj) {
@@ -393,6 +407,16 @@ static void tls_channel_uninit(belle_sip_tls_channel_t *obj) {
 	if (obj->client_cert_chain) belle_sip_object_unref(obj->client_cert_chain);
 	if (obj->client_cert_key) belle_sip_object_unref(obj->client_cert_key);
 	if (obj->http_proxy_resolver_ctx) belle_sip_object_unref(obj->http_proxy_resolver_ctx);
+	if (obj->ssl_session_key) belle_sip_free(obj->ssl_session_key);
+}
+
+/* With TLS 1.3 the session can be saved only once the server's ticket was received, after the handshake */
+static void tls_channel_save_ssl_session(belle_sip_tls_channel_t *obj) {
+	if (obj->ssl_session_key == NULL || obj->ssl_session_saved) return;
+	if (belle_tls_crypto_config_save_ssl_session(obj->crypto_config, obj->ssl_session_key, obj->sslctx) == 0) {
+		belle_sip_message("Channel [%p]: TLS session saved for [%s]", obj, obj->ssl_session_key);
+		obj->ssl_session_saved = 1;
+	}
 }
 
 static int tls_channel_send(belle_sip_channel_t *obj, const void *buf, size_t buflen) {
@@ -410,6 +434,7 @@ static int tls_channel_send(belle_sip_channel_t *obj, const void *buf, size_t bu
 static int tls_channel_recv(belle_sip_channel_t *obj, void *buf, size_t buflen) {
 	belle_sip_tls_channel_t *channel = (belle_sip_tls_channel_t *)obj;
 	int err = bctbx_ssl_read(channel->sslctx, buf, buflen);
+	if (err > 0) tls_channel_save_ssl_session(channel);
 	if (err == BCTBX_ERROR_SSL_PEER_CLOSE_NOTIFY) return 0;
 	if (err < 0) {
 		char tmp[256] = {0};
@@ -503,11 +528,15 @@ static int tls_process_handshake(belle_sip_channel_t *obj) {
 
 	memset(tmp, '\0', sizeof(tmp));
 	if (err == 0) {
-		belle_sip_message("Channel [%p]: SSL handshake finished, SSL version is [%s], selected ciphersuite is [%s]",
-		                  obj, bctbx_ssl_get_version(channel->sslctx), bctbx_ssl_get_ciphersuite(channel->sslctx));
+		belle_sip_message(
+		    "Channel [%p]: SSL handshake finished, SSL version is [%s], selected ciphersuite is [%s]%s", obj,
+		    bctbx_ssl_get_version(channel->sslctx), bctbx_ssl_get_ciphersuite(channel->sslctx),
+		    bctbx_ssl_session_reused(channel->sslctx) ? ", session resumed" : "");
 		err = tls_handle_postcheck(channel);
 		if (err != 0) {
 			snprintf(tmp, sizeof(tmp) - 1, "%s", "application level post-check failed.");
+		} else {
+			tls_channel_save_ssl_session(channel);
 		}
 	}
 
@@ -521,6 +550,9 @@ static int tls_process_handshake(belle_sip_channel_t *obj) {
 			bctbx_strerror(err, tmp, sizeof(tmp));
 		}
 		belle_sip_error("Channel [%p]: SSL handshake failed : %s", obj, tmp);
+		/* do not offer again a session which may be the cause of the failure */
+		if (channel->ssl_session_key)
+			belle_tls_crypto_config_remove_ssl_session(channel->crypto_config, channel->ssl_session_key);
 		return -1;
 	}
 	return 0;
@@ -848,6 +880,7 @@ static void belle_sip_tls_channel_deinit_bctbx_ssl(belle_sip_tls_channel_t *obj)
 static int belle_sip_tls_channel_init_bctbx_ssl(belle_sip_tls_channel_t *obj) {
 	belle_sip_stream_channel_t *super = (belle_sip_stream_channel_t *)obj;
 	belle_tls_crypto_config_t *crypto_config = obj->crypto_config;
+	const char *hostname;
 
 	/* create and initialise ssl context and configuration */
 	obj->sslctx = bctbx_ssl_context_new();
@@ -855,6 +888,7 @@ static int belle_sip_tls_channel_init_bctbx_ssl(belle_sip_tls_channel_t *obj) {
 	if (crypto_config->ssl_config == NULL) {
 		bctbx_ssl_config_defaults(obj->sslcfg, BCTBX_SSL_IS_CLIENT, BCTBX_SSL_TRANSPORT_STREAM);
 		bctbx_ssl_config_set_authmode(obj->sslcfg, BCTBX_SSL_VERIFY_REQUIRED);
+		if (crypto_config->session_resumption_enabled) bctbx_ssl_config_set_session_tickets(obj->sslcfg, 1);
 		/* set up client certificate */
 		/* if we do not have one, request it */
 		if (!(obj->client_cert_chain && obj->client_cert_key)) {
@@ -899,8 +933,24 @@ static int belle_sip_tls_channel_init_bctbx_ssl(belle_sip_tls_channel_t *obj) {
 	bctbx_ssl_context_setup(obj->sslctx, obj->sslcfg);
 	bctbx_ssl_set_io_callbacks(obj->sslctx, obj, tls_callback_write, tls_callback_read);
 	if (super->base.stack->verify_server_cn_against_srv_target && super->base.current_peer_cname)
-		bctbx_ssl_set_hostname(obj->sslctx, super->base.current_peer_cname);
-	else bctbx_ssl_set_hostname(obj->sslctx, super->base.peer_cname ? super->base.peer_cname : super->base.peer_name);
+		hostname = super->base.current_peer_cname;
+	else hostname = super->base.peer_cname ? super->base.peer_cname : super->base.peer_name;
+	bctbx_ssl_set_hostname(obj->sslctx, hostname);
+
+	/* a resumed session would keep the identity of the client certificate it was established with */
+	if (obj->ssl_session_key) {
+		belle_sip_free(obj->ssl_session_key);
+		obj->ssl_session_key = NULL;
+	}
+	obj->ssl_session_saved = 0;
+	if (crypto_config->session_resumption_enabled && !(obj->client_cert_chain && obj->client_cert_key)) {
+		const bctbx_ssl_session_t *session;
+		obj->ssl_session_key = belle_sip_strdup_printf("%s:%i", hostname, super->base.peer_port);
+		session = belle_tls_crypto_config_get_ssl_session(crypto_config, obj->ssl_session_key);
+		if (session && bctbx_ssl_set_session(obj->sslctx, session) == 0) {
+			belle_sip_message("Channel [%p]: offering saved TLS session for [%s]", obj, obj->ssl_session_key);
+		}
+	}
 
 	return 0;
 }
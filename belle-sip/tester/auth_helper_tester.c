@@ -176,7 +176,7 @@ static void test_proxy_authentication(void) {
 
 #define TEMPORARY_CERTIFICATE_DIR "/belle_sip_tester_crt"
 
-static void test_generate_and_parse_certificates(void) {
+static void generate_and_parse_certificates(belle_sip_certificate_key_type_t key_type) {
 	belle_sip_certificates_chain_t *certificate, *parsed_certificate;
 	belle_sip_signing_key_t *key, *parsed_key;
 	char *pem_certificate, *pem_parsed_certificate, *pem_key, *pem_parsed_key;
@@ -185,8 +185,8 @@ static void test_generate_and_parse_certificates(void) {
 
 	/* create 2 certificates in the temporary certificate directory (TODO : set the directory in a absolute path??
 	 * where?)*/
-	ret = belle_sip_generate_self_signed_certificate(belle_sip_certificate_temporary_dir, "test_certificate1",
-	                                                 &certificate, &key);
+	ret = belle_sip_generate_self_signed_certificate_with_key_type(belle_sip_certificate_temporary_dir,
+	                                                               "test_certificate1", key_type, &certificate, &key);
 	if (ret == BCTBX_ERROR_UNAVAILABLE_FUNCTION) {
 		belle_sip_warning("Test skipped, self signed certificate generation not available.");
 		return;
@@ -196,8 +196,8 @@ static void test_generate_and_parse_certificates(void) {
 		belle_sip_object_unref(certificate);
 		belle_sip_object_unref(key);
 	}
-	ret = belle_sip_generate_self_signed_certificate(belle_sip_certificate_temporary_dir, "test_certificate2",
-	                                                 &certificate, &key);
+	ret = belle_sip_generate_self_signed_certificate_with_key_type(belle_sip_certificate_temporary_dir,
+	                                                               "test_certificate2", key_type, &certificate, &key);
 	BC_ASSERT_EQUAL(0, ret, int, "%d");
 
 	/* parse directory to get the certificate2 */
@@ -231,6 +231,14 @@ static void test_generate_and_parse_certificates(void) {
 	belle_sip_object_unref(parsed_key);
 }
 
+static void test_generate_and_parse_certificates(void) {
+	generate_and_parse_certificates(BELLE_SIP_CERTIFICATE_KEY_RSA_3072);
+}
+
+static void test_generate_and_parse_ecdsa_certificates(void) {
+	generate_and_parse_certificates(BELLE_SIP_CERTIFICATE_KEY_ECDSA_P256);
+}
+
 const char *belle_sip_tester_fingerprint256_cert = /*for URI:sip:tester@client.example.org*/
     "-----BEGIN CERTIFICATE-----\n"
     "MIIDtTCCAh2gAwIBAgIBATANBgkqhkiG9w0BAQsFADAcMRowGAYDVQQDExF0ZXN0\n"
@@ -305,6 +313,7 @@ static test_t authentication_helper_tests[] = {
     TEST_NO_TAG("WWW-Authenticate-MD5 RFC7616 patterns", test_authentication_md5_rfc7616),
     TEST_NO_TAG("WWW-Authenticate (with qop)", test_authentication_qop_auth),
     TEST_NO_TAG("generate and parse self signed certificates", test_generate_and_parse_certificates),
+    TEST_NO_TAG("generate and parse ECDSA self signed certificates", test_generate_and_parse_ecdsa_certificates),
     TEST_NO_TAG("generate certificate fingerprint", test_certificate_fingerprint)};
 
 test_suite_t authentication_helper_test_suite = {"Authentication helper",
@@ -632,6 +632,88 @@ static void http_channel_reuse(void) {
 	}
 }
 
+static void process_response_headers_resume(void *data, const belle_http_response_event_t *event) {
+	http_counters_t *counters = (http_counters_t *)data;
+	counters->response_headers_count++;
+	BC_ASSERT_PTR_NOT_NULL(event->response);
+	if (event->response) {
+		const char *filepath = (const char *)belle_sip_object_data_get(BELLE_SIP_OBJECT(event->request), "filepath");
+		size_t resume_offset =
+		    (size_t)(intptr_t)belle_sip_object_data_get(BELLE_SIP_OBJECT(event->request), "resume_offset");
+		belle_sip_file_body_handler_t *bh =
+		    belle_sip_file_body_handler_new(filepath, on_progress, NULL, BELLE_SIP_DIRECTION_RECV);
+		/* only a partial content response can be appended to what we already have */
+		if (belle_http_response_get_status_code(event->response) == 206) {
+			belle_sip_file_body_handler_set_recv_offset(bh, resume_offset);
+		}
+		belle_sip_message_set_body_handler((belle_sip_message_t *)event->response, (belle_sip_body_handler_t *)bh);
+	}
+}
+
+static void http_get_resumed_with_range(void) {
+	HttpServer http_server;
+	belle_http_request_listener_callbacks_t cbs = {0};
+	belle_http_request_listener_t *l;
+	belle_http_request_t *req;
+	http_counters_t counters = {0};
+	std::string content;
+	const size_t resume_offset = 100000;
+	char *filepath = bc_tester_file("http_resumed_download.bin");
+	char range[64];
+
+	for (size_t i = 0; i < 3 * resume_offset; ++i) {
+		content.push_back((char)('a' + i % 26));
+	}
+	http_server.Get("/file.bin", [&content](const httplib::Request &req, httplib::Response &res) {
+		res.set_content(content, "application/octet-stream");
+	});
+
+	/* simulate an interrupted download: the first part of the file is already there */
+	FILE *partial = fopen(filepath, "wb");
+	if (!BC_ASSERT_PTR_NOT_NULL(partial)) goto end;
+	fwrite(content.data(), 1, resume_offset, partial);
+	fclose(partial);
+
+	cbs.process_response_headers = process_response_headers_resume;
+	cbs.process_response = process_response;
+	cbs.process_io_error = process_io_error;
+	snprintf(range, sizeof(range), "bytes=%zu-", resume_offset);
+	req = belle_http_request_create("GET", belle_generic_uri_parse((http_server.mRootUrl + "/file.bin").c_str()),
+	                                belle_sip_header_create("User-Agent", "belle-sip/" PACKAGE_VERSION),
+	                                belle_sip_header_create("Range", range), NULL);
+	belle_sip_object_data_set(BELLE_SIP_OBJECT(req), "filepath", filepath, NULL);
+	belle_sip_object_data_set(BELLE_SIP_OBJECT(req), "resume_offset", (void *)(intptr_t)resume_offset, NULL);
+	l = belle_http_request_listener_create_from_callbacks(&cbs, &counters);
+	belle_sip_object_ref(req);
+	belle_http_provider_send_request(http_prov, req, l);
+	BC_ASSERT_TRUE(wait_for(http_stack, &counters.response_count, 1, 10000));
+	BC_ASSERT_EQUAL(counters.response_headers_count, 1, int, "%d");
+	BC_ASSERT_EQUAL(counters.two_hundred, 1, int, "%d");
+	if (BC_ASSERT_PTR_NOT_NULL(belle_http_request_get_response(req))) {
+		BC_ASSERT_EQUAL(belle_http_response_get_status_code(belle_http_request_get_response(req)), 206, int, "%d");
+	}
+	belle_sip_object_unref(req);
+	belle_sip_object_unref(l);
+
+	{
+		/* the file must now be complete, the resumed part appended to the already downloaded one */
+		std::string received;
+		char buf[4096];
+		size_t n;
+		FILE *result = fopen(filepath, "rb");
+		if (BC_ASSERT_PTR_NOT_NULL(result)) {
+			while ((n = fread(buf, 1, sizeof(buf), result)) > 0)
+				received.append(buf, n);
+			fclose(result);
+		}
+		BC_ASSERT_EQUAL(received.size(), content.size(), size_t, "%zu");
+		BC_ASSERT_TRUE(received == content);
+	}
+	remove(filepath);
+end:
+	bc_free(filepath);
+}
+
 extern const char *test_http_proxy_addr;
 extern int test_http_proxy_port;
 
@@ -663,7 +745,8 @@ static test_t http_tests[] = {
     TEST_NO_TAG("https POST with long body", https_post_long_body),
     TEST_NO_TAG("http GET with long user body", http_get_long_user_body), TEST_NO_TAG("https only", one_https_only_get),
     TEST_NO_TAG("http redirect to https", http_redirect_to_https),
-    TEST_NO_TAG("http channel reuse", http_channel_reuse)};
+    TEST_NO_TAG("http channel reuse", http_channel_reuse),
+    TEST_NO_TAG("http GET resumed with range", http_get_resumed_with_range)};
 
 test_suite_t http_test_suite = {"HTTP stack",
                                 http_before_all,
@@ -24,6 +24,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 // =============================================================================
 
@@ -48,6 +49,7 @@ BELR_PUBLIC std::string tolower(const std::string &str);
 class ParserContextBase;
 class BinaryOutputStream;
 class BinaryGrammarBuilder;
+class CodeGenerator;
 
 /**
  * The transition map is an internal tool used to optimize recognizers
@@ -76,11 +78,17 @@ public:
 	void optimize(int recursionLevel);
 	void serialize(BinaryOutputStream &fstr, bool topLevel = false);
 	static std::shared_ptr<Recognizer> build(BinaryGrammarBuilder &ifstr);
+	/*writes the C++ statements assigning to variable 'result' the number of characters matched at position 'pos'*/
+	void generateCode(CodeGenerator &gen, const std::string &pos, const std::string &result, bool topLevel = false);
+	/*returns true if the recognizer is unnamed and matches a single character out of a set, added to the mask*/
+	bool getCharClass(TransitionMap *mask);
 
 protected:
 	Recognizer() = default;
 	Recognizer(BinaryGrammarBuilder &istr);
 	virtual void _serialize(BinaryOutputStream &fstr) = 0;
+	virtual void _generateCode(CodeGenerator &gen, const std::string &pos, const std::string &result) = 0;
+	virtual bool _getCharClass(TransitionMap *mask);
 	/*returns true if the transition map is complete, false otherwise*/
 	virtual bool _getTransitionMap(TransitionMap *mask);
 	virtual void _optimize(int recursionLevel) = 0;
@@ -112,6 +120,8 @@ private:
 	size_t _feed(ParserContextBase &ctx, const std::string &input, size_t pos) override;
 	void _optimize(int recursionLevel) override;
 	virtual void _serialize(BinaryOutputStream &fstr) override;
+	void _generateCode(CodeGenerator &gen, const std::string &pos, const std::string &result) override;
+	bool _getCharClass(TransitionMap *mask) override;
 
 	int mToRecognize;
 	bool mCaseSensitive;
@@ -128,6 +138,8 @@ protected:
 	size_t _feed(ParserContextBase &ctx, const std::string &input, size_t pos) override;
 	bool _getTransitionMap(TransitionMap *mask) override;
 	virtual void _serialize(BinaryOutputStream &fstr) override;
+	void _generateCode(CodeGenerator &gen, const std::string &pos, const std::string &result) override;
+	bool _getCharClass(TransitionMap *mask) override;
 
 	size_t _feedExclusive(ParserContextBase &ctx, const std::string &input, size_t pos);
 
@@ -154,6 +166,7 @@ public:
 
 protected:
 	virtual void _serialize(BinaryOutputStream &fstr) override;
+	void _generateCode(CodeGenerator &gen, const std::string &pos, const std::string &result) override;
 	void _optimize(int recursionLevel) override;
 
 private:
@@ -171,6 +184,7 @@ public:
 
 protected:
 	virtual void _serialize(BinaryOutputStream &fstr) override;
+	void _generateCode(CodeGenerator &gen, const std::string &pos, const std::string &result) override;
 	void _optimize(int recursionLevel) override;
 
 private:
@@ -197,8 +211,10 @@ public:
 
 private:
 	virtual void _serialize(BinaryOutputStream &fstr) override;
+	void _generateCode(CodeGenerator &gen, const std::string &pos, const std::string &result) override;
 	void _optimize(int recursionLevel) override;
 	size_t _feed(ParserContextBase &ctx, const std::string &input, size_t pos) override;
+	bool _getCharClass(TransitionMap *mask) override;
 
 	int mBegin;
 	int mEnd;
@@ -213,6 +229,7 @@ public:
 private:
 	void _optimize(int recursionLevel) override;
 	virtual void _serialize(BinaryOutputStream &fstr) override;
+	void _generateCode(CodeGenerator &gen, const std::string &pos, const std::string &result) override;
 	size_t _feed(ParserContextBase &ctx, const std::string &input, size_t pos) override;
 
 	std::string mLiteral;
@@ -240,6 +257,7 @@ public:
 private:
 	void _optimize(int recursionLevel) override;
 	virtual void _serialize(BinaryOutputStream &fstr) override;
+	void _generateCode(CodeGenerator &gen, const std::string &pos, const std::string &result) override;
 	size_t _feed(ParserContextBase &ctx, const std::string &input, size_t pos) override;
 
 	std::shared_ptr<Recognizer> mRecognizer;
@@ -260,10 +278,43 @@ public:
 private:
 	void _optimize(int recursionLevel) override;
 	virtual void _serialize(BinaryOutputStream &fstr) override;
+	void _generateCode(CodeGenerator &gen, const std::string &pos, const std::string &result) override;
 	size_t _feed(ParserContextBase &ctx, const std::string &input, size_t pos) override;
 	std::shared_ptr<Recognizer> mRecognizer;
 };
 
+/**
+ * The NativeRule implements a rule of a grammar compiled into C++ code by Grammar::generateCode().
+ * The generated function replaces the tree of recognizers that is otherwise interpreted at parse time.
+ * The rules of a compiled grammar invoke each other through a table shared by all of them, and notify the
+ * ParserContextBase the same way as interpreted rules do, so that handlers and collectors work unchanged.
+ **/
+class NativeRule : public Recognizer {
+public:
+	using RuleTable = std::vector<std::shared_ptr<Recognizer>>;
+	using Function = size_t (*)(const RuleTable &rules, ParserContextBase &ctx, const std::string &input, size_t pos);
+	struct Definition {
+		const char *name;
+		Function function;
+	};
+
+	NativeRule(Function function, const RuleTable *rules);
+	/*invokes the rule at the given index of the table, as Recognizer::feed() does*/
+	BELR_PUBLIC static size_t
+	invoke(const RuleTable &rules, size_t index, ParserContextBase &ctx, const std::string &input, size_t pos);
+	/*an unnamed recognizer, used by generated code to undo the assignments of a sub-recognizer that does not match*/
+	BELR_PUBLIC static const std::shared_ptr<Recognizer> &getAnonymous();
+
+private:
+	void _optimize(int recursionLevel) override;
+	virtual void _serialize(BinaryOutputStream &fstr) override;
+	void _generateCode(CodeGenerator &gen, const std::string &pos, const std::string &result) override;
+	size_t _feed(ParserContextBase &ctx, const std::string &input, size_t pos) override;
+
+	Function mFunction;
+	const RuleTable *mRules; // owned by the grammar.
+};
+
 /**
  * Grammar class represents an ABNF grammar, with all its rules.
  **/
@@ -335,12 +386,27 @@ public:
 	 * Load the grammar from a binary file
 	 **/
 	BELR_PUBLIC int load(const std::string &filename);
+	/**
+	 * Generate the C++ source of a recursive-descent recognizer for this grammar.
+	 * The generated file defines a function named after functionName, taking no argument and returning a
+	 * std::shared_ptr<belr::Grammar> made of NativeRule objects, that can be used with Parser like any other grammar.
+	 * @param filename the C++ source file to write.
+	 * @param functionName the name of the function returning the compiled grammar.
+	 * @return 0 if successful, -1 otherwise.
+	 **/
+	BELR_PUBLIC int generateCode(const std::string &filename, const std::string &functionName);
+	/**
+	 * Add the rules of a grammar compiled by generateCode(). This is meant to be invoked by the generated code only.
+	 **/
+	BELR_PUBLIC void addNativeRules(const NativeRule::Definition *definitions, size_t count);
 
 private:
 	std::map<std::string, std::shared_ptr<Recognizer>> mRules;
 	// The recognizer pointers create loops in the chain of recognizer, preventing shared_ptr<> to be released.
 	// We store them in this list so that we can reset them manually to break the loop of reference.
 	std::list<std::shared_ptr<RecognizerPointer>> mRecognizerPointers;
+	// The tables through which the native rules of this grammar, or of included grammars, invoke each other.
+	std::list<std::shared_ptr<NativeRule::RuleTable>> mNativeRuleTables;
 	std::string mName;
 };
 
@@ -28,6 +28,7 @@
 #include "belr/belr.h"
 #include "belr/parser.h"
 #include "binarystream.h"
+#include "codegen.h"
 #include "common.h"
 
 using namespace std;
@@ -219,6 +220,23 @@ size_t Recognizer::feed(ParserContextBase &ctx, const string &input, size_t pos)
 	return match;
 }
 
+void Recognizer::generateCode(CodeGenerator &gen, const string &pos, const string &result, bool topLevel) {
+	if (!topLevel && !mName.empty() && typeid(*this) != typeid(RecognizerPointer)) {
+		/* We are referencing another rule of the grammar, which is generated as a function of its own.*/
+		gen.generateRuleCall(this, pos, result);
+		return;
+	}
+	_generateCode(gen, pos, result);
+}
+
+bool Recognizer::getCharClass(TransitionMap *mask) {
+	return mName.empty() && _getCharClass(mask);
+}
+
+bool Recognizer::_getCharClass(BCTBX_UNUSED(TransitionMap *mask)) {
+	return false;
+}
+
 bool Recognizer::getTransitionMap(TransitionMap *mask) {
 	bool ret = _getTransitionMap(mask);
 	if (0 /*!mName.empty()*/) {
@@ -279,6 +297,18 @@ void CharRecognizer::_serialize(BinaryOutputStream &fstr) {
 	fstr << (unsigned char)mCaseSensitive;
 }
 
+void CharRecognizer::_generateCode(CodeGenerator &gen, const string &pos, const string &result) {
+	TransitionMap chars;
+	_getCharClass(&chars);
+	gen.generateCharClass(chars, pos, result);
+}
+
+bool CharRecognizer::_getCharClass(TransitionMap *mask) {
+	mask->mPossibleChars[mToRecognize] = true;
+	if (!mCaseSensitive) mask->mPossibleChars[::toupper(mToRecognize)] = true;
+	return true;
+}
+
 CharRecognizer::CharRecognizer(BinaryGrammarBuilder &istr) : Recognizer(istr) {
 	unsigned char toRecognize;
 	istr >> toRecognize;
@@ -348,6 +378,65 @@ void Selector::_serialize(BinaryOutputStream &fstr) {
 	}
 }
 
+void Selector::_generateCode(CodeGenerator &gen, const string &pos, const string &result) {
+	TransitionMap chars;
+	if (_getCharClass(&chars)) {
+		gen.generateCharClass(chars, pos, result);
+		return;
+	}
+	if (mIsExclusive) {
+		gen.line() << result << " = npos;\n";
+		gen.line() << "do {\n";
+		gen.indent();
+		for (auto it = mElements.begin(); it != mElements.end(); ++it) {
+			string matched = gen.newVariable("m");
+			gen.line() << "size_t " << matched << ";\n";
+			gen.generateUndoable(**it, pos, matched);
+			gen.line() << "if (" << matched << " != npos && " << matched << " > 0) {\n";
+			gen.line() << "\t" << result << " = " << matched << ";\n";
+			gen.line() << "\tbreak;\n";
+			gen.line() << "}\n";
+		}
+		gen.unindent();
+		gen.line() << "} while (0);\n";
+		return;
+	}
+
+	string bestBranch = gen.newVariable("b");
+	gen.useContext();
+	gen.line() << result << " = npos;\n";
+	gen.line() << "std::shared_ptr<HandlerContextBase> " << bestBranch << ";\n";
+	for (auto it = mElements.begin(); it != mElements.end(); ++it) {
+		string branch = gen.newVariable("b");
+		string matched = gen.newVariable("m");
+		gen.line() << "{\n";
+		gen.indent();
+		gen.line() << "std::shared_ptr<HandlerContextBase> " << branch << " = ctx.branch();\n";
+		gen.line() << "size_t " << matched << ";\n";
+		(*it)->generateCode(gen, pos, matched);
+		gen.line() << "if (" << matched << " != npos && (" << matched << " > " << result << " || " << result
+		           << " == npos)) {\n";
+		gen.line() << "\t" << result << " = " << matched << ";\n";
+		gen.line() << "\tif (" << bestBranch << ") ctx.removeBranch(" << bestBranch << ");\n";
+		gen.line() << "\t" << bestBranch << " = " << branch << ";\n";
+		gen.line() << "} else {\n";
+		gen.line() << "\tctx.removeBranch(" << branch << ");\n";
+		gen.line() << "}\n";
+		gen.unindent();
+		gen.line() << "}\n";
+	}
+	gen.line() << "if (" << result << " != npos) ctx.merge(" << bestBranch << ");\n";
+}
+
+/* A selector whose all elements match a single character is itself a set of characters, that generated code
+ * recognizes with a lookup instead of trying each element in turn. */
+bool Selector::_getCharClass(TransitionMap *mask) {
+	for (auto it = mElements.begin(); it != mElements.end(); ++it) {
+		if (!(*it)->getCharClass(mask)) return false;
+	}
+	return !mElements.empty();
+}
+
 Selector::Selector(BinaryGrammarBuilder &istr) : Recognizer(istr) {
 	unsigned char tmp;
 	istr >> tmp;
@@ -446,6 +535,24 @@ void Sequence::_serialize(BinaryOutputStream &fstr) {
 	}
 }
 
+void Sequence::_generateCode(CodeGenerator &gen, const string &pos, const string &result) {
+	string current = gen.newVariable("p");
+	gen.line() << result << " = npos;\n";
+	gen.line() << "do {\n";
+	gen.indent();
+	gen.line() << "size_t " << current << " = " << pos << ";\n";
+	for (auto it = mElements.begin(); it != mElements.end(); ++it) {
+		string matched = gen.newVariable("m");
+		gen.line() << "size_t " << matched << ";\n";
+		(*it)->generateCode(gen, current, matched);
+		gen.line() << "if (" << matched << " == npos) break;\n";
+		gen.line() << current << " += " << matched << ";\n";
+	}
+	gen.line() << result << " = " << current << " - " << pos << ";\n";
+	gen.unindent();
+	gen.line() << "} while (0);\n";
+}
+
 Sequence::Sequence(BinaryGrammarBuilder &istr) : Recognizer(istr) {
 	int count;
 	istr >> count;
@@ -492,6 +599,36 @@ void Loop::_serialize(BinaryOutputStream &fstr) {
 	mRecognizer->serialize(fstr);
 }
 
+void Loop::_generateCode(CodeGenerator &gen, const string &pos, const string &result) {
+	string current = gen.newVariable("p");
+	string matched = gen.newVariable("m");
+	string repeat = gen.newVariable("r");
+	bool counted = mMin > 0 || mMax != -1;
+
+	gen.line() << "size_t " << current << " = " << pos << ";\n";
+	if (counted) {
+		gen.line() << "int " << repeat << ";\n";
+		ostream &ostr = gen.line();
+		ostr << "for (" << repeat << " = 0; ";
+		if (mMax != -1) ostr << repeat << " < " << mMax << " && ";
+		ostr << "input[" << current << "] != '\\0'; " << repeat << "++) {\n";
+	} else {
+		gen.line() << "while (input[" << current << "] != '\\0') {\n";
+	}
+	gen.indent();
+	gen.line() << "size_t " << matched << ";\n";
+	gen.generateUndoable(*mRecognizer, current, matched);
+	gen.line() << "if (" << matched << " == npos) break;\n";
+	gen.line() << current << " += " << matched << ";\n";
+	gen.unindent();
+	gen.line() << "}\n";
+	if (mMin > 0) {
+		gen.line() << result << " = " << repeat << " < " << mMin << " ? npos : " << current << " - " << pos << ";\n";
+	} else {
+		gen.line() << result << " = " << current << " - " << pos << ";\n";
+	}
+}
+
 Loop::Loop(BinaryGrammarBuilder &istr) : Recognizer(istr) {
 	istr >> mMin;
 	istr >> mMax;
@@ -522,6 +659,18 @@ void CharRange::_serialize(BinaryOutputStream &fstr) {
 	fstr << end;
 }
 
+void CharRange::_generateCode(CodeGenerator &gen, const string &pos, const string &result) {
+	TransitionMap chars;
+	_getCharClass(&chars);
+	gen.generateCharClass(chars, pos, result);
+}
+
+bool CharRange::_getCharClass(TransitionMap *mask) {
+	for (int c = max(mBegin, 0); c <= min(mEnd, 255); ++c)
+		mask->mPossibleChars[c] = true;
+	return true;
+}
+
 CharRange::CharRange(BinaryGrammarBuilder &istr) : Recognizer(istr) {
 	unsigned char begin, end;
 	istr >> begin;
@@ -561,6 +710,23 @@ void Literal::_serialize(BinaryOutputStream &fstr) {
 	fstr << mLiteral;
 }
 
+void Literal::_generateCode(CodeGenerator &gen, const string &pos, const string &result) {
+	if (mLiteralSize == 0) {
+		gen.line() << result << " = 0;\n";
+		return;
+	}
+	ostream &ostr = gen.line();
+	ostr << result << " = (";
+	for (size_t i = 0; i < mLiteralSize; ++i) {
+		int c = (unsigned char)mLiteral[i];
+		if (i > 0) ostr << " && ";
+		/* The literal is lower case, and matched case insensitively. */
+		if (::islower(c)) ostr << "((unsigned char)input[" << pos << " + " << i << "] | 0x20) == " << c;
+		else ostr << "(unsigned char)input[" << pos << " + " << i << "] == " << c;
+	}
+	ostr << ") ? " << mLiteralSize << " : npos;\n";
+}
+
 Literal::Literal(BinaryGrammarBuilder &istr) : Recognizer(istr) {
 	istr >> mLiteral;
 	mLiteralSize = mLiteral.size();
@@ -604,6 +770,10 @@ void RecognizerPointer::_serialize(BCTBX_UNUSED(BinaryOutputStream &fstr)) {
 //	//nothing to do
 // }
 
+void RecognizerPointer::_generateCode(CodeGenerator &gen, const string &pos, const string &result) {
+	mRecognizer->generateCode(gen, pos, result);
+}
+
 void RecognizerPointer::setPointed(const shared_ptr<Recognizer> &r) {
 	mRecognizer = r;
 }
@@ -630,6 +800,10 @@ void RecognizerAlias::_serialize(BinaryOutputStream &fstr) {
 	mRecognizer->serialize(fstr);
 }
 
+void RecognizerAlias::_generateCode(CodeGenerator &gen, const string &pos, const string &result) {
+	mRecognizer->generateCode(gen, pos, result);
+}
+
 RecognizerAlias::RecognizerAlias(BinaryGrammarBuilder &istr) : Recognizer(istr) {
 	mRecognizer = Recognizer::build(istr);
 }
@@ -643,6 +817,43 @@ void RecognizerAlias::_optimize(BCTBX_UNUSED(int recursionLevel)) {
 	 * The grammar will do it for all rules anyway*/
 }
 
+NativeRule::NativeRule(Function function, const RuleTable *rules) : mFunction(function), mRules(rules) {
+}
+
+size_t
+NativeRule::invoke(const RuleTable &rules, size_t index, ParserContextBase &ctx, const string &input, size_t pos) {
+	/* Same as Recognizer::feed(), without the cost of the virtual call and of shared_from_this(). */
+	const shared_ptr<Recognizer> &rule = rules[index];
+	ParserLocalContext hctx;
+	ctx.beginParse(hctx, rule);
+	size_t match = static_cast<NativeRule *>(rule.get())->mFunction(rules, ctx, input, pos);
+	ctx.endParse(hctx, input, pos, match);
+	return match;
+}
+
+const shared_ptr<Recognizer> &NativeRule::getAnonymous() {
+	static const shared_ptr<Recognizer> anonymous = make_shared<Sequence>();
+	return anonymous;
+}
+
+size_t NativeRule::_feed(ParserContextBase &ctx, const string &input, size_t pos) {
+	return mFunction(*mRules, ctx, input, pos);
+}
+
+void NativeRule::_optimize(BCTBX_UNUSED(int recursionLevel)) {
+	/*the generated code is already optimized*/
+}
+
+void NativeRule::_serialize(BCTBX_UNUSED(BinaryOutputStream &fstr)) {
+	bctbx_fatal("The NativeRule '%s' is not supposed to be serialized.", mName.c_str());
+}
+
+void NativeRule::_generateCode(CodeGenerator &gen,
+                               BCTBX_UNUSED(const string &pos),
+                               BCTBX_UNUSED(const string &result)) {
+	gen.setError("Rule '" + mName + "' is already compiled into native code.");
+}
+
 Grammar::Grammar(const string &name) : mName(name) {
 }
 
@@ -726,6 +937,8 @@ void Grammar::include(const shared_ptr<Grammar> &grammar) {
 		}
 		mRules[(*it).first] = (*it).second;
 	}
+	mNativeRuleTables.insert(mNativeRuleTables.end(), grammar->mNativeRuleTables.begin(),
+	                         grammar->mNativeRuleTables.end());
 }
 
 bool Grammar::isComplete() const {
@@ -819,6 +1032,37 @@ int Grammar::load(const std::string &filename) {
 	return err;
 }
 
+int Grammar::generateCode(const std::string &filename, const std::string &functionName) {
+	if (!isComplete()) {
+		BCTBX_SLOGE << "Cannot generate code for the incomplete grammar '" << mName << "'";
+		return -1;
+	}
+	ostringstream code;
+	CodeGenerator gen(code);
+	gen.generateGrammar(mName, functionName, mRules);
+	if (gen.hasError()) return -1;
+
+	ofstream of(filename, ofstream::out | ofstream::trunc);
+	if (of.fail()) {
+		BCTBX_SLOGE << "Could not open " << filename;
+		return -1;
+	}
+	of << code.str();
+	of.close();
+	return of.fail() ? -1 : 0;
+}
+
+void Grammar::addNativeRules(const NativeRule::Definition *definitions, size_t count) {
+	auto rules = make_shared<NativeRule::RuleTable>();
+	rules->reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		shared_ptr<Recognizer> rule = make_shared<NativeRule>(definitions[i].function, rules.get());
+		rules->push_back(rule);
+		addRule(definitions[i].name, rule);
+	}
+	mNativeRuleTables.push_back(rules);
+}
+
 string tolower(const string &str) {
 	string ret(str);
 	transform(ret.begin(), ret.end(), ret.begin(), ::tolower);
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2016-2019 Belledonne Communications SARL.
+ *
+ * This file is part of belr - a language recognition library for ABNF-defined grammars.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cctype>
+#include <sstream>
+#include <typeinfo>
+
+#include "belr/belr.h"
+#include "codegen.h"
+#include "common.h"
+
+using namespace std;
+
+namespace belr {
+
+CodeGenerator::CodeGenerator(ostream &ostr) : mOutput(ostr) {
+}
+
+void CodeGenerator::addRule(const Recognizer *rule, size_t index) {
+	/*if a recognizer is shared by several rules, keep invoking the first one*/
+	mRuleIndexes.emplace(rule, index);
+}
+
+string CodeGenerator::newVariable(const char *prefix) {
+	ostringstream ostr;
+	ostr << prefix << mVariableCount++;
+	return ostr.str();
+}
+
+ostream &CodeGenerator::line() {
+	for (int i = 0; i < mIndentation; ++i)
+		mOutput << '\t';
+	return mOutput;
+}
+
+void CodeGenerator::indent() {
+	mIndentation++;
+}
+
+void CodeGenerator::unindent() {
+	mIndentation--;
+}
+
+static string quote(const string &str) {
+	string ret("\"");
+	for (auto c : str) {
+		if (c == '"' || c == '\\') ret.push_back('\\');
+		ret.push_back(c);
+	}
+	ret.push_back('"');
+	return ret;
+}
+
+static void generatePrototype(ostream &ostr, size_t index) {
+	ostr << "static size_t rule" << index
+	     << "(const NativeRule::RuleTable &rules, ParserContextBase &ctx, const std::string &input, size_t pos)";
+}
+
+void CodeGenerator::generateGrammar(const string &name,
+                                    const string &functionName,
+                                    const map<string, shared_ptr<Recognizer>> &rules) {
+	size_t index;
+
+	mOutput << "/*\n * Generated by belr-compiler from grammar " << quote(name) << ", do not edit.\n */\n\n";
+	mOutput << "#include <memory>\n#include <string>\n\n#include \"belr/parser.h\"\n\n";
+	mOutput << "using namespace belr;\n\n";
+	mOutput << "static const size_t npos = std::string::npos;\n\n";
+
+	index = 0;
+	for (auto it = rules.begin(); it != rules.end(); ++it, ++index) {
+		addRule((*it).second.get(), index);
+		generatePrototype(mOutput, index);
+		mOutput << ";\n";
+	}
+	mOutput << "\n";
+
+	index = 0;
+	for (auto it = rules.begin(); it != rules.end() && !mError; ++it, ++index) {
+		mOutput << "/* " << (*it).first << " */\n";
+		generatePrototype(mOutput, index);
+		mOutput << " {\n";
+		indent();
+		mContextUsed = false;
+		string result = newVariable("m");
+		line() << "size_t " << result << ";\n";
+		(*it).second->generateCode(*this, "pos", result, true);
+		if (!mContextUsed) {
+			line() << "(void)rules;\n";
+			line() << "(void)ctx;\n";
+		}
+		line() << "return " << result << ";\n";
+		unindent();
+		mOutput << "}\n\n";
+	}
+
+	mOutput << "std::shared_ptr<Grammar> " << functionName << "() {\n";
+	indent();
+	line() << "static const NativeRule::Definition definitions[] = {\n";
+	indent();
+	index = 0;
+	for (auto it = rules.begin(); it != rules.end(); ++it, ++index) {
+		line() << "{" << quote((*it).first) << ", rule" << index << "},\n";
+	}
+	unindent();
+	line() << "};\n";
+	line() << "auto grammar = std::make_shared<Grammar>(" << quote(name) << ");\n";
+	line() << "grammar->addNativeRules(definitions, sizeof(definitions) / sizeof(definitions[0]));\n";
+	line() << "return grammar;\n";
+	unindent();
+	mOutput << "}\n";
+}
+
+void CodeGenerator::generateRuleCall(const Recognizer *rule, const string &pos, const string &result) {
+	auto it = mRuleIndexes.find(rule);
+	if (it == mRuleIndexes.end()) {
+		setError("Recognizer '" + rule->getName() + "' is not a rule of the grammar.");
+		return;
+	}
+	mContextUsed = true;
+	line() << result << " = NativeRule::invoke(rules, " << (*it).second << ", ctx, input, " << pos << ");\n";
+}
+
+void CodeGenerator::generateUndoable(Recognizer &rec, const string &pos, const string &result) {
+	/* Only sequences and loops may fail after some of their sub-recognizers did assignments. The other recognizers
+	 * either assign nothing, or are rules and selectors that already cleanup after themselves. */
+	if (!rec.getName().empty() || (typeid(rec) != typeid(Sequence) && typeid(rec) != typeid(Loop))) {
+		rec.generateCode(*this, pos, result);
+		return;
+	}
+	string frame = newVariable("f");
+	mContextUsed = true;
+	line() << "ParserLocalContext " << frame << ";\n";
+	line() << "ctx.beginParse(" << frame << ", NativeRule::getAnonymous());\n";
+	rec.generateCode(*this, pos, result);
+	line() << "ctx.endParse(" << frame << ", input, " << pos << ", " << result << ");\n";
+}
+
+void CodeGenerator::generateCharClass(const TransitionMap &chars, const string &pos, const string &result) {
+	int first = -1, last = -1, count = 0;
+	bool contiguous = true;
+
+	for (int i = 0; i < 256; ++i) {
+		if (!chars.mPossibleChars[i]) continue;
+		if (first == -1) first = i;
+		else if (last != i - 1) contiguous = false;
+		last = i;
+		count++;
+	}
+
+	string c = "(unsigned char)input[" + pos + "]";
+	ostringstream condition;
+	if (count == 0) {
+		line() << result << " = npos;\n";
+		return;
+	}
+	if (contiguous && first == last) {
+		condition << c << " == " << first;
+	} else if (contiguous) {
+		condition << c << " >= " << first << " && " << c << " <= " << last;
+	} else if (count == 2 && ::isupper(first) && last == ::tolower(first)) {
+		/*a case insensitive letter*/
+		condition << "(" << c << " | 0x20) == " << last;
+	} else {
+		string table = newVariable("c");
+		line() << "static const unsigned char " << table << "[32] = {";
+		for (int i = 0; i < 32; ++i) {
+			unsigned int byte = 0;
+			for (int bit = 0; bit < 8; ++bit) {
+				if (chars.mPossibleChars[i * 8 + bit]) byte |= 1U << bit;
+			}
+			mOutput << (i ? ", " : "") << byte;
+		}
+		mOutput << "};\n";
+		condition << table << "[" << c << " >> 3] & (1 << (" << c << " & 7))";
+	}
+	line() << result << " = (" << condition.str() << ") ? 1 : npos;\n";
+}
+
+void CodeGenerator::useContext() {
+	mContextUsed = true;
+}
+
+void CodeGenerator::setError(const string &message) {
+	BCTBX_SLOGE << message;
+	mError = true;
+}
+
+bool CodeGenerator::hasError() const {
+	return mError;
+}
+
+} // namespace belr
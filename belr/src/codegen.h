@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2016-2019 Belledonne Communications SARL.
+ *
+ * This file is part of belr - a language recognition library for ABNF-defined grammars.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef codegen_h
+#define codegen_h
+
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace belr {
+
+class Recognizer;
+struct TransitionMap;
+
+/**
+ * The CodeGenerator is used internally to write the C++ source of a grammar compiled by Grammar::generateCode().
+ * Each recognizer writes the statements that compute how many characters it matches, rules being compiled into
+ * functions invoking each other through NativeRule::invoke().
+ **/
+class CodeGenerator {
+public:
+	CodeGenerator(std::ostream &ostr);
+
+	void addRule(const Recognizer *rule, size_t index);
+	/*returns a variable name that is unique in the generated file*/
+	std::string newVariable(const char *prefix);
+	/*starts a new line at the current indentation level*/
+	std::ostream &line();
+	void indent();
+	void unindent();
+
+	/*generates the whole source file of a grammar*/
+	void generateGrammar(const std::string &name,
+	                     const std::string &functionName,
+	                     const std::map<std::string, std::shared_ptr<Recognizer>> &rules);
+	void generateRuleCall(const Recognizer *rule, const std::string &pos, const std::string &result);
+	/*generates a recognizer whose assignments must be undone if it doesn't match, as the interpreter does.*/
+	void generateUndoable(Recognizer &rec, const std::string &pos, const std::string &result);
+	void generateCharClass(const TransitionMap &chars, const std::string &pos, const std::string &result);
+	void useContext();
+
+	void setError(const std::string &message);
+	bool hasError() const;
+
+private:
+	std::ostream &mOutput;
+	std::map<const Recognizer *, size_t> mRuleIndexes;
+	unsigned int mVariableCount = 0;
+	int mIndentation = 0;
+	bool mContextUsed = false;
+	bool mError = false;
+};
+
+} // namespace belr
+
+#endif
@@ -115,6 +115,9 @@ void belr_tester_init(void (*ftester_printf)(int level, const char *fmt, va_list
 
 	bc_tester_add_suite(&grammar_suite);
 	bc_tester_add_suite(&parser_suite);
+#ifdef HAVE_GENERATED_GRAMMARS
+	bc_tester_add_suite(&codegen_suite);
+#endif
 }
 
 void belr_tester_uninit(void) {
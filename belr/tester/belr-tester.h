@@ -45,6 +45,9 @@ extern "C" {
 
 extern test_suite_t grammar_suite;
 extern test_suite_t parser_suite;
+#ifdef HAVE_GENERATED_GRAMMARS
+extern test_suite_t codegen_suite;
+#endif
 
 void belr_tester_init(void (*ftester_printf)(int level, const char *fmt, va_list args));
 void belr_tester_uninit(void);
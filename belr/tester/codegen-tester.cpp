@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2016-2019 Belledonne Communications SARL.
+ *
+ * This file is part of belr - a language recognition library for ABNF-defined grammars.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "bctoolbox/logging.h"
+#include "belr-tester.h"
+#include "belr/parser.h"
+
+using namespace ::std;
+using namespace ::belr;
+
+/* Defined by the sources generated by belr-compiler from the grammars of the tester resources. */
+shared_ptr<Grammar> belr_tester_sipgrammar();
+shared_ptr<Grammar> belr_tester_vcardgrammar();
+
+static const int benchmarkIterations = 50;
+
+static string parseToString(const shared_ptr<Grammar> &grammar,
+                            const list<string> &observedRules,
+                            const string &rulename,
+                            const string &input,
+                            size_t *parsed) {
+	DebugParser parser(grammar);
+	parser.setObservedRules(observedRules);
+	shared_ptr<DebugElement> elem = parser.parseInput(rulename, input, parsed);
+	ostringstream ostr;
+	if (elem) elem->tostream(0, ostr);
+	return ostr.str();
+}
+
+static double benchmark(const shared_ptr<Grammar> &grammar,
+                        const list<string> &observedRules,
+                        const string &rulename,
+                        const string &input) {
+	DebugParser parser(grammar);
+	parser.setObservedRules(observedRules);
+	size_t parsed = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < benchmarkIterations; ++i) {
+		parser.parseInput(rulename, input, &parsed);
+	}
+	std::chrono::duration<double, std::micro> elapsed = std::chrono::high_resolution_clock::now() - start;
+	return elapsed.count() / benchmarkIterations;
+}
+
+/* The compiled grammar must build the same objects as the interpreted one, and is expected to do it faster. */
+static void compareWithInterpreted(const shared_ptr<Grammar> &interpreted,
+                                   const shared_ptr<Grammar> &compiled,
+                                   const list<string> &observedRules,
+                                   const string &rulename,
+                                   const string &input) {
+	size_t interpretedParsed = 0, compiledParsed = 0;
+	string interpretedResult = parseToString(interpreted, observedRules, rulename, input, &interpretedParsed);
+	string compiledResult = parseToString(compiled, observedRules, rulename, input, &compiledParsed);
+
+	BC_ASSERT_EQUAL((int)compiledParsed, (int)interpretedParsed, int, "%i");
+	BC_ASSERT_TRUE(compiledResult == interpretedResult);
+
+	double interpretedTime = benchmark(interpreted, observedRules, rulename, input);
+	double compiledTime = benchmark(compiled, observedRules, rulename, input);
+	bctbx_message("Rule '%s' on %i bytes: interpreted %.1f us, compiled %.1f us (x%.2f)", rulename.c_str(),
+	              (int)input.size(), interpretedTime, compiledTime, interpretedTime / compiledTime);
+}
+
+static void sipgrammar_compiled(void) {
+	ABNFGrammarBuilder builder;
+	shared_ptr<Grammar> interpreted =
+	    builder.createFromAbnfFile(bcTesterRes("sipgrammar.txt"), make_shared<CoreRules>());
+	BC_ASSERT_PTR_NOT_NULL(interpreted);
+	if (!interpreted) return;
+	shared_ptr<Grammar> compiled = belr_tester_sipgrammar();
+	BC_ASSERT_TRUE(compiled->isComplete());
+	BC_ASSERT_EQUAL(compiled->getNumRules(), interpreted->getNumRules(), int, "%i");
+
+	list<string> observedRules = {"sip-message",   "request-line", "status-line", "method", "sip-uri",
+	                              "user",          "host",         "port",        "from",   "to",
+	                              "name-addr",     "via",          "via-parm",    "header-name",
+	                              "generic-param", "extension-header"};
+	string registerMessage = openFile(bcTesterRes("register.txt"));
+	string responseMessage = openFile(bcTesterRes("response.txt"));
+	BC_ASSERT_TRUE(registerMessage.size() > 0);
+	BC_ASSERT_TRUE(responseMessage.size() > 0);
+
+	compareWithInterpreted(interpreted, compiled, observedRules, "sip-message", registerMessage);
+	compareWithInterpreted(interpreted, compiled, observedRules, "sip-message", responseMessage);
+	/* Partial matches must stop at the same position. */
+	compareWithInterpreted(interpreted, compiled, observedRules, "sip-message",
+	                       registerMessage.substr(0, registerMessage.size() / 2));
+	compareWithInterpreted(interpreted, compiled, observedRules, "sip-uri", "sip:smorlat2@78.220.48.77:41076;x=y?z");
+}
+
+static void vcardgrammar_compiled(void) {
+	ABNFGrammarBuilder builder;
+	shared_ptr<Grammar> interpreted =
+	    builder.createFromAbnfFile(bcTesterRes("vcardgrammar.txt"), make_shared<CoreRules>());
+	BC_ASSERT_PTR_NOT_NULL(interpreted);
+	if (!interpreted) return;
+	shared_ptr<Grammar> compiled = belr_tester_vcardgrammar();
+	BC_ASSERT_TRUE(compiled->isComplete());
+	BC_ASSERT_EQUAL(compiled->getNumRules(), interpreted->getNumRules(), int, "%i");
+
+	list<string> observedRules = {"vcard-entity", "vcard", "contentline", "group", "name", "param", "value"};
+	string vcard = "BEGIN:VCARD\r\n"
+	               "VERSION:4.0\r\n"
+	               "FN:Sylvain Berfini\r\n"
+	               "N:Berfini;Sylvain;;;\r\n"
+	               "TEL;TYPE=work,voice;VALUE=uri:tel:+33-4-00-00-00-00\r\n"
+	               "EMAIL;PREF=1:sylvain@example.org\r\n"
+	               "item1.IMPP:sip:sylvain@sip.example.org\r\n"
+	               "END:VCARD\r\n";
+
+	compareWithInterpreted(interpreted, compiled, observedRules, "vcard-entity", vcard);
+	compareWithInterpreted(interpreted, compiled, observedRules, "vcard-entity", vcard + vcard);
+}
+
+static void compiled_grammar_cannot_be_compiled(void) {
+	shared_ptr<Grammar> compiled = belr_tester_vcardgrammar();
+	string output = bcTesterFile("compiledGrammar.cc");
+	BC_ASSERT_TRUE(compiled->generateCode(output, "compiled") != 0);
+	remove(output.c_str());
+}
+
+static test_t tests[] = {
+    TEST_NO_TAG("SIP grammar compiled to C++", sipgrammar_compiled),
+    TEST_NO_TAG("vCard grammar compiled to C++", vcardgrammar_compiled),
+    TEST_NO_TAG("Compiled grammar cannot be compiled again", compiled_grammar_cannot_be_compiled)};
+
+test_suite_t codegen_suite = {"Code generation", NULL, NULL, NULL, NULL, sizeof(tests) / sizeof(tests[0]), tests,
+                              0, 0};
@@ -17,6 +17,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstring>
+
 #include "belr/abnf.h"
 #include "belr/grammarbuilder.h"
 
@@ -24,14 +26,22 @@ using namespace std;
 using namespace belr;
 
 int main(int argc, char *argv[]) {
-	string file, ofile;
+	string file, ofile, functionName;
+	int i = 1;
 
-	if (argc < 3) {
-		cerr << argv[0] << " <grammar file to load> <output filename>" << endl;
+	if (argc > 2 && strcmp(argv[1], "--cpp") == 0) {
+		functionName = argv[2];
+		i = 3;
+	}
+	if (argc - i < 2) {
+		cerr << argv[0] << " [--cpp <function name>] <grammar file to load> <output filename>" << endl;
+		cerr << "\t--cpp <function name>: instead of a binary grammar, output the C++ source of a recognizer for the grammar,"
+		     << endl
+		     << "\t                      defining 'std::shared_ptr<belr::Grammar> <function name>()'." << endl;
 		return -1;
 	}
-	file = argv[1];
-	ofile = argv[2];
+	file = argv[i];
+	ofile = argv[i + 1];
 	// Create a GrammarBuilder:
 	ABNFGrammarBuilder builder;
 	// construct the grammar from the grammar file, the core rules are included since required by most RFCs.
@@ -41,6 +51,9 @@ int main(int argc, char *argv[]) {
 		cerr << "Fail to create grammar." << endl;
 		return -1;
 	}
+	if (!functionName.empty()) {
+		return grammar->generateCode(ofile, functionName) == 0 ? 0 : -1;
+	}
 	if (grammar->save(ofile) != 0) {
 		return -1;
 	}
@@ -729,6 +729,18 @@ BZRTP_EXPORT uint8_t bzrtp_available_key_agreement(uint8_t availableTypes[256]);
  */
 BZRTP_EXPORT bool_t bzrtp_is_PQ_available(void);
 
+/**
+ * @brief Set the number of key agreement contexts kept ready in the background pool
+ * When enabled, a worker thread pre-generates the ephemeral key pairs (DH, ECDH and KEM) used to build
+ * Commit and DHPart messages, for each key agreement in use, so they are not computed while processing packets.
+ * The pool is process wide and shared by all ZRTP sessions.
+ *
+ * @param[in]	poolSize	number of key pairs kept ready per key agreement in use, 0 disables the pool and frees its content
+ *
+ * @return 0 on success
+ */
+BZRTP_EXPORT int bzrtp_setKeyAgreementPoolSize(uint8_t poolSize);
+
 /**
  * @brief Create a GoClear event and send it to the state machine
  * The user is in secure state.
@@ -342,6 +342,24 @@ int bzrtp_KEM_decaps(bzrtp_KEMContext_t *ctx, uint8_t *cipherText);
  * @return 0 on success
  */
 int bzrtp_destroyKEMContext(bzrtp_KEMContext_t *ctx);
+
+/**
+ * Take a context holding a freshly generated key pair from the background key agreement pool
+ * The requested key agreement is registered in the pool so it gets refilled for the next call.
+ *
+ * @param[in]	keyAgreementAlgo	the key agreement algorithm
+ * @param[in]	param				secret length in bytes for DH, hash algorithm for KEM, 0 for ECDH
+ *
+ * @return a bctbx_DHMContext_t, bctbx_ECDHContext_t or bzrtp_KEMContext_t pointer, NULL when the pool is disabled or empty
+ */
+void *bzrtp_keyAgreementPool_get(uint8_t keyAgreementAlgo, uint8_t param);
+
+/**
+ * Get the number of contexts taken from the background key agreement pool since the process started
+ *
+ * @return the number of bzrtp_keyAgreementPool_get calls which returned a pre-generated context
+ */
+uint64_t bzrtp_keyAgreementPool_getHitCount(void);
 #ifdef __cplusplus
 }
 #endif
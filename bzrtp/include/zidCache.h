@@ -25,6 +25,21 @@
 extern "C"{
 #endif
 
+/**
+ * @brief Bind a bzrtp context to a cache database: the statements run on behalf of contexts are kept prepared
+ *		until the last context bound to this database is unbound.
+ *
+ * @param[in]	dbPointer	the opened sqlite database pointer, ignored if NULL
+ */
+void bzrtp_cache_bindContext(void *dbPointer);
+
+/**
+ * @brief Unbind a bzrtp context from a cache database, finalize the prepared statements when it was the last one bound
+ *
+ * @param[in]	dbPointer	the opened sqlite database pointer, ignored if NULL
+ */
+void bzrtp_cache_unbindContext(void *dbPointer);
+
 /**
  * @brief Parse the cache to find secrets associated to the given ZID, set them and their length in the context if they are found 
  *		Note: this function also retrieve zuid(set in the context) wich allow successive calls to cache operation to be faster.
@@ -99,6 +99,7 @@ bzrtpContext_t *bzrtp_createBzrtpContext(void) {
 	context->cachedSecret.auxsecret = NULL;
 	context->cachedSecret.auxsecretLength = 0;
 	context->cacheMismatchFlag = 0;
+	context->pendingPVS = 0;
 	context->peerPVS = 0;
 
 	/* initialise transient shared auxiliary secret buffer */
@@ -135,7 +136,11 @@ int bzrtp_setZIDCache(bzrtpContext_t *context, void *zidCache, const char *selfU
 	}
 
 	/* zidCache pointer is actually a pointer to sqlite3 db, store it in context */
-	context->zidCache = (sqlite3 *)zidCache;
+	if (context->zidCache != (sqlite3 *)zidCache) {
+		bzrtp_cache_unbindContext(context->zidCache);
+		context->zidCache = (sqlite3 *)zidCache;
+		bzrtp_cache_bindContext(context->zidCache);
+	}
 	if (context->selfURI != NULL) {
 		free(context->selfURI);
 	}
@@ -325,6 +330,9 @@ int bzrtp_destroyBzrtpContext(bzrtpContext_t *context, uint32_t selfSSRC) {
 	free(context->selfURI);
 	free(context->peerURI);
 
+	/* release the prepared statements this context may hold on the cache database */
+	bzrtp_cache_unbindContext(context->zidCache);
+
 	/* transient shared auxiliary secret */
 	if (context->transientAuxSecret != NULL) {
 		bzrtp_DestroyKey(context->transientAuxSecret, context->transientAuxSecretLength, context->RNGContext);
@@ -611,12 +619,16 @@ void bzrtp_SASVerified(bzrtpContext_t *zrtpContext) {
 		uint8_t *colValues[] = {&pvsFlag};
 		size_t colLength[] = {1};
 
-		/* check if we must update the cache(delayed until sas verified in case of cache mismatch) */
+		zrtpContext->pendingPVS = 1;
+		/* check if we must update the cache(delayed until sas verified in case of cache mismatch), the pvs flag is then written along the retained secrets */
 		if (zrtpContext->cacheMismatchFlag  == 1) {
 			zrtpContext->cacheMismatchFlag  = 0;
 			bzrtp_updateCachedSecrets(zrtpContext, zrtpContext->channelContext[0]); /* channel[0] is the only one in DHM mode, so the only one able to have a cache mismatch */
 		}
-		bzrtp_cache_write_lock(zrtpContext->zidCache, zrtpContext->zuid, "zrtp", colNames, colValues, colLength, 1, zrtpContext->zidCacheMutex);
+		if (zrtpContext->pendingPVS == 1) {
+			zrtpContext->pendingPVS = 0;
+			bzrtp_cache_write_lock(zrtpContext->zidCache, zrtpContext->zuid, "zrtp", colNames, colValues, colLength, 1, zrtpContext->zidCacheMutex);
+		}
 	}
 }
 
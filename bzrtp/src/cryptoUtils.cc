@@ -22,6 +22,11 @@
 #include <string.h>
 #include <list>
 #include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
 
 #include "cryptoUtils.h"
 #include "bctoolbox/crypto.hh"
@@ -1712,3 +1717,171 @@ int bzrtp_destroyKEMContext(bzrtp_KEMContext_t *ctx) {
 }
 
 #endif /* HAVE_BCTBXPQ */
+
+/* Key agreement pool: a background thread keeps a few contexts holding a freshly generated key pair
+ * for each key agreement in use, so the packet builder does not have to generate them on the media path */
+namespace {
+
+void *bzrtp_createKeyAgreementContext(uint8_t keyAgreementAlgo, uint8_t param, bctbx_rng_context_t *RNGContext) {
+	switch (keyAgreementAlgo) {
+	case ZRTP_KEYAGREEMENT_DH2k:
+	case ZRTP_KEYAGREEMENT_DH3k: {
+		bctbx_DHMContext_t *DHMContext = bctbx_CreateDHMContext((keyAgreementAlgo == ZRTP_KEYAGREEMENT_DH2k)?BCTBX_DHM_2048:BCTBX_DHM_3072, param);
+		if (DHMContext != NULL) {
+			bctbx_DHMCreatePublic(DHMContext, (int (*)(void *, uint8_t *, size_t))bctbx_rng_get, RNGContext);
+		}
+		return DHMContext;
+	}
+	case ZRTP_KEYAGREEMENT_X255:
+	case ZRTP_KEYAGREEMENT_X448: {
+		bctbx_ECDHContext_t *ECDHContext = bctbx_CreateECDHContext((keyAgreementAlgo == ZRTP_KEYAGREEMENT_X255)?BCTBX_ECDH_X25519:BCTBX_ECDH_X448);
+		if (ECDHContext != NULL) {
+			bctbx_ECDHCreateKeyPair(ECDHContext, (int (*)(void *, uint8_t *, size_t))bctbx_rng_get, RNGContext);
+		}
+		return ECDHContext;
+	}
+	default: {
+		bzrtp_KEMContext_t *KEMContext = bzrtp_createKEMContext(keyAgreementAlgo, param);
+		if (KEMContext != NULL && bzrtp_KEM_generateKeyPair(KEMContext) != 0) {
+			bzrtp_destroyKEMContext(KEMContext);
+			KEMContext = NULL;
+		}
+		return KEMContext;
+	}
+	}
+}
+
+void bzrtp_destroyKeyAgreementContext(uint8_t keyAgreementAlgo, void *context) {
+	if (bzrtp_isKem(keyAgreementAlgo)) {
+		bzrtp_destroyKEMContext((bzrtp_KEMContext_t *)context);
+	} else if (keyAgreementAlgo == ZRTP_KEYAGREEMENT_X255 || keyAgreementAlgo == ZRTP_KEYAGREEMENT_X448) {
+		bctbx_DestroyECDHContext((bctbx_ECDHContext_t *)context);
+	} else {
+		bctbx_DestroyDHMContext((bctbx_DHMContext_t *)context);
+	}
+}
+
+class KeyAgreementPool {
+public:
+	explicit KeyAgreementPool(size_t size) : mSize(size) {
+		mThread = std::thread(&KeyAgreementPool::run, this);
+	}
+
+	~KeyAgreementPool() {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mRunning = false;
+		}
+		mCondition.notify_all();
+		mThread.join();
+		for (auto &entry : mContexts) {
+			for (void *context : entry.second) {
+				bzrtp_destroyKeyAgreementContext(entry.first >> 8, context);
+			}
+		}
+	}
+
+	void setSize(size_t size) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mSize = size;
+		for (auto &entry : mContexts) {
+			while (entry.second.size() > mSize) {
+				bzrtp_destroyKeyAgreementContext(entry.first >> 8, entry.second.back());
+				entry.second.pop_back();
+			}
+		}
+		mCondition.notify_all();
+	}
+
+	/* Return a ready context or NULL, in any case register the key agreement so the worker keeps it filled */
+	void *take(uint8_t keyAgreementAlgo, uint8_t param) {
+		void *context = NULL;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			auto &contexts = mContexts[(uint16_t)((keyAgreementAlgo << 8) | param)];
+			if (!contexts.empty()) {
+				context = contexts.front();
+				contexts.pop_front();
+			}
+		}
+		mCondition.notify_one();
+		return context;
+	}
+
+private:
+	void run() {
+		bctbx_rng_context_t *RNGContext = bctbx_rng_context_new();
+		std::unique_lock<std::mutex> lock(mMutex);
+		while (mRunning) {
+			/* refill the emptiest queue first */
+			auto next = mContexts.end();
+			for (auto it = mContexts.begin(); it != mContexts.end(); ++it) {
+				if (it->second.size() < mSize && (next == mContexts.end() || it->second.size() < next->second.size())) {
+					next = it;
+				}
+			}
+			if (next == mContexts.end()) {
+				mCondition.wait(lock);
+				continue;
+			}
+
+			uint16_t key = next->first;
+			lock.unlock();
+			void *context = bzrtp_createKeyAgreementContext(key >> 8, key & 0xFF, RNGContext);
+			lock.lock();
+
+			if (context == NULL) { /* not supported by this build, stop trying until it is requested again */
+				mContexts.erase(key);
+			} else if (!mRunning || mContexts[key].size() >= mSize) {
+				bzrtp_destroyKeyAgreementContext(key >> 8, context);
+			} else {
+				mContexts[key].push_back(context);
+			}
+		}
+		lock.unlock();
+		bctbx_rng_context_free(RNGContext);
+	}
+
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	std::map<uint16_t, std::deque<void *>> mContexts; /* indexed by key agreement algo << 8 | param */
+	size_t mSize;
+	bool mRunning = true;
+	std::thread mThread;
+};
+
+std::mutex keyAgreementPoolMutex;
+KeyAgreementPool *keyAgreementPool = nullptr;
+uint64_t keyAgreementPoolHitCount = 0; /* protected by keyAgreementPoolMutex */
+
+} // namespace
+
+int bzrtp_setKeyAgreementPoolSize(uint8_t poolSize) {
+	std::lock_guard<std::mutex> lock(keyAgreementPoolMutex);
+	if (poolSize == 0) {
+		delete keyAgreementPool;
+		keyAgreementPool = nullptr;
+	} else if (keyAgreementPool == nullptr) {
+		keyAgreementPool = new KeyAgreementPool(poolSize);
+	} else {
+		keyAgreementPool->setSize(poolSize);
+	}
+	return 0;
+}
+
+void *bzrtp_keyAgreementPool_get(uint8_t keyAgreementAlgo, uint8_t param) {
+	std::lock_guard<std::mutex> lock(keyAgreementPoolMutex);
+	if (keyAgreementPool == nullptr) {
+		return NULL;
+	}
+	void *context = keyAgreementPool->take(keyAgreementAlgo, param);
+	if (context != NULL) {
+		keyAgreementPoolHitCount++;
+	}
+	return context;
+}
+
+uint64_t bzrtp_keyAgreementPool_getHitCount(void) {
+	std::lock_guard<std::mutex> lock(keyAgreementPoolMutex);
+	return keyAgreementPoolHitCount;
+}
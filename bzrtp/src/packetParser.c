@@ -1424,9 +1424,13 @@ bzrtpPacket_t *bzrtp_createZrtpPacket(bzrtpContext_t *zrtpContext, bzrtpChannelC
 
 			/* if the DH is of type KEM, generate now the key pair, store the KEM context in the  */
 			if (bzrtp_isKem(zrtpCommitMessage->keyAgreementAlgo)) {
-				bzrtp_KEMContext_t *KEMContext = bzrtp_createKEMContext(zrtpCommitMessage->keyAgreementAlgo, zrtpChannelContext->hashAlgo);
-				if (KEMContext != NULL) {
+				/* get a pre-generated key pair if the pool has one, generate it otherwise */
+				bzrtp_KEMContext_t *KEMContext = (bzrtp_KEMContext_t *)bzrtp_keyAgreementPool_get(zrtpCommitMessage->keyAgreementAlgo, zrtpChannelContext->hashAlgo);
+				if (KEMContext == NULL) {
+					KEMContext = bzrtp_createKEMContext(zrtpCommitMessage->keyAgreementAlgo, zrtpChannelContext->hashAlgo);
 					bzrtp_KEM_generateKeyPair(KEMContext);
+				}
+				if (KEMContext != NULL) {
 					uint16_t pvLength = bzrtp_computeKeyAgreementPublicValueLength(zrtpCommitMessage->keyAgreementAlgo, MSGTYPE_COMMIT);
 					zrtpCommitMessage->pv = (uint8_t *)malloc(pvLength*sizeof(uint8_t));
 					memset(zrtpCommitMessage->pv, 0, pvLength); // Set the memory to zero as the buffer is expanded to have a size multiple of 0, so there might be padding at the end.
@@ -1494,17 +1498,21 @@ bzrtpPacket_t *bzrtp_createZrtpPacket(bzrtpContext_t *zrtpContext, bzrtpChannelC
 			} else {
 				bctbx_keyAgreementAlgo = BCTBX_DHM_3072;
 			}
-			/* create DHM context */
-			DHMContext = bctbx_CreateDHMContext(bctbx_keyAgreementAlgo, secretLength);
+			/* get a pre-generated DHM context if the pool has one */
+			DHMContext = (bctbx_DHMContext_t *)bzrtp_keyAgreementPool_get(zrtpChannelContext->keyAgreementAlgo, secretLength);
 			if (DHMContext == NULL) {
-				free(zrtpPacket);
-				free(zrtpDHPartMessage);
-				*exitCode = BZRTP_CREATE_ERROR_UNABLETOCREATECRYPTOCONTEXT;
-				return NULL;
-			}
+				/* create DHM context */
+				DHMContext = bctbx_CreateDHMContext(bctbx_keyAgreementAlgo, secretLength);
+				if (DHMContext == NULL) {
+					free(zrtpPacket);
+					free(zrtpDHPartMessage);
+					*exitCode = BZRTP_CREATE_ERROR_UNABLETOCREATECRYPTOCONTEXT;
+					return NULL;
+				}
 
-			/* create private key and compute the public value */
-			bctbx_DHMCreatePublic(DHMContext, (int (*)(void *, uint8_t *, size_t))bctbx_rng_get, zrtpContext->RNGContext);
+				/* create private key and compute the public value */
+				bctbx_DHMCreatePublic(DHMContext, (int (*)(void *, uint8_t *, size_t))bctbx_rng_get, zrtpContext->RNGContext);
+			}
 			zrtpDHPartMessage->pv = (uint8_t *)malloc(pvLength*sizeof(uint8_t));
 			memcpy(zrtpDHPartMessage->pv, DHMContext->self, pvLength);
 			zrtpContext->keyAgreementContext = (void *)DHMContext; /* save DHM context in zrtp Context */
@@ -1519,16 +1527,20 @@ bzrtpPacket_t *bzrtp_createZrtpPacket(bzrtpContext_t *zrtpContext, bzrtpChannelC
 				bctbx_keyAgreementAlgo = BCTBX_ECDH_X448;
 			}
 
-			/* Create the ECDH context */
-			ECDHContext = bctbx_CreateECDHContext(bctbx_keyAgreementAlgo);
+			/* get a pre-generated ECDH context if the pool has one */
+			ECDHContext = (bctbx_ECDHContext_t *)bzrtp_keyAgreementPool_get(zrtpChannelContext->keyAgreementAlgo, 0);
 			if (ECDHContext == NULL) {
-				free(zrtpPacket);
-				free(zrtpDHPartMessage);
-				*exitCode = BZRTP_CREATE_ERROR_UNABLETOCREATECRYPTOCONTEXT;
-				return NULL;
+				/* Create the ECDH context */
+				ECDHContext = bctbx_CreateECDHContext(bctbx_keyAgreementAlgo);
+				if (ECDHContext == NULL) {
+					free(zrtpPacket);
+					free(zrtpDHPartMessage);
+					*exitCode = BZRTP_CREATE_ERROR_UNABLETOCREATECRYPTOCONTEXT;
+					return NULL;
+				}
+				/* create private key and compute the public value */
+				bctbx_ECDHCreateKeyPair(ECDHContext, (int (*)(void *, uint8_t *, size_t))bctbx_rng_get, zrtpContext->RNGContext);
 			}
-			/* create private key and compute the public value */
-			bctbx_ECDHCreateKeyPair(ECDHContext, (int (*)(void *, uint8_t *, size_t))bctbx_rng_get, zrtpContext->RNGContext);
 			zrtpDHPartMessage->pv = (uint8_t *)malloc(pvLength*sizeof(uint8_t));
 			memcpy(zrtpDHPartMessage->pv, ECDHContext->selfPublic, pvLength);
 			/* we might already have a keyAgreement context in the zrtpContext (if we are building a DHPart1 after having built a DHPart2) */
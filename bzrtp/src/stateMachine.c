@@ -2755,9 +2755,11 @@ static int bzrtp_sendPacket ( const bzrtpContext_t* zrtpContext, bzrtpChannelCon
  * return 0 on success, error code otherwise
  */
 int bzrtp_updateCachedSecrets(bzrtpContext_t *zrtpContext, bzrtpChannelContext_t *zrtpChannelContext) {
-	const char *colNames[] = {"rs1", "rs2"};
-	uint8_t *colValues[2] = {NULL, NULL};
-	size_t colLength[2] = {RETAINED_SECRET_LENGTH,0};
+	uint8_t pvsFlag = 1;
+	const char *colNames[] = {"rs1", "rs2", "pvs"};
+	uint8_t *colValues[3] = {NULL, NULL, &pvsFlag};
+	size_t colLength[3] = {RETAINED_SECRET_LENGTH,0,1};
+	uint8_t colCount = 2;
 
 	/* if this channel context is in multistream mode, do nothing */
 	if (zrtpChannelContext->keyAgreementAlgo == ZRTP_KEYAGREEMENT_Mult) {
@@ -2794,7 +2796,14 @@ int bzrtp_updateCachedSecrets(bzrtpContext_t *zrtpContext, bzrtpChannelContext_t
 		bzrtp_cache_getZuid((void *)zrtpContext->zidCache, zrtpContext->selfURI, zrtpContext->peerURI, zrtpContext->peerZID, BZRTP_ZIDCACHE_INSERT_ZUID, &zrtpContext->zuid, zrtpContext->zidCacheMutex);
 	}
 
-	bzrtp_cache_write_active(zrtpContext, "zrtp", colNames, colValues, colLength, 2);
+	/* a pending SAS verification is written in the same transaction */
+	if (zrtpContext->pendingPVS == 1) {
+		colCount = 3;
+	}
+
+	if (bzrtp_cache_write_active(zrtpContext, "zrtp", colNames, colValues, colLength, colCount) == 0 && colCount == 3) {
+		zrtpContext->pendingPVS = 0;
+	}
 
 	/* if exist, call the callback function to perform custom cache operation that may use s0(writing exported key into cache) */
 	if (zrtpContext->zrtpCallbacks.bzrtp_contextReadyForExportedKeys != NULL) {
@@ -21,6 +21,8 @@
 #include "typedef.h"
 #include <bctoolbox/crypto.h>
 #include <bctoolbox/defs.h>
+#include <bctoolbox/list.h>
+#include <bctoolbox/port.h>
 #include "cryptoUtils.h"
 #include "zidCache.h"
 
@@ -41,6 +43,162 @@
  */
 #define ZIDCACHE_DBSCHEMA_VERSION_NUMBER 0x000002
 
+/* Prepared statements cache
+ * The statements run on behalf of a bzrtp context are kept prepared as long as at least one context
+ * is bound to the database, so concurrent and successive calls sharing the database reuse them.
+ * They are finalized when the last context bound to the database is destroyed, the application can then close it.
+ * The functions working directly on a database pointer do not use this cache as the database may be closed at any time.
+ */
+typedef struct {
+	char *sql; /**< the SQL text of the statement, used as key */
+	sqlite3_stmt *stmt;
+	uint8_t inUse; /**< statement is currently used, a concurrent user must prepare its own */
+} bzrtp_zidCacheStatement_t;
+
+typedef struct {
+	sqlite3 *db;
+	int refCount; /**< number of bzrtp contexts bound to this database */
+	bctbx_list_t *statements; /**< list of bzrtp_zidCacheStatement_t */
+} bzrtp_zidCacheStatements_t;
+
+/* list of bzrtp_zidCacheStatements_t, one per database, protected by the sqlite static mutex SQLITE_MUTEX_STATIC_APP1 */
+static bctbx_list_t *zidCacheStatementsList = NULL;
+
+static bzrtp_zidCacheStatements_t *bzrtp_cache_findStatements(sqlite3 *db) {
+	bctbx_list_t *it;
+	for (it = zidCacheStatementsList; it != NULL; it = bctbx_list_next(it)) {
+		bzrtp_zidCacheStatements_t *statements = (bzrtp_zidCacheStatements_t *)bctbx_list_get_data(it);
+		if (statements->db == db) {
+			return statements;
+		}
+	}
+	return NULL;
+}
+
+void bzrtp_cache_bindContext(void *dbPointer) {
+	sqlite3_mutex *mutex = sqlite3_mutex_alloc(SQLITE_MUTEX_STATIC_APP1);
+	bzrtp_zidCacheStatements_t *statements;
+
+	if (dbPointer == NULL) {
+		return;
+	}
+
+	sqlite3_mutex_enter(mutex);
+	statements = bzrtp_cache_findStatements((sqlite3 *)dbPointer);
+	if (statements == NULL) {
+		statements = (bzrtp_zidCacheStatements_t *)bctbx_malloc0(sizeof(bzrtp_zidCacheStatements_t));
+		statements->db = (sqlite3 *)dbPointer;
+		zidCacheStatementsList = bctbx_list_append(zidCacheStatementsList, statements);
+	}
+	statements->refCount++;
+	sqlite3_mutex_leave(mutex);
+}
+
+void bzrtp_cache_unbindContext(void *dbPointer) {
+	sqlite3_mutex *mutex = sqlite3_mutex_alloc(SQLITE_MUTEX_STATIC_APP1);
+	bzrtp_zidCacheStatements_t *statements;
+
+	if (dbPointer == NULL) {
+		return;
+	}
+
+	sqlite3_mutex_enter(mutex);
+	statements = bzrtp_cache_findStatements((sqlite3 *)dbPointer);
+	if (statements != NULL && --statements->refCount == 0) {
+		bctbx_list_t *it;
+		for (it = statements->statements; it != NULL; it = bctbx_list_next(it)) {
+			bzrtp_zidCacheStatement_t *statement = (bzrtp_zidCacheStatement_t *)bctbx_list_get_data(it);
+			if (statement->inUse == 0) { /* a statement still in use is finalized on release as it won't be found anymore */
+				sqlite3_finalize(statement->stmt);
+			}
+			bctbx_free(statement->sql);
+			bctbx_free(statement);
+		}
+		bctbx_list_free(statements->statements);
+		zidCacheStatementsList = bctbx_list_remove(zidCacheStatementsList, statements);
+		bctbx_free(statements);
+	}
+	sqlite3_mutex_leave(mutex);
+}
+
+/**
+ * @brief Get a prepared statement, from the cache if the database is bound to a context and useCache is set
+ * The statement must be given back using bzrtp_cache_release
+ *
+ * @return the prepared statement, NULL on error
+ */
+static sqlite3_stmt *bzrtp_cache_prepare(sqlite3 *db, const char *sql, uint8_t useCache) {
+	sqlite3_mutex *mutex = sqlite3_mutex_alloc(SQLITE_MUTEX_STATIC_APP1);
+	bzrtp_zidCacheStatements_t *statements;
+	sqlite3_stmt *sqlStmt = NULL;
+
+	if (useCache == 1) {
+		sqlite3_mutex_enter(mutex);
+		statements = bzrtp_cache_findStatements(db);
+		if (statements != NULL) {
+			bctbx_list_t *it;
+			for (it = statements->statements; it != NULL; it = bctbx_list_next(it)) {
+				bzrtp_zidCacheStatement_t *statement = (bzrtp_zidCacheStatement_t *)bctbx_list_get_data(it);
+				if (statement->inUse == 0 && strcmp(statement->sql, sql) == 0) {
+					statement->inUse = 1;
+					sqlite3_mutex_leave(mutex);
+					return statement->stmt;
+				}
+			}
+		}
+		sqlite3_mutex_leave(mutex);
+	}
+
+	if (sqlite3_prepare_v2(db, sql, -1, &sqlStmt, NULL) != SQLITE_OK) {
+		sqlite3_finalize(sqlStmt);
+		return NULL;
+	}
+
+	if (useCache == 1) {
+		sqlite3_mutex_enter(mutex);
+		statements = bzrtp_cache_findStatements(db);
+		if (statements != NULL) {
+			bzrtp_zidCacheStatement_t *statement = (bzrtp_zidCacheStatement_t *)bctbx_malloc(sizeof(bzrtp_zidCacheStatement_t));
+			statement->sql = bctbx_strdup(sql);
+			statement->stmt = sqlStmt;
+			statement->inUse = 1;
+			statements->statements = bctbx_list_append(statements->statements, statement);
+		}
+		sqlite3_mutex_leave(mutex);
+	}
+	return sqlStmt;
+}
+
+/**
+ * @brief Give back a statement obtained from bzrtp_cache_prepare: reset it if it is cached, finalize it otherwise
+ */
+static void bzrtp_cache_release(sqlite3 *db, sqlite3_stmt *sqlStmt) {
+	sqlite3_mutex *mutex = sqlite3_mutex_alloc(SQLITE_MUTEX_STATIC_APP1);
+	bzrtp_zidCacheStatements_t *statements;
+
+	if (sqlStmt == NULL) {
+		return;
+	}
+
+	sqlite3_mutex_enter(mutex);
+	statements = bzrtp_cache_findStatements(db);
+	if (statements != NULL) {
+		bctbx_list_t *it;
+		for (it = statements->statements; it != NULL; it = bctbx_list_next(it)) {
+			bzrtp_zidCacheStatement_t *statement = (bzrtp_zidCacheStatement_t *)bctbx_list_get_data(it);
+			if (statement->stmt == sqlStmt) {
+				sqlite3_reset(sqlStmt);
+				sqlite3_clear_bindings(sqlStmt);
+				statement->inUse = 0;
+				sqlite3_mutex_leave(mutex);
+				return;
+			}
+		}
+	}
+	sqlite3_mutex_leave(mutex);
+	sqlite3_finalize(sqlStmt);
+}
+
 static int callback_getSelfZID(void *data, BCTBX_UNUSED(int argc), char **argv, BCTBX_UNUSED(char **colName)){
 	uint8_t **selfZID = (uint8_t **)data;
 
@@ -326,6 +484,77 @@ int bzrtp_getSelfZID_lock(void *dbPointer, const char *selfURI, uint8_t selfZID[
 }
 
 
+/* non locking implementation of bzrtp_cache_getZuid, useCache is set when running on behalf of a context */
+static int bzrtp_cache_getZuid_impl(sqlite3 *db, const char *selfURI, const char *peerURI, const uint8_t peerZID[12], const uint8_t insertFlag, int *zuid, uint8_t useCache) {
+	int ret;
+	sqlite3_stmt *sqlStmt = NULL;
+
+	/* Try to fetch the requested zuid */
+	sqlStmt = bzrtp_cache_prepare(db, "SELECT zuid FROM ziduri WHERE selfuri=? AND peeruri=? AND zid=? ORDER BY zuid LIMIT 1;", useCache);
+	if (sqlStmt == NULL) {
+		return BZRTP_ZIDCACHE_UNABLETOREAD;
+	}
+
+	sqlite3_bind_text(sqlStmt, 1, selfURI,-1,SQLITE_TRANSIENT);
+	sqlite3_bind_text(sqlStmt, 2, peerURI,-1,SQLITE_TRANSIENT);
+	sqlite3_bind_blob(sqlStmt, 3, peerZID, 12, SQLITE_TRANSIENT);
+
+	ret = sqlite3_step(sqlStmt);
+
+	if (ret == SQLITE_ROW) {
+		/* retrieve value in column 0 */
+		*zuid = sqlite3_column_int(sqlStmt, 0);
+		bzrtp_cache_release(db, sqlStmt);
+		return 0;
+	}
+	bzrtp_cache_release(db, sqlStmt);
+
+	if (ret != SQLITE_DONE) { /* we had an error querying the DB... */
+		return BZRTP_ZIDCACHE_UNABLETOREAD;
+	}
+
+	/* query executed correctly, just our data is not there: shall we insert it? */
+	if (insertFlag != BZRTP_ZIDCACHE_INSERT_ZUID) {
+		*zuid = 0;
+		return BZRTP_ERROR_CACHE_PEERNOTFOUND;
+	}
+
+	/* check that we have a self ZID matching the self URI */
+	sqlStmt = bzrtp_cache_prepare(db, "SELECT zid FROM ziduri WHERE selfuri=? AND peeruri='self' ORDER BY zuid LIMIT 1;", useCache);
+	if (sqlStmt == NULL) {
+		return BZRTP_ZIDCACHE_UNABLETOREAD;
+	}
+	sqlite3_bind_text(sqlStmt, 1, selfURI,-1,SQLITE_TRANSIENT);
+	ret = sqlite3_step(sqlStmt);
+	bzrtp_cache_release(db, sqlStmt);
+	if (ret == SQLITE_DONE) { /* this sip URI is not in our DB, do not create an association with the peer ZID/URI binding */
+		return BZRTP_ZIDCACHE_BADINPUTDATA;
+	}
+	if (ret != SQLITE_ROW) {
+		return BZRTP_ZIDCACHE_UNABLETOREAD;
+	}
+
+	/* yes we know this URI on local device, add a row in the ziduri table */
+	sqlStmt = bzrtp_cache_prepare(db, "INSERT INTO ziduri (zid,selfuri,peeruri) VALUES(?,?,?);", useCache);
+	if (sqlStmt == NULL) {
+		return BZRTP_ZIDCACHE_UNABLETOUPDATE;
+	}
+
+	sqlite3_bind_blob(sqlStmt, 1, peerZID, 12, SQLITE_TRANSIENT);
+	sqlite3_bind_text(sqlStmt, 2, selfURI,-1,SQLITE_TRANSIENT);
+	sqlite3_bind_text(sqlStmt, 3, peerURI,-1,SQLITE_TRANSIENT);
+
+	ret = sqlite3_step(sqlStmt);
+	bzrtp_cache_release(db, sqlStmt);
+	if (ret!=SQLITE_DONE) {
+		return BZRTP_ZIDCACHE_UNABLETOUPDATE;
+	}
+
+	/* get the zuid created */
+	*zuid = (int)sqlite3_last_insert_rowid(db);
+	return 0;
+}
+
 /**
  * @brief Parse the cache to find secrets associated to the given ZID, set them and their length in the context if they are found 
  *
@@ -335,7 +564,6 @@ int bzrtp_getSelfZID_lock(void *dbPointer, const char *selfURI, uint8_t selfZID[
  * return 	0 on succes, error code otherwise 
  */
 int bzrtp_getPeerAssociatedSecrets(bzrtpContext_t *context, uint8_t peerZID[12]) {
-	char *stmt = NULL;
 	int ret;
 	sqlite3_stmt *sqlStmt = NULL;
 	int length =0;
@@ -369,10 +597,8 @@ int bzrtp_getPeerAssociatedSecrets(bzrtpContext_t *context, uint8_t peerZID[12])
 	}
 
 	/* get all secrets from zrtp table, ORDER BY is just to ensure consistent return in case of inconsistent table) */
-	stmt = sqlite3_mprintf("SELECT z.zuid, z.rs1, z.rs2, z.aux, z.pbx, z.pvs FROM ziduri as zu INNER JOIN zrtp as z ON z.zuid=zu.zuid WHERE zu.selfuri=? AND zu.peeruri=? AND zu.zid=? ORDER BY zu.zuid LIMIT 1;");
-	ret = sqlite3_prepare_v2(context->zidCache, stmt, -1, &sqlStmt, NULL);
-	sqlite3_free(stmt);
-	if (ret != SQLITE_OK) {
+	sqlStmt = bzrtp_cache_prepare(context->zidCache, "SELECT z.zuid, z.rs1, z.rs2, z.aux, z.pbx, z.pvs FROM ziduri as zu INNER JOIN zrtp as z ON z.zuid=zu.zuid WHERE zu.selfuri=? AND zu.peeruri=? AND zu.zid=? ORDER BY zu.zuid LIMIT 1;", 1);
+	if (sqlStmt == NULL) {
 		if (context->zidCacheMutex != NULL) {
 			bctbx_mutex_unlock(context->zidCacheMutex);
 		}
@@ -385,10 +611,10 @@ int bzrtp_getPeerAssociatedSecrets(bzrtpContext_t *context, uint8_t peerZID[12])
 	ret = sqlite3_step(sqlStmt);
 
 	if (ret!=SQLITE_ROW) {
-		sqlite3_finalize(sqlStmt);
+		bzrtp_cache_release(context->zidCache, sqlStmt);
 		if (ret == SQLITE_DONE) {/* not found in cache, just leave cached secrets reset, but retrieve zuid, do not insert new peer ZID at this step, it must be done only when negotiation succeeds */
-			/* last param is NULL as we already hold the lock on database */
-			ret = bzrtp_cache_getZuid((void *)context->zidCache, context->selfURI, context->peerURI, context->peerZID, BZRTP_ZIDCACHE_DONT_INSERT_ZUID, &context->zuid, NULL);
+			/* we already hold the lock on database */
+			ret = bzrtp_cache_getZuid_impl(context->zidCache, context->selfURI, context->peerURI, context->peerZID, BZRTP_ZIDCACHE_DONT_INSERT_ZUID, &context->zuid, 1);
 		} else { /* we had an error querying the DB... */
 			ret = BZRTP_ZIDCACHE_UNABLETOREAD;
 		}
@@ -443,7 +669,7 @@ int bzrtp_getPeerAssociatedSecrets(bzrtpContext_t *context, uint8_t peerZID[12])
 		}
 	}
 
-	sqlite3_finalize(sqlStmt);
+	bzrtp_cache_release(context->zidCache, sqlStmt);
 
 	if (context->zidCacheMutex != NULL) {
 		bctbx_mutex_unlock(context->zidCacheMutex);
@@ -471,10 +697,7 @@ int bzrtp_getPeerAssociatedSecrets(bzrtpContext_t *context, uint8_t peerZID[12])
  * @return 0 on success, BZRTP_ERROR_CACHE_PEERNOTFOUND if peer was not in and the insert flag is not set to BZRTP_ZIDCACHE_INSERT_ZUID, error code otherwise
  */
 int bzrtp_cache_getZuid(void *dbPointer, const char *selfURI, const char *peerURI, const uint8_t peerZID[12], const uint8_t insertFlag, int *zuid, bctbx_mutex_t *zidCacheMutex) {
-	char *stmt=NULL;
 	int ret;
-	sqlite3_stmt *sqlStmt = NULL;
-	sqlite3 *db = (sqlite3 *)dbPointer;
 
 	if (dbPointer == NULL) { /* we are running cacheless */
 		return BZRTP_ZIDCACHE_RUNTIME_CACHELESS;
@@ -484,103 +707,13 @@ int bzrtp_cache_getZuid(void *dbPointer, const char *selfURI, const char *peerUR
 		bctbx_mutex_lock(zidCacheMutex);
 	}
 
-	/* Try to fetch the requested zuid */
-	stmt = sqlite3_mprintf("SELECT zuid FROM ziduri WHERE selfuri=? AND peeruri=? AND zid=? ORDER BY zuid LIMIT 1;");
-	ret = sqlite3_prepare_v2(db, stmt, -1, &sqlStmt, NULL);
-	sqlite3_free(stmt);
-	if (ret != SQLITE_OK) {
-		if (zidCacheMutex != NULL) {
-			bctbx_mutex_unlock(zidCacheMutex);
-		}
-		return BZRTP_ZIDCACHE_UNABLETOREAD;
-	}
-
-	sqlite3_bind_text(sqlStmt, 1, selfURI,-1,SQLITE_TRANSIENT);
-	sqlite3_bind_text(sqlStmt, 2, peerURI,-1,SQLITE_TRANSIENT);
-	sqlite3_bind_blob(sqlStmt, 3, peerZID, 12, SQLITE_TRANSIENT);
-
-	ret = sqlite3_step(sqlStmt);
-
-	if (ret!=SQLITE_ROW) { /* We didn't found this binding in the DB */
-		sqlite3_finalize(sqlStmt);
-		if (ret == SQLITE_DONE) { /* query executed correctly, just our data is not there */
-			/* shall we insert it? */
-			if (insertFlag == BZRTP_ZIDCACHE_INSERT_ZUID) {
-				uint8_t *localZID = NULL;
-				char *errmsg=NULL;
-
-				/* check that we have a self ZID matching the self URI and insert a new row */
-				stmt = sqlite3_mprintf("SELECT zid FROM ziduri WHERE selfuri=%Q AND peeruri='self' ORDER BY zuid LIMIT 1;",selfURI);
-				ret = sqlite3_exec(db,stmt,callback_getSelfZID,&localZID,&errmsg);
-				sqlite3_free(stmt);
-				if (ret != SQLITE_OK) {
-					sqlite3_free(errmsg);
-					if (zidCacheMutex != NULL) {
-						bctbx_mutex_unlock(zidCacheMutex);
-					}
-					return BZRTP_ZIDCACHE_UNABLETOREAD;
-				}
-
-				if (localZID==NULL) { /* this sip URI is not in our DB, do not create an association with the peer ZID/URI binding */
-					if (zidCacheMutex != NULL) {
-						bctbx_mutex_unlock(zidCacheMutex);
-					}
-					return BZRTP_ZIDCACHE_BADINPUTDATA;
-				} else { /* yes we know this URI on local device, add a row in the ziduri table */
-					free(localZID);
-					stmt = sqlite3_mprintf("INSERT INTO ziduri (zid,selfuri,peeruri) VALUES(?,?,?);");
-					ret = sqlite3_prepare_v2(db, stmt, -1, &sqlStmt, NULL);
-					if (ret != SQLITE_OK) {
-						if (zidCacheMutex != NULL) {
-							bctbx_mutex_unlock(zidCacheMutex);
-						}
-						return BZRTP_ZIDCACHE_UNABLETOUPDATE;
-					}
-					sqlite3_free(stmt);
-
-					sqlite3_bind_blob(sqlStmt, 1, peerZID, 12, SQLITE_TRANSIENT);
-					sqlite3_bind_text(sqlStmt, 2, selfURI,-1,SQLITE_TRANSIENT);
-					sqlite3_bind_text(sqlStmt, 3, peerURI,-1,SQLITE_TRANSIENT);
-
-					ret = sqlite3_step(sqlStmt);
-					if (ret!=SQLITE_DONE) {
-						if (zidCacheMutex != NULL) {
-							bctbx_mutex_unlock(zidCacheMutex);
-						}
-						return BZRTP_ZIDCACHE_UNABLETOUPDATE;
-					}
-					sqlite3_finalize(sqlStmt);
-					/* get the zuid created */
-					*zuid = (int)sqlite3_last_insert_rowid(db);
-					if (zidCacheMutex != NULL) {
-						bctbx_mutex_unlock(zidCacheMutex);
-					}
-					return 0;
-				}
-			} else { /* no found and not inserted */
-				*zuid = 0;
-				if (zidCacheMutex != NULL) {
-					bctbx_mutex_unlock(zidCacheMutex);
-				}
-				return BZRTP_ERROR_CACHE_PEERNOTFOUND;
-			}
-		} else { /* we had an error querying the DB... */
-			if (zidCacheMutex != NULL) {
-				bctbx_mutex_unlock(zidCacheMutex);
-			}
-			return BZRTP_ZIDCACHE_UNABLETOREAD;
-		}
-	}
-
-	/* retrieve value in column 0 */
-	*zuid = sqlite3_column_int(sqlStmt, 0);
-	sqlite3_finalize(sqlStmt);
+	ret = bzrtp_cache_getZuid_impl((sqlite3 *)dbPointer, selfURI, peerURI, peerZID, insertFlag, zuid, 0);
 
 	if (zidCacheMutex != NULL) {
 		bctbx_mutex_unlock(zidCacheMutex);
 	}
 
-	return 0;
+	return ret;
 }
 
 /**
@@ -599,7 +732,7 @@ int bzrtp_cache_getZuid(void *dbPointer, const char *selfURI, const char *peerUR
  *
  * @return 0 on succes, error code otherwise
  */
-static int bzrtp_cache_write_impl(void *dbPointer, int zuid, const char *tableName, const char **columns, uint8_t **values, size_t *lengths, uint8_t columnsCount) {
+static int bzrtp_cache_write_impl(void *dbPointer, int zuid, const char *tableName, const char **columns, uint8_t **values, size_t *lengths, uint8_t columnsCount, uint8_t useCache) {
 	char *stmt=NULL;
 	int ret,i;
 	size_t j;
@@ -632,11 +765,12 @@ static int bzrtp_cache_write_impl(void *dbPointer, int zuid, const char *tableNa
 		j=strlen(insertColumnsString);
 	}
 
-	stmt = sqlite3_mprintf("UPDATE %w SET %s WHERE zuid=%d;", tableName, insertColumnsString, zuid);
+	/* zuid is bound and not formatted in the statement so it can be reused for any zuid writing the same columns set */
+	stmt = sqlite3_mprintf("UPDATE %w SET %s WHERE zuid=?;", tableName, insertColumnsString);
 	free(insertColumnsString);
-	ret = sqlite3_prepare_v2(db, stmt, -1, &sqlStmt, NULL);
+	sqlStmt = bzrtp_cache_prepare(db, stmt, useCache);
 	sqlite3_free(stmt);
-	if (ret != SQLITE_OK) {
+	if (sqlStmt == NULL) {
 		return BZRTP_ZIDCACHE_UNABLETOUPDATE;
 	}
 
@@ -644,9 +778,10 @@ static int bzrtp_cache_write_impl(void *dbPointer, int zuid, const char *tableNa
 	for (i=0; i<columnsCount; i++) {
 		sqlite3_bind_blob(sqlStmt, i+1, values[i], (int)(lengths[i]), SQLITE_TRANSIENT);/* i+1 because index of sql bind is 1 based */
 	}
+	sqlite3_bind_int(sqlStmt, columnsCount+1, zuid);
 
 	ret = sqlite3_step(sqlStmt);
-	sqlite3_finalize(sqlStmt);
+	bzrtp_cache_release(db, sqlStmt);
 
 	if (ret!=SQLITE_DONE) {
 		return BZRTP_ZIDCACHE_UNABLETOUPDATE;
@@ -668,9 +803,9 @@ static int bzrtp_cache_write_impl(void *dbPointer, int zuid, const char *tableNa
 		}
 		stmt = sqlite3_mprintf("INSERT INTO %w (%s) VALUES(%s);", tableName, insertColumnsString, valuesBindingString);
 		free(insertColumnsString);
-		ret = sqlite3_prepare_v2(db, stmt, -1, &sqlStmt, NULL);
+		sqlStmt = bzrtp_cache_prepare(db, stmt, useCache);
 		sqlite3_free(stmt);
-		if (ret != SQLITE_OK) {
+		if (sqlStmt == NULL) {
 			return BZRTP_ZIDCACHE_UNABLETOUPDATE;
 		}
 
@@ -681,7 +816,7 @@ static int bzrtp_cache_write_impl(void *dbPointer, int zuid, const char *tableNa
 		}
 
 		ret = sqlite3_step(sqlStmt);
-		sqlite3_finalize(sqlStmt);
+		bzrtp_cache_release(db, sqlStmt);
 
 		/* there is a foreign key binding on zuid, which make it impossible to insert a row in zrtp table without an existing zuid */
 		/* if it fails it is at this point: TODO: add a specific error return value for this case */
@@ -695,7 +830,7 @@ static int bzrtp_cache_write_impl(void *dbPointer, int zuid, const char *tableNa
 
 /* non locking database version of the previous function, is deprecated but kept for compatibility */
 int bzrtp_cache_write(void *dbPointer, int zuid, const char *tableName, const char **columns, uint8_t **values, size_t *lengths, uint8_t columnsCount) {
-	return bzrtp_cache_write_impl(dbPointer, zuid, tableName, columns, values, lengths, columnsCount);
+	return bzrtp_cache_write_impl(dbPointer, zuid, tableName, columns, values, lengths, columnsCount, 0);
 }
 
 /* locking database version of the previous function */
@@ -706,7 +841,7 @@ int bzrtp_cache_write_lock(void *dbPointer, int zuid, const char *tableName, con
 	if (dbPointer != NULL && zidCacheMutex != NULL) {
 		bctbx_mutex_lock(zidCacheMutex);
 		sqlite3_exec((sqlite3 *)dbPointer, "BEGIN TRANSACTION;", NULL, NULL, NULL);
-		retval = bzrtp_cache_write_impl(dbPointer, zuid, tableName, columns, values, lengths, columnsCount);
+		retval = bzrtp_cache_write_impl(dbPointer, zuid, tableName, columns, values, lengths, columnsCount, 0);
 		if (retval == 0) {
 			sqlite3_exec((sqlite3 *)dbPointer, "COMMIT;", NULL, NULL, NULL);
 		} else {
@@ -716,7 +851,7 @@ int bzrtp_cache_write_lock(void *dbPointer, int zuid, const char *tableName, con
 		return retval;
 	}
 	else {
-		return bzrtp_cache_write_impl(dbPointer, zuid, tableName, columns, values, lengths, columnsCount);
+		return bzrtp_cache_write_impl(dbPointer, zuid, tableName, columns, values, lengths, columnsCount, 0);
 	}
 }
 
@@ -740,7 +875,6 @@ int bzrtp_cache_write_lock(void *dbPointer, int zuid, const char *tableName, con
  * @return 0 on succes, error code otherwise
  */
 int bzrtp_cache_write_active(bzrtpContext_t *context, const char *tableName, const char **columns, uint8_t **values, size_t *lengths, uint8_t columnsCount) {
-	char *stmt=NULL;
 	int ret;
 	const unsigned char *peeruri=NULL;
 	int activeFlag=0;
@@ -762,10 +896,8 @@ int bzrtp_cache_write_active(bzrtpContext_t *context, const char *tableName, con
 	sqlite3_exec(context->zidCache, "BEGIN TRANSACTION;", NULL, NULL, NULL);
 
 	/* Retrieve the peerUri and active flag from ziduri table */
-	stmt = sqlite3_mprintf("SELECT peeruri, active FROM ziduri WHERE zuid=? LIMIT 1;");
-	ret = sqlite3_prepare_v2(context->zidCache, stmt, -1, &sqlStmt, NULL);
-	sqlite3_free(stmt);
-	if (ret != SQLITE_OK) {
+	sqlStmt = bzrtp_cache_prepare(context->zidCache, "SELECT peeruri, active FROM ziduri WHERE zuid=? LIMIT 1;", 1);
+	if (sqlStmt == NULL) {
 		sqlite3_exec(context->zidCache, "ROLLBACK;", NULL, NULL, NULL);
 		if (context->zidCacheMutex != NULL) {
 			bctbx_mutex_unlock(context->zidCacheMutex);
@@ -778,7 +910,7 @@ int bzrtp_cache_write_active(bzrtpContext_t *context, const char *tableName, con
 	ret = sqlite3_step(sqlStmt);
 
 	if (ret!=SQLITE_ROW) { /* We didn't found this zuid in the DB -> we would not be able to write */
-		sqlite3_finalize(sqlStmt);
+		bzrtp_cache_release(context->zidCache, sqlStmt);
 		sqlite3_exec(context->zidCache, "ROLLBACK;", NULL, NULL, NULL);
 		if (context->zidCacheMutex != NULL) {
 			bctbx_mutex_unlock(context->zidCacheMutex);
@@ -787,19 +919,16 @@ int bzrtp_cache_write_active(bzrtpContext_t *context, const char *tableName, con
 	}
 
 	/* retrieve values 0:peeruri, 1:active */
-	peeruri = sqlite3_column_text(sqlStmt, 0); /* warning: finalize the statement will invalidate peeruri pointer */
+	peeruri = sqlite3_column_text(sqlStmt, 0); /* warning: releasing the statement will invalidate peeruri pointer */
 	activeFlag = sqlite3_column_int(sqlStmt, 1);
 
 	/* if active flag is already set, just do nothing otherwise set it and reset all others with the same peeruri(active device is shared among local users) */
 	if (activeFlag == 0) {
 		sqlite3_stmt *sqlStmtActive = NULL;
 		/* reset all active flags with this peeruri */
-		stmt = sqlite3_mprintf("UPDATE ziduri SET active=0 WHERE active<>0 AND zuid<>? AND peeruri=?;");
-		ret = sqlite3_prepare_v2(context->zidCache, stmt, -1, &sqlStmtActive, NULL);
-		sqlite3_free(stmt);
-		if (ret != SQLITE_OK) {
-			sqlite3_finalize(sqlStmt);
-			sqlite3_finalize(sqlStmtActive);
+		sqlStmtActive = bzrtp_cache_prepare(context->zidCache, "UPDATE ziduri SET active=0 WHERE active<>0 AND zuid<>? AND peeruri=?;", 1);
+		if (sqlStmtActive == NULL) {
+			bzrtp_cache_release(context->zidCache, sqlStmt);
 			sqlite3_exec(context->zidCache, "ROLLBACK;", NULL, NULL, NULL);
 			if (context->zidCacheMutex != NULL) {
 				bctbx_mutex_unlock(context->zidCacheMutex);
@@ -809,14 +938,11 @@ int bzrtp_cache_write_active(bzrtpContext_t *context, const char *tableName, con
 		sqlite3_bind_int(sqlStmtActive, 1, context->zuid);
 		sqlite3_bind_text(sqlStmtActive, 2, (const char *)peeruri, -1, SQLITE_TRANSIENT);
 		ret = sqlite3_step(sqlStmtActive);
-		sqlite3_finalize(sqlStmtActive);
+		bzrtp_cache_release(context->zidCache, sqlStmtActive);
 		/* set to 1 the active flag four current row */
-		stmt = sqlite3_mprintf("UPDATE ziduri SET active=1 WHERE zuid=?;");
-		ret = sqlite3_prepare_v2(context->zidCache, stmt, -1, &sqlStmtActive, NULL);
-		sqlite3_free(stmt);
-		if (ret != SQLITE_OK) {
-			sqlite3_finalize(sqlStmt);
-			sqlite3_finalize(sqlStmtActive);
+		sqlStmtActive = bzrtp_cache_prepare(context->zidCache, "UPDATE ziduri SET active=1 WHERE zuid=?;", 1);
+		if (sqlStmtActive == NULL) {
+			bzrtp_cache_release(context->zidCache, sqlStmt);
 			sqlite3_exec(context->zidCache, "ROLLBACK;", NULL, NULL, NULL);
 			if (context->zidCacheMutex != NULL) {
 				bctbx_mutex_unlock(context->zidCacheMutex);
@@ -825,13 +951,13 @@ int bzrtp_cache_write_active(bzrtpContext_t *context, const char *tableName, con
 		}
 		sqlite3_bind_int(sqlStmtActive, 1, context->zuid);
 		ret = sqlite3_step(sqlStmtActive);
-		sqlite3_finalize(sqlStmtActive);
+		bzrtp_cache_release(context->zidCache, sqlStmtActive);
 	}
 
-	sqlite3_finalize(sqlStmt);
+	bzrtp_cache_release(context->zidCache, sqlStmt);
 
 	/* and perform the actual writing */
-	ret = bzrtp_cache_write_impl(context->zidCache, context->zuid, tableName, columns, values, lengths, columnsCount);
+	ret = bzrtp_cache_write_impl(context->zidCache, context->zuid, tableName, columns, values, lengths, columnsCount, 1);
 
 	if (ret == 0) {
 		sqlite3_exec(context->zidCache, "COMMIT;", NULL, NULL, NULL);
@@ -1102,4 +1228,10 @@ int bzrtp_cache_getPeerStatus_lock(void *dbPointer, const char *peerURI, bctbx_m
 int bzrtp_cache_getZuid(void *dbPointer, const char *selfURI, const char *peerURI, const uint8_t peerZID[12], const uint8_t insertFlag, int *zuid, bctbx_mutex_t *zidCacheMutex) {
 	return BZRTP_ERROR_CACHEDISABLED;
 }
+
+void bzrtp_cache_bindContext(void *dbPointer) {
+}
+
+void bzrtp_cache_unbindContext(void *dbPointer) {
+}
 #endif /* ZIDCACHE_ENABLED */
@@ -19,11 +19,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <inttypes.h>
 
 #include <bctoolbox/defs.h>
 #include <bctoolbox/port.h>
 
 #include "bzrtp/bzrtp.h"
+#include "cryptoUtils.h"
 #include "zidCache.h"
 #include "bzrtpTest.h"
 #include "testUtils.h"
@@ -918,6 +920,45 @@ static void test_cacheless_exchange(void) {
 	BC_ASSERT_EQUAL(multichannel_exchange(NULL, NULL, defaultCryptoAlgoSelection(), NULL, NULL, NULL, NULL), 0, int, "%x");
 }
 
+static void test_key_agreement_pool(void) {
+	cryptoParams_t *pattern;
+	int i;
+	uint64_t hitCount;
+
+	/* Reset Global Static settings */
+	resetGlobalParams();
+
+	cryptoParams_t patterns[] = {
+		{{ZRTP_CIPHER_AES1},1,{ZRTP_HASH_S256},1,{ZRTP_KEYAGREEMENT_DH3k},1,{ZRTP_SAS_B32},1,{ZRTP_AUTHTAG_HS32},1,0},
+		{{ZRTP_CIPHER_AES3},1,{ZRTP_HASH_S256},1,{ZRTP_KEYAGREEMENT_X255},1,{ZRTP_SAS_B32},1,{ZRTP_AUTHTAG_HS32},1,0},
+		{{ZRTP_CIPHER_AES3},1,{ZRTP_HASH_S512},1,{ZRTP_KEYAGREEMENT_K255_KYB512_HQC128},1,{ZRTP_SAS_B32},1,{ZRTP_AUTHTAG_GCM},1,0},
+		{{0},0,{0},0,{0},0,{0},0,{0},0,0}, /* this pattern will end the run because cipher nb is 0 */
+	};
+
+	/* run the exchanges several times so the later ones use key pairs generated by the pool worker */
+	hitCount = bzrtp_keyAgreementPool_getHitCount();
+	BC_ASSERT_EQUAL(bzrtp_setKeyAgreementPoolSize(2), 0, int, "%d");
+	for (i=0; i<3; i++) {
+		pattern = &patterns[0];
+		while (pattern->cipherNb!=0) {
+			if ((pattern->keyAgreement[0] != ZRTP_KEYAGREEMENT_X255 || (bctbx_key_agreement_algo_list()&BCTBX_ECDH_X25519))
+				&& (pattern->keyAgreement[0] != ZRTP_KEYAGREEMENT_K255_KYB512_HQC128 || bzrtp_is_PQ_available() == TRUE)) {
+				BC_ASSERT_EQUAL(multichannel_exchange_fast(pattern, pattern, pattern, NULL, NULL, NULL, NULL), 0, int, "%x");
+			}
+			pattern++;
+		}
+		bctbx_sleep_ms(50); /* let the worker refill the pool */
+	}
+	/* some of the key pairs used by the exchanges must come from the pool */
+	BC_ASSERT_GREATER_STRICT(bzrtp_keyAgreementPool_getHitCount(), hitCount, uint64_t, "%" PRIu64);
+	BC_ASSERT_EQUAL(bzrtp_setKeyAgreementPoolSize(0), 0, int, "%d");
+
+	/* pool is disabled, exchanges are back to inline generation */
+	hitCount = bzrtp_keyAgreementPool_getHitCount();
+	BC_ASSERT_EQUAL(multichannel_exchange_fast(&patterns[0], &patterns[0], &patterns[0], NULL, NULL, NULL, NULL), 0, int, "%x");
+	BC_ASSERT_EQUAL(bzrtp_keyAgreementPool_getHitCount(), hitCount, uint64_t, "%" PRIu64);
+}
+
 #define PERFO_LOOP_NB 500
 static void test_performances(void) {
 	cryptoParams_t *pattern;
@@ -2531,6 +2572,7 @@ static test_t key_exchange_tests[] = {
 	TEST_NO_TAG("Go Clear Send simultaneously", test_goclear_sendSimultaneously),
 	TEST_NO_TAG("Loosy network GoClear", test_loosy_network_goclear),
 	TEST_NO_TAG("Loosy network GoClear Multichannel", test_loosy_network_goclear_multiChannel),
+	TEST_NO_TAG("Key agreement pool", test_key_agreement_pool),
 	TEST_NO_TAG("Performance measurements", test_performances),
 };
 
@@ -199,9 +199,77 @@ static void test_cache_zrtpSecrets(void) {
 #endif /* ZIDCACHE_ENABLED */
 }
 
+/* Check the statements kept prepared for contexts bound to the cache do not return stale data and are released with the last context */
+static void test_cache_preparedStatements(void) {
+#ifdef ZIDCACHE_ENABLED
+	bzrtpContext_t *aliceContext, *aliceContext2;
+	sqlite3 *patternDB=NULL, *aliceDB=NULL;
+	sqlite3_backup *backup;
+	uint8_t peerZIDbob[12] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xed, 0xcb, 0xa9, 0x87,};
+	uint8_t patternRs1[16] = {0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10, 0x12};
+	uint8_t newRs1[16] = {0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10, 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef};
+	uint8_t pvsFlag = 0;
+	const char *colNames[] = {"rs1", "pvs"};
+	uint8_t *colValues[] = {newRs1, &pvsFlag};
+	size_t colLength[] = {16, 1};
+	char patternFilename[1024];
+	char *resource_dir = (char *)bc_tester_get_resource_dir_prefix();
+	int ret, i;
+
+	/* work on an in memory copy of the pattern file as we will write in it */
+	sprintf(patternFilename, "%s/patternZIDAlice.sqlite", resource_dir);
+	BC_ASSERT_EQUAL((ret = bzrtptester_sqlite3_open(patternFilename, &patternDB)), SQLITE_OK, int, "0x%x");
+	if (ret != SQLITE_OK) {
+		bzrtp_message("Error: unable to find patternZIDAlice.sqlite file. Did you set correctly the --resource-dir argument(current set: %s)", resource_dir==NULL?"NULL":resource_dir);
+		return;
+	}
+	BC_ASSERT_EQUAL(sqlite3_open(":memory:", &aliceDB), SQLITE_OK, int, "0x%x");
+	backup = sqlite3_backup_init(aliceDB, "main", patternDB, "main");
+	BC_ASSERT_PTR_NOT_NULL(backup);
+	if (backup != NULL) {
+		sqlite3_backup_step(backup, -1);
+		sqlite3_backup_finish(backup);
+	}
+	sqlite3_close(patternDB);
+
+	/* two contexts sharing the same cache */
+	aliceContext = bzrtp_createBzrtpContext();
+	aliceContext2 = bzrtp_createBzrtpContext();
+	BC_ASSERT_EQUAL(bzrtp_setZIDCache(aliceContext, (void *)aliceDB, "alice@sip.linphone.org", "bob@sip.linphone.org"),0,int,"%x");
+	BC_ASSERT_EQUAL(bzrtp_setZIDCache(aliceContext2, (void *)aliceDB, "alice@sip.linphone.org", "bob@sip.linphone.org"),0,int,"%x");
+
+	/* successive reads use the same prepared statement and get the same result */
+	for (i=0; i<3; i++) {
+		BC_ASSERT_EQUAL(bzrtp_getPeerAssociatedSecrets(aliceContext, peerZIDbob), 0, int, "%x");
+		BC_ASSERT_EQUAL(aliceContext->zuid, 5, int, "%d");
+		BC_ASSERT_EQUAL(aliceContext->cachedSecret.rs1Length, 16, int, "%d");
+		BC_ASSERT_EQUAL(memcmp(aliceContext->cachedSecret.rs1, patternRs1, 16), 0, int, "%d");
+		BC_ASSERT_EQUAL(aliceContext->cachedSecret.previouslyVerifiedSas, 1, int, "%d");
+	}
+
+	/* a write performed by one context is read by the other one */
+	BC_ASSERT_EQUAL(bzrtp_getPeerAssociatedSecrets(aliceContext2, peerZIDbob), 0, int, "%x");
+	BC_ASSERT_EQUAL(bzrtp_cache_write_active(aliceContext, "zrtp", colNames, colValues, colLength, 2), 0, int, "%x");
+	BC_ASSERT_EQUAL(bzrtp_getPeerAssociatedSecrets(aliceContext2, peerZIDbob), 0, int, "%x");
+	BC_ASSERT_EQUAL(aliceContext2->cachedSecret.rs1Length, 16, int, "%d");
+	BC_ASSERT_EQUAL(memcmp(aliceContext2->cachedSecret.rs1, newRs1, 16), 0, int, "%d");
+	BC_ASSERT_EQUAL(aliceContext2->cachedSecret.previouslyVerifiedSas, 0, int, "%d");
+	BC_ASSERT_EQUAL(bzrtp_cache_getPeerStatus_lock(aliceDB, "bob@sip.linphone.org", NULL), BZRTP_CACHE_PEER_STATUS_INVALID, int, "%d");
+
+	bzrtp_destroyBzrtpContext(aliceContext, 0);
+	bzrtp_destroyBzrtpContext(aliceContext2, 0);
+
+	/* all prepared statements are finalized with the last context bound to the database */
+	BC_ASSERT_EQUAL(sqlite3_close(aliceDB), SQLITE_OK, int, "0x%x");
+#else /* ZIDCACHE_ENABLED */
+	bzrtp_message("Test skipped as ZID cache is disabled\n");
+#endif /* ZIDCACHE_ENABLED */
+}
+
 static test_t zidcache_tests[] = {
 	TEST_NO_TAG("SelfZID", test_cache_getSelfZID),
 	TEST_NO_TAG("ZRTP secrets", test_cache_zrtpSecrets),
+	TEST_NO_TAG("Prepared statements", test_cache_preparedStatements),
 };
 
 test_suite_t zidcache_test_suite = {
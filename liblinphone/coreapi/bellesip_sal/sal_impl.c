@@ -218,7 +218,8 @@ void sal_certificates_chain_parse_directory(char **certificate_pem,
                                             const char *subject,
                                             SalCertificateRawFormat format,
                                             bool_t generate_certificate,
-                                            bool_t generate_dtls_fingerprint) {
+                                            bool_t generate_dtls_fingerprint,
+                                            SalCertificateKeyType key_type) {
 	belle_sip_certificates_chain_t *certificate = NULL;
 	belle_sip_signing_key_t *key = NULL;
 	*certificate_pem = NULL;
@@ -230,7 +231,8 @@ void sal_certificates_chain_parse_directory(char **certificate_pem,
 		ms_message("Retrieve certificate with SAN or CN %s successful in path %s", subject, path);
 	} else {
 		if (generate_certificate == TRUE) {
-			if (belle_sip_generate_self_signed_certificate(path, subject, &certificate, &key) == 0) {
+			if (belle_sip_generate_self_signed_certificate_with_key_type(
+			        path, subject, (belle_sip_certificate_key_type_t)key_type, &certificate, &key) == 0) {
 				*certificate_pem = belle_sip_certificates_chain_get_pem(certificate);
 				*key_pem = belle_sip_signing_key_get_pem(key);
 				ms_message("Generate self-signed certificate with CN=%s successful", subject);
@@ -2001,6 +2001,13 @@ static void sip_config_read(LinphoneCore *lc) {
 	tmp = linphone_config_get_int(lc->config, "sip", "delayed_timeout", 4);
 	linphone_core_set_delayed_timeout(lc, tmp);
 
+	/* The pool of ZRTP key pairs generated in background is shared by all the cores of the process: only change it
+	 * when configured. */
+	if (linphone_config_has_entry(lc->config, "sip", "zrtp_key_agreement_pool_size")) {
+		tmp = linphone_config_get_int(lc->config, "sip", "zrtp_key_agreement_pool_size", 0);
+		ms_zrtp_set_key_agreement_pool_size((uint8_t)(tmp < 0 ? 0 : (tmp > 255 ? 255 : tmp)));
+	}
+
 	tmp = linphone_config_get_int(lc->config, "app", "auto_download_incoming_files_max_size", -1);
 	linphone_core_set_max_size_for_auto_download_incoming_files(lc, tmp);
 
@@ -8505,6 +8512,7 @@ void linphone_core_set_user_certificates_path(LinphoneCore *lc, const char *path
 	if (lc->user_certificates_path) bctbx_free(lc->user_certificates_path);
 	lc->user_certificates_path = new_value;
 	linphone_config_set_string(lc->config, "misc", "user_certificates_path", lc->user_certificates_path);
+	L_GET_CPP_PTR_FROM_C_OBJECT(lc)->resetDefaultDtlsIdentity();
 }
 
 const char *linphone_core_get_user_certificates_path(LinphoneCore *lc) {
@@ -377,6 +377,14 @@ typedef enum SalCertificateRawFormat { /*this enum must be same as belle_sip_cer
 	                                   SAL_CERTIFICATE_RAW_FORMAT_DER  /** ASN.1 raw format*/
 } SalCertificateRawFormat;
 
+/**
+ * Type of the key of a generated self-signed certificate
+ * */
+typedef enum SalCertificateKeyType { /*this enum must be same as belle_sip_certificate_key_type_t*/
+	                                 SAL_CERTIFICATE_KEY_RSA_3072,  /** RSA 3072 bits */
+	                                 SAL_CERTIFICATE_KEY_ECDSA_P256 /** ECDSA on curve P-256 */
+} SalCertificateKeyType;
+
 typedef struct SalAuthInfo {
 	char *username;
 	char *userid;
@@ -450,6 +458,7 @@ void sal_signing_key_parse(SalAuthInfo *auth_info, const char *buffer, const cha
  * store it into the given dir, filename will be subject.pem
  * @param[in]	generate_dtls_fingerprint	if true and we have a certificate, generate the dtls fingerprint as
  * described in rfc4572
+ * @param[in]	key_type					type of the key of the generated certificate
  */
 void sal_certificates_chain_parse_directory(char **certificate_pem,
                                             char **key_pem,
@@ -458,7 +467,8 @@ void sal_certificates_chain_parse_directory(char **certificate_pem,
                                             const char *subject,
                                             SalCertificateRawFormat format,
                                             bool_t generate_certificate,
-                                            bool_t generate_dtls_fingerprint);
+                                            bool_t generate_dtls_fingerprint,
+                                            SalCertificateKeyType key_type);
 
 void sal_certificates_chain_delete(belle_sip_certificates_chain_t *chain);
 void sal_signing_key_delete(belle_sip_signing_key_t *key);
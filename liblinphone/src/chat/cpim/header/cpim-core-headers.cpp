@@ -18,8 +18,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <iomanip>
-#include <sstream>
+#include <cstdio>
 
 #include "bctoolbox/utils.hh"
 
@@ -85,11 +84,63 @@ string Cpim::ContactHeader::getValue() const {
 }
 
 string Cpim::ContactHeader::asString() const {
-	return getName() + ": " + getValue() + "\r\n";
+	string output;
+	output.reserve(getStringLength());
+	appendTo(output);
+	return output;
+}
+
+size_t Cpim::ContactHeader::getStringLength() const {
+	L_D();
+
+	size_t length = getName().size() + d->uri.size() + 6;
+	if (!d->formalName.empty()) length += d->formalName.size() + 2;
+	return length;
+}
+
+void Cpim::ContactHeader::appendTo(string &output) const {
+	L_D();
+
+	output += getName();
+	output += ": ";
+	if (!d->formalName.empty()) {
+		output += '"';
+		output += d->formalName;
+		output += '"';
+	}
+	output += '<';
+	output += d->uri;
+	output += ">\r\n";
 }
 
 // -----------------------------------------------------------------------------
 
+namespace {
+constexpr const char *DateTimeFormat = "%04d-%02d-%02dT%02d:%02d:%02d";
+constexpr const char *TimeOffsetFormat = "%02d:%02d";
+
+size_t getDateTimeValueLength(const tm &dateTime, const tm &timeOffset, const string &signOffset) {
+	size_t length = (size_t)snprintf(nullptr, 0, DateTimeFormat, dateTime.tm_year, dateTime.tm_mon + 1,
+	                                 dateTime.tm_mday, dateTime.tm_hour, dateTime.tm_min, dateTime.tm_sec);
+	length += signOffset.size();
+	if (signOffset != "Z")
+		length += (size_t)snprintf(nullptr, 0, TimeOffsetFormat, timeOffset.tm_hour, timeOffset.tm_min);
+	return length;
+}
+
+void appendDateTimeValue(string &output, const tm &dateTime, const tm &timeOffset, const string &signOffset) {
+	char buffer[128];
+	int length = snprintf(buffer, sizeof(buffer), DateTimeFormat, dateTime.tm_year, dateTime.tm_mon + 1,
+	                      dateTime.tm_mday, dateTime.tm_hour, dateTime.tm_min, dateTime.tm_sec);
+	output.append(buffer, (size_t)length);
+	output += signOffset;
+	if (signOffset != "Z") {
+		length = snprintf(buffer, sizeof(buffer), TimeOffsetFormat, timeOffset.tm_hour, timeOffset.tm_min);
+		output.append(buffer, (size_t)length);
+	}
+}
+} // namespace
+
 class Cpim::DateTimeHeaderPrivate : public HeaderPrivate {
 public:
 	tm dateTime;
@@ -156,21 +207,30 @@ void Cpim::DateTimeHeader::setTime(const tm &time, const tm &timeOffset, const s
 string Cpim::DateTimeHeader::getValue() const {
 	L_D();
 
-	stringstream ss;
-	ss << setfill('0') << setw(4) << d->dateTime.tm_year << "-" << setfill('0') << setw(2) << d->dateTime.tm_mon + 1
-	   << "-" << setfill('0') << setw(2) << d->dateTime.tm_mday << "T" << setfill('0') << setw(2) << d->dateTime.tm_hour
-	   << ":" << setfill('0') << setw(2) << d->dateTime.tm_min << ":" << setfill('0') << setw(2) << d->dateTime.tm_sec;
+	string value;
+	appendDateTimeValue(value, d->dateTime, d->dateTimeOffset, d->signOffset);
+	return value;
+}
 
-	ss << d->signOffset;
-	if (d->signOffset != "Z")
-		ss << setfill('0') << setw(2) << d->dateTimeOffset.tm_hour << ":" << setfill('0') << setw(2)
-		   << d->dateTimeOffset.tm_min;
+string Cpim::DateTimeHeader::asString() const {
+	string output;
+	output.reserve(getStringLength());
+	appendTo(output);
+	return output;
+}
 
-	return ss.str();
+size_t Cpim::DateTimeHeader::getStringLength() const {
+	L_D();
+	return getName().size() + getDateTimeValueLength(d->dateTime, d->dateTimeOffset, d->signOffset) + 4;
 }
 
-string Cpim::DateTimeHeader::asString() const {
-	return getName() + ": " + getValue() + "\r\n";
+void Cpim::DateTimeHeader::appendTo(string &output) const {
+	L_D();
+
+	output += getName();
+	output += ": ";
+	appendDateTimeValue(output, d->dateTime, d->dateTimeOffset, d->signOffset);
+	output += "\r\n";
 }
 
 struct tm Cpim::DateTimeHeader::getTimeStruct() const {
@@ -234,7 +294,32 @@ string Cpim::NsHeader::getValue() const {
 }
 
 string Cpim::NsHeader::asString() const {
-	return getName() + ": " + getValue() + "\r\n";
+	string output;
+	output.reserve(getStringLength());
+	appendTo(output);
+	return output;
+}
+
+size_t Cpim::NsHeader::getStringLength() const {
+	L_D();
+
+	size_t length = getName().size() + d->uri.size() + 6;
+	if (!d->prefixName.empty()) length += d->prefixName.size() + 1;
+	return length;
+}
+
+void Cpim::NsHeader::appendTo(string &output) const {
+	L_D();
+
+	output += getName();
+	output += ": ";
+	if (!d->prefixName.empty()) {
+		output += d->prefixName;
+		output += ' ';
+	}
+	output += '<';
+	output += d->uri;
+	output += ">\r\n";
 }
 
 // -----------------------------------------------------------------------------
@@ -282,7 +367,33 @@ string Cpim::RequireHeader::getValue() const {
 }
 
 string Cpim::RequireHeader::asString() const {
-	return getName() + ": " + getValue() + "\r\n";
+	string output;
+	output.reserve(getStringLength());
+	appendTo(output);
+	return output;
+}
+
+size_t Cpim::RequireHeader::getStringLength() const {
+	L_D();
+
+	size_t length = getName().size() + 4;
+	for (const string &header : d->headerNames) {
+		if (header != d->headerNames.front()) length++;
+		length += header.size();
+	}
+	return length;
+}
+
+void Cpim::RequireHeader::appendTo(string &output) const {
+	L_D();
+
+	output += getName();
+	output += ": ";
+	for (const string &header : d->headerNames) {
+		if (header != d->headerNames.front()) output += ',';
+		output += header;
+	}
+	output += "\r\n";
 }
 
 // -----------------------------------------------------------------------------
@@ -331,7 +442,32 @@ string Cpim::SubjectHeader::getValue() const {
 }
 
 string Cpim::SubjectHeader::asString() const {
-	return getName() + ":" + getValue() + "\r\n";
+	string output;
+	output.reserve(getStringLength());
+	appendTo(output);
+	return output;
+}
+
+size_t Cpim::SubjectHeader::getStringLength() const {
+	L_D();
+
+	size_t length = getName().size() + d->subject.size() + 4;
+	if (!d->language.empty()) length += d->language.size() + 6;
+	return length;
+}
+
+void Cpim::SubjectHeader::appendTo(string &output) const {
+	L_D();
+
+	output += getName();
+	output += ':';
+	if (!d->language.empty()) {
+		output += ";lang=";
+		output += d->language;
+	}
+	output += ' ';
+	output += d->subject;
+	output += "\r\n";
 }
 
 LINPHONE_END_NAMESPACE
@@ -69,6 +69,8 @@ public:
 	std::string getValue() const override;
 
 	std::string asString() const override;
+	size_t getStringLength() const override;
+	void appendTo(std::string &output) const override;
 
 private:
 	L_DECLARE_PRIVATE(ContactHeader);
@@ -109,6 +111,8 @@ public:
 	std::string getValue() const override;
 
 	std::string asString() const override;
+	size_t getStringLength() const override;
+	void appendTo(std::string &output) const override;
 
 private:
 	tm getTimeStruct() const;
@@ -144,6 +148,8 @@ public:
 	std::string getValue() const override;
 
 	std::string asString() const override;
+	size_t getStringLength() const override;
+	void appendTo(std::string &output) const override;
 
 private:
 	L_DECLARE_PRIVATE(NsHeader);
@@ -173,6 +179,8 @@ public:
 	std::string getValue() const override;
 
 	std::string asString() const override;
+	size_t getStringLength() const override;
+	void appendTo(std::string &output) const override;
 
 private:
 	L_DECLARE_PRIVATE(RequireHeader);
@@ -204,6 +212,8 @@ public:
 	std::string getValue() const override;
 
 	std::string asString() const override;
+	size_t getStringLength() const override;
+	void appendTo(std::string &output) const override;
 
 private:
 	L_DECLARE_PRIVATE(SubjectHeader);
@@ -97,13 +97,36 @@ void Cpim::GenericHeader::removeParameter(const string &key, const string &value
 }
 
 string Cpim::GenericHeader::asString() const {
+	string output;
+	output.reserve(getStringLength());
+	appendTo(output);
+	return output;
+}
+
+size_t Cpim::GenericHeader::getStringLength() const {
 	L_D();
 
-	string parameters;
+	size_t length = d->name.size() + 1;
 	for (const auto &parameter : *d->parameters)
-		parameters += ";" + parameter.first + "=" + parameter.second;
+		length += parameter.first.size() + parameter.second.size() + 2;
+
+	return length + d->value.size() + 3;
+}
 
-	return d->name + ":" + parameters + " " + getValue() + "\r\n";
+void Cpim::GenericHeader::appendTo(string &output) const {
+	L_D();
+
+	output += d->name;
+	output += ':';
+	for (const auto &parameter : *d->parameters) {
+		output += ';';
+		output += parameter.first;
+		output += '=';
+		output += parameter.second;
+	}
+	output += ' ';
+	output += d->value;
+	output += "\r\n";
 }
 
 LINPHONE_END_NAMESPACE
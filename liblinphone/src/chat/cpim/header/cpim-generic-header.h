@@ -54,6 +54,8 @@ public:
 	void removeParameter(const std::string &key, const std::string &value);
 
 	std::string asString() const override;
+	size_t getStringLength() const override;
+	void appendTo(std::string &output) const override;
 
 private:
 	L_DECLARE_PRIVATE(GenericHeader);
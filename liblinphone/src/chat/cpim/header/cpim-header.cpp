@@ -31,4 +31,12 @@ LINPHONE_BEGIN_NAMESPACE
 Cpim::Header::Header(HeaderPrivate &p) : Object(p) {
 }
 
+size_t Cpim::Header::getStringLength() const {
+	return asString().size();
+}
+
+void Cpim::Header::appendTo(string &output) const {
+	output += asString();
+}
+
 LINPHONE_END_NAMESPACE
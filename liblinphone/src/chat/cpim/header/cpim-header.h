@@ -40,6 +40,12 @@ public:
 
 	virtual std::string asString() const = 0;
 
+	// Size of asString(), used to serialize a whole message with a single allocation.
+	virtual size_t getStringLength() const;
+
+	// Appends asString() to output.
+	virtual void appendTo(std::string &output) const;
+
 protected:
 	explicit Header(HeaderPrivate &p);
 
@@ -61,18 +61,20 @@ Cpim::Message::HeaderList Cpim::Message::getMessageHeaders(const string &ns) con
 }
 
 bool Cpim::Message::addMessageHeader(const Header &messageHeader, const string &ns) {
-	L_D();
-
 	auto header = Parser::getInstance()->cloneHeader(messageHeader);
 	if (header == nullptr) return false;
 
-	if (d->messageHeaders.find(ns) == d->messageHeaders.end())
-		d->messageHeaders[ns] = make_shared<Cpim::MessagePrivate::PrivHeaderList>();
+	appendMessageHeader(header, ns);
+	return true;
+}
+
+void Cpim::Message::appendMessageHeader(const shared_ptr<const Header> &messageHeader, const string &ns) {
+	L_D();
 
-	auto list = d->messageHeaders.at(ns);
-	list->push_back(header);
+	auto &list = d->messageHeaders[ns];
+	if (!list) list = make_shared<Cpim::MessagePrivate::PrivHeaderList>();
 
-	return true;
+	list->push_back(messageHeader);
 }
 
 void Cpim::Message::removeMessageHeader(const Header &messageHeader, const string &ns) {
@@ -116,6 +118,11 @@ bool Cpim::Message::addContentHeader(const Header &contentHeader) {
 	return true;
 }
 
+void Cpim::Message::appendContentHeader(const shared_ptr<const Header> &contentHeader) {
+	L_D();
+	d->contentHeaders->push_back(contentHeader);
+}
+
 void Cpim::Message::removeContentHeader(const Header &contentHeader) {
 	L_D();
 	d->contentHeaders->remove_if([&contentHeader](const shared_ptr<const Header> &header) {
@@ -135,14 +142,14 @@ shared_ptr<const Cpim::Header> Cpim::Message::getContentHeader(const string &nam
 
 // -----------------------------------------------------------------------------
 
-string Cpim::Message::getContent() const {
+const string &Cpim::Message::getContent() const {
 	L_D();
 	return d->content;
 }
 
-bool Cpim::Message::setContent(const string &content) {
+bool Cpim::Message::setContent(string content) {
 	L_D();
-	d->content = content;
+	d->content = std::move(content);
 	return true;
 }
 
@@ -151,25 +158,43 @@ bool Cpim::Message::setContent(const string &content) {
 string Cpim::Message::asString() const {
 	L_D();
 
+	// Compute the size first so that the output is allocated once.
+	size_t length = 0;
+	if (!d->messageHeaders.empty()) {
+		for (const auto &entry : d->messageHeaders) {
+			for (const auto &messageHeader : *entry.second) {
+				if (!entry.first.empty()) length += entry.first.size() + 1;
+				length += messageHeader->getStringLength();
+			}
+		}
+		length += 2;
+	}
+	for (const auto &contentHeader : *d->contentHeaders)
+		length += contentHeader->getStringLength();
+	length += 2 + d->content.size();
+
 	string output;
+	output.reserve(length);
 	if (!d->messageHeaders.empty()) {
 		for (const auto &entry : d->messageHeaders) {
-			auto list = entry.second;
-			for (const auto &messageHeader : *list) {
-				if (entry.first != "") output += entry.first + ".";
-				output += messageHeader->asString();
+			for (const auto &messageHeader : *entry.second) {
+				if (!entry.first.empty()) {
+					output += entry.first;
+					output += '.';
+				}
+				messageHeader->appendTo(output);
 			}
 		}
 
 		output += "\r\n";
 	}
 
-	for (const auto &contentHeaders : *d->contentHeaders)
-		output += contentHeaders->asString();
+	for (const auto &contentHeader : *d->contentHeaders)
+		contentHeader->appendTo(output);
 
 	output += "\r\n";
 
-	output += getContent();
+	output += d->content;
 
 	return output;
 }
@@ -30,8 +30,11 @@ LINPHONE_BEGIN_NAMESPACE
 
 namespace Cpim {
 class MessagePrivate;
+class ParserPrivate;
 
 class LINPHONE_PUBLIC Message : public Object {
+	friend class ParserPrivate;
+
 public:
 	Message();
 
@@ -47,14 +50,18 @@ public:
 	void removeContentHeader(const Header &contentHeader);
 	std::shared_ptr<const Cpim::Header> getContentHeader(const std::string &name) const;
 
-	std::string getContent() const;
-	bool setContent(const std::string &content);
+	const std::string &getContent() const;
+	bool setContent(std::string content);
 
 	std::string asString() const;
 
 	static std::shared_ptr<const Message> createFromString(const std::string &str);
 
 private:
+	// Used by the parser to add the headers it has just built, without cloning them.
+	void appendMessageHeader(const std::shared_ptr<const Header> &messageHeader, const std::string &ns);
+	void appendContentHeader(const std::shared_ptr<const Header> &contentHeader);
+
 	L_DECLARE_PRIVATE(Message);
 	L_DISABLE_COPY(Message);
 };
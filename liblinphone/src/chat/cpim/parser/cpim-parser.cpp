@@ -19,6 +19,7 @@
  */
 
 #include <set>
+#include <string_view>
 
 #include "bctoolbox/utils.hh"
 #include <belr/abnf.h>
@@ -242,8 +243,8 @@ public:
 
 private:
 	string mSign;
-	int mHour;
-	int mMinute;
+	int mHour = 0;
+	int mMinute = 0;
 };
 
 class DateTimeHeaderNode : public HeaderNode {
@@ -308,9 +309,13 @@ public:
 	}
 
 	void setOffset(const shared_ptr<DateTimeOffsetNode> &offset) {
-		mTimeOffset.tm_hour = offset->mHour;
-		mTimeOffset.tm_min = offset->mMinute;
-		mSignOffset = offset->mSign;
+		applyOffset(*offset);
+	}
+
+	void applyOffset(const DateTimeOffsetNode &offset) {
+		mTimeOffset.tm_hour = offset.mHour;
+		mTimeOffset.tm_min = offset.mMinute;
+		mSignOffset = offset.mSign;
 	}
 
 	bool isValid() const override;
@@ -318,8 +323,8 @@ public:
 	shared_ptr<Header> createHeader() const override;
 
 private:
-	tm mTime;
-	tm mTimeOffset;
+	tm mTime = {};
+	tm mTimeOffset = {};
 	string mSignOffset;
 };
 
@@ -559,15 +564,531 @@ private:
 	list<shared_ptr<HeaderNode>> mContentHeaders;
 	list<shared_ptr<HeaderNode>> mMessageHeaders;
 };
+
+// -------------------------------------------------------------------------
+// Single pass reader.
+// The functions below return the length of the longest match of a rule of
+// the CPIM grammar at a given position, 0 if it does not match.
+// -------------------------------------------------------------------------
+
+namespace {
+bool isAlpha(char c) {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool isDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+bool isHexDigit(char c) {
+	return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+char toLower(char c) {
+	return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+}
+
+bool startsWithNoCase(string_view input, size_t pos, string_view lowerCasePrefix) {
+	if (input.size() < pos + lowerCasePrefix.size()) return false;
+
+	for (size_t i = 0; i < lowerCasePrefix.size(); i++) {
+		if (toLower(input[pos + i]) != lowerCasePrefix[i]) return false;
+	}
+	return true;
+}
+
+bool isNameChar(char c) {
+	return c == 0x21 || (c >= 0x23 && c <= 0x27) || c == 0x2a || c == 0x2b || c == 0x2d || (c >= 0x5e && c <= 0x60) ||
+	       c == 0x7c || c == 0x7e || isAlpha(c) || isDigit(c);
+}
+
+size_t getUtf8MultiLength(string_view input, size_t pos) {
+	if (pos >= input.size()) return 0;
+
+	const unsigned char c = (unsigned char)input[pos];
+	size_t length;
+	if (c >= 0xc0 && c <= 0xdf) length = 2;
+	else if (c >= 0xe0 && c <= 0xef) length = 3;
+	else if (c >= 0xf0 && c <= 0xf7) length = 4;
+	else if (c >= 0xf8 && c <= 0xfb) length = 5;
+	else if (c >= 0xfc && c <= 0xfd) length = 6;
+	else return 0;
+
+	if (pos + length > input.size()) return 0;
+	for (size_t i = 1; i < length; i++) {
+		const unsigned char next = (unsigned char)input[pos + i];
+		if (next < 0x80 || next > 0xbf) return 0;
+	}
+	return length;
+}
+
+// Name = 1*NAMECHAR
+size_t getNameLength(string_view input, size_t pos) {
+	size_t i = pos;
+	while (i < input.size() && isNameChar(input[i]))
+		i++;
+	return i - pos;
+}
+
+// Header-name = [ Name-prefix "." ] Name
+size_t getHeaderNameLength(string_view input, size_t pos) {
+	const size_t prefixLength = getNameLength(input, pos);
+	if (prefixLength == 0) return 0;
+
+	const size_t dotPos = pos + prefixLength;
+	if (dotPos >= input.size() || input[dotPos] != '.') return prefixLength;
+
+	const size_t nameLength = getNameLength(input, dotPos + 1);
+	return nameLength > 0 ? prefixLength + 1 + nameLength : 0;
+}
+
+// Token = 1*( NAMECHAR / "." / UCS-high )
+size_t getTokenLength(string_view input, size_t pos) {
+	size_t i = pos;
+	while (i < input.size()) {
+		if (isNameChar(input[i]) || input[i] == '.') i++;
+		else {
+			const size_t length = getUtf8MultiLength(input, i);
+			if (length == 0) break;
+			i += length;
+		}
+	}
+	return i - pos;
+}
+
+// Escape = "\" ( "u" 4(HEXDIG) / "b" / "t" / "n" / "r" / DQUOTE / "'" / "\" )
+size_t getEscapeLength(string_view input, size_t pos) {
+	if (pos + 1 >= input.size() || input[pos] != '\\') return 0;
+
+	const char c = toLower(input[pos + 1]);
+	if (c == 'u') {
+		if (pos + 6 > input.size()) return 0;
+		for (size_t i = pos + 2; i < pos + 6; i++) {
+			if (!isHexDigit(input[i])) return 0;
+		}
+		return 6;
+	}
+	return (c == 'b' || c == 't' || c == 'n' || c == 'r' || c == '"' || c == '\'' || c == '\\') ? 2 : 0;
+}
+
+// String = DQUOTE *( Str-char / Escape ) DQUOTE
+size_t getStringLength(string_view input, size_t pos) {
+	if (pos >= input.size() || input[pos] != '"') return 0;
+
+	size_t i = pos + 1;
+	while (i < input.size()) {
+		const unsigned char c = (unsigned char)input[i];
+		size_t length;
+		if (c == '"') return i + 1 - pos;
+		if (c == '\\') length = getEscapeLength(input, i);
+		else if (c >= 0x20 && c <= 0x7e) length = 1;
+		else length = getUtf8MultiLength(input, i);
+
+		if (length == 0) return 0;
+		i += length;
+	}
+	return 0;
+}
+
+// Language-tag = 1*8ALPHA *( "-" 1*8( ALPHA / DIGIT ) )
+size_t getLanguageTagLength(string_view input, size_t pos) {
+	size_t i = pos;
+	while (i < input.size() && i - pos < 8 && isAlpha(input[i]))
+		i++;
+	if (i == pos) return 0;
+
+	while (i < input.size() && input[i] == '-') {
+		size_t subtagLength = 0;
+		while (i + 1 + subtagLength < input.size() && subtagLength < 8 &&
+		       (isAlpha(input[i + 1 + subtagLength]) || isDigit(input[i + 1 + subtagLength])))
+			subtagLength++;
+		if (subtagLength == 0) break;
+		i += 1 + subtagLength;
+	}
+	return i - pos;
+}
+
+// Parameter = Lang-param / Ext-param, the grammar takes Lang-param whenever it matches even if Ext-param is longer.
+size_t getParameterLength(string_view input, size_t pos) {
+	if (startsWithNoCase(input, pos, "lang=")) {
+		const size_t length = getLanguageTagLength(input, pos + 5);
+		if (length > 0) return 5 + length;
+	}
+
+	const size_t nameLength = getNameLength(input, pos);
+	const size_t equalPos = pos + nameLength;
+	if (nameLength == 0 || equalPos >= input.size() || input[equalPos] != '=') return 0;
+
+	// String and Token start with different characters, and Number is a subset of Token.
+	const size_t length = getStringLength(input, equalPos + 1) + getTokenLength(input, equalPos + 1);
+	return length > 0 ? nameLength + 1 + length : 0;
+}
+
+// Header-value = *HEADERCHAR, escapes are made of printable characters and do not change where the value ends.
+size_t getHeaderValueLength(string_view input, size_t pos) {
+	size_t i = pos;
+	while (i < input.size()) {
+		if (input[i] >= 0x20 && input[i] <= 0x7e) i++;
+		else {
+			const size_t length = getUtf8MultiLength(input, i);
+			if (length == 0) break;
+			i += length;
+		}
+	}
+	return i - pos;
+}
+
+// unreserved / escaped / one of otherChars.
+size_t getUriCharLength(string_view input, size_t pos, string_view otherChars) {
+	static constexpr string_view Marks = "-_.!~*'()";
+
+	if (pos >= input.size()) return 0;
+
+	const char c = input[pos];
+	if (c == '%') return (pos + 2 < input.size() && isHexDigit(input[pos + 1]) && isHexDigit(input[pos + 2])) ? 3 : 0;
+	return (isAlpha(c) || isDigit(c) || Marks.find(c) != string_view::npos || otherChars.find(c) != string_view::npos)
+	           ? 1
+	           : 0;
+}
+
+/*
+ * absoluteURI = scheme ":" ( hier-part / opaque-part )
+ * reg-name accepts every character that server does, and abs-path every character that net-path does, so that
+ * hier-part comes down to "/" followed by path characters and an optional query.
+ */
+size_t getUriLength(string_view input, size_t pos) {
+	static constexpr string_view PathChars = ":@&=+$,;/";
+	static constexpr string_view UricChars = ";/?:@&=+$,[]";
+	static constexpr string_view UricNoSlashChars = ";?:@&=+$,";
+
+	size_t i = pos;
+	if (i >= input.size() || !isAlpha(input[i])) return 0;
+
+	for (i++; i < input.size(); i++) {
+		const char c = input[i];
+		if (!isAlpha(c) && !isDigit(c) && c != '+' && c != '-' && c != '.') break;
+	}
+	if (i >= input.size() || input[i] != ':') return 0;
+	i++;
+
+	size_t length;
+	if (i < input.size() && input[i] == '/') {
+		for (i++; (length = getUriCharLength(input, i, PathChars)) > 0; i += length)
+			;
+		if (i < input.size() && input[i] == '?') {
+			for (i++; (length = getUriCharLength(input, i, UricChars)) > 0; i += length)
+				;
+		}
+		return i - pos;
+	}
+
+	length = getUriCharLength(input, i, UricNoSlashChars);
+	if (length == 0) return 0;
+	for (i += length; (length = getUriCharLength(input, i, UricChars)) > 0; i += length)
+		;
+	return i - pos;
+}
+
+bool isReservedHeaderName(string_view name) {
+	return name == "From" || name == "To" || name == "cc" || name == "DateTime" || name == "Subject" || name == "NS" ||
+	       name == "Require";
+}
+
+// Header = Header-name ":" Header-parameters SP Header-value
+shared_ptr<GenericHeader> readGenericHeader(string_view line, string_view &name) {
+	const size_t nameLength = getHeaderNameLength(line, 0);
+	if (nameLength == 0 || nameLength >= line.size() || line[nameLength] != ':') return nullptr;
+	name = line.substr(0, nameLength);
+
+	size_t i = nameLength + 1;
+	const size_t parametersPos = i;
+	while (i < line.size() && line[i] == ';') {
+		const size_t length = getParameterLength(line, i + 1);
+		if (length == 0) return nullptr;
+		i += 1 + length;
+	}
+	const string_view parameters = line.substr(parametersPos, i - parametersPos);
+
+	if (i >= line.size() || line[i] != ' ') return nullptr;
+	i++;
+
+	// Empty values are rejected by HeaderNode::isValid().
+	if (i == line.size() || getHeaderValueLength(line, i) != line.size() - i) return nullptr;
+
+	shared_ptr<GenericHeader> header = make_shared<GenericHeader>();
+	header->setValue(string(line.substr(i)));
+
+	// Same split as HeaderNode::createHeader().
+	size_t parameterPos = 0;
+	while (parameterPos < parameters.size()) {
+		size_t parameterEnd = parameters.find(';', parameterPos);
+		if (parameterEnd == string_view::npos) parameterEnd = parameters.size();
+
+		const string_view parameter = parameters.substr(parameterPos, parameterEnd - parameterPos);
+		const size_t equalIndex = parameter.find('=');
+		if (equalIndex != string_view::npos)
+			header->addParameter(string(parameter.substr(0, equalIndex)), string(parameter.substr(equalIndex + 1)));
+
+		parameterPos = parameterEnd + 1;
+	}
+
+	return header;
+}
+
+// [ Formal-name ] "<" URI ">"
+template <class T>
+shared_ptr<Header> readContactHeader(string_view value) {
+	size_t formalNameLength = getStringLength(value, 0);
+	if (formalNameLength == 0) {
+		// 1*( Token SP )
+		size_t length;
+		while ((length = getTokenLength(value, formalNameLength)) > 0 && formalNameLength + length < value.size() &&
+		       value[formalNameLength + length] == ' ')
+			formalNameLength += length + 1;
+	}
+
+	if (formalNameLength >= value.size() || value[formalNameLength] != '<') return nullptr;
+
+	const size_t uriPos = formalNameLength + 1;
+	const size_t uriLength = getUriLength(value, uriPos);
+	if (uriLength == 0 || uriPos + uriLength + 1 != value.size() || value.back() != '>') return nullptr;
+
+	T node;
+	node.setFormalName(string(value.substr(0, formalNameLength)));
+	node.setUri(string(value.substr(uriPos, uriLength)));
+	return node.createHeader();
+}
+
+// date-time = full-date "T" partial-time time-offset
+shared_ptr<Header> readDateTimeHeader(string_view value) {
+	static constexpr string_view Pattern = "0000-00-00t00:00:00";
+
+	if (value.size() <= Pattern.size()) return nullptr;
+	for (size_t i = 0; i < Pattern.size(); i++) {
+		if (Pattern[i] == '0' ? !isDigit(value[i]) : toLower(value[i]) != Pattern[i]) return nullptr;
+	}
+
+	size_t i = Pattern.size();
+	if (value[i] == '.') {
+		const size_t fractionPos = i + 1;
+		for (i = fractionPos; i < value.size() && isDigit(value[i]); i++)
+			;
+		if (i == fractionPos) return nullptr;
+	}
+
+	DateTimeOffsetNode offset;
+	if (i + 1 == value.size() && toLower(value[i]) == 'z') {
+		// Default offset.
+	} else if (i + 6 == value.size() && (value[i] == '+' || value[i] == '-') && isDigit(value[i + 1]) &&
+	           isDigit(value[i + 2]) && value[i + 3] == ':' && isDigit(value[i + 4]) && isDigit(value[i + 5])) {
+		offset.setSign(string(value.substr(i, 1)));
+		offset.setHour(string(value.substr(i + 1, 2)));
+		offset.setMinute(string(value.substr(i + 4, 2)));
+	} else return nullptr;
+
+	DateTimeHeaderNode node;
+	node.setYear(string(value.substr(0, 4)));
+	node.setMonth(string(value.substr(5, 2)));
+	node.setMonthDay(string(value.substr(8, 2)));
+	node.setHour(string(value.substr(11, 2)));
+	node.setMinute(string(value.substr(14, 2)));
+	node.setSecond(string(value.substr(17, 2)));
+	node.applyOffset(offset);
+	return node.createHeader();
+}
+
+// Subject-header-value = [ ";" Lang-param ] SP Header-value
+shared_ptr<Header> readSubjectHeader(string_view value) {
+	SubjectHeaderNode node;
+
+	size_t i = 0;
+	if (!value.empty() && value[0] == ';') {
+		if (!startsWithNoCase(value, 1, "lang=")) return nullptr;
+
+		const size_t length = getLanguageTagLength(value, 6);
+		if (length == 0) return nullptr;
+		node.setLanguage(string(value.substr(6, length)));
+		i = 6 + length;
+	}
+
+	if (i >= value.size() || value[i] != ' ') return nullptr;
+	i++;
+
+	if (getHeaderValueLength(value, i) != value.size() - i) return nullptr;
+	node.setSubject(string(value.substr(i)));
+	return node.createHeader();
+}
+
+// NS-header-value = [ Name-prefix SP ] "<" URI ">"
+shared_ptr<Header> readNsHeader(string_view value) {
+	NsHeaderNode node;
+
+	size_t i = getNameLength(value, 0);
+	if (i > 0) {
+		if (i >= value.size() || value[i] != ' ') return nullptr;
+		node.setPrefixName(string(value.substr(0, i)));
+		i++;
+	}
+
+	if (i >= value.size() || value[i] != '<') return nullptr;
+	i++;
+
+	const size_t uriLength = getUriLength(value, i);
+	if (uriLength == 0 || i + uriLength + 1 != value.size() || value.back() != '>') return nullptr;
+	node.setUri(string(value.substr(i, uriLength)));
+	return node.createHeader();
+}
+
+// Require-header-value = Header-name *( "," Header-name )
+shared_ptr<Header> readRequireHeader(string_view value) {
+	size_t i = getHeaderNameLength(value, 0);
+	if (i == 0) return nullptr;
+
+	while (i < value.size() && value[i] == ',') {
+		const size_t length = getHeaderNameLength(value, i + 1);
+		if (length == 0) return nullptr;
+		i += 1 + length;
+	}
+	if (i != value.size()) return nullptr;
+
+	RequireHeaderNode node;
+	node.setHeaderNames(string(value));
+	return node.createHeader();
+}
+
+/*
+ * Core headers are recognized by their literal prefix, as the first alternatives of Message-header. The grammar falls
+ * back to the generic Header alternative when the rest of the line is not what the core header expects, which gives a
+ * header with a reserved name and thus an invalid message.
+ */
+shared_ptr<Header> readCoreHeader(string_view line, bool &isCoreHeader) {
+	static constexpr string_view FromPrefix = "From: ";
+	static constexpr string_view ToPrefix = "To: ";
+	static constexpr string_view DateTimePrefix = "DateTime: ";
+	static constexpr string_view CcPrefix = "cc: ";
+	static constexpr string_view SubjectPrefix = "Subject:";
+	static constexpr string_view NsPrefix = "NS: ";
+	static constexpr string_view RequirePrefix = "Require: ";
+
+	isCoreHeader = true;
+	if (line.substr(0, FromPrefix.size()) == FromPrefix)
+		return readContactHeader<FromHeaderNode>(line.substr(FromPrefix.size()));
+	if (line.substr(0, ToPrefix.size()) == ToPrefix)
+		return readContactHeader<ToHeaderNode>(line.substr(ToPrefix.size()));
+	if (line.substr(0, DateTimePrefix.size()) == DateTimePrefix)
+		return readDateTimeHeader(line.substr(DateTimePrefix.size()));
+	if (line.substr(0, CcPrefix.size()) == CcPrefix)
+		return readContactHeader<CcHeaderNode>(line.substr(CcPrefix.size()));
+	if (line.substr(0, SubjectPrefix.size()) == SubjectPrefix)
+		return readSubjectHeader(line.substr(SubjectPrefix.size()));
+	if (line.substr(0, NsPrefix.size()) == NsPrefix) return readNsHeader(line.substr(NsPrefix.size()));
+	if (line.substr(0, RequirePrefix.size()) == RequirePrefix)
+		return readRequireHeader(line.substr(RequirePrefix.size()));
+
+	isCoreHeader = false;
+	return nullptr;
+}
+
+class MessageReader {
+public:
+	explicit MessageReader(string_view input) : mInput(input) {
+	}
+
+	// Crappy-header = "Content-Type: Message/CPIM" CRLF, followed by an empty line.
+	void skipCrappyHeader() {
+		static constexpr string_view CrappyHeader = "content-type: message/cpim\r\n\r\n";
+		if (startsWithNoCase(mInput, mPosition, CrappyHeader)) mPosition += CrappyHeader.size();
+	}
+
+	// Reads the next line without its CRLF, false if the input has no more complete lines.
+	bool readLine(string_view &line) {
+		const size_t end = mInput.find('\r', mPosition);
+		if (end == string_view::npos || end + 1 >= mInput.size() || mInput[end + 1] != '\n') return false;
+
+		line = mInput.substr(mPosition, end - mPosition);
+		mPosition = end + 2;
+		return true;
+	}
+
+	string_view getRemainingInput() const {
+		return mInput.substr(mPosition);
+	}
+
+private:
+	string_view mInput;
+	size_t mPosition = 0;
+};
+} // namespace
 } // namespace Cpim
 
 // -----------------------------------------------------------------------------
 
 class Cpim::ParserPrivate : public ObjectPrivate {
 public:
+	static shared_ptr<Message> readMessage(string_view input);
+
 	shared_ptr<belr::Parser<shared_ptr<Node>>> parser;
 };
 
+shared_ptr<Cpim::Message> Cpim::ParserPrivate::readMessage(string_view input) {
+	MessageReader reader(input);
+	reader.skipCrappyHeader();
+
+	const shared_ptr<Message> message = make_shared<Message>();
+	string_view line;
+
+	// Message-headers = 1*( Message-header CRLF )
+	for (bool first = true;; first = false) {
+		if (!reader.readLine(line)) return nullptr;
+		if (line.empty()) {
+			if (first) return nullptr;
+			break;
+		}
+
+		bool isCoreHeader;
+		const shared_ptr<Header> coreHeader = readCoreHeader(line, isCoreHeader);
+		if (isCoreHeader) {
+			// Cloned like the grammar does, it normalizes the header the same way.
+			if (!coreHeader || !message->addMessageHeader(*coreHeader)) return nullptr;
+			continue;
+		}
+
+		string_view name;
+		const shared_ptr<GenericHeader> header = readGenericHeader(line, name);
+		if (!header) return nullptr;
+
+		string_view ns;
+		const size_t dotIndex = name.find('.');
+		if (dotIndex != string_view::npos) {
+			ns = name.substr(0, dotIndex);
+			name = name.substr(dotIndex + 1);
+		}
+		if (isReservedHeaderName(name)) return nullptr;
+
+		header->setName(string(name));
+		message->appendMessageHeader(header, string(ns));
+	}
+
+	// Content-headers = 1*( Header CRLF )
+	for (bool first = true;; first = false) {
+		if (!reader.readLine(line)) return nullptr;
+		if (line.empty()) {
+			if (first) return nullptr;
+			break;
+		}
+
+		string_view name;
+		const shared_ptr<GenericHeader> header = readGenericHeader(line, name);
+		if (!header || isReservedHeaderName(name)) return nullptr;
+
+		header->setName(string(name));
+		message->appendContentHeader(header);
+	}
+
+	message->setContent(string(reader.getRemainingInput()));
+	return message;
+}
+
 Cpim::Parser::Parser() : Singleton(*new ParserPrivate) {
 	L_D();
 
@@ -638,6 +1159,15 @@ Cpim::Parser::Parser() : Singleton(*new ParserPrivate) {
 // -----------------------------------------------------------------------------
 
 shared_ptr<Cpim::Message> Cpim::Parser::parseMessage(const string &input) {
+	shared_ptr<Message> message = parseMessageFast(input);
+	return message ? message : parseMessageWithGrammar(input);
+}
+
+shared_ptr<Cpim::Message> Cpim::Parser::parseMessageFast(string_view input) {
+	return ParserPrivate::readMessage(input);
+}
+
+shared_ptr<Cpim::Message> Cpim::Parser::parseMessageWithGrammar(const string &input) {
 	L_D();
 
 	size_t parsedSize;
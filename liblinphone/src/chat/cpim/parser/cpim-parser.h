@@ -21,6 +21,8 @@
 #ifndef _L_CPIM_PARSER_H_
 #define _L_CPIM_PARSER_H_
 
+#include <string_view>
+
 #include "chat/cpim/message/cpim-message.h"
 #include "object/singleton.h"
 
@@ -31,12 +33,19 @@ LINPHONE_BEGIN_NAMESPACE
 namespace Cpim {
 class ParserPrivate;
 
-class Parser : public Singleton<Parser> {
+class LINPHONE_PUBLIC Parser : public Singleton<Parser> {
 	friend class Singleton<Parser>;
 
 public:
+	// Reads the message with parseMessageFast() and falls back to the grammar when it cannot.
 	std::shared_ptr<Message> parseMessage(const std::string &input);
 
+	// Single pass reader for the messages exchanged in chat rooms. Returns nullptr whenever the input is not one it
+	// can read exactly as the grammar would, including when the input is malformed.
+	std::shared_ptr<Message> parseMessageFast(std::string_view input);
+
+	std::shared_ptr<Message> parseMessageWithGrammar(const std::string &input);
+
 	std::shared_ptr<Header> cloneHeader(const Header &header);
 
 private:
@@ -28,6 +28,7 @@
 #include "bctoolbox/charconv.h"
 #include "bctoolbox/crypto.h"
 #include "bctoolbox/parser.h"
+#include "bctoolbox/vfs.h"
 #include "c-wrapper/c-wrapper.h"
 #include "chat/chat-message/chat-message-p.h"
 #include "chat/chat-room/chat-room.h"
@@ -108,6 +109,9 @@ void FileTransferChatMessageModifier::fileTransferOnProgress(BCTBX_UNUSED(belle_
 	shared_ptr<ChatMessage> message = chatMessage.lock();
 	if (!message) return;
 
+	// When resuming a download, the body handler only knows about the missing part of the file.
+	offset += downloadResumeOffset;
+	total += downloadResumeOffset;
 	size_t percentage = offset * 100 / total;
 	if (percentage <= lastNotifiedPercentage) {
 		return;
@@ -573,6 +577,11 @@ int FileTransferChatMessageModifier::startHttpTransfer(const string &url,
 		lWarning() << "Could not create http request for uri " << url;
 		goto error;
 	}
+	if (action == "GET" && downloadResumeOffset > 0) {
+		belle_sip_message_add_header(
+		    BELLE_SIP_MESSAGE(httpRequest),
+		    belle_http_header_create("Range", ("bytes=" + to_string(downloadResumeOffset) + "-").c_str()));
+	}
 	if (bh) belle_sip_message_set_body_handler(BELLE_SIP_MESSAGE(httpRequest), BELLE_SIP_BODY_HANDLER(bh));
 	// keep a reference to the http request to be able to cancel it during upload
 	belle_sip_object_ref(httpRequest);
@@ -855,6 +864,18 @@ static std::shared_ptr<FileContent> createFileTransferInformationFromHeaders(con
 	return fileContent;
 }
 
+// Checks that a partial content response carries the file from the given offset up to its end.
+static bool contentRangeResumesAt(belle_sip_message_t *response, size_t offset) {
+	belle_sip_header_t *contentRange = belle_sip_message_get_header(response, "Content-Range");
+	if (!contentRange) return false;
+	const char *value = belle_sip_header_get_unparsed_value(contentRange);
+	unsigned long long first = 0, last = 0, total = 0;
+	if (sscanf(value, "bytes %llu-%llu/%llu", &first, &last, &total) == 3) return first == offset && last + 1 == total;
+	// The complete length of the file may be unknown to the server.
+	if (sscanf(value, "bytes %llu-%llu/*", &first, &last) == 2) return first == offset;
+	return false;
+}
+
 void FileTransferChatMessageModifier::processResponseHeadersFromGetFile(const belle_http_response_event_t *event) {
 	if (event->response) {
 		int code = belle_http_response_get_status_code(event->response);
@@ -867,16 +888,38 @@ void FileTransferChatMessageModifier::processResponseHeadersFromGetFile(const be
 			return;
 		}
 
+		if (downloadResumeOffset > 0 && code != 206) {
+			lWarning() << "Server did not accept to resume the download of message [" << message
+			           << "], downloading the whole file again";
+			downloadResumeOffset = 0;
+		}
+
 		// we are receiving a response, set a specific body handler to acquire the response.
 		// if not done, belle-sip will create a memory body handler, the default
 		belle_sip_message_t *response = BELLE_SIP_MESSAGE(event->response);
 
+		if (downloadResumeOffset > 0 && !contentRangeResumesAt(response, downloadResumeOffset)) {
+			belle_sip_header_t *contentRange = belle_sip_message_get_header(response, "Content-Range");
+			lWarning() << "Content-Range ["
+			           << (contentRange ? belle_sip_header_get_unparsed_value(contentRange) : "none")
+			           << "] of the resumed download of message [" << message << "] does not match offset "
+			           << downloadResumeOffset << ", downloading the whole file again";
+			downloadResumeOffset = 0;
+			downloadRestartNeeded = true;
+			// Discard this body, it cannot be appended to the file: the whole file is requested once it is received.
+			belle_sip_message_set_body_handler(
+			    response, (belle_sip_body_handler_t *)belle_sip_user_body_handler_new(0, nullptr, nullptr, nullptr,
+			                                                                          nullptr, nullptr, nullptr));
+			return;
+		}
+
 		if (currentFileContentToTransfer) {
 			belle_sip_header_content_length_t *content_length_hdr =
 			    BELLE_SIP_HEADER_CONTENT_LENGTH(belle_sip_message_get_header(response, "Content-Length"));
 			if (content_length_hdr) {
+				// A partial content response only carries the missing part of the file.
 				currentFileContentToTransfer->setFileSize(
-				    belle_sip_header_content_length_get_content_length(content_length_hdr));
+				    downloadResumeOffset + belle_sip_header_content_length_get_content_length(content_length_hdr));
 				lInfo() << "Extracted content length " << currentFileContentToTransfer->getFileSize() << " from header";
 			}
 
@@ -888,7 +931,7 @@ void FileTransferChatMessageModifier::processResponseHeadersFromGetFile(const be
 		}
 
 		size_t body_size = 0;
-		if (currentFileContentToTransfer) body_size = currentFileContentToTransfer->getFileSize();
+		if (currentFileContentToTransfer) body_size = currentFileContentToTransfer->getFileSize() - downloadResumeOffset;
 
 		/* Reception buffering : The decryption engine must get data chunks which size is 0 mod 16
 		 * In order to achieve this, we bufferize the input at body handler level as the callbacks
@@ -909,6 +952,11 @@ void FileTransferChatMessageModifier::processResponseHeadersFromGetFile(const be
 				belle_sip_body_handler_set_size((belle_sip_body_handler_t *)body_handler, body_size);
 			}
 			belle_sip_file_body_handler_set_user_body_handler((belle_sip_file_body_handler_t *)body_handler, bh);
+			if (downloadResumeOffset > 0) {
+				lInfo() << "Resuming download of message [" << message << "] at offset " << downloadResumeOffset;
+				belle_sip_file_body_handler_set_recv_offset((belle_sip_file_body_handler_t *)body_handler,
+				                                            downloadResumeOffset);
+			}
 		} else { // We are not using a file body handler, so we shall bufferize at user body handler level
 			body_handler = (belle_sip_body_handler_t *)belle_sip_buffering_user_body_handler_new(
 			    body_size, 16, _chat_message_file_transfer_on_progress, nullptr, _chat_message_on_recv_body, nullptr,
@@ -980,10 +1028,23 @@ void FileTransferChatMessageModifier::processResponseFromGetFile(const belle_htt
 		if (!message) return;
 
 		int code = belle_http_response_get_status_code(event->response);
+		if (downloadRestartNeeded && code < 400) {
+			downloadRestartNeeded = false;
+			// Only the request is released, the content being downloaded is kept for the new one.
+			belle_sip_object_unref(httpRequest);
+			httpRequest = nullptr;
+			belle_sip_object_unref(httpListener);
+			httpListener = nullptr;
+			if (startHttpDownload(message) == -1) {
+				lError() << "Could not restart the download of message [" << message << "]";
+				onDownloadFailed();
+			}
+			return;
+		}
 		if (code >= 400) {
 			lWarning() << "[Response] File transfer failed with code " << code;
 			onDownloadFailed();
-		} else if (code != 200) {
+		} else if (code != 200 && code != 206) {
 			lWarning() << "Unhandled HTTP code response " << code << " for file transfer";
 		}
 	}
@@ -1039,9 +1100,26 @@ FileTransferChatMessageModifier::downloadFile(const shared_ptr<ChatMessage> &mes
 	}
 
 	lastNotifiedPercentage = 0;
+	downloadResumeOffset = computeDownloadResumeOffset(message, fileTransferContent);
 	lInfo() << "Downloading file transfer content [" << fileTransferContent
 	        << "], result will be available in file content [" << fileContent->getFilePath() << "]";
 
+	int err = startHttpDownload(message);
+	if (err == -1) {
+		lError() << "Content " << fileTransferContent << " cannot be downloaded due to HTTP failure";
+		return DownloadStatus::HttpFailure;
+	}
+
+	// start the download, status is In Progress
+	const auto &meAddress = message->getMeAddress();
+	if (meAddress) {
+		message->getPrivate()->setParticipantState(meAddress, ChatMessage::State::FileTransferInProgress,
+		                                           ::ms_time(nullptr));
+	}
+	return DownloadStatus::Ok;
+}
+
+int FileTransferChatMessageModifier::startHttpDownload(const shared_ptr<ChatMessage> &message) {
 	belle_http_request_listener_callbacks_t cbs = {0};
 	cbs.process_response_headers = _chat_process_response_headers_from_get_file;
 	cbs.process_response = _chat_message_process_response_from_get_file;
@@ -1049,7 +1127,7 @@ FileTransferChatMessageModifier::downloadFile(const shared_ptr<ChatMessage> &mes
 	cbs.process_auth_requested = _chat_message_process_auth_requested_download;
 
 	std::string url =
-	    fileTransferContent
+	    currentFileTransferContent
 	        ->getFileUrl(); // File URL has been set by createFileTransferInformationsFromVndGsmaRcsFtHttpXml
 	// Shall we use a proxy to get this file?
 	std::string proxy(linphone_config_get_string(message->getCore()->getCCore()->config, "misc",
@@ -1059,19 +1137,30 @@ FileTransferChatMessageModifier::downloadFile(const shared_ptr<ChatMessage> &mes
 		proxy.append("?target=");
 		url.insert(0, proxy);
 	}
-	int err = startHttpTransfer(url, "GET", nullptr, &cbs);
-	if (err == -1) {
-		lError() << "Content " << fileTransferContent << " cannot be downloaded due to HTTP failure";
-		return DownloadStatus::HttpFailure;
-	}
+	return startHttpTransfer(url, "GET", nullptr, &cbs);
+}
 
-	// start the download, status is In Progress
-	const auto &meAddress = message->getMeAddress();
-	if (meAddress) {
-		message->getPrivate()->setParticipantState(meAddress, ChatMessage::State::FileTransferInProgress,
-		                                           ::ms_time(nullptr));
-	}
-	return DownloadStatus::Ok;
+size_t FileTransferChatMessageModifier::computeDownloadResumeOffset(
+    const shared_ptr<ChatMessage> &message, const shared_ptr<FileTransferContent> &fileTransferContent) const {
+	if (!linphone_config_get_bool(linphone_core_get_config(message->getCore()->getCCore()), "misc",
+	                              "file_transfer_download_resume", FALSE))
+		return 0;
+
+	// The decryption context of encrypted files is a stream that cannot be restarted in the middle of the file.
+	const string &filePath = currentFileContentToTransfer->getFilePath();
+	if (filePath.empty() || !fileTransferContent->getFileKey().empty()) return 0;
+	if (bctbx_file_exist(filePath.c_str()) != 0) return 0;
+
+	bctbx_vfs_file_t *file = bctbx_file_open(bctbx_vfs_get_default(), filePath.c_str(), "r");
+	if (!file) return 0;
+	ssize_t partialSize = bctbx_file_size(file);
+	bctbx_file_close(file);
+
+	// Only a strictly partial file that is smaller than the announced one can be completed.
+	if (partialSize <= 0 || (size_t)partialSize >= fileTransferContent->getFileSize()) return 0;
+	lInfo() << "Found " << partialSize << " bytes of file transfer content [" << fileTransferContent
+	        << "] already downloaded in [" << filePath << "]";
+	return (size_t)partialSize;
 }
 
 // ----------------------------------------------------------
@@ -1145,6 +1234,8 @@ void FileTransferChatMessageModifier::releaseHttpRequest() {
 		}
 	}
 	currentFileContentToTransfer = nullptr;
+	downloadResumeOffset = 0;
+	downloadRestartNeeded = false;
 }
 
 /* -------------------------------------------------------------------------------------- */
@@ -90,10 +90,14 @@ private:
 	                      const std::string &action,
 	                      belle_sip_body_handler_t *bh,
 	                      belle_http_request_listener_callbacks_t *cbs);
+	// Sends the GET request of the file being downloaded, with a Range header when resuming it.
+	int startHttpDownload(const std::shared_ptr<ChatMessage> &message);
 	void fileUploadBeginBackgroundTask();
 
 	void onDownloadFailed();
 	void releaseHttpRequest();
+	size_t computeDownloadResumeOffset(const std::shared_ptr<ChatMessage> &message,
+	                                   const std::shared_ptr<FileTransferContent> &fileTransferContent) const;
 	belle_sip_body_handler_t *prepare_upload_body_handler(std::shared_ptr<ChatMessage> message);
 
 	std::string escapeFileName(const std::string &fileName) const;
@@ -108,6 +112,10 @@ private:
 	belle_http_provider_t *provider = nullptr;
 
 	size_t lastNotifiedPercentage = 0;
+	// Size of the already downloaded part of the file when a download is resumed with an HTTP Range request.
+	size_t downloadResumeOffset = 0;
+	// Set when the server answered a resumed download with another range: the whole file is requested again.
+	bool downloadRestartNeeded = false;
 
 	BackgroundTask bgTask;
 };
@@ -755,7 +755,7 @@ std::list<std::shared_ptr<const Address>> Conference::getInvitedAddresses() cons
 }
 
 std::list<std::shared_ptr<Participant>> Conference::getFullParticipantList() const {
-	auto participantList = mInvitedParticipants;
+	std::list<std::shared_ptr<Participant>> participantList = mInvitedParticipants;
 	// Add participants that are not part of the invitees'list
 	for (const auto &p : getParticipants()) {
 		const auto &pAddress = p->getAddress();
@@ -1121,17 +1121,11 @@ void Conference::setUsername(const string &username) {
 // -----------------------------------------------------------------------------
 
 shared_ptr<Participant> Conference::findParticipant(const shared_ptr<const CallSession> &session) const {
-	for (const auto &participant : mParticipants) {
-		shared_ptr<ParticipantDevice> device = participant->findDevice(session);
-		if (device || (participant->getSession() == session)) {
-			return participant;
-		}
-	}
-	// Try to find a device linked to the session and retrieve the participant. In fact, anonymous participants do not
-	// share the same address as the From header of the INVITE session
-	const auto &device = findParticipantDevice(session);
-	if (device) {
-		return device->getParticipant();
+	// The participant may also be found through the session of one of its devices. In fact, anonymous participants do
+	// not share the same address as the From header of the INVITE session
+	const auto participant = mParticipants.findParticipant(session);
+	if (participant) {
+		return participant;
 	}
 
 	lDebug() << "Unable to find participant in " << *this << " with session " << session;
@@ -1139,10 +1133,9 @@ shared_ptr<Participant> Conference::findParticipant(const shared_ptr<const CallS
 }
 
 shared_ptr<Participant> Conference::findParticipant(const std::shared_ptr<const Address> &addr) const {
-	for (const auto &participant : mParticipants) {
-		if (participant->getAddress()->weakEqual(*addr)) {
-			return participant;
-		}
+	const auto participant = mParticipants.findParticipant(addr);
+	if (participant) {
+		return participant;
 	}
 
 	lDebug() << "Unable to find participant in " << *this << " with address " << *addr;
@@ -1151,12 +1144,9 @@ shared_ptr<Participant> Conference::findParticipant(const std::shared_ptr<const
 
 std::shared_ptr<Participant>
 Conference::findInvitedParticipant(const std::shared_ptr<const Address> &participantAddress) const {
-	const auto &it = std::find_if(
-	    mInvitedParticipants.begin(), mInvitedParticipants.end(),
-	    [&participantAddress](const auto &invitee) { return participantAddress->weakEqual(*invitee->getAddress()); });
-
-	if (it != mInvitedParticipants.end()) {
-		return (*it);
+	const auto invitee = mInvitedParticipants.findParticipant(participantAddress);
+	if (invitee) {
+		return invitee;
 	}
 
 	lDebug() << "Unable to find invited participant in " << *this << " with address " << *participantAddress;
@@ -1165,10 +1155,8 @@ Conference::findInvitedParticipant(const std::shared_ptr<const Address> &partici
 
 shared_ptr<ParticipantDevice> Conference::findParticipantDeviceByLabel(LinphoneStreamType type,
                                                                        const std::string &label) const {
-	for (const auto &participant : mParticipants) {
-		auto device = participant->findDevice(type, label, false);
-		if (device) return device;
-	}
+	const auto device = mParticipants.findDeviceByLabel(type, label);
+	if (device) return device;
 
 	lDebug() << "Unable to find invited participant in " << *this << " with "
 	         << std::string(linphone_stream_type_to_string(type)) << " label " << label;
@@ -1177,11 +1165,9 @@ shared_ptr<ParticipantDevice> Conference::findParticipantDeviceByLabel(LinphoneS
 }
 
 shared_ptr<ParticipantDevice> Conference::findParticipantDeviceBySsrc(uint32_t ssrc, LinphoneStreamType type) const {
-	for (const auto &participant : mParticipants) {
-		auto device = participant->findDeviceBySsrc(ssrc, type);
-		if (device) {
-			return device;
-		}
+	const auto device = mParticipants.findDeviceBySsrc(ssrc, type);
+	if (device) {
+		return device;
 	}
 
 	lDebug() << "Unable to find participant device in " << *this << " with ssrc " << ssrc;
@@ -1191,11 +1177,16 @@ shared_ptr<ParticipantDevice> Conference::findParticipantDeviceBySsrc(uint32_t s
 
 shared_ptr<ParticipantDevice> Conference::findParticipantDevice(const std::shared_ptr<const Address> &pAddr,
                                                                 const std::shared_ptr<const Address> &dAddr) const {
-	for (const auto &participant : mParticipants) {
-		// Do not take into account anonymous participant addresses as the guessed participant address may not match the
-		// actual one. For instance, the actual anonymous participant address is sip:anonymous<number>@<domain> whereas
-		// the one guessed from a call is sip:anonymous@<domain>
-		if (!pAddr || Conference::isAnonymousParticipant(pAddr) || pAddr->weakEqual(*participant->getAddress())) {
+	// Do not take into account anonymous participant addresses as the guessed participant address may not match the
+	// actual one. For instance, the actual anonymous participant address is sip:anonymous<number>@<domain> whereas
+	// the one guessed from a call is sip:anonymous@<domain>
+	if (pAddr && !Conference::isAnonymousParticipant(pAddr)) {
+		const auto device = mParticipants.findDevice(pAddr, dAddr);
+		if (device) {
+			return device;
+		}
+	} else {
+		for (const auto &participant : mParticipants) {
 			auto device = participant->findDevice(dAddr, false);
 			if (device) {
 				return device;
@@ -1209,11 +1200,9 @@ shared_ptr<ParticipantDevice> Conference::findParticipantDevice(const std::share
 }
 
 shared_ptr<ParticipantDevice> Conference::findParticipantDevice(const shared_ptr<const CallSession> &session) const {
-	for (const auto &participant : mParticipants) {
-		auto device = participant->findDevice(session, false);
-		if (device) {
-			return device;
-		}
+	const auto device = mParticipants.findDevice(session);
+	if (device) {
+		return device;
 	}
 
 	lDebug() << "Unable to find participant device in " << *this << " with call session " << session;
@@ -1221,6 +1210,11 @@ shared_ptr<ParticipantDevice> Conference::findParticipantDevice(const shared_ptr
 	return nullptr;
 }
 
+void Conference::updateParticipantIndexes(const Participant &participant) {
+	mParticipants.update(participant);
+	mInvitedParticipants.update(participant);
+}
+
 void Conference::setActiveSpeakerParticipantDevice(const std::shared_ptr<ParticipantDevice> &device) {
 	mActiveSpeakerDevice = device;
 }
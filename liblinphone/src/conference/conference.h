@@ -31,6 +31,7 @@
 #include "conference/conference-interface.h"
 #include "conference/conference-listener.h"
 #include "conference/conference-params.h"
+#include "conference/participant-registry.h"
 #include "conference/participant.h"
 #include "core/core-accessor.h"
 #include "linphone/api/c-conference.h"
@@ -101,6 +102,9 @@ public:
 	std::shared_ptr<ParticipantDevice> findParticipantDeviceBySsrc(uint32_t ssrc, LinphoneStreamType type) const;
 	std::shared_ptr<ParticipantDevice> findParticipantDeviceByLabel(LinphoneStreamType type,
 	                                                                const std::string &label) const;
+	// To be called when an attribute the participants are looked up by changes: address, session, devices, SSRCs or
+	// stream labels.
+	void updateParticipantIndexes(const Participant &participant);
 	void setActiveSpeakerParticipantDevice(const std::shared_ptr<ParticipantDevice> &device);
 	std::shared_ptr<ParticipantDevice> getActiveSpeakerParticipantDevice() const;
 
@@ -386,7 +390,7 @@ protected:
 	                    std::shared_ptr<CallSessionListener> callSessionListener,
 	                    const std::shared_ptr<const ConferenceParams> params);
 
-	std::list<std::shared_ptr<Participant>> mParticipants;
+	ParticipantRegistry mParticipants;
 	std::shared_ptr<Participant> mActiveParticipant;
 	std::shared_ptr<Participant> mMe;
 	std::shared_ptr<ParticipantDevice> mActiveSpeakerDevice = nullptr;
@@ -403,7 +407,7 @@ protected:
 
 	ConferenceId mConferenceId;
 
-	std::list<std::shared_ptr<Participant>> mInvitedParticipants;
+	ParticipantRegistry mInvitedParticipants{false};
 
 	std::shared_ptr<ConferenceParams> mConfParams = nullptr;
 
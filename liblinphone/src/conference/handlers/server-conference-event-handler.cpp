@@ -135,12 +135,18 @@ std::shared_ptr<Content> ServerConferenceEventHandler::createNotifyFullState(con
 	}
 
 	std::shared_ptr<Address> conferenceAddress = conf->getConferenceAddress();
+	string entity = conferenceAddress ? conferenceAddress->asStringUriOnly() : std::string();
+	// The full state is the same for every subscriber, hence serialize it only once per conference version
+	const string cachedFullState = getCachedFullState(conf, entity);
+	if (!cachedFullState.empty()) {
+		return makeContent(cachedFullState);
+	}
+
 	ConferenceId conferenceId(conferenceAddress, conferenceAddress, conf->getCore()->createConferenceIdParams());
 	// Enquire whether this conference belongs to a server group chat room
 	std::shared_ptr<AbstractChatRoom> chatRoom = conf->getChatRoom();
 	const bool oneOnOne = chatRoom ? !!!chatRoom->getCurrentParams()->isGroup() : false;
 	const bool ephemerable = chatRoom ? !!chatRoom->getCurrentParams()->getChatParams()->ephemeralEnabled() : false;
-	string entity = conferenceAddress ? conferenceAddress->asStringUriOnly() : std::string();
 	string subject = conf->getUtf8Subject();
 	ConferenceType confInfo = ConferenceType(entity);
 	ConferenceDescriptionType confDescr = ConferenceDescriptionType();
@@ -283,7 +289,56 @@ std::shared_ptr<Content> ServerConferenceEventHandler::createNotifyFullState(con
 
 		confInfo.getUsers()->getUser().push_back(user);
 	}
-	return makeContent(createNotify(confInfo, true));
+	const string notify = createNotify(confInfo, true);
+	cacheFullState(conf, entity, notify);
+	return makeContent(notify);
+}
+
+string ServerConferenceEventHandler::getCachedFullState(const shared_ptr<Conference> &conf, const string &entity) {
+	if (mFullStateCache.empty() || (mFullStateCacheVersion != conf->getLastNotify()) ||
+	    (mFullStateCacheEntity != entity)) {
+		return std::string();
+	}
+
+	// The free text holds the time the NOTIFY was created, therefore it is the only field to refresh
+	if (mFullStateCacheFreeTextBegin != string::npos) {
+		const string now = Utils::toString(static_cast<long>(time(nullptr)));
+		mFullStateCache.replace(mFullStateCacheFreeTextBegin, mFullStateCacheFreeTextEnd - mFullStateCacheFreeTextBegin,
+		                        now);
+		mFullStateCacheFreeTextEnd = mFullStateCacheFreeTextBegin + now.size();
+	}
+	return mFullStateCache;
+}
+
+void ServerConferenceEventHandler::cacheFullState(const shared_ptr<Conference> &conf,
+                                                  const string &entity,
+                                                  const string &xml) {
+	invalidateFullStateCache();
+	if (xml.empty() || !linphone_config_get_bool(linphone_core_get_config(conf->getCore()->getCCore()), "misc",
+	                                             "conference_full_state_cache", TRUE)) {
+		return;
+	}
+
+	static const string freeTextTag = "<free-text>";
+	const size_t freeTextTagPosition = xml.find(freeTextTag);
+	if (freeTextTagPosition != string::npos) {
+		mFullStateCacheFreeTextBegin = freeTextTagPosition + freeTextTag.size();
+		mFullStateCacheFreeTextEnd = xml.find('<', mFullStateCacheFreeTextBegin);
+		if (mFullStateCacheFreeTextEnd == string::npos) {
+			mFullStateCacheFreeTextBegin = string::npos;
+			return;
+		}
+	}
+	mFullStateCache = xml;
+	mFullStateCacheEntity = entity;
+	mFullStateCacheVersion = conf->getLastNotify();
+}
+
+void ServerConferenceEventHandler::invalidateFullStateCache() {
+	mFullStateCache.clear();
+	mFullStateCacheEntity.clear();
+	mFullStateCacheFreeTextBegin = string::npos;
+	mFullStateCacheFreeTextEnd = string::npos;
 }
 
 void ServerConferenceEventHandler::addAvailableMediaCapabilities(const LinphoneMediaDirection audioDirection,
@@ -1323,6 +1378,7 @@ void ServerConferenceEventHandler::onFullStateReceived() {
 
 void ServerConferenceEventHandler::onParticipantAdded(const std::shared_ptr<ConferenceParticipantEvent> &eventLog,
                                                       const std::shared_ptr<Participant> &participant) {
+	invalidateFullStateCache();
 	auto conf = getConference();
 	if (!conf) {
 		return;
@@ -1347,6 +1403,7 @@ void ServerConferenceEventHandler::onParticipantAdded(const std::shared_ptr<Conf
 
 void ServerConferenceEventHandler::onParticipantRemoved(const std::shared_ptr<ConferenceParticipantEvent> &eventLog,
                                                         const std::shared_ptr<Participant> &participant) {
+	invalidateFullStateCache();
 	auto conf = getConference();
 	if (!conf) {
 		return;
@@ -1369,6 +1426,7 @@ void ServerConferenceEventHandler::onParticipantRemoved(const std::shared_ptr<Co
 
 void ServerConferenceEventHandler::onParticipantSetAdmin(const std::shared_ptr<ConferenceParticipantEvent> &eventLog,
                                                          const std::shared_ptr<Participant> &participant) {
+	invalidateFullStateCache();
 	// Do not send notify if conference pointer is null. It may mean that the conference has been terminated
 	auto conf = getConference();
 	const bool isAdmin = (eventLog->getType() == EventLog::Type::ConferenceParticipantSetAdmin);
@@ -1387,6 +1445,7 @@ void ServerConferenceEventHandler::onParticipantSetAdmin(const std::shared_ptr<C
 }
 
 void ServerConferenceEventHandler::onSubjectChanged(const std::shared_ptr<ConferenceSubjectEvent> &eventLog) {
+	invalidateFullStateCache();
 	// Do not send notify if conference pointer is null. It may mean that the conference has been terminated
 	auto conf = getConference();
 	if (conf) {
@@ -1414,6 +1473,7 @@ void ServerConferenceEventHandler::onParticipantDeviceIsMuted(const std::shared_
 
 void ServerConferenceEventHandler::onAvailableMediaChanged(
     const std::shared_ptr<ConferenceAvailableMediaEvent> &eventLog) {
+	invalidateFullStateCache();
 	// Do not send notify if conference pointer is null. It may mean that the conference has been terminated
 	auto conf = getConference();
 	if (!conf) {
@@ -1431,6 +1491,7 @@ void ServerConferenceEventHandler::onAvailableMediaChanged(
 void ServerConferenceEventHandler::onParticipantDeviceJoiningRequest(
     BCTBX_UNUSED(const std::shared_ptr<ConferenceParticipantDeviceEvent> &eventLog),
     const std::shared_ptr<ParticipantDevice> &device) {
+	invalidateFullStateCache();
 	// Do not send notify if conference pointer is null. It may mean that the conference has been terminated
 	auto conf = getConference();
 	const auto &dAddress = device->getAddress();
@@ -1447,6 +1508,7 @@ void ServerConferenceEventHandler::onParticipantDeviceJoiningRequest(
 void ServerConferenceEventHandler::onParticipantDeviceAdded(
     const std::shared_ptr<ConferenceParticipantDeviceEvent> &eventLog,
     const std::shared_ptr<ParticipantDevice> &device) {
+	invalidateFullStateCache();
 	// Do not send notify if conference pointer is null. It may mean that the conference has been terminated
 	auto conf = getConference();
 	const auto &dAddress = device->getAddress();
@@ -1475,6 +1537,7 @@ void ServerConferenceEventHandler::onParticipantDeviceAdded(
 void ServerConferenceEventHandler::onParticipantDeviceRemoved(
     const std::shared_ptr<ConferenceParticipantDeviceEvent> &eventLog,
     const std::shared_ptr<ParticipantDevice> &device) {
+	invalidateFullStateCache();
 	// Do not send notify if conference pointer is null. It may mean that the conference has been terminated
 	auto conf = getConference();
 	const auto &dAddress = device->getAddress();
@@ -1496,6 +1559,7 @@ void ServerConferenceEventHandler::onParticipantDeviceRemoved(
 void ServerConferenceEventHandler::onParticipantDeviceStateChanged(
     const std::shared_ptr<ConferenceParticipantDeviceEvent> &eventLog,
     const std::shared_ptr<ParticipantDevice> &device) {
+	invalidateFullStateCache();
 	// Do not send notify if conference pointer is null. It may mean that the conference has been terminated
 	auto conf = getConference();
 	const auto &dAddress = device->getAddress();
@@ -1517,6 +1581,7 @@ void ServerConferenceEventHandler::onParticipantDeviceStateChanged(
 void ServerConferenceEventHandler::onParticipantDeviceScreenSharingChanged(
     BCTBX_UNUSED(const std::shared_ptr<ConferenceParticipantDeviceEvent> &eventLog),
     const std::shared_ptr<ParticipantDevice> &device) {
+	invalidateFullStateCache();
 	// Do not send notify if conference pointer is null. It may mean that the conference has been terminated
 	auto conf = getConference();
 	if (conf) {
@@ -1532,6 +1597,7 @@ void ServerConferenceEventHandler::onParticipantDeviceScreenSharingChanged(
 void ServerConferenceEventHandler::onParticipantDeviceMediaCapabilityChanged(
     BCTBX_UNUSED(const std::shared_ptr<ConferenceParticipantDeviceEvent> &eventLog),
     const std::shared_ptr<ParticipantDevice> &device) {
+	invalidateFullStateCache();
 	// Do not send notify if conference pointer is null. It may mean that the conference has been terminated
 	auto conf = getConference();
 	const auto &dAddress = device->getAddress();
@@ -1546,6 +1612,7 @@ void ServerConferenceEventHandler::onParticipantDeviceMediaCapabilityChanged(
 
 void ServerConferenceEventHandler::onEphemeralModeChanged(
     const std::shared_ptr<ConferenceEphemeralMessageEvent> &eventLog) {
+	invalidateFullStateCache();
 	// Do not send notify if conference pointer is null. It may mean that the conference has been terminated
 	auto conf = getConference();
 	if (conf) {
@@ -1557,6 +1624,7 @@ void ServerConferenceEventHandler::onEphemeralModeChanged(
 
 void ServerConferenceEventHandler::onEphemeralLifetimeChanged(
     const std::shared_ptr<ConferenceEphemeralMessageEvent> &eventLog) {
+	invalidateFullStateCache();
 	// Do not send notify if the conference pointer is null. It may mean that the conference has been terminated.
 	if (getConference()) {
 		notifyAll(makeContent(createNotifyEphemeralLifetime(eventLog->getEphemeralMessageLifetime(),
@@ -1568,6 +1636,7 @@ void ServerConferenceEventHandler::onEphemeralLifetimeChanged(
 }
 
 void ServerConferenceEventHandler::onStateChanged(LinphonePrivate::ConferenceInterface::State state) {
+	invalidateFullStateCache();
 	auto conf = getConference();
 	if (!conf) {
 		return;
@@ -238,6 +238,9 @@ private:
 	std::string createNotifyEphemeralLifetime(const long &lifetime, const long &notReadLifetime);
 	std::string createNotifyEphemeralMode(const EventLog::Type &type);
 	std::shared_ptr<Content> makeContent(const std::string &xml);
+	std::string getCachedFullState(const std::shared_ptr<Conference> &conf, const std::string &entity);
+	void cacheFullState(const std::shared_ptr<Conference> &conf, const std::string &entity, const std::string &xml);
+	void invalidateFullStateCache();
 	void notifyParticipant(const std::shared_ptr<Content> &notify, const std::shared_ptr<Participant> &participant);
 	void notifyParticipantDevice(const std::shared_ptr<Content> &content,
 	                             const std::shared_ptr<ParticipantDevice> &device);
@@ -260,6 +263,15 @@ private:
 	Xsd::XmlSchema::DateTime timeTToDateTime(const time_t &unixTime) const;
 
 	std::shared_ptr<Conference> getConference() const;
+
+	// Serialized full state shared by all the subscribers of the conference. It is bound to the version and the entity
+	// it was built for and dropped as soon as the conference reports a change.
+	std::string mFullStateCache;
+	std::string mFullStateCacheEntity;
+	unsigned int mFullStateCacheVersion = 0;
+	size_t mFullStateCacheFreeTextBegin = std::string::npos;
+	size_t mFullStateCacheFreeTextEnd = std::string::npos;
+
 	L_DISABLE_COPY(ServerConferenceEventHandler);
 };
 
@@ -79,6 +79,13 @@ std::shared_ptr<Conference> ParticipantDevice::getConference() const {
 	return getParticipant() ? getParticipant()->getConference() : nullptr;
 }
 
+void ParticipantDevice::updateConferenceIndexes() const {
+	const auto participant = mParticipant.lock();
+	if (participant) {
+		participant->updateConferenceIndexes();
+	}
+}
+
 shared_ptr<Core> ParticipantDevice::getCore() const {
 	return getParticipant() ? getParticipant()->getCore() : nullptr;
 }
@@ -197,6 +204,7 @@ bool ParticipantDevice::setSsrc(const LinphoneStreamType type, uint32_t newSsrc)
 	}
 
 	if (changed) {
+		updateConferenceIndexes();
 		if (conference) {
 			lInfo() << "Setting " << std::string(linphone_stream_type_to_string(type)) << " ssrc of " << *this << " in "
 			        << *conference << " to " << newSsrc;
@@ -389,6 +397,7 @@ void ParticipantDevice::setCapabilityDescriptor(const std::string &capabilities)
 void ParticipantDevice::setSession(std::shared_ptr<CallSession> session) {
 	lInfo() << "Assigning session " << session << " to " << *this << " in " << *getConference();
 	mSession = session;
+	updateConferenceIndexes();
 	// Clear the call ID, to and from tags here but do not assign them straight away as some of them may not be
 	// available yet
 	mCallId.clear();
@@ -411,6 +420,7 @@ bool ParticipantDevice::setStreamLabel(const std::string &streamLabel, const Lin
 		lInfo() << "Setting label of " << std::string(linphone_stream_type_to_string(type)) << " stream of " << *this
 		        << " in " << *conference << " to " << streamLabel;
 		streams[type].label = streamLabel;
+		updateConferenceIndexes();
 		return true;
 	}
 	return false;
@@ -426,6 +436,7 @@ bool ParticipantDevice::setThumbnailStreamLabel(const std::string &streamLabel)
 		lInfo() << "Setting label of the thumbnail stream of " << *this << " in " << *conference << " to "
 		        << streamLabel;
 		thumbnailStream.label = streamLabel;
+		updateConferenceIndexes();
 		return true;
 	}
 	return false;
@@ -228,6 +228,8 @@ protected:
 	std::shared_ptr<Conference> getConference() const;
 
 private:
+	void updateConferenceIndexes() const;
+
 	std::weak_ptr<Participant> mParticipant;
 	std::shared_ptr<Address> mGruu;
 	std::string mName;
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2010-2025 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "address/address.h"
+#include "conference/participant-device.h"
+#include "conference/participant-registry.h"
+#include "conference/participant.h"
+#include "conference/session/call-session.h"
+
+// =============================================================================
+
+using namespace std;
+
+LINPHONE_BEGIN_NAMESPACE
+
+namespace {
+constexpr LinphoneStreamType IndexedStreamTypes[] = {LinphoneStreamTypeAudio, LinphoneStreamTypeVideo,
+                                                     LinphoneStreamTypeText};
+
+// Removes the entry of the multimap whose key is key and whose value is that of object.
+template <typename Map, typename Key, typename Predicate>
+void eraseIndexEntry(Map &map, const Key &key, Predicate isObject) {
+	const auto range = map.equal_range(key);
+	for (auto it = range.first; it != range.second; ++it) {
+		if (isObject(it->second)) {
+			map.erase(it);
+			return;
+		}
+	}
+}
+
+// Returns the single value stored under key, or nullptr if there is none. Sets ambiguous if there are several.
+template <typename Map, typename Key>
+const typename Map::mapped_type *findIndexEntry(const Map &map, const Key &key, bool &ambiguous) {
+	const auto range = map.equal_range(key);
+	ambiguous = false;
+	if (range.first == range.second) return nullptr;
+	if (next(range.first) != range.second) {
+		ambiguous = true;
+		return nullptr;
+	}
+	return &range.first->second;
+}
+
+bool isIndexedStreamType(LinphoneStreamType type) {
+	return find(begin(IndexedStreamTypes), end(IndexedStreamTypes), type) != end(IndexedStreamTypes);
+}
+
+bool hasLabel(const ParticipantDevice &device, LinphoneStreamType type, const string &label) {
+	const auto &deviceLabel = device.getStreamLabel(type);
+	return !label.empty() && ((!deviceLabel.empty() && (deviceLabel == label)) ||
+	                          ((type == LinphoneStreamTypeVideo) && (device.getThumbnailStreamLabel() == label)));
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+
+ParticipantRegistry::ParticipantRegistry(bool indexDevices) : mIndexDevices(indexDevices) {
+}
+
+ParticipantRegistry &ParticipantRegistry::operator=(const List &participants) {
+	// Keep the previous participants alive until the indexes are consistent with the new list, as destroying one of
+	// them may end up calling update().
+	List previousParticipants;
+	previousParticipants.swap(mParticipants);
+	unindexAll();
+	mParticipants = participants;
+	for (const auto &participant : mParticipants) {
+		if (mKeys.find(participant.get()) == mKeys.cend()) index(participant);
+	}
+	return *this;
+}
+
+void ParticipantRegistry::push_back(const shared_ptr<Participant> &participant) {
+	mParticipants.push_back(participant);
+	if (mKeys.find(participant.get()) == mKeys.cend()) index(participant);
+}
+
+void ParticipantRegistry::remove(const shared_ptr<Participant> &participant) {
+	// The argument may be a reference to an element of the list.
+	const auto removedParticipant = participant;
+	unindex(removedParticipant.get());
+	mParticipants.remove(removedParticipant);
+}
+
+ParticipantRegistry::const_iterator ParticipantRegistry::erase(const_iterator it) {
+	const auto removedParticipant = *it;
+	const auto nextIt = mParticipants.erase(it);
+	if (find(mParticipants.cbegin(), mParticipants.cend(), removedParticipant) == mParticipants.cend()) {
+		unindex(removedParticipant.get());
+	}
+	return nextIt;
+}
+
+void ParticipantRegistry::clear() {
+	List previousParticipants;
+	previousParticipants.swap(mParticipants);
+	unindexAll();
+}
+
+void ParticipantRegistry::update(const Participant &participant) {
+	const auto it = mKeys.find(&participant);
+	if (it == mKeys.cend()) return;
+	const auto indexedParticipant = it->second.participant;
+	unindex(indexedParticipant.get());
+	index(indexedParticipant);
+}
+
+// -----------------------------------------------------------------------------
+
+string ParticipantRegistry::getAddressKey(const Address &address) {
+	// Address::weakEqual() compares the user, the host and the port of SIP URIs, a missing user or host only being
+	// equal to a missing one. Other kinds of URI are rare enough to be looked up by scanning the list.
+	if (!address.isSip()) return string();
+	const char *username = address.getUsernameCstr();
+	const char *domain = address.getDomainCstr();
+	string key;
+	key.reserve(32);
+	key.append(username ? "u" : "-");
+	if (username) key.append(username);
+	key.push_back('\0');
+	key.append(domain ? "h" : "-");
+	if (domain) key.append(domain);
+	key.push_back('\0');
+	key.append(to_string(address.getPort()));
+	return key;
+}
+
+uint64_t ParticipantRegistry::getSsrcKey(LinphoneStreamType type, uint32_t ssrc) {
+	return (static_cast<uint64_t>(type) << 32) | ssrc;
+}
+
+string ParticipantRegistry::getLabelKey(LinphoneStreamType type, const string &label) {
+	return to_string(static_cast<int>(type)) + ":" + label;
+}
+
+void ParticipantRegistry::index(const shared_ptr<Participant> &participant) {
+	auto &keys = mKeys[participant.get()];
+	keys.participant = participant;
+
+	const auto &address = participant->getAddress();
+	if (address) keys.addressKey = getAddressKey(*address);
+	if (!keys.addressKey.empty()) mParticipantsByAddress.emplace(keys.addressKey, participant);
+
+	keys.session = participant->getSession().get();
+	if (keys.session) mParticipantsBySession.emplace(keys.session, participant);
+
+	if (!mIndexDevices) return;
+	for (const auto &device : participant->getDevices()) {
+		DeviceKeys deviceKeys;
+		deviceKeys.device = device.get();
+		const IndexedDevice indexedDevice(participant, device);
+
+		deviceKeys.session = device->getSession().get();
+		if (deviceKeys.session) mDevicesBySession.emplace(deviceKeys.session, indexedDevice);
+
+		for (const auto type : IndexedStreamTypes) {
+			const auto ssrc = device->getSsrc(type);
+			if (ssrc != 0) {
+				deviceKeys.ssrcKeys.push_back(getSsrcKey(type, ssrc));
+				mDevicesBySsrc.emplace(deviceKeys.ssrcKeys.back(), indexedDevice);
+			}
+			const auto &label = device->getStreamLabel(type);
+			if (!label.empty()) deviceKeys.labelKeys.push_back(getLabelKey(type, label));
+		}
+		const auto &thumbnailLabel = device->getThumbnailStreamLabel();
+		if (!thumbnailLabel.empty() && (thumbnailLabel != device->getStreamLabel(LinphoneStreamTypeVideo))) {
+			deviceKeys.labelKeys.push_back(getLabelKey(LinphoneStreamTypeVideo, thumbnailLabel));
+		}
+		for (const auto &labelKey : deviceKeys.labelKeys) {
+			mDevicesByLabel.emplace(labelKey, indexedDevice);
+		}
+
+		keys.devices.push_back(std::move(deviceKeys));
+	}
+}
+
+void ParticipantRegistry::unindex(const Participant *participant) {
+	const auto it = mKeys.find(participant);
+	if (it == mKeys.cend()) return;
+
+	const auto &keys = it->second;
+	const auto isParticipant = [participant](const shared_ptr<Participant> &p) { return p.get() == participant; };
+	if (!keys.addressKey.empty()) eraseIndexEntry(mParticipantsByAddress, keys.addressKey, isParticipant);
+	if (keys.session) eraseIndexEntry(mParticipantsBySession, keys.session, isParticipant);
+
+	for (const auto &deviceKeys : keys.devices) {
+		const auto device = deviceKeys.device;
+		const auto isDevice = [device](const IndexedDevice &d) { return d.second.get() == device; };
+		if (deviceKeys.session) eraseIndexEntry(mDevicesBySession, deviceKeys.session, isDevice);
+		for (const auto &ssrcKey : deviceKeys.ssrcKeys) {
+			eraseIndexEntry(mDevicesBySsrc, ssrcKey, isDevice);
+		}
+		for (const auto &labelKey : deviceKeys.labelKeys) {
+			eraseIndexEntry(mDevicesByLabel, labelKey, isDevice);
+		}
+	}
+
+	// Destroying the last reference to the participant must happen once the registry is consistent again.
+	const auto unindexedParticipant = keys.participant;
+	mKeys.erase(it);
+}
+
+void ParticipantRegistry::unindexAll() {
+	mParticipantsByAddress.clear();
+	mParticipantsBySession.clear();
+	mDevicesBySession.clear();
+	mDevicesBySsrc.clear();
+	mDevicesByLabel.clear();
+	// Same as in unindex(), the participants may only be released once the registry is empty.
+	decltype(mKeys) keys;
+	keys.swap(mKeys);
+}
+
+// -----------------------------------------------------------------------------
+
+shared_ptr<Participant> ParticipantRegistry::findParticipant(const shared_ptr<const Address> &address) const {
+	const auto key = getAddressKey(*address);
+	if (!key.empty()) {
+		bool ambiguous;
+		const auto participant = findIndexEntry(mParticipantsByAddress, key, ambiguous);
+		if (!ambiguous) {
+			if (!participant) return nullptr;
+			if ((*participant)->getAddress()->weakEqual(*address)) return *participant;
+		}
+	}
+
+	const auto it = find_if(mParticipants.cbegin(), mParticipants.cend(),
+	                        [&address](const auto &p) { return p->getAddress()->weakEqual(*address); });
+	return (it != mParticipants.cend()) ? *it : nullptr;
+}
+
+shared_ptr<Participant> ParticipantRegistry::findParticipant(const shared_ptr<const CallSession> &session) const {
+	const auto matches = [&session](const shared_ptr<Participant> &p) {
+		return (p->getSession() == session) || p->findDevice(session, false);
+	};
+
+	// A participant may be reached through its own session or through the session of one of its devices.
+	if (session && mIndexDevices) {
+		shared_ptr<Participant> candidate;
+		bool ambiguous = false;
+		const auto addCandidate = [&candidate, &ambiguous](const shared_ptr<Participant> &p) {
+			if (candidate && (candidate != p)) ambiguous = true;
+			candidate = p;
+		};
+		const auto participants = mParticipantsBySession.equal_range(session.get());
+		for (auto it = participants.first; it != participants.second; ++it) {
+			addCandidate(it->second);
+		}
+		const auto devices = mDevicesBySession.equal_range(session.get());
+		for (auto it = devices.first; it != devices.second; ++it) {
+			addCandidate(it->second.first);
+		}
+		if (!ambiguous) {
+			if (!candidate) return nullptr;
+			if (matches(candidate)) return candidate;
+		}
+	}
+
+	const auto it = find_if(mParticipants.cbegin(), mParticipants.cend(), matches);
+	return (it != mParticipants.cend()) ? *it : nullptr;
+}
+
+shared_ptr<ParticipantDevice> ParticipantRegistry::findDevice(const shared_ptr<const Address> &participantAddress,
+                                                              const shared_ptr<const Address> &deviceAddress) const {
+	const auto key = getAddressKey(*participantAddress);
+	if (!key.empty()) {
+		bool ambiguous;
+		const auto participant = findIndexEntry(mParticipantsByAddress, key, ambiguous);
+		if (!ambiguous) {
+			if (!participant) return nullptr;
+			if ((*participant)->getAddress()->weakEqual(*participantAddress)) {
+				return (*participant)->findDevice(deviceAddress, false);
+			}
+		}
+	}
+
+	for (const auto &participant : mParticipants) {
+		if (participantAddress->weakEqual(*participant->getAddress())) {
+			auto device = participant->findDevice(deviceAddress, false);
+			if (device) return device;
+		}
+	}
+	return nullptr;
+}
+
+shared_ptr<ParticipantDevice> ParticipantRegistry::findDevice(const shared_ptr<const CallSession> &session) const {
+	if (session && mIndexDevices) {
+		bool ambiguous;
+		const auto device = findIndexEntry(mDevicesBySession, session.get(), ambiguous);
+		if (!ambiguous) {
+			if (!device) return nullptr;
+			if (device->second->getSession() == session) return device->second;
+		}
+	}
+
+	for (const auto &participant : mParticipants) {
+		auto device = participant->findDevice(session, false);
+		if (device) return device;
+	}
+	return nullptr;
+}
+
+shared_ptr<ParticipantDevice> ParticipantRegistry::findDeviceBySsrc(uint32_t ssrc, LinphoneStreamType type) const {
+	// Devices having no stream of the requested type have a null SSRC, hence those are not indexed.
+	if ((ssrc != 0) && mIndexDevices && isIndexedStreamType(type)) {
+		bool ambiguous;
+		const auto device = findIndexEntry(mDevicesBySsrc, getSsrcKey(type, ssrc), ambiguous);
+		if (!ambiguous) {
+			if (!device) return nullptr;
+			if (device->second->getSsrc(type) == ssrc) return device->second;
+		}
+	}
+
+	for (const auto &participant : mParticipants) {
+		auto device = participant->findDeviceBySsrc(ssrc, type);
+		if (device) return device;
+	}
+	return nullptr;
+}
+
+shared_ptr<ParticipantDevice> ParticipantRegistry::findDeviceByLabel(LinphoneStreamType type,
+                                                                     const string &label) const {
+	if (label.empty()) return nullptr;
+	if (mIndexDevices && isIndexedStreamType(type)) {
+		bool ambiguous;
+		const auto device = findIndexEntry(mDevicesByLabel, getLabelKey(type, label), ambiguous);
+		if (!ambiguous) {
+			if (!device) return nullptr;
+			if (hasLabel(*device->second, type, label)) return device->second;
+		}
+	}
+
+	for (const auto &participant : mParticipants) {
+		auto device = participant->findDevice(type, label, false);
+		if (device) return device;
+	}
+	return nullptr;
+}
+
+LINPHONE_END_NAMESPACE
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2010-2025 Belledonne Communications SARL.
+ *
+ * This file is part of Liblinphone
+ * (see https://gitlab.linphone.org/BC/public/liblinphone).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _L_PARTICIPANT_REGISTRY_H_
+#define _L_PARTICIPANT_REGISTRY_H_
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "linphone/types.h"
+#include "linphone/utils/general.h"
+
+// =============================================================================
+
+LINPHONE_BEGIN_NAMESPACE
+
+class Address;
+class CallSession;
+class Participant;
+class ParticipantDevice;
+
+/*
+ * Ordered list of the participants of a conference, indexed by address, call session, SSRC and stream label.
+ * The list keeps the order in which participants were added and is what the conference exposes through its getters.
+ * The indexes only speed up the lookups: whenever a key is shared by several participants or devices, or cannot be
+ * computed, the lookup falls back to a scan of the list so that the result is the one a scan would have returned.
+ * Participants and devices notify the conference when an indexed attribute changes, see
+ * Conference::updateParticipantIndexes().
+ */
+class ParticipantRegistry {
+public:
+	using List = std::list<std::shared_ptr<Participant>>;
+	using const_iterator = List::const_iterator;
+
+	// The devices of invited participants are never looked up, hence they need not be indexed.
+	explicit ParticipantRegistry(bool indexDevices = true);
+	ParticipantRegistry(const ParticipantRegistry &other) = delete;
+	~ParticipantRegistry() = default;
+
+	ParticipantRegistry &operator=(const ParticipantRegistry &other) = delete;
+	ParticipantRegistry &operator=(const List &participants);
+
+	operator const List &() const {
+		return mParticipants;
+	}
+
+	const_iterator begin() const {
+		return mParticipants.cbegin();
+	}
+	const_iterator end() const {
+		return mParticipants.cend();
+	}
+	const_iterator cbegin() const {
+		return mParticipants.cbegin();
+	}
+	const_iterator cend() const {
+		return mParticipants.cend();
+	}
+	size_t size() const {
+		return mParticipants.size();
+	}
+	bool empty() const {
+		return mParticipants.empty();
+	}
+	const std::shared_ptr<Participant> &front() const {
+		return mParticipants.front();
+	}
+
+	void push_back(const std::shared_ptr<Participant> &participant);
+	void remove(const std::shared_ptr<Participant> &participant);
+	const_iterator erase(const_iterator it);
+	void clear();
+
+	// Recomputes the keys of a participant and of its devices. Participants that are not in the registry are ignored.
+	void update(const Participant &participant);
+
+	std::shared_ptr<Participant> findParticipant(const std::shared_ptr<const Address> &address) const;
+	std::shared_ptr<Participant> findParticipant(const std::shared_ptr<const CallSession> &session) const;
+	std::shared_ptr<ParticipantDevice> findDevice(const std::shared_ptr<const Address> &participantAddress,
+	                                              const std::shared_ptr<const Address> &deviceAddress) const;
+	std::shared_ptr<ParticipantDevice> findDevice(const std::shared_ptr<const CallSession> &session) const;
+	std::shared_ptr<ParticipantDevice> findDeviceBySsrc(uint32_t ssrc, LinphoneStreamType type) const;
+	std::shared_ptr<ParticipantDevice> findDeviceByLabel(LinphoneStreamType type, const std::string &label) const;
+
+	// Key under which an address is indexed, consistent with Address::weakEqual(). Empty if the address cannot be
+	// indexed, in which case lookups must scan the list.
+	static std::string getAddressKey(const Address &address);
+
+private:
+	// A device and the participant owning it.
+	using IndexedDevice = std::pair<std::shared_ptr<Participant>, std::shared_ptr<ParticipantDevice>>;
+
+	struct DeviceKeys {
+		const ParticipantDevice *device = nullptr;
+		const CallSession *session = nullptr;
+		std::vector<uint64_t> ssrcKeys;
+		std::vector<std::string> labelKeys;
+	};
+
+	struct ParticipantKeys {
+		std::shared_ptr<Participant> participant;
+		std::string addressKey;
+		const CallSession *session = nullptr;
+		std::vector<DeviceKeys> devices;
+	};
+
+	void index(const std::shared_ptr<Participant> &participant);
+	void unindex(const Participant *participant);
+	void unindexAll();
+
+	static uint64_t getSsrcKey(LinphoneStreamType type, uint32_t ssrc);
+	static std::string getLabelKey(LinphoneStreamType type, const std::string &label);
+
+	bool mIndexDevices;
+	List mParticipants;
+
+	std::unordered_map<const Participant *, ParticipantKeys> mKeys;
+	std::unordered_multimap<std::string, std::shared_ptr<Participant>> mParticipantsByAddress;
+	std::unordered_multimap<const CallSession *, std::shared_ptr<Participant>> mParticipantsBySession;
+	std::unordered_multimap<const CallSession *, IndexedDevice> mDevicesBySession;
+	std::unordered_multimap<uint64_t, IndexedDevice> mDevicesBySsrc;
+	std::unordered_multimap<std::string, IndexedDevice> mDevicesByLabel;
+};
+
+LINPHONE_END_NAMESPACE
+
+#endif // ifndef _L_PARTICIPANT_REGISTRY_H_
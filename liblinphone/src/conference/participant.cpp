@@ -88,6 +88,12 @@ Participant::createSession(const std::shared_ptr<Core> &core, const CallSessionP
 void Participant::setSession(std::shared_ptr<CallSession> callSession) {
 	lInfo() << "Assigning session " << callSession << " to " << *this;
 	session = callSession;
+	updateConferenceIndexes();
+}
+
+void Participant::removeSession() {
+	session.reset();
+	updateConferenceIndexes();
 }
 // -----------------------------------------------------------------------------
 
@@ -144,6 +150,7 @@ std::shared_ptr<ParticipantDevice> Participant::addDevice(const std::shared_ptr<
 	}
 	device = ParticipantDevice::create(getSharedFromThis(), session, name);
 	mDevices.push_back(device);
+	updateConferenceIndexes();
 	return device;
 }
 
@@ -164,11 +171,13 @@ std::shared_ptr<ParticipantDevice> Participant::addDevice(const std::shared_ptr<
 	}
 	device = ParticipantDevice::create(getSharedFromThis(), gruu, name);
 	mDevices.push_back(device);
+	updateConferenceIndexes();
 	return device;
 }
 
 void Participant::clearDevices() {
 	mDevices.clear();
+	updateConferenceIndexes();
 }
 
 shared_ptr<ParticipantDevice>
@@ -241,6 +250,7 @@ void Participant::removeDevice(const shared_ptr<const CallSession> &session) {
 	mDevices.erase(std::remove_if(mDevices.begin(), mDevices.end(),
 	                              [&session](const auto &device) { return (device->getSession() == session); }),
 	               mDevices.end());
+	updateConferenceIndexes();
 }
 
 void Participant::removeDevice(const std::shared_ptr<Address> &gruu) {
@@ -248,6 +258,15 @@ void Participant::removeDevice(const std::shared_ptr<Address> &gruu) {
 	    std::remove_if(mDevices.begin(), mDevices.end(),
 	                   [&gruu](const auto &device) { return (device->getAddress()->getUri() == gruu->getUri()); }),
 	    mDevices.end());
+	updateConferenceIndexes();
+}
+
+void Participant::updateConferenceIndexes() const {
+	// Participants of one-to-one chat rooms have no conference.
+	const auto conference = mConference.lock();
+	if (conference) {
+		conference->updateParticipantIndexes(*this);
+	}
 }
 
 // -----------------------------------------------------------------------------
@@ -255,6 +274,7 @@ void Participant::removeDevice(const std::shared_ptr<Address> &gruu) {
 void Participant::setAddress(const std::shared_ptr<const Address> &newAddr) {
 	mAddress = Address::create(newAddr->getUriWithoutGruu());
 	mAddress->setDisplayName(newAddr->getDisplayName());
+	updateConferenceIndexes();
 }
 
 const std::shared_ptr<Address> &Participant::getAddress() const {
@@ -68,6 +68,7 @@ class LINPHONE_PUBLIC Participant : public bellesip::HybridObject<LinphonePartic
 	friend class MainDbPrivate;
 	friend class MediaSessionPrivate;
 	friend class ParticipantDevice;
+	friend class ParticipantRegistry;
 	friend class ClientConference;
 	friend class ClientConferenceEventHandler;
 	friend class ServerChatRoom;
@@ -159,9 +160,7 @@ protected:
 	inline std::shared_ptr<CallSession> getSession() const {
 		return session;
 	}
-	inline void removeSession() {
-		session.reset();
-	}
+	void removeSession();
 	void setAddress(const std::shared_ptr<const Address> &addr);
 
 	std::shared_ptr<ParticipantDevice> addDevice(const std::shared_ptr<ParticipantDevice> &device);
@@ -173,6 +172,9 @@ protected:
 	void removeDevice(const std::shared_ptr<Address> &gruu);
 	void removeDevice(const std::shared_ptr<const CallSession> &session);
 
+	// Notifies the conference that the participant may have to be looked up under different keys.
+	void updateConferenceIndexes() const;
+
 private:
 	std::weak_ptr<Conference> mConference;
 	std::shared_ptr<Address> mAddress;
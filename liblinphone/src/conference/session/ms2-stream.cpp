@@ -927,15 +927,19 @@ void MS2Stream::initDtlsParams(MediaStream *ms) {
 			    &certificate, &key, &fingerprint, linphone_core_get_user_certificates_path(getCCore()), localAddrUri,
 			    SAL_CERTIFICATE_RAW_FORMAT_PEM,
 			    false, // Do not generate a self signed certificate if we do not find it
-			    true);
+			    true, SAL_CERTIFICATE_KEY_RSA_3072);
 
-			/* third: fallback on the default selfsigned certificate in the user certificate path set in core */
+			/* third: fallback on the default selfsigned certificate in the user certificate path set in core, loaded
+			 * once per core */
 			if (certificate == nullptr || key == nullptr) {
 				lInfo() << "DTLS-SRTP : No client certificate found for user " << localAddrUri
 				        << " fallback on linphone-dtls-default-identity";
-				sal_certificates_chain_parse_directory(
-				    &certificate, &key, &fingerprint, linphone_core_get_user_certificates_path(getCCore()),
-				    "linphone-dtls-default-identity", SAL_CERTIFICATE_RAW_FORMAT_PEM, true, true);
+				string defaultCertificate, defaultKey, defaultFingerprint;
+				if (getCore().getDefaultDtlsIdentity(defaultCertificate, defaultKey, defaultFingerprint)) {
+					certificate = ms_strdup(defaultCertificate.c_str());
+					key = ms_strdup(defaultKey.c_str());
+					if (!defaultFingerprint.empty()) fingerprint = ms_strdup(defaultFingerprint.c_str());
+				}
 			} else {
 				lInfo() << "DTLS-SRTP : user " << localAddrUri << " uses client certificate found in "
 				        << linphone_core_get_user_certificates_path(getCCore());
@@ -38,6 +38,7 @@ MS2VideoMixer::MS2VideoMixer(MixerSession &session) : StreamMixer(session), MS2V
 	LinphoneConfig *config = linphone_core_get_config(mSession.getCCore());
 	mConferenceParams.mode = static_cast<MSConferenceMode>(
 	    linphone_config_get_int(config, "video", "conference_mode", MSConferenceModeRouterPayload));
+	mConferenceParams.temporal_layers = linphone_config_get_int(config, "video", "conference_temporal_layers", 1);
 	mConferenceMix = ms_video_conference_new(mSession.getCCore()->factory, &mConferenceParams);
 	mConferenceThumbnail = ms_video_conference_new(mSession.getCCore()->factory, &mConferenceParams);
 }
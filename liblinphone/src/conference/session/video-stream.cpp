@@ -592,6 +592,11 @@ void MS2VideoStream::render(const OfferAnswerContext &ctx, CallSession::State ta
 			// If we are a client in a RemoteConference, enable the active speaker mode for the main video stream.
 			// This mode will listen to any new incoming ssrc in the stream.
 			if (isMain()) video_stream_enable_active_speaker_mode(mStream, TRUE);
+			// Temporal layers let the conference server lower the frame rate of the participants on a poor link,
+			// instead of lowering our bitrate for everyone.
+			video_stream_set_temporal_layers(
+			    mStream, linphone_config_get_int(linphone_core_get_config(getCCore()), "video",
+			                                     "conference_temporal_layers", 1));
 		}
 	}
 
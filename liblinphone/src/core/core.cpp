@@ -248,6 +248,12 @@ void CorePrivate::init() {
 	createConferenceCleanupTimer(q->getConferenceCleanupPeriod());
 	createAsyncTasksCleanupTimer();
 
+	if (linphone_core_get_media_encryption(lc) == LinphoneMediaEncryptionDTLS &&
+	    linphone_core_media_encryption_supported(lc, LinphoneMediaEncryptionDTLS)) {
+		// Calls would otherwise wait for the default certificate to be generated.
+		q->preloadDefaultDtlsIdentity();
+	}
+
 #ifdef __ANDROID__
 	// On Android assume Core has been started in background,
 	// otherwise first notifyEnterForeground() will do nothing.
@@ -3851,6 +3857,59 @@ void Core::setEktPluginLoaded(bool ektPluginLoaded) {
 	mEktPluginLoaded = ektPluginLoaded;
 }
 
+// -----------------------------------------------------------------------------
+
+SalCertificateKeyType Core::getDefaultDtlsIdentityKeyType() const {
+	// ECDSA keys are generated in a few milliseconds, RSA 3072 bits ones may take hundreds of them.
+	const string keyType = L_C_TO_STRING(
+	    linphone_config_get_string(linphone_core_get_config(getCCore()), "rtp", "dtls_certificate_key_type", "rsa"));
+	return (keyType == "ecdsa") ? SAL_CERTIFICATE_KEY_ECDSA_P256 : SAL_CERTIFICATE_KEY_RSA_3072;
+}
+
+void Core::loadDefaultDtlsIdentity(const string &path, SalCertificateKeyType keyType) {
+	lock_guard<mutex> lock(mDefaultDtlsIdentityMutex);
+	if (!mDefaultDtlsCertificate.empty()) return;
+
+	char *certificate = nullptr;
+	char *key = nullptr;
+	char *fingerprint = nullptr;
+	sal_certificates_chain_parse_directory(&certificate, &key, &fingerprint, path.empty() ? nullptr : path.c_str(),
+	                                       "linphone-dtls-default-identity", SAL_CERTIFICATE_RAW_FORMAT_PEM, true, true,
+	                                       keyType);
+	if (certificate && key) {
+		mDefaultDtlsCertificate = certificate;
+		mDefaultDtlsKey = key;
+		mDefaultDtlsFingerprint = L_C_TO_STRING(fingerprint);
+	}
+	if (certificate) ms_free(certificate);
+	if (key) ms_free(key);
+	if (fingerprint) ms_free(fingerprint);
+}
+
+bool Core::getDefaultDtlsIdentity(string &certificate, string &key, string &fingerprint) {
+	loadDefaultDtlsIdentity(L_C_TO_STRING(linphone_core_get_user_certificates_path(getCCore())),
+	                        getDefaultDtlsIdentityKeyType());
+	lock_guard<mutex> lock(mDefaultDtlsIdentityMutex);
+	certificate = mDefaultDtlsCertificate;
+	key = mDefaultDtlsKey;
+	fingerprint = mDefaultDtlsFingerprint;
+	return !certificate.empty();
+}
+
+void Core::preloadDefaultDtlsIdentity() {
+	L_D();
+	const string path = L_C_TO_STRING(linphone_core_get_user_certificates_path(getCCore()));
+	const SalCertificateKeyType keyType = getDefaultDtlsIdentityKeyType();
+	d->doAsync([this, path, keyType]() { loadDefaultDtlsIdentity(path, keyType); });
+}
+
+void Core::resetDefaultDtlsIdentity() {
+	lock_guard<mutex> lock(mDefaultDtlsIdentityMutex);
+	mDefaultDtlsCertificate.clear();
+	mDefaultDtlsKey.clear();
+	mDefaultDtlsFingerprint.clear();
+}
+
 #ifdef HAVE_HIDAPI
 const std::list<std::shared_ptr<HidDevice>> &Core::getHidDevices() const {
 	L_D();
@@ -23,6 +23,7 @@
 
 #include <functional>
 #include <list>
+#include <mutex>
 #include <optional>
 
 #include "mediastreamer2/mssndcard.h"
@@ -547,6 +548,18 @@ public:
 	bool isEktPluginLoaded() const;
 	void setEktPluginLoaded(bool ektPluginLoaded);
 
+	// ---------------------------------------------------------------------------
+	// DTLS-SRTP
+	// ---------------------------------------------------------------------------
+
+	// Get the linphone-dtls-default-identity certificate, key and fingerprint, used when no certificate matches the
+	// local address. It is read from (or generated into) the user certificates path once, then kept by the core.
+	bool getDefaultDtlsIdentity(std::string &certificate, std::string &key, std::string &fingerprint);
+	// Load or generate the default DTLS identity in the background, so that the first call does not wait for it.
+	void preloadDefaultDtlsIdentity();
+	// Forget the default DTLS identity, for example when the user certificates path changes.
+	void resetDefaultDtlsIdentity();
+
 	// ---------------------------------------------------------------------------
 	// HID devices
 	// ---------------------------------------------------------------------------
@@ -604,6 +617,14 @@ private:
 
 	bool mEktPluginLoaded = false;
 
+	void loadDefaultDtlsIdentity(const std::string &path, SalCertificateKeyType keyType);
+	SalCertificateKeyType getDefaultDtlsIdentityKeyType() const;
+
+	std::mutex mDefaultDtlsIdentityMutex;
+	std::string mDefaultDtlsCertificate;
+	std::string mDefaultDtlsKey;
+	std::string mDefaultDtlsFingerprint;
+
 	L_DECLARE_PRIVATE(Core);
 	L_DISABLE_COPY(Core);
 };
@@ -116,6 +116,10 @@ private:
 	std::string selectSipAddressFromId(long long sipAddressId) const;
 	void deleteChatRoom(const long long &dbId) const;
 	void deleteChatRoom(const ConferenceId &conferenceId);
+	int selectUnreadChatMessageCount(long long chatRoomId) const;
+	void updateUnreadChatMessageCount(long long chatRoomId, const ConferenceId &conferenceId, int delta) const;
+	// Computes the unread chat message counter of a chat room, or of all of them if chatRoomId is negative.
+	void recountUnreadChatMessages(long long chatRoomId = -1) const;
 	long long selectChatRoomId(long long peerSipAddressId) const;
 	long long selectChatRoomId(long long peerSipAddressId, long long localSipAddressId) const;
 	long long selectChatRoomId(const ConferenceId &conferenceId) const;
@@ -274,6 +278,8 @@ private:
 	// ---------------------------------------------------------------------------
 
 	mutable LruCache<ConferenceId, int> unreadChatMessageCountCache;
+	// Sum of the unread chat message counters of all chat rooms, -1 until it is read from the database.
+	mutable int unreadChatMessageGlobalCount = -1;
 
 	L_DECLARE_PUBLIC(MainDb);
 };
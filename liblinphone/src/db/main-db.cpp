@@ -1191,6 +1191,15 @@ std::string MainDbPrivate::selectSipAddressFromId(long long sipAddressId) const
 
 void MainDbPrivate::deleteChatRoom(const long long &dbId) const {
 #ifdef HAVE_DB_STORAGE
+	// Drop the unread messages of the chat room from the counters before its row disappears.
+	const int unreadCount = selectUnreadChatMessageCount(dbId);
+	if (unreadChatMessageGlobalCount >= 0) unreadChatMessageGlobalCount -= unreadCount;
+
+	ConferenceId conferenceId = getConferenceIdFromCache(dbId);
+	if (!conferenceId.isValid()) conferenceId = selectConferenceId(dbId);
+	if (conferenceId.isValid()) unreadChatMessageCountCache.insert(conferenceId, 0);
+	else unreadChatMessageCountCache.clear();
+
 	invalidConferenceEventsFromQuery("SELECT event_id FROM conference_event WHERE chat_room_id = :chatRoomId", dbId);
 
 	*dbSession.getBackendSession() << "DELETE FROM chat_room WHERE id = :chatRoomId", soci::use(dbId);
@@ -1201,10 +1210,67 @@ void MainDbPrivate::deleteChatRoom(const ConferenceId &conferenceId) {
 #ifdef HAVE_DB_STORAGE
 	const long long &dbChatRoomId = selectChatRoomId(conferenceId);
 	deleteChatRoom(dbChatRoomId);
+	// The conference ID stored in database may differ from the requested one (GRUU), so reset this entry too.
 	unreadChatMessageCountCache.insert(conferenceId, 0);
 #endif
 }
 
+// -----------------------------------------------------------------------------
+
+// The number of chat messages not marked as read of each chat room is stored in chat_room.unread_message_count. It is
+// updated along with every statement inserting, updating or deleting chat messages so that it never has to be
+// computed again from the conference_chat_message_event table.
+
+int MainDbPrivate::selectUnreadChatMessageCount(long long chatRoomId) const {
+#ifdef HAVE_DB_STORAGE
+	int count = 0;
+	*dbSession.getBackendSession() << "SELECT unread_message_count FROM chat_room WHERE id = :chatRoomId",
+	    soci::use(chatRoomId), soci::into(count);
+	return count;
+#else
+	return 0;
+#endif
+}
+
+void MainDbPrivate::updateUnreadChatMessageCount(long long chatRoomId,
+                                                 const ConferenceId &conferenceId,
+                                                 int delta) const {
+#ifdef HAVE_DB_STORAGE
+	if (delta == 0) return;
+
+	*dbSession.getBackendSession()
+	    << "UPDATE chat_room SET unread_message_count = unread_message_count + :delta WHERE id = :chatRoomId",
+	    soci::use(delta), soci::use(chatRoomId);
+
+	int *count = unreadChatMessageCountCache[conferenceId];
+	if (count) {
+		L_ASSERT(*count + delta >= 0);
+		*count += delta;
+	}
+	if (unreadChatMessageGlobalCount >= 0) unreadChatMessageGlobalCount += delta;
+#endif
+}
+
+void MainDbPrivate::recountUnreadChatMessages(long long chatRoomId) const {
+#ifdef HAVE_DB_STORAGE
+	string query = "UPDATE chat_room SET unread_message_count = ("
+	               "  SELECT COUNT(*) FROM conference_event, conference_chat_message_event"
+	               "  WHERE conference_event.event_id = conference_chat_message_event.event_id"
+	               "  AND conference_event.chat_room_id = chat_room.id"
+	               "  AND conference_chat_message_event.marked_as_read = 0"
+	               ")";
+
+	soci::session *session = dbSession.getBackendSession();
+	if (chatRoomId < 0) {
+		*session << query;
+		unreadChatMessageCountCache.clear();
+	} else {
+		*session << query + " WHERE id = :chatRoomId", soci::use(chatRoomId);
+	}
+	unreadChatMessageGlobalCount = -1;
+#endif
+}
+
 long long MainDbPrivate::selectChatRoomId(long long peerSipAddressId) const {
 #ifdef HAVE_DB_STORAGE
 	long long chatRoomId;
@@ -1808,10 +1874,7 @@ long long MainDbPrivate::insertConferenceChatMessageEvent(const shared_ptr<Event
 	*dbSession.getBackendSession() << "UPDATE chat_room SET last_message_id = :1 WHERE id = :2", soci::use(eventId),
 	    soci::use(dbChatRoomId);
 
-	if (direction == int(ChatMessage::Direction::Incoming) && !markedAsRead) {
-		int *count = unreadChatMessageCountCache[chatRoom->getConferenceId()];
-		if (count) ++*count;
-	}
+	if (!markedAsRead) updateUnreadChatMessageCount(dbChatRoomId, chatRoom->getConferenceId(), 1);
 	return eventId;
 #else
 	return -1;
@@ -1881,14 +1944,10 @@ void MainDbPrivate::updateConferenceChatMessageEvent(const shared_ptr<EventLog>
 	const bool markedAsRead = chatMessage->getPrivate()->isMarkedAsRead();
 
 	// 2. Update unread chat message count if necessary.
-	const bool isOutgoing = chatMessage->getDirection() == ChatMessage::Direction::Outgoing;
 	shared_ptr<AbstractChatRoom> chatRoom = chatMessage->getChatRoom();
-	if (!isOutgoing && markedAsRead) {
-		int *count = unreadChatMessageCountCache[chatRoom->getConferenceId()];
-		if (count && !dbMarkedAsRead) {
-			L_ASSERT(*count > 0);
-			--*count;
-		}
+	if (markedAsRead != dbMarkedAsRead) {
+		const ConferenceId &conferenceId = chatRoom->getConferenceId();
+		updateUnreadChatMessageCount(selectChatRoomId(conferenceId), conferenceId, markedAsRead ? -1 : 1);
 	}
 
 	// 3. Update chat message event.
@@ -3423,6 +3482,14 @@ void MainDbPrivate::updateSchema() {
 		         << ": Column 'ephemeral_not_read_lifetime' already exists in table 'chat_message_ephemeral_event'";
 	}
 
+	try {
+		*session << "ALTER TABLE chat_room ADD COLUMN unread_message_count INT NOT NULL DEFAULT 0";
+		recountUnreadChatMessages();
+	} catch (const soci::soci_error &e) {
+		lDebug() << "Caught exception " << e.what()
+		         << ": Column 'unread_message_count' already exists in table 'chat_room'";
+	}
+
 	// /!\ Warning : if varchar columns < 255 were to be indexed, their size must be set back to 191 = max indexable
 	// (KEY or UNIQUE) varchar size for mysql < 5.7 with charset utf8mb4 (both here and in column creation)
 	//
@@ -3770,6 +3837,7 @@ bool MainDbPrivate::importLegacyHistory(DbSession &inDbSession) {
 		       "AND conference_event.chat_room_id=chat_room.id "
 		       "GROUP BY conference_event.chat_room_id),0))"; // if there are no messages, the first is NULL. So put
 		                                                      // a 0 to the ID
+		recountUnreadChatMessages();
 		tr.commit();
 
 		// Only update the module version once the import has been done.
@@ -4886,13 +4954,22 @@ bool MainDb::deleteEvent(const shared_ptr<const EventLog> &eventLog) {
 	return L_DB_TRANSACTION_C(&mainDb) {
 		MainDbPrivate *const d = mainDb.getPrivate();
 		soci::session *session = d->dbSession.getBackendSession();
+		const bool isChatMessage = eventLog->getType() == EventLog::Type::ConferenceChatMessage;
+		// The stored flag is the one the unread chat message counter was computed from.
+		int markedAsRead = 1;
+		if (isChatMessage) {
+			*session << "SELECT marked_as_read FROM conference_chat_message_event WHERE event_id = :id",
+			    soci::use(dEventKey->storageId), soci::into(markedAsRead);
+		}
+
 		*session << "DELETE FROM event WHERE id = :id", soci::use(dEventKey->storageId);
 
-		if (eventLog->getType() == EventLog::Type::ConferenceChatMessage) {
+		if (isChatMessage) {
 			shared_ptr<ChatMessage> chatMessage(
 			    static_pointer_cast<const ConferenceChatMessageEvent>(eventLog)->getChatMessage());
 			shared_ptr<AbstractChatRoom> chatRoom(chatMessage->getChatRoom());
 			const long long &dbChatRoomId = d->selectChatRoomId(chatRoom->getConferenceId());
+			if (!markedAsRead) d->updateUnreadChatMessageCount(dbChatRoomId, chatRoom->getConferenceId(), -1);
 			*session << "UPDATE chat_room SET last_message_id = IFNULL((SELECT id FROM conference_event_simple_view "
 			            "WHERE chat_room_id = chat_room.id AND type = "
 			         << mapEventFilterToSql(ConferenceChatMessageFilter)
@@ -4908,16 +4985,6 @@ bool MainDb::deleteEvent(const shared_ptr<const EventLog> &eventLog) {
 		// Reset storage ID as event is not valid anymore
 		const_cast<EventLogPrivate *>(dEventLog)->resetStorageId();
 
-		if (eventLog->getType() == EventLog::Type::ConferenceChatMessage) {
-			shared_ptr<ChatMessage> chatMessage(
-			    static_pointer_cast<const ConferenceChatMessageEvent>(eventLog)->getChatMessage());
-			if (chatMessage->getDirection() == ChatMessage::Direction::Incoming &&
-			    !chatMessage->getPrivate()->isMarkedAsRead()) {
-				int *count = d->unreadChatMessageCountCache[chatMessage->getChatRoom()->getConferenceId()];
-				if (count) --*count;
-			}
-		}
-
 		return true;
 	};
 #else
@@ -5073,11 +5140,6 @@ int MainDb::getUnreadChatMessageCount(const ConferenceId &conferenceId) const {
 	const int *count = d->unreadChatMessageCountCache[conferenceId];
 	if (count) return *count;
 
-	string query = "SELECT COUNT(*) FROM conference_chat_message_event WHERE event_id IN ("
-	               "  SELECT event_id FROM conference_event WHERE chat_room_id = :chatRoomId"
-	               ") AND "
-	               " marked_as_read = 0 ";
-
 	/*
 	DurationLogger durationLogger(
 	    "Get unread chat messages count of: (peer=" + conferenceId.getPeerAddress()->toStringUriOnlyOrdered() +
@@ -5086,10 +5148,8 @@ int MainDb::getUnreadChatMessageCount(const ConferenceId &conferenceId) const {
 	*/
 
 	return L_DB_TRANSACTION {
-		int count = 0;
-		soci::session *session = d->dbSession.getBackendSession();
 		const long long &dbChatRoomId = d->selectChatRoomId(conferenceId);
-		*session << query, soci::use(dbChatRoomId), soci::into(count);
+		const int count = d->selectUnreadChatMessageCount(dbChatRoomId);
 		d->unreadChatMessageCountCache.insert(conferenceId, count);
 		return count;
 	};
@@ -5101,10 +5161,16 @@ int MainDb::getUnreadChatMessageCount(const ConferenceId &conferenceId) const {
 int MainDb::getUnreadChatMessageGlobalCount() const {
 #ifdef HAVE_DB_STORAGE
 	L_D();
+	if (d->unreadChatMessageGlobalCount >= 0) return d->unreadChatMessageGlobalCount;
+
 	return L_DB_TRANSACTION {
+		// Summed here rather than with SUM() whose result type depends on the backend.
 		int count = 0;
 		soci::session *session = d->dbSession.getBackendSession();
-		*session << "SELECT COUNT(*) FROM conference_chat_message_event WHERE marked_as_read = 0 ", soci::into(count);
+		soci::rowset<int> rows = (session->prepare << "SELECT unread_message_count FROM chat_room");
+		for (const int &chatRoomCount : rows)
+			count += chatRoomCount;
+		d->unreadChatMessageGlobalCount = count;
 		return count;
 	};
 #else
@@ -5114,13 +5180,16 @@ int MainDb::getUnreadChatMessageGlobalCount() const {
 
 void MainDb::markChatMessagesAsRead(const ConferenceId &conferenceId) const {
 #ifdef HAVE_DB_STORAGE
-	if (getUnreadChatMessageCount(conferenceId) == 0) return;
+	const int count = getUnreadChatMessageCount(conferenceId);
+	if (count == 0) return;
 
 	static const string query = "UPDATE conference_chat_message_event"
 	                            "  SET marked_as_read = 1"
 	                            "  WHERE marked_as_read = 0"
-	                            "  AND event_id IN ("
-	                            "    SELECT event_id FROM conference_event WHERE chat_room_id = :chatRoomId"
+	                            "  AND EXISTS ("
+	                            "    SELECT 1 FROM conference_event"
+	                            "    WHERE conference_event.event_id = conference_chat_message_event.event_id"
+	                            "    AND chat_room_id = :chatRoomId"
 	                            "  )";
 
 	/*
@@ -5135,9 +5204,9 @@ void MainDb::markChatMessagesAsRead(const ConferenceId &conferenceId) const {
 
 		const long long &dbChatRoomId = d->selectChatRoomId(conferenceId);
 		*d->dbSession.getBackendSession() << query, soci::use(dbChatRoomId);
+		d->updateUnreadChatMessageCount(dbChatRoomId, conferenceId, -count);
 
 		tr.commit();
-		d->unreadChatMessageCountCache.insert(conferenceId, 0);
 	};
 #endif
 }
@@ -6360,9 +6429,10 @@ void MainDb::cleanHistory(const ConferenceId &conferenceId, FilterMask mask) {
 		d->invalidConferenceEventsFromQuery(query, dbChatRoomId);
 		*d->dbSession.getBackendSession() << "DELETE FROM event WHERE id IN (" + query + ")", soci::use(dbChatRoomId);
 		*d->dbSession.getBackendSession() << query2, soci::use(dbChatRoomId);
+		if (!mask || (mask & ConferenceChatMessageFilter))
+			d->updateUnreadChatMessageCount(dbChatRoomId, conferenceId,
+			                                -d->selectUnreadChatMessageCount(dbChatRoomId));
 		tr.commit();
-
-		if (!mask || (mask & ConferenceChatMessageFilter)) d->unreadChatMessageCountCache.insert(conferenceId, 0);
 	};
 #endif
 }
@@ -6594,7 +6664,7 @@ bool MainDb::addChatroomToList(ChatRoomContextWeakCompareMap &chatRoomsMap,
 	try {
 		auto storedContext = chatRoomsMap.at(chatRoomConferenceId);
 		const auto &storedChatRoom = storedContext.sChatRoom;
-		chatRoomToAdd = mergeChatRooms(chatRoom, storedChatRoom, id, storedContext.sDbId, unreadMessageCount);
+		chatRoomToAdd = mergeChatRooms(chatRoom, storedChatRoom, id, storedContext.sDbId);
 		if (storedChatRoom == chatRoomToAdd) {
 			chatRoomToRemove = chatRoom;
 			ret = false;
@@ -6619,8 +6689,7 @@ bool MainDb::addChatroomToList(ChatRoomContextWeakCompareMap &chatRoomsMap,
 shared_ptr<AbstractChatRoom> MainDb::mergeChatRooms(const shared_ptr<AbstractChatRoom> &chatRoom1,
                                                     const shared_ptr<AbstractChatRoom> &chatRoom2,
                                                     long long id1,
-                                                    long long id2,
-                                                    int unreadMessageCount) const {
+                                                    long long id2) const {
 #ifdef HAVE_DB_STORAGE
 	L_D();
 	shared_ptr<AbstractChatRoom> chatRoomToAdd = nullptr;
@@ -6693,12 +6762,6 @@ shared_ptr<AbstractChatRoom> MainDb::mergeChatRooms(const shared_ptr<AbstractCha
 	}
 
 	chatRoomToAdd->setCreationTime(creationTime);
-	const auto unreadChatMessageCountChatRoom2 = d->unreadChatMessageCountCache[chatRoom2ConferenceId];
-	int unreadChatMessageCount = unreadMessageCount;
-	if (unreadChatMessageCountChatRoom2) {
-		unreadChatMessageCount += *unreadChatMessageCountChatRoom2;
-	}
-	d->unreadChatMessageCountCache.insert(chatRoom2ConferenceId, unreadChatMessageCount);
 
 	auto creationTimeToAddSoci = d->dbSession.getTimeWithSociIndicator(creationTimeToAdd);
 	soci::session *session = d->dbSession.getBackendSession();
@@ -6737,6 +6800,13 @@ shared_ptr<AbstractChatRoom> MainDb::mergeChatRooms(const shared_ptr<AbstractCha
 		lInfo() << "Deleting chatroom with ID " << dbChatRoomToRemoveId;
 		*session << "DELETE FROM chat_room WHERE id = :chatRoomId", soci::use(dbChatRoomToRemoveId);
 	}
+
+	// Only the moved events are kept, hence the counter of the merged chat room has to be computed again.
+	if (dbChatRoomToAddId >= 0) {
+		d->recountUnreadChatMessages(dbChatRoomToAddId);
+		d->unreadChatMessageCountCache.insert(chatRoom2ConferenceId,
+		                                      d->selectUnreadChatMessageCount(dbChatRoomToAddId));
+	}
 	return chatRoomToAdd;
 #else
 	return nullptr;
@@ -6781,16 +6851,6 @@ list<shared_ptr<AbstractChatRoom>> MainDb::getChatRooms() {
 		int nbChatRooms = 0;
 		*session << "SELECT COUNT(*) FROM chat_room", soci::into(nbChatRooms);
 
-		// SOCI uses a hack for sqlite3:
-		// "sqlite3 type system does not have a date or time field.  Also it does not reliably id other data types.
-		// It has a tendency to see everything as text.
-		// sqlite3_column_decltype returns the text that is used in the create table statement"
-		// The data type on the count can be a string (as of SOCI 4.0.0) but as it is a "hack", we have to work with
-		// both types (integer and string)
-		soci::data_type unreadMessageCountType;
-		bool typeHasBeenSet = false;
-		d->unreadChatMessageCountCache.clear();
-
 		auto conferenceIdParams = core->createConferenceIdParams();
 		conferenceIdParams.enableExtractUri(false);
 		bool keepGruu = conferenceIdParams.getKeepGruu();
@@ -6863,15 +6923,8 @@ list<shared_ptr<AbstractChatRoom>> MainDb::getChatRooms() {
 			    "SELECT chat_room.id, peer_sip_address.value, local_sip_address.value,"
 			    " creation_time, last_update_time, capabilities, subject, last_notify_id, flags, last_message_id,"
 			    " ephemeral_enabled, ephemeral_messages_lifetime, ephemeral_messages_not_read_lifetime,"
-			    " unread_messages_count.message_count, muted, conference_info_id"
-			    " FROM chat_room"
-			    " LEFT JOIN (SELECT conference_event.chat_room_id, count(*) as message_count"
-			    " FROM conference_chat_message_event, conference_event"
-			    " WHERE conference_chat_message_event.event_id=conference_event.event_id AND "
-			    "conference_chat_message_event.marked_as_read = 0"
-			    " GROUP BY conference_event.chat_room_id) AS unread_messages_count"
-			    " ON unread_messages_count.chat_room_id = chat_room.id"
-			    " , sip_address AS peer_sip_address, sip_address AS local_sip_address"
+			    " unread_message_count, muted, conference_info_id"
+			    " FROM chat_room, sip_address AS peer_sip_address, sip_address AS local_sip_address"
 			    " WHERE chat_room.peer_sip_address_id = peer_sip_address.id AND chat_room.local_sip_address_id = "
 			    "local_sip_address.id AND chat_room.id IN (" +
 			    chatRoomIdsStr + ") ORDER BY last_update_time DESC";
@@ -6881,10 +6934,6 @@ list<shared_ptr<AbstractChatRoom>> MainDb::getChatRooms() {
 				// Decrement the number of chatrooms to be retrieved
 				offset++;
 				nbChatRooms--;
-				if (!typeHasBeenSet) {
-					unreadMessageCountType = chatRoomRow.get_properties(13).get_data_type();
-					typeHasBeenSet = true;
-				}
 
 				std::string pAddressString = chatRoomRow.get<string>(1);
 				std::string lAddressString = chatRoomRow.get<string>(2);
@@ -7110,10 +7159,7 @@ list<shared_ptr<AbstractChatRoom>> MainDb::getChatRooms() {
 				chatRoom->setIsEmpty(lastMessageId == 0);
 				chatRoom->setIsMuted(muted, false);
 
-				int unreadMessagesCount = 0;
-				if (unreadMessageCountType == soci::dt_string)
-					unreadMessagesCount = std::stoi(chatRoomRow.get<string>(13, "0"));
-				else unreadMessagesCount = chatRoomRow.get<int>(13, 0);
+				const int unreadMessagesCount = chatRoomRow.get<int>(13, 0);
 
 				lDebug() << "Found chat room in DB: " << conferenceId;
 
@@ -362,8 +362,7 @@ private:
 	std::shared_ptr<AbstractChatRoom> mergeChatRooms(const std::shared_ptr<AbstractChatRoom> &chatRoom1,
 	                                                 const std::shared_ptr<AbstractChatRoom> &chatRoom2,
 	                                                 long long id1,
-	                                                 long long id2,
-	                                                 int unreadMessageCount) const;
+	                                                 long long id2) const;
 
 	std::string getConferenceInfoTypeQuery(const std::list<LinphoneStreamType> &capabilities) const;
 };
@@ -44,7 +44,7 @@
 #include "vcard/vcard-context.h"
 #include "vcard/vcard.h"
 #ifdef HAVE_XML2
-#include "xml/xml-parsing-context.h"
+#include <libxml/xmlreader.h>
 #endif // HAVE_XML2
 
 // =============================================================================
@@ -260,11 +260,9 @@ std::shared_ptr<Friend> FriendList::findFriendByPhoneNumber(const std::string &p
 
 	const auto &accounts = getCore()->getAccounts();
 	for (const auto &accountInList : accounts) {
-		char *normalizedPhoneNumber =
-		    linphone_account_normalize_phone_number(accountInList->toC(), L_STRING_TO_C(phoneNumber));
-		if (normalizedPhoneNumber && strlen(normalizedPhoneNumber) > 0) {
+		const std::string normalizedPhoneNumber = normalizePhoneNumber(accountInList, phoneNumber);
+		if (!normalizedPhoneNumber.empty()) {
 			std::shared_ptr<Friend> result = findFriendByPhoneNumber(accountInList, normalizedPhoneNumber);
-			bctbx_free(normalizedPhoneNumber);
 			if (result) return result;
 		}
 	}
@@ -565,6 +563,10 @@ LinphoneFriendListStatus FriendList::addFriend(const std::shared_ptr<Friend> &lf
 	return status;
 }
 
+void FriendList::addPhoneNumberIntoMaps(const std::shared_ptr<Friend> &lf, const std::string &phoneNumber) {
+	updatePhoneNumberMaps(lf, phoneNumber, true);
+}
+
 void FriendList::closeSubscriptions() {
 	/* FIXME we should wait until subscription is complete. */
 	if (mEvent) {
@@ -690,9 +692,42 @@ std::shared_ptr<Friend> FriendList::findFriendByOutSubscribe(SalOp *op) const {
 
 std::shared_ptr<Friend> FriendList::findFriendByPhoneNumber(const std::shared_ptr<Account> &account,
                                                             const std::string &normalizedPhoneNumber) const {
-	const auto it = std::find_if(mFriendsList.mList.cbegin(), mFriendsList.mList.cend(),
-	                             [&](const auto &f) { return f->hasPhoneNumber(account, normalizedPhoneNumber); });
-	return (it == mFriendsList.mList.cend()) ? nullptr : *it;
+	const PhoneNumberMap &friendsMap = getFriendsMapByPhoneNumber(account);
+	const auto it = friendsMap.find(normalizedPhoneNumber);
+	return (it == friendsMap.cend()) ? nullptr : it->second;
+}
+
+const FriendList::PhoneNumberMap &FriendList::getFriendsMapByPhoneNumber(const std::shared_ptr<Account> &account) const {
+	const auto [it, inserted] = mFriendsMapsByPhoneNumber.try_emplace(getDialPlanKey(account));
+	PhoneNumberMap &friendsMap = it->second;
+	if (inserted) {
+		for (const auto &f : mFriendsList.mList) {
+			for (const auto &phoneNumber : f->getPhoneNumbers()) {
+				const std::string normalizedPhoneNumber = normalizePhoneNumber(account, phoneNumber);
+				if (normalizedPhoneNumber.empty()) continue;
+				// Two phone numbers of the friend may have the same normalized form, keep a single entry as
+				// updatePhoneNumberMaps() does.
+				const auto [first, last] = friendsMap.equal_range(normalizedPhoneNumber);
+				if (std::none_of(first, last, [&](const auto &entry) { return entry.second == f; })) {
+					friendsMap.insert({normalizedPhoneNumber, f});
+				}
+			}
+		}
+	}
+	return friendsMap;
+}
+
+std::string FriendList::getDialPlanKey(const std::shared_ptr<Account> &account) {
+	// These are the only account parameters linphone_account_normalize_phone_number() depends on.
+	const auto &params = account->getAccountParams();
+	return params->getInternationalPrefix() + (params->getDialEscapePlusEnabled() ? "|+" : "|");
+}
+
+std::string FriendList::normalizePhoneNumber(const std::shared_ptr<Account> &account, const std::string &phoneNumber) {
+	char *normalizedPhoneNumber = linphone_account_normalize_phone_number(account->toC(), L_STRING_TO_C(phoneNumber));
+	std::string result = L_C_TO_STRING(normalizedPhoneNumber);
+	if (normalizedPhoneNumber) bctbx_free(normalizedPhoneNumber);
+	return result;
 }
 
 std::shared_ptr<Address> FriendList::getRlsAddressWithCoreFallback() const {
@@ -754,6 +789,7 @@ LinphoneStatus FriendList::importFriendsFromVcard4(const std::vector<std::shared
 void FriendList::invalidateFriendsMaps() {
 	mFriendsMapByRefKey.clear();
 	mFriendsMapByUri.clear();
+	mFriendsMapsByPhoneNumber.clear();
 	for (const auto &f : mFriendsList.mList)
 		f->addAddressesAndNumbersIntoMaps(getSharedFromThis());
 }
@@ -805,35 +841,124 @@ private:
 	const char *mMessage;
 };
 
+namespace {
+
+constexpr char RlmiNamespace[] = "urn:ietf:params:xml:ns:rlmi";
+
+struct RlmiResource {
+	std::string uri;
+	std::string name;
+	std::string activeCid;
+	bool hasName = false;
+	bool active = false;
+};
+
+struct RlmiList {
+	std::string version;
+	std::string fullState;
+	std::vector<RlmiResource> resources;
+};
+
+std::string takeXmlString(xmlChar *value) {
+	if (!value) return std::string();
+	std::string result(reinterpret_cast<const char *>(value));
+	xmlFree(value);
+	return result;
+}
+
+std::string getReaderAttribute(xmlTextReaderPtr reader, const char *name) {
+	return takeXmlString(xmlTextReaderGetAttribute(reader, reinterpret_cast<const xmlChar *>(name)));
+}
+
+bool isRlmiElement(xmlTextReaderPtr reader, const char *localName) {
+	const xmlChar *ns = xmlTextReaderConstNamespaceUri(reader);
+	const xmlChar *name = xmlTextReaderConstLocalName(reader);
+	return ns && name && xmlStrEqual(ns, reinterpret_cast<const xmlChar *>(RlmiNamespace)) &&
+	       xmlStrEqual(name, reinterpret_cast<const xmlChar *>(localName));
+}
+
+// Walks the rlmi+xml document once, without building a DOM, and collects what is needed to dispatch the presence
+// parts: the list attributes and, for each resource, its URI, its name and the Content-Id of its active instance.
+void readRlmiList(const std::string &body, RlmiList &list) {
+	xmlTextReaderPtr reader =
+	    xmlReaderForMemory(body.c_str(), (int)body.size(), nullptr, "UTF-8", XML_PARSE_NONET | XML_PARSE_NOERROR);
+	if (!reader) throw FriendListXmlException("Wrongly formatted rlmi+xml body: cannot create reader");
+
+	bool listFound = false;
+	int ret;
+	while ((ret = xmlTextReaderRead(reader)) == 1) {
+		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) continue;
+		switch (xmlTextReaderDepth(reader)) {
+			case 0:
+				if (isRlmiElement(reader, "list")) {
+					listFound = true;
+					list.version = getReaderAttribute(reader, "version");
+					list.fullState = getReaderAttribute(reader, "fullState");
+				}
+				break;
+			case 1:
+				if (listFound && isRlmiElement(reader, "resource")) {
+					list.resources.emplace_back();
+					list.resources.back().uri = getReaderAttribute(reader, "uri");
+				}
+				break;
+			case 2:
+				if (list.resources.empty()) break;
+				if (isRlmiElement(reader, "name")) {
+					RlmiResource &resource = list.resources.back();
+					if (!resource.hasName) {
+						resource.hasName = true;
+						resource.name = takeXmlString(xmlTextReaderReadString(reader));
+					}
+				} else if (isRlmiElement(reader, "instance")) {
+					RlmiResource &resource = list.resources.back();
+					if (!resource.active && getReaderAttribute(reader, "state") == "active") {
+						resource.active = true;
+						resource.activeCid = getReaderAttribute(reader, "cid");
+					}
+				}
+				break;
+			default:
+				break;
+		}
+	}
+	xmlFreeTextReader(reader);
+	if (ret < 0) throw FriendListXmlException("Wrongly formatted rlmi+xml body");
+}
+
+} // namespace
+
+std::string FriendList::getUriKey(const std::string &uri) const {
+	// Most resource URIs are already in the form under which friends are indexed: avoid parsing them.
+	if (mFriendsMapByUri.find(uri) != mFriendsMapByUri.cend()) return uri;
+	std::shared_ptr<Address> addr = Address::create(uri);
+	if (!addr) return std::string();
+	if (addr->hasUriParam("gr")) {
+		addr->removeUriParam("gr");
+	}
+	return addr->asStringUriOnly();
+}
+
 void FriendList::parseMultipartRelatedBody(const std::shared_ptr<const Content> &content,
                                            const std::string &firstPartBody) {
 	try {
-		XmlParsingContext xmlCtx(firstPartBody);
-		if (!xmlCtx.isValid()) {
-			stringstream ss;
-			ss << "Wrongly formatted rlmi+xml body: " << xmlCtx.getError();
-			throw FriendListXmlException(ss.str().c_str());
-		}
+		RlmiList rlmiList;
+		readRlmiList(firstPartBody, rlmiList);
 
-		xmlXPathRegisterNs(xmlCtx.getXpathContext(), reinterpret_cast<const xmlChar *>("rlmi"),
-		                   reinterpret_cast<const xmlChar *>("urn:ietf:params:xml:ns:rlmi"));
-		std::string versionStr = xmlCtx.getAttributeTextContent("/rlmi:list", "version");
-		if (versionStr.empty()) {
+		if (rlmiList.version.empty()) {
 			throw FriendListXmlException("rlmi+xml: No version attribute in list");
 		}
-		int version = atoi(versionStr.c_str());
+		int version = atoi(rlmiList.version.c_str());
 		if (version < mExpectedNotificationVersion) {
 			// No longer an error as dialog may be silently restarting by the refresher
 			lWarning() << "rlmi+xml: Received notification with version " << version << " expected was "
 			           << mExpectedNotificationVersion << ", dialog may have been reseted";
 		}
-		std::string fullStateStr = xmlCtx.getAttributeTextContent("/rlmi:list", "fullState");
-		if (fullStateStr.empty()) {
+		if (rlmiList.fullState.empty()) {
 			throw FriendListXmlException("rlmi+xml: No fullState attribute in list");
 		}
 		bool fullState = false;
-		std::string fullStateString(fullStateStr);
-		if ((fullStateString == "true") || (fullStateString == "1")) {
+		if ((rlmiList.fullState == "true") || (rlmiList.fullState == "1")) {
 			fullState = true;
 			for (const auto &lf : mFriendsList.mList) {
 				lf->clearPresenceModels();
@@ -844,137 +969,93 @@ void FriendList::parseMultipartRelatedBody(const std::shared_ptr<const Content>
 		}
 		mExpectedNotificationVersion = version + 1;
 
-		xmlXPathObjectPtr nameObject = xmlCtx.getXpathObjectForNodeList("/rlmi:list/rlmi:resource/rlmi:name/..");
-		if (nameObject != nullptr && nameObject->nodesetval != nullptr) {
-			for (int i = 1; i <= nameObject->nodesetval->nodeNr; i++) {
-				xmlCtx.setXpathContextNode(xmlXPathNodeSetItem(nameObject->nodesetval, i - 1));
-				std::string name = xmlCtx.getTextContent("./rlmi:name");
-				std::string uri = xmlCtx.getTextContent("./@uri");
-				if (uri.empty()) {
-					continue;
-				}
-				std::shared_ptr<Address> addr = Address::create(uri);
-				if (!addr) {
-					continue;
-				}
-				std::shared_ptr<Friend> lf = findFriendByAddress(addr);
-				if (!lf && mBodylessSubscription) {
-					lf = Friend::create(getCore(), uri);
-					addFriend(lf);
-				}
-				if (!name.empty()) {
-					lf->setName(name);
-				}
+		for (const auto &resource : rlmiList.resources) {
+			if (!resource.hasName || resource.uri.empty()) continue;
+			std::string uri = getUriKey(resource.uri);
+			if (uri.empty()) continue;
+			std::shared_ptr<Friend> lf = findFriendByUri(uri);
+			if (!lf && mBodylessSubscription) {
+				lf = Friend::create(getCore(), resource.uri);
+				addFriend(lf);
+			}
+			if (lf && !resource.name.empty()) {
+				lf->setName(resource.name);
 			}
 		}
-		if (nameObject != nullptr) {
-			xmlXPathFreeObject(nameObject);
+
+		// Index the presence parts by Content-Id once instead of looking them up for each resource.
+		bctbx_list_t *parts = linphone_content_get_parts(content->toC());
+		std::unordered_map<std::string, LinphoneContent *> partsByCid;
+		for (bctbx_list_t *it = parts; it != nullptr; it = bctbx_list_next(it)) {
+			auto *part = (LinphoneContent *)it->data;
+			const char *header = linphone_content_get_custom_header(part, "Content-Id");
+			if (header != nullptr) partsByCid.emplace(Utils::stringToLower(Utils::unquote(header, '<')), part);
 		}
 
 		std::set<std::shared_ptr<Friend>> listFriendsPresenceReceived;
-		bctbx_list_t *parts = linphone_content_get_parts(content->toC());
-		xmlXPathObjectPtr resourceObject =
-		    xmlCtx.getXpathObjectForNodeList("/rlmi:list/rlmi:resource/rlmi:instance[@state=\"active\"]/..");
-		if (resourceObject != nullptr && resourceObject->nodesetval != nullptr) {
-			for (int i = 1; i <= resourceObject->nodesetval->nodeNr; i++) {
-				xmlCtx.setXpathContextNode(xmlXPathNodeSetItem(resourceObject->nodesetval, i - 1));
-				std::string cid = xmlCtx.getTextContent("./rlmi:instance/@cid");
-				if (!cid.empty()) {
-					std::shared_ptr<Content> presencePart = nullptr;
-					bctbx_list_t *it = parts;
-					while (it != nullptr) {
-						auto *content = (LinphoneContent *)it->data;
-						const char *header = linphone_content_get_custom_header(content, "Content-Id");
-						if (header != nullptr && Utils::iequalsIgnoreBrakets(header, cid)) {
-							presencePart = Content::toCpp(content)->getSharedFromThis();
-							break;
-						}
-						it = bctbx_list_next(it);
-					}
-					if (!presencePart) {
-						lWarning() << "rlmi+xml: Cannot find part with Content-Id: " << cid;
+		for (const auto &resource : rlmiList.resources) {
+			if (!resource.active || resource.activeCid.empty()) continue;
+			const auto partIt = partsByCid.find(Utils::stringToLower(Utils::unquote(resource.activeCid, '<')));
+			if (partIt == partsByCid.cend()) {
+				lWarning() << "rlmi+xml: Cannot find part with Content-Id: " << resource.activeCid;
+				continue;
+			}
+			const auto presencePart = Content::toCpp(partIt->second);
+			const ContentType &presencePartContentType = presencePart->getContentType();
+			SalPresenceModel *presence =
+			    PresenceModel::parsePresence(presencePartContentType.getType(), presencePartContentType.getSubType(),
+			                                 presencePart->getBodyAsUtf8String());
+			if (presence == nullptr) continue;
+			auto presenceModel = PresenceModel::toCpp((LinphonePresenceModel *)presence)->getSharedFromThis();
+
+			// Only resolve the URI key when we know for sure we have a presence to notify
+			std::string uri = resource.uri.empty() ? std::string() : getUriKey(resource.uri);
+			if (!uri.empty()) {
+				const auto [first, last] = mFriendsMapByUri.equal_range(uri);
+				if (first == last) {
+					if (mBodylessSubscription) {
+						std::shared_ptr<Friend> lf = Friend::create(getCore(), uri);
+						addFriend(lf);
+						lf->presenceReceived(getSharedFromThis(), uri, presenceModel);
+						listFriendsPresenceReceived.insert(lf);
 					} else {
-						const ContentType &presencePartContentType = presencePart->getContentType();
-						SalPresenceModel *presence = PresenceModel::parsePresence(presencePartContentType.getType(),
-						                                                          presencePartContentType.getSubType(),
-						                                                          presencePart->getBodyAsUtf8String());
-						if (presence != nullptr) {
-							// Try to reduce CPU cost of linphone_address_new and find_friend_by_address by only doing
-							// it when we know for sure we have a presence to notify
-							std::string uri = xmlCtx.getTextContent("./@uri");
-							if (uri.empty()) {
-								continue;
-							}
-							std::shared_ptr<Address> addr = Address::create(uri);
-							if (!addr) {
-								continue;
-							}
-
-							// Clean the URI
-							if (addr->hasUriParam("gr")) {
-								addr->removeUriParam("gr");
-							}
-							uri = addr->asStringUriOnly();
-
-							const auto [first, last] = mFriendsMapByUri.equal_range(uri);
-							if (first == last) {
-								if (mBodylessSubscription) {
-									std::shared_ptr<Friend> lf = Friend::create(getCore(), uri);
-									addFriend(lf);
-									lf->presenceReceived(
-									    getSharedFromThis(), uri,
-									    PresenceModel::toCpp((LinphonePresenceModel *)presence)->getSharedFromThis());
-									listFriendsPresenceReceived.insert(lf);
-								} else {
-									for (const auto &account : getCore()->getAccounts()) {
-										if (account->getAccountParams()->echoedPresenceSubscriptionEnabled()) {
-											const std::shared_ptr<Address> localIdentity =
-											    account->getAccountParams()->getIdentityAddress();
-											if (localIdentity && localIdentity->asStringUriOnly() == uri) {
-												account->setEchoedPresenceModel(
-												    PresenceModel::toCpp(
-												        reinterpret_cast<LinphonePresenceModel *>(presence))
-												        ->getSharedFromThis());
-											}
-										}
-									}
-								}
-							} else {
-								// Save the equal_range iterators for looping because mFriendsMapByUri might
-								// change during the loop, leading to wrong presence notifications
-								std::list<std::multimap<std::string, std::shared_ptr<Friend>>::iterator> its;
-								for (auto it = first; it != last; it++) {
-									its.push_back(it);
-								}
-								for (const auto &it : its) {
-									it->second->presenceReceived(
-									    getSharedFromThis(), uri,
-									    PresenceModel::toCpp((LinphonePresenceModel *)presence)->getSharedFromThis());
-									listFriendsPresenceReceived.insert(it->second);
+						for (const auto &account : getCore()->getAccounts()) {
+							if (account->getAccountParams()->echoedPresenceSubscriptionEnabled()) {
+								const std::shared_ptr<Address> localIdentity =
+								    account->getAccountParams()->getIdentityAddress();
+								if (localIdentity && localIdentity->asStringUriOnly() == uri) {
+									account->setEchoedPresenceModel(presenceModel);
 								}
 							}
-
-							PresenceModel::toCpp((LinphonePresenceModel *)presence)->unref();
 						}
 					}
+				} else {
+					// Save the equal_range iterators for looping because mFriendsMapByUri might
+					// change during the loop, leading to wrong presence notifications
+					std::list<std::multimap<std::string, std::shared_ptr<Friend>>::iterator> its;
+					for (auto it = first; it != last; it++) {
+						its.push_back(it);
+					}
+					for (const auto &it : its) {
+						it->second->presenceReceived(getSharedFromThis(), uri, presenceModel);
+						listFriendsPresenceReceived.insert(it->second);
+					}
 				}
 			}
+			presenceModel->unref();
+		}
 
-			// Notify list with all friends for which we received presence information
-			if (!listFriendsPresenceReceived.empty()) {
-				bctbx_list_t *l = nullptr;
-				for (const auto &lf : listFriendsPresenceReceived) {
-					l = bctbx_list_append(l, lf->toC());
-				}
-				LINPHONE_HYBRID_OBJECT_INVOKE_CBS(FriendList, this, linphone_friend_list_cbs_get_presence_received, l);
-				bctbx_list_free(l);
+		// Notify list with all friends for which we received presence information
+		if (!listFriendsPresenceReceived.empty()) {
+			bctbx_list_t *l = nullptr;
+			for (const auto &lf : listFriendsPresenceReceived) {
+				l = bctbx_list_append(l, lf->toC());
 			}
+			LINPHONE_HYBRID_OBJECT_INVOKE_CBS(FriendList, this, linphone_friend_list_cbs_get_presence_received, l);
+			bctbx_list_free(l);
 		}
 
 		bctbx_list_free_with_data(parts, (void (*)(void *))linphone_content_unref);
-		if (resourceObject != nullptr) {
-			xmlXPathFreeObject(resourceObject);
-		}
 	} catch (FriendListXmlException &e) {
 		lWarning() << e.what();
 	}
@@ -1019,6 +1100,13 @@ void FriendList::deleteFriend(const std::shared_ptr<Friend> &lf, bool removeFrom
 			if (mapIt != mFriendsMapByUri.cend()) mFriendsMapByUri.erase(mapIt);
 		}
 	}
+	for (auto &entry : mFriendsMapsByPhoneNumber) {
+		PhoneNumberMap &friendsMap = entry.second;
+		for (auto it = friendsMap.begin(); it != friendsMap.end();) {
+			if (it->second == lf) it = friendsMap.erase(it);
+			else it++;
+		}
+	}
 
 	std::list<std::shared_ptr<Address>> addresses = lf->getAddresses();
 	for (const auto &address : addresses) {
@@ -1033,6 +1121,7 @@ void FriendList::deleteFriend(const std::shared_ptr<Friend> &lf, bool removeFrom
 }
 
 void FriendList::removeFriends(bool removeFromServer) {
+	mFriendsMapsByPhoneNumber.clear();
 	for (auto &lf : mFriendsList.mList) {
 		deleteFriend(lf, removeFromServer);
 	}
@@ -1161,6 +1250,10 @@ void FriendList::removeFromDb() {
 	mStorageId = -1;
 }
 
+void FriendList::removePhoneNumberFromMaps(const std::shared_ptr<Friend> &lf, const std::string &phoneNumber) {
+	updatePhoneNumberMaps(lf, phoneNumber, false);
+}
+
 void FriendList::saveInDb(BCTBX_UNUSED(bool saveFriends)) {
 #ifdef HAVE_DB_STORAGE
 	try {
@@ -1262,6 +1355,7 @@ void FriendList::sendListSubscriptionWithoutBody(const std::shared_ptr<Address>
 
 void FriendList::setFriends(const std::list<std::shared_ptr<Friend>> &friends) {
 	mFriendsList.mList = friends;
+	mFriendsMapsByPhoneNumber.clear();
 }
 
 void FriendList::updateSubscriptions() {
@@ -1302,6 +1396,38 @@ void FriendList::updateSubscriptions() {
 	}
 }
 
+void FriendList::updatePhoneNumberMaps(const std::shared_ptr<Friend> &lf, const std::string &phoneNumber, bool add) {
+	if (mFriendsMapsByPhoneNumber.empty()) return;
+
+	std::map<std::string, PhoneNumberMap> updatedMaps;
+	for (const auto &account : getCore()->getAccounts()) {
+		auto mapIt = mFriendsMapsByPhoneNumber.find(getDialPlanKey(account));
+		if (mapIt == mFriendsMapsByPhoneNumber.end()) continue;
+		auto &friendsMap = updatedMaps.insert({mapIt->first, std::move(mapIt->second)}).first->second;
+		mFriendsMapsByPhoneNumber.erase(mapIt);
+
+		const std::string normalizedPhoneNumber = normalizePhoneNumber(account, phoneNumber);
+		if (normalizedPhoneNumber.empty()) continue;
+		const auto [first, last] = friendsMap.equal_range(normalizedPhoneNumber);
+		const auto it = std::find_if(first, last, [&](const auto &entry) { return entry.second == lf; });
+		if (add) {
+			if (it == last) friendsMap.insert({normalizedPhoneNumber, lf});
+		} else if (it != last) {
+			// The friend may have another phone number with the same normalized form.
+			const std::string flattenedPhoneNumber = Utils::flattenPhoneNumber(phoneNumber);
+			const auto phoneNumbers = lf->getPhoneNumbers();
+			const bool stillHasPhoneNumber =
+			    std::any_of(phoneNumbers.cbegin(), phoneNumbers.cend(), [&](const auto &otherPhoneNumber) {
+				    return (Utils::flattenPhoneNumber(otherPhoneNumber) != flattenedPhoneNumber) &&
+				           (normalizePhoneNumber(account, otherPhoneNumber) == normalizedPhoneNumber);
+			    });
+			if (!stillHasPhoneNumber) friendsMap.erase(it);
+		}
+	}
+	// The maps of dial plans no account uses anymore can't be kept in sync, they will be built again if needed.
+	mFriendsMapsByPhoneNumber = std::move(updatedMaps);
+}
+
 // -----------------------------------------------------------------------------
 
 void FriendList::subscriptionStateChanged(BCTBX_UNUSED(LinphoneCore *lc),
@@ -1343,6 +1469,7 @@ void FriendList::carddavUpdated(const std::shared_ptr<Friend> &newFriend, const
 	auto it = std::find_if(mFriendsList.mList.begin(), mFriendsList.mList.end(),
 	                       [&](const auto &elem) { return elem == oldFriend; });
 	if (it != mFriendsList.mList.end()) *it = newFriend;
+	mFriendsMapsByPhoneNumber.clear();
 	newFriend->saveInDb();
 	LINPHONE_HYBRID_OBJECT_INVOKE_CBS(FriendList, this, linphone_friend_list_cbs_get_contact_updated, newFriend->toC(),
 	                                  oldFriend->toC());
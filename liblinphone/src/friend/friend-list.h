@@ -146,14 +146,20 @@ public:
 	bool isReadOnly() const;
 
 private:
+	// Friends by phone number normalized with the dial plan settings of an account.
+	using PhoneNumberMap = std::multimap<std::string, std::shared_ptr<Friend>>;
+
 	LinphoneFriendListStatus addFriend(const std::shared_ptr<Friend> &lf, bool synchronize);
+	void addPhoneNumberIntoMaps(const std::shared_ptr<Friend> &lf, const std::string &phoneNumber);
 	void closeSubscriptions();
 	std::string createResourceListXml() const;
 	std::shared_ptr<Friend> findFriendByIncSubscribe(SalOp *op) const;
 	std::shared_ptr<Friend> findFriendByOutSubscribe(SalOp *op) const;
 	std::shared_ptr<Friend> findFriendByPhoneNumber(const std::shared_ptr<Account> &account,
 	                                                const std::string &normalizedPhoneNumber) const;
+	const PhoneNumberMap &getFriendsMapByPhoneNumber(const std::shared_ptr<Account> &account) const;
 	std::shared_ptr<Address> getRlsAddressWithCoreFallback() const;
+	std::string getUriKey(const std::string &uri) const;
 	bool hasSubscribeInactive() const;
 	LinphoneFriendListStatus importFriend(const std::shared_ptr<Friend> &lf, bool synchronize);
 	LinphoneStatus importFriendsFromVcard4(const std::vector<std::shared_ptr<Vcard>> &vcards);
@@ -165,6 +171,7 @@ private:
 	LinphoneFriendListStatus removeFriend(const std::shared_ptr<Friend> &lf, bool removeFromServer);
 	void removeFriends(bool removeFromServer);
 	void removeFromDb();
+	void removePhoneNumberFromMaps(const std::shared_ptr<Friend> &lf, const std::string &phoneNumber);
 	void saveInDb(bool saveFriends = false);
 	void sendListSubscription();
 	void sendListSubscriptionWithBody(const std::shared_ptr<Address> &address);
@@ -174,7 +181,10 @@ private:
 	void updateSubscriptions();
 	void synchronizeFriendsFromServerVcard4();
 	void synchronizeFriendsFromServerCardDav();
+	void updatePhoneNumberMaps(const std::shared_ptr<Friend> &lf, const std::string &phoneNumber, bool add);
 
+	static std::string getDialPlanKey(const std::shared_ptr<Account> &account);
+	static std::string normalizePhoneNumber(const std::shared_ptr<Account> &account, const std::string &phoneNumber);
 	static void
 	subscriptionStateChanged(LinphoneCore *lc, std::shared_ptr<Event> event, LinphoneSubscriptionState state);
 #ifdef VCARD_ENABLED
@@ -192,6 +202,8 @@ private:
 	mutable ListHolder<Friend> mFriendsList;
 	std::map<std::string, std::shared_ptr<Friend>> mFriendsMapByRefKey;
 	std::multimap<std::string, std::shared_ptr<Friend>> mFriendsMapByUri;
+	// Built on the first phone number search for a dial plan, see getDialPlanKey(), and kept in sync afterwards.
+	mutable std::map<std::string, PhoneNumberMap> mFriendsMapsByPhoneNumber;
 	std::array<unsigned char, 16> *mContentDigest = nullptr;
 	int mExpectedNotificationVersion;
 	long long mStorageId = -1;
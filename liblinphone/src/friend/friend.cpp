@@ -245,7 +245,11 @@ void Friend::setVcard(const std::shared_ptr<Vcard> &vcard) {
 	if (mRefKey.empty()) {
 		mRefKey = vcard->getUid();
 	}
-	if (mFriendList) saveInDb();
+	if (mFriendList) {
+		// The phone numbers may have changed.
+		mFriendList->mFriendsMapsByPhoneNumber.clear();
+		saveInDb();
+	}
 }
 
 // -----------------------------------------------------------------------------
@@ -617,6 +621,7 @@ void Friend::addPhoneNumber(const std::string &phoneNumber) {
 	if (mFriendList) {
 		const std::string uri = phoneNumberToSipUri(phoneNumber);
 		addFriendToListMapIfNotInItYet(uri);
+		mFriendList->addPhoneNumberIntoMaps(getSharedFromThis(), phoneNumber);
 	}
 	if (linphone_core_vcard_supported()) {
 		if (!mVcard) createVcard(phoneNumber);
@@ -640,7 +645,10 @@ void Friend::addPhoneNumberWithLabel(const std::shared_ptr<const FriendPhoneNumb
 		}
 	}
 
-	if (mFriendList) addFriendToListMapIfNotInItYet(phoneNumberToSipUri(phone));
+	if (mFriendList) {
+		addFriendToListMapIfNotInItYet(phoneNumberToSipUri(phone));
+		mFriendList->addPhoneNumberIntoMaps(getSharedFromThis(), phone);
+	}
 	if (linphone_core_vcard_supported()) {
 		if (!mVcard) createVcard(phone);
 		if (mVcard) mVcard->addPhoneNumberWithLabel(phoneNumber);
@@ -812,7 +820,10 @@ void Friend::removePhoneNumber(const std::string &phoneNumber) {
 	if (isReadOnly()) return;
 	if (phoneNumber.empty()) return;
 
-	if (mFriendList) removeFriendFromListMapIfAlreadyInIt(phoneNumberToSipUri(phoneNumber));
+	if (mFriendList) {
+		removeFriendFromListMapIfAlreadyInIt(phoneNumberToSipUri(phoneNumber));
+		mFriendList->removePhoneNumberFromMaps(getSharedFromThis(), phoneNumber);
+	}
 	if (linphone_core_vcard_supported() && mVcard) {
 		mVcard->removePhoneNumber(phoneNumber);
 	}
@@ -825,7 +836,10 @@ void Friend::removePhoneNumberWithLabel(const std::shared_ptr<const FriendPhoneN
 	const std::string &phone = phoneNumber->getPhoneNumber();
 	if (phone.empty()) return;
 
-	if (mFriendList) removeFriendFromListMapIfAlreadyInIt(phoneNumberToSipUri(phone));
+	if (mFriendList) {
+		removeFriendFromListMapIfAlreadyInIt(phoneNumberToSipUri(phone));
+		mFriendList->removePhoneNumberFromMaps(getSharedFromThis(), phone);
+	}
 	if (linphone_core_vcard_supported() && mVcard) {
 		mVcard->removePhoneNumberWithLabel(phoneNumber);
 	}
@@ -847,6 +861,7 @@ void Friend::addAddressesAndNumbersIntoMaps(const std::shared_ptr<FriendList> &l
 	std::list<std::string> phoneNumbers = getPhoneNumbers();
 	for (const auto &phoneNumber : phoneNumbers) {
 		addFriendToListMapIfNotInItYet(phoneNumberToSipUri(phoneNumber));
+		list->addPhoneNumberIntoMaps(getSharedFromThis(), phoneNumber);
 	}
 
 	const std::list<shared_ptr<Address>> &addresses = getAddresses();
@@ -970,6 +985,12 @@ void Friend::doSubscribe() {
 bool Friend::hasPhoneNumber(const std::shared_ptr<Account> &account, const std::string &searchedPhoneNumber) const {
 	if (searchedPhoneNumber.empty()) return false;
 
+	if (mFriendList) {
+		const auto &friendsMap = mFriendList->getFriendsMapByPhoneNumber(account);
+		const auto [first, last] = friendsMap.equal_range(searchedPhoneNumber);
+		return std::any_of(first, last, [this](const auto &entry) { return entry.second.get() == this; });
+	}
+
 	bool found = false;
 	std::list<std::string> phoneNumbers = getPhoneNumbers();
 	for (auto phoneNumber : phoneNumbers) {
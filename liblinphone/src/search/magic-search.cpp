@@ -22,7 +22,7 @@
 
 #include "bctoolbox/defs.h"
 #include "bctoolbox/list.h"
-#include "bctoolbox/regex.h"
+#include "bctoolbox/utils.hh"
 
 #include "address/address.h"
 #include "c-wrapper/c-wrapper.h"
@@ -64,8 +64,6 @@ using namespace std;
 
 LINPHONE_BEGIN_NAMESPACE
 
-static const std::regex charactersToEscape(R"([\.\^\$\+\(\)\[\]\{\}\|\?\*])");
-
 MagicSearch::MagicSearch(const shared_ptr<Core> &core) : CoreAccessor(core) {
 	L_GET_PRIVATE(core)->registerListener(this);
 }
@@ -201,7 +199,7 @@ void MagicSearch::getContactListFromFilterAsync(const string &filter,
                                                 LinphoneMagicSearchAggregation aggregation) {
 	lDebug() << "[Magic Search] New async search: " << filter;
 
-	setupRegex(filter);
+	setupFilter(filter);
 	if (mAsyncData.pushRequest(SearchRequest(filter, withDomain, sourceFlags, aggregation)) ==
 	    1) { // This is a new request.
 		if (mAutoResetCache || mFilter.size() > filter.size()) {
@@ -232,7 +230,7 @@ list<shared_ptr<SearchResult>> MagicSearch::getContactListFromFilter(const strin
 		resetSearchCache();
 	}
 
-	setupRegex(filter);
+	setupFilter(filter);
 	if (!getSearchCache().empty() && !filter.empty()) {
 		resultList = continueSearch(withDomain, aggregation);
 		resetSearchCache();
@@ -959,46 +957,38 @@ unsigned int MagicSearch::searchInAddress(const shared_ptr<const Address> &lAddr
 	return getMinWeight();
 }
 
-void MagicSearch::setupRegex(const string &filter) {
+void MagicSearch::setupFilter(const string &filter) {
 	string lowercaseFilter = filter;
 	transform(lowercaseFilter.begin(), lowercaseFilter.end(), lowercaseFilter.begin(),
 	          [](unsigned char c) { return tolower(c); });
 
-	if (lowercaseFilter.empty()) {
-		// Match anything
-		lowercaseFilter = ".*";
-	} else {
-		lowercaseFilter = regex_replace(lowercaseFilter, charactersToEscape, "\\$&");
-		// Replace white space by wildcard (used by LDAP)
-		lowercaseFilter = Utils::replaceAll(lowercaseFilter, " ", ".*");
-		if (lowercaseFilter != ".*") {
-			lowercaseFilter = ".*" + lowercaseFilter + ".*";
-		}
+	// White spaces act as wildcards (used by LDAP): "jo do" matches "john doe".
+	// An empty filter has no words and matches anything.
+	mFilterTokens.clear();
+	for (const auto &token : bctoolbox::Utils::split(lowercaseFilter, ' ')) {
+		if (!token.empty()) mFilterTokens.push_back(token);
 	}
-
-	// Replace any regex special character by escaped version of it, such as '+' for example
-	lDebug() << "[Magic Search] Building regex [" << lowercaseFilter << "]";
-	mFilterRegex = lowercaseFilter;
+	lDebug() << "[Magic Search] Filter [" << filter << "] split in " << mFilterTokens.size() << " word(s)";
 	mFilterApplyFullSipUri =
 	    (filter.rfind("sip:", 0) == 0 || filter.rfind("sips:", 0) == 0 || filter.rfind("@") != string::npos);
 }
 
 unsigned int MagicSearch::getWeight(const string &haystack) const {
-	string lowercaseHaystack = haystack;
+	if (mFilterTokens.empty()) return getMaxWeight();
 
+	// This is called for every field of every candidate on each keystroke: match the filter words with plain
+	// substring lookups instead of compiling a regular expression for each call.
+	string lowercaseHaystack = haystack;
 	transform(lowercaseHaystack.begin(), lowercaseHaystack.end(), lowercaseHaystack.begin(),
 	          [](unsigned char c) { return tolower(c); });
 
-	if (bctbx_is_matching_regex_log_context(lowercaseHaystack.c_str(), mFilterRegex.c_str(), TRUE,
-#ifdef _MSC_VER
-	                                        __FUNCSIG__
-#else
-	                                        __PRETTY_FUNCTION__
-#endif
-	                                        )) {
-		return getMaxWeight();
+	size_t position = 0;
+	for (const auto &token : mFilterTokens) {
+		position = lowercaseHaystack.find(token, position);
+		if (position == string::npos) return getMinWeight();
+		position += token.size();
 	}
-	return getMinWeight();
+	return getMaxWeight();
 }
 
 bool MagicSearch::checkDomain(const shared_ptr<Friend> &lFriend,
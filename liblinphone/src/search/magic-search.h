@@ -24,8 +24,8 @@
 #include <list>
 #include <memory>
 #include <queue>
-#include <regex>
 #include <string>
+#include <vector>
 
 #include "c-wrapper/c-wrapper.h"
 #include "linphone/api/c-callbacks.h"
@@ -383,7 +383,7 @@ public:
 
 private:
 	void destroyIterateTimer();
-	void setupRegex(const std::string &filter);
+	void setupFilter(const std::string &filter);
 
 	int mState = 0;
 	unsigned int mMinWeight = 0;
@@ -396,7 +396,8 @@ private:
 	std::string mFilter;
 	bool mAutoResetCache = true; // When a new search start, let MagicSearch to clean its cache
 	bool returnEmptyFriends = false;
-	std::string mFilterRegex;
+	// Lowercase words of the filter, that must all be found in this order in a haystack for it to match
+	std::vector<std::string> mFilterTokens;
 	bool mFilterApplyFullSipUri =
 	    false; // If true, searchInAddress will check the full SIP URI, otherwise only display name & username
 
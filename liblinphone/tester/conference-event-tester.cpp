@@ -1541,6 +1541,162 @@ void send_first_notify() {
 	linphone_core_manager_destroy(pauline);
 }
 
+void send_full_state_notify_to_many_subscribers() {
+	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
+	LinphoneCoreManager *pauline =
+	    linphone_core_manager_new(transport_supported(LinphoneTransportTls) ? "pauline_rc" : "pauline_tcp_rc");
+	shared_ptr<ConferenceEventTester> tester =
+	    dynamic_pointer_cast<ConferenceEventTester>((new ConferenceEventTester(marie->lc->cppPtr))->toSharedPtr());
+	tester->init();
+	auto params = ConferenceParams::create(pauline->lc->cppPtr);
+	params->enableAudio(true);
+	params->enableLocalParticipant(false);
+	shared_ptr<Conference> localConf = (new ServerConference(pauline->lc->cppPtr, nullptr, params))->toSharedPtr();
+	localConf->init();
+
+	const size_t nbParticipants = 200;
+	for (size_t idx = 0; idx < nbParticipants; idx++) {
+		LinphoneAddress *cAddr =
+		    linphone_core_interpret_url(marie->lc, ("sip:participant" + std::to_string(idx) + "@example.org").c_str());
+		localConf->addParticipant(Address::toCpp(cAddr)->getSharedFromThis());
+		linphone_address_unref(cAddr);
+	}
+	localConf->setSubject("A random test subject");
+
+	ServerConferenceEventHandler *localHandler =
+	    (L_ATTR_GET(dynamic_pointer_cast<ServerConference>(localConf).get(), mEventHandler)).get();
+	localConf->setState(ConferenceInterface::State::Instantiated);
+	std::shared_ptr<Address> addr = Address::toCpp(pauline->identity)->getSharedFromThis();
+	localConf->setConferenceAddress(addr);
+	tester->setConferenceAddress(addr);
+	const_cast<ConferenceId &>(tester->handler->getConferenceId()).setPeerAddress(addr);
+
+	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+	auto content = localHandler->createNotifyFullState(NULL);
+	chrono::high_resolution_clock::time_point end = chrono::high_resolution_clock::now();
+	long firstNotifyUs = (long)chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+	// Every subsequent subscriber is expected to be served the full state built for the first one
+	const size_t nbSubscribers = 100;
+	start = chrono::high_resolution_clock::now();
+	for (size_t idx = 0; idx < nbSubscribers; idx++) {
+		auto otherContent = localHandler->createNotifyFullState(NULL);
+		BC_ASSERT_EQUAL(otherContent->getSize(), content->getSize(), size_t, "%zu");
+	}
+	end = chrono::high_resolution_clock::now();
+	long otherNotifiesUs = (long)chrono::duration_cast<chrono::microseconds>(end - start).count();
+	bctbx_message("Creating the NOTIFY full state of a conference with %zu participants took %li us for the first "
+	              "subscriber and %li us for the %zu following ones",
+	              nbParticipants, firstNotifyUs, otherNotifiesUs, nbSubscribers);
+	BC_ASSERT_LOWER(otherNotifiesUs, firstNotifyUs * static_cast<long>(nbSubscribers) / 2, long, "%li");
+
+	tester->handler->notifyReceived(*content);
+	BC_ASSERT_STRING_EQUAL(tester->confSubject.c_str(), "A random test subject");
+	BC_ASSERT_EQUAL(tester->participants.size(), nbParticipants, size_t, "%zu");
+
+	// A change of the conference must not be hidden by the full state of the previous version
+	localConf->setSubject("Another random test subject");
+	content = localHandler->createNotifyFullState(NULL);
+	tester->handler->notifyReceived(*content);
+	BC_ASSERT_STRING_EQUAL(tester->confSubject.c_str(), "Another random test subject");
+	BC_ASSERT_EQUAL(tester->participants.size(), nbParticipants, size_t, "%zu");
+
+	linphone_core_manager_destroy(marie);
+	linphone_core_manager_destroy(pauline);
+}
+
+void participant_lookups_in_large_conference() {
+	LinphoneCoreManager *pauline =
+	    linphone_core_manager_new(transport_supported(LinphoneTransportTls) ? "pauline_rc" : "pauline_tcp_rc");
+	linphone_core_enable_conference_server(pauline->lc, TRUE);
+	auto params = ConferenceParams::create(pauline->lc->cppPtr);
+	params->enableAudio(true);
+	params->enableVideo(true);
+	params->enableChat(false);
+	shared_ptr<ServerConferenceTester> localConf = dynamic_pointer_cast<ServerConferenceTester>(
+	    (new ServerConferenceTester(pauline->lc->cppPtr, nullptr, params))->toSharedPtr());
+	localConf->init();
+
+	const size_t nbParticipants = 500;
+	vector<shared_ptr<Address>> addresses;
+	vector<shared_ptr<CallSession>> sessions;
+	for (size_t idx = 0; idx < nbParticipants; idx++) {
+		LinphoneAddress *cAddr =
+		    linphone_core_interpret_url(pauline->lc, ("sip:participant" + to_string(idx) + "@example.org").c_str());
+		addresses.push_back(Address::toCpp(cAddr)->getSharedFromThis());
+		linphone_address_unref(cAddr);
+		localConf->addParticipant(addresses.back());
+
+		// Set the attributes once the device belongs to the conference, as a negotiation would do
+		const auto device = localConf->findParticipant(addresses.back())->getDevices().front();
+		sessions.push_back(make_shared<CallSession>(pauline->lc->cppPtr, nullptr));
+		device->setSession(sessions.back());
+		device->setSsrc(LinphoneStreamTypeAudio, static_cast<uint32_t>(1000 + idx));
+		device->setSsrc(LinphoneStreamTypeVideo, static_cast<uint32_t>(100000 + idx));
+		device->setStreamLabel("audio" + to_string(idx), LinphoneStreamTypeAudio);
+		device->setStreamLabel("video" + to_string(idx), LinphoneStreamTypeVideo);
+		device->setThumbnailStreamLabel("thumbnail" + to_string(idx));
+	}
+	BC_ASSERT_EQUAL(localConf->getParticipants().size(), nbParticipants, size_t, "%zu");
+
+	chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+	for (size_t idx = 0; idx < nbParticipants; idx++) {
+		const auto participant = localConf->findParticipant(addresses[idx]);
+		BC_ASSERT_PTR_NOT_NULL(participant);
+		if (!participant) continue;
+		const auto device = participant->getDevices().front();
+		BC_ASSERT_TRUE(localConf->findParticipant(sessions[idx]) == participant);
+		BC_ASSERT_TRUE(localConf->findParticipantDevice(sessions[idx]) == device);
+		BC_ASSERT_TRUE(localConf->findParticipantDevice(addresses[idx], addresses[idx]) == device);
+		BC_ASSERT_TRUE(localConf->findParticipantDeviceBySsrc(static_cast<uint32_t>(1000 + idx),
+		                                                      LinphoneStreamTypeAudio) == device);
+		BC_ASSERT_TRUE(localConf->findParticipantDeviceBySsrc(static_cast<uint32_t>(100000 + idx),
+		                                                      LinphoneStreamTypeVideo) == device);
+		BC_ASSERT_TRUE(localConf->findParticipantDeviceByLabel(LinphoneStreamTypeAudio, "audio" + to_string(idx)) ==
+		               device);
+		BC_ASSERT_TRUE(localConf->findParticipantDeviceByLabel(LinphoneStreamTypeVideo, "video" + to_string(idx)) ==
+		               device);
+		BC_ASSERT_TRUE(localConf->findParticipantDeviceByLabel(LinphoneStreamTypeVideo,
+		                                                       "thumbnail" + to_string(idx)) == device);
+	}
+	chrono::high_resolution_clock::time_point end = chrono::high_resolution_clock::now();
+	bctbx_message("Looking up the %zu participants of a conference and their devices took %li us", nbParticipants,
+	              (long)chrono::duration_cast<chrono::microseconds>(end - start).count());
+
+	// The SSRC of the audio stream of the first participant changes, e.g. after a reINVITE
+	const auto firstDevice = localConf->findParticipant(addresses[0])->getDevices().front();
+	firstDevice->setSsrc(LinphoneStreamTypeAudio, 42);
+	BC_ASSERT_PTR_NULL(localConf->findParticipantDeviceBySsrc(1000, LinphoneStreamTypeAudio));
+	BC_ASSERT_TRUE(localConf->findParticipantDeviceBySsrc(42, LinphoneStreamTypeAudio) == firstDevice);
+	BC_ASSERT_PTR_NULL(localConf->findParticipantDeviceBySsrc(42, LinphoneStreamTypeVideo));
+	BC_ASSERT_PTR_NULL(localConf->findParticipantDeviceByLabel(LinphoneStreamTypeAudio, "video0"));
+	BC_ASSERT_PTR_NULL(localConf->findParticipantDeviceByLabel(LinphoneStreamTypeAudio, ""));
+
+	// Removed participants and their devices can no longer be found
+	for (size_t idx = 0; idx < nbParticipants; idx += 2) {
+		localConf->Conference::removeParticipant(localConf->findParticipant(addresses[idx]));
+	}
+	BC_ASSERT_EQUAL(localConf->getParticipants().size(), nbParticipants / 2, size_t, "%zu");
+	for (size_t idx = 0; idx < nbParticipants; idx++) {
+		const bool removed = ((idx % 2) == 0);
+		const auto participant = localConf->findParticipant(addresses[idx]);
+		BC_ASSERT_EQUAL(participant == nullptr, removed, bool, "%d");
+		BC_ASSERT_EQUAL(localConf->findParticipant(sessions[idx]) == nullptr, removed, bool, "%d");
+		BC_ASSERT_EQUAL(localConf->findParticipantDevice(sessions[idx]) == nullptr, removed, bool, "%d");
+		BC_ASSERT_EQUAL(
+		    localConf->findParticipantDeviceBySsrc(static_cast<uint32_t>(100000 + idx), LinphoneStreamTypeVideo) ==
+		        nullptr,
+		    removed, bool, "%d");
+		BC_ASSERT_EQUAL(localConf->findParticipantDeviceByLabel(LinphoneStreamTypeVideo,
+		                                                        "thumbnail" + to_string(idx)) == nullptr,
+		                removed, bool, "%d");
+	}
+
+	localConf = nullptr;
+	sessions.clear();
+	linphone_core_manager_destroy(pauline);
+}
+
 void send_added_notify_through_address() {
 	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
 	LinphoneCoreManager *pauline =
@@ -2949,6 +3105,10 @@ test_t conference_event_tests[] = {
     TEST_NO_TAG("Participant admined", participant_admined_parsing),
     TEST_NO_TAG("Participant unadmined", participant_unadmined_parsing),
     TEST_NO_TAG("Send first notify", send_first_notify),
+    TEST_ONE_TAG("Send full state notify to many subscribers",
+                 send_full_state_notify_to_many_subscribers,
+                 "Performance"),
+    TEST_NO_TAG("Participant lookups in a large conference", participant_lookups_in_large_conference),
     TEST_NO_TAG("Send participant added notify through address", send_added_notify_through_address),
     TEST_NO_TAG("Send participant added notify through call", send_added_notify_through_call),
     TEST_NO_TAG("Send participant removed notify through call", send_removed_notify_through_call),
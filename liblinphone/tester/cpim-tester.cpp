@@ -18,6 +18,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <random>
+
 #include "bctoolbox/defs.h"
 
 #include "address/address.h"
@@ -25,6 +27,7 @@
 #include "chat/chat-message/chat-message.h"
 #include "chat/chat-room/basic-chat-room.h"
 #include "chat/cpim/message/cpim-message.h"
+#include "chat/cpim/parser/cpim-parser.h"
 #include "content/content-type.h"
 #include "content/content.h"
 #include "core/core.h"
@@ -239,6 +242,97 @@ static void build_message() {
 	BC_ASSERT_STRING_EQUAL(strMessage.c_str(), expectedMessage.c_str());
 }
 
+static const vector<string> &get_parser_samples() {
+	static const vector<string> samples = {
+	    "Subject: the weather will be fine today\r\n"
+	    "\r\n"
+	    "Content-Type: text/plain; charset=utf-8\r\n"
+	    "\r\n",
+	    "From: \"MR SANDERS\"<im:piglet@100akerwood.com>\r\n"
+	    "To: \"Depressed Donkey\"<im:eeyore@100akerwood.com>\r\n"
+	    "DateTime: 2000-12-13T13:40:00-08:00\r\n"
+	    "Subject: the weather will be fine today\r\n"
+	    "Subject:;lang=fr beau temps prevu pour aujourd'hui\r\n"
+	    "NS: MyFeatures <mid:MessageFeatures@id.foo.com>\r\n"
+	    "Require: MyFeatures.VitalMessageOption\r\n"
+	    "MyFeatures.VitalMessageOption: Confirmation-requested\r\n"
+	    "MyFeatures.WackyMessageOption: Use-silly-font\r\n"
+	    "\r\n"
+	    "Content-Type: text/xml; charset=utf-8\r\n"
+	    "Content-ID: <1234567890@foo.com>\r\n"
+	    "\r\n"
+	    "<body>Here is the text of my message.</body>",
+	    "Content-Type: Message/CPIM\r\n"
+	    "\r\n"
+	    "From: <sip:marie@sip.example.org;gr=urn:uuid:0d2119d7-b587-0072-81cd-3d640d0cd95f>\r\n"
+	    "To: Pauline Smith <sip:chatroom-ik10al00qYlYL~TZ@conf.example.org>\r\n"
+	    "cc: \"A \\\"quoted\\\" \\u00e9 name\"<sips:laure@sip.example.org>\r\n"
+	    "DateTime: 2023-12-01T09:30:15.123Z\r\n"
+	    "NS: imdn <urn:ietf:params:imdn>\r\n"
+	    "imdn.Message-ID: 6rsIsWAkKvib\r\n"
+	    "imdn.Disposition-Notification: positive-delivery, negative-delivery, display\r\n"
+	    "NS: linphone <http://www.linphone.org/im?a=b>\r\n"
+	    "linphone.Replying-To-Message-ID: 4Dj5Ow8R5Xk\r\n"
+	    "Test:;aaa=bbb;lang=en-US;quoted=\"a;b=c\" \xc3\xa9t\xc3\xa9\r\n"
+	    "\r\n"
+	    "Content-Type: text/plain;charset=UTF-8\r\n"
+	    "Content-Length: 13\r\n"
+	    "\r\n"
+	    "This is Marie\r\n\r\nX: y\r\n"};
+	return samples;
+}
+
+static void check_fast_parser_against_grammar(const string &input) {
+	Cpim::Parser *parser = Cpim::Parser::getInstance();
+	const shared_ptr<const Cpim::Message> fastMessage = parser->parseMessageFast(input);
+	const shared_ptr<const Cpim::Message> grammarMessage = parser->parseMessageWithGrammar(input);
+
+	// The fast parser may give up on a message the grammar reads, but must never read a message differently.
+	if (!fastMessage) return;
+	if (!BC_ASSERT_PTR_NOT_NULL(grammarMessage)) {
+		ms_error("Message read by the fast parser only: %s", input.c_str());
+		return;
+	}
+
+	const string fastString = fastMessage->asString();
+	const string grammarString = grammarMessage->asString();
+	BC_ASSERT_STRING_EQUAL(fastString.c_str(), grammarString.c_str());
+	BC_ASSERT_TRUE(fastMessage->getContent() == grammarMessage->getContent());
+}
+
+static void fast_parser_equivalence() {
+	for (const auto &sample : get_parser_samples()) {
+		BC_ASSERT_PTR_NOT_NULL(Cpim::Parser::getInstance()->parseMessageFast(sample));
+		check_fast_parser_against_grammar(sample);
+	}
+}
+
+static void fast_parser_fuzz() {
+	const string alphabet = string("\"\\<>;:=.,? -_/%@[]\r\n\tZzT+09\xc3\xa9\x80") + '\0';
+	mt19937 generator(42);
+
+	for (int i = 0; i < 3000; i++) {
+		const auto &samples = get_parser_samples();
+		string input = samples[generator() % samples.size()];
+		for (int mutations = 1 + generator() % 3; mutations > 0; mutations--) {
+			const size_t pos = generator() % (input.size() + 1);
+			const char c = alphabet[generator() % alphabet.size()];
+			switch (generator() % 3) {
+				case 0:
+					input.insert(pos, 1, c);
+					break;
+				case 1:
+					if (pos < input.size()) input.erase(pos, 1);
+					break;
+				default:
+					if (pos < input.size()) input[pos] = c;
+					break;
+			}
+		}
+		check_fast_parser_against_grammar(input);
+	}
+}
+
 static int fake_im_encryption_engine_process_incoming_message_cb(BCTBX_UNUSED(LinphoneImEncryptionEngine *engine),
                                                                  BCTBX_UNUSED(LinphoneChatRoom *room),
                                                                  LinphoneChatMessage *msg) {
@@ -351,6 +445,8 @@ test_t cpim_tests[] = {
     TEST_NO_TAG("Parse RFC example", parse_rfc_example),
     TEST_NO_TAG("Parse Message with generic header parameters", parse_message_with_generic_header_parameters),
     TEST_NO_TAG("Build Message", build_message),
+    TEST_NO_TAG("Fast parser equivalence", fast_parser_equivalence),
+    TEST_NO_TAG("Fast parser fuzz", fast_parser_fuzz),
     TEST_NO_TAG("CPIM chat message modifier", cpim_chat_message_modifier),
     TEST_NO_TAG("CPIM chat message modifier with multipart body", cpim_chat_message_modifier_with_multipart_body),
     TEST_ONE_TAG("CPIM ephemeral message", ephemeral_message, "Ephemeral")};
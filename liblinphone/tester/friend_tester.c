@@ -1459,6 +1459,60 @@ static void search_friend_with_name_with_uppercase(void) {
 	linphone_core_manager_destroy(manager);
 }
 
+static void search_friend_with_words_in_order(void) {
+	LinphoneMagicSearch *magicSearch = NULL;
+	bctbx_list_t *resultList = NULL;
+	LinphoneCoreManager *manager = linphone_core_manager_new_with_proxies_check("empty_rc", FALSE);
+	LinphoneFriendList *lfl = linphone_core_get_default_friend_list(manager->lc);
+	const char *friendSipUri = {"sip:jdoe@sip.example.org"};
+	LinphoneFriend *lFriend = linphone_core_create_friend(manager->lc);
+	LinphoneVcard *vcard = linphone_factory_create_vcard(linphone_factory_get());
+
+	linphone_vcard_set_full_name(vcard, "John (Work) Doe+");
+	linphone_vcard_add_sip_address(vcard, friendSipUri);
+	linphone_friend_set_vcard(lFriend, vcard);
+	linphone_core_add_friend(manager->lc, lFriend);
+
+	magicSearch = linphone_magic_search_new(manager->lc);
+
+	// White spaces separate words that must be found in this order
+	resultList = linphone_magic_search_get_contacts_list(magicSearch, "jo do", "", LinphoneMagicSearchSourceFriends,
+	                                                     LinphoneMagicSearchAggregationNone);
+	if (BC_ASSERT_PTR_NOT_NULL(resultList)) {
+		BC_ASSERT_EQUAL((int)bctbx_list_size(resultList), 1, int, "%d");
+		_check_friend_result_list(manager->lc, resultList, 0, friendSipUri, NULL);
+		bctbx_list_free_with_data(resultList, (bctbx_list_free_func)linphone_search_result_unref);
+	}
+	linphone_magic_search_reset_search_cache(magicSearch);
+
+	resultList = linphone_magic_search_get_contacts_list(magicSearch, "doe john", "", LinphoneMagicSearchSourceFriends,
+	                                                     LinphoneMagicSearchAggregationNone);
+	BC_ASSERT_PTR_NULL(resultList);
+	if (resultList) bctbx_list_free_with_data(resultList, (bctbx_list_free_func)linphone_search_result_unref);
+	linphone_magic_search_reset_search_cache(magicSearch);
+
+	// Characters that have a meaning in regular expressions are matched as is
+	resultList = linphone_magic_search_get_contacts_list(magicSearch, "(work) doe+", "",
+	                                                     LinphoneMagicSearchSourceFriends,
+	                                                     LinphoneMagicSearchAggregationNone);
+	if (BC_ASSERT_PTR_NOT_NULL(resultList)) {
+		BC_ASSERT_EQUAL((int)bctbx_list_size(resultList), 1, int, "%d");
+		bctbx_list_free_with_data(resultList, (bctbx_list_free_func)linphone_search_result_unref);
+	}
+	linphone_magic_search_reset_search_cache(magicSearch);
+
+	resultList = linphone_magic_search_get_contacts_list(magicSearch, "w.rk", "", LinphoneMagicSearchSourceFriends,
+	                                                     LinphoneMagicSearchAggregationNone);
+	BC_ASSERT_PTR_NULL(resultList);
+	if (resultList) bctbx_list_free_with_data(resultList, (bctbx_list_free_func)linphone_search_result_unref);
+
+	linphone_friend_list_remove_friend(lfl, lFriend);
+	linphone_friend_unref(lFriend);
+	linphone_vcard_unref(vcard);
+	linphone_magic_search_unref(magicSearch);
+	linphone_core_manager_destroy(manager);
+}
+
 static void search_friend_with_multiple_sip_address(void) {
 	LinphoneMagicSearch *magicSearch = NULL;
 	bctbx_list_t *resultList = NULL;
@@ -1638,6 +1692,58 @@ static void search_friend_large_database(void) {
 	bc_free(dbPath);
 }
 
+static void search_friend_per_keystroke_latency(void) {
+	char *import_filepath = bc_tester_res("vcards/thousand_vcards.vcf");
+	const char *typedName = "Sharyn Langford";
+	long long maxTime = 0;
+
+	LinphoneCoreManager *manager = linphone_core_manager_new_with_proxies_check("empty_rc", FALSE);
+	LinphoneFriendList *lfl = linphone_core_get_default_friend_list(manager->lc);
+	linphone_friend_list_import_friends_from_vcard4_file(lfl, import_filepath);
+	BC_ASSERT_EQUAL((unsigned int)bctbx_list_size(linphone_friend_list_get_friends(lfl)), 1000, unsigned int, "%u");
+
+	// The same object is kept while typing, so that every keystroke narrows the results of the previous one.
+	LinphoneMagicSearch *magicSearch = linphone_magic_search_new(manager->lc);
+	for (size_t i = 1; i <= strlen(typedName); i++) {
+		MSTimeSpec start, current;
+		long long time;
+		char subBuff[32];
+		memcpy(subBuff, typedName, i);
+		subBuff[i] = '\0';
+		liblinphone_tester_clock_start(&start);
+		bctbx_list_t *resultList = linphone_magic_search_get_contacts_list(
+		    magicSearch, subBuff, "", LinphoneMagicSearchSourceFriends, LinphoneMagicSearchAggregationNone);
+		ms_get_cur_time(&current);
+		time = ((current.tv_sec - start.tv_sec) * 1000LL) + ((current.tv_nsec - start.tv_nsec) / 1000000LL);
+		if (time > maxTime) maxTime = time;
+		ms_message("Keystroke [%s]: %zu results in %lld ms", subBuff, bctbx_list_size(resultList), time);
+
+		// Narrowing must not lose anything a search from scratch would find.
+		LinphoneMagicSearch *freshSearch = linphone_magic_search_new(manager->lc);
+		bctbx_list_t *freshList = linphone_magic_search_get_contacts_list(
+		    freshSearch, subBuff, "", LinphoneMagicSearchSourceFriends, LinphoneMagicSearchAggregationNone);
+		BC_ASSERT_EQUAL(bctbx_list_size(resultList), bctbx_list_size(freshList), size_t, "%zu");
+		bctbx_list_free_with_data(freshList, (bctbx_list_free_func)linphone_search_result_unref);
+		linphone_magic_search_unref(freshSearch);
+
+		if (i == strlen(typedName)) {
+			BC_ASSERT_EQUAL(bctbx_list_size(resultList), 1, size_t, "%zu");
+			if (resultList) {
+				const LinphoneFriend *lf =
+				    linphone_search_result_get_friend((LinphoneSearchResult *)bctbx_list_get_data(resultList));
+				BC_ASSERT_STRING_EQUAL(linphone_friend_get_name(lf), typedName);
+			}
+		}
+		bctbx_list_free_with_data(resultList, (bctbx_list_free_func)linphone_search_result_unref);
+	}
+	ms_message("Slowest keystroke: %lld ms", maxTime);
+	BC_ASSERT_LOWER(maxTime, 500, long long, "%lld");
+
+	linphone_magic_search_unref(magicSearch);
+	linphone_core_manager_destroy(manager);
+	bc_free(import_filepath);
+}
+
 static void search_friend_get_capabilities(void) {
 	LinphoneMagicSearch *magicSearch = NULL;
 	bctbx_list_t *resultList = NULL;
@@ -3721,9 +3827,11 @@ static test_t friends_tests[] = {
     TEST_ONE_TAG("Search friend in excluded cache friend list", search_friend_in_app_cache, "MagicSearch"),
     TEST_ONE_TAG("Search friend with aggregation", search_friend_with_aggregation, "MagicSearch"),
     TEST_ONE_TAG("Search friend with uppercase name", search_friend_with_name_with_uppercase, "MagicSearch"),
+    TEST_ONE_TAG("Search friend with words in order", search_friend_with_words_in_order, "MagicSearch"),
     TEST_ONE_TAG("Search friend with multiple sip address", search_friend_with_multiple_sip_address, "MagicSearch"),
     TEST_ONE_TAG("Search friend with same address", search_friend_with_same_address, "MagicSearch"),
     TEST_ONE_TAG("Search friend in large friends database", search_friend_large_database, "MagicSearch"),
+    TEST_ONE_TAG("Search friend latency per keystroke", search_friend_per_keystroke_latency, "MagicSearch"),
     TEST_ONE_TAG("Search friend result has capabilities", search_friend_get_capabilities, "MagicSearch"),
     TEST_TWO_TAGS("Search friend result chat room remote", search_friend_chat_room_remote, "MagicSearch", "LDAP"),
     TEST_TWO_TAGS("Search friend result chat room remote ldap fallback",
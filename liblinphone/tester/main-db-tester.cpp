@@ -153,6 +153,110 @@ static void get_unread_messages_count(void) {
 	}
 }
 
+static void unread_messages_count_is_persisted(void) {
+	MainDbProvider provider;
+	MainDb &mainDb = provider.getMainDb();
+	if (mainDb.isInitialized()) {
+		const int globalCount = mainDb.getUnreadChatMessageGlobalCount();
+		BC_ASSERT_EQUAL(globalCount, 2, int, "%d");
+
+		int sum = 0;
+		list<ConferenceId> unreadConferenceIds;
+		for (const auto &chatRoom : mainDb.getChatRooms()) {
+			const ConferenceId &conferenceId = chatRoom->getConferenceId();
+			const int count = mainDb.getUnreadChatMessageCount(conferenceId);
+			BC_ASSERT_EQUAL(count, chatRoom->getUnreadChatMessageCount(), int, "%d");
+			if (count > 0) unreadConferenceIds.push_back(conferenceId);
+			sum += count;
+		}
+		BC_ASSERT_EQUAL(sum, globalCount, int, "%d");
+		BC_ASSERT_FALSE(unreadConferenceIds.empty());
+
+		for (const auto &conferenceId : unreadConferenceIds) {
+			mainDb.markChatMessagesAsRead(conferenceId);
+			BC_ASSERT_EQUAL(mainDb.getUnreadChatMessageCount(conferenceId), 0, int, "%d");
+		}
+		BC_ASSERT_EQUAL(mainDb.getUnreadChatMessageGlobalCount(), 0, int, "%d");
+
+		// The counters are read back from the chat_room table.
+		provider.reStart(FALSE);
+		MainDb &restartedMainDb = provider.getMainDb();
+		BC_ASSERT_EQUAL(restartedMainDb.getUnreadChatMessageGlobalCount(), 0, int, "%d");
+		for (const auto &conferenceId : unreadConferenceIds)
+			BC_ASSERT_EQUAL(restartedMainDb.getUnreadChatMessageCount(conferenceId), 0, int, "%d");
+	} else {
+		BC_FAIL("Database not initialized");
+	}
+}
+
+enum class UnreadChatRoomRemoval { DeleteChatRoom, CleanHistory, DeleteConferenceInfo };
+
+static void unread_messages_count_after_removal(UnreadChatRoomRemoval removal) {
+	MainDbProvider provider;
+	MainDb &mainDb = provider.getMainDb();
+	if (mainDb.isInitialized()) {
+		const int globalCount = mainDb.getUnreadChatMessageGlobalCount();
+		BC_ASSERT_EQUAL(globalCount, 2, int, "%d");
+
+		shared_ptr<AbstractChatRoom> unreadChatRoom;
+		for (const auto &chatRoom : mainDb.getChatRooms()) {
+			if (mainDb.getUnreadChatMessageCount(chatRoom->getConferenceId()) > 0) {
+				unreadChatRoom = chatRoom;
+				break;
+			}
+		}
+		BC_ASSERT_PTR_NOT_NULL(unreadChatRoom);
+		if (!unreadChatRoom) return;
+
+		const ConferenceId conferenceId = unreadChatRoom->getConferenceId();
+		const int unreadCount = mainDb.getUnreadChatMessageCount(conferenceId);
+		switch (removal) {
+			case UnreadChatRoomRemoval::DeleteChatRoom:
+				mainDb.deleteChatRoom(conferenceId);
+				break;
+			case UnreadChatRoomRemoval::CleanHistory:
+				mainDb.cleanHistory(conferenceId);
+				break;
+			case UnreadChatRoomRemoval::DeleteConferenceInfo: {
+				// Link the chat room to a conference information so that deleting the latter cleans the former up.
+				std::shared_ptr<ConferenceInfo> info = ConferenceInfo::create();
+				info->setOrganizer(Address::create("sip:test-47@sip.linphone.org"));
+				info->setUri(conferenceId.getPeerAddress());
+				info->setDateTime(1682770620);
+				info->setDuration(0);
+				BC_ASSERT_GREATER(mainDb.insertConferenceInfo(info), 0, long long, "%lld");
+				mainDb.insertChatRoom(unreadChatRoom, 0, true);
+				const size_t chatRoomCount = mainDb.getChatRoomCount();
+				mainDb.deleteConferenceInfo(info);
+				BC_ASSERT_EQUAL(mainDb.getChatRoomCount(), chatRoomCount - 1, size_t, "%zu");
+				break;
+			}
+		}
+		BC_ASSERT_EQUAL(mainDb.getUnreadChatMessageCount(conferenceId), 0, int, "%d");
+		BC_ASSERT_EQUAL(mainDb.getUnreadChatMessageGlobalCount(), globalCount - unreadCount, int, "%d");
+
+		// The cached counters must match the ones read back from the chat_room table.
+		provider.reStart(FALSE);
+		MainDb &restartedMainDb = provider.getMainDb();
+		BC_ASSERT_EQUAL(restartedMainDb.getUnreadChatMessageCount(conferenceId), 0, int, "%d");
+		BC_ASSERT_EQUAL(restartedMainDb.getUnreadChatMessageGlobalCount(), globalCount - unreadCount, int, "%d");
+	} else {
+		BC_FAIL("Database not initialized");
+	}
+}
+
+static void unread_messages_count_after_chat_room_deletion(void) {
+	unread_messages_count_after_removal(UnreadChatRoomRemoval::DeleteChatRoom);
+}
+
+static void unread_messages_count_after_history_cleaning(void) {
+	unread_messages_count_after_removal(UnreadChatRoomRemoval::CleanHistory);
+}
+
+static void unread_messages_count_after_conference_info_deletion(void) {
+	unread_messages_count_after_removal(UnreadChatRoomRemoval::DeleteConferenceInfo);
+}
+
 static void get_history(void) {
 	MainDbProvider provider;
 	const MainDb &mainDb = provider.getMainDb();
@@ -735,6 +839,11 @@ static test_t main_db_tests[] = {
     TEST_NO_TAG("Get events count", get_events_count),
     TEST_NO_TAG("Get messages count", get_messages_count),
     TEST_NO_TAG("Get unread messages count", get_unread_messages_count),
+    TEST_NO_TAG("Unread messages count is persisted", unread_messages_count_is_persisted),
+    TEST_NO_TAG("Unread messages count after chat room deletion", unread_messages_count_after_chat_room_deletion),
+    TEST_NO_TAG("Unread messages count after history cleaning", unread_messages_count_after_history_cleaning),
+    TEST_NO_TAG("Unread messages count after conference info deletion",
+                unread_messages_count_after_conference_info_deletion),
     TEST_NO_TAG("Get history", get_history),
     TEST_NO_TAG("Get conference events", get_conference_notified_events),
     TEST_NO_TAG("Get chat rooms", get_chat_rooms),
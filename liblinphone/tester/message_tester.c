@@ -2849,6 +2849,85 @@ static void transfer_message_download_cancelled(void) {
 	linphone_core_manager_destroy(pauline);
 }
 
+static size_t resumed_download_first_offset = 0;
+
+static void file_transfer_progress_indication_resumed(LinphoneChatMessage *msg,
+                                                      LinphoneContent *content,
+                                                      size_t offset,
+                                                      size_t total) {
+	if (resumed_download_first_offset == 0) resumed_download_first_offset = offset;
+	file_transfer_progress_indication(msg, content, offset, total);
+}
+
+static void transfer_message_download_resumed(void) {
+	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
+	LinphoneCoreManager *pauline = linphone_core_manager_new("pauline_tcp_rc");
+	char *send_filepath = bc_tester_res("sounds/sintel_trailer_opus_h264.mkv");
+	char *receive_filepath = random_filepath("receive_file", "dump");
+
+	/* Globally configure an http file transfer server. */
+	linphone_core_set_file_transfer_server(pauline->lc, file_transfer_url);
+	linphone_config_set_bool(linphone_core_get_config(marie->lc), "misc", "file_transfer_download_resume", TRUE);
+
+	/* create a chatroom on pauline's side */
+	LinphoneChatRoom *chat_room = linphone_core_get_chat_room(pauline->lc, marie->identity);
+	LinphoneChatMessage *msg = create_message_from_sintel_trailer(chat_room);
+	linphone_chat_message_send(msg);
+
+	/* wait for marie to receive pauline's msg */
+	BC_ASSERT_TRUE(
+	    wait_for_until(pauline->lc, marie->lc, &marie->stat.number_of_LinphoneMessageReceivedWithFile, 1, 60000));
+
+	LinphoneChatMessage *marie_msg = marie->stat.last_received_chat_message;
+	if (marie_msg) {
+		LinphoneChatMessageCbs *cbs = linphone_chat_message_get_callbacks(marie_msg);
+		linphone_chat_message_cbs_set_msg_state_changed(cbs, liblinphone_tester_chat_message_msg_state_changed);
+		linphone_chat_message_cbs_set_file_transfer_progress_indication(cbs, file_transfer_progress_indication);
+		remove(receive_filepath);
+		linphone_chat_message_set_file_transfer_filepath(marie_msg, receive_filepath);
+		linphone_chat_message_download_file(marie_msg);
+
+		/* wait for the file to be partly downloaded, then simulate a network drop */
+		BC_ASSERT_TRUE(wait_for(pauline->lc, marie->lc, &marie->stat.progress_of_LinphoneFileTransfer, 20));
+		belle_http_provider_set_recv_error(linphone_core_get_http_provider(marie->lc), -1);
+		BC_ASSERT_TRUE(wait_for_until(marie->lc, pauline->lc, &marie->stat.number_of_LinphoneMessageFileTransferError,
+		                              1, 10000));
+		belle_http_provider_set_recv_error(linphone_core_get_http_provider(marie->lc), 1);
+		BC_ASSERT_EQUAL(marie->stat.number_of_LinphoneFileTransferDownloadSuccessful, 0, int, "%d");
+
+		/* what was received before the interruption is kept */
+		size_t file_size =
+		    linphone_content_get_file_size(linphone_chat_message_get_file_transfer_information(marie_msg));
+		size_t partial_size = 0;
+		FILE *partial = fopen(receive_filepath, "rb");
+		if (BC_ASSERT_PTR_NOT_NULL(partial)) {
+			fseek(partial, 0, SEEK_END);
+			partial_size = (size_t)ftell(partial);
+			fclose(partial);
+		}
+		BC_ASSERT_GREATER_STRICT(partial_size, 0, size_t, "%zu");
+		BC_ASSERT_LOWER_STRICT(partial_size, file_size, size_t, "%zu");
+
+		/* download again: only the missing part is requested and appended, progress starting after the kept part */
+		resumed_download_first_offset = 0;
+		linphone_chat_message_cbs_set_file_transfer_progress_indication(cbs,
+		                                                                file_transfer_progress_indication_resumed);
+		linphone_chat_message_download_file(marie_msg);
+		if (BC_ASSERT_TRUE(wait_for_until(pauline->lc, marie->lc,
+		                                  &marie->stat.number_of_LinphoneFileTransferDownloadSuccessful, 1, 55000))) {
+			BC_ASSERT_GREATER(resumed_download_first_offset, partial_size, size_t, "%zu");
+			compare_files(send_filepath, receive_filepath);
+		}
+		remove(receive_filepath);
+	}
+
+	linphone_chat_message_unref(msg);
+	bctbx_free(receive_filepath);
+	bctbx_free(send_filepath);
+	linphone_core_manager_destroy(marie);
+	linphone_core_manager_destroy(pauline);
+}
+
 static void transfer_message_auto_download_aborted(void) {
 	LinphoneCoreManager *marie = linphone_core_manager_new("marie_rc");
 	LinphoneCoreManager *pauline = linphone_core_manager_new("pauline_tcp_rc");
@@ -5609,6 +5688,7 @@ static test_t message_tests[] = {
     TEST_ONE_TAG(
         "Transfer message upload finished during stop", transfer_message_upload_finished_during_stop, "Transfer"),
     TEST_ONE_TAG("Transfer message download cancelled", transfer_message_download_cancelled, "Transfer"),
+    TEST_ONE_TAG("Transfer message download resumed", transfer_message_download_resumed, "Transfer"),
     TEST_ONE_TAG("Transfer message auto download aborted", transfer_message_auto_download_aborted, "Transfer"),
     TEST_ONE_TAG("Transfer message core stopped async 1", transfer_message_core_stopped_async_1, "Transfer"),
     TEST_ONE_TAG("Transfer message core stopped async 2", transfer_message_core_stopped_async_2, "Transfer"),
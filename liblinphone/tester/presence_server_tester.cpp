@@ -21,6 +21,8 @@
 #include "bctoolbox/charconv.h"
 #include "bctoolbox/tester.h"
 #include "belle-sip/object.h"
+#include "content/content-type.h"
+#include "content/content.h"
 #include "liblinphone_tester.h"
 #include "linphone/api/c-account-params.h"
 #include "linphone/api/c-account.h"
@@ -2895,6 +2897,129 @@ void permanent_activities_notify() {
 	linphone_presence_model_unref(presence_model);
 }
 
+static std::string rlmi_pidf_part(const std::string &cid, const std::string &entity, const std::string &basic) {
+	return "--rlmi-boundary\r\n"
+	       "Content-Type: application/pidf+xml;charset=\"UTF-8\"\r\n"
+	       "Content-Id: " +
+	       cid +
+	       "\r\n\r\n"
+	       "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+	       "<presence xmlns=\"urn:ietf:params:xml:ns:pidf\" entity=\"" +
+	       entity + "\"><tuple id=\"t1\"><status><basic>" + basic + "</basic></status><contact>" + entity +
+	       "</contact></tuple></presence>\r\n";
+}
+
+static void notify_rlmi_body(LinphoneFriendList *lfl, const std::string &rlmi, const std::string &parts) {
+	auto content = LinphonePrivate::Content::create();
+	content->setContentType(
+	    LinphonePrivate::ContentType("multipart/related;type=\"application/rlmi+xml\";boundary=rlmi-boundary"));
+	content->setBodyFromUtf8("--rlmi-boundary\r\n"
+	                         "Content-Type: application/rlmi+xml;charset=\"UTF-8\"\r\n\r\n" +
+	                         rlmi + "\r\n" + parts + "--rlmi-boundary--\r\n");
+	linphone_friend_list_notify_presence_received(lfl, nullptr, content->toC());
+}
+
+static void rlmi_presence_received(LinphoneFriendList *friend_list, const bctbx_list_t *friends) {
+	LinphoneFriendListCbs *cbs = linphone_friend_list_get_current_callbacks(friend_list);
+	int *received = (int *)linphone_friend_list_cbs_get_user_data(cbs);
+	received[0]++;
+	received[1] = (int)bctbx_list_size(friends);
+}
+
+static LinphonePresenceBasicStatus rlmi_friend_basic_status(const LinphoneFriend *lf) {
+	const LinphonePresenceModel *model = linphone_friend_get_presence_model(lf);
+	return model ? linphone_presence_model_get_basic_status(model) : (LinphonePresenceBasicStatus)-1;
+}
+
+/*
+ * Feed the friend list with list NOTIFY bodies directly, to check how the rlmi+xml part is walked and how its
+ * resources are matched with the friends and with the presence parts.
+ */
+static void presence_list_rlmi_notify_parsing(void) {
+	LinphoneCoreManager *marie = linphone_core_manager_new_with_proxies_check("empty_rc", FALSE);
+	LinphoneFriendList *lfl = linphone_core_create_friend_list(marie->lc);
+	linphone_friend_list_enable_subscriptions(lfl, FALSE);
+	linphone_core_add_friend_list(marie->lc, lfl);
+
+	LinphoneFriend *alice = linphone_core_create_friend_with_address(marie->lc, "sip:alice@sip.example.org");
+	LinphoneFriend *bob = linphone_core_create_friend_with_address(marie->lc, "sip:bob@sip.example.org");
+	LinphoneFriend *carol = linphone_core_create_friend_with_address(marie->lc, "sip:carol@sip.example.org");
+	linphone_friend_set_name(carol, "Carol");
+	linphone_friend_list_add_friend(lfl, alice);
+	linphone_friend_list_add_friend(lfl, bob);
+	linphone_friend_list_add_friend(lfl, carol);
+
+	int received[2] = {0, 0};
+	LinphoneFriendListCbs *cbs = linphone_factory_create_friend_list_cbs(linphone_factory_get());
+	linphone_friend_list_cbs_set_presence_received(cbs, rlmi_presence_received);
+	linphone_friend_list_cbs_set_user_data(cbs, received);
+	linphone_friend_list_add_callbacks(lfl, cbs);
+
+	// Bob is announced with a GRUU and his Content-Id differs in case and brackets, Carol is only pending, Dave is not
+	// a friend and Eve's presence part is missing.
+	notify_rlmi_body(
+	    lfl,
+	    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+	    "<list xmlns=\"urn:ietf:params:xml:ns:rlmi\" uri=\"sip:rls@sip.example.org\" version=\"0\" fullState=\"true\">"
+	    "<resource uri=\"sip:alice@sip.example.org\"><name>Alice Liddell</name>"
+	    "<instance id=\"1\" state=\"active\" cid=\"alice@rls.example.org\"/></resource>"
+	    "<resource uri=\"sip:bob@sip.example.org;gr=urn:uuid:1234\"><name></name>"
+	    "<instance id=\"1\" state=\"active\" cid=\"bob@rls.example.org\"/></resource>"
+	    "<resource uri=\"sip:carol@sip.example.org\"><name>Carol</name>"
+	    "<instance id=\"1\" state=\"pending\"/></resource>"
+	    "<resource uri=\"sip:dave@sip.example.org\"><name>Dave</name>"
+	    "<instance id=\"1\" state=\"active\" cid=\"dave@rls.example.org\"/></resource>"
+	    "<resource uri=\"sip:eve@sip.example.org\"><name>Eve</name>"
+	    "<instance id=\"1\" state=\"active\" cid=\"eve@rls.example.org\"/></resource>"
+	    "</list>",
+	    rlmi_pidf_part("<alice@rls.example.org>", "sip:alice@sip.example.org", "open") +
+	        rlmi_pidf_part("<BOB@rls.example.org>", "sip:bob@sip.example.org", "closed") +
+	        rlmi_pidf_part("<dave@rls.example.org>", "sip:dave@sip.example.org", "open"));
+
+	// A single notification for the whole NOTIFY, with the two friends whose presence was received.
+	BC_ASSERT_EQUAL(received[0], 1, int, "%d");
+	BC_ASSERT_EQUAL(received[1], 2, int, "%d");
+	BC_ASSERT_STRING_EQUAL(linphone_friend_get_name(alice), "Alice Liddell");
+	BC_ASSERT_STRING_EQUAL(linphone_friend_get_name(carol), "Carol");
+	BC_ASSERT_EQUAL(rlmi_friend_basic_status(alice), LinphonePresenceBasicStatusOpen, int, "%d");
+	BC_ASSERT_EQUAL(rlmi_friend_basic_status(bob), LinphonePresenceBasicStatusClosed, int, "%d");
+	BC_ASSERT_PTR_NULL(linphone_friend_get_presence_model(carol));
+	BC_ASSERT_EQUAL((int)bctbx_list_size(linphone_friend_list_get_friends(lfl)), 3, int, "%d");
+
+	// A partial state only updates the resources it lists.
+	notify_rlmi_body(
+	    lfl,
+	    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+	    "<list xmlns=\"urn:ietf:params:xml:ns:rlmi\" uri=\"sip:rls@sip.example.org\" version=\"1\" fullState=\"false\">"
+	    "<resource uri=\"sip:bob@sip.example.org\"><name>Bob</name>"
+	    "<instance id=\"1\" state=\"active\" cid=\"bob2@rls.example.org\"/></resource>"
+	    "</list>",
+	    rlmi_pidf_part("<bob2@rls.example.org>", "sip:bob@sip.example.org", "open"));
+
+	BC_ASSERT_EQUAL(received[0], 2, int, "%d");
+	BC_ASSERT_EQUAL(received[1], 1, int, "%d");
+	BC_ASSERT_STRING_EQUAL(linphone_friend_get_name(bob), "Bob");
+	BC_ASSERT_EQUAL(rlmi_friend_basic_status(bob), LinphonePresenceBasicStatusOpen, int, "%d");
+	BC_ASSERT_EQUAL(rlmi_friend_basic_status(alice), LinphonePresenceBasicStatusOpen, int, "%d");
+
+	// A malformed rlmi+xml part is ignored as a whole.
+	notify_rlmi_body(lfl,
+	                 "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+	                 "<list xmlns=\"urn:ietf:params:xml:ns:rlmi\" version=\"2\" fullState=\"true\">"
+	                 "<resource uri=\"sip:alice@sip.example.org\"><instance id=\"1\" state=\"active\" "
+	                 "cid=\"alice3@rls.example.org\"/>",
+	                 rlmi_pidf_part("<alice3@rls.example.org>", "sip:alice@sip.example.org", "closed"));
+	BC_ASSERT_EQUAL(received[0], 2, int, "%d");
+	BC_ASSERT_EQUAL(rlmi_friend_basic_status(alice), LinphonePresenceBasicStatusOpen, int, "%d");
+
+	linphone_friend_list_cbs_unref(cbs);
+	linphone_friend_unref(alice);
+	linphone_friend_unref(bob);
+	linphone_friend_unref(carol);
+	linphone_friend_list_unref(lfl);
+	linphone_core_manager_destroy(marie);
+}
+
 test_t presence_server_tests[] = {
     TEST_NO_TAG("Simple Publish", simple_publish),
     TEST_NO_TAG("Publish with 2 identities", publish_with_dual_identity),
@@ -2952,6 +3077,7 @@ test_t presence_server_tests[] = {
     TEST_ONE_TAG("Permanent activities SUBSCRIBE", permanent_activities_subscribe, "permanent-activities"),
     TEST_ONE_TAG("Permanent activities PUBLISH", permanent_activities_publish, "permanent-activities"),
     TEST_ONE_TAG("Permanent activities NOTIFY", permanent_activities_notify, "permanent-activities"),
+    TEST_ONE_TAG("Presence list, RLMI notify parsing", presence_list_rlmi_notify_parsing, "presence"),
 };
 
 test_suite_t presence_server_test_suite = {"Presence using server",
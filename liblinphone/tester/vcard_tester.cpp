@@ -1324,6 +1324,124 @@ static void find_friend_by_ref_key_in_lot_of_friends_test(void) {
 	bctbx_mmap_cchar_delete(friends_map);
 }
 
+static void find_friend_by_phone_number_in_lot_of_friends_test(void) {
+	LinphoneCoreManager *manager = linphone_core_manager_new_with_proxies_check("marie_rc", FALSE);
+	LinphoneFriendList *lfl = linphone_core_create_friend_list(manager->lc);
+	const int nb_friends = 20000;
+	const int nb_lookups = 1000;
+	char phone_number[32];
+	char name[32];
+	std::string buffer;
+	uint64_t start;
+
+	for (int i = 0; i < nb_friends; i++) {
+		snprintf(name, sizeof(name), "Friend %i", i);
+		snprintf(phone_number, sizeof(phone_number), "+336%08i", i);
+		buffer += std::string("BEGIN:VCARD\r\nVERSION:4.0\r\nFN:") + name + "\r\nTEL:" + phone_number +
+		          "\r\nEND:VCARD\r\n";
+	}
+
+	start = bctbx_get_cur_time_ms();
+	BC_ASSERT_EQUAL(linphone_friend_list_import_friends_from_vcard4_buffer(lfl, buffer.c_str()), nb_friends, int,
+	                "%d");
+	ms_message("Imported %i vCards in %i ms", nb_friends, (int)(bctbx_get_cur_time_ms() - start));
+
+	// The first search builds the phone number map, the following ones only normalize the searched number.
+	start = bctbx_get_cur_time_ms();
+	for (int i = 0; i < nb_lookups; i++) {
+		const int index = (int)(((long long)i * nb_friends) / nb_lookups);
+		snprintf(name, sizeof(name), "Friend %i", index);
+		snprintf(phone_number, sizeof(phone_number), "+33 6 %08i", index);
+		LinphoneFriend *lf = linphone_friend_list_find_friend_by_phone_number(lfl, phone_number);
+		if (BC_ASSERT_PTR_NOT_NULL(lf)) BC_ASSERT_STRING_EQUAL(linphone_friend_get_name(lf), name);
+	}
+	ms_message("Found %i friends by phone number among %i in %i ms", nb_lookups, nb_friends,
+	           (int)(bctbx_get_cur_time_ms() - start));
+
+	// The map is kept in sync with the friends.
+	LinphoneFriend *lf = linphone_friend_list_find_friend_by_phone_number(lfl, "+33600000042");
+	if (BC_ASSERT_PTR_NOT_NULL(lf)) {
+		linphone_friend_add_phone_number(lf, "+33799999999");
+		BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "+33799999999"), lf);
+		linphone_friend_remove_phone_number(lf, "+33600000042");
+		BC_ASSERT_PTR_NULL(linphone_friend_list_find_friend_by_phone_number(lfl, "+33600000042"));
+		BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "+33799999999"), lf);
+		linphone_friend_list_remove_friend(lfl, lf);
+		BC_ASSERT_PTR_NULL(linphone_friend_list_find_friend_by_phone_number(lfl, "+33799999999"));
+	}
+	BC_ASSERT_PTR_NULL(linphone_friend_list_find_friend_by_phone_number(lfl, "+33612345678901"));
+
+	linphone_friend_list_unref(lfl);
+	linphone_core_manager_destroy(manager);
+}
+
+static void set_default_account_international_prefix(LinphoneCore *lc, const char *prefix) {
+	LinphoneAccount *account = linphone_core_get_default_account(lc);
+	LinphoneAccountParams *params = linphone_account_params_clone(linphone_account_get_params(account));
+	linphone_account_params_set_international_prefix(params, prefix);
+	linphone_account_set_params(account, params);
+	linphone_account_params_unref(params);
+}
+
+static void find_friend_by_equivalent_phone_numbers_test(void) {
+	LinphoneCoreManager *manager = linphone_core_manager_new_with_proxies_check("marie_rc", FALSE);
+	LinphoneFriendList *lfl = linphone_core_create_friend_list(manager->lc);
+	LinphoneFriend *lf = linphone_core_create_friend(manager->lc);
+
+	set_default_account_international_prefix(manager->lc, "33");
+
+	// Both numbers have the same normalized form, the friend is indexed once.
+	linphone_friend_set_name(lf, "Equivalent numbers");
+	linphone_friend_add_phone_number(lf, "+33612345678");
+	linphone_friend_add_phone_number(lf, "06 12 34 56 78");
+	linphone_friend_list_add_friend(lfl, lf);
+
+	// The first search builds the phone number map.
+	BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "+33612345678"), lf);
+
+	// The friend is still found through its other number, then not at all once both are removed.
+	linphone_friend_remove_phone_number(lf, "06 12 34 56 78");
+	BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "+33612345678"), lf);
+	linphone_friend_remove_phone_number(lf, "+33612345678");
+	BC_ASSERT_PTR_NULL(linphone_friend_list_find_friend_by_phone_number(lfl, "+33612345678"));
+
+	linphone_friend_unref(lf);
+	linphone_friend_list_unref(lfl);
+	linphone_core_manager_destroy(manager);
+}
+
+static void find_friend_by_phone_number_after_dial_plan_change_test(void) {
+	LinphoneCoreManager *manager = linphone_core_manager_new_with_proxies_check("marie_rc", FALSE);
+	LinphoneFriendList *lfl = linphone_core_create_friend_list(manager->lc);
+	LinphoneFriend *lf = linphone_core_create_friend(manager->lc);
+
+	set_default_account_international_prefix(manager->lc, "");
+
+	linphone_friend_set_name(lf, "National number");
+	linphone_friend_add_phone_number(lf, "0612345678");
+	linphone_friend_list_add_friend(lfl, lf);
+
+	// Without international prefix, the national number can't match an international one.
+	BC_ASSERT_PTR_NULL(linphone_friend_list_find_friend_by_phone_number(lfl, "+33612345678"));
+
+	// The friends are indexed again with the new dial plan.
+	set_default_account_international_prefix(manager->lc, "33");
+	BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "+33612345678"), lf);
+
+	// Numbers added meanwhile are indexed with the dial plan in use.
+	linphone_friend_add_phone_number(lf, "0611111111");
+	BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "+33611111111"), lf);
+
+	// Going back to the previous dial plan doesn't use the stale index.
+	set_default_account_international_prefix(manager->lc, "");
+	BC_ASSERT_PTR_NULL(linphone_friend_list_find_friend_by_phone_number(lfl, "+33611111111"));
+	BC_ASSERT_PTR_EQUAL(linphone_friend_list_find_friend_by_phone_number(lfl, "0611111111"), lf);
+
+	linphone_friend_unref(lf);
+	linphone_friend_list_unref(lfl);
+	linphone_core_manager_destroy(manager);
+}
+
 static void find_friend_by_ref_key_empty_list_test() {
 	LinphoneCoreManager *manager = linphone_core_manager_new_with_proxies_check("empty_rc", FALSE);
 	LinphoneFriendList *lfl = linphone_core_get_default_friend_list(manager->lc);
@@ -1454,6 +1572,10 @@ static test_t vcard_tests[] = {
     TEST_NO_TAG("Find friend by ref key", find_friend_by_ref_key_test),
     TEST_NO_TAG("create a map and insert 20000 objects", insert_lot_of_friends_map_test),
     TEST_NO_TAG("Find ref key in 20000 objects map", find_friend_by_ref_key_in_lot_of_friends_test),
+    TEST_NO_TAG("Find friend by phone number in 20000 friends", find_friend_by_phone_number_in_lot_of_friends_test),
+    TEST_NO_TAG("Find friend by equivalent phone numbers", find_friend_by_equivalent_phone_numbers_test),
+    TEST_NO_TAG("Find friend by phone number after dial plan change",
+                find_friend_by_phone_number_after_dial_plan_change_test),
     TEST_NO_TAG("Find friend by ref key in empty list", find_friend_by_ref_key_empty_list_test),
     TEST_NO_TAG("Legacy import and migration", legacy_import_and_migration)};
 
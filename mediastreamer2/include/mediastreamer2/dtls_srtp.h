@@ -55,6 +55,8 @@ typedef struct MSDtlsSrtpParams {
 	int mtu;
 	bool_t verify_certificate; /**< when set, accept only valid certificates */
 	const char *peer_uri;      /**< peer's uri retrieved from the SDP */
+	struct _MSFactory *factory; /**< if set, incoming DTLS packets are processed by a worker thread of the factory
+	                            crypto pool instead of the thread receiving them */
 } MSDtlsSrtpParams;
 
 /* an opaque structure containing all context data needed by DTLS-SRTP */
@@ -85,6 +87,8 @@ MS2_PUBLIC void ms_dtls_srtp_start(MSDtlsSrtpContext *context);
 
 /**
  * Free ressources used by DTLS-SRTP context
+ * When the context processes its packets on a crypto worker of the factory, this blocks until the packet being
+ * processed by the worker, if any, is done: at most one handshake step. The packets still queued are dropped.
  * @param[in/out]	context		the DTLS-SRTP context
  */
 MS2_PUBLIC void ms_dtls_srtp_context_destroy(MSDtlsSrtpContext *ctx);
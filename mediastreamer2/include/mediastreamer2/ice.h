@@ -220,6 +220,12 @@ typedef struct _IceTransaction {
 	int canceled;
 } IceTransaction;
 
+/**
+ * Opaque hash index over one of the lists of an ICE check list, used to avoid linear searches when the number of
+ * candidates and candidate pairs is large.
+ */
+typedef struct _IceIndex IceIndex;
+
 /**
  * Structure representing an ICE check list.
  *
@@ -245,9 +251,17 @@ typedef struct _IceCheckList {
 	MSList *local_componentIDs;      /**< List of uint16_t */
 	MSList *remote_componentIDs;     /**< List of uint16_t */
 	MSList *transaction_list;        /**< List of IceTransaction structures */
+	IceIndex *local_candidates_index;  /**< Index of local_candidates by transport address */
+	IceIndex *remote_candidates_index; /**< Index of remote_candidates by transport address */
+	IceIndex *pairs_index;             /**< Index of pairs by local and remote candidates */
+	IceIndex *check_list_index;        /**< Index of check_list by local and remote candidates */
+	IceIndex *transactions_index;      /**< Index of transaction_list by transaction ID */
 	IceCheckListState state;         /**< Global state of the ICE check list */
 	MSTimeSpec ta_time;              /**< Time when the Ta timer has been processed for the last time */
 	MSTimeSpec keepalive_time;       /**< Time when the last keepalive packet has been sent for this stream */
+	MSTimeSpec retransmission_time;  /**< Earliest time at which a connectivity check may have to be retransmitted */
+	MSTimeSpec valid_pairs_keepalive_time; /**< Earliest time at which a valid pair may need a keepalive while the
+	                                          check list is running */
 	uint32_t foundation_generator;   /**< Autoincremented integer to generate unique foundation values */
 	MSTimeSpec gathering_start_time; /**< Time when the gathering process was started */
 	MSTimeSpec nomination_delay_start_time; /**< Time when the nomination process has been delayed */
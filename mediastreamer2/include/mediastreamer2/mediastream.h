@@ -298,6 +298,18 @@ MS2_PUBLIC MSCryptoSuite ms_media_stream_sessions_get_srtp_crypto_suite(const MS
                                                                         MediaStreamDir dir,
                                                                         bool_t is_inner);
 
+/**
+ * Get the cumulated SRTP processing statistics of this stream: RTP packets and bytes given to the SRTP engine and the
+ * time spent protecting/unprotecting them (inner and outer layers included)
+ * @param[in]		sessions	Pointer to the stream session structure
+ * @param[in]		dir	stream direction (send, recv or both - in that case the two directions are summed)
+ * @param[out]		stats	filled with the statistics
+ * @return 0 on success, -1 if there is no srtp context on this stream
+ */
+MS2_PUBLIC int ms_media_stream_sessions_get_srtp_crypto_stats(const MSMediaStreamSessions *sessions,
+                                                              MediaStreamDir dir,
+                                                              MSSrtpCryptoStats *stats);
+
 /**
  * Get the encryption status, if this srtp context does not exists, returns inactive
  * @param[in] 		stream MediaStream object
@@ -1388,6 +1400,7 @@ struct _VideoStream {
 	MSVideoDisplayMode display_mode;
 	MSVideoDisplayMode preview_display_mode;
 	int frame_marking_extension_id;
+	int temporal_layers;
 	char *label;
 	MSVideoContent content;
 	bool_t use_preview_window;
@@ -1810,6 +1823,17 @@ MS2_PUBLIC const char *video_stream_get_video_preset(VideoStream *stream);
  */
 MS2_PUBLIC void video_stream_set_frame_marking_extension_id(VideoStream *stream, int extension_id);
 
+/**
+ * Sets the number of temporal layers the encoder has to produce, if it supports temporal scalability.
+ * The temporal layer id of each frame is carried by the frame marking extension, so that a conference server can
+ * reduce the frame rate sent to the participants with a poor link without transcoding.
+ * This has to be called before starting the video stream.
+ *
+ * @param stream the video stream
+ * @param layers the number of temporal layers, from 1 (the default, no temporal scalability) to 3
+ */
+MS2_PUBLIC void video_stream_set_temporal_layers(VideoStream *stream, int layers);
+
 /**
  * Open a player to play a video file (mkv) to remote end.
  * The player is returned as a MSFilter so that application can make usual player controls on it using the
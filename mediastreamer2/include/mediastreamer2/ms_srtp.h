@@ -117,6 +117,15 @@ MS2_PUBLIC bool_t ms_crypto_suite_is_unauthenticated(MSCryptoSuite cs);
 /* defined in srtp.h*/
 typedef struct _MSSrtpCtx MSSrtpCtx;
 
+/**
+ * Cumulated SRTP processing statistics of one direction of a stream
+ */
+typedef struct _MSSrtpCryptoStats {
+	uint64_t packets;        /**< number of RTP packets given to the SRTP engine */
+	uint64_t bytes;          /**< number of bytes given to the SRTP engine */
+	uint64_t crypto_time_us; /**< time spent in protect/unprotect, in microseconds */
+} MSSrtpCryptoStats;
+
 /**
  * Check if SRTP is supported
  * @return true if SRTP is supported
@@ -111,6 +111,47 @@ ms_worker_thread_add_repeated_task(MSWorkerThread *obj, MSTaskFunc func, void *d
 
 MS2_PUBLIC void ms_worker_thread_destroy(MSWorkerThread *obj, bool_t finish_tasks);
 
+/*
+ * A bounded set of worker threads shared by several users, for example all the video encoders of a factory.
+ * Each user is given one worker thread, so that its tasks are executed in order. Once max_threads threads exist,
+ * users share the least loaded ones instead of creating new threads.
+ */
+typedef struct _MSWorkerThreadPool MSWorkerThreadPool;
+
+MS2_PUBLIC MSWorkerThreadPool *ms_worker_thread_pool_new(const char *name, int max_threads);
+
+/* Change the maximum number of threads. Threads already created are kept until they have no user anymore. */
+MS2_PUBLIC void ms_worker_thread_pool_set_max_threads(MSWorkerThreadPool *obj, int max_threads);
+
+MS2_PUBLIC int ms_worker_thread_pool_get_max_threads(const MSWorkerThreadPool *obj);
+
+/*
+ * Returns the number of users of the pool, that is the number of worker threads acquired and not yet released, plus
+ * the users added with ms_worker_thread_pool_add_user().
+ */
+MS2_PUBLIC int ms_worker_thread_pool_get_user_count(MSWorkerThreadPool *obj);
+
+/*
+ * Count a user that shares the thread budget of the pool without needing a worker thread, for example a codec running
+ * its own internal threads. It must be removed with ms_worker_thread_pool_remove_user().
+ */
+MS2_PUBLIC void ms_worker_thread_pool_add_user(MSWorkerThreadPool *obj);
+
+MS2_PUBLIC void ms_worker_thread_pool_remove_user(MSWorkerThreadPool *obj);
+
+/* Get a worker thread from the pool. It must be given back with ms_worker_thread_pool_release(). */
+MS2_PUBLIC MSWorkerThread *ms_worker_thread_pool_acquire(MSWorkerThreadPool *obj);
+
+/*
+ * Give back a worker thread obtained with ms_worker_thread_pool_acquire().
+ * The tasks queued so far on this worker thread are executed before this function returns, since the thread may be
+ * shared: the user must make them harmless beforehand if they must not be executed.
+ */
+MS2_PUBLIC void ms_worker_thread_pool_release(MSWorkerThreadPool *obj, MSWorkerThread *worker);
+
+/* All the worker threads must have been released, and the users added with ms_worker_thread_pool_add_user() removed. */
+MS2_PUBLIC void ms_worker_thread_pool_destroy(MSWorkerThreadPool *obj);
+
 #ifdef __cplusplus
 }
 #endif
@@ -345,6 +345,7 @@ struct _MSVideoConferenceParams {
 	MSStreamSecurityLevel security_level;
 	const char *codec_mime_type;
 	MSConferenceMode mode;
+	int temporal_layers; /*< number of temporal layers produced by the participants, 0 or 1 if they don't use any */
 };
 
 /**
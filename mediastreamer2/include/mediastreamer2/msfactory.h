@@ -50,6 +50,9 @@ struct _MSFactory {
 	char *image_resources_dir;
 	char *echo_canceller_filtername;
 	int expected_video_bandwidth;
+	struct _MSWorkerThreadPool *video_codec_pool;
+	int video_codec_thread_budget;
+	struct _MSWorkerThreadPool *crypto_pool;
 };
 
 typedef struct _MSFactory MSFactory;
@@ -293,6 +296,61 @@ MS2_PUBLIC unsigned int ms_factory_get_cpu_count(MSFactory *obj);
  **/
 MS2_PUBLIC void ms_factory_set_cpu_count(MSFactory *obj, unsigned int c);
 
+/**
+ * Set the number of threads that the video codecs of the factory may use altogether.
+ * It bounds the number of threads shared by the codecs for asynchronous processing, and the number of internal threads
+ * given to each codec is derived from it. 0, the default, means the number of cpus.
+ **/
+MS2_PUBLIC void ms_factory_set_video_codec_thread_budget(MSFactory *obj, int threads);
+
+/**
+ * Get the number of threads that the video codecs of the factory may use altogether.
+ **/
+MS2_PUBLIC int ms_factory_get_video_codec_thread_budget(MSFactory *obj);
+
+/**
+ * Get a worker thread to run a video codec asynchronously. It is shared with the other video codecs of the factory
+ * once the thread budget is reached, and must be given back with ms_factory_release_video_codec_worker().
+ **/
+MS2_PUBLIC struct _MSWorkerThread *ms_factory_acquire_video_codec_worker(MSFactory *obj);
+
+/**
+ * Give back a worker thread obtained with ms_factory_acquire_video_codec_worker().
+ * The tasks already queued on the worker thread are executed before this function returns.
+ **/
+MS2_PUBLIC void ms_factory_release_video_codec_worker(MSFactory *obj, struct _MSWorkerThread *worker);
+
+/**
+ * Register a video codec that does not need a worker thread but runs internal threads, such as a decoder processing
+ * on the ticker thread, so that it shares the thread budget of the factory with the other video codecs.
+ * It must be unregistered with ms_factory_unregister_video_codec().
+ **/
+MS2_PUBLIC void ms_factory_register_video_codec(MSFactory *obj);
+
+MS2_PUBLIC void ms_factory_unregister_video_codec(MSFactory *obj);
+
+/**
+ * Get the number of internal threads a video codec should use, so that the codecs running at the same time
+ * share the thread budget of the factory. The codecs are the ones holding a worker thread obtained with
+ * ms_factory_acquire_video_codec_worker() or registered with ms_factory_register_video_codec() at the time of the
+ * call.
+ * @param max_threads The maximum number of threads the codec can make use of.
+ **/
+MS2_PUBLIC int ms_factory_get_video_codec_thread_count(MSFactory *obj, int max_threads);
+
+/**
+ * Get a worker thread to run cryptographic processing, such as DTLS handshakes, outside of the ticker threads.
+ * It is shared with the other users of the factory once there is one per cpu, and must be given back with
+ * ms_factory_release_crypto_worker().
+ **/
+MS2_PUBLIC struct _MSWorkerThread *ms_factory_acquire_crypto_worker(MSFactory *obj);
+
+/**
+ * Give back a worker thread obtained with ms_factory_acquire_crypto_worker().
+ * The tasks already queued on the worker thread are executed before this function returns.
+ **/
+MS2_PUBLIC void ms_factory_release_crypto_worker(MSFactory *obj, struct _MSWorkerThread *worker);
+
 MS2_PUBLIC void ms_factory_add_platform_tag(MSFactory *obj, const char *tag);
 
 MS2_PUBLIC MSList *ms_factory_get_platform_tags(MSFactory *obj);
@@ -242,6 +242,9 @@ typedef enum _MSRecorderState MSRecorderState;
 #define MS_VIDEO_ENCODER_ENABLE_DIVIDE_PACKETS_EQUAL_SIZE MS_FILTER_METHOD(MSFilterVideoEncoderInterface, 12, bool_t)
 /* Optimize encoding for screen content (i.e when doing screen sharing) */
 #define MS_VIDEO_ENCODER_ENABLE_SCREEN_CONTENT_MODE MS_FILTER_METHOD(MSFilterVideoEncoderInterface, 13, bool_t)
+/* Number of temporal layers to produce (1 to 3, 1 disables temporal scalability). The temporal layer id of each frame
+ * is set with mblk_set_temporal_layer_id(). */
+#define MS_VIDEO_ENCODER_SET_TEMPORAL_LAYERS MS_FILTER_METHOD(MSFilterVideoEncoderInterface, 14, int)
 
 /** Interface definitions for audio capture */
 
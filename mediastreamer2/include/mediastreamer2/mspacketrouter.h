@@ -58,6 +58,14 @@ typedef struct _MSPacketRouterPinControl {
 #define MS_PACKET_ROUTER_NOTIFY_PLI MS_FILTER_METHOD(MS_PACKET_ROUTER_ID, 6, int)
 #define MS_PACKET_ROUTER_NOTIFY_FIR MS_FILTER_METHOD(MS_PACKET_ROUTER_ID, 7, int)
 
+typedef struct _MSPacketRouterTemporalLayerData {
+	int output;             /*< The output pin */
+	int max_temporal_layer; /*< The highest temporal layer forwarded to this output, -1 to forward all of them */
+} MSPacketRouterTemporalLayerData;
+// Frames of higher temporal layers, as given by the frame marking extension, are not forwarded to the output.
+#define MS_PACKET_ROUTER_SET_OUTPUT_MAX_TEMPORAL_LAYER                                                                 \
+	MS_FILTER_METHOD(MS_PACKET_ROUTER_ID, 11, MSPacketRouterTemporalLayerData)
+
 // Events raised by the router when it needs to receive a key frame in order to complete the route to new input source
 #define MS_PACKET_ROUTER_SEND_FIR MS_FILTER_EVENT(MS_PACKET_ROUTER_ID, 0, int)
 #define MS_PACKET_ROUTER_SEND_PLI MS_FILTER_EVENT(MS_PACKET_ROUTER_ID, 1, int)
@@ -120,9 +120,21 @@ MS2_PUBLIC void ms_queue_destroy(MSQueue *q);
 #define mblk_set_discardable_flag(m, bit) __mblk_set_flag(m, 5, bit) /*use to mark a discardable frame*/
 #define mblk_get_discardable_flag(m) (((m)->reserved2) >> 5 & 0x1)   /*bit 6*/
 
+#define mblk_set_base_layer_sync_flag(m, bit)                                                                          \
+	__mblk_set_flag(m, 6, bit) /*use to mark a frame that only depends on the temporal base layer*/
+#define mblk_get_base_layer_sync_flag(m) (((m)->reserved2) >> 6 & 0x1) /*bit 7*/
+
 #define mblk_set_user_flag(m, bit) __mblk_set_flag(m, 7, bit) /* to be used by extensions to mediastreamer2*/
 #define mblk_get_user_flag(m) (((m)->reserved2) >> 7 & 0x1)   /*bit 8*/
 
+/*temporal layer id of the frame (0 is the base layer), as carried by the frame marking extension*/
+#define mblk_set_temporal_layer_id(m, tid) (m)->reserved2 = ((m)->reserved2 & ~(0x7 << 8)) | (((tid) & 0x7) << 8);
+#define mblk_get_temporal_layer_id(m) (((m)->reserved2) >> 8 & 0x7) /*bits 9 to 11*/
+
+#define mblk_set_scalable_flag(m, bit)                                                                                 \
+	__mblk_set_flag(m, 14, bit) /*use to mark a frame of a stream with temporal layers, whose layer id is meaningful*/
+#define mblk_get_scalable_flag(m) (((m)->reserved2) >> 14 & 0x1) /*bit 15*/
+
 #define mblk_set_cseq(m, value) (m)->reserved2 = ((m)->reserved2 & 0x0000FFFF) | ((value & 0xFFFF) << 16);
 #define mblk_get_cseq(m) ((m)->reserved2 >> 16)
 
@@ -588,6 +588,27 @@ MS2_PUBLIC MSVideoConfiguration ms_video_find_best_configuration_for_size_and_bi
  */
 MS2_PUBLIC bool_t ms_video_configuratons_equal(const MSVideoConfiguration *vconf1, const MSVideoConfiguration *vconf2);
 
+#define MS_VIDEO_MAX_TEMPORAL_LAYERS 3
+
+/**
+ * Give the temporal layer of a frame, for a stream encoded with the given number of temporal layers.
+ * With 2 layers, odd frames are in layer 1. With 3 layers, the pattern is 0, 2, 1, 2.
+ * Layer 0 frames only reference layer 0 frames, the others only reference the last layer 0 frame, so that any
+ * set of upper layers can be dropped without breaking the decoding.
+ * @param[in] layers The number of temporal layers, from 1 to MS_VIDEO_MAX_TEMPORAL_LAYERS.
+ * @param[in] frame_index The index of the frame in the stream.
+ * @return The temporal layer id, 0 being the base layer.
+ */
+MS2_PUBLIC int ms_video_get_temporal_layer_id(int layers, uint64_t frame_index);
+
+/**
+ * Give the share of the stream bitrate used by the temporal layers up to a given one (included).
+ * @param[in] layers The number of temporal layers, from 1 to MS_VIDEO_MAX_TEMPORAL_LAYERS.
+ * @param[in] layer_id The highest temporal layer kept.
+ * @return The ratio, between 0 and 1.
+ */
+MS2_PUBLIC float ms_video_get_temporal_layer_bitrate_ratio(int layers, int layer_id);
+
 /**
  * Compute the number and the size of the payloads of the mblk_t packets to create by the video encoder, given the size
  * of the bitstream unit, the maximal payload size and the option to get packets of equal size or not. If the size of
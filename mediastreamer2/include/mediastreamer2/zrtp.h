@@ -131,6 +131,9 @@ typedef struct MSZrtpParams {
 	MsZrtpCryptoTypesCount keyAgreementsCount;
 	MSZrtpSasType sasTypes[MS_MAX_ZRTP_CRYPTO_TYPES];
 	MsZrtpCryptoTypesCount sasTypesCount;
+
+	struct _MSFactory *factory; /**< if set, incoming ZRTP packets are processed by a worker thread of the factory
+	                            crypto pool instead of the thread receiving them */
 } MSZrtpParams;
 
 typedef struct _MSZrtpContext MSZrtpContext;
@@ -178,6 +181,8 @@ MS2_PUBLIC int ms_zrtp_channel_start(MSZrtpContext *ctx);
 /**
  * Free ressources used by ZRTP context
  * it will also free the libbzrtp context if no more channel are active
+ * When the context processes its packets on a crypto worker of the factory, this blocks until the packet being
+ * processed by the worker, if any, is done. The packets still queued are dropped.
  * @param[in/out]	context		the opaque MSZRTP context
  */
 MS2_PUBLIC void ms_zrtp_context_destroy(MSZrtpContext *ctx);
@@ -281,6 +286,15 @@ MS2_PUBLIC uint8_t ms_zrtp_available_key_agreement(MSZrtpKeyAgreement algos[256]
  */
 MS2_PUBLIC bool_t ms_zrtp_is_PQ_available(void);
 
+/**
+ * @brief Set the number of ZRTP key pairs pre-generated in background for each key agreement in use
+ * Avoids generating the ephemeral DH/ECDH/KEM key pairs when processing ZRTP packets on the media path.
+ * The pool is shared by all ZRTP sessions of the process.
+ *
+ * @param[in]	size	number of key pairs kept ready per key agreement, 0 disables the pool
+ */
+MS2_PUBLIC void ms_zrtp_set_key_agreement_pool_size(uint8_t size);
+
 /* Cache wrapper functions : functions needed by liblinphone wrapped to avoid direct dependence of linphone on bzrtp */
 /**
  * @brief Check the given sqlite3 DB and create requested tables if needed
@@ -141,6 +141,12 @@ struct _MSAsyncWriter {
 	uint8_t *wbuf;
 	bctbx_vfs_file_t *fp;
 	size_t blocksize;
+	size_t max_pending_size;
+	MSTask *flush_task;
+	MSAsyncWriterStats stats;
+	off_t pos; /*next write offset in positional mode, only used by the worker thread*/
+	bool_t positional;
+	bool_t flush_requested;
 };
 
 MSAsyncWriter *ms_async_writer_new(bctbx_vfs_file_t *fp) {
@@ -158,46 +164,117 @@ MSAsyncWriter *ms_async_writer_new(bctbx_vfs_file_t *fp) {
 	return obj;
 }
 
+MSAsyncWriter *ms_async_writer_new_at(bctbx_vfs_file_t *fp, off_t offset) {
+	MSAsyncWriter *obj = ms_async_writer_new(fp);
+	obj->pos = offset;
+	obj->positional = TRUE;
+	return obj;
+}
+
 static bool_t async_writer_write(void *data) {
 	MSAsyncWriter *obj = (MSAsyncWriter *)data;
 	size_t size;
-	bool_t ok = FALSE;
+	ssize_t written;
 
-	ms_mutex_lock(&obj->mutex);
-	size = MIN(obj->blocksize, ms_bufferizer_get_avail(&obj->buf));
-	if (ms_bufferizer_read(&obj->buf, obj->wbuf, size) == size) {
-		ok = TRUE;
-	} else {
-		ms_error("async_writer_write(): should not happen");
-	}
-	ms_mutex_unlock(&obj->mutex);
-	if (ok) {
-		if (bctbx_file_write2(obj->fp, obj->wbuf, size) == BCTBX_VFS_ERROR) {
-			ms_error("async_writer_write(): %s", strerror(errno));
+	/*write all the complete blocks, and the remaining bytes if a flush was requested*/
+	while (TRUE) {
+		ms_mutex_lock(&obj->mutex);
+		size = MIN(obj->blocksize, ms_bufferizer_get_avail(&obj->buf));
+		if (size < obj->blocksize && !obj->flush_requested) size = 0;
+		if (size == 0) {
+			obj->flush_requested = FALSE;
+		} else if (ms_bufferizer_read(&obj->buf, obj->wbuf, size) != size) {
+			ms_error("async_writer_write(): should not happen");
+			size = 0;
+		}
+		ms_mutex_unlock(&obj->mutex);
+		if (size == 0) break;
+		if (obj->positional) {
+			written = bctbx_file_write(obj->fp, obj->wbuf, size, obj->pos);
+			obj->pos += (off_t)size;
+		} else {
+			written = bctbx_file_write2(obj->fp, obj->wbuf, size);
+		}
+		if (written != (ssize_t)size) {
+			if (written == BCTBX_VFS_ERROR) ms_error("async_writer_write(): %s", strerror(errno));
+			else ms_error("async_writer_write(): short write of [%i] bytes over [%i]", (int)written, (int)size);
+			ms_mutex_lock(&obj->mutex);
+			obj->stats.failed_writes++;
+			ms_mutex_unlock(&obj->mutex);
 		}
 	}
-	return ok;
+	return TRUE;
 }
 
-void ms_async_writer_destroy(MSAsyncWriter *obj) {
-	if (ms_bufferizer_get_avail(&obj->buf) > 0) {
-		/*push last samples, even if less than blocksize long */
-		ms_worker_thread_add_task(obj->wth, async_writer_write, obj);
+static bool_t async_writer_flush(void *data) {
+	MSAsyncWriter *obj = (MSAsyncWriter *)data;
+	ms_mutex_lock(&obj->mutex);
+	obj->flush_requested = TRUE;
+	ms_mutex_unlock(&obj->mutex);
+	return async_writer_write(data);
+}
+
+int ms_async_writer_destroy(MSAsyncWriter *obj) {
+	int err;
+	if (obj->flush_task) {
+		ms_task_cancel_and_destroy(obj->flush_task);
+		obj->flush_task = NULL;
 	}
+	/*push last samples, even if less than blocksize long */
+	ms_worker_thread_add_task(obj->wth, async_writer_flush, obj);
 	ms_worker_thread_destroy(obj->wth, TRUE);
+	err = obj->stats.failed_writes > 0 ? -1 : 0;
 	ms_mutex_destroy(&obj->mutex);
 	ms_bufferizer_flush(&obj->buf);
 	ms_free(obj->wbuf);
 	ms_free(obj);
+	return err;
 }
 
 int ms_async_writer_write(MSAsyncWriter *obj, mblk_t *m) {
+	size_t avail;
 	ms_mutex_lock(&obj->mutex);
+	if (obj->max_pending_size > 0 && ms_bufferizer_get_avail(&obj->buf) + msgdsize(m) > obj->max_pending_size) {
+		/*the file is not written fast enough, do not let the queue grow without limit*/
+		obj->stats.rejected_writes++;
+		ms_mutex_unlock(&obj->mutex);
+		freemsg(m);
+		return -1;
+	}
 	ms_bufferizer_put(&obj->buf, m);
+	avail = ms_bufferizer_get_avail(&obj->buf);
+	if (avail > obj->stats.max_pending_size_reached) obj->stats.max_pending_size_reached = avail;
 	/*each time we have blocksize bytes in a bufferizer, push a write*/
-	if (ms_bufferizer_get_avail(&obj->buf) >= obj->blocksize) {
+	if (avail >= obj->blocksize) {
 		ms_worker_thread_add_task(obj->wth, async_writer_write, obj);
 	}
 	ms_mutex_unlock(&obj->mutex);
 	return 0;
 }
+
+void ms_async_writer_set_max_pending_size(MSAsyncWriter *obj, size_t size) {
+	ms_mutex_lock(&obj->mutex);
+	obj->max_pending_size = size;
+	ms_mutex_unlock(&obj->mutex);
+}
+
+void ms_async_writer_flush(MSAsyncWriter *obj) {
+	ms_worker_thread_add_task(obj->wth, async_writer_flush, obj);
+}
+
+void ms_async_writer_set_flush_interval(MSAsyncWriter *obj, int interval_ms) {
+	if (obj->flush_task) {
+		ms_task_cancel_and_destroy(obj->flush_task);
+		obj->flush_task = NULL;
+	}
+	if (interval_ms > 0) {
+		obj->flush_task = ms_worker_thread_add_repeated_task(obj->wth, async_writer_flush, obj, interval_ms);
+	}
+}
+
+void ms_async_writer_get_stats(MSAsyncWriter *obj, MSAsyncWriterStats *stats) {
+	ms_mutex_lock(&obj->mutex);
+	*stats = obj->stats;
+	stats->pending_size = ms_bufferizer_get_avail(&obj->buf);
+	ms_mutex_unlock(&obj->mutex);
+}
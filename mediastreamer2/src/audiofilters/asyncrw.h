@@ -29,9 +29,20 @@
 
 #include <ortp/str_utils.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef struct _MSAsyncReader MSAsyncReader;
 typedef struct _MSAsyncWriter MSAsyncWriter;
 
+typedef struct _MSAsyncWriterStats {
+	size_t pending_size;             /*number of bytes queued and not yet written to the file*/
+	size_t max_pending_size_reached; /*highest value reached by pending_size*/
+	unsigned int rejected_writes;    /*number of ms_async_writer_write() refused because the queue was full*/
+	unsigned int failed_writes;      /*number of blocks that could not be entirely written to the file*/
+} MSAsyncWriterStats;
+
 MSAsyncReader *ms_async_reader_new(bctbx_vfs_file_t *fp);
 
 void ms_async_reader_destroy(MSAsyncReader *obj);
@@ -42,8 +53,42 @@ void ms_async_reader_seek(MSAsyncReader *obj, off_t offset);
 
 MSAsyncWriter *ms_async_writer_new(bctbx_vfs_file_t *fp);
 
-void ms_async_writer_destroy(MSAsyncWriter *obj);
+/*
+ * Create a writer using positional writes from offset instead of the current file position. Each block is written at
+ * the offset its bytes were queued for, so a failed write does not shift the data written after it.
+ */
+MSAsyncWriter *ms_async_writer_new_at(bctbx_vfs_file_t *fp, off_t offset);
 
+/*
+ * Write the queued data and destroy the writer. Returns -1 if some data could not be written to the file, 0 otherwise.
+ */
+int ms_async_writer_destroy(MSAsyncWriter *obj);
+
+/*
+ * Queue m to be written to the file. Returns -1 and frees m if the queue is bounded and full.
+ */
 int ms_async_writer_write(MSAsyncWriter *obj, mblk_t *m);
 
+/*
+ * Bound the number of bytes that can be queued, 0 meaning unbounded (the default).
+ */
+void ms_async_writer_set_max_pending_size(MSAsyncWriter *obj, size_t size);
+
+/*
+ * Request the queued data to be written, even if less than a block is available.
+ */
+void ms_async_writer_flush(MSAsyncWriter *obj);
+
+/*
+ * Flush the queued data every interval_ms milliseconds, so that it does not stay in memory until a full block is
+ * available. 0 (the default) disables the periodic flush.
+ */
+void ms_async_writer_set_flush_interval(MSAsyncWriter *obj, int interval_ms);
+
+void ms_async_writer_get_stats(MSAsyncWriter *obj, MSAsyncWriterStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -31,6 +31,8 @@
 
 #define MAX_SCANS 10
 
+static_assert(MAX_SCANS <= mediastreamer::GoertzelFilterBank::MaxFrequencies, "Too many scans for the filter bank");
+
 using namespace mediastreamer;
 
 static const float energy_min_threshold = 0.01f;
@@ -48,6 +50,7 @@ static float compute_energy(int16_t *samples, int nsamples) {
 typedef struct _DetectorState {
 	MSToneDetectorDef tone_def[MAX_SCANS];
 	GoertzelState tone_gs[MAX_SCANS];
+	GoertzelFilterBank bank;
 	int nscans;
 	MSBufferizer *buf;
 	int rate;
@@ -87,6 +90,7 @@ static int detector_add_scan(MSFilter *f, void *arg) {
 		s->tone_def[i] = *def;
 		s->nscans++;
 		s->tone_gs[i].init(def->frequency, s->rate);
+		s->bank.setFrequency(i, def->frequency, s->rate);
 		return 0;
 	}
 	return -1;
@@ -96,6 +100,7 @@ static int detector_clear_scans(MSFilter *f, BCTBX_UNUSED(void *arg)) {
 	DetectorState *s = (DetectorState *)f->data;
 	memset(&s->tone_def, 0, sizeof(s->tone_def));
 	s->nscans = 0;
+	s->bank.clear();
 	return 0;
 }
 
@@ -132,12 +137,14 @@ static void detector_process(MSFilter *f) {
 		while (ms_bufferizer_read(s->buf, buf, s->framesize) != 0) {
 			float en = compute_energy((int16_t *)buf, s->framesize / 2);
 			if (en > energy_min_threshold * (32767.0 * 32767.0 * 0.7)) {
+				float freq_en[MAX_SCANS];
 				int i;
+				/* All the scanned frequencies are evaluated in a single pass over the frame */
+				s->bank.run(reinterpret_cast<int16_t *>(buf), s->framesize / 2, en, freq_en);
 				for (i = 0; i < s->nscans; ++i) {
 					GoertzelState *gs = &s->tone_gs[i];
 					MSToneDetectorDef *tone_def = &s->tone_def[i];
-					float freq_en = gs->run(reinterpret_cast<int16_t *>(buf), s->framesize / 2, en);
-					if (freq_en >= tone_def->min_amplitude) {
+					if (freq_en[i] >= tone_def->min_amplitude) {
 						if (gs->get_duration() == 0) gs->set_start_time(f->ticker->time);
 						gs->set_duration(gs->get_duration() + s->frame_ms);
 						if (gs->get_duration() >= tone_def->min_duration && !gs->is_event_sent()) {
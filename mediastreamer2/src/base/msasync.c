@@ -18,6 +18,8 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <bctoolbox/defs.h>
+
 #include "mediastreamer2/msasync.h"
 
 static void _ms_task_cancel(MSTask *task, bool_t with_destroy) {
@@ -255,3 +257,134 @@ void ms_worker_thread_destroy(MSWorkerThread *obj, bool_t finish_tasks) {
 	if (obj->name) bctbx_free(obj->name);
 	ms_free(obj);
 }
+
+typedef struct _MSPooledWorkerThread {
+	MSWorkerThread *worker;
+	int users;
+} MSPooledWorkerThread;
+
+struct _MSWorkerThreadPool {
+	ms_mutex_t mutex;
+	bctbx_list_t *workers; /* list of MSPooledWorkerThread */
+	int threadless_users;
+	char *name;
+	int max_threads;
+	int thread_index;
+};
+
+MSWorkerThreadPool *ms_worker_thread_pool_new(const char *name, int max_threads) {
+	MSWorkerThreadPool *obj = ms_new0(MSWorkerThreadPool, 1);
+	ms_mutex_init(&obj->mutex, NULL);
+	obj->name = bctbx_strdup(name);
+	obj->max_threads = MAX(max_threads, 1);
+	return obj;
+}
+
+void ms_worker_thread_pool_set_max_threads(MSWorkerThreadPool *obj, int max_threads) {
+	ms_mutex_lock(&obj->mutex);
+	obj->max_threads = MAX(max_threads, 1);
+	ms_mutex_unlock(&obj->mutex);
+}
+
+int ms_worker_thread_pool_get_max_threads(const MSWorkerThreadPool *obj) {
+	return obj->max_threads;
+}
+
+int ms_worker_thread_pool_get_user_count(MSWorkerThreadPool *obj) {
+	int count;
+	bctbx_list_t *it;
+	ms_mutex_lock(&obj->mutex);
+	count = obj->threadless_users;
+	for (it = obj->workers; it != NULL; it = it->next) {
+		count += ((MSPooledWorkerThread *)it->data)->users;
+	}
+	ms_mutex_unlock(&obj->mutex);
+	return count;
+}
+
+void ms_worker_thread_pool_add_user(MSWorkerThreadPool *obj) {
+	ms_mutex_lock(&obj->mutex);
+	obj->threadless_users++;
+	ms_mutex_unlock(&obj->mutex);
+}
+
+void ms_worker_thread_pool_remove_user(MSWorkerThreadPool *obj) {
+	ms_mutex_lock(&obj->mutex);
+	if (obj->threadless_users > 0) obj->threadless_users--;
+	else ms_error("ms_worker_thread_pool_remove_user(): pool [%s] has no such user", obj->name);
+	ms_mutex_unlock(&obj->mutex);
+}
+
+MSWorkerThread *ms_worker_thread_pool_acquire(MSWorkerThreadPool *obj) {
+	MSPooledWorkerThread *chosen = NULL;
+	bctbx_list_t *it;
+
+	ms_mutex_lock(&obj->mutex);
+	for (it = obj->workers; it != NULL; it = it->next) {
+		MSPooledWorkerThread *pooled = (MSPooledWorkerThread *)it->data;
+		if (chosen == NULL || pooled->users < chosen->users) chosen = pooled;
+	}
+	if (chosen == NULL || (chosen->users > 0 && (int)bctbx_list_size(obj->workers) < obj->max_threads)) {
+		char *name = bctbx_strdup_printf("%s-%i", obj->name, obj->thread_index++);
+		chosen = ms_new0(MSPooledWorkerThread, 1);
+		chosen->worker = ms_worker_thread_new(name);
+		bctbx_free(name);
+		obj->workers = bctbx_list_append(obj->workers, chosen);
+	}
+	chosen->users++;
+	ms_mutex_unlock(&obj->mutex);
+	return chosen->worker;
+}
+
+static bool_t ms_worker_thread_pool_barrier(BCTBX_UNUSED(void *data)) {
+	return TRUE;
+}
+
+void ms_worker_thread_pool_release(MSWorkerThreadPool *obj, MSWorkerThread *worker) {
+	MSPooledWorkerThread *pooled = NULL;
+	MSTask *barrier;
+	bctbx_list_t *it;
+
+	/* Tasks are executed in order: once the barrier is done, the previous tasks of the user are done too. */
+	barrier = ms_worker_thread_add_waitable_task(worker, ms_worker_thread_pool_barrier, NULL);
+	ms_task_wait_completion(barrier);
+	ms_task_destroy(barrier);
+
+	ms_mutex_lock(&obj->mutex);
+	for (it = obj->workers; it != NULL; it = it->next) {
+		if (((MSPooledWorkerThread *)it->data)->worker == worker) {
+			pooled = (MSPooledWorkerThread *)it->data;
+			break;
+		}
+	}
+	if (pooled == NULL) {
+		ms_error("ms_worker_thread_pool_release(): worker thread [%p] does not belong to pool [%s]", worker, obj->name);
+		ms_mutex_unlock(&obj->mutex);
+		return;
+	}
+	pooled->users--;
+	if (pooled->users == 0) {
+		obj->workers = bctbx_list_erase_link(obj->workers, it);
+	} else {
+		pooled = NULL;
+	}
+	ms_mutex_unlock(&obj->mutex);
+
+	if (pooled) {
+		ms_worker_thread_destroy(pooled->worker, TRUE);
+		ms_free(pooled);
+	}
+}
+
+void ms_worker_thread_pool_destroy(MSWorkerThreadPool *obj) {
+	if (obj->workers) {
+		ms_error("ms_worker_thread_pool_destroy(): pool [%s] still has %i worker threads in use", obj->name,
+		         (int)bctbx_list_size(obj->workers));
+	}
+	if (obj->threadless_users > 0) {
+		ms_error("ms_worker_thread_pool_destroy(): pool [%s] still has %i users", obj->name, obj->threadless_users);
+	}
+	ms_mutex_destroy(&obj->mutex);
+	bctbx_free(obj->name);
+	ms_free(obj);
+}
@@ -34,6 +34,7 @@
 #endif
 
 #include "basedescs.h"
+#include "mediastreamer2/msasync.h"
 #include "mediastreamer2/mseventqueue.h"
 #include "mediastreamer2/msfilter.h"
 #include "mediastreamer2/msvideo.h"
@@ -134,6 +135,46 @@ void ms_factory_set_cpu_count(MSFactory *obj, unsigned int c) {
 	obj->cpu_count = c;
 }
 
+void ms_factory_set_video_codec_thread_budget(MSFactory *obj, int threads) {
+	ms_message("Video codec thread budget set to %d", threads);
+	obj->video_codec_thread_budget = threads;
+}
+
+int ms_factory_get_video_codec_thread_budget(MSFactory *obj) {
+	return obj->video_codec_thread_budget > 0 ? obj->video_codec_thread_budget : (int)obj->cpu_count;
+}
+
+MSWorkerThread *ms_factory_acquire_video_codec_worker(MSFactory *obj) {
+	ms_worker_thread_pool_set_max_threads(obj->video_codec_pool, ms_factory_get_video_codec_thread_budget(obj));
+	return ms_worker_thread_pool_acquire(obj->video_codec_pool);
+}
+
+void ms_factory_release_video_codec_worker(MSFactory *obj, MSWorkerThread *worker) {
+	ms_worker_thread_pool_release(obj->video_codec_pool, worker);
+}
+
+void ms_factory_register_video_codec(MSFactory *obj) {
+	ms_worker_thread_pool_add_user(obj->video_codec_pool);
+}
+
+void ms_factory_unregister_video_codec(MSFactory *obj) {
+	ms_worker_thread_pool_remove_user(obj->video_codec_pool);
+}
+
+int ms_factory_get_video_codec_thread_count(MSFactory *obj, int max_threads) {
+	int users = MAX(ms_worker_thread_pool_get_user_count(obj->video_codec_pool), 1);
+	int threads = ms_factory_get_video_codec_thread_budget(obj) / users;
+	return MIN(MAX(threads, 1), max_threads);
+}
+
+MSWorkerThread *ms_factory_acquire_crypto_worker(MSFactory *obj) {
+	return ms_worker_thread_pool_acquire(obj->crypto_pool);
+}
+
+void ms_factory_release_crypto_worker(MSFactory *obj, MSWorkerThread *worker) {
+	ms_worker_thread_pool_release(obj->crypto_pool, worker);
+}
+
 void ms_factory_add_platform_tag(MSFactory *obj, const char *tag) {
 	if ((tag == NULL) || (tag[0] == '\0')) return;
 	if (bctbx_list_find_custom(obj->platform_tags, (bctbx_compare_func)strcasecmp, tag) == NULL) {
@@ -211,6 +252,8 @@ void ms_factory_init(MSFactory *obj) {
 #warning "There is no code that detects the number of CPU for this platform."
 #endif
 	ms_factory_set_cpu_count(obj, num_cpu);
+	obj->video_codec_pool = ms_worker_thread_pool_new("MSVideoCodec", num_cpu);
+	obj->crypto_pool = ms_worker_thread_pool_new("MSCrypto", num_cpu);
 	ms_factory_set_mtu(obj, MS_MTU_DEFAULT);
 #ifdef _WIN32
 	ms_factory_add_platform_tag(obj, "win32");
@@ -1147,6 +1190,8 @@ void ms_factory_destroy(MSFactory *factory) {
 	if (factory->plugins_dir) ms_free(factory->plugins_dir);
 	if (factory->image_resources_dir) ms_free(factory->image_resources_dir);
 	if (factory->wbcmanager) ms_web_cam_manager_destroy(factory->wbcmanager);
+	if (factory->video_codec_pool) ms_worker_thread_pool_destroy(factory->video_codec_pool);
+	if (factory->crypto_pool) ms_worker_thread_pool_destroy(factory->crypto_pool);
 	ms_free(factory);
 	if (factory == fallback_factory) fallback_factory = NULL;
 }
@@ -119,6 +119,9 @@ public:
 	}
 
 private:
+	static constexpr int SpaceToneIndex = 0;
+	static constexpr int MarkToneIndex = 1;
+
 	// Calculate the number of bits corresponding to a tone duration, according to the given standard.
 	static uint16_t calcNbBits(uint16_t nbMs, MSBaudotStandard standard) {
 		switch (standard) {
@@ -303,8 +306,8 @@ private:
 	}
 
 	void initGoertzelStates() {
-		mGoertzelStates[0].init(SPACE_TONE_FREQ, mRate);
-		mGoertzelStates[1].init(MARK_TONE_FREQ, mRate);
+		mGoertzelBank.setFrequency(SpaceToneIndex, SPACE_TONE_FREQ, mRate);
+		mGoertzelBank.setFrequency(MarkToneIndex, MARK_TONE_FREQ, mRate);
 	}
 
 	bool isDuration(uint16_t nbMs, MSBaudotStandard standard) {
@@ -351,8 +354,10 @@ private:
 	void processSample(MSFilter *f, int16_t *buffer) {
 		float energy = computeEnergy(buffer, mFrameSize / 2);
 		if (energy > (ENERGY_MIN_THRESHOLD * 32767.0 * 32767.0 * 0.7)) {
-			float spaceStateEnergy = mGoertzelStates[0].run(buffer, mFrameSize / 2, energy);
-			float markStateEnergy = mGoertzelStates[1].run(buffer, mFrameSize / 2, energy);
+			float energies[2];
+			mGoertzelBank.run(buffer, mFrameSize / 2, energy, energies);
+			float spaceStateEnergy = energies[SpaceToneIndex];
+			float markStateEnergy = energies[MarkToneIndex];
 			if (isSpaceDetected(spaceStateEnergy, markStateEnergy)) {
 				handleMarkBits(f);
 				mConsecutiveSpaceMs++;
@@ -393,7 +398,7 @@ private:
 	}
 
 	BaudotDecodingContext mContext;
-	GoertzelState mGoertzelStates[2];
+	GoertzelFilterBank mGoertzelBank;
 	DetectionState mDetectionState = WaitingForCarrier;
 	MSBufferizer *mBufferizer = nullptr;
 	bctoolboxTimeSpec mTemporaryDetectionDisablingTime;
@@ -19,12 +19,15 @@
  */
 
 #include <array>
+#include <atomic>
 #include <bctoolbox/defs.h>
 #include <mutex>
 #include <queue>
 
 #include "mediastreamer2/dtls_srtp.h"
 #include "mediastreamer2/mediastream.h"
+#include "mediastreamer2/msasync.h"
+#include "mediastreamer2/msfactory.h"
 #include "private.h"
 
 #ifdef _WIN32
@@ -86,8 +89,8 @@ struct _MSDtlsSrtpContext {
 	int mtu;
 	RtpTransportModifier *rtp_modifier;
 	DtlsCrypto mDtlsCryptoContext; /**< a structure containing all contexts needed by DTLS handshake for RTP channel */
-	DtlsStatus mChannelStatus;     /**< channel status :not ready, ready, hanshake on going, handshake over, fingerprint
-	verified, failed */
+	std::atomic<DtlsStatus> mChannelStatus; /**< channel status :not ready, ready, hanshake on going, handshake over,
+	fingerprint verified, failed */
 	bool mVerifyCertificate;       /**< shall we verify the peer certificate? */
 	std::string mPeerUri;          /**< the peer uri as announced in the SDP */
 
@@ -95,22 +98,33 @@ struct _MSDtlsSrtpContext {
 	                                                                 on rtp channel */
 	MSCryptoSuite mSrtpProtectionProfile;                      /**< agreed protection profile on rtp channel */
 	std::queue<std::vector<uint8_t>>
-	    mRtpIncomingBuffer;      /**< buffer of incoming DTLS packet to be read by mbedtls callback */
-	uint64_t rtp_time_reference; /**< an epoch in ms, used to manage retransmission when we are client */
-	bool retry_sending;          /**< a flag to set a retry after failed packet sending */
-	std::mutex mtx;              /**< lock any operation on this context */
+	    mRtpIncomingBuffer; /**< buffer of incoming DTLS packet to be read by mbedtls callback */
+	std::queue<mblk_t *> mRtpOutgoingBuffer; /**< DTLS packets produced off the ticker thread, waiting to be sent */
+	std::atomic<uint64_t> rtp_time_reference; /**< an epoch in ms, used to manage retransmission when we are client */
+	std::atomic<bool> retry_sending;          /**< a flag to set a retry after failed packet sending */
+	std::mutex mtx;                           /**< lock any operation on this context */
+	std::mutex mOutgoingMtx;                  /**< lock the outgoing buffer only */
+	MSFactory *mFactory;                      /**< factory providing the worker thread */
+	MSWorkerThread *mWorker; /**< when set, incoming DTLS packets are processed by this thread */
+	bool mStopped;           /**< set before destruction, so that packets still queued on the worker are dropped */
 
 	_MSDtlsSrtpContext() = delete;
 	_MSDtlsSrtpContext(MSMediaStreamSessions *sessions, MSDtlsSrtpParams *params)
 	    : mStreamSessions(sessions), mRole(params->role), mtu(params->mtu),
-	      mVerifyCertificate(params->verify_certificate), mPeerUri(std::string(params->peer_uri)) {
+	      mVerifyCertificate(params->verify_certificate), mPeerUri(std::string(params->peer_uri)),
+	      mFactory(params->factory), mWorker(nullptr), mStopped(false) {
 		rtp_time_reference = 0;
 		retry_sending = false;
 
 		mChannelStatus = DtlsStatus::ContextNotReady;
 		mSrtpProtectionProfile = MS_CRYPTO_SUITE_INVALID;
 	};
-	~_MSDtlsSrtpContext() = default;
+	~_MSDtlsSrtpContext() {
+		while (!mRtpOutgoingBuffer.empty()) {
+			freemsg(mRtpOutgoingBuffer.front());
+			mRtpOutgoingBuffer.pop();
+		}
+	};
 
 	int initialiseDtlsCryptoContext(MSDtlsSrtpParams *params);
 	void start();
@@ -246,11 +260,45 @@ ms_dtls_srtp_bctbx_protection_profile_to_ms_crypto_suite(bctbx_dtls_srtp_profile
 	}
 }
 
-void schedule_rtp(struct _RtpTransportModifier *t) {
-	MSDtlsSrtpContext *ctx = (MSDtlsSrtpContext *)t->data;
+/* Send a DTLS packet through the RTP session, returns what the transport returned. Must run on the ticker thread. */
+int ms_dtls_srtp_send_packet(MSDtlsSrtpContext *context, mblk_t *msg) {
+	RtpTransport *rtpt = NULL;
+	int ret;
+
+	/* get RTP transport from session */
+	rtp_session_get_transports(context->mStreamSessions->rtp_session, &rtpt, NULL);
+	ret = meta_rtp_transport_modifier_inject_packet_to_send(rtpt, context->rtp_modifier, msg, 0);
+	freemsg(msg);
+
+	/* sending failed - allow to retry at the next schedule tick */
+	if (ret < 0) {
+		ms_warning("DTLS Send RTP packet sessions: %p rtp session %p failed returns %d", context->mStreamSessions,
+		           context->mStreamSessions->rtp_session, ret);
+		context->retry_sending = true;
+	}
+	return ret;
+}
+
+/* Send the packets queued by ms_dtls_srtp_rtp_sendData() on other threads */
+void ms_dtls_srtp_flush_outgoing_packets(MSDtlsSrtpContext *ctx) {
+	std::queue<mblk_t *> packets;
+	{
+		std::lock_guard<std::mutex> lock(ctx->mOutgoingMtx);
+		packets.swap(ctx->mRtpOutgoingBuffer);
+	}
+	while (!packets.empty()) {
+		ms_dtls_srtp_send_packet(ctx, packets.front());
+		packets.pop();
+	}
+}
+
+void ms_dtls_srtp_schedule_handshake(MSDtlsSrtpContext *ctx) {
+	/* This runs on the ticker thread, which must not wait for a handshake processed by the worker thread: when the
+	 * context is busy, try again at the next tick. */
+	std::unique_lock<std::mutex> lock(ctx->mtx, std::defer_lock);
 	/* the retry sending flag is raised when a sending failed */
 	if (ctx->retry_sending) {
-		std::lock_guard<std::mutex> lock(ctx->mtx);
+		if (!lock.try_lock()) return;
 		ctx->retry_sending = false;
 		bctbx_ssl_handshake(ctx->mDtlsCryptoContext.ssl);
 		return;
@@ -264,7 +312,7 @@ void schedule_rtp(struct _RtpTransportModifier *t) {
 	if (ctx->rtp_time_reference > 0) { /* only when retransmission timer is armed */
 		auto current_time = bctbx_get_cur_time_ms();
 		if (current_time - ctx->rtp_time_reference > DtlsRepetitionTimerPoll) {
-			std::lock_guard<std::mutex> lock(ctx->mtx);
+			if (!lock.try_lock()) return;
 			if (ctx->rtp_time_reference >
 			    0) { /* recheck the timer is still armed once we're into the guarded section */
 				bctbx_ssl_handshake(ctx->mDtlsCryptoContext.ssl);
@@ -274,6 +322,12 @@ void schedule_rtp(struct _RtpTransportModifier *t) {
 	}
 }
 
+void schedule_rtp(struct _RtpTransportModifier *t) {
+	MSDtlsSrtpContext *ctx = (MSDtlsSrtpContext *)t->data;
+	ms_dtls_srtp_schedule_handshake(ctx);
+	ms_dtls_srtp_flush_outgoing_packets(ctx);
+}
+
 /********************************************/
 /**** bctoolbox DTLS packet I/O functions ****/
 
@@ -293,30 +347,24 @@ void schedule_rtp(struct _RtpTransportModifier *t) {
  */
 int ms_dtls_srtp_rtp_sendData(void *ctx, const unsigned char *data, size_t length) {
 	MSDtlsSrtpContext *context = (MSDtlsSrtpContext *)ctx;
-	RtpSession *session = context->mStreamSessions->rtp_session;
-	RtpTransport *rtpt = NULL;
-	mblk_t *msg;
-	int ret;
 
 	ms_message("DTLS Send RTP packet len %d sessions: %p rtp session %p", (int)length, context->mStreamSessions,
 	           context->mStreamSessions->rtp_session);
 
-	/* get RTP transport from session */
-	rtp_session_get_transports(session, &rtpt, NULL);
-
 	/* generate message from raw data */
-	msg = rtp_create_packet((uint8_t *)data, length);
-
-	ret = meta_rtp_transport_modifier_inject_packet_to_send(rtpt, context->rtp_modifier, msg, 0);
-	freemsg(msg);
-
-	/* sending failed - allow to retry at the next schedule tick */
-	if (ret < 0) {
-		ms_warning("DTLS Send RTP packet len %d sessions: %p rtp session %p failed returns %d", (int)length,
-		           context->mStreamSessions, context->mStreamSessions->rtp_session, ret);
-		context->retry_sending = true;
-		return BCTBX_ERROR_NET_WANT_WRITE;
+	mblk_t *msg = rtp_create_packet((uint8_t *)data, length);
+
+	if (context->mWorker != nullptr) {
+		/* The handshake may run on the worker thread or on the thread starting the stream, while the RTP session is
+		 * used by the ticker thread: let schedule_rtp() send the packet at the next tick. A packet lost afterwards is
+		 * handled like any lost datagram, by the DTLS retransmissions. */
+		std::lock_guard<std::mutex> lock(context->mOutgoingMtx);
+		context->mRtpOutgoingBuffer.push(msg);
+		return (int)length;
 	}
+
+	int ret = ms_dtls_srtp_send_packet(context, msg);
+	if (ret < 0) return BCTBX_ERROR_NET_WANT_WRITE;
 	return ret;
 }
 
@@ -343,16 +391,11 @@ int ms_dtls_srtp_rtp_DTLSread(void *ctx, unsigned char *buf, size_t len) {
 /*******************************************************/
 /**** Transport Modifier Sender/Receiver functions  ****/
 
-int ms_dtls_srtp_rtp_process_on_receive(struct _RtpTransportModifier *t, mblk_t *msg) {
-	MSDtlsSrtpContext *ctx = (MSDtlsSrtpContext *)t->data;
-	if (!ctx->isDtlsPacket(msg)) {
-		return (int)msgdsize(msg);
-	}
-
-	std::lock_guard<std::mutex> lock(ctx->mtx);
+/* Process an incoming DTLS packet, the context lock must be held */
+void ms_dtls_srtp_handle_packet(MSDtlsSrtpContext *ctx, mblk_t *msg) {
 	if (ctx->mChannelStatus == DtlsStatus::HandshakeFailed) {
 		ms_message("DTLS RTP received a message but we are in failed state: ignore");
-		return 0;
+		return;
 	}
 
 	/* process it */
@@ -361,21 +404,21 @@ int ms_dtls_srtp_rtp_process_on_receive(struct _RtpTransportModifier *t, mblk_t
 		/* something went wrong with the handshake - abort */
 		ctx->resetKeyMaterial();
 		ctx->setChannelStatus(DtlsStatus::HandshakeFailed, MS_DTLS_ERROR_HANDSHAKE_FAIL_FATAL_ALERT);
-		return 0;
+		return;
 	}
 
 	if (ret == BCTBX_ERROR_CERT_VERIFY_FAILED) {
 		/* failed to verify peer's certificate */
 		ctx->resetKeyMaterial();
 		ctx->setChannelStatus(DtlsStatus::HandshakeFailed, MS_DTLS_ERROR_CERT_VERIFY_FAIL);
-		return 0;
+		return;
 	}
 
 	if (ret == 0 && ctx->mChannelStatus == DtlsStatus::HandshakeOngoing) {
 		/* handshake is now over */
 		if (ctx->mVerifyCertificate) { // Certificate was verified, now check that it holds a subject (or cname)
 			if (!ctx->isPeerCerticateMatchHisUri()) {
-				return 0;
+				return;
 			}
 		}
 		ctx->mChannelStatus = DtlsStatus::HandshakeOver;
@@ -386,7 +429,7 @@ int ms_dtls_srtp_rtp_process_on_receive(struct _RtpTransportModifier *t, mblk_t
 		if (ctx->mSrtpProtectionProfile == MS_CRYPTO_SUITE_INVALID) {
 			ctx->setChannelStatus(DtlsStatus::HandshakeFailed, MS_DTLS_ERROR_HANDSHAKE_FAIL_TO_GENERATE_SRTP_KEYS);
 			ms_error("DTLS SRTP handshake successful but unable to agree on srtp_profile to use");
-			return 0;
+			return;
 		} else {
 			/* Get key material generated by DTLS handshake */
 			size_t dtls_srtp_key_material_length = ctx->mSrtpKeyMaterial.size();
@@ -399,13 +442,13 @@ int ms_dtls_srtp_rtp_process_on_receive(struct _RtpTransportModifier *t, mblk_t
 			if (ret < 0) {
 				ms_error("DTLS SRTP Handshake : Unable to retrieve DTLS SRTP key material [-0x%x]", -ret);
 				ctx->setChannelStatus(DtlsStatus::HandshakeFailed, MS_DTLS_ERROR_HANDSHAKE_FAIL_TO_GENERATE_SRTP_KEYS);
-				return 0;
+				return;
 			}
 
 			/* Check certificate fingerprint */
 			if (ctx->mPeerFingerprint.empty()) { /* fingerprint not set yet - peer's 200Ok didn't arrived yet */
 				ms_warning("DTLS-SRTP: RTP empty peer fingerprint - waiting for it");
-				return 0;
+				return;
 			}
 
 			if (ms_dtls_srtp_check_certificate_fingerprint(bctbx_ssl_get_peer_certificate(ctx->mDtlsCryptoContext.ssl),
@@ -415,6 +458,43 @@ int ms_dtls_srtp_rtp_process_on_receive(struct _RtpTransportModifier *t, mblk_t
 			}
 		}
 	}
+}
+
+typedef struct _DtlsPacketTask {
+	MSDtlsSrtpContext *ctx;
+	mblk_t *msg;
+} DtlsPacketTask;
+
+bool_t ms_dtls_srtp_process_packet_task(void *data) {
+	DtlsPacketTask *task = (DtlsPacketTask *)data;
+	{
+		std::lock_guard<std::mutex> lock(task->ctx->mtx);
+		if (!task->ctx->mStopped) {
+			ms_dtls_srtp_handle_packet(task->ctx, task->msg);
+		}
+	}
+	freemsg(task->msg);
+	ms_free(task);
+	return TRUE;
+}
+
+int ms_dtls_srtp_rtp_process_on_receive(struct _RtpTransportModifier *t, mblk_t *msg) {
+	MSDtlsSrtpContext *ctx = (MSDtlsSrtpContext *)t->data;
+	if (!ctx->isDtlsPacket(msg)) {
+		return (int)msgdsize(msg);
+	}
+
+	if (ctx->mWorker != nullptr) {
+		/* Key exchange, signatures and certificate verification are done by the worker thread, so that they do not
+		 * delay the media of the other streams sharing the receiving thread. */
+		DtlsPacketTask *task = ms_new0(DtlsPacketTask, 1);
+		task->ctx = ctx;
+		task->msg = copymsg(msg);
+		ms_worker_thread_add_task(ctx->mWorker, ms_dtls_srtp_process_packet_task, task);
+	} else {
+		std::lock_guard<std::mutex> lock(ctx->mtx);
+		ms_dtls_srtp_handle_packet(ctx, msg);
+	}
 	return 0;
 }
 
@@ -979,6 +1059,9 @@ extern "C" MSDtlsSrtpContext *ms_dtls_srtp_context_new(MSMediaStreamSessions *se
 	}
 
 	context->mChannelStatus = DtlsStatus::ContextReady;
+	if (params->factory != NULL) {
+		context->mWorker = ms_factory_acquire_crypto_worker(params->factory);
+	}
 	return context;
 }
 
@@ -1002,6 +1085,14 @@ extern "C" void ms_dtls_srtp_start(MSDtlsSrtpContext *context) {
 }
 
 extern "C" void ms_dtls_srtp_context_destroy(MSDtlsSrtpContext *ctx) {
+	if (ctx->mWorker != nullptr) {
+		{
+			std::lock_guard<std::mutex> lock(ctx->mtx);
+			ctx->mStopped = true;
+		}
+		/* returns once the packets still queued are dropped */
+		ms_factory_release_crypto_worker(ctx->mFactory, ctx->mWorker);
+	}
 	delete ctx;
 	ms_message("DTLS-SRTP context destroyed");
 }
@@ -18,6 +18,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
 #include <map>
 #include <mutex>
 #include <vector>
@@ -216,6 +217,15 @@ public:
 	srtp_t mInnerSrtp;
 	MSSrtpStreamStats mInnerStats;
 
+	/* Scratch buffers reused from one packet to the next (always accessed under mMutex) */
+	std::vector<uint8_t> mHeaderScratch; /**< RTP header and extensions saved while the inner layer works in place */
+	std::vector<uint8_t> mEktTagScratch; /**< EKT tag put aside while the outer layer works in transfer mode */
+
+	/* Cumulated RTP processing statistics */
+	uint64_t mProcessedPackets;
+	uint64_t mProcessedBytes;
+	std::chrono::nanoseconds mCryptoTime;
+
 	/* For EKT */
 	MSEKTMode mEktMode; /**< EKT operation mode:
 	                     * disabled: no EKT operation
@@ -226,7 +236,26 @@ public:
 
 	MSSrtpStreamContext()
 	    : mSrtp{nullptr}, mModifierRtp{nullptr}, mModifierRtcp{nullptr}, mSecured{false}, mMandatoryEnabled{false},
-	      mInnerSrtp{nullptr}, mEktMode{MS_EKT_DISABLED} {};
+	      mInnerSrtp{nullptr}, mProcessedPackets{0}, mProcessedBytes{0}, mCryptoTime{0}, mEktMode{MS_EKT_DISABLED} {};
+};
+
+/**
+ * Accounts the time spent in the SRTP engine on a stream context, from its creation to the end of the enclosing scope.
+ * Must live under the lock of the context.
+ */
+class SrtpCryptoTimer {
+public:
+	SrtpCryptoTimer(MSSrtpStreamContext *ctx, int len) : mCtx{ctx}, mBegin{std::chrono::steady_clock::now()} {
+		mCtx->mProcessedPackets++;
+		mCtx->mProcessedBytes += (uint64_t)len;
+	}
+	~SrtpCryptoTimer() {
+		mCtx->mCryptoTime += std::chrono::steady_clock::now() - mBegin;
+	}
+
+private:
+	MSSrtpStreamContext *mCtx;
+	std::chrono::steady_clock::time_point mBegin;
 };
 
 class MSSrtpSendStreamContext : public MSSrtpStreamContext {
@@ -568,7 +597,6 @@ int ms_srtp_process_on_send(RtpTransportModifier *t, mblk_t *m) {
 
 	if (rtp_header && (slen > RTP_FIXED_HEADER_SIZE && rtp_header->version == 2)) {
 		size_t ekt_tag_size = 0;
-		std::vector<uint8_t> ekt_tag{};
 		std::lock_guard<std::recursive_mutex> lock(ctx->mMutex);
 		if (ctx->mStats.mSuite == MS_CRYPTO_SUITE_INVALID) { // No srtp is set up
 			if (ctx->mMandatoryEnabled) {
@@ -577,6 +605,9 @@ int ms_srtp_process_on_send(RtpTransportModifier *t, mblk_t *m) {
 				return slen; /* pass it uncrypted */
 			}
 		}
+		SrtpCryptoTimer timer(ctx, slen);
+		std::vector<uint8_t> &ekt_tag = ctx->mEktTagScratch;
+		ekt_tag.clear();
 
 		// EKT preparation (possible tag append at the end of encryption processing)
 		if (ctx->mEktMode == MS_EKT_ENABLED) {
@@ -634,33 +665,27 @@ int ms_srtp_process_on_send(RtpTransportModifier *t, mblk_t *m) {
 					ms_warning("srtp_protect inner encryption failed (unable to get payload) for stream ctx [%p]", ctx);
 					return -1;
 				}
-				/* create a synthetic packet, it holds:
-				 * RTP header + size of CSRC if any - No extensions
-				 * payload
-				 * reserve space for SRTP trailer */
-				size_t synthetic_header_size = RTP_FIXED_HEADER_SIZE + 4 * cc;
-				size_t synthetic_size = synthetic_header_size + (size_t)payload_size + SRTP_MAX_TRAILER_LEN + 4;
-				synthetic_size += 4 - synthetic_size % 4; /* make sure the memory is 32 bits aligned for srtp */
-				uint8_t *synthetic = (uint8_t *)ms_malloc0(synthetic_size);
-				memcpy(synthetic, m->b_rptr, synthetic_header_size);              /* copy header */
-				((rtp_header_t *)(synthetic))->extbit = 0;                        /* force the ext bit to 0 */
-				memcpy(synthetic + synthetic_header_size, payload, payload_size); /* append payload */
-
-				/* encrypt the synthetic packet */
-				int synthetic_len = (int)(synthetic_header_size + payload_size);
-				err = srtp_protect(ctx->mInnerSrtp, synthetic, &synthetic_len);
+				/* build the inner packet in place: RTP header + CSRC if any - no extensions - followed by the payload.
+				 * Save the original header and its extensions, move the header right in front of the payload (the
+				 * extensions size is a multiple of 4 so the packet stays 32 bits aligned), encrypt from there and put
+				 * the saved bytes back: the payload and the inner SRTP trailer never move */
+				size_t inner_header_size = RTP_FIXED_HEADER_SIZE + 4 * cc;
+				uint8_t *inner_packet = payload - inner_header_size;
+				ctx->mHeaderScratch.assign(m->b_rptr, payload);
+				memmove(inner_packet, m->b_rptr, inner_header_size);
+				((rtp_header_t *)(inner_packet))->extbit = 0; /* force the ext bit to 0 */
+
+				/* encrypt the inner packet */
+				int inner_len = (int)(inner_header_size + payload_size);
+				err = srtp_protect(ctx->mInnerSrtp, inner_packet, &inner_len);
+				memcpy(m->b_rptr, ctx->mHeaderScratch.data(), ctx->mHeaderScratch.size()); /* restore the header */
 				if (err != err_status_ok) {
 					ms_warning("srtp_protect inner encryption failed (%d) for stream ctx [%p]", err, ctx);
-					ms_free(synthetic);
 					return -1;
 				}
-
-				/* put it back in the original one */
-				memcpy(payload, synthetic + synthetic_header_size, synthetic_len - synthetic_header_size);
-				ms_free(synthetic);
-				slen += (int)(synthetic_len - synthetic_header_size -
-				              payload_size); /* slen is header + payload -> set it with new payload size: (synthetic_len
-				                                - synthetic_header_size) instead of the original payload_size  */
+				slen += (int)(inner_len - inner_header_size -
+				              payload_size); /* slen is header + payload -> set it with new payload size: (inner_len
+				                                - inner_header_size) instead of the original payload_size  */
 
 			} else { /* no extension header, we can directly proceed to inner encryption */
 				err = srtp_protect(ctx->mInnerSrtp, m->b_rptr, &slen);
@@ -802,8 +827,9 @@ int ms_srtp_process_on_receive(RtpTransportModifier *t, mblk_t *m) {
 	MSSrtpRecvStreamContext *ctx = (MSSrtpRecvStreamContext *)t->data;
 
 	/* Shall we check the EKT ? */
-	std::vector<uint8_t> ekt_tag{};
 	std::lock_guard<std::recursive_mutex> lock(ctx->mMutex);
+	std::vector<uint8_t> &ekt_tag = ctx->mEktTagScratch;
+	ekt_tag.clear();
 	if (ctx->mEktMode == MS_EKT_ENABLED) {
 		if (!ms_srtp_process_ekt_on_receive(t, m, &slen)) {
 			return 0; // Error during ekt tag processing, drop the packet
@@ -845,6 +871,7 @@ int ms_srtp_process_on_receive(RtpTransportModifier *t, mblk_t *m) {
 		}
 	}
 
+	SrtpCryptoTimer timer(ctx, slen);
 	if ((srtp_err = srtp_unprotect(ctx->mSrtp, m->b_rptr, &slen)) != err_status_ok) {
 		ms_warning("srtp_unprotect_rtp failed (%d) on stream ctx [%p]", srtp_err, ctx);
 		return -1;
@@ -891,35 +918,31 @@ int ms_srtp_process_on_receive(RtpTransportModifier *t, mblk_t *m) {
 			                                                    includes the outer encryption auth tag and OHB */
 			payload_size =
 			    slen - (RTP_FIXED_HEADER_SIZE + 4 * cc + extsize); /* slen is the size of header(with ext) + payload */
-			/* create a synthetic packet, it holds:
-			 * RTP header + size of CSRC if any - No extensions
-			 * payload (includes inner SRTP auth tag) */
-			size_t synthetic_header_size = RTP_FIXED_HEADER_SIZE + 4 * cc;
-			int synthetic_len = (int)synthetic_header_size + payload_size;
-			uint8_t *synthetic = (uint8_t *)ms_malloc0(synthetic_len);
-			memcpy(synthetic, m->b_rptr, synthetic_header_size); /* copy header */
-			((rtp_header_t *)(synthetic))->extbit = 0;           /* force the ext bit to 0 */
-			if (OHB_config & OHB_SEQNUM_BIT) {                   /* set back the original seqnum */
-				rtp_header_set_seqnumber((rtp_header_t *)synthetic, OHB_seqnum);
+			/* build the inner packet in place, as on the sending side: RTP header + CSRC if any - no extensions -
+			 * moved right in front of the payload (which includes the inner SRTP auth tag), the original header and
+			 * extensions are saved and restored after decryption */
+			size_t inner_header_size = RTP_FIXED_HEADER_SIZE + 4 * cc;
+			uint8_t *inner_packet = payload - inner_header_size;
+			int inner_len = (int)inner_header_size + payload_size;
+			ctx->mHeaderScratch.assign(m->b_rptr, payload);
+			memmove(inner_packet, m->b_rptr, inner_header_size);
+			((rtp_header_t *)(inner_packet))->extbit = 0; /* force the ext bit to 0 */
+			if (OHB_config & OHB_SEQNUM_BIT) {            /* set back the original seqnum */
+				rtp_header_set_seqnumber((rtp_header_t *)inner_packet, OHB_seqnum);
 			}
 			if (OHB_config & OHB_PAYLOAD_TYPE_BIT) { /* set back the original payload type */
-				((rtp_header_t *)(synthetic))->paytype = OHB_payload_type;
+				((rtp_header_t *)(inner_packet))->paytype = OHB_payload_type;
 			}
-			memcpy(synthetic + synthetic_header_size, payload, payload_size); /* append payload */
 
-			/* decrypt the synthetic packet */
-			srtp_err = srtp_unprotect(ctx->mInnerSrtp, synthetic, &synthetic_len);
+			/* decrypt the inner packet */
+			srtp_err = srtp_unprotect(ctx->mInnerSrtp, inner_packet, &inner_len);
+			memcpy(m->b_rptr, ctx->mHeaderScratch.data(), ctx->mHeaderScratch.size()); /* restore the header */
 			if (srtp_err != err_status_ok) {
 				ms_warning("srtp_unprotect_rtp inner encryption failed (%d) for stream ctx [%p]", srtp_err, ctx);
-				ms_free(synthetic);
 				return -1;
 			}
-
-			/* put it back in the original packet */
-			memcpy(payload, synthetic + synthetic_header_size, synthetic_len - synthetic_header_size);
-			ms_free(synthetic);
 			slen = (int)(RTP_FIXED_HEADER_SIZE + 4 * cc + extsize  /* original header size */
-			             + synthetic_len - synthetic_header_size); /* current payload size (after decrypt) */
+			             + inner_len - inner_header_size); /* current payload size (after decrypt) */
 		} else {
 			uint16_t outer_layer_seqnum = 0;
 			uint16_t outer_layer_payload_type = 0;
@@ -1593,6 +1616,32 @@ extern "C" MSCryptoSuite ms_media_stream_sessions_get_srtp_crypto_suite(const MS
 	return MS_CRYPTO_SUITE_INVALID;
 }
 
+namespace {
+void ms_srtp_add_crypto_stats(MSSrtpStreamContext *streamCtx, MSSrtpCryptoStats *stats) {
+	std::lock_guard<std::recursive_mutex> lock(streamCtx->mMutex);
+	stats->packets += streamCtx->mProcessedPackets;
+	stats->bytes += streamCtx->mProcessedBytes;
+	stats->crypto_time_us +=
+	    (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(streamCtx->mCryptoTime).count();
+}
+} // anonymous namespace
+
+extern "C" int ms_media_stream_sessions_get_srtp_crypto_stats(const MSMediaStreamSessions *sessions,
+                                                              MediaStreamDir dir,
+                                                              MSSrtpCryptoStats *stats) {
+	memset(stats, 0, sizeof(*stats));
+	if (sessions->srtp_context == NULL) {
+		return -1;
+	}
+	if (dir == MediaStreamSendRecv || dir == MediaStreamSendOnly) {
+		ms_srtp_add_crypto_stats(&sessions->srtp_context->mSend, stats);
+	}
+	if (dir == MediaStreamSendRecv || dir == MediaStreamRecvOnly) {
+		ms_srtp_add_crypto_stats(&sessions->srtp_context->mRecv, stats);
+	}
+	return 0;
+}
+
 extern "C" int ms_media_stream_sessions_set_srtp_recv_key_b64(MSMediaStreamSessions *sessions,
                                                               MSCryptoSuite suite,
                                                               const char *b64_key,
@@ -1841,6 +1890,13 @@ extern "C" MSCryptoSuite ms_media_stream_sessions_get_srtp_crypto_suite(const MS
 	return MS_CRYPTO_SUITE_INVALID;
 }
 
+extern "C" int ms_media_stream_sessions_get_srtp_crypto_stats(const MSMediaStreamSessions *sessions,
+                                                              MediaStreamDir dir,
+                                                              MSSrtpCryptoStats *stats) {
+	memset(stats, 0, sizeof(*stats));
+	return -1;
+}
+
 extern "C" void ms_srtp_context_delete(MSSrtpCtx *session) {
 	ms_error("Unable to delete srtp context [%p]: srtp support disabled in mediastreamer2", session);
 }
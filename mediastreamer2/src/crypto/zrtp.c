@@ -35,6 +35,18 @@
 #undef PACKAGE_VERSION
 #include <bzrtp/bzrtp.h>
 
+#include "mediastreamer2/msasync.h"
+
+/* The libbzrtp context is shared by the channels of all the streams of a call and is not thread safe: this holds it
+ * with the lock and the worker thread serializing the operations on it. */
+typedef struct _MSZrtpEngine {
+	bzrtpContext_t *zrtpContext; /**< the opaque zrtp context from libbzrtp */
+	ms_mutex_t mutex;            /**< lock any operation on the libbzrtp context */
+	MSFactory *factory;          /**< factory providing the worker thread */
+	MSWorkerThread *worker; /**< when set, incoming ZRTP packets and timer ticks are processed by this thread */
+	int refcount;           /**< number of MSZrtpContext sharing the engine, protected by mutex */
+} MSZrtpEngine;
+
 struct _MSZrtpContext {
 	MSMediaStreamSessions
 	    *stream_sessions; /**< a retro link to the stream session as we need it to configure srtp sessions */
@@ -43,6 +55,11 @@ struct _MSZrtpContext {
 	RtpTransportModifier
 	    *rtp_modifier;           /**< transport modifier needed to be able to inject the ZRTP packet for sending */
 	bzrtpContext_t *zrtpContext; /**< the opaque zrtp context from libbzrtp */
+	MSZrtpEngine *engine;        /**< the engine shared with the other channels of the libbzrtp context */
+	queue_t outgoing;            /**< ZRTP packets produced by the engine, waiting to be sent by the ticker thread */
+	ms_mutex_t queue_mutex;      /**< lock the outgoing queue and the iterate_pending flag only */
+	bool_t iterate_pending;      /**< a timer tick is queued on the worker thread */
+	bool_t stopped; /**< set before destruction, so that packets still queued on the worker are dropped */
 	/* cache related data */
 	void *cacheDB;               /**< pointer to an already open sqlite db holding the zid cache */
 	bctbx_mutex_t *cacheDBMutex; /**< pointer to a mutex used to lock cache access */
@@ -162,23 +179,21 @@ static int ms_zrtp_statusMessage(void *clientData,
  */
 static int32_t ms_zrtp_sendDataZRTP(void *clientData, const uint8_t *data, uint16_t length) {
 	MSZrtpContext *userData = (MSZrtpContext *)clientData;
-	RtpSession *session = userData->stream_sessions->rtp_session;
-	RtpTransport *rtpt = NULL;
 	mblk_t *msg;
 
 	char packetInfo[PACKET_INFO_MAX_SIZE];
 	ms_zrtp_getPacketInfo(data, packetInfo);
-	ms_message("ZRTP Send %s of size %d on rtp session [%p]", packetInfo, length, session);
-
-	/* get RTP transport from session */
-	rtp_session_get_transports(session, &rtpt, NULL);
+	ms_message("ZRTP Send %s of size %d on rtp session [%p]", packetInfo, length,
+	           userData->stream_sessions->rtp_session);
 
 	/* generate message from raw data */
 	msg = rtp_create_packet(data, length);
 
-	meta_rtp_transport_modifier_inject_packet_to_send(rtpt, userData->rtp_modifier, msg, 0);
-
-	freemsg(msg);
+	/* The engine runs on the worker thread or on the application thread, while the RTP session is used by the ticker
+	 * thread: ms_zrtp_rtp_on_schedule() sends the packet at the next tick. */
+	ms_mutex_lock(&userData->queue_mutex);
+	putq(&userData->outgoing, msg);
+	ms_mutex_unlock(&userData->queue_mutex);
 
 	return 0;
 }
@@ -487,18 +502,104 @@ static int ms_zrtp_rtcp_process_on_send(BCTBX_UNUSED(RtpTransportModifier *t), m
 	return (int)msgdsize(msg);
 }
 
+/* prerequisite: the engine mutex is held */
+static void ms_zrtp_process_packet(MSZrtpContext *userData, mblk_t *msg) {
+	bzrtpContext_t *zrtpContext = userData->zrtpContext;
+	RtpSession *session = userData->stream_sessions->rtp_session;
+	uint8_t *rtp = msg->b_rptr;
+	int msgLength = (int)msgdsize(msg);
+
+	// display received message
+	char packetInfo[PACKET_INFO_MAX_SIZE];
+	ms_zrtp_getPacketInfo(rtp, packetInfo);
+	ms_message("ZRTP Receive %s of size %d on rtp session [%p]", packetInfo, msgLength, session);
+
+	// check if the ZRTP channel is started, if not(ZRTP not set on our side but incoming zrtp packets), start it
+	if (userData->autoStart && bzrtp_getChannelStatus(zrtpContext, userData->self_ssrc) == BZRTP_CHANNEL_INITIALISED) {
+		ms_message("ZRTP autostart channel on rtp session [%p]", session);
+		bzrtp_startChannelEngine(zrtpContext, userData->self_ssrc);
+	}
+
+	// send ZRTP packet to engine
+	int ret = bzrtp_processMessage(zrtpContext, userData->self_ssrc, rtp, msgLength);
+	if (ret != 0) {
+		ms_message("ZRTP packet %s processing returns %04x on rtp session [%p]", packetInfo, ret, session);
+	}
+}
+
+typedef struct _MSZrtpTask {
+	MSZrtpContext *ctx;
+	mblk_t *msg; /**< the ZRTP packet to process, NULL for a timer tick */
+} MSZrtpTask;
+
+static bool_t ms_zrtp_process_task(void *data) {
+	MSZrtpTask *task = (MSZrtpTask *)data;
+	MSZrtpContext *userData = task->ctx;
+
+	if (task->msg == NULL) {
+		ms_mutex_lock(&userData->queue_mutex);
+		userData->iterate_pending = FALSE;
+		ms_mutex_unlock(&userData->queue_mutex);
+	}
+	ms_mutex_lock(&userData->engine->mutex);
+	if (!userData->stopped) {
+		if (task->msg != NULL) {
+			ms_zrtp_process_packet(userData, task->msg);
+		} else {
+			bzrtp_iterate(userData->zrtpContext, userData->self_ssrc, bctbx_get_cur_time_ms());
+		}
+	}
+	ms_mutex_unlock(&userData->engine->mutex);
+	if (task->msg != NULL) freemsg(task->msg);
+	ms_free(task);
+	return TRUE;
+}
+
+static void ms_zrtp_queue_task(MSZrtpContext *userData, mblk_t *msg) {
+	MSZrtpTask *task = ms_new0(MSZrtpTask, 1);
+	task->ctx = userData;
+	task->msg = msg;
+	ms_worker_thread_add_task(userData->engine->worker, ms_zrtp_process_task, task);
+}
+
+static bool_t ms_zrtp_barrier_task(BCTBX_UNUSED(void *data)) {
+	return TRUE;
+}
+
 static void ms_zrtp_rtp_on_schedule(RtpTransportModifier *t) {
 	MSZrtpContext *userData = (MSZrtpContext *)t->data;
-	bzrtpContext_t *zrtpContext = userData->zrtpContext;
+	MSZrtpEngine *engine = userData->engine;
+	mblk_t *msg;
+
 	// send a timer tick to the zrtp engine
-	bzrtp_iterate(zrtpContext, userData->self_ssrc, bctbx_get_cur_time_ms());
+	if (engine->worker != NULL) {
+		/* the ticker thread must not wait for a packet processed by the worker thread: queue the tick behind it,
+		 * unless the previous one is still waiting */
+		bool_t queue_tick;
+		ms_mutex_lock(&userData->queue_mutex);
+		queue_tick = !userData->iterate_pending;
+		userData->iterate_pending = TRUE;
+		ms_mutex_unlock(&userData->queue_mutex);
+		if (queue_tick) ms_zrtp_queue_task(userData, NULL);
+	} else {
+		ms_mutex_lock(&engine->mutex);
+		bzrtp_iterate(userData->zrtpContext, userData->self_ssrc, bctbx_get_cur_time_ms());
+		ms_mutex_unlock(&engine->mutex);
+	}
+
+	/* send the packets produced by the engine since the last tick */
+	ms_mutex_lock(&userData->queue_mutex);
+	while ((msg = getq(&userData->outgoing)) != NULL) {
+		meta_rtp_transport_modifier_inject_packet_to_send(t->transport, t, msg, 0);
+		freemsg(msg);
+	}
+	ms_mutex_unlock(&userData->queue_mutex);
 }
 
 static int ms_zrtp_rtp_process_on_receive(RtpTransportModifier *t, mblk_t *msg) {
 	uint32_t *magicField;
 
 	MSZrtpContext *userData = (MSZrtpContext *)t->data;
-	bzrtpContext_t *zrtpContext = userData->zrtpContext;
 	uint8_t *rtp;
 	int rtpVersion;
 	int msgLength = (int)msgdsize(msg);
@@ -517,21 +618,14 @@ static int ms_zrtp_rtp_process_on_receive(RtpTransportModifier *t, mblk_t *msg)
 		return msgLength;
 	}
 
-	// display received message
-	char packetInfo[PACKET_INFO_MAX_SIZE];
-	ms_zrtp_getPacketInfo(rtp, packetInfo);
-	ms_message("ZRTP Receive %s of size %d on rtp session [%p]", packetInfo, msgLength, t->session);
-
-	// check if the ZRTP channel is started, if not(ZRTP not set on our side but incoming zrtp packets), start it
-	if (userData->autoStart && bzrtp_getChannelStatus(zrtpContext, userData->self_ssrc) == BZRTP_CHANNEL_INITIALISED) {
-		ms_message("ZRTP autostart channel on rtp session [%p]", t->session);
-		bzrtp_startChannelEngine(zrtpContext, userData->self_ssrc);
-	}
-
-	// send ZRTP packet to engine
-	int ret = bzrtp_processMessage(zrtpContext, userData->self_ssrc, rtp, msgLength);
-	if (ret != 0) {
-		ms_message("ZRTP packet %s processing returns %04x on rtp session [%p]", packetInfo, ret, t->session);
+	if (userData->engine->worker != NULL) {
+		/* Key agreement and key derivation are done by the worker thread, so that they do not delay the media of the
+		 * other streams sharing the receiving thread. */
+		ms_zrtp_queue_task(userData, copymsg(msg));
+	} else {
+		ms_mutex_lock(&userData->engine->mutex);
+		ms_zrtp_process_packet(userData, msg);
+		ms_mutex_unlock(&userData->engine->mutex);
 	}
 	return 0;
 }
@@ -802,10 +896,23 @@ static void set_sas_suites(bzrtpContext_t *ctx, const MSZrtpSasType *sasTypes, c
 /* header declared in voip/private.h */
 void ms_zrtp_set_stream_sessions(MSZrtpContext *zrtp_context, MSMediaStreamSessions *stream_sessions) {
 	if (zrtp_context != NULL) {
+		ms_mutex_lock(&zrtp_context->engine->mutex);
 		zrtp_context->stream_sessions = stream_sessions;
+		ms_mutex_unlock(&zrtp_context->engine->mutex);
 	}
 }
 
+static MSZrtpContext *ms_zrtp_context_alloc(MSMediaStreamSessions *sessions, MSZrtpEngine *engine) {
+	MSZrtpContext *userData = ms_new0(MSZrtpContext, 1);
+	userData->zrtpContext = engine->zrtpContext;
+	userData->engine = engine;
+	userData->stream_sessions = sessions;
+	userData->self_ssrc = sessions->rtp_session->snd.ssrc;
+	qinit(&userData->outgoing);
+	ms_mutex_init(&userData->queue_mutex, NULL);
+	return userData;
+}
+
 /**** Public functions ****/
 /* header declared in include/mediastreamer2/zrtp.h */
 bool_t ms_zrtp_available(void) {
@@ -814,6 +921,7 @@ bool_t ms_zrtp_available(void) {
 
 MSZrtpContext *ms_zrtp_context_new(MSMediaStreamSessions *sessions, MSZrtpParams *params) {
 	MSZrtpContext *userData;
+	MSZrtpEngine *engine;
 	bzrtpContext_t *context;
 	bzrtpCallbacks_t cbs = {0};
 
@@ -853,11 +961,17 @@ MSZrtpContext *ms_zrtp_context_new(MSMediaStreamSessions *sessions, MSZrtpParams
 	bzrtp_initBzrtpContext(
 	    context, sessions->rtp_session->snd.ssrc); /* init is performed only when creating the main channel context */
 
+	engine = ms_new0(MSZrtpEngine, 1);
+	engine->zrtpContext = context;
+	ms_mutex_init(&engine->mutex, NULL);
+	engine->refcount = 1;
+	if (params->factory != NULL) {
+		engine->factory = params->factory;
+		engine->worker = ms_factory_acquire_crypto_worker(params->factory);
+	}
+
 	/* create and link main channel user data */
-	userData = ms_new0(MSZrtpContext, 1);
-	userData->zrtpContext = context;
-	userData->stream_sessions = sessions;
-	userData->self_ssrc = sessions->rtp_session->snd.ssrc;
+	userData = ms_zrtp_context_alloc(sessions, engine);
 
 	userData->cacheDB =
 	    params->zidCacheDB; /* add a link to the ZidCache and mutex to be able to access it from callbacks */
@@ -872,31 +986,39 @@ MSZrtpContext *ms_zrtp_context_new(MSMediaStreamSessions *sessions, MSZrtpParams
 MSZrtpContext *ms_zrtp_multistream_new(MSMediaStreamSessions *sessions, MSZrtpContext *activeContext) {
 	int retval;
 	MSZrtpContext *userData;
-	if ((retval = bzrtp_addChannel(activeContext->zrtpContext, sessions->rtp_session->snd.ssrc)) != 0) {
+	MSZrtpEngine *engine = activeContext->engine;
+
+	ms_mutex_lock(&engine->mutex);
+	if ((retval = bzrtp_addChannel(engine->zrtpContext, sessions->rtp_session->snd.ssrc)) != 0) {
+		ms_mutex_unlock(&engine->mutex);
 		ms_error("ZRTP could't add stream, returns %x", retval);
 		return NULL;
 	}
 
 	ms_message("Initializing multistream ZRTP context on rtp session [%p] ssrc 0x%x", sessions->rtp_session,
 	           sessions->rtp_session->snd.ssrc);
-	userData = ms_new0(MSZrtpContext, 1);
-	userData->zrtpContext = activeContext->zrtpContext;
-	userData->stream_sessions = sessions;
-	userData->self_ssrc = sessions->rtp_session->snd.ssrc;
+	userData = ms_zrtp_context_alloc(sessions, engine);
+	engine->refcount++;
 	/* no cache related information here as it is not needed for multistream channel */
-	bzrtp_setClientData(activeContext->zrtpContext, sessions->rtp_session->snd.ssrc, (void *)userData);
+	bzrtp_setClientData(engine->zrtpContext, sessions->rtp_session->snd.ssrc, (void *)userData);
+	ms_mutex_unlock(&engine->mutex);
 
 	return ms_zrtp_configure_context(userData, sessions->rtp_session);
 }
 
 void ms_zrtp_enable_go_clear(MSZrtpContext *ctx, bool_t enable) {
+	ms_mutex_lock(&ctx->engine->mutex);
 	bzrtp_setFlags(ctx->zrtpContext, BZRTP_SELF_ACCEPT_GOCLEAR, enable);
+	ms_mutex_unlock(&ctx->engine->mutex);
 }
 
 int ms_zrtp_channel_start(MSZrtpContext *ctx) {
 	int retval;
 	ms_message("Starting ZRTP engine on rtp session [%p] ssrc 0x%x", ctx->stream_sessions->rtp_session, ctx->self_ssrc);
-	if ((retval = bzrtp_startChannelEngine(ctx->zrtpContext, ctx->self_ssrc)) != 0) {
+	ms_mutex_lock(&ctx->engine->mutex);
+	retval = bzrtp_startChannelEngine(ctx->zrtpContext, ctx->self_ssrc);
+	ms_mutex_unlock(&ctx->engine->mutex);
+	if (retval != 0) {
 		/* remap some error code */
 		if (retval == BZRTP_ERROR_CHANNELALREADYSTARTED) {
 			ms_message("ZRTP channel already started");
@@ -918,21 +1040,50 @@ int ms_zrtp_channel_start(MSZrtpContext *ctx) {
 }
 
 void ms_zrtp_context_destroy(MSZrtpContext *ctx) {
+	MSZrtpEngine *engine = ctx->engine;
+	bool_t last;
+
 	ms_message("Stopping ZRTP context on session [%p]",
 	           ctx->stream_sessions ? ctx->stream_sessions->rtp_session : NULL);
+	ms_mutex_lock(&engine->mutex);
+	ctx->stopped = TRUE;
 	if (ctx->zrtpContext) {
 		bzrtp_destroyBzrtpContext(ctx->zrtpContext, ctx->self_ssrc);
 	}
+	last = (--engine->refcount == 0);
+	ms_mutex_unlock(&engine->mutex);
+
+	if (engine->worker != NULL) {
+		if (last) {
+			/* returns once the packets still queued are dropped */
+			ms_factory_release_crypto_worker(engine->factory, engine->worker);
+		} else {
+			/* the other streams keep the worker: wait until the packets of this one still queued are dropped */
+			MSTask *barrier = ms_worker_thread_add_waitable_task(engine->worker, ms_zrtp_barrier_task, NULL);
+			ms_task_wait_completion(barrier);
+			ms_task_destroy(barrier);
+		}
+	}
+	if (last) {
+		ms_mutex_destroy(&engine->mutex);
+		ms_free(engine);
+	}
+	flushq(&ctx->outgoing, 0);
+	ms_mutex_destroy(&ctx->queue_mutex);
 	ms_free(ctx);
 	ms_message("ZRTP context destroyed");
 }
 
 void ms_zrtp_reset_transmition_timer(MSZrtpContext *ctx) {
+	ms_mutex_lock(&ctx->engine->mutex);
 	bzrtp_resetRetransmissionTimer(ctx->zrtpContext, ctx->self_ssrc);
+	ms_mutex_unlock(&ctx->engine->mutex);
 }
 
 void ms_zrtp_sas_verified(MSZrtpContext *ctx) {
+	ms_mutex_lock(&ctx->engine->mutex);
 	bzrtp_SASVerified(ctx->zrtpContext);
+	ms_mutex_unlock(&ctx->engine->mutex);
 	if (ms_media_stream_sessions_get_encryption_status(ctx->stream_sessions, MediaStreamSendRecv) ==
 	    MSMediaEncryptionStatusZrtpSASCheckRequested) {
 		ms_media_stream_sessions_set_encryption_status(ctx->stream_sessions, MediaStreamSendRecv,
@@ -941,11 +1092,17 @@ void ms_zrtp_sas_verified(MSZrtpContext *ctx) {
 }
 
 uint8_t ms_zrtp_getAuxiliarySharedSecretMismatch(MSZrtpContext *ctx) {
-	return bzrtp_getAuxiliarySharedSecretMismatch(ctx->zrtpContext);
+	uint8_t ret;
+	ms_mutex_lock(&ctx->engine->mutex);
+	ret = bzrtp_getAuxiliarySharedSecretMismatch(ctx->zrtpContext);
+	ms_mutex_unlock(&ctx->engine->mutex);
+	return ret;
 }
 
 void ms_zrtp_sas_reset_verified(MSZrtpContext *ctx) {
+	ms_mutex_lock(&ctx->engine->mutex);
 	bzrtp_resetSASVerified(ctx->zrtpContext);
+	ms_mutex_unlock(&ctx->engine->mutex);
 	if (ms_media_stream_sessions_get_encryption_status(ctx->stream_sessions, MediaStreamSendRecv) ==
 	    MSMediaEncryptionStatusActive) {
 		ms_media_stream_sessions_set_encryption_status(ctx->stream_sessions, MediaStreamSendRecv,
@@ -968,16 +1125,28 @@ MSZrtpPeerStatus ms_zrtp_get_peer_status(void *db, const char *peerUri, bctbx_mu
 }
 
 int ms_zrtp_getHelloHash(MSZrtpContext *ctx, uint8_t *output, size_t outputLength) {
-	return bzrtp_getSelfHelloHash(ctx->zrtpContext, ctx->self_ssrc, output, outputLength);
+	int ret;
+	ms_mutex_lock(&ctx->engine->mutex);
+	ret = bzrtp_getSelfHelloHash(ctx->zrtpContext, ctx->self_ssrc, output, outputLength);
+	ms_mutex_unlock(&ctx->engine->mutex);
+	return ret;
 }
 
 int ms_zrtp_setAuxiliarySharedSecret(MSZrtpContext *ctx, const uint8_t *auxSharedSecret, size_t auxSharedSecretLength) {
-	return bzrtp_setAuxiliarySharedSecret(ctx->zrtpContext, auxSharedSecret, auxSharedSecretLength);
+	int ret;
+	ms_mutex_lock(&ctx->engine->mutex);
+	ret = bzrtp_setAuxiliarySharedSecret(ctx->zrtpContext, auxSharedSecret, auxSharedSecretLength);
+	ms_mutex_unlock(&ctx->engine->mutex);
+	return ret;
 }
 
 int ms_zrtp_setPeerHelloHash(MSZrtpContext *ctx, uint8_t *peerHelloHashHexString, size_t peerHelloHashHexStringLength) {
-	return bzrtp_setPeerHelloHash(ctx->zrtpContext, ctx->self_ssrc, peerHelloHashHexString,
-	                              peerHelloHashHexStringLength);
+	int ret;
+	ms_mutex_lock(&ctx->engine->mutex);
+	ret = bzrtp_setPeerHelloHash(ctx->zrtpContext, ctx->self_ssrc, peerHelloHashHexString,
+	                             peerHelloHashHexStringLength);
+	ms_mutex_unlock(&ctx->engine->mutex);
+	return ret;
 }
 
 /**
@@ -1102,17 +1271,33 @@ bool_t ms_zrtp_is_PQ_available(void) {
 	return bzrtp_is_PQ_available();
 }
 
+void ms_zrtp_set_key_agreement_pool_size(uint8_t size) {
+	bzrtp_setKeyAgreementPoolSize(size);
+}
+
 // #ifdef HAVE_GOCLEAR
 int ms_zrtp_send_go_clear(MSZrtpContext *ctx) {
-	return bzrtp_sendGoClear(ctx->zrtpContext, ctx->self_ssrc);
+	int ret;
+	ms_mutex_lock(&ctx->engine->mutex);
+	ret = bzrtp_sendGoClear(ctx->zrtpContext, ctx->self_ssrc);
+	ms_mutex_unlock(&ctx->engine->mutex);
+	return ret;
 }
 
 int ms_zrtp_confirm_go_clear(MSZrtpContext *ctx) {
-	return bzrtp_confirmGoClear(ctx->zrtpContext, ctx->self_ssrc);
+	int ret;
+	ms_mutex_lock(&ctx->engine->mutex);
+	ret = bzrtp_confirmGoClear(ctx->zrtpContext, ctx->self_ssrc);
+	ms_mutex_unlock(&ctx->engine->mutex);
+	return ret;
 }
 
 int ms_zrtp_back_to_secure_mode(MSZrtpContext *ctx) {
-	return bzrtp_backToSecureMode(ctx->zrtpContext, ctx->self_ssrc);
+	int ret;
+	ms_mutex_lock(&ctx->engine->mutex);
+	ret = bzrtp_backToSecureMode(ctx->zrtpContext, ctx->self_ssrc);
+	ms_mutex_unlock(&ctx->engine->mutex);
+	return ret;
 }
 // #endif /* HAVE_GOCLEAR */
 
@@ -1190,6 +1375,8 @@ uint8_t ms_zrtp_available_key_agreement(MSZrtpKeyAgreement algos[256]) {
 bool_t ms_zrtp_is_PQ_available(void) {
 	return FALSE;
 }
+void ms_zrtp_set_key_agreement_pool_size(uint8_t size) {
+}
 int ms_zrtp_send_go_clear(MSZrtpContext *ctx) {
 	return 0;
 }
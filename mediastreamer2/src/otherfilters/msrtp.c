@@ -73,6 +73,7 @@ struct SenderData {
 	MSRtpSendRequestClientToMixerDataCb ctm_request_data_cb;
 	void *ctm_request_data_user_data;
 	int frame_marking_extension_id;
+	uint8_t tl0picidx; /* index of the last base layer frame sent, for the scalable form of the frame marking */
 	bool_t frame_start;
 	bool_t rtp_transfer_mode;
 	bool_t voice_activity;
@@ -607,7 +608,16 @@ static void add_frame_marking_extension(SenderData *d, mblk_t *header, mblk_t *i
 	if (mblk_get_independent_flag(im)) marker |= RTP_FRAME_MARKER_INDEPENDENT;
 	if (mblk_get_discardable_flag(im)) marker |= RTP_FRAME_MARKER_DISCARDABLE;
 
-	rtp_add_frame_marker(header, d->frame_marking_extension_id, marker);
+	if (mblk_get_scalable_flag(im)) {
+		/* The layer information only exists in the scalable form of the extension. */
+		uint8_t tid = (uint8_t)mblk_get_temporal_layer_id(im);
+		if (mblk_get_base_layer_sync_flag(im)) marker |= RTP_FRAME_MARKER_BASE_LAYER_SYNC;
+		marker |= tid & RTP_FRAME_MARKER_TID_MASK;
+		if ((marker & RTP_FRAME_MARKER_START) && tid == 0) d->tl0picidx++;
+		rtp_add_scalable_frame_marker(header, d->frame_marking_extension_id, marker, 0, d->tl0picidx);
+	} else {
+		rtp_add_frame_marker(header, d->frame_marking_extension_id, marker);
+	}
 }
 
 static void sender_add_extensions(SenderData *d, mblk_t *header, mblk_t *im) {
@@ -1026,9 +1036,15 @@ static void receiver_check_for_extensions(MSFilter *f, mblk_t *m) {
 	if (d->frame_marking_extension_id > 0) {
 		uint8_t marker;
 
-		if (rtp_get_frame_marker(m, d->frame_marking_extension_id, &marker)) {
+		bool_t scalable = rtp_get_scalable_frame_marker(m, d->frame_marking_extension_id, &marker, NULL, NULL);
+
+		if (scalable || rtp_get_frame_marker(m, d->frame_marking_extension_id, &marker)) {
 			mblk_set_independent_flag(m, (marker & RTP_FRAME_MARKER_INDEPENDENT));
 			mblk_set_discardable_flag(m, (marker & RTP_FRAME_MARKER_DISCARDABLE));
+			/* Without the scalable form, the stream only has a base layer. */
+			mblk_set_scalable_flag(m, scalable);
+			mblk_set_base_layer_sync_flag(m, (scalable && (marker & RTP_FRAME_MARKER_BASE_LAYER_SYNC)));
+			mblk_set_temporal_layer_id(m, scalable ? (marker & RTP_FRAME_MARKER_TID_MASK) : 0);
 		}
 	}
 }
@@ -81,3 +81,92 @@ void av_frame_unref(AVFrame *frame) {
 	avcodec_get_frame_defaults(frame);
 }
 #endif
+
+#ifdef HAVE_FFMPEG_DIRECT_RENDERING
+
+/* decoded pictures are kept as reference frames by the decoder while they are in use downstream */
+#define MS_FFMPEG_DR_MAX_FRAMES 32
+#define MS_FFMPEG_DR_ALIGN 64
+#define MS_FFMPEG_DR_MB_SIZE 16
+
+static void release_yuvmsg(void *opaque, uint8_t *data) {
+	(void)data;
+	freemsg((mblk_t *)opaque);
+}
+
+static int get_yuvmsg_buffer(AVCodecContext *ctx, AVFrame *frame, int flags) {
+	MSYuvBufAllocator *allocator = (MSYuvBufAllocator *)ctx->opaque;
+	int linesize_align[AV_NUM_DATA_POINTERS];
+	int w = frame->width, h = frame->height;
+	int ysize = 0, size = 0;
+	mblk_t *m = NULL;
+
+	/* the planes of a yuv mblk_t are packed: the decoders write whole macroblocks, so that the last row of macroblocks
+	 * of a picture whose height is not a multiple of theirs would overwrite the top of the next plane */
+	if (frame->format == AV_PIX_FMT_YUV420P && (w & 1) == 0 && (h % MS_FFMPEG_DR_MB_SIZE) == 0 &&
+	    (ctx->codec->capabilities & AV_CODEC_CAP_DR1)) {
+		avcodec_align_dimensions2(ctx, &w, &h, linesize_align);
+		/* the rows of a yuv mblk_t are packed: the decoder must not need any room on the right of the picture */
+		if (w == frame->width && (w % linesize_align[0]) == 0 && ((w / 2) % linesize_align[1]) == 0 &&
+		    ((w / 2) % linesize_align[2]) == 0) {
+			ysize = w * frame->height;
+			size = (ysize * 3) / 2;
+			/* beyond the macroblocks, the decoder only reads up to the aligned height, and a bit further with simd: keep
+			 * this readable */
+			m = ms_yuv_allocator_get(allocator, size + (h - frame->height) * w + 2 * MS_FFMPEG_DR_ALIGN + 16,
+			                         frame->width, frame->height);
+		}
+	}
+	if (m == NULL) return avcodec_default_get_buffer2(ctx, frame, flags);
+
+	m->b_rptr = (uint8_t *)(((intptr_t)m->b_rptr + MS_FFMPEG_DR_ALIGN - 1) & ~(intptr_t)(MS_FFMPEG_DR_ALIGN - 1));
+	m->b_wptr = m->b_rptr + size;
+	frame->buf[0] = av_buffer_create(m->b_rptr, size, release_yuvmsg, m, 0);
+	if (frame->buf[0] == NULL) {
+		freemsg(m);
+		return AVERROR(ENOMEM);
+	}
+	frame->data[0] = m->b_rptr;
+	frame->data[1] = frame->data[0] + ysize;
+	frame->data[2] = frame->data[1] + ysize / 4;
+	frame->linesize[0] = frame->width;
+	frame->linesize[1] = frame->linesize[2] = frame->width / 2;
+	frame->extended_data = frame->data;
+	return 0;
+}
+
+void ms_ffmpeg_enable_direct_rendering(AVCodecContext *ctx, MSYuvBufAllocator *allocator) {
+	ms_yuv_buf_allocator_set_max_frames(allocator, MS_FFMPEG_DR_MAX_FRAMES);
+	ctx->opaque = allocator;
+	ctx->get_buffer2 = get_yuvmsg_buffer;
+#if LIBAVCODEC_VERSION_MAJOR < 59
+	/* keep the references on the buffers in the frames returned by avcodec_decode_video2() */
+	ctx->refcounted_frames = 1;
+#endif
+}
+
+mblk_t *ms_ffmpeg_frame_to_yuvmsg(AVCodecContext *ctx, const AVFrame *frame) {
+	MSYuvBufAllocator *allocator = (MSYuvBufAllocator *)ctx->opaque;
+	mblk_t *m;
+
+	if (ctx->get_buffer2 != get_yuvmsg_buffer || frame->buf[0] == NULL || frame->buf[1] != NULL) return NULL;
+	for (m = qbegin(&allocator->q); !qend(&allocator->q, m); m = qnext(&allocator->q, m)) {
+		/* only the buffers given by get_yuvmsg_buffer() point into the allocator's blocks */
+		if (frame->buf[0]->data >= dblk_base(m->b_datap) && frame->buf[0]->data < dblk_lim(m->b_datap)) {
+			mblk_t *yuv_msg = (mblk_t *)av_buffer_get_opaque(frame->buf[0]);
+			YuvBuf pic;
+			int i;
+
+			/* the decoder may have cropped the picture */
+			ms_yuv_buf_init_from_mblk(&pic, yuv_msg);
+			if (pic.w != frame->width || pic.h != frame->height) return NULL;
+			for (i = 0; i < 3; i++) {
+				if (pic.planes[i] != frame->data[i] || pic.strides[i] != frame->linesize[i]) return NULL;
+			}
+			return dupb(yuv_msg);
+		}
+	}
+	return NULL;
+}
+
+#endif
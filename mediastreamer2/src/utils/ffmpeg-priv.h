@@ -42,6 +42,8 @@
 
 #include <ortp/port.h>
 
+#include "mediastreamer2/msvideo.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -162,6 +164,21 @@ void av_frame_unref(AVFrame *frame);
  *jehan: previous version (55.39.100 at least) might be buggy */
 #endif
 
+#if LIBAVCODEC_VERSION_MAJOR >= 57
+#define HAVE_FFMPEG_DIRECT_RENDERING 1
+/*
+ * Make the decoder write its YUV420P pictures straight into mblk_t taken from the allocator, so that they can be
+ * handed over with ms_ffmpeg_frame_to_yuvmsg() instead of being copied. Must be called before avcodec_open2().
+ */
+void ms_ffmpeg_enable_direct_rendering(AVCodecContext *ctx, MSYuvBufAllocator *allocator);
+/*
+ * Get a reference on the mblk_t a decoded frame was written into. The picture stays shared with the decoder, which
+ * may still use it as a reference frame. Returns NULL if the frame did not come from direct rendering or if its
+ * planes are not laid out as ms_yuv_buf_init_from_mblk() expects, in which case the frame must be copied.
+ */
+mblk_t *ms_ffmpeg_frame_to_yuvmsg(AVCodecContext *ctx, const AVFrame *frame);
+#endif
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -23,12 +23,24 @@
 
 #include "goertzel_state.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define MS_GOERTZEL_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MS_GOERTZEL_NEON
+#endif
+
 static const double PI = std::acos(-1);
 
 namespace mediastreamer {
 
+static float computeCoef(int frequency, int samplingFrequency) {
+	return (float)2.0f * (float)std::cos(2 * PI * ((float)frequency / (float)samplingFrequency));
+}
+
 void GoertzelState::init(int frequency, int samplingFrequency) {
-	mCoef = (float)2.0f * (float)std::cos(2 * PI * ((float)frequency / (float)samplingFrequency));
+	mCoef = computeCoef(frequency, samplingFrequency);
 	mStartTime = 0;
 	mDuration = 0;
 }
@@ -51,4 +63,89 @@ float GoertzelState::run(int16_t *samples, int nbSamples, float totalEnergy) {
 	return frequencyEnergy / (totalEnergy * (float)nbSamples * 0.5f);
 }
 
-} // namespace mediastreamer
\ No newline at end of file
+void GoertzelFilterBank::setFrequency(int index, int frequency, int samplingFrequency) {
+	if (index < 0 || index >= MaxFrequencies) return;
+	mCoefs[index] = computeCoef(frequency, samplingFrequency);
+	if (index >= mSize) mSize = index + 1;
+}
+
+void GoertzelFilterBank::clear() {
+	for (float &coef : mCoefs)
+		coef = 0;
+	mSize = 0;
+}
+
+/*
+ * Each group of 8 frequencies is run as two independent vectors of 4 lanes so that the latency of one recurrence
+ * is hidden by the other one. Unused lanes have a null coefficient and their result is ignored. The operations are
+ * done in the same order as in GoertzelState::run() (no fused multiply-add) so that the results are identical.
+ */
+void GoertzelFilterBank::run(const int16_t *samples, int nbSamples, float totalEnergy, float *energies) const {
+	alignas(16) float q1[MaxFrequencies];
+	alignas(16) float q2[MaxFrequencies];
+
+	for (int base = 0; base < mSize; base += 8) {
+#if defined(MS_GOERTZEL_SSE)
+		const __m128 coefA = _mm_loadu_ps(&mCoefs[base]);
+		const __m128 coefB = _mm_loadu_ps(&mCoefs[base + 4]);
+		__m128 q1A = _mm_setzero_ps(), q2A = _mm_setzero_ps();
+		__m128 q1B = _mm_setzero_ps(), q2B = _mm_setzero_ps();
+
+		for (int i = 0; i < nbSamples; ++i) {
+			const __m128 x = _mm_set1_ps((float)samples[i]);
+			const __m128 tmpA = q1A;
+			const __m128 tmpB = q1B;
+			q1A = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(coefA, q1A), q2A), x);
+			q1B = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(coefB, q1B), q2B), x);
+			q2A = tmpA;
+			q2B = tmpB;
+		}
+		_mm_store_ps(&q1[base], q1A);
+		_mm_store_ps(&q1[base + 4], q1B);
+		_mm_store_ps(&q2[base], q2A);
+		_mm_store_ps(&q2[base + 4], q2B);
+#elif defined(MS_GOERTZEL_NEON)
+		const float32x4_t coefA = vld1q_f32(&mCoefs[base]);
+		const float32x4_t coefB = vld1q_f32(&mCoefs[base + 4]);
+		float32x4_t q1A = vdupq_n_f32(0), q2A = vdupq_n_f32(0);
+		float32x4_t q1B = vdupq_n_f32(0), q2B = vdupq_n_f32(0);
+
+		for (int i = 0; i < nbSamples; ++i) {
+			const float32x4_t x = vdupq_n_f32((float)samples[i]);
+			const float32x4_t tmpA = q1A;
+			const float32x4_t tmpB = q1B;
+			q1A = vaddq_f32(vsubq_f32(vmulq_f32(coefA, q1A), q2A), x);
+			q1B = vaddq_f32(vsubq_f32(vmulq_f32(coefB, q1B), q2B), x);
+			q2A = tmpA;
+			q2B = tmpB;
+		}
+		vst1q_f32(&q1[base], q1A);
+		vst1q_f32(&q1[base + 4], q1B);
+		vst1q_f32(&q2[base], q2A);
+		vst1q_f32(&q2[base + 4], q2B);
+#else
+		float lq1[8] = {0}, lq2[8] = {0};
+
+		for (int i = 0; i < nbSamples; ++i) {
+			const float x = (float)samples[i];
+			for (int j = 0; j < 8; ++j) {
+				const float tmp = lq1[j];
+				lq1[j] = (mCoefs[base + j] * lq1[j]) - lq2[j] + x;
+				lq2[j] = tmp;
+			}
+		}
+		for (int j = 0; j < 8; ++j) {
+			q1[base + j] = lq1[j];
+			q2[base + j] = lq2[j];
+		}
+#endif
+	}
+
+	for (int i = 0; i < mSize; ++i) {
+		float frequencyEnergy = (q1[i] * q1[i]) + (q2[i] * q2[i]) - (q1[i] * q2[i] * mCoefs[i]);
+		/* Return a relative frequency energy compared over the total signal energy */
+		energies[i] = frequencyEnergy / (totalEnergy * (float)nbSamples * 0.5f);
+	}
+}
+
+} // namespace mediastreamer
@@ -63,6 +63,33 @@ private:
 	bool mEventSent = false;
 };
 
+/*
+ * Bank of Goertzel filters evaluating several frequencies in a single pass over the samples. The frequencies are
+ * processed in SIMD lanes (SSE on x86, NEON on ARM) and give the same results as GoertzelState::run().
+ */
+class GoertzelFilterBank {
+public:
+	static constexpr int MaxFrequencies = 16;
+
+	GoertzelFilterBank() = default;
+	~GoertzelFilterBank() = default;
+
+	/* Sets the frequency of the filter at the given index, the bank grows to include it if needed. */
+	void setFrequency(int index, int frequency, int samplingFrequency);
+	void clear();
+
+	int size() const {
+		return mSize;
+	}
+
+	/* Fills energies with the relative energy of each frequency of the bank, in the order of their indexes. */
+	void run(const int16_t *samples, int nbSamples, float totalEnergy, float *energies) const;
+
+private:
+	alignas(16) float mCoefs[MaxFrequencies] = {};
+	int mSize = 0;
+};
+
 } // namespace mediastreamer
 
 #endif /* _MS_GOERTZEL_STATE_H */
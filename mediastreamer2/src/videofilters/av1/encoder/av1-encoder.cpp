@@ -87,6 +87,10 @@ void Av1Encoder::configure(bool avpfEnabled) {
 #else
 	mConfig.g_threads = ms_factory_get_cpu_count(mFactory);
 #endif
+#if !TARGET_IPHONE_SIMULATOR
+	// The thread budget of the factory is shared by all the running video codecs.
+	mConfig.g_threads = (unsigned int)ms_factory_get_video_codec_thread_count(mFactory, (int)mConfig.g_threads);
+#endif
 
 	mConfig.g_error_resilient = AOM_ERROR_RESILIENT_DEFAULT;
 
@@ -116,8 +120,10 @@ void Av1Encoder::start() {
 			}
 		}
 
+		mWorker = ms_factory_acquire_video_codec_worker(mFactory);
+		mQueueingDelayMax = 0;
+		mQueueingDelayAvg = 0;
 		mIsRunning = true;
-		mEncodeThread = std::thread(&Av1Encoder::encoderThread, this);
 	}
 }
 
@@ -125,13 +131,17 @@ void Av1Encoder::stop() {
 	if (mIsRunning) {
 		mIsRunning = false;
 
-		// Ensure the encoding thread can finish
+		// The frames not encoded yet are dropped, the pending tasks will find nothing to do.
 		unique_lock<mutex> lk(mToEncodeMutex);
-		mFramesAvailable = true;
+		ms_queue_flush(&mToEncode);
 		lk.unlock();
-		mToEncodeCondition.notify_one();
 
-		mEncodeThread.join();
+		if (mWorker) {
+			ms_factory_release_video_codec_worker(mFactory, mWorker);
+			mWorker = nullptr;
+		}
+		ms_message("Av1Encoder: queueing delay before encoding avg=%.1f ms, max=%llu ms", mQueueingDelayAvg,
+		           (unsigned long long)mQueueingDelayMax);
 
 		flush();
 
@@ -149,15 +159,13 @@ void Av1Encoder::feed(mblk_t *rawData, [[maybe_unused]] uint64_t time, bool requ
 
 	unique_lock<mutex> lk(mToEncodeMutex);
 
+	if (ms_queue_empty(&mToEncode)) mToEncodeTime = bctbx_get_cur_time_ms();
 	ms_queue_put(&mToEncode, rawData);
 
-	// Notify the encoding thread that frames are available
-	mFramesAvailable = true;
-
 	if (requestIFrame) mIframeRequested = true;
 
 	lk.unlock();
-	mToEncodeCondition.notify_one();
+	ms_worker_thread_add_task(mWorker, &Av1Encoder::encodeTask, this);
 }
 
 bool Av1Encoder::fetch(MSQueue *encodedData) {
@@ -185,84 +193,91 @@ void Av1Encoder::resetEncoder() {
 	}
 }
 
-void Av1Encoder::encoderThread() {
-	while (mIsRunning) {
-		// Wait for available frames to pass to the encoder
-		unique_lock lk(mToEncodeMutex);
-		mToEncodeCondition.wait(lk, [this] { return this->mFramesAvailable; });
+bool_t Av1Encoder::encodeTask(void *data) {
+	static_cast<Av1Encoder *>(data)->encodeFrame();
+	return TRUE;
+}
 
-		mblk_t *data = nullptr;
-		int skippedCount = 0;
+void Av1Encoder::encodeFrame() {
+	unique_lock lk(mToEncodeMutex);
+	if (!ms_queue_empty(&mToEncode)) {
+		// Time spent waiting for the worker thread, that may be busy with other encoders.
+		uint64_t delay = bctbx_get_cur_time_ms() - mToEncodeTime;
+		mQueueingDelayMax = std::max(mQueueingDelayMax, delay);
+		mQueueingDelayAvg = 0.9f * mQueueingDelayAvg + 0.1f * (float)delay;
+	}
 
-		mblk_t *previous = nullptr;
-		while ((data = ms_queue_get(&mToEncode)) != nullptr) {
-			if (previous) {
-				freemsg(previous);
-				skippedCount++;
-			}
-			previous = data;
+	mblk_t *data = nullptr;
+	int skippedCount = 0;
+
+	mblk_t *previous = nullptr;
+	while ((data = ms_queue_get(&mToEncode)) != nullptr) {
+		if (previous) {
+			freemsg(previous);
+			skippedCount++;
 		}
+		previous = data;
+	}
 
-		if (data == nullptr) data = previous;
+	if (data == nullptr) data = previous;
 
-		mFramesAvailable = false;
-		lk.unlock();
+	lk.unlock();
 
-		if (data == nullptr) continue;
+	// The frame was already encoded by a previous task.
+	if (data == nullptr) return;
 
-		if (skippedCount > 0) ms_warning("Av1Encoder: %i frames skipped by async encoding process", skippedCount);
+	if (skippedCount > 0) ms_warning("Av1Encoder: %i frames skipped by async encoding process", skippedCount);
 
-		MSPicture pic;
-		ms_yuv_buf_init_from_mblk(&pic, data);
+	MSPicture pic;
+	ms_yuv_buf_init_from_mblk(&pic, data);
 
-		aom_image_t img;
-		aom_img_wrap(&img, AOM_IMG_FMT_I420, mVsize.width, mVsize.height, 1, pic.planes[0]);
+	aom_image_t img;
+	aom_img_wrap(&img, AOM_IMG_FMT_I420, mVsize.width, mVsize.height, 1, pic.planes[0]);
 
-		aom_enc_frame_flags_t flags = 0;
+	aom_enc_frame_flags_t flags = 0;
 
-		if (mFrameCount == 0) flags |= AOM_EFLAG_FORCE_KF;
+	if (mFrameCount == 0) flags |= AOM_EFLAG_FORCE_KF;
 
-		lk.lock();
-		if (mIframeRequested) {
-			flags |= AOM_EFLAG_FORCE_KF;
-			mIframeRequested = false;
-		}
-		lk.unlock();
+	lk.lock();
+	if (mIframeRequested) {
+		flags |= AOM_EFLAG_FORCE_KF;
+		mIframeRequested = false;
+	}
+	lk.unlock();
 
-		unique_lock codecLk(mCodecMutex);
-		aom_codec_err_t ret = aom_codec_encode(&mCodec, &img, mFrameCount, 1, flags);
+	unique_lock codecLk(mCodecMutex);
+	aom_codec_err_t ret = aom_codec_encode(&mCodec, &img, mFrameCount, 1, flags);
 
-		if (ret != AOM_CODEC_OK) {
-			ms_error("Av1Encoder: encode failed: %s (%s)", aom_codec_err_to_string(ret),
-			         aom_codec_error_detail(&mCodec));
-			ms_message("AV1Encoder: unexpected encode error occurred, proceed to reset encoder");
-			resetEncoder();
-		}
+	if (ret != AOM_CODEC_OK) {
+		ms_error("Av1Encoder: encode failed: %s (%s)", aom_codec_err_to_string(ret),
+		         aom_codec_error_detail(&mCodec));
+		ms_message("AV1Encoder: unexpected encode error occurred, proceed to reset encoder");
+		resetEncoder();
+	}
 
-		const aom_codec_cx_pkt_t *pkt;
-		aom_codec_iter_t iter = nullptr;
-
-		while ((pkt = aom_codec_get_cx_data(&mCodec, &iter))) {
-			if (pkt->kind == AOM_CODEC_CX_FRAME_PKT) {
-				mblk_t *out = allocb(pkt->data.frame.sz, 0);
-				memcpy(out->b_wptr, pkt->data.frame.buf, pkt->data.frame.sz);
-				out->b_wptr += pkt->data.frame.sz;
-				mblk_set_timestamp_info(out, mblk_get_timestamp_info(data));
-				mblk_set_independent_flag(out, (pkt->data.frame.flags & AOM_FRAME_IS_KEY ||
-				                                pkt->data.frame.flags & AOM_FRAME_IS_INTRAONLY ||
-				                                pkt->data.frame.flags & AOM_FRAME_IS_SWITCH));
-				mblk_set_discardable_flag(out, (pkt->data.frame.flags & AOM_FRAME_IS_DROPPABLE));
-
-				lock_guard<mutex> guard(mEncodedFramesMutex);
-				ms_queue_put(&mEncodedFrames, out);
-			}
+	const aom_codec_cx_pkt_t *pkt;
+	aom_codec_iter_t iter = nullptr;
+
+	while ((pkt = aom_codec_get_cx_data(&mCodec, &iter))) {
+		if (pkt->kind == AOM_CODEC_CX_FRAME_PKT) {
+			mblk_t *out = allocb(pkt->data.frame.sz, 0);
+			memcpy(out->b_wptr, pkt->data.frame.buf, pkt->data.frame.sz);
+			out->b_wptr += pkt->data.frame.sz;
+			mblk_set_timestamp_info(out, mblk_get_timestamp_info(data));
+			mblk_set_independent_flag(out, (pkt->data.frame.flags & AOM_FRAME_IS_KEY ||
+			                                pkt->data.frame.flags & AOM_FRAME_IS_INTRAONLY ||
+			                                pkt->data.frame.flags & AOM_FRAME_IS_SWITCH));
+			mblk_set_discardable_flag(out, (pkt->data.frame.flags & AOM_FRAME_IS_DROPPABLE));
+
+			lock_guard<mutex> guard(mEncodedFramesMutex);
+			ms_queue_put(&mEncodedFrames, out);
 		}
-		codecLk.unlock();
+	}
+	codecLk.unlock();
 
-		mFrameCount++;
+	mFrameCount++;
 
-		freemsg(data);
-	}
+	freemsg(data);
 }
 
 void Av1Encoder::flush() {
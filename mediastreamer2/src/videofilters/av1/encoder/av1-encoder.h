@@ -20,13 +20,12 @@
 
 #pragma once
 
-#include <condition_variable>
 #include <mutex>
-#include <thread>
 
 #include <aom/aom_encoder.h>
 #include <aom/aomcx.h>
 
+#include "mediastreamer2/msasync.h"
 #include "mediastreamer2/msqueue.h"
 #include "video-encoder.h"
 
@@ -71,7 +70,8 @@ public:
 	void flush();
 
 protected:
-	void encoderThread();
+	static bool_t encodeTask(void *data);
+	void encodeFrame();
 	void resetEncoder();
 
 	MSFactory *mFactory;
@@ -92,8 +92,9 @@ protected:
 	// IN frames
 	MSQueue mToEncode;
 	std::mutex mToEncodeMutex;
-	std::condition_variable mToEncodeCondition;
-	bool mFramesAvailable = false;
+	uint64_t mToEncodeTime = 0; // time at which the oldest frame of mToEncode was queued
+	uint64_t mQueueingDelayMax = 0;
+	float mQueueingDelayAvg = 0;
 
 	// OUT frames
 	MSQueue mEncodedFrames;
@@ -101,7 +102,8 @@ protected:
 
 	std::mutex mCodecMutex;
 
-	std::thread mEncodeThread{};
+	// Shared with the other video codecs of the factory
+	MSWorkerThread *mWorker = nullptr;
 };
 
 } // namespace mediastreamer
@@ -71,12 +71,18 @@ static void ffmpeg_init(void) {
 	}
 }
 
-static void dec_open(DecData *d) {
+static void dec_open(MSFilter *f, DecData *d) {
 	AVCodec *codec;
 	int error;
 	codec = avcodec_find_decoder(CODEC_ID_H264);
 	if (codec == NULL) ms_fatal("Could not find H264 decoder in ffmpeg.");
 	avcodec_get_context_defaults3(&d->av_context, NULL);
+	/* frame threading would delay the output by one frame per thread */
+	d->av_context.thread_count = ms_factory_get_video_codec_thread_count(f->factory, 4);
+	d->av_context.thread_type = FF_THREAD_SLICE;
+#ifdef HAVE_FFMPEG_DIRECT_RENDERING
+	ms_ffmpeg_enable_direct_rendering(&d->av_context, d->buf_allocator);
+#endif
 	error = avcodec_open2(&d->av_context, codec, NULL);
 	if (error != 0) {
 		ms_fatal("avcodec_open() failed.");
@@ -91,7 +97,9 @@ static void dec_init(MSFilter *f) {
 	d->sws_ctx = NULL;
 	d->unpacker = new H264NalUnpacker();
 	d->packet_num = 0;
-	dec_open(d);
+	d->buf_allocator = ms_yuv_buf_allocator_new();
+	ms_factory_register_video_codec(f->factory);
+	dec_open(f, d);
 	d->vsize.width = 0;
 	d->vsize.height = 0;
 	d->bitstream_size = 65536;
@@ -102,7 +110,6 @@ static void dec_init(MSFilter *f) {
 		ms_error("Could not allocate frame");
 	}
 	d->regulator = NULL;
-	d->buf_allocator = ms_yuv_buf_allocator_new();
 	f->data = d;
 }
 
@@ -112,9 +119,9 @@ static void dec_preprocess(MSFilter *f) {
 	s->regulator = ms_stream_regulator_new(f->ticker, 90000);
 }
 
-static void dec_reinit(DecData *d) {
+static void dec_reinit(MSFilter *f, DecData *d) {
 	avcodec_close(&d->av_context);
-	dec_open(d);
+	dec_open(f, d);
 }
 
 static void dec_postprocess(MSFilter *f) {
@@ -132,13 +139,14 @@ static void dec_uninit(MSFilter *f) {
 	if (d->sws_ctx) sws_freeContext(d->sws_ctx);
 	ms_free(d->bitstream);
 	ms_yuv_buf_allocator_free(d->buf_allocator);
+	ms_factory_unregister_video_codec(f->factory);
 	ms_free(d);
 }
 
 static mblk_t *get_as_yuvmsg(MSFilter *f, DecData *s, AVFrame *orig) {
 	AVCodecContext *ctx = &s->av_context;
 	MSPicture pic = {0};
-	mblk_t *yuv_msg;
+	mblk_t *yuv_msg = NULL;
 
 	if (s->vsize.width != ctx->width || s->vsize.height != ctx->height) {
 		if (s->sws_ctx != NULL) {
@@ -152,14 +160,20 @@ static mblk_t *get_as_yuvmsg(MSFilter *f, DecData *s, AVFrame *orig) {
 		                            SWS_FAST_BILINEAR, NULL, NULL, NULL);
 		ms_filter_notify_no_arg(f, MS_FILTER_OUTPUT_FMT_CHANGED);
 	}
-	yuv_msg = ms_yuv_buf_allocator_get(s->buf_allocator, &pic, ctx->width, ctx->height);
+#ifdef HAVE_FFMPEG_DIRECT_RENDERING
+	yuv_msg = ms_ffmpeg_frame_to_yuvmsg(ctx, orig);
+#endif
+	if (yuv_msg == NULL) {
+		yuv_msg = ms_yuv_buf_allocator_get(s->buf_allocator, &pic, ctx->width, ctx->height);
 #if LIBSWSCALE_VERSION_INT >= AV_VERSION_INT(0, 9, 0)
-	if (sws_scale(s->sws_ctx, (const uint8_t *const *)orig->data, orig->linesize, 0, ctx->height, pic.planes,
-	              pic.strides) < 0) {
+		if (sws_scale(s->sws_ctx, (const uint8_t *const *)orig->data, orig->linesize, 0, ctx->height, pic.planes,
+		              pic.strides) < 0) {
 #else
-	if (sws_scale(s->sws_ctx, (uint8_t **)orig->data, orig->linesize, 0, ctx->height, pic.planes, pic.strides) < 0) {
+		if (sws_scale(s->sws_ctx, (uint8_t **)orig->data, orig->linesize, 0, ctx->height, pic.planes,
+		              pic.strides) < 0) {
 #endif
-		ms_error("%s: error in sws_scale().", f->desc->name);
+			ms_error("%s: error in sws_scale().", f->desc->name);
+		}
 	}
 #if LIBAVUTIL_VERSION_INT >= AV_VERSION_INT(50, 43, 0) // backward compatibility with Debian Squeeze (6.0)
 	mblk_set_timestamp_info(yuv_msg, (uint32_t)orig->pkt_pts);
@@ -280,7 +294,7 @@ static void dec_process(MSFilter *f) {
 		if (msgdsize(im) == 0) {
 			delete d->unpacker;
 			d->unpacker = new H264NalUnpacker();
-			dec_reinit(d);
+			dec_reinit(f, d);
 			ms_stream_regulator_reset(d->regulator);
 			freemsg(im);
 			continue;
@@ -302,7 +316,7 @@ static void dec_process(MSFilter *f) {
 #endif
 
 			size = nalusToFrame(d, &nalus, &need_reinit);
-			if (need_reinit) dec_reinit(d);
+			if (need_reinit) dec_reinit(f, d);
 			p = d->bitstream;
 			end = d->bitstream + size;
 			while (end - p > 0) {
@@ -325,6 +339,7 @@ static void dec_process(MSFilter *f) {
 				}
 				if (got_picture) {
 					ms_stream_regulator_push(d->regulator, get_as_yuvmsg(f, d, d->orig));
+					av_frame_unref(d->orig);
 				}
 				p += len;
 			}
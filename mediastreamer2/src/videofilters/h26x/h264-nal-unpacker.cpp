@@ -55,12 +55,12 @@ mblk_t *H264FuaAggregator::feed(mblk_t *im) {
 		H264Tools::nalHeaderInit(new_header->b_wptr, nri, type);
 		new_header->b_wptr++;
 		mblk_meta_copy(im, new_header);
-		concatb(new_header, im);
+		_tail = concatb(new_header, im);
 		_m = new_header;
 	} else {
 		if (_m != nullptr) {
 			im->b_rptr += 2;
-			concatb(_m, im);
+			_tail = concatb(_tail, im);
 		} else {
 			ms_error("Receiving continuation FU packet but no start.");
 			freemsg(im);
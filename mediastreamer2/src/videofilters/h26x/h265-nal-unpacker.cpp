@@ -42,7 +42,7 @@ mblk_t *H265NalUnpacker::FuAggregator::feed(mblk_t *packet) {
 	if (fuHeader.getPosition() == H265FuHeader::Position::Start && isAggregating()) {
 		ms_error("receiving start FU packet while aggregating. Dropping the under construction NALu");
 		reset();
-		_m = packet;
+		_m = _tail = packet;
 		return nullptr;
 	}
 
@@ -53,10 +53,10 @@ mblk_t *H265NalUnpacker::FuAggregator::feed(mblk_t *packet) {
 	}
 
 	if (fuHeader.getPosition() == H265FuHeader::Position::Start) {
-		_m = naluHeader.forge();
+		_m = _tail = naluHeader.forge();
 	}
 
-	concatb(_m, packet);
+	_tail = concatb(_tail, packet);
 
 	if (fuHeader.getPosition() == H265FuHeader::Position::End) {
 		return completeAggregation();
@@ -51,6 +51,7 @@ public:
 
 	protected:
 		mblk_t *_m = nullptr;
+		mblk_t *_tail = nullptr; // last fragment of _m, so that appending a fragment doesn't walk the whole chain
 	};
 
 	class ApSpliterInterface {
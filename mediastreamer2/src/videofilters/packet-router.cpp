@@ -260,6 +260,18 @@ bool RouterVideoInput::isKeyFrame(mblk_t *packet) const {
 
 	return mKeyFrameIndicator->isKeyFrame(packet);
 }
+
+int RouterVideoInput::getTemporalLayerId(mblk_t *packet) const {
+	if (!mRouter->isFullPacketModeEnabled()) return mblk_get_temporal_layer_id(packet);
+
+	// Streams without the scalable form of the frame marking are considered as having only a base layer.
+	uint8_t marker;
+	if (rtp_get_scalable_frame_marker(packet, getExtensionId(RTP_EXTENSION_FRAME_MARKING), &marker, NULL, NULL)) {
+		return marker & RTP_FRAME_MARKER_TID_MASK;
+	}
+
+	return 0;
+}
 #endif
 
 // =============================================================================
@@ -393,6 +405,8 @@ void RouterVideoOutput::transfer() {
 			mblk_t *start = input->mKeyFrameStart ? input->mKeyFrameStart : ms_queue_peek_first(inputQueue);
 
 			for (mblk_t *m = start; !ms_queue_end(inputQueue, m); m = ms_queue_peek_next(inputQueue, m)) {
+				if (isAboveMaxTemporalLayer(input, m)) continue;
+
 				mblk_t *o = copymsg(m);
 
 				// Only re-write packet information if full packet mode is disabled
@@ -407,6 +421,28 @@ void RouterVideoOutput::transfer() {
 		}
 	}
 }
+
+void RouterVideoOutput::setMaxTemporalLayer(int layer) {
+	if (layer != mNextMaxTemporalLayer) {
+		PackerRouterLogContextualizer prlc(mRouter);
+		ms_message("Output pin %i max temporal layer set to %i", mPin, layer);
+	}
+	mNextMaxTemporalLayer = layer;
+}
+
+bool RouterVideoOutput::isAboveMaxTemporalLayer(const RouterVideoInput *input, mblk_t *packet) {
+	// Frame boundaries are tracked even without limit, so that a limit set in the middle of a frame waits for the next.
+	uint32_t timestamp = mRouter->isFullPacketModeEnabled() ? rtp_get_timestamp(packet) : mblk_get_timestamp_info(packet);
+	if (timestamp != mCurrentFrameTimestamp) {
+		mCurrentFrameTimestamp = timestamp;
+		mMaxTemporalLayer = mNextMaxTemporalLayer;
+	}
+
+	if (mMaxTemporalLayer == -1) return false;
+
+	// Upper layer frames are not referenced by the lower ones, so they can be dropped without breaking the decoding.
+	return input->getTemporalLayerId(packet) > mMaxTemporalLayer;
+}
 #endif
 
 // =============================================================================
@@ -881,6 +917,22 @@ void PacketRouter::notifyOutputSwitched(MSPacketRouterSwitchedEventData event) {
 	notify(MS_PACKET_ROUTER_OUTPUT_SWITCHED, &event);
 }
 
+void PacketRouter::setOutputMaxTemporalLayer(const MSPacketRouterTemporalLayerData *data) {
+	if (mRoutingMode != RoutingMode::Video) {
+		PackerRouterLogContextualizer prlc(this);
+		ms_error("Trying to set an output max temporal layer while not in video mode");
+		return;
+	}
+
+	lock();
+
+	if (auto output = dynamic_cast<RouterVideoOutput *>(getRouterOutput(data->output)); output != nullptr) {
+		output->setMaxTemporalLayer(data->max_temporal_layer);
+	}
+
+	unlock();
+}
+
 void PacketRouter::setInputFmt(const MSFmtDescriptor *format) {
 	PackerRouterLogContextualizer prlc(this);
 
@@ -1165,6 +1217,22 @@ int PacketRouterFilterWrapper::onNotifyFir(MSFilter *f, void *arg) {
 	}
 }
 
+int PacketRouterFilterWrapper::onSetOutputMaxTemporalLayer(MSFilter *f, void *arg) {
+	try {
+		const auto data = static_cast<MSPacketRouterTemporalLayerData *>(arg);
+		if (data->output < 0 || data->output >= ROUTER_MAX_OUTPUT_CHANNELS || data->max_temporal_layer < -1) {
+			PackerRouterLogContextualizer prlc(static_cast<PacketRouter *>(f->data));
+			ms_error("Invalid argument to MS_PACKET_ROUTER_SET_OUTPUT_MAX_TEMPORAL_LAYER");
+			return -1;
+		}
+
+		static_cast<PacketRouter *>(f->data)->setOutputMaxTemporalLayer(data);
+		return 0;
+	} catch (const PacketRouter::MethodCallFailed &) {
+		return -1;
+	}
+}
+
 int PacketRouterFilterWrapper::onSetInputFmt(MSFilter *f, void *arg) {
 	try {
 		const MSFmtDescriptor *format = static_cast<MSFmtDescriptor *>(arg);
@@ -1205,6 +1273,7 @@ static MSFilterMethod MS_FILTER_WRAPPER_METHODS_NAME(PacketRouter)[] = {
     {MS_PACKET_ROUTER_SET_FOCUS, PacketRouterFilterWrapper::onSetFocus},
     {MS_PACKET_ROUTER_NOTIFY_PLI, PacketRouterFilterWrapper::onNotifyPli},
     {MS_PACKET_ROUTER_NOTIFY_FIR, PacketRouterFilterWrapper::onNotifyFir},
+    {MS_PACKET_ROUTER_SET_OUTPUT_MAX_TEMPORAL_LAYER, PacketRouterFilterWrapper::onSetOutputMaxTemporalLayer},
     {MS_FILTER_SET_INPUT_FMT, PacketRouterFilterWrapper::onSetInputFmt},
 #endif
     {0, nullptr}};
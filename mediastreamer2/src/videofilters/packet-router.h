@@ -101,6 +101,7 @@ public:
 
 protected:
 	bool isKeyFrame(mblk_t *packet) const;
+	int getTemporalLayerId(mblk_t *packet) const;
 
 	enum State { Stopped, Running };
 	State mState = State::Stopped;
@@ -168,11 +169,20 @@ public:
 		return mCurrentSource;
 	}
 
+	void setMaxTemporalLayer(int layer);
+
 protected:
+	bool isAboveMaxTemporalLayer(const RouterVideoInput *input, mblk_t *packet);
+
 	int mCurrentSource = -1;
 	int mNextSource = -1;
 
 	bool mActiveSpeakerEnabled = false;
+
+	// The limit is only changed at the beginning of a frame, to never forward part of a frame.
+	int mMaxTemporalLayer = -1;
+	int mNextMaxTemporalLayer = -1;
+	uint32_t mCurrentFrameTimestamp = 0;
 };
 #endif
 
@@ -280,6 +290,8 @@ public:
 	void notifyFir(int pin);
 	void notifyOutputSwitched(MSPacketRouterSwitchedEventData event);
 
+	void setOutputMaxTemporalLayer(const MSPacketRouterTemporalLayerData *data);
+
 	void setInputFmt(const MSFmtDescriptor *format);
 #endif
 
@@ -322,6 +334,7 @@ public:
 	static int onSetFocus(MSFilter *f, void *arg);
 	static int onNotifyPli(MSFilter *f, void *arg);
 	static int onNotifyFir(MSFilter *f, void *arg);
+	static int onSetOutputMaxTemporalLayer(MSFilter *f, void *arg);
 	static int onSetInputFmt(MSFilter *f, void *arg);
 #endif
 };
@@ -101,9 +101,16 @@ int FileWriter::open(const std::string &filepath, bool append) {
 	} else {
 		writeRoot();
 	}
+	/* Records are written from mWritePos without blocking the caller, each one at the position writeRecord()
+	 * assigned to it. */
+	mAsyncWriter = ms_async_writer_new_at(mFile, (off_t)mWritePos);
+	ms_async_writer_set_max_pending_size(mAsyncWriter, mMaxPendingWriteSize);
+	ms_async_writer_set_flush_interval(mAsyncWriter, mFlushInterval);
+	mDroppedRecords = 0;
 	return 0;
 error:
 	bctbx_file_close(mFile);
+	mFile = nullptr;
 	return -1;
 }
 
@@ -208,18 +215,33 @@ bool FileWriter::writeRoot() {
 	return write(&root, sizeof(root), 0, "root");
 }
 
+bool FileWriter::invalidateRoot() {
+	SMFFRoot root;
+	memset(root.magic, 0, sizeof(root.magic));
+	return write(&root, sizeof(root), 0, "invalidated root");
+}
+
 bool FileWriter::writeRecord(Record &record, uint32_t absoluteTimestamp) {
 	/* update the last absolute timestamp for the file, which is required for offset computation and track
 	 * synchronisation */
 	if (absoluteTimestamp > mMostRecentAbsTimestamp) {
 		mMostRecentAbsTimestamp = absoluteTimestamp;
 	}
-	if (write(record.data.inputBuffer, record.size, mWritePos, "data")) {
-		record.pos = mWritePos;
-		mWritePos += (FilePos)record.size;
-		return true;
+	mblk_t *m = allocb(record.size, 0);
+	memcpy(m->b_wptr, record.data.inputBuffer, record.size);
+	m->b_wptr += record.size;
+	if (ms_async_writer_write(mAsyncWriter, m) != 0) {
+		if (mDroppedRecords++ % 100 == 0) {
+			MSAsyncWriterStats stats;
+			ms_async_writer_get_stats(mAsyncWriter, &stats);
+			bctbx_warning("FileWriter: storage is too slow, [%u] records dropped so far, [%llu] bytes pending.",
+			              mDroppedRecords, (unsigned long long)stats.pending_size);
+		}
+		return false;
 	}
-	return false;
+	record.pos = mWritePos;
+	mWritePos += (FilePos)record.size;
+	return true;
 }
 
 void FileWriter::synchronizeTracks() {
@@ -248,8 +270,35 @@ std::optional<std::reference_wrapper<TrackWriterInterface>> FileWriter::getMainT
 	return std::nullopt;
 }
 
+void FileWriter::setMaxPendingWriteSize(size_t size) {
+	mMaxPendingWriteSize = size;
+}
+
+void FileWriter::setFlushInterval(int intervalMs) {
+	mFlushInterval = intervalMs;
+}
+
 int FileWriter::close() {
+	bool recordsWritten = true;
 	if (mFile == nullptr) return -1;
+	if (mAsyncWriter) {
+		MSAsyncWriterStats stats;
+		ms_async_writer_get_stats(mAsyncWriter, &stats);
+		bctbx_message("FileWriter::close(): [%llu] bytes of records at most were pending, [%u] records dropped.",
+		              (unsigned long long)stats.max_pending_size_reached, mDroppedRecords);
+		/* Waits for all the records to be written. */
+		recordsWritten = ms_async_writer_destroy(mAsyncWriter) == 0;
+		mAsyncWriter = nullptr;
+	}
+	if (!recordsWritten) {
+		/* The track descriptors would point to data that is not in the file: make it unreadable instead. */
+		bctbx_error("FileWriter::close(): some records could not be written, the file is marked as invalid.");
+		invalidateRoot();
+		bctbx_file_close(mFile);
+		mTrackWriters.clear();
+		mFile = nullptr;
+		return -1;
+	}
 	mTrackPos = mWritePos;
 	beginCompression();
 	for (auto &trackWriter : mTrackWriters) {
@@ -291,7 +340,10 @@ void TrackWriter::addRecord(const RecordInterface &record) {
 	Record &copy = mRecords.back();
 	adjustTimestamp(copy);
 	uint32_t absTimestamp = toAbsoluteTimestamp(copy.timestamp);
-	mFileWriter.writeRecord(copy, absTimestamp);
+	if (!mFileWriter.writeRecord(copy, absTimestamp)) {
+		mRecords.pop_back();
+		return;
+	}
 	copy.data.inputBuffer = nullptr; /* don't point to user memory that is not retained. */
 	/*bctbx_message("TrackWriter[%p, type=%s]: adding record with raw-ts=[%u] adjusted-ts=[%u]; abs-ts=[%u]",
 	              this, (getType() == multimedia_container::TrackInterface::MediaType::Audio) ? "audio" : "video",
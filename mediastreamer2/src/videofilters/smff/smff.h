@@ -35,6 +35,7 @@
 #include "zlib.h"
 #endif
 
+#include "../../audiofilters/asyncrw.h"
 #include "../multimedia-container-interface.h"
 
 using namespace mediastreamer::multimedia_container;
@@ -120,6 +121,17 @@ public:
 	virtual std::optional<std::reference_wrapper<TrackWriterInterface>> getTrackByID(unsigned id) override;
 	virtual void synchronizeTracks() override;
 	virtual int close() override;
+	/**
+	 * Records are written to the file by a worker thread. Bound the amount of record data waiting to be written:
+	 * when the storage is too slow, records are dropped instead of stalling the caller. 0 means unbounded.
+	 * Must be called before open().
+	 */
+	void setMaxPendingWriteSize(size_t size);
+	/**
+	 * Set the interval at which record data waiting to be written is flushed, even if less than a block is available.
+	 * Must be called before open().
+	 */
+	void setFlushInterval(int intervalMs);
 
 private:
 	void moveDataFromReader(FileReader &reader);
@@ -129,12 +141,17 @@ private:
 	bool write(const void *data, size_t size, const char *what);
 	bool _write(const void *data, size_t size, const char *what);
 	bool writeRoot();
+	bool invalidateRoot();
 	bool writeRecord(Record &record, uint32_t absoluteTimestamp);
 	std::list<std::unique_ptr<TrackWriter>> mTrackWriters;
 	FilePos mTrackPos = 0;
 	FilePos mDataStartPos;
 	FilePos mWritePos;
 	bctbx_vfs_file_t *mFile = nullptr;
+	MSAsyncWriter *mAsyncWriter = nullptr;
+	size_t mMaxPendingWriteSize = 16 * 1024 * 1024;
+	int mFlushInterval = 1000;
+	unsigned int mDroppedRecords = 0;
 	uint32_t mMostRecentAbsTimestamp = 0;
 	z_stream mZlibStream;
 	bool mCompress = false;
@@ -69,6 +69,13 @@ static void dec_init(MSFilter *f, enum CodecID cid) {
 
 	avcodec_get_context_defaults3(&s->av_context, NULL);
 	s->allocator = ms_yuv_buf_allocator_new();
+	ms_factory_register_video_codec(f->factory);
+	/* frame threading would delay the output by one frame per thread */
+	s->av_context.thread_count = ms_factory_get_video_codec_thread_count(f->factory, 4);
+	s->av_context.thread_type = FF_THREAD_SLICE;
+#ifdef HAVE_FFMPEG_DIRECT_RENDERING
+	ms_ffmpeg_enable_direct_rendering(&s->av_context, s->allocator);
+#endif
 	s->av_codec = NULL;
 	s->codec = cid;
 	s->input = NULL;
@@ -123,6 +130,7 @@ static void dec_uninit(MSFilter *f) {
 		s->av_context.codec = NULL;
 	}
 	ms_yuv_buf_allocator_free(s->allocator);
+	ms_factory_unregister_video_codec(f->factory);
 	if (s->input != NULL) freemsg(s->input);
 	if (s->sws_ctx != NULL) {
 		sws_freeContext(s->sws_ctx);
@@ -559,7 +567,7 @@ static mblk_t *read_rfc2435_header(DecState *s, mblk_t *inm) {
 
 static mblk_t *get_as_yuvmsg(MSFilter *f, DecState *s, AVFrame *orig) {
 	AVCodecContext *ctx = &s->av_context;
-	mblk_t *yuv_msg;
+	mblk_t *yuv_msg = NULL;
 
 	if (ctx->width == 0 || ctx->height == 0) {
 		ms_error("%s: wrong image size provided by decoder.", f->desc->name);
@@ -574,6 +582,17 @@ static mblk_t *get_as_yuvmsg(MSFilter *f, DecState *s, AVFrame *orig) {
 			sws_freeContext(s->sws_ctx);
 			s->sws_ctx = NULL;
 		}
+		s->outbuf.w = ctx->width;
+		s->outbuf.h = ctx->height;
+	}
+#ifdef HAVE_FFMPEG_DIRECT_RENDERING
+	if (s->output_pix_fmt == AV_PIX_FMT_YUV420P) yuv_msg = ms_ffmpeg_frame_to_yuvmsg(ctx, orig);
+	if (yuv_msg != NULL) {
+		mblk_set_timestamp_info(yuv_msg, (uint32_t)orig->pkt_pts);
+		return yuv_msg;
+	}
+#endif
+	if (s->sws_ctx == NULL) {
 		s->sws_ctx = sws_getContext(ctx->width, ctx->height, ctx->pix_fmt, ctx->width, ctx->height, s->output_pix_fmt,
 		                            SWS_FAST_BILINEAR, NULL, NULL, NULL);
 	}
@@ -658,6 +677,7 @@ static void dec_process_frame(MSFilter *f, mblk_t *inm) {
 				}
 				if (got_picture) {
 					mblk_t *om = get_as_yuvmsg(f, s, s->orig);
+					av_frame_unref(s->orig);
 					ms_average_fps_activity(&s->fps, f->ticker->time, om != NULL);
 					if (om != NULL) {
 						ms_queue_put(f->outputs[0], om);
@@ -94,10 +94,16 @@ typedef struct EncState {
 	MSVideoConfiguration vconf;
 	const MSVideoConfiguration *vconf_list;
 	int last_fir_seq_nr;
+	int temporal_layers;
+	uint64_t layer_frame_index; /* position in the temporal layer pattern, restarted by each keyframe */
+	uint8_t tl0picidx;
 	uint16_t picture_id;
 	uint16_t last_sli_id;
-	MSWorkerThread *process_thread;
+	MSWorkerThread *process_thread; /* shared with the other video codecs of the factory */
 	queue_t entry_q;
+	uint64_t entry_time; /* time at which the oldest frame of entry_q was queued */
+	uint64_t queueing_delay_max;
+	float queueing_delay_avg;
 	MSQueue *exit_q;
 	ms_mutex_t vp8_mutex;
 	bool_t force_keyframe;
@@ -124,6 +130,7 @@ static void enc_init(MSFilter *f) {
 	s->vconf = ms_video_find_best_configuration_for_size(s->vconf_list, vsize, ms_factory_get_cpu_count(f->factory));
 	s->frame_count = 0;
 	s->last_fir_seq_nr = -1;
+	s->temporal_layers = 1;
 #ifdef PICTURE_ID_ON_16_BITS
 	s->picture_id = (bctbx_random() & 0x7FFF) | 0x8000;
 #else
@@ -159,6 +166,8 @@ static void enc_init_impl(MSFilter *f) {
 
 	/* Populate encoder configuration */
 	s->flags = 0;
+	/* A new encoder starts with a keyframe, which must be in the base layer. */
+	s->layer_frame_index = 0;
 	caps = vpx_codec_get_caps(s->iface);
 	if ((s->avpf_enabled == TRUE) && (caps & VPX_CODEC_CAP_OUTPUT_PARTITION)) {
 		s->flags |= VPX_CODEC_USE_OUTPUT_PARTITION;
@@ -180,12 +189,30 @@ static void enc_init_impl(MSFilter *f) {
 		s->cfg.kf_mode = VPX_KF_AUTO;                    /* encoder automatically places keyframes */
 		s->cfg.kf_max_dist = 10 * s->cfg.g_timebase.den; /* 1 keyframe each 10s. */
 	}
+	if (s->temporal_layers > 1) {
+		int i;
+		/* The layer of each frame is given with VP8E_SET_TEMPORAL_LAYER_ID, the pattern is only used for rate control.
+		 */
+		s->cfg.ts_number_layers = s->temporal_layers;
+		s->cfg.ts_periodicity = (s->temporal_layers == 2) ? 2 : 4;
+		for (i = 0; i < (int)s->cfg.ts_periodicity; i++) {
+			s->cfg.ts_layer_id[i] = ms_video_get_temporal_layer_id(s->temporal_layers, i);
+		}
+		for (i = 0; i < s->temporal_layers; i++) {
+			s->cfg.ts_target_bitrate[i] =
+			    (unsigned int)((float)s->cfg.rc_target_bitrate *
+			                   ms_video_get_temporal_layer_bitrate_ratio(s->temporal_layers, i));
+			s->cfg.ts_rate_decimator[i] = 1 << (s->temporal_layers - 1 - i);
+		}
+		ms_message("VP8 encoder using %i temporal layers", s->temporal_layers);
+	}
 #if TARGET_IPHONE_SIMULATOR
 	s->cfg.g_threads = 1; /*workaround to remove crash on ipad simulator*/
 #else
 	// We don't need more than 4 threads for encoder and we have to free thread space for decoders. This limitation is
 	// due to the inefficiency of spinlocks used by the libvpx.
-	s->cfg.g_threads = MIN(MAX(ms_factory_get_cpu_count(f->factory) - 2, 1), 4);
+	// The thread budget of the factory is shared by all the running video codecs.
+	s->cfg.g_threads = ms_factory_get_video_codec_thread_count(f->factory, 4);
 #endif
 	ms_message("VP8 g_threads=%d", s->cfg.g_threads);
 	s->cfg.rc_undershoot_pct = 95; /* --undershoot-pct=95 */
@@ -238,6 +265,9 @@ static void enc_init_impl(MSFilter *f) {
 static void enc_preprocess(MSFilter *f) {
 	EncState *s = (EncState *)f->data;
 
+	s->process_thread = ms_factory_acquire_video_codec_worker(f->factory);
+	s->queueing_delay_max = 0;
+	s->queueing_delay_avg = 0;
 	enc_init_impl(f);
 	s->invalid_frame_reported = FALSE;
 	vp8rtpfmt_packer_init(&s->packer, ms_factory_get_payload_max_size(f->factory));
@@ -247,7 +277,6 @@ static void enc_preprocess(MSFilter *f) {
 		ms_video_starter_init(&s->starter);
 	}
 
-	s->process_thread = ms_worker_thread_new("MSVp8Enc");
 	qinit(&s->entry_q);
 	s->exit_q = ms_queue_new(0, 0, 0, 0);
 	s->ready = TRUE;
@@ -461,11 +490,32 @@ static bool_t is_frame_independent(unsigned int flags) {
 	return FALSE;
 }
 
+static int enc_fill_temporal_layer_flags(EncState *s, unsigned int *flags) {
+	int tid;
+
+	if (s->temporal_layers <= 1) return 0;
+	/* Keyframes belong to the base layer and restart the layer pattern. */
+	if (*flags & VPX_EFLAG_FORCE_KF) {
+		s->layer_frame_index = 0;
+		return 0;
+	}
+	/* Frames refreshing the golden or altref frames belong to the base layer, whatever their position. */
+	if (*flags & (VP8_EFLAG_FORCE_GF | VP8_EFLAG_FORCE_ARF)) return 0;
+	tid = ms_video_get_temporal_layer_id(s->temporal_layers, s->layer_frame_index);
+	if (tid > 0) {
+		/* Upper layer frames are never used as reference, so that they can be dropped by a router. As the reference
+		 * frames are only refreshed by the base layer, they also only depend on the base layer. */
+		*flags |= VP8_EFLAG_NO_UPD_LAST | VP8_EFLAG_NO_UPD_GF | VP8_EFLAG_NO_UPD_ARF | VP8_EFLAG_NO_UPD_ENTROPY;
+	}
+	return tid;
+}
+
 static bool_t enc_process_frame_task(void *obj) {
 	mblk_t *im, *prev_im = NULL;
 	MSFilter *f = (MSFilter *)obj;
 	EncState *s = (EncState *)f->data;
 	unsigned int flags = 0;
+	int tid = 0;
 	vpx_codec_err_t err;
 	MSPicture yuv;
 	bool_t is_ref_frame = FALSE;
@@ -473,6 +523,12 @@ static bool_t enc_process_frame_task(void *obj) {
 	int skipped_count = 0;
 
 	ms_filter_lock(f);
+	if (s->entry_q.q_mcount > 0) {
+		/* Time spent waiting for the worker thread, that may be busy with other encoders. */
+		uint64_t delay = bctbx_get_cur_time_ms() - s->entry_time;
+		if (delay > s->queueing_delay_max) s->queueing_delay_max = delay;
+		s->queueing_delay_avg = 0.9f * s->queueing_delay_avg + 0.1f * (float)delay;
+	}
 	while ((im = getq(&s->entry_q)) != NULL) {
 		if (prev_im) {
 			freemsg(prev_im);
@@ -519,6 +575,9 @@ static bool_t enc_process_frame_task(void *obj) {
 	           s->frames_state.altref.picture_id, (s->frames_state.altref.acknowledged == TRUE) ? "Y" : "N");
 #endif
 	ms_mutex_lock(&s->vp8_mutex);
+	/* Under the lock, as the encoder may be re-created meanwhile, which restarts the layer pattern. */
+	tid = enc_fill_temporal_layer_flags(s, &flags);
+	if (s->temporal_layers > 1) vpx_codec_control(&s->codec, VP8E_SET_TEMPORAL_LAYER_ID, tid);
 	err = vpx_codec_encode(
 	    &s->codec, &img, s->frame_count, 1, flags,
 	    (unsigned long)((double)1000000 /
@@ -549,7 +608,7 @@ static bool_t enc_process_frame_task(void *obj) {
 		} else if (flags & VP8_EFLAG_FORCE_ARF) {
 			enc_mark_reference_frame_as_sent(s, VP8_ALTR_FRAME);
 			is_ref_frame = TRUE;
-		} else if (flags & VP8_EFLAG_NO_REF_LAST) {
+		} else if ((flags & VP8_EFLAG_NO_REF_LAST) && !(flags & VP8_EFLAG_NO_UPD_LAST)) {
 			enc_mark_reference_frame_as_sent(s, VP8_LAST_FRAME);
 			is_ref_frame = is_reconstruction_frame_sane(s, flags);
 		}
@@ -562,14 +621,29 @@ static bool_t enc_process_frame_task(void *obj) {
 			if ((pkt->kind == VPX_CODEC_CX_FRAME_PKT) && (pkt->data.frame.sz > 0)) {
 				Vp8RtpFmtPacket *packet = ms_new0(Vp8RtpFmtPacket, 1);
 
+				if (list == NULL && s->temporal_layers > 1) {
+					/* A keyframe placed by the encoder itself refreshes all the references: it belongs to the base
+					 * layer and restarts the layer pattern, wherever it falls. */
+					if (pkt->data.frame.flags & VPX_FRAME_IS_KEY) {
+						tid = 0;
+						s->layer_frame_index = 0;
+					}
+					/* TL0PICIDX is the index of the last base layer frame, upper layer frames carry the one they
+					 * depend on. */
+					if (tid == 0) s->tl0picidx++;
+				}
+
 				packet->m = allocb(pkt->data.frame.sz, 0);
 				memcpy(packet->m->b_wptr, pkt->data.frame.buf, pkt->data.frame.sz);
 				packet->m->b_wptr += pkt->data.frame.sz;
 				mblk_set_timestamp_info(packet->m, mblk_get_timestamp_info(im));
 				mblk_set_independent_flag(packet->m, (pkt->data.frame.flags & VPX_FRAME_IS_KEY));
-				mblk_set_discardable_flag(packet->m, (pkt->data.frame.flags & VPX_FRAME_IS_DROPPABLE));
+				mblk_set_discardable_flag(packet->m, (pkt->data.frame.flags & VPX_FRAME_IS_DROPPABLE) || tid > 0);
+				mblk_set_base_layer_sync_flag(packet->m, (tid > 0));
+				mblk_set_temporal_layer_id(packet->m, tid);
+				mblk_set_scalable_flag(packet->m, (s->temporal_layers > 1));
 				packet->pd = ms_new0(Vp8RtpFmtPayloadDescriptor, 1);
-				packet->pd->non_reference_frame = s->avpf_enabled && !is_ref_frame;
+				packet->pd->non_reference_frame = (s->avpf_enabled && !is_ref_frame) || tid > 0;
 				if (s->avpf_enabled == TRUE) {
 					packet->pd->extended_control_bits_present = TRUE;
 					packet->pd->pictureid_present = TRUE;
@@ -578,6 +652,14 @@ static bool_t enc_process_frame_task(void *obj) {
 					packet->pd->extended_control_bits_present = FALSE;
 					packet->pd->pictureid_present = FALSE;
 				}
+				if (s->temporal_layers > 1) {
+					packet->pd->extended_control_bits_present = TRUE;
+					packet->pd->tl0picidx_present = TRUE;
+					packet->pd->tl0picidx = s->tl0picidx;
+					packet->pd->tid_present = TRUE;
+					packet->pd->tid = (uint8_t)tid;
+					packet->pd->layer_sync = tid > 0;
+				}
 				if (s->flags & VPX_CODEC_USE_OUTPUT_PARTITION) {
 					if (pkt->data.frame.partition_id != current_partition_id) {
 						current_partition_id = pkt->data.frame.partition_id;
@@ -617,6 +699,7 @@ static bool_t enc_process_frame_task(void *obj) {
 
 		/* Handle video starter if AVPF is not enabled. */
 		s->frame_count++;
+		s->layer_frame_index++;
 		if ((s->avpf_enabled != TRUE) && (s->frame_count == 1)) {
 			ms_video_starter_first_frame(&s->starter, f->ticker->time);
 		}
@@ -660,6 +743,7 @@ static void enc_process(MSFilter *f) {
 			         s->vconf.vsize.height);
 		} else {
 			ms_queue_remove(f->inputs[0], entry_f);
+			if (s->entry_q.q_mcount == 0) s->entry_time = bctbx_get_cur_time_ms();
 			putq(&s->entry_q, entry_f);
 			if (!f->ticker->params.no_real_time) {
 				ms_worker_thread_add_task(s->process_thread, enc_process_frame_task, (void *)f);
@@ -683,8 +767,14 @@ static void enc_process(MSFilter *f) {
 
 static void enc_postprocess(MSFilter *f) {
 	EncState *s = (EncState *)f->data;
-	ms_worker_thread_destroy(s->process_thread, FALSE);
+	/* The frames not encoded yet are dropped, the pending tasks will find nothing to do. */
+	ms_filter_lock(f);
+	flushq(&s->entry_q, 0);
+	ms_filter_unlock(f);
+	ms_factory_release_video_codec_worker(f->factory, s->process_thread);
 	s->process_thread = NULL;
+	ms_message("VP8 encoder [%p]: queueing delay before encoding avg=%.1f ms, max=%llu ms", f, s->queueing_delay_avg,
+	           (unsigned long long)s->queueing_delay_max);
 	if (s->ready) vpx_codec_destroy(&s->codec);
 	vp8rtpfmt_packer_uninit(&s->packer);
 	flushq(&s->entry_q, 0);
@@ -863,6 +953,22 @@ static int enc_enable_screen_content_mode(MSFilter *f, void *data) {
 	return 0;
 }
 
+static int enc_set_temporal_layers(MSFilter *f, void *data) {
+	EncState *s = (EncState *)f->data;
+	int layers = *(int *)data;
+
+	if (layers < 1 || layers > MS_VIDEO_MAX_TEMPORAL_LAYERS) {
+		ms_error("VP8: unsupported number of temporal layers: %i", layers);
+		return -1;
+	}
+	if (s->ready && layers != s->temporal_layers) {
+		ms_warning("VP8: cannot change the number of temporal layers while the encoder is running");
+		return -1;
+	}
+	s->temporal_layers = layers;
+	return 0;
+}
+
 static MSFilterMethod enc_methods[] = {{MS_FILTER_REQ_VFU, enc_req_vfu},
                                        {MS_VIDEO_ENCODER_REQ_VFU, enc_req_vfu},
                                        {MS_VIDEO_ENCODER_NOTIFY_PLI, enc_notify_pli},
@@ -874,6 +980,7 @@ static MSFilterMethod enc_methods[] = {{MS_FILTER_REQ_VFU, enc_req_vfu},
                                        {MS_VIDEO_ENCODER_SET_CONFIGURATION, enc_set_configuration},
                                        {MS_VIDEO_ENCODER_ENABLE_AVPF, enc_enable_avpf},
                                        {MS_VIDEO_ENCODER_ENABLE_SCREEN_CONTENT_MODE, enc_enable_screen_content_mode},
+                                       {MS_VIDEO_ENCODER_SET_TEMPORAL_LAYERS, enc_set_temporal_layers},
                                        {0, NULL}};
 
 #define MS_VP8_ENC_NAME "MSVp8Enc"
@@ -2655,7 +2655,10 @@ float audio_stream_get_average_lq_quality_rating(AudioStream *stream) {
 
 void audio_stream_enable_zrtp(AudioStream *stream, MSZrtpParams *params) {
 	if (stream->ms.sessions.zrtp_context == NULL) {
-		stream->ms.sessions.zrtp_context = ms_zrtp_context_new(&(stream->ms.sessions), params);
+		MSZrtpParams params_copy = *params;
+		/* Keep the key agreement off the ticker thread. */
+		if (params_copy.factory == NULL) params_copy.factory = stream->ms.factory;
+		stream->ms.sessions.zrtp_context = ms_zrtp_context_new(&(stream->ms.sessions), &params_copy);
 	} else if (!media_stream_secured(&stream->ms)) {
 		ms_zrtp_reset_transmition_timer(stream->ms.sessions.zrtp_context);
 	}
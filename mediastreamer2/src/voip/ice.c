@@ -50,6 +50,7 @@
 #define ICE_MAX_RETRANSMISSIONS 7
 #define ICE_MAX_RETRANSMISSIONS_FOR_NOMINATIONS 5
 #define ICE_MAX_STUN_REQUEST_RETRANSMISSIONS 7
+#define ICE_VALID_PAIR_KEEPALIVE_PERIOD 3000 /* In milliseconds */
 
 typedef struct _TransportAddress_ComponentID {
 	const IceTransportAddress *ta;
@@ -126,9 +127,22 @@ typedef struct _ComponentID_Family {
 	int family;
 } ComponentID_Family;
 
+typedef unsigned int (*IceIndexHashFunc)(const void *item);
+
+/* Hash table of pointers to the items of one of the lists of a check list. The list stays the reference: the index is
+ * updated incrementally while it is clean, and rebuilt from the list on the next lookup once it has been marked dirty. */
+struct _IceIndex {
+	bctbx_list_t **buckets;
+	unsigned int nb_buckets; /* Always a power of two. */
+	unsigned int nb_items;
+	IceIndexHashFunc hash;
+	bool_t dirty;
+};
+
 static MSTimeSpec ice_current_time(void);
 static MSTimeSpec ice_add_ms(MSTimeSpec orig, uint32_t ms);
 static int32_t ice_compare_time(MSTimeSpec ts1, MSTimeSpec ts2);
+static void ice_schedule_timer(MSTimeSpec *timer, MSTimeSpec time);
 static void transactionID2string(const UInt96 *tr_id, char *tr_id_str);
 static IceStunServerRequest *ice_stun_server_request_new(IceCheckList *cl,
                                                          MSTurnContext *turn_context,
@@ -148,6 +162,12 @@ static int ice_compare_transport_addresses(const IceTransportAddress *ta1, const
 static int ice_compare_pair_priorities(const IceCandidatePair *p1, const IceCandidatePair *p2);
 static int ice_compare_pairs(const IceCandidatePair *p1, const IceCandidatePair *p2);
 static int ice_compare_candidates(const IceCandidate *c1, const IceCandidate *c2);
+static int ice_find_candidate_from_transport_address(const IceCandidate *candidate, const IceTransportAddress *taddr);
+static int ice_find_candidate_from_transport_address_and_componentID(const IceCandidate *candidate,
+                                                                     const TransportAddress_ComponentID *taci);
+static int ice_find_pair_from_candidates(const IceCandidatePair *pair,
+                                         const LocalCandidate_RemoteCandidate *candidates);
+static int ice_find_pair_from_transactionID(const IceTransaction *transaction, const UInt96 *transactionID);
 static int ice_find_host_candidate(const IceCandidate *candidate, const ComponentID_Family *cf);
 static int ice_find_candidate_from_type_and_componentID(const IceCandidate *candidate, const Type_ComponentID *tc);
 static int ice_find_candidate_from_type_family_and_componentID(const IceCandidate *candidate,
@@ -291,6 +311,193 @@ void ice_session_enable_message_integrity_check(IceSession *session, bool_t enab
 	session->check_message_integrity = enable;
 }
 
+/******************************************************************************
+ * INDEXES                                                                    *
+ *****************************************************************************/
+
+#define ICE_INDEX_INITIAL_NB_BUCKETS 16
+#define ICE_INDEX_HASH_SEED 2166136261u
+
+static unsigned int ice_hash_bytes(unsigned int hash, const void *data, size_t len) {
+	/* FNV-1a */
+	const unsigned char *bytes = (const unsigned char *)data;
+	size_t i;
+	for (i = 0; i < len; i++) {
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static unsigned int ice_hash_transport_address(const IceTransportAddress *taddr) {
+	unsigned int hash = ice_hash_bytes(ICE_INDEX_HASH_SEED, taddr->ip, strlen(taddr->ip));
+	hash = ice_hash_bytes(hash, &taddr->port, sizeof(taddr->port));
+	return ice_hash_bytes(hash, &taddr->family, sizeof(taddr->family));
+}
+
+static unsigned int ice_hash_candidate_transport_address(const IceCandidate *candidate) {
+	return ice_hash_transport_address(&candidate->taddr);
+}
+
+static unsigned int ice_hash_candidates(const IceCandidate *local, const IceCandidate *remote) {
+	unsigned int hash = ice_hash_bytes(ICE_INDEX_HASH_SEED, &local, sizeof(local));
+	return ice_hash_bytes(hash, &remote, sizeof(remote));
+}
+
+static unsigned int ice_hash_pair_candidates(const IceCandidatePair *pair) {
+	return ice_hash_candidates(pair->local, pair->remote);
+}
+
+static unsigned int ice_hash_pair_transport_addresses(const IceCandidatePair *pair) {
+	return ice_hash_transport_address(&pair->local->taddr) * 31 + ice_hash_transport_address(&pair->remote->taddr);
+}
+
+static unsigned int ice_hash_pair_foundation(const IcePairFoundation *foundation) {
+	unsigned int hash = ice_hash_bytes(ICE_INDEX_HASH_SEED, foundation->local, strlen(foundation->local) + 1);
+	return ice_hash_bytes(hash, foundation->remote, strlen(foundation->remote));
+}
+
+static unsigned int ice_hash_transaction_id(const UInt96 *tr_id) {
+	return ice_hash_bytes(ICE_INDEX_HASH_SEED, tr_id->octet, sizeof(tr_id->octet));
+}
+
+static unsigned int ice_hash_transaction(const IceTransaction *transaction) {
+	return ice_hash_transaction_id(&transaction->transactionID);
+}
+
+static int ice_compare_pointers(const void *p1, const void *p2) {
+	return p1 != p2;
+}
+
+static IceIndex *ice_index_new(IceIndexHashFunc hash) {
+	IceIndex *index = ms_new0(IceIndex, 1);
+	index->nb_buckets = ICE_INDEX_INITIAL_NB_BUCKETS;
+	index->buckets = ms_new0(bctbx_list_t *, index->nb_buckets);
+	index->hash = hash;
+	return index;
+}
+
+/* Empty the index. Use it when the indexed list itself has been emptied. */
+static void ice_index_clear(IceIndex *index) {
+	unsigned int i;
+	for (i = 0; i < index->nb_buckets; i++) {
+		index->buckets[i] = bctbx_list_free(index->buckets[i]);
+	}
+	index->nb_items = 0;
+	index->dirty = FALSE;
+}
+
+static void ice_index_destroy(IceIndex *index) {
+	if (index == NULL) return;
+	ice_index_clear(index);
+	ms_free(index->buckets);
+	ms_free(index);
+}
+
+/* Mark the index as out of date, for list changes that are not worth tracking one by one. */
+static void ice_index_invalidate(IceIndex *index) {
+	index->dirty = TRUE;
+}
+
+static void ice_index_grow(IceIndex *index) {
+	unsigned int old_nb_buckets = index->nb_buckets;
+	bctbx_list_t **old_buckets = index->buckets;
+	bctbx_list_t *elem;
+	unsigned int i;
+
+	index->nb_buckets *= 2;
+	index->buckets = ms_new0(bctbx_list_t *, index->nb_buckets);
+	/* Items sharing a bucket keep their relative order, so that lookups still return the first match of the list. */
+	for (i = 0; i < old_nb_buckets; i++) {
+		for (elem = old_buckets[i]; elem != NULL; elem = elem->next) {
+			unsigned int bucket = index->hash(elem->data) & (index->nb_buckets - 1);
+			index->buckets[bucket] = bctbx_list_append(index->buckets[bucket], elem->data);
+		}
+		bctbx_list_free(old_buckets[i]);
+	}
+	ms_free(old_buckets);
+}
+
+static void ice_index_insert(IceIndex *index, void *item) {
+	unsigned int bucket;
+	if (index->nb_items >= 2 * index->nb_buckets) ice_index_grow(index);
+	bucket = index->hash(item) & (index->nb_buckets - 1);
+	index->buckets[bucket] = bctbx_list_append(index->buckets[bucket], item);
+	index->nb_items++;
+}
+
+/* Track an item appended to the indexed list. */
+static void ice_index_add(IceIndex *index, void *item) {
+	if (!index->dirty) ice_index_insert(index, item);
+}
+
+/* Track an item removed from the indexed list. It must still be valid since it is hashed again. */
+static void ice_index_remove(IceIndex *index, void *item) {
+	bctbx_list_t **bucket;
+	if (index->dirty) return;
+	bucket = &index->buckets[index->hash(item) & (index->nb_buckets - 1)];
+	if (bctbx_list_find(*bucket, item) != NULL) {
+		*bucket = bctbx_list_remove(*bucket, item);
+		index->nb_items--;
+	}
+}
+
+/* Equivalent to bctbx_list_find_custom(list, compare_func, key), provided that every item of the list matching key has
+ * the given hash. */
+static void *ice_index_lookup(
+    IceIndex *index, const bctbx_list_t *list, unsigned int hash, bctbx_compare_func compare_func, const void *key) {
+	bctbx_list_t *elem;
+	if (index->dirty) {
+		ice_index_clear(index);
+		for (; list != NULL; list = list->next) {
+			ice_index_insert(index, list->data);
+		}
+	}
+	elem = bctbx_list_find_custom(index->buckets[hash & (index->nb_buckets - 1)], compare_func, key);
+	return (elem != NULL) ? elem->data : NULL;
+}
+
+static void ice_check_list_init_indexes(IceCheckList *cl) {
+	cl->local_candidates_index = ice_index_new((IceIndexHashFunc)ice_hash_candidate_transport_address);
+	cl->remote_candidates_index = ice_index_new((IceIndexHashFunc)ice_hash_candidate_transport_address);
+	cl->pairs_index = ice_index_new((IceIndexHashFunc)ice_hash_pair_candidates);
+	cl->check_list_index = ice_index_new((IceIndexHashFunc)ice_hash_pair_candidates);
+	cl->transactions_index = ice_index_new((IceIndexHashFunc)ice_hash_transaction);
+}
+
+static void ice_check_list_destroy_indexes(IceCheckList *cl) {
+	ice_index_destroy(cl->local_candidates_index);
+	ice_index_destroy(cl->remote_candidates_index);
+	ice_index_destroy(cl->pairs_index);
+	ice_index_destroy(cl->check_list_index);
+	ice_index_destroy(cl->transactions_index);
+}
+
+static IceCandidate *ice_find_local_candidate(IceCheckList *cl, const IceTransportAddress *taddr) {
+	return (IceCandidate *)ice_index_lookup(cl->local_candidates_index, cl->local_candidates,
+	                                        ice_hash_transport_address(taddr),
+	                                        (bctbx_compare_func)ice_find_candidate_from_transport_address, taddr);
+}
+
+static IceCandidate *
+ice_find_candidate_in_index(IceIndex *index, const bctbx_list_t *list, const TransportAddress_ComponentID *taci) {
+	return (IceCandidate *)ice_index_lookup(
+	    index, list, ice_hash_transport_address(taci->ta),
+	    (bctbx_compare_func)ice_find_candidate_from_transport_address_and_componentID, taci);
+}
+
+static IceCandidatePair *
+ice_find_pair_in_index(IceIndex *index, const bctbx_list_t *list, const LocalCandidate_RemoteCandidate *candidates) {
+	return (IceCandidatePair *)ice_index_lookup(index, list, ice_hash_candidates(candidates->local, candidates->remote),
+	                                            (bctbx_compare_func)ice_find_pair_from_candidates, candidates);
+}
+
+static IceTransaction *ice_find_transaction_from_id(IceCheckList *cl, const UInt96 *tr_id) {
+	return (IceTransaction *)ice_index_lookup(cl->transactions_index, cl->transaction_list,
+	                                          ice_hash_transaction_id(tr_id),
+	                                          (bctbx_compare_func)ice_find_pair_from_transactionID, tr_id);
+}
+
 /******************************************************************************
  * CHECK LIST INITIALISATION AND DEINITIALISATION                             *
  *****************************************************************************/
@@ -311,8 +518,11 @@ static void ice_check_list_init(IceCheckList *cl) {
 	cl->nomination_delay_running = FALSE;
 	cl->ta_time = ice_current_time();
 	memset(&cl->keepalive_time, 0, sizeof(cl->keepalive_time));
+	memset(&cl->retransmission_time, 0, sizeof(cl->retransmission_time));
+	memset(&cl->valid_pairs_keepalive_time, 0, sizeof(cl->valid_pairs_keepalive_time));
 	memset(&cl->gathering_start_time, 0, sizeof(cl->gathering_start_time));
 	memset(&cl->nomination_delay_start_time, 0, sizeof(cl->nomination_delay_start_time));
+	ice_check_list_init_indexes(cl);
 }
 
 IceCheckList *ice_check_list_new(void) {
@@ -377,6 +587,7 @@ static void ice_free_candidate_pair(IceCandidatePair *pair, IceCheckList *cl) {
 	bctbx_list_t *elem;
 	while ((elem = bctbx_list_find(cl->check_list, pair)) != NULL) {
 		cl->check_list = bctbx_list_remove(cl->check_list, pair);
+		ice_index_remove(cl->check_list_index, pair);
 	}
 	while ((elem = bctbx_list_find_custom(cl->valid_list, (bctbx_compare_func)ice_find_pair_in_valid_list, pair)) !=
 	       NULL) {
@@ -425,6 +636,7 @@ void ice_check_list_destroy(IceCheckList *cl) {
 	bctbx_list_free(cl->pairs);
 	bctbx_list_free(cl->remote_candidates);
 	bctbx_list_free(cl->local_candidates);
+	ice_check_list_destroy_indexes(cl);
 	memset(cl, 0, sizeof(IceCheckList));
 	ms_free(cl);
 }
@@ -1349,6 +1561,7 @@ static IceTransaction *ice_create_transaction(IceCheckList *cl, IceCandidatePair
 	transaction->pair = pair;
 	transaction->transactionID = tr_id;
 	cl->transaction_list = bctbx_list_prepend(cl->transaction_list, transaction);
+	ice_index_add(cl->transactions_index, transaction);
 	return transaction;
 }
 
@@ -1737,6 +1950,7 @@ static void ice_send_binding_request(IceCheckList *cl, IceCandidatePair *pair, c
 			/* Change the state of the pair. */
 			ice_pair_set_state(pair, ICP_InProgress);
 		}
+		ice_schedule_timer(&cl->retransmission_time, ice_add_ms(pair->transmission_time, pair->rto));
 	}
 	if (buf != NULL) ms_free(buf);
 	ms_stun_message_destroy(msg);
@@ -1974,7 +2188,7 @@ static void ice_send_keepalive_packet_for_componentID(const uint16_t *componentI
 
 static void
 ice_check_keep_alive_on_valid_pair(IceValidCandidatePair *valid, RtpSession *rtp_session, const MSTimeSpec *curtime) {
-	if (ice_compare_time(*curtime, valid->last_keepalive) >= 3000) {
+	if (ice_compare_time(*curtime, valid->last_keepalive) >= ICE_VALID_PAIR_KEEPALIVE_PERIOD) {
 		ice_send_indication(valid->valid, rtp_session);
 		valid->last_keepalive = *curtime;
 	}
@@ -1991,10 +2205,15 @@ static void ice_send_keepalive_packets(IceCheckList *cl, RtpSession *rtp_session
 		bctbx_list_t *elem;
 		MSTimeSpec curtime;
 		ms_get_cur_time(&curtime);
+		/* Valid pairs are added with a fresh keepalive time, so none of them is due before this time. */
+		if (ice_compare_time(curtime, cl->valid_pairs_keepalive_time) < 0) return;
+		cl->valid_pairs_keepalive_time = ice_add_ms(curtime, ICE_VALID_PAIR_KEEPALIVE_PERIOD);
 		/*refresh pairs on the valid list, to keep them alive until conclusion*/
 		for (elem = cl->valid_list; elem != NULL; elem = elem->next) {
 			IceValidCandidatePair *valid = (IceValidCandidatePair *)elem->data;
 			ice_check_keep_alive_on_valid_pair(valid, rtp_session, &curtime);
+			ice_schedule_timer(&cl->valid_pairs_keepalive_time,
+			                   ice_add_ms(valid->last_keepalive, ICE_VALID_PAIR_KEEPALIVE_PERIOD));
 		}
 	}
 }
@@ -2186,7 +2405,6 @@ static IceCandidate *ice_learn_peer_reflexive_candidate(IceCheckList *cl,
                                                         const IceTransportAddress *taddr) {
 	char foundation[32];
 	IceCandidate *candidate = NULL;
-	bctbx_list_t *elem;
 	int componentID;
 	TransportAddress_ComponentID taci;
 
@@ -2195,9 +2413,7 @@ static IceCandidate *ice_learn_peer_reflexive_candidate(IceCheckList *cl,
 
 	taci.ta = taddr;
 	taci.componentID = componentID;
-	elem = bctbx_list_find_custom(cl->remote_candidates,
-	                              (bctbx_compare_func)ice_find_candidate_from_transport_address_and_componentID, &taci);
-	if (elem == NULL) {
+	if (ice_find_candidate_in_index(cl->remote_candidates_index, cl->remote_candidates, &taci) == NULL) {
 		ms_message("ice: Learned peer reflexive candidate %s:%d for componentID %d", taddr->ip, taddr->port,
 		           componentID);
 		/* Add peer reflexive candidate to the remote candidates list. */
@@ -2222,7 +2438,6 @@ static IceCandidatePair *ice_trigger_connectivity_check_on_binding_request(IceCh
                                                                            const IceTransportAddress *remote_taddr) {
 	IceTransportAddress local_taddr;
 	LocalCandidate_RemoteCandidate candidates;
-	bctbx_list_t *elem;
 	IceCandidatePair *pair = NULL;
 	struct sockaddr_storage recv_addr;
 	socklen_t recv_addrlen = sizeof(recv_addr);
@@ -2233,53 +2448,47 @@ static IceCandidatePair *ice_trigger_connectivity_check_on_binding_request(IceCh
 	ortp_recvaddr_to_sockaddr(&evt_data->packet->recv_addr, (struct sockaddr *)&recv_addr, &recv_addrlen);
 	bctbx_sockaddr_ipv6_to_ipv4((struct sockaddr *)&recv_addr, (struct sockaddr *)&recv_addr, &recv_addrlen);
 	ice_fill_transport_address_from_sockaddr(&local_taddr, (struct sockaddr *)&recv_addr, recv_addrlen);
-	elem = bctbx_list_find_custom(cl->local_candidates, (bctbx_compare_func)ice_find_candidate_from_transport_address,
-	                              &local_taddr);
-	if (elem == NULL) {
+	candidates.local = ice_find_local_candidate(cl, &local_taddr);
+	if (candidates.local == NULL) {
 		ice_transport_address_to_printable_ip_address(&local_taddr, addr_str, sizeof(addr_str));
 		ms_error("ice: Local candidate %s not found!", addr_str);
 		return NULL;
 	}
-	candidates.local = (IceCandidate *)elem->data;
 	if (prflx_candidate != NULL) {
 		candidates.remote = prflx_candidate;
 	} else {
 		TransportAddress_ComponentID taci;
 		taci.componentID = candidates.local->componentID;
 		taci.ta = remote_taddr;
-		elem = bctbx_list_find_custom(cl->remote_candidates,
-		                              (bctbx_compare_func)ice_find_candidate_from_transport_address_and_componentID,
-		                              &taci);
-		if (elem == NULL) {
+		candidates.remote = ice_find_candidate_in_index(cl->remote_candidates_index, cl->remote_candidates, &taci);
+		if (candidates.remote == NULL) {
 			ice_transport_address_to_printable_ip_address(remote_taddr, addr_str, sizeof(addr_str));
 			ms_error("ice: Remote candidate %s not found!", addr_str);
 			return NULL;
 		}
-		candidates.remote = (IceCandidate *)elem->data;
 	}
-	elem = bctbx_list_find_custom(cl->check_list, (bctbx_compare_func)ice_find_pair_from_candidates, &candidates);
-	if (elem == NULL) {
+	pair = ice_find_pair_in_index(cl->check_list_index, cl->check_list, &candidates);
+	if (pair == NULL) {
 		/* The pair is not in the check list yet. */
 		ms_message("ice: Add new candidate pair [%p - %p] in the check list", candidates.local, candidates.remote);
 		/* Check if the pair is in the list of pairs even if it is not in the check list. */
-		elem = bctbx_list_find_custom(cl->pairs, (bctbx_compare_func)ice_find_pair_from_candidates, &candidates);
-		if (elem == NULL) {
+		pair = ice_find_pair_in_index(cl->pairs_index, cl->pairs, &candidates);
+		if (pair == NULL) {
 			pair = ice_pair_new(cl, candidates.local, candidates.remote);
 			cl->pairs = bctbx_list_append(cl->pairs, pair);
-		} else {
-			pair = (IceCandidatePair *)elem->data;
+			ice_index_add(cl->pairs_index, pair);
 		}
-		elem = bctbx_list_find(cl->check_list, pair);
-		if (elem == NULL) {
+		if (ice_index_lookup(cl->check_list_index, cl->check_list, ice_hash_pair_candidates(pair), ice_compare_pointers,
+		                     pair) == NULL) {
 			cl->check_list =
 			    bctbx_list_insert_sorted(cl->check_list, pair, (bctbx_compare_func)ice_compare_pair_priorities);
+			ice_index_add(cl->check_list_index, pair);
 		}
 		/* Set the state of the pair to Waiting and trigger a check. */
 		ice_pair_set_state(pair, ICP_Waiting);
 		ice_check_list_queue_triggered_check(cl, pair);
 	} else {
 		/* The pair has been found in the check list. */
-		pair = (IceCandidatePair *)elem->data;
 		switch (pair->state) {
 			case ICP_Waiting:
 			case ICP_Frozen:
@@ -2454,7 +2663,6 @@ ice_discover_peer_reflexive_candidate(IceCheckList *cl, const IceCandidatePair *
 	IceTransportAddress taddr;
 	const MSStunAddress *xor_mapped_address;
 	IceCandidate *candidate = NULL;
-	bctbx_list_t *elem;
 	char taddr_str[64];
 	TransportAddress_ComponentID taci;
 
@@ -2463,9 +2671,8 @@ ice_discover_peer_reflexive_candidate(IceCheckList *cl, const IceCandidatePair *
 	ice_fill_transport_address_from_stun_address(&taddr, xor_mapped_address);
 	taci.componentID = pair->local->componentID;
 	taci.ta = &taddr;
-	elem = bctbx_list_find_custom(cl->local_candidates,
-	                              (bctbx_compare_func)ice_find_candidate_from_transport_address_and_componentID, &taci);
-	if (elem == NULL) {
+	candidate = ice_find_candidate_in_index(cl->local_candidates_index, cl->local_candidates, &taci);
+	if (candidate == NULL) {
 		memset(taddr_str, 0, sizeof(taddr_str));
 		ice_transport_address_to_printable_ip_address(&taddr, taddr_str, sizeof(taddr_str));
 		ms_message("ice: Discovered peer reflexive candidate %s for componentID %d", taddr_str,
@@ -2474,8 +2681,6 @@ ice_discover_peer_reflexive_candidate(IceCheckList *cl, const IceCandidatePair *
 		candidate = ice_add_local_candidate(cl, "prflx", taddr.family, taddr.ip, taddr.port, pair->local->componentID,
 		                                    pair->local);
 		ice_compute_candidate_foundation(candidate, cl);
-	} else {
-		candidate = (IceCandidate *)elem->data;
 	}
 	return candidate;
 }
@@ -2504,14 +2709,12 @@ static IceCandidatePair *ice_construct_valid_pair(IceCheckList *cl,
 
 	candidates.local = candidate;
 	candidates.remote = succeeded_pair->remote;
-	elem = bctbx_list_find_custom(cl->check_list, (bctbx_compare_func)ice_find_pair_from_candidates, &candidates);
-	if (elem == NULL) {
+	pair = ice_find_pair_in_index(cl->check_list_index, cl->check_list, &candidates);
+	if (pair == NULL) {
 		/* The candidate pair is not a known candidate pair, compute its priority and add it to the valid list. */
 		pair = ice_pair_new(cl, candidates.local, candidates.remote);
 		cl->pairs = bctbx_list_append(cl->pairs, pair);
-	} else {
-		/* The candidate pair is already in the check list, add it to the valid list. */
-		pair = (IceCandidatePair *)elem->data;
+		ice_index_add(cl->pairs_index, pair);
 	}
 	valid_pair = ms_new0(IceValidCandidatePair, 1);
 	valid_pair->valid = pair;
@@ -2899,7 +3102,6 @@ static void ice_handle_received_binding_response(IceCheckList *cl,
 	IceCandidatePair *succeeded_pair;
 	IceCandidatePair *valid_pair;
 	IceCandidate *candidate;
-	bctbx_list_t *elem;
 	IceTransaction *tr;
 	UInt96 tr_id = ms_stun_message_get_tr_id(msg);
 	char tr_id_str[25];
@@ -2911,13 +3113,12 @@ static void ice_handle_received_binding_response(IceCheckList *cl,
 			return;
 	}
 
-	elem = bctbx_list_find_custom(cl->transaction_list, (bctbx_compare_func)ice_find_pair_from_transactionID, &tr_id);
-	if (elem == NULL) {
+	tr = ice_find_transaction_from_id(cl, &tr_id);
+	if (tr == NULL) {
 		/* We received an a binding response concerning an unknown binding request, ignore it... */
 		ms_warning("ice: Received a binding response for an unknown transaction ID: %s", tr_id_str);
 		return;
 	}
-	tr = (IceTransaction *)elem->data;
 	if (tr->canceled) {
 		/* We received an binding response concerning a canceled binding request transaction*/
 		ms_message("ice: Received a binding response for a cancelled transaction ID: %s", tr_id_str);
@@ -2925,7 +3126,7 @@ static void ice_handle_received_binding_response(IceCheckList *cl,
 		 * consider the lack of response as a failure.*/
 	}
 
-	succeeded_pair = (IceCandidatePair *)((IceTransaction *)elem->data)->pair;
+	succeeded_pair = tr->pair;
 	if (ice_check_received_binding_response_addresses(rtp_session, evt_data, succeeded_pair, remote_addr) < 0) return;
 	if (ice_check_received_binding_response_attributes(msg, remote_addr, cl->session->check_message_integrity) < 0)
 		return;
@@ -2988,14 +3189,13 @@ static void ice_handle_received_error_response(IceCheckList *cl,
 		ice_handle_stun_server_error_response(cl, rtp_session, evt_data, msg);
 	} else {
 		UInt96 tr_id = ms_stun_message_get_tr_id(msg);
-		bctbx_list_t *elem =
-		    bctbx_list_find_custom(cl->transaction_list, (bctbx_compare_func)ice_find_pair_from_transactionID, &tr_id);
-		if (elem == NULL) {
+		IceTransaction *tr = ice_find_transaction_from_id(cl, &tr_id);
+		if (tr == NULL) {
 			/* We received an error response concerning an unknown binding request, ignore it... */
 			return;
 		}
 
-		pair = (IceCandidatePair *)((IceTransaction *)elem->data)->pair;
+		pair = tr->pair;
 		if (ms_stun_message_has_error_code(msg) &&
 		    (ms_stun_message_get_error_code(msg, NULL) == MS_STUN_ERROR_CODE_UNAUTHORIZED) &&
 		    pair->retry_with_dummy_message_integrity) {
@@ -3241,7 +3441,6 @@ IceCandidate *ice_add_local_candidate(IceCheckList *cl,
                                       int port,
                                       uint16_t componentID,
                                       IceCandidate *base) {
-	bctbx_list_t *elem;
 	IceCandidate *candidate;
 
 	if (bctbx_list_size(cl->local_candidates) >= ICE_MAX_NB_CANDIDATES) {
@@ -3252,8 +3451,9 @@ IceCandidate *ice_add_local_candidate(IceCheckList *cl,
 	candidate = ice_candidate_new(type, family, ip, port, componentID);
 	if (candidate->base == NULL) candidate->base = base;
 
-	elem = bctbx_list_find_custom(cl->local_candidates, (bctbx_compare_func)ice_compare_candidates, candidate);
-	if (elem != NULL) {
+	if (ice_index_lookup(cl->local_candidates_index, cl->local_candidates,
+	                     ice_hash_candidate_transport_address(candidate), (bctbx_compare_func)ice_compare_candidates,
+	                     candidate) != NULL) {
 		/* This candidate is already in the list, do not add it again. */
 		ms_free(candidate);
 		return NULL;
@@ -3261,6 +3461,7 @@ IceCandidate *ice_add_local_candidate(IceCheckList *cl,
 
 	ice_add_componentID(&cl->local_componentIDs, &candidate->componentID);
 	cl->local_candidates = bctbx_list_append(cl->local_candidates, candidate);
+	ice_index_add(cl->local_candidates_index, candidate);
 
 	return candidate;
 }
@@ -3320,10 +3521,9 @@ IceCandidate *ice_add_remote_candidate(IceCheckList *cl,
                                        uint32_t priority,
                                        const char *const foundation,
                                        bool_t is_default) {
-	bctbx_list_t *elem;
 	IceCandidate *candidate;
 
-	if (bctbx_list_size(cl->local_candidates) >= ICE_MAX_NB_CANDIDATES) {
+	if (bctbx_list_size(cl->remote_candidates) >= ICE_MAX_NB_CANDIDATES) {
 		ms_error("ice: Candidate list limited to %d candidates", ICE_MAX_NB_CANDIDATES);
 		return NULL;
 	}
@@ -3333,8 +3533,9 @@ IceCandidate *ice_add_remote_candidate(IceCheckList *cl,
 	 * candidates. */
 	if (priority != 0) candidate->priority = priority;
 
-	elem = bctbx_list_find_custom(cl->remote_candidates, (bctbx_compare_func)ice_compare_candidates, candidate);
-	if (elem != NULL) {
+	if (ice_index_lookup(cl->remote_candidates_index, cl->remote_candidates,
+	                     ice_hash_candidate_transport_address(candidate), (bctbx_compare_func)ice_compare_candidates,
+	                     candidate) != NULL) {
 		/* This candidate is already in the list, do not add it again. */
 		ms_free(candidate);
 		return NULL;
@@ -3344,6 +3545,7 @@ IceCandidate *ice_add_remote_candidate(IceCheckList *cl,
 	candidate->is_default = is_default;
 	ice_add_componentID(&cl->remote_componentIDs, &candidate->componentID);
 	cl->remote_candidates = bctbx_list_append(cl->remote_candidates, candidate);
+	ice_index_add(cl->remote_candidates_index, candidate);
 
 	return candidate;
 }
@@ -3396,9 +3598,8 @@ void ice_add_losing_pair(IceCheckList *cl,
 	taddr.family = local_family;
 	taci.componentID = componentID;
 	taci.ta = &taddr;
-	elem = bctbx_list_find_custom(cl->local_candidates,
-	                              (bctbx_compare_func)ice_find_candidate_from_transport_address_and_componentID, &taci);
-	if (elem == NULL) {
+	lr.local = ice_find_candidate_in_index(cl->local_candidates_index, cl->local_candidates, &taci);
+	if (lr.local == NULL) {
 		// Workaround to detect if the local candidate that has not been found has been added by the proxy server.
 		// If that is the case, add it to the local candidates now.
 		elem = bctbx_list_find_custom(cl->remote_candidates, (bctbx_compare_func)ice_find_candidate_from_ip_address,
@@ -3420,38 +3621,34 @@ void ice_add_losing_pair(IceCheckList *cl,
 			ms_warning("ice: Local candidate %s should have been found", taddr_str);
 			return;
 		}
-	} else {
-		lr.local = (IceCandidate *)elem->data;
 	}
 	snprintf(taddr.ip, sizeof(taddr.ip), "%s", remote_addr);
 	taddr.port = remote_port;
 	taddr.family = remote_family;
 	taci.componentID = componentID;
 	taci.ta = &taddr;
-	elem = bctbx_list_find_custom(cl->remote_candidates,
-	                              (bctbx_compare_func)ice_find_candidate_from_transport_address_and_componentID, &taci);
-	if (elem == NULL) {
+	lr.remote = ice_find_candidate_in_index(cl->remote_candidates_index, cl->remote_candidates, &taci);
+	if (lr.remote == NULL) {
 		ice_transport_address_to_printable_ip_address(&taddr, taddr_str, sizeof(taddr_str));
 		ms_warning("ice: Remote candidate %s should have been found", taddr_str);
 		return;
 	}
-	lr.remote = (IceCandidate *)elem->data;
 	if (added_missing_relay_candidate == TRUE) {
 		/* If we just added a missing relay candidate, also add the candidate pair. */
 		pair = ice_pair_new(cl, lr.local, lr.remote);
 		cl->pairs = bctbx_list_append(cl->pairs, pair);
+		ice_index_add(cl->pairs_index, pair);
 	}
-	elem = bctbx_list_find_custom(cl->pairs, (bctbx_compare_func)ice_find_pair_from_candidates, &lr);
-	if (elem == NULL) {
+	pair = ice_find_pair_in_index(cl->pairs_index, cl->pairs, &lr);
+	if (pair == NULL) {
 		if (added_missing_relay_candidate == FALSE) {
 			/* Candidate pair has not been created but the candidates exist.
 			It must be that the local candidate is a reflexive or relayed candidate.
 			Therefore create this pair and use it. */
 			pair = ice_pair_new(cl, lr.local, lr.remote);
 			cl->pairs = bctbx_list_append(cl->pairs, pair);
+			ice_index_add(cl->pairs_index, pair);
 		} else return;
-	} else {
-		pair = (IceCandidatePair *)elem->data;
 	}
 	elem = bctbx_list_find_custom(cl->valid_list, (bctbx_compare_func)ice_find_pair_in_valid_list, pair);
 	if (elem == NULL) {
@@ -3575,6 +3772,7 @@ static void ice_check_list_eliminate_redundant_candidates(IceCheckList *cl) {
 						ice_free_candidate(candidate);
 						cl->local_candidates = bctbx_list_erase_link(cl->local_candidates, elem);
 					}
+					ice_index_invalidate(cl->local_candidates_index);
 					elem_removed = TRUE;
 					break;
 				}
@@ -3701,6 +3899,7 @@ static void ice_form_candidate_pairs(IceCheckList *cl) {
 			    (local_candidate->taddr.family == remote_candidate->taddr.family)) {
 				pair = ice_pair_new(cl, local_candidate, remote_candidate);
 				cl->pairs = bctbx_list_append(cl->pairs, pair);
+				ice_index_add(cl->pairs_index, pair);
 			}
 			remote_list = bctbx_list_next(remote_list);
 		}
@@ -3729,13 +3928,17 @@ static int ice_compare_pairs(const IceCandidatePair *p1, const IceCandidatePair
 	         (ice_compare_candidates(p1->remote, p2->remote) == 0));
 }
 
-static int ice_prune_duplicate_pair(IceCandidatePair *pair, bctbx_list_t **pairs, IceCheckList *cl) {
-	bctbx_list_t *other_pair = bctbx_list_find_custom(*pairs, (bctbx_compare_func)ice_compare_pairs, pair);
-	if (other_pair != NULL) {
-		IceCandidatePair *other_candidate_pair = (IceCandidatePair *)other_pair->data;
+static int
+ice_prune_duplicate_pair(IceCandidatePair *pair, bctbx_list_t **pairs, IceIndex *duplicates_index, IceCheckList *cl) {
+	IceCandidatePair *other_candidate_pair =
+	    (IceCandidatePair *)ice_index_lookup(duplicates_index, *pairs, ice_hash_pair_transport_addresses(pair),
+	                                         (bctbx_compare_func)ice_compare_pairs, pair);
+	if (other_candidate_pair != NULL) {
 		if (other_candidate_pair->priority > pair->priority) {
 			/* Found duplicate with higher priority so prune current pair. */
 			*pairs = bctbx_list_remove(*pairs, pair);
+			ice_index_remove(duplicates_index, pair);
+			ice_index_remove(cl->pairs_index, pair);
 			ice_free_candidate_pair(pair, cl);
 			return 1;
 		}
@@ -3743,8 +3946,42 @@ static int ice_prune_duplicate_pair(IceCandidatePair *pair, bctbx_list_t **pairs
 	return 0;
 }
 
-static void ice_create_check_list(IceCandidatePair *pair, IceCheckList *cl) {
-	cl->check_list = bctbx_list_insert_sorted(cl->check_list, pair, (bctbx_compare_func)ice_compare_pair_priorities);
+typedef struct _Pair_Position {
+	IceCandidatePair *pair;
+	size_t position;
+} Pair_Position;
+
+static int ice_compare_pair_positions(const void *p1, const void *p2) {
+	const Pair_Position *pp1 = (const Pair_Position *)p1;
+	const Pair_Position *pp2 = (const Pair_Position *)p2;
+	if (pp1->pair->priority != pp2->pair->priority) return (pp1->pair->priority < pp2->pair->priority) ? 1 : -1;
+	return (pp1->position < pp2->position) ? 1 : -1;
+}
+
+/* Build the check list ordered by decreasing priorities. Pairs of equal priority end up in the order that inserting them
+ * one by one with bctbx_list_insert_sorted() would give, but without its quadratic cost on large pair lists. */
+static void ice_create_check_list(IceCheckList *cl) {
+	size_t nb_pairs = bctbx_list_size(cl->pairs);
+	Pair_Position *positions;
+	bctbx_list_t *elem;
+	size_t i;
+
+	bctbx_list_free(cl->check_list);
+	cl->check_list = NULL;
+	ice_index_clear(cl->check_list_index);
+	if (nb_pairs == 0) return;
+
+	positions = ms_new0(Pair_Position, nb_pairs);
+	for (elem = cl->pairs, i = 0; elem != NULL; elem = elem->next, i++) {
+		positions[i].pair = (IceCandidatePair *)elem->data;
+		positions[i].position = i;
+	}
+	qsort(positions, nb_pairs, sizeof(Pair_Position), ice_compare_pair_positions);
+	for (i = nb_pairs; i > 0; i--) {
+		cl->check_list = bctbx_list_prepend(cl->check_list, positions[i - 1].pair);
+	}
+	ms_free(positions);
+	ice_index_invalidate(cl->check_list_index);
 }
 
 /* Prune pairs according to 5.7.3. */
@@ -3752,24 +3989,28 @@ static void ice_prune_candidate_pairs(IceCheckList *cl) {
 	bctbx_list_t *list;
 	bctbx_list_t *next;
 	bctbx_list_t *prev;
+	IceIndex *duplicates_index;
 	int nb_pairs;
 	int nb_pairs_to_remove;
 	int i;
 
 	bctbx_list_for_each(cl->pairs, (void (*)(void *))ice_replace_srflx_by_base_in_pair);
+	ice_index_invalidate(cl->pairs_index);
+	/* Index the pairs by transport addresses so that finding the duplicates of each pair does not scan the whole list.
+	 */
+	duplicates_index = ice_index_new((IceIndexHashFunc)ice_hash_pair_transport_addresses);
+	ice_index_invalidate(duplicates_index);
 	/* Do not use bctbx_list_for_each2() here, because ice_prune_duplicate_pair() can remove list elements. */
 	for (list = cl->pairs; list != NULL; list = list->next) {
 		next = list->next;
-		if (ice_prune_duplicate_pair(list->data, &cl->pairs, cl)) {
+		if (ice_prune_duplicate_pair(list->data, &cl->pairs, duplicates_index, cl)) {
 			if (next && next->prev) list = next->prev;
 			else break; /* The end of the list has been reached, prevent accessing a wrong list->next */
 		}
 	}
+	ice_index_destroy(duplicates_index);
 
-	/* Create the check list. */
-	bctbx_list_free(cl->check_list);
-	cl->check_list = NULL;
-	bctbx_list_for_each2(cl->pairs, (void (*)(void *, void *))ice_create_check_list, cl);
+	ice_create_check_list(cl);
 
 	/* Limit the number of connectivity checks. */
 	nb_pairs = (int)bctbx_list_size(cl->check_list);
@@ -3780,6 +4021,7 @@ static void ice_prune_candidate_pairs(IceCheckList *cl) {
 			list = bctbx_list_next(list);
 		for (i = 0; i < nb_pairs_to_remove; i++) {
 			cl->pairs = bctbx_list_remove(cl->pairs, list->data);
+			ice_index_remove(cl->pairs_index, list->data);
 			prev = list->prev;
 			ice_free_candidate_pair(list->data, cl); // this function remove list in cl too
 			list = prev;
@@ -3792,20 +4034,24 @@ static int ice_find_pair_foundation(const IcePairFoundation *f1, const IcePairFo
 	         (strlen(f1->remote) == strlen(f2->remote)) && (strcmp(f1->remote, f2->remote) == 0));
 }
 
-static void ice_generate_pair_foundations_list(const IceCandidatePair *pair, bctbx_list_t **list) {
+static void ice_fill_pair_foundation(IcePairFoundation *foundation, const IceCandidatePair *pair) {
+	memset(foundation, 0, sizeof(*foundation));
+	strncpy(foundation->local, pair->local->foundation, sizeof(foundation->local) - 1);
+	strncpy(foundation->remote, pair->remote->foundation, sizeof(foundation->remote) - 1);
+}
+
+static void
+ice_generate_pair_foundations_list(const IceCandidatePair *pair, bctbx_list_t **list, IceIndex *foundations_index) {
 	IcePairFoundation foundation;
 	IcePairFoundation *dyn_foundation;
-	bctbx_list_t *elem;
-
-	memset(&foundation, 0, sizeof(foundation));
-	strncpy(foundation.local, pair->local->foundation, sizeof(foundation.local) - 1);
-	strncpy(foundation.remote, pair->remote->foundation, sizeof(foundation.remote) - 1);
 
-	elem = bctbx_list_find_custom(*list, (bctbx_compare_func)ice_find_pair_foundation, &foundation);
-	if (elem == NULL) {
+	ice_fill_pair_foundation(&foundation, pair);
+	if (ice_index_lookup(foundations_index, *list, ice_hash_pair_foundation(&foundation),
+	                     (bctbx_compare_func)ice_find_pair_foundation, &foundation) == NULL) {
 		dyn_foundation = ms_new0(IcePairFoundation, 1);
 		memcpy(dyn_foundation, &foundation, sizeof(foundation));
 		*list = bctbx_list_append(*list, dyn_foundation);
+		ice_index_add(foundations_index, dyn_foundation);
 	}
 }
 
@@ -3823,38 +4069,71 @@ static void ice_find_lowest_componentid_pair_with_specified_foundation(IceCandid
 	}
 }
 
-static void ice_set_lowest_componentid_pair_with_foundation_to_waiting_state(const IcePairFoundation *foundation,
-                                                                             IceCheckList *cl) {
-	Foundation_Pair_Priority_ComponentID fc;
-	fc.foundation = foundation;
-	fc.pair = NULL;
-	fc.componentID = ICE_INVALID_COMPONENTID;
-	fc.priority = 0;
-	bctbx_list_for_each2(cl->check_list,
-	                     (void (*)(void *, void *))ice_find_lowest_componentid_pair_with_specified_foundation, &fc);
-	if (fc.pair != NULL) {
-		/* Set the state of the pair to Waiting. */
-		ice_pair_set_state(fc.pair, ICP_Waiting);
-	}
+static unsigned int ice_hash_foundation_of_fc(const Foundation_Pair_Priority_ComponentID *fc) {
+	return ice_hash_pair_foundation(fc->foundation);
+}
+
+static int ice_find_fc_from_foundation(const Foundation_Pair_Priority_ComponentID *fc,
+                                       const IcePairFoundation *foundation) {
+	return ice_find_pair_foundation(fc->foundation, foundation);
 }
 
-/* Compute pairs states according to 5.7.4. */
+/* Compute pairs states according to 5.7.4. The check list is walked once, each pair being matched with the state of its
+ * foundation through an index instead of walking the whole check list for every foundation. */
 static void ice_compute_pairs_states(IceCheckList *cl) {
-	bctbx_list_for_each2(cl->foundations,
-	                     (void (*)(void *, void *))ice_set_lowest_componentid_pair_with_foundation_to_waiting_state,
-	                     cl);
+	size_t nb_foundations = bctbx_list_size(cl->foundations);
+	Foundation_Pair_Priority_ComponentID *fcs;
+	Foundation_Pair_Priority_ComponentID *fc;
+	IcePairFoundation foundation;
+	IceIndex *index;
+	bctbx_list_t *elem;
+	size_t i;
+
+	if (nb_foundations == 0) return;
+	fcs = ms_new0(Foundation_Pair_Priority_ComponentID, nb_foundations);
+	index = ice_index_new((IceIndexHashFunc)ice_hash_foundation_of_fc);
+	for (elem = cl->foundations, i = 0; elem != NULL; elem = elem->next, i++) {
+		fcs[i].foundation = (const IcePairFoundation *)elem->data;
+		fcs[i].pair = NULL;
+		fcs[i].componentID = ICE_INVALID_COMPONENTID;
+		fcs[i].priority = 0;
+		ice_index_add(index, &fcs[i]);
+	}
+	for (elem = cl->check_list; elem != NULL; elem = elem->next) {
+		IceCandidatePair *pair = (IceCandidatePair *)elem->data;
+		ice_fill_pair_foundation(&foundation, pair);
+		fc = (Foundation_Pair_Priority_ComponentID *)ice_index_lookup(
+		    index, NULL, ice_hash_pair_foundation(&foundation), (bctbx_compare_func)ice_find_fc_from_foundation,
+		    &foundation);
+		if (fc != NULL) ice_find_lowest_componentid_pair_with_specified_foundation(pair, fc);
+	}
+	for (i = 0; i < nb_foundations; i++) {
+		if (fcs[i].pair != NULL) {
+			/* Set the state of the pair to Waiting. */
+			ice_pair_set_state(fcs[i].pair, ICP_Waiting);
+		}
+	}
+	ice_index_destroy(index);
+	ms_free(fcs);
 }
 
 static void ice_check_list_pair_candidates(IceCheckList *cl) {
 	if (cl->state == ICL_Running) {
+		IceIndex *foundations_index;
+		bctbx_list_t *elem;
+
 		cl->connectivity_checks_running = TRUE;
 		ice_create_turn_permissions(cl);
 		ms_message("ICE: connectivity checks are going to start for check list %p", cl);
 		ice_form_candidate_pairs(cl);
 		ice_prune_candidate_pairs(cl);
 		/* Generate pair foundations list. */
-		bctbx_list_for_each2(cl->check_list, (void (*)(void *, void *))ice_generate_pair_foundations_list,
-		                     &cl->foundations);
+		foundations_index = ice_index_new((IceIndexHashFunc)ice_hash_pair_foundation);
+		ice_index_invalidate(foundations_index);
+		for (elem = cl->check_list; elem != NULL; elem = elem->next) {
+			ice_generate_pair_foundations_list((IceCandidatePair *)elem->data, &cl->foundations, foundations_index);
+		}
+		ice_index_destroy(foundations_index);
 	}
 }
 
@@ -4020,6 +4299,7 @@ static void ice_conclude_waiting_frozen_and_inprogress_pairs(const IceValidCandi
 	if (valid_pair->valid->is_nominated == TRUE) {
 		bctbx_list_t *elem;
 		ice_remove_waiting_and_frozen_pairs_from_list(&cl->check_list, valid_pair->valid->local->componentID);
+		ice_index_invalidate(cl->check_list_index);
 		ice_remove_waiting_and_frozen_pairs_from_list(&cl->triggered_checks_queue,
 		                                              valid_pair->valid->local->componentID);
 
@@ -4285,6 +4565,10 @@ static void ice_check_list_restart(IceCheckList *cl) {
 	cl->stun_server_requests = cl->foundations = cl->remote_componentIDs = NULL;
 	cl->valid_list = cl->check_list = cl->triggered_checks_queue = cl->losing_pairs = cl->pairs =
 	    cl->remote_candidates = cl->transaction_list = NULL;
+	ice_index_clear(cl->remote_candidates_index);
+	ice_index_clear(cl->pairs_index);
+	ice_index_clear(cl->check_list_index);
+	ice_index_clear(cl->transactions_index);
 	cl->state = ICL_Running;
 	cl->mismatch = FALSE;
 	cl->gathering_candidates = FALSE;
@@ -4293,6 +4577,8 @@ static void ice_check_list_restart(IceCheckList *cl) {
 	cl->ta_time = ice_current_time();
 	cl->nomination_in_progress = FALSE;
 	memset(&cl->keepalive_time, 0, sizeof(cl->keepalive_time));
+	memset(&cl->retransmission_time, 0, sizeof(cl->retransmission_time));
+	memset(&cl->valid_pairs_keepalive_time, 0, sizeof(cl->valid_pairs_keepalive_time));
 	memset(&cl->gathering_start_time, 0, sizeof(cl->gathering_start_time));
 	memset(&cl->nomination_delay_start_time, 0, sizeof(cl->nomination_delay_start_time));
 }
@@ -4330,6 +4616,7 @@ void ice_session_reset(IceSession *session, IceRole role) {
 		if (cl != NULL) {
 			cl->local_candidates =
 			    bctbx_list_free_with_data(cl->local_candidates, (bctbx_list_free_func)ice_free_candidate);
+			ice_index_clear(cl->local_candidates_index);
 			bctbx_list_free(cl->local_componentIDs);
 			cl->local_componentIDs = NULL;
 		}
@@ -4431,11 +4718,21 @@ static void ice_check_retransmissions_pending(const IceCandidatePair *pair, bool
 static void
 ice_check_list_retransmit_connectivity_checks(IceCheckList *cl, RtpSession *rtp_session, MSTimeSpec curtime) {
 	CheckList_RtpSession_Time params;
+	bctbx_list_t *elem;
+
+	/* Sending a binding request moves this time backwards if needed, so nothing is due before it. */
+	if (ice_compare_time(curtime, cl->retransmission_time) < 0) return;
+	cl->retransmission_time = ice_add_ms(curtime, ICE_DEFAULT_RTO_DURATION << ICE_MAX_RETRANSMISSIONS);
 	params.cl = cl;
 	params.rtp_session = rtp_session;
 	params.time = curtime;
-	bctbx_list_for_each2(cl->check_list, (void (*)(void *, void *))ice_handle_connectivity_check_retransmission,
-	                     &params);
+	for (elem = cl->check_list; elem != NULL; elem = elem->next) {
+		IceCandidatePair *pair = (IceCandidatePair *)elem->data;
+		ice_handle_connectivity_check_retransmission(pair, &params);
+		if (pair->state == ICP_InProgress) {
+			ice_schedule_timer(&cl->retransmission_time, ice_add_ms(pair->transmission_time, pair->rto));
+		}
+	}
 }
 
 static IceCandidatePair *ice_check_list_send_triggered_check(IceCheckList *cl, RtpSession *rtp_session) {
@@ -4578,6 +4875,11 @@ static int32_t ice_compare_time(MSTimeSpec ts1, MSTimeSpec ts2) {
 	return ms;
 }
 
+/* Move the timer backwards to the given time if it is earlier. */
+static void ice_schedule_timer(MSTimeSpec *timer, MSTimeSpec time) {
+	if (ice_compare_time(time, *timer) < 0) *timer = time;
+}
+
 static void transactionID2string(const UInt96 *tr_id, char *tr_id_str) {
 	int j, pos;
 
@@ -4663,6 +4965,7 @@ static void ice_remove_transaction_with_pair(IceCheckList *cl, IceCandidatePair
 		IceTransaction *tr = (IceTransaction *)elem->data;
 		next_elem = elem->next;
 		if (tr->pair == pair) {
+			ice_index_remove(cl->transactions_index, tr);
 			ice_free_transaction(tr);
 			cl->transaction_list = bctbx_list_erase_link(cl->transaction_list, elem);
 		}
@@ -4687,6 +4990,7 @@ static void ice_clean_rtcp_candidate_pairs(IceCheckList *cl) {
 			/*
 			 * ice_free_candidate_pair() will also remove pair from check list and valid list.
 			 */
+			ice_index_remove(cl->pairs_index, pair);
 			ice_free_candidate_pair(pair, cl);
 			cl->pairs = bctbx_list_erase_link(cl->pairs, elem);
 		}
@@ -4707,6 +5011,7 @@ void ice_check_list_remove_rtcp_candidates(IceCheckList *cl) {
 	                                      &rtcp_componentID)) != NULL) {
 		IceCandidate *candidate = (IceCandidate *)elem->data;
 		cl->local_candidates = bctbx_list_remove(cl->local_candidates, candidate);
+		ice_index_remove(cl->local_candidates_index, candidate);
 		ice_free_candidate(candidate);
 	}
 	ice_remove_componentID(&cl->remote_componentIDs, rtcp_componentID);
@@ -4715,6 +5020,7 @@ void ice_check_list_remove_rtcp_candidates(IceCheckList *cl) {
 	                                   &rtcp_componentID)) != NULL) {
 		IceCandidate *candidate = (IceCandidate *)elem->data;
 		cl->remote_candidates = bctbx_list_remove(cl->remote_candidates, candidate);
+		ice_index_remove(cl->remote_candidates_index, candidate);
 		ice_free_candidate(candidate);
 	}
 }
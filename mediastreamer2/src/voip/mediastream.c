@@ -251,6 +251,11 @@ static void ms_media_stream_bundle_and_sessions_free(void *b) {
 }
 
 void ms_media_stream_sessions_uninit(MSMediaStreamSessions *sessions) {
+	/* DTLS packets may be processed by a worker thread using the sessions: stop it first. */
+	if (sessions->dtls_context != NULL) {
+		ms_dtls_srtp_context_destroy(sessions->dtls_context);
+		sessions->dtls_context = NULL;
+	}
 	if (sessions->srtp_context) {
 		ms_srtp_context_delete(sessions->srtp_context);
 		sessions->srtp_context = NULL;
@@ -270,10 +275,6 @@ void ms_media_stream_sessions_uninit(MSMediaStreamSessions *sessions) {
 		ms_zrtp_context_destroy(sessions->zrtp_context);
 		sessions->zrtp_context = NULL;
 	}
-	if (sessions->dtls_context != NULL) {
-		ms_dtls_srtp_context_destroy(sessions->dtls_context);
-		sessions->dtls_context = NULL;
-	}
 	if (sessions->ticker) {
 		ms_ticker_destroy(sessions->ticker);
 		sessions->ticker = NULL;
@@ -400,6 +401,8 @@ void media_stream_enable_dtls(MediaStream *stream, const MSDtlsSrtpParams *param
 		MSDtlsSrtpParams params_copy = *params;
 		ms_message("Create DTLS media stream context in stream session [%p]", &(stream->sessions));
 		if (params_copy.mtu == 0) params_copy.mtu = ms_factory_get_mtu(stream->factory);
+		/* Keep the handshake cryptography off the ticker thread. */
+		if (params_copy.factory == NULL) params_copy.factory = stream->factory;
 
 		stream->sessions.dtls_context = ms_dtls_srtp_context_new(&(stream->sessions), &params_copy);
 		media_stream_configure_stun_packet_sending(stream);
@@ -1259,6 +1259,35 @@ bool_t ms_video_configuratons_equal(const MSVideoConfiguration *vconf1, const MS
 	        vconf1->fps == vconf2->fps && vconf1->mincpu == vconf2->mincpu);
 }
 
+int ms_video_get_temporal_layer_id(int layers, uint64_t frame_index) {
+	static const int pattern_2[] = {0, 1};
+	static const int pattern_3[] = {0, 2, 1, 2};
+	switch (layers) {
+		case 2:
+			return pattern_2[frame_index % 2];
+		case 3:
+			return pattern_3[frame_index % 4];
+		default:
+			return 0;
+	}
+}
+
+float ms_video_get_temporal_layer_bitrate_ratio(int layers, int layer_id) {
+	/* Cumulative shares, the base layer gets a larger part as it carries the quality of all the layers. */
+	static const float ratios_2[] = {0.6f, 1.0f};
+	static const float ratios_3[] = {0.4f, 0.6f, 1.0f};
+	if (layer_id < 0) return 0;
+	if (layer_id >= layers - 1) return 1.0f;
+	switch (layers) {
+		case 2:
+			return ratios_2[layer_id];
+		case 3:
+			return ratios_3[layer_id];
+		default:
+			return 1.0f;
+	}
+}
+
 size_t ms_video_payload_sizes(const size_t bitstreamSize,
                               const size_t maxPayloadSize,
                               const bool_t equalSizeEnabled,
@@ -94,17 +94,14 @@ MSFilter *VideoConferenceAllToAll::getMixer() const {
 	return mMixer;
 }
 
-void VideoConferenceAllToAll::applyNewBitrateRequest() {
-	const bctbx_list_t *elem;
-	for (elem = mMembers; elem != NULL; elem = elem->next) {
-		VideoEndpoint *ep = (VideoEndpoint *)elem->data;
-		if (ep->mIsRemote) {
-			if (ep->mSt->ms.bandwidth_controller) {
-				ms_bandwidth_controller_set_maximum_bandwidth_usage(ep->mSt->ms.bandwidth_controller, mBitrate);
-			}
-		} else {
-			media_stream_process_tmmbr((MediaStream *)ep->mSt, mBitrate);
+void VideoConferenceAllToAll::applyNewBitrateRequest(VideoEndpoint *ep) {
+	if (ep->mIsRemote) {
+		if (ep->mSt->ms.bandwidth_controller) {
+			ms_bandwidth_controller_set_maximum_bandwidth_usage(ep->mSt->ms.bandwidth_controller,
+			                                                    ep->mRequestedBitrate);
 		}
+	} else {
+		media_stream_process_tmmbr((MediaStream *)ep->mSt, ep->mRequestedBitrate);
 	}
 }
 
@@ -409,40 +406,88 @@ void VideoConferenceAllToAll::connectEndpoint(VideoEndpoint *ep) {
 	}
 }
 
+bool VideoConferenceAllToAll::isReceiverOf(const VideoEndpoint *receiver, const VideoEndpoint *source) const {
+	if (receiver->mOutPin < 0 || receiver->mLastTmmbrReceived == 0) return false;
+	if (bctbx_list_find(mEndpoints, receiver) != NULL) {
+		// Thumbnails have their own bitrate, they should not constrain the sender.
+		return receiver->mSt->content != MSVideoContentThumbnail && receiver->mSource == source->mPin;
+	}
+	// Active speaker outputs may show any participant except themselves.
+	return receiver != source;
+}
+
 void VideoConferenceAllToAll::updateBitrateRequest() {
-	const bctbx_list_t *elem;
-	int min_of_tmmbr = -1;
-	for (elem = mEndpoints; elem != NULL; elem = elem->next) {
-		VideoEndpoint *ep = (VideoEndpoint *)elem->data;
-		if (ep->mSt->content != MSVideoContentThumbnail && ep->mLastTmmbrReceived != 0) {
-			if (min_of_tmmbr == -1) {
-				min_of_tmmbr = ep->mLastTmmbrReceived;
-			} else {
-				if (ep->mLastTmmbrReceived < min_of_tmmbr) {
-					min_of_tmmbr = ep->mLastTmmbrReceived;
+	// Each sender adapts to its own receivers only: a participant on a poor link does not degrade the video sent to
+	// the others.
+	for (const bctbx_list_t *elem = mMembers; elem != NULL; elem = elem->next) {
+		VideoEndpoint *source = (VideoEndpoint *)elem->data;
+		int min_of_tmmbr = -1;
+		int max_of_tmmbr = 0;
+
+		for (int i = 0; i < 2; i++) {
+			for (const bctbx_list_t *it = i == 0 ? mEndpoints : mMembers; it != NULL; it = it->next) {
+				const VideoEndpoint *receiver = (VideoEndpoint *)it->data;
+				if (!isReceiverOf(receiver, source)) continue;
+				if (min_of_tmmbr == -1 || receiver->mLastTmmbrReceived < min_of_tmmbr) {
+					min_of_tmmbr = receiver->mLastTmmbrReceived;
 				}
+				max_of_tmmbr = MAX(max_of_tmmbr, receiver->mLastTmmbrReceived);
 			}
 		}
-	}
-	for (elem = mMembers; elem != NULL; elem = elem->next) {
-		VideoEndpoint *ep = (VideoEndpoint *)elem->data;
-		if ((ep->mOutPin > -1) && ep->mLastTmmbrReceived != 0) {
-			if (min_of_tmmbr == -1) {
-				min_of_tmmbr = ep->mLastTmmbrReceived;
-			} else {
-				if (ep->mLastTmmbrReceived < min_of_tmmbr) {
-					min_of_tmmbr = ep->mLastTmmbrReceived;
-				}
-			}
+		if (min_of_tmmbr == -1) continue;
+
+		int bitrate = min_of_tmmbr;
+		if (mCfparams.temporal_layers > 1) {
+			// Receivers on a poor link get only the lower temporal layers, so the senders do not have to reduce their
+			// bitrate below what these receivers can take for the base layer.
+			bitrate = (int)((float)min_of_tmmbr /
+			                ms_video_get_temporal_layer_bitrate_ratio(mCfparams.temporal_layers, 0));
+			bitrate = MIN(bitrate, max_of_tmmbr);
+		}
+
+		if (source->mRequestedBitrate != bitrate) {
+			source->mRequestedBitrate = bitrate;
+			ms_message("MSVideoConference [%p]: new bitrate requested for input pin %d: %i kbits/s.", this,
+			           source->mPin, bitrate / 1000);
+			applyNewBitrateRequest(source);
 		}
 	}
-	if (min_of_tmmbr != -1) {
-		if (mBitrate != min_of_tmmbr) {
-			mBitrate = min_of_tmmbr;
-			ms_message("MSVideoConference [%p]: new bitrate requested: %i kbits/s.", this, mBitrate / 1000);
-			applyNewBitrateRequest();
+
+	if (mCfparams.temporal_layers > 1) {
+		bctbx_list_for_each2(mEndpoints, (void (*)(void *, void *))applyMaxTemporalLayer, this);
+		bctbx_list_for_each2(mMembers, (void (*)(void *, void *))applyMaxTemporalLayer, this);
+	}
+}
+
+void VideoConferenceAllToAll::applyMaxTemporalLayer(VideoEndpoint *ep, VideoConferenceAllToAll *conf) {
+	if (ep->mOutPin < 0 || ep->mLastTmmbrReceived == 0) return;
+
+	int source_bitrate = 0;
+	if (bctbx_list_find(conf->mEndpoints, ep) != NULL) {
+		VideoEndpoint *source = conf->getMemberAtInputPin(ep->mSource);
+		if (source) source_bitrate = source->mRequestedBitrate;
+	} else {
+		// The active speaker changes, be conservative and consider the participant sending the most.
+		for (const bctbx_list_t *elem = conf->mMembers; elem != NULL; elem = elem->next) {
+			VideoEndpoint *source = (VideoEndpoint *)elem->data;
+			if (source != ep) source_bitrate = MAX(source_bitrate, source->mRequestedBitrate);
 		}
 	}
+	if (source_bitrate == 0) return;
+
+	// Keep the highest layer whose cumulated bitrate fits into what the receiver asked for.
+	int layers = conf->mCfparams.temporal_layers;
+	int layer = 0;
+	while (layer < layers - 1 &&
+	       (float)source_bitrate * ms_video_get_temporal_layer_bitrate_ratio(layers, layer + 1) <=
+	           (float)ep->mLastTmmbrReceived) {
+		layer++;
+	}
+
+	MSPacketRouterTemporalLayerData data;
+	data.output = ep->mOutPin;
+	data.max_temporal_layer = layer == layers - 1 ? -1 : layer;
+	ms_filter_call_method(conf->mMixer, MS_PACKET_ROUTER_SET_OUTPUT_MAX_TEMPORAL_LAYER, &data);
 }
 
 void VideoConferenceAllToAll::configureOutput(VideoEndpoint *ep) {
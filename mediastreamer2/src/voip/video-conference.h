@@ -59,6 +59,7 @@ public:
 	std::string mName = ""; /*Participant*/
 	int mIsRemote = 0;
 	int mLastTmmbrReceived = 0; /*Value in bits/s */
+	int mRequestedBitrate = 0;  /*Bitrate requested to this member as a sender, in bits/s */
 	int mLinkSource = -1;
 	MSConferenceMode mConferenceMode;
 };
@@ -96,14 +97,15 @@ public:
 protected:
 	void chooseNewFocus();
 	int findSourcePin(const std::string &participant);
+	bool isReceiverOf(const VideoEndpoint *receiver, const VideoEndpoint *source) const;
 	void configureOutput(VideoEndpoint *ep);
-	void applyNewBitrateRequest();
+	void applyNewBitrateRequest(VideoEndpoint *ep);
+	static void applyMaxTemporalLayer(VideoEndpoint *ep, VideoConferenceAllToAll *conf);
 
 	MSVideoConferenceParams mCfparams{};
 	MSTicker *mTicker = nullptr;
 	MSFilter *mMixer = nullptr;
 	bctbx_list_t *mMembers = nullptr;
-	int mBitrate = 0;
 	bctbx_list_t *mEndpoints = nullptr;
 	RtpProfile *mLocalDummyProfile = nullptr;
 
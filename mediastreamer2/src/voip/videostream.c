@@ -656,6 +656,7 @@ VideoStream *video_stream_new_with_sessions(MSFactory *factory, const MSMediaStr
 	stream->staticimage_webcam_fps_optimization = TRUE;
 	stream->vconf_list = NULL;
 	stream->frame_marking_extension_id = 0;
+	stream->temporal_layers = 1;
 
 	stream->is_forwarding = FALSE;
 
@@ -966,6 +967,15 @@ static void configure_video_source(VideoStream *stream, bool_t skip_bitrate, boo
 		bool_t screen_content_mode = ms_filter_get_id(stream->source) == MS_SCREEN_SHARING_ID;
 		ms_filter_call_method(stream->ms.encoder, MS_VIDEO_ENCODER_SET_CONFIGURATION, &vconf);
 		ms_filter_call_method(stream->ms.encoder, MS_VIDEO_ENCODER_ENABLE_SCREEN_CONTENT_MODE, &screen_content_mode);
+		/* Layers are only useful if the frame marking extension tells the receiver which frames can be dropped. */
+		if (stream->temporal_layers > 1 && stream->frame_marking_extension_id > 0) {
+			if (ms_filter_has_method(stream->ms.encoder, MS_VIDEO_ENCODER_SET_TEMPORAL_LAYERS)) {
+				ms_filter_call_method(stream->ms.encoder, MS_VIDEO_ENCODER_SET_TEMPORAL_LAYERS,
+				                      &stream->temporal_layers);
+			} else {
+				ms_message("Encoder %s does not support temporal layers", stream->ms.encoder->desc->name);
+			}
+		}
 	}
 
 	encoder_supports_source_format.supported = FALSE;
@@ -2862,6 +2872,10 @@ void video_stream_set_frame_marking_extension_id(VideoStream *stream, int extens
 	stream->frame_marking_extension_id = extension_id;
 }
 
+void video_stream_set_temporal_layers(VideoStream *stream, int layers) {
+	stream->temporal_layers = layers;
+}
+
 void video_stream_set_sent_video_size_max(VideoStream *stream, MSVideoSize max) {
 	stream->max_sent_vsize = max;
 }
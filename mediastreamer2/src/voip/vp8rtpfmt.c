@@ -184,18 +184,32 @@ static int vp8_decode_value(BOOL_DECODER *br, int bits) {
 	return z;
 }
 
+/* Append data to a list whose last element is known, so that building a list of n packets is not quadratic. */
+static void append_to_list(bctbx_list_t **list, bctbx_list_t **last, void *data) {
+	bctbx_list_t *elem = bctbx_list_new(data);
+	if (*last == NULL) {
+		*list = elem;
+	} else {
+		(*last)->next = elem;
+		elem->prev = *last;
+	}
+	*last = elem;
+}
+
 static mblk_t *concat_packets_of_partition(Vp8RtpFmtPartition *partition) {
 	Vp8RtpFmtPacket *packet;
-	int nb_packets = (int)bctbx_list_size(partition->packets_list);
-	int i;
+	bctbx_list_t *it;
+	mblk_t *last = NULL;
 
 	if (partition->m != NULL) return partition->m;
-	for (i = 0; i < nb_packets; i++) {
-		packet = bctbx_list_nth_data(partition->packets_list, i);
+	for (it = partition->packets_list; it != NULL; it = it->next) {
+		packet = (Vp8RtpFmtPacket *)it->data;
+		if (packet->m == NULL) continue;
 		if (partition->m == NULL) {
 			partition->m = packet->m;
+			last = partition->m;
 		} else {
-			concatb(partition->m, packet->m);
+			last = concatb(last, packet->m);
 		}
 		packet->m = NULL;
 	}
@@ -461,7 +475,7 @@ static void add_packet_to_frame(Vp8RtpFmtFrame *frame, Vp8RtpFmtPacket *packet)
 	if (mblk_get_marker_info(packet->m)) {
 		partition->has_marker = TRUE;
 	}
-	partition->packets_list = bctbx_list_append(partition->packets_list, (void *)packet);
+	append_to_list(&partition->packets_list, &partition->last_packet, (void *)packet);
 	partition->size += msgdsize(packet->m);
 }
 
@@ -507,29 +521,27 @@ static void check_frame_partitions_have_start(Vp8RtpFmtUnpackerCtx *ctx, Vp8RtpF
 	Vp8RtpFmtPacket *packet;
 	Vp8RtpFmtPartition *partition;
 	int i;
-	int j;
 
 	if (frame->unnumbered_partitions == TRUE) return;
 
 	for (i = 0; i <= frame->partitions_info.nb_partitions; i++) {
 		partition = frame->partitions[i];
-		if (partition == NULL) continue;
-		for (j = 0; j < (int)bctbx_list_size(partition->packets_list); j++) {
-			packet = (Vp8RtpFmtPacket *)bctbx_list_nth_data(partition->packets_list, j);
-			if ((j == 0) && !partition->has_start && !packet->cseq_inconsistency) {
-				/**
-				 * We have detected a partition does not start at the beginning of a packet.
-				 * Do not output partitions but the entire frame. Also consider frame has
-				 * unnumbered partitions to prevent checks on the partitions.
-				 * WARNING: This is a workaround because the partitions are now built according
-				 * to the partition id of the packet header. However a packet can contain parts of
-				 * several partitions. In this case we should split the packet in several parts and
-				 * put these parts in the corresponding partitions and check from the partition sizes
-				 * that we get from parsing the frame header.
-				 */
-				frame->unnumbered_partitions = TRUE;
-				ctx->output_partitions = FALSE;
-			}
+		if ((partition == NULL) || (partition->packets_list == NULL)) continue;
+		/* Only the first packet of the partition tells whether it is started. */
+		packet = (Vp8RtpFmtPacket *)partition->packets_list->data;
+		if (!partition->has_start && !packet->cseq_inconsistency) {
+			/**
+			 * We have detected a partition does not start at the beginning of a packet.
+			 * Do not output partitions but the entire frame. Also consider frame has
+			 * unnumbered partitions to prevent checks on the partitions.
+			 * WARNING: This is a workaround because the partitions are now built according
+			 * to the partition id of the packet header. However a packet can contain parts of
+			 * several partitions. In this case we should split the packet in several parts and
+			 * put these parts in the corresponding partitions and check from the partition sizes
+			 * that we get from parsing the frame header.
+			 */
+			frame->unnumbered_partitions = TRUE;
+			ctx->output_partitions = FALSE;
 		}
 	}
 }
@@ -607,7 +619,7 @@ static void notify_frame_error_if_any(Vp8RtpFmtUnpackerCtx *ctx, Vp8RtpFmtFrame
 	}
 }
 
-static void add_frame(Vp8RtpFmtUnpackerCtx *ctx, bctbx_list_t **packets_list, bool_t end_missing) {
+static void add_frame(Vp8RtpFmtUnpackerCtx *ctx, bctbx_list_t **packets_list, bctbx_list_t **last, bool_t end_missing) {
 	Vp8RtpFmtFrame *frame;
 
 	if (*packets_list != NULL) {
@@ -621,17 +633,20 @@ static void add_frame(Vp8RtpFmtUnpackerCtx *ctx, bctbx_list_t **packets_list, bo
 		bctbx_list_free(*packets_list);
 	}
 	*packets_list = NULL;
+	*last = NULL;
 }
 
 static void generate_frames_list(Vp8RtpFmtUnpackerCtx *ctx, bctbx_list_t *packets_list) {
 	Vp8RtpFmtPacket *packet;
 	bctbx_list_t *frame_packets_list = NULL;
+	bctbx_list_t *frame_last_packet = NULL;
 	bctbx_list_t *it;
 	uint32_t ts;
 
 	/* If we have some packets from the previous iteration, put them in the frame_packets_list. */
 	if (ctx->non_processed_packets_list) {
-		frame_packets_list = bctbx_list_concat(ctx->non_processed_packets_list, frame_packets_list);
+		frame_packets_list = ctx->non_processed_packets_list;
+		frame_last_packet = bctbx_list_last_elem(frame_packets_list);
 	}
 	ctx->non_processed_packets_list = NULL;
 
@@ -643,17 +658,17 @@ static void generate_frames_list(Vp8RtpFmtUnpackerCtx *ctx, bctbx_list_t *packet
 		if ((ctx->initialized_last_ts == TRUE) && (ts != ctx->last_ts)) {
 			/* The current packet is from a frame different than the previous one
 			 * (that apparently is not complete). */
-			add_frame(ctx, &frame_packets_list, TRUE);
+			add_frame(ctx, &frame_packets_list, &frame_last_packet, TRUE);
 		}
 		ctx->last_ts = ts;
 		ctx->initialized_last_ts = TRUE;
 
 		/* Add the current packet to the current frame. */
-		frame_packets_list = bctbx_list_append(frame_packets_list, packet);
+		append_to_list(&frame_packets_list, &frame_last_packet, packet);
 
 		if (mblk_get_marker_info(packet->m)) {
 			/* The current packet is the last of the current frame. */
-			add_frame(ctx, &frame_packets_list, FALSE);
+			add_frame(ctx, &frame_packets_list, &frame_last_packet, FALSE);
 		}
 	}
 
@@ -661,29 +676,55 @@ static void generate_frames_list(Vp8RtpFmtUnpackerCtx *ctx, bctbx_list_t *packet
 	ctx->non_processed_packets_list = frame_packets_list;
 }
 
+static void copy_msg(mblk_t *dst, const mblk_t *src) {
+	for (; src != NULL; src = src->b_cont) {
+		size_t len = (size_t)(src->b_wptr - src->b_rptr);
+		memcpy(dst->b_wptr, src->b_rptr, len);
+		dst->b_wptr += len;
+	}
+}
+
 static void output_frame(MSQueue *out, Vp8RtpFmtFrame *frame) {
 	Vp8RtpFmtPartition *partition;
+	Vp8RtpFmtPartition *first = NULL;
 	mblk_t *om = NULL;
-	mblk_t *curm = NULL;
+	size_t size = 0;
+	int nb_non_empty = 0;
 	int i;
+	bctbx_list_t *it;
 
 	for (i = 0; i <= frame->partitions_info.nb_partitions; i++) {
 		partition = frame->partitions[i];
 		if (partition == NULL) continue;
-		if (om == NULL) {
-			om = concat_packets_of_partition(partition);
-			curm = om;
-		} else {
-			curm = concatb(curm, concat_packets_of_partition(partition));
-		}
-		partition->outputted = TRUE;
+		if (first == NULL) first = partition;
+		size += partition->size;
+		nb_non_empty++;
 	}
-	if (om != NULL) {
-		if (om->b_cont) msgpullup(om, -1);
-		mblk_set_marker_info(om, 1);
-		mblk_set_timestamp_info(om, frame->timestamp);
-		ms_queue_put(out, om);
+	if (first == NULL) return;
+
+	if ((nb_non_empty == 1) && (concat_packets_of_partition(first) != NULL) && (first->m->b_cont == NULL)) {
+		/* The whole frame is already contiguous (it has been pulled up to parse the frame header), give it away. */
+		om = first->m;
+		first->outputted = TRUE;
+	} else {
+		/* Copy the partitions once into a buffer of the size of the frame instead of chaining and pulling them up. */
+		om = allocb(size, 0);
+		mblk_meta_copy((first->m != NULL) ? first->m : ((Vp8RtpFmtPacket *)first->packets_list->data)->m, om);
+		for (i = 0; i <= frame->partitions_info.nb_partitions; i++) {
+			partition = frame->partitions[i];
+			if (partition == NULL) continue;
+			if (partition->m != NULL) {
+				copy_msg(om, partition->m);
+			} else {
+				for (it = partition->packets_list; it != NULL; it = it->next) {
+					copy_msg(om, ((Vp8RtpFmtPacket *)it->data)->m);
+				}
+			}
+		}
 	}
+	mblk_set_marker_info(om, 1);
+	mblk_set_timestamp_info(om, frame->timestamp);
+	ms_queue_put(out, om);
 }
 
 static void output_partition(MSQueue *out, Vp8RtpFmtPartition **partition, bool_t last) {
@@ -987,6 +1028,7 @@ void vp8rtpfmt_unpacker_uninit(Vp8RtpFmtUnpackerCtx *ctx) {
 
 void vp8rtpfmt_unpacker_feed(Vp8RtpFmtUnpackerCtx *ctx, MSQueue *in) {
 	bctbx_list_t *packets_list = NULL;
+	bctbx_list_t *last_packet = NULL;
 	Vp8RtpFmtPacket *packet;
 	mblk_t *m;
 
@@ -1013,7 +1055,7 @@ void vp8rtpfmt_unpacker_feed(Vp8RtpFmtUnpackerCtx *ctx, MSQueue *in) {
 				ctx->ref_cseq = cseq;
 			}
 		}
-		packets_list = bctbx_list_append(packets_list, packet);
+		append_to_list(&packets_list, &last_packet, packet);
 	}
 	generate_frames_list(ctx, packets_list);
 	bctbx_list_free(packets_list);
@@ -68,6 +68,7 @@ typedef struct Vp8RtpFmtPacket {
 
 typedef struct Vp8RtpFmtPartition {
 	MSList *packets_list;
+	MSList *last_packet; /* last element of packets_list, packets are appended in constant time */
 	mblk_t *m;
 	size_t size;
 	bool_t has_start;
@@ -126,15 +127,15 @@ typedef struct Vp8RtpFmtPackerCtx {
 	uint16_t _refCSeq;
 } Vp8RtpFmtPackerCtx;
 
-void vp8rtpfmt_packer_init(Vp8RtpFmtPackerCtx *ctx, size_t max_payload_size);
-void vp8rtpfmt_packer_uninit(Vp8RtpFmtPackerCtx *ctx);
-void vp8rtpfmt_packer_process(Vp8RtpFmtPackerCtx *ctx, MSList *in, MSQueue *out);
+MS2_PUBLIC void vp8rtpfmt_packer_init(Vp8RtpFmtPackerCtx *ctx, size_t max_payload_size);
+MS2_PUBLIC void vp8rtpfmt_packer_uninit(Vp8RtpFmtPackerCtx *ctx);
+MS2_PUBLIC void vp8rtpfmt_packer_process(Vp8RtpFmtPackerCtx *ctx, MSList *in, MSQueue *out);
 
-void vp8rtpfmt_unpacker_init(
+MS2_PUBLIC void vp8rtpfmt_unpacker_init(
     Vp8RtpFmtUnpackerCtx *ctx, MSFilter *f, bool_t avpf_enabled, bool_t freeze_on_error, bool_t output_partitions);
-void vp8rtpfmt_unpacker_uninit(Vp8RtpFmtUnpackerCtx *ctx);
-void vp8rtpfmt_unpacker_feed(Vp8RtpFmtUnpackerCtx *ctx, MSQueue *in);
-int vp8rtpfmt_unpacker_get_frame(Vp8RtpFmtUnpackerCtx *ctx, MSQueue *out, Vp8RtpFmtFrameInfo *frame_info);
+MS2_PUBLIC void vp8rtpfmt_unpacker_uninit(Vp8RtpFmtUnpackerCtx *ctx);
+MS2_PUBLIC void vp8rtpfmt_unpacker_feed(Vp8RtpFmtUnpackerCtx *ctx, MSQueue *in);
+MS2_PUBLIC int vp8rtpfmt_unpacker_get_frame(Vp8RtpFmtUnpackerCtx *ctx, MSQueue *out, Vp8RtpFmtFrameInfo *frame_info);
 uint32_t vp8rtpfmt_unpacker_calc_extended_cseq(Vp8RtpFmtUnpackerCtx *ctx, uint16_t cseq);
 void vp8rtpfmt_send_rpsi(Vp8RtpFmtUnpackerCtx *ctx, uint16_t pictureid);
 
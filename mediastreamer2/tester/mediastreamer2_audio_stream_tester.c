@@ -18,10 +18,12 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <bctoolbox/crypto.h>
 #include <bctoolbox/defs.h>
 
 #include "mediastreamer2/dtmfgen.h"
 #include "mediastreamer2/mediastream.h"
+#include "mediastreamer2/msasync.h"
 #include "mediastreamer2/msfileplayer.h"
 #include "mediastreamer2/msfilerec.h"
 #include "mediastreamer2/msrtp.h"
@@ -542,6 +544,110 @@ static void encrypted_audio_stream_with_key_change_encryption_mandatory(void) {
 	encrypted_audio_stream_base(FALSE, TRUE, FALSE, TRUE, TRUE, MS_AES_128_SHA1_32);
 }
 
+typedef struct _dtls_identity_t {
+	char pem[8192];
+	char fingerprint[256];
+} dtls_identity_t;
+
+static bool_t generate_dtls_identity(const char *subject, dtls_identity_t *identity) {
+	bctbx_x509_certificate_t *certificate = bctbx_x509_certificate_new();
+	bctbx_signing_key_t *key = bctbx_signing_key_new();
+	bool_t ret = FALSE;
+
+	/* ECDSA keeps the generation short */
+	if (bctbx_x509_certificate_generate_selfsigned_with_key_type(subject, BCTBX_CERTIFICATE_KEY_ECDSA_P256, certificate,
+	                                                             key, identity->pem, sizeof(identity->pem)) == 0 &&
+	    bctbx_x509_certificate_get_fingerprint(certificate, identity->fingerprint, sizeof(identity->fingerprint),
+	                                           BCTBX_MD_SHA256) > 0) {
+		ret = TRUE;
+	}
+	bctbx_x509_certificate_free(certificate);
+	bctbx_signing_key_free(key);
+	return ret;
+}
+
+static void dtls_srtp_audio_stream(void) {
+	AudioStream *marielle, *margaux;
+	RtpProfile *profile;
+	char *hello_file;
+	dtls_identity_t marielle_identity, margaux_identity;
+	MSDtlsSrtpParams params;
+	stats_t marielle_stats, margaux_stats;
+	int dummy = 0;
+	int elapsed = 0;
+
+	if (!ms_dtls_srtp_available()) {
+		ms_warning("DTLS-SRTP is not available, skipping test.");
+		return;
+	}
+	if (!BC_ASSERT_TRUE(generate_dtls_identity("CN=marielle", &marielle_identity))) return;
+	if (!BC_ASSERT_TRUE(generate_dtls_identity("CN=margaux", &margaux_identity))) return;
+
+	marielle = audio_stream_new(_factory, MARIELLE_RTP_PORT, MARIELLE_RTCP_PORT, FALSE);
+	margaux = audio_stream_new(_factory, MARGAUX_RTP_PORT, MARGAUX_RTCP_PORT, FALSE);
+	profile = rtp_profile_new("default profile");
+	hello_file = bc_tester_res(HELLO_8K_1S_FILE);
+	reset_stats(&marielle_stats);
+	reset_stats(&margaux_stats);
+	rtp_profile_set_payload(profile, 0, &payload_type_pcmu8000);
+	rtp_session_enable_rtcp_mux(marielle->ms.sessions.rtp_session, TRUE);
+	rtp_session_enable_rtcp_mux(margaux->ms.sessions.rtp_session, TRUE);
+
+	/* The factory is set by media_stream_enable_dtls(): the handshakes run on its crypto workers. */
+	memset(&params, 0, sizeof(params));
+	params.root_ca = "";
+	params.peer_uri = "";
+	params.pem_certificate = marielle_identity.pem;
+	params.pem_pkey = marielle_identity.pem;
+	params.role = MSDtlsSrtpRoleIsClient;
+	media_stream_enable_dtls(&marielle->ms, &params);
+	params.pem_certificate = margaux_identity.pem;
+	params.pem_pkey = margaux_identity.pem;
+	params.role = MSDtlsSrtpRoleIsServer;
+	media_stream_enable_dtls(&margaux->ms, &params);
+	if (!BC_ASSERT_PTR_NOT_NULL(marielle->ms.sessions.dtls_context) ||
+	    !BC_ASSERT_PTR_NOT_NULL(margaux->ms.sessions.dtls_context))
+		goto end;
+	BC_ASSERT_EQUAL(ms_worker_thread_pool_get_user_count(_factory->crypto_pool), 2, int, "%d");
+	ms_dtls_srtp_set_peer_fingerprint(marielle->ms.sessions.dtls_context, margaux_identity.fingerprint);
+	ms_dtls_srtp_set_peer_fingerprint(margaux->ms.sessions.dtls_context, marielle_identity.fingerprint);
+
+	BC_ASSERT_EQUAL(audio_stream_start_full(margaux, profile, MARIELLE_IP, MARIELLE_RTP_PORT, MARIELLE_IP,
+	                                        MARIELLE_RTP_PORT, 0, 50, NULL, NULL, NULL, NULL, 0),
+	                0, int, "%d");
+	BC_ASSERT_EQUAL(audio_stream_start_full(marielle, profile, MARGAUX_IP, MARGAUX_RTP_PORT, MARGAUX_IP,
+	                                        MARGAUX_RTP_PORT, 0, 50, hello_file, NULL, NULL, NULL, 0),
+	                0, int, "%d");
+	ms_dtls_srtp_start(margaux->ms.sessions.dtls_context);
+	ms_dtls_srtp_start(marielle->ms.sessions.dtls_context);
+
+	/* The flights produced by the workers are sent by the ticker threads. */
+	while (elapsed < 5000 &&
+	       !(media_stream_secured((MediaStream *)marielle) && media_stream_secured((MediaStream *)margaux))) {
+		wait_for_until(&marielle->ms, &margaux->ms, &dummy, 1, 100);
+		elapsed += 100;
+	}
+	BC_ASSERT_TRUE(media_stream_secured((MediaStream *)marielle));
+	BC_ASSERT_TRUE(media_stream_secured((MediaStream *)margaux));
+	BC_ASSERT_TRUE(media_stream_get_srtp_key_source((MediaStream *)marielle, MediaStreamSendRecv, FALSE) ==
+	               MSSrtpKeySourceDTLS);
+	BC_ASSERT_TRUE(media_stream_get_srtp_key_source((MediaStream *)margaux, MediaStreamSendRecv, FALSE) ==
+	               MSSrtpKeySourceDTLS);
+
+	/* Media flows once the keys are set. */
+	wait_for_until(&marielle->ms, &margaux->ms, &dummy, 1, 500);
+	audio_stream_get_local_rtp_stats(margaux, &margaux_stats.rtp);
+	BC_ASSERT_GREATER(margaux_stats.rtp.packet_recv, 0, unsigned long long, "%llu");
+
+end:
+	/* Destroying the DTLS contexts gives the crypto workers back. */
+	audio_stream_stop(marielle);
+	audio_stream_stop(margaux);
+	BC_ASSERT_EQUAL(ms_worker_thread_pool_get_user_count(_factory->crypto_pool), 0, int, "%d");
+	rtp_profile_destroy(profile);
+	bc_free(hello_file);
+}
+
 static void codec_change_for_audio_stream(void) {
 	AudioStream *marielle = audio_stream_new2(_factory, MARIELLE_IP, MARIELLE_RTP_PORT, MARIELLE_RTCP_PORT);
 	stats_t marielle_stats;
@@ -1705,6 +1811,7 @@ static test_t tests[] = {
     TEST_NO_TAG("Encrypted audio stream, encryption mandatory", encrypted_audio_stream_encryption_mandatory),
     TEST_NO_TAG("Encrypted audio stream with key change + encryption mandatory",
                 encrypted_audio_stream_with_key_change_encryption_mandatory),
+    TEST_NO_TAG("DTLS-SRTP audio stream", dtls_srtp_audio_stream),
     TEST_NO_TAG("Double Encrypted audio stream", double_encrypted_audio_stream),
     TEST_NO_TAG("Double Encrypted audio stream with 2 srtp context", double_encrypted_audio_stream_both_streams),
     TEST_NO_TAG("Double Encrypted audio stream, encryption mandatory",
@@ -18,7 +18,9 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <optional>
 #include <string>
 #include <vector>
@@ -31,6 +33,7 @@
 
 #include "baudot/baudot_encoding_context.h"
 #include "mediastreamer2_tester_private.h"
+#include "utils/goertzel_state.h"
 
 using namespace mediastreamer;
 using namespace std;
@@ -853,6 +856,69 @@ static void test_baudot_detection_from_file_no_detection() {
 	                                                  MARGAUX_RTP_PORT, MARGAUX_RTCP_PORT);
 }
 
+static float goertzelTotalEnergy(const vector<int16_t> &samples) {
+	float energy = 0;
+	for (int16_t sample : samples)
+		energy += (float)sample * (float)sample;
+	return energy / (float)samples.size();
+}
+
+static void test_goertzel_filter_bank_same_as_single_filters() {
+	const int samplingFrequency = 48000;
+	/* Baudot and DTMF tones, plus enough frequencies to fill a whole bank. */
+	const int frequencies[GoertzelFilterBank::MaxFrequencies] = {1400, 1800, 697,  770,  852,  941,  1209, 1336,
+	                                                             1477, 1633, 350,  440,  480,  620,  2600, 3000};
+	vector<int16_t> samples(963); /* not a multiple of the SIMD width */
+	uint32_t seed = 1234;
+	for (int16_t &sample : samples) {
+		seed = seed * 1103515245 + 12345;
+		sample = (int16_t)(seed >> 16);
+	}
+	const float totalEnergy = goertzelTotalEnergy(samples);
+
+	for (int size : {1, 2, 3, 4, 5, 8, 10, 16}) {
+		GoertzelFilterBank bank;
+		float energies[GoertzelFilterBank::MaxFrequencies];
+		for (int i = 0; i < size; ++i)
+			bank.setFrequency(i, frequencies[i], samplingFrequency);
+		BC_ASSERT_EQUAL(bank.size(), size, int, "%d");
+		bank.run(samples.data(), (int)samples.size(), totalEnergy, energies);
+
+		/* The bank must give exactly what the filters give one by one. */
+		for (int i = 0; i < size; ++i) {
+			GoertzelState state;
+			state.init(frequencies[i], samplingFrequency);
+			float expected = state.run(samples.data(), (int)samples.size(), totalEnergy);
+			BC_ASSERT_TRUE(memcmp(&energies[i], &expected, sizeof(float)) == 0);
+		}
+	}
+}
+
+static void test_goertzel_filter_bank_tone_selection() {
+	const int samplingFrequency = 8000;
+	const double pi = std::acos(-1.0);
+	GoertzelFilterBank bank;
+	bank.setFrequency(0, 1400, samplingFrequency); /* Baudot mark */
+	bank.setFrequency(1, 1800, samplingFrequency); /* Baudot space */
+
+	for (int tone : {1400, 1800}) {
+		vector<int16_t> samples(160);
+		for (size_t i = 0; i < samples.size(); ++i)
+			samples[i] = (int16_t)(10000 * std::sin(2 * pi * tone * (double)i / samplingFrequency));
+		float energies[GoertzelFilterBank::MaxFrequencies];
+		bank.run(samples.data(), (int)samples.size(), goertzelTotalEnergy(samples), energies);
+		const int expected = tone == 1400 ? 0 : 1;
+		BC_ASSERT_GREATER(energies[expected], 0.5f, float, "%f");
+		BC_ASSERT_LOWER(energies[1 - expected], 0.1f, float, "%f");
+	}
+
+	/* Clearing the bank empties it, and it grows again from the highest index set. */
+	bank.clear();
+	BC_ASSERT_EQUAL(bank.size(), 0, int, "%d");
+	bank.setFrequency(2, 1800, samplingFrequency);
+	BC_ASSERT_EQUAL(bank.size(), 3, int, "%d");
+}
+
 static test_t tests[] = {
     TEST_NO_TAG("Baudot text encoding - Uppercase alphabet", test_baudot_text_encoding_uppercase_alphabet),
     TEST_NO_TAG("Baudot text encoding - Lowercase alphabet", test_baudot_text_encoding_lowercase_alphabet),
@@ -891,6 +957,9 @@ static test_t tests[] = {
                 test_baudot_detection_from_file_letter_by_letter_us),
     TEST_NO_TAG("Baudot detection from file - Stereo Alphabet US", test_baudot_detection_from_file_stereo_alphabet_us),
     TEST_NO_TAG("Baudot detection from file - No detection", test_baudot_detection_from_file_no_detection),
+    TEST_NO_TAG("Goertzel filter bank - Same energies as single filters",
+                test_goertzel_filter_bank_same_as_single_filters),
+    TEST_NO_TAG("Goertzel filter bank - Tone selection", test_goertzel_filter_bank_tone_selection),
 };
 
 extern "C" {
@@ -1172,6 +1172,93 @@ static void simple_encrypted_relayed_data(void) {
 	BC_ASSERT_TRUE(double_encrypted_rtp_relay_data_base(p));
 }
 
+/* Marielle sends bursts of double encrypted packets directly to Margaux who drains them all before the next burst, as
+ * a ticker would. Packets carry an audio level extension so both layers go through the in place inner processing */
+#define THROUGHPUT_PACKETS 5000
+#define THROUGHPUT_BURST 25
+static void double_encrypted_throughput(void) {
+	if (!ms_srtp_supported()) {
+		ms_warning("srtp not available, skiping...");
+		return;
+	}
+	const char *outer_key = "bkTcxXe9N3/vHKKiqQAqmL0qJ+CSiWRat/Tadg==";
+	const char *inner_key = "J74fLdR6tp6EwJVgWjtcGufB7GcR64kAHbIbZyGKVq62acCZmx4mNNLIkus=";
+
+	RtpSession *rtpSession_marielle =
+	    ms_create_duplex_rtp_session(MARIELLE_IP, MARIELLE_RTP_PORT, MARIELLE_RTCP_PORT, ms_factory_get_mtu(_factory));
+	rtp_session_set_remote_addr_and_port(rtpSession_marielle, MARGAUX_IP, MARGAUX_RTP_PORT, MARGAUX_RTCP_PORT);
+	rtp_session_set_profile(rtpSession_marielle, profile);
+	rtp_session_enable_rtcp(rtpSession_marielle, FALSE);
+	rtp_session_set_payload_type(rtpSession_marielle, MARIELLE_PAYLOAD_TYPE);
+	MSMediaStreamSessions marielle = {};
+	marielle.rtp_session = rtpSession_marielle;
+
+	RtpSession *rtpSession_margaux =
+	    ms_create_duplex_rtp_session(MARGAUX_IP, MARGAUX_RTP_PORT, MARGAUX_RTCP_PORT, ms_factory_get_mtu(_factory));
+	rtp_session_set_profile(rtpSession_margaux, profile);
+	rtp_session_enable_jitter_buffer(rtpSession_margaux, FALSE);
+	rtp_session_enable_rtcp(rtpSession_margaux, FALSE);
+	rtp_session_set_payload_type(rtpSession_margaux, MARIELLE_PAYLOAD_TYPE);
+	MSMediaStreamSessions margaux = {};
+	margaux.rtp_session = rtpSession_margaux;
+
+	BC_ASSERT_TRUE(ms_media_stream_sessions_set_srtp_send_key_b64(&marielle, MS_AEAD_AES_128_GCM, outer_key,
+	                                                              MSSrtpKeySourceSDES) == 0);
+	BC_ASSERT_TRUE(ms_media_stream_sessions_set_srtp_inner_send_key_b64(&marielle, MS_AEAD_AES_256_GCM, inner_key,
+	                                                                    MSSrtpKeySourceZRTP) == 0);
+	BC_ASSERT_TRUE(ms_media_stream_sessions_set_srtp_recv_key_b64(&margaux, MS_AEAD_AES_128_GCM, outer_key,
+	                                                              MSSrtpKeySourceSDES) == 0);
+	BC_ASSERT_TRUE(ms_media_stream_sessions_set_srtp_inner_recv_key_b64(&margaux, MS_AEAD_AES_256_GCM, inner_key,
+	                                                                    MSSrtpKeySourceZRTP,
+	                                                                    rtpSession_marielle->snd.ssrc) == 0);
+
+	uint8_t buffer[160];
+	uint32_t user_ts = 0;
+	int packet_sent = 0;
+	int packet_received = 0;
+	uint64_t start = bctbx_get_cur_time_ms();
+	while (packet_sent < THROUGHPUT_PACKETS) {
+		for (int i = 0; i < THROUGHPUT_BURST; i++, packet_sent++) {
+			memset(buffer, packet_sent & 0xFF, sizeof(buffer));
+			mblk_t *sent_packet = rtp_session_create_packet_header(rtpSession_marielle, 0);
+			rtp_add_client_to_mixer_audio_level(sent_packet, RTP_EXTENSION_CLIENT_TO_MIXER_AUDIO_LEVEL, TRUE, -32);
+			sent_packet->b_cont = rtp_create_packet(buffer, sizeof(buffer));
+			BC_ASSERT_TRUE(rtp_session_sendm_with_ts(rtpSession_marielle, sent_packet, user_ts) > 0);
+		}
+		/* drain everything that arrived, 25 packets fit comfortably in the socket buffer */
+		mblk_t *received_packet;
+		while ((received_packet = rtp_session_recvm_with_ts(rtpSession_margaux, user_ts)) != NULL) {
+			uint8_t *payload;
+			int size = rtp_get_payload(received_packet, &payload);
+			BC_ASSERT_EQUAL(size, (int)sizeof(buffer), int, "%d");
+			if (size == (int)sizeof(buffer)) {
+				BC_ASSERT_EQUAL(payload[0], (uint8_t)(packet_received & 0xFF), uint8_t, "%d");
+			}
+			freemsg(received_packet);
+			packet_received++;
+		}
+		user_ts += 160;
+	}
+	uint64_t elapsed = bctbx_get_cur_time_ms() - start;
+	BC_ASSERT_EQUAL(packet_received, THROUGHPUT_PACKETS, int, "%d");
+
+	MSSrtpCryptoStats send_stats, recv_stats;
+	BC_ASSERT_EQUAL(ms_media_stream_sessions_get_srtp_crypto_stats(&marielle, MediaStreamSendOnly, &send_stats), 0,
+	                int, "%d");
+	BC_ASSERT_EQUAL(ms_media_stream_sessions_get_srtp_crypto_stats(&margaux, MediaStreamRecvOnly, &recv_stats), 0,
+	                int, "%d");
+	BC_ASSERT_EQUAL(send_stats.packets, THROUGHPUT_PACKETS, unsigned long long, "%llu");
+	BC_ASSERT_EQUAL(recv_stats.packets, THROUGHPUT_PACKETS, unsigned long long, "%llu");
+	ms_message("Double encryption throughput: %d packets in %d ms, crypto time %llu us to protect (%llu bytes) and %llu "
+	           "us to unprotect (%llu bytes)",
+	           THROUGHPUT_PACKETS, (int)elapsed, (unsigned long long)send_stats.crypto_time_us,
+	           (unsigned long long)send_stats.bytes, (unsigned long long)recv_stats.crypto_time_us,
+	           (unsigned long long)recv_stats.bytes);
+
+	ms_media_stream_sessions_uninit(&marielle);
+	ms_media_stream_sessions_uninit(&margaux);
+}
+
 static test_t tests[] = {
     TEST_NO_TAG("Double Encrypted relayed data", double_encrypted_relayed_data),
     TEST_NO_TAG("Double Encrypted relayed data with volume info", double_encrypted_relayed_data_with_volume),
@@ -1191,6 +1278,7 @@ static test_t tests[] = {
     TEST_NO_TAG("Double Encrypted relayed data autodiscovered bundled sessions",
                 double_encrypted_relayed_data_autodiscoverd_bundled_sessions),
     TEST_NO_TAG("Simple Encrypted relayed data", simple_encrypted_relayed_data),
+    TEST_NO_TAG("Double Encrypted throughput", double_encrypted_throughput),
 };
 
 test_suite_t double_encryption_test_suite = {"RTP Data Double Encryption",
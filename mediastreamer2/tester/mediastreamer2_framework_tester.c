@@ -602,6 +602,85 @@ static void test_worker_threads_2(void) {
 	}
 }
 
+static bool_t do_something_slowly(void *data) {
+	ms_usleep(50000);
+	return do_something(data);
+}
+
+static void test_worker_thread_pool(void) {
+	MSWorkerThreadPool *pool = ms_worker_thread_pool_new("test-pool", 2);
+	MSWorkerThread *w1, *w2, *w3;
+	int something_done = 0;
+
+	/* A new thread is created while the existing ones are busy and the pool is under its limit... */
+	w1 = ms_worker_thread_pool_acquire(pool);
+	w2 = ms_worker_thread_pool_acquire(pool);
+	BC_ASSERT_PTR_NOT_NULL(w1);
+	BC_ASSERT_PTR_NOT_NULL(w2);
+	BC_ASSERT_PTR_NOT_EQUAL(w1, w2);
+	/* ...then the threads are shared. */
+	w3 = ms_worker_thread_pool_acquire(pool);
+	BC_ASSERT_TRUE(w3 == w1 || w3 == w2);
+	BC_ASSERT_EQUAL(ms_worker_thread_pool_get_user_count(pool), 3, int, "%d");
+
+	/* Users without a worker thread are counted too. */
+	ms_worker_thread_pool_add_user(pool);
+	BC_ASSERT_EQUAL(ms_worker_thread_pool_get_user_count(pool), 4, int, "%d");
+	ms_worker_thread_pool_remove_user(pool);
+	BC_ASSERT_EQUAL(ms_worker_thread_pool_get_user_count(pool), 3, int, "%d");
+
+	/* The tasks queued by a user are done when it gives back a shared worker thread, which keeps running. */
+	ms_worker_thread_add_task(w3, do_something_slowly, &something_done);
+	ms_worker_thread_pool_release(pool, w3);
+	BC_ASSERT_EQUAL(something_done, 1, int, "%d");
+	something_done = 0;
+	ms_worker_thread_add_task(w3, do_something, &something_done);
+	BC_ASSERT_TRUE(wait_event(&something_done, 2000));
+	BC_ASSERT_EQUAL(ms_worker_thread_pool_get_user_count(pool), 2, int, "%d");
+
+	/* A thread given back by all its users is freed, and a new one is created on demand. */
+	ms_worker_thread_pool_release(pool, w2);
+	w2 = ms_worker_thread_pool_acquire(pool);
+	something_done = 0;
+	ms_worker_thread_add_task(w2, do_something, &something_done);
+	BC_ASSERT_TRUE(wait_event(&something_done, 2000));
+
+	ms_worker_thread_pool_release(pool, w1);
+	ms_worker_thread_pool_release(pool, w2);
+	BC_ASSERT_EQUAL(ms_worker_thread_pool_get_user_count(pool), 0, int, "%d");
+	ms_worker_thread_pool_destroy(pool);
+}
+
+static void test_video_codec_thread_budget(void) {
+	MSFactory *factory = ms_tester_factory_new();
+	MSWorkerThread *w1, *w2;
+
+	ms_factory_set_video_codec_thread_budget(factory, 4);
+	BC_ASSERT_EQUAL(ms_factory_get_video_codec_thread_budget(factory), 4, int, "%d");
+
+	/* The budget is shared between the codecs running at the same time, be they encoders or decoders. */
+	w1 = ms_factory_acquire_video_codec_worker(factory);
+	BC_ASSERT_EQUAL(ms_factory_get_video_codec_thread_count(factory, 16), 4, int, "%d");
+	BC_ASSERT_EQUAL(ms_factory_get_video_codec_thread_count(factory, 2), 2, int, "%d");
+	ms_factory_register_video_codec(factory);
+	BC_ASSERT_EQUAL(ms_factory_get_video_codec_thread_count(factory, 16), 2, int, "%d");
+	w2 = ms_factory_acquire_video_codec_worker(factory);
+	ms_factory_register_video_codec(factory);
+	ms_factory_register_video_codec(factory);
+	ms_factory_register_video_codec(factory);
+	/* Every codec keeps at least one thread. */
+	BC_ASSERT_EQUAL(ms_factory_get_video_codec_thread_count(factory, 16), 1, int, "%d");
+
+	ms_factory_unregister_video_codec(factory);
+	ms_factory_unregister_video_codec(factory);
+	ms_factory_unregister_video_codec(factory);
+	ms_factory_unregister_video_codec(factory);
+	ms_factory_release_video_codec_worker(factory, w2);
+	BC_ASSERT_EQUAL(ms_factory_get_video_codec_thread_count(factory, 16), 4, int, "%d");
+	ms_factory_release_video_codec_worker(factory, w1);
+	ms_factory_destroy(factory);
+}
+
 static void dummy_encoder_process(MSFilter *f) {
 	mblk_t *im;
 
@@ -701,6 +780,8 @@ static test_t tests[] = {TEST_NO_TAG("Multiple ms_voip_init", filter_register_te
                          TEST_NO_TAG("FilterDesc enabling/disabling", test_filterdesc_enable_disable),
                          TEST_NO_TAG("Worker threads", test_worker_threads),
                          TEST_NO_TAG("Worker threads 2", test_worker_threads_2),
+                         TEST_NO_TAG("Worker thread pool", test_worker_thread_pool),
+                         TEST_NO_TAG("Video codec thread budget", test_video_codec_thread_budget),
 #ifdef VIDEO_ENABLED
                          TEST_NO_TAG("Video processing function", test_video_processing),
                          TEST_NO_TAG("Copy ycbcrbiplanar to true yuv with downscaling",
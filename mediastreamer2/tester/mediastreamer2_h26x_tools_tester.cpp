@@ -19,6 +19,7 @@
  */
 
 #include <fstream>
+#include <functional>
 #include <list>
 #include <sstream>
 #include <string>
@@ -95,6 +96,83 @@ static void bytestream_transcoding_two_consecutive_prevention_thee_bytes() {
 	bytestream_transcoding_test(byteStream);
 }
 
+/* Pack a single H264 NAL unit into FU-A packets numbered from 0 */
+static vector<mblk_t *> packH264Nalu(const vector<uint8_t> &nalu, size_t maxPayloadSize) {
+	MSQueue nalus, rtp;
+	vector<mblk_t *> packets;
+
+	ms_queue_init(&nalus);
+	ms_queue_init(&rtp);
+
+	const H26xToolFactory &factory = H26xToolFactory::get("video/avc");
+	unique_ptr<NalPacker> packer(factory.createNalPacker(maxPayloadSize));
+	packer->setPacketizationMode(NalPacker::NonInterleavedMode);
+
+	mblk_t *m = allocb(nalu.size(), 0);
+	memcpy(m->b_wptr, nalu.data(), nalu.size());
+	m->b_wptr += nalu.size();
+	ms_queue_put(&nalus, m);
+	packer->pack(&nalus, &rtp, 90000);
+
+	uint16_t cseq = 0;
+	while ((m = ms_queue_get(&rtp))) {
+		mblk_set_cseq(m, cseq++);
+		packets.push_back(m);
+	}
+	return packets;
+}
+
+/* Unpack the packets of a fragmented NAL unit in the order given by reorder() and check the output frame */
+static void h264_fua_unpacking_test(const function<void(vector<mblk_t *> &)> &reorder, bool expectCorrupted) {
+	vector<uint8_t> nalu(20000);
+	MSQueue out;
+
+	ms_queue_init(&out);
+	nalu[0] = 0x65; /* IDR slice */
+	for (size_t i = 1; i < nalu.size(); i++)
+		nalu[i] = (uint8_t)(i * 7);
+
+	vector<mblk_t *> packets = packH264Nalu(nalu, 200);
+	BC_ASSERT_GREATER((int)packets.size(), 50, int, "%d");
+	reorder(packets);
+
+	const H26xToolFactory &factory = H26xToolFactory::get("video/avc");
+	unique_ptr<NalUnpacker> unpacker(factory.createNalUnpacker());
+	NalUnpacker::Status status;
+	for (mblk_t *m : packets) {
+		status = unpacker->unpack(m, &out);
+	}
+
+	BC_ASSERT_TRUE(status.frameAvailable);
+	BC_ASSERT_EQUAL(status.frameCorrupted, expectCorrupted, bool, "%d");
+	BC_ASSERT_EQUAL((int)ms_queue_size(&out), 1, int, "%d");
+	mblk_t *om = ms_queue_peek_first(&out);
+	if (!expectCorrupted && om != nullptr) {
+		/* the aggregated NAL unit is output in a single buffer */
+		BC_ASSERT_PTR_NULL(om->b_cont);
+		BC_ASSERT_EQUAL(msgdsize(om), nalu.size(), size_t, "%zu");
+		BC_ASSERT_TRUE(memcmp(om->b_rptr, nalu.data(), nalu.size()) == 0);
+	}
+	ms_queue_flush(&out);
+}
+
+static void h264_fua_in_order_test() {
+	h264_fua_unpacking_test([](vector<mblk_t *> &) {}, false);
+}
+
+static void h264_fua_loss_test() {
+	h264_fua_unpacking_test(
+	    [](vector<mblk_t *> &packets) {
+		    freemsg(packets[packets.size() / 2]);
+		    packets.erase(packets.begin() + packets.size() / 2);
+	    },
+	    true);
+}
+
+static void h264_fua_reorder_test() {
+	h264_fua_unpacking_test([](vector<mblk_t *> &packets) { swap(packets[20], packets[21]); }, true);
+}
+
 #if ENABLE_CRASHING_TESTS
 
 static void packing_unpacking_test(const std::vector<uint8_t> &byteStream, const std::string &mime) {
@@ -151,7 +229,10 @@ static test_t tests[] = {
     TEST_NO_TAG("Bytestream transcoding - paramter sets frame", paramter_sets_bytestream_transcoding_test),
     TEST_NO_TAG("Bytestream transcoding - i-frame", iframe_bytestream_transcoding_test),
     TEST_NO_TAG("Bytestream transcoding - two consecutive prevention three bytes",
-                bytestream_transcoding_two_consecutive_prevention_thee_bytes)
+                bytestream_transcoding_two_consecutive_prevention_thee_bytes),
+    TEST_NO_TAG("H264 FU-A unpacking - in order", h264_fua_in_order_test),
+    TEST_NO_TAG("H264 FU-A unpacking - packet loss", h264_fua_loss_test),
+    TEST_NO_TAG("H264 FU-A unpacking - packet reorder", h264_fua_reorder_test)
 #if ENABLE_CRASHING_TESTS
         ,
     TEST_NO_TAG("H265 Packing/Unpacking - paramter sets frame", packing_unpacking_test_h265_ps),
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of mediastreamer2
+ * (see https://gitlab.linphone.org/BC/public/mediastreamer2).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bctoolbox/defs.h>
+
+#include "mediastreamer2/ice.h"
+#include "mediastreamer2/mediastream.h"
+#include "mediastreamer2_tester.h"
+#include "mediastreamer2_tester_private.h"
+
+/*
+ * Two ICE agents running back-to-back over the loopback interface. Each agent binds one RTP session on 0.0.0.0 and
+ * advertises it through several host candidates using distinct 127.0.0.x addresses, which gives a check list of
+ * nb_addresses * nb_addresses pairs per component, as a multi-homed host would.
+ */
+
+#define ICE_TESTER_TIMEOUT_MS 30000
+
+static MSFactory *_factory = NULL;
+
+static int tester_init(void) {
+	_factory = ms_tester_factory_new();
+	ortp_init();
+	return 0;
+}
+
+static int tester_cleanup(void) {
+	ms_factory_destroy(_factory);
+	return 0;
+}
+
+typedef struct _ice_tester_agent_t {
+	RtpSession *session;
+	OrtpEvQueue *q;
+	IceSession *ice_session;
+	IceCheckList *cl;
+	uint32_t recv_ts;
+	uint64_t processing_time_us; /* Time spent in the ICE processing functions. */
+} ice_tester_agent_t;
+
+static uint64_t elapsed_us(const MSTimeSpec *begin, const MSTimeSpec *end) {
+	return (uint64_t)((end->tv_sec - begin->tv_sec) * 1000000LL + (end->tv_nsec - begin->tv_nsec) / 1000LL);
+}
+
+/* Gather one host candidate per address and component, as done when the session is created or reset. */
+static void ice_tester_agent_gather(ice_tester_agent_t *agent, int nb_addresses) {
+	char ip[32];
+	int rtp_port = rtp_session_get_local_port(agent->session);
+	int rtcp_port = rtp_session_get_local_rtcp_port(agent->session);
+	int i;
+
+	for (i = 0; i < nb_addresses; i++) {
+		snprintf(ip, sizeof(ip), "127.0.0.%i", i + 1);
+		BC_ASSERT_PTR_NOT_NULL(
+		    ice_add_local_candidate(agent->cl, "host", AF_INET, ip, rtp_port, ICE_RTP_COMPONENT_ID, NULL));
+		BC_ASSERT_PTR_NOT_NULL(
+		    ice_add_local_candidate(agent->cl, "host", AF_INET, ip, rtcp_port, ICE_RTCP_COMPONENT_ID, NULL));
+	}
+	BC_ASSERT_EQUAL((int)bctbx_list_size(agent->cl->local_candidates), 2 * nb_addresses, int, "%d");
+	ice_session_compute_candidates_foundations(agent->ice_session);
+	ice_session_choose_default_candidates(agent->ice_session);
+}
+
+static void ice_tester_agent_init(ice_tester_agent_t *agent, IceRole role, int nb_addresses) {
+	memset(agent, 0, sizeof(*agent));
+	agent->session = ms_create_duplex_rtp_session("0.0.0.0", -1, -1, ms_factory_get_mtu(_factory));
+	/* The destination address of the received packets tells which local candidate they are for. */
+	rtp_session_set_pktinfo(agent->session, TRUE);
+	agent->q = ortp_ev_queue_new();
+	rtp_session_register_event_queue(agent->session, agent->q);
+
+	agent->ice_session = ice_session_new();
+	ice_session_set_role(agent->ice_session, role);
+	ice_session_set_max_connectivity_checks(agent->ice_session, 255);
+	agent->cl = ice_check_list_new();
+	ice_check_list_set_rtp_session(agent->cl, agent->session);
+	ice_session_add_check_list(agent->ice_session, agent->cl, 0);
+	ice_tester_agent_gather(agent, nb_addresses);
+}
+
+static void ice_tester_agent_set_remote(ice_tester_agent_t *agent, const ice_tester_agent_t *remote) {
+	const bctbx_list_t *elem;
+
+	ice_session_set_remote_credentials(agent->ice_session, ice_session_local_ufrag(remote->ice_session),
+	                                   ice_session_local_pwd(remote->ice_session));
+	for (elem = remote->cl->local_candidates; elem != NULL; elem = elem->next) {
+		const IceCandidate *candidate = (const IceCandidate *)elem->data;
+		ice_add_remote_candidate(agent->cl, ice_candidate_type(candidate), candidate->taddr.family,
+		                         candidate->taddr.ip, candidate->taddr.port, candidate->componentID,
+		                         candidate->priority, candidate->foundation, candidate->is_default);
+	}
+	ice_session_choose_default_remote_candidates(agent->ice_session);
+}
+
+static void ice_tester_agent_iterate(ice_tester_agent_t *agent) {
+	MSTimeSpec begin;
+	MSTimeSpec end;
+	OrtpEvent *ev;
+	mblk_t *m;
+
+	/* Reading the sockets queues the received STUN packets as events. The sockets are only read when the timestamp
+	 * changes. */
+	while ((m = rtp_session_recvm_with_ts(agent->session, agent->recv_ts++)) != NULL) {
+		freemsg(m);
+	}
+	ms_get_cur_time(&begin);
+	while ((ev = ortp_ev_queue_get(agent->q)) != NULL) {
+		if (ortp_event_get_type(ev) == ORTP_EVENT_STUN_PACKET_RECEIVED) {
+			ice_handle_stun_packet(agent->cl, agent->session, ortp_event_get_data(ev));
+		}
+		ortp_event_destroy(ev);
+	}
+	ice_check_list_process(agent->cl, agent->session);
+	ms_get_cur_time(&end);
+	agent->processing_time_us += elapsed_us(&begin, &end);
+}
+
+static void ice_tester_agent_uninit(ice_tester_agent_t *agent) {
+	ice_session_destroy(agent->ice_session);
+	rtp_session_unregister_event_queue(agent->session, agent->q);
+	ortp_ev_queue_destroy(agent->q);
+	rtp_session_destroy(agent->session);
+}
+
+/* Exchange the candidates of both agents and run the connectivity checks until both check lists complete. */
+static void ice_tester_run_connectivity_checks(ice_tester_agent_t *controlling,
+                                               ice_tester_agent_t *controlled,
+                                               int nb_addresses) {
+	MSTimeSpec begin;
+	MSTimeSpec now;
+	int nb_pairs;
+
+	ice_tester_agent_set_remote(controlling, controlled);
+	ice_tester_agent_set_remote(controlled, controlling);
+
+	controlling->processing_time_us = controlled->processing_time_us = 0;
+	ms_get_cur_time(&begin);
+	ice_session_start_connectivity_checks(controlling->ice_session);
+	ice_session_start_connectivity_checks(controlled->ice_session);
+	nb_pairs = (int)bctbx_list_size(controlling->cl->check_list);
+	BC_ASSERT_EQUAL(nb_pairs, 2 * nb_addresses * nb_addresses, int, "%d");
+
+	do {
+		ice_tester_agent_iterate(controlling);
+		ice_tester_agent_iterate(controlled);
+		if ((ice_check_list_state(controlling->cl) == ICL_Completed) &&
+		    (ice_check_list_state(controlled->cl) == ICL_Completed))
+			break;
+		ms_usleep(1000);
+		ms_get_cur_time(&now);
+	} while (elapsed_us(&begin, &now) < ICE_TESTER_TIMEOUT_MS * 1000LL);
+	ms_get_cur_time(&now);
+
+	BC_ASSERT_EQUAL(ice_check_list_state(controlling->cl), ICL_Completed, int, "%d");
+	BC_ASSERT_EQUAL(ice_check_list_state(controlled->cl), ICL_Completed, int, "%d");
+	ms_message("ICE with %d addresses per agent: %d pairs in the check list, completed in %d ms, processing time %d us "
+	           "(controlling) and %d us (controlled)",
+	           nb_addresses, nb_pairs, (int)(elapsed_us(&begin, &now) / 1000), (int)controlling->processing_time_us,
+	           (int)controlled->processing_time_us);
+}
+
+static void connectivity_checks_between_multihomed_agents(int nb_addresses) {
+	ice_tester_agent_t controlling;
+	ice_tester_agent_t controlled;
+
+	ice_tester_agent_init(&controlling, IR_Controlling, nb_addresses);
+	ice_tester_agent_init(&controlled, IR_Controlled, nb_addresses);
+	ice_tester_run_connectivity_checks(&controlling, &controlled, nb_addresses);
+
+	ice_tester_agent_uninit(&controlling);
+	ice_tester_agent_uninit(&controlled);
+}
+
+static void connectivity_checks_1_address(void) {
+	connectivity_checks_between_multihomed_agents(1);
+}
+
+static void connectivity_checks_4_addresses(void) {
+	connectivity_checks_between_multihomed_agents(4);
+}
+
+static void connectivity_checks_8_addresses(void) {
+	connectivity_checks_between_multihomed_agents(8);
+}
+
+static void connectivity_checks_11_addresses(void) {
+	/* 242 pairs, just below the maximum number of connectivity checks that can be configured. */
+	connectivity_checks_between_multihomed_agents(11);
+}
+
+/*
+ * Run the connectivity checks, then restart or reset both sessions as done by liblinphone for an ICE restart, gather
+ * the candidates again and check that a second round of connectivity checks completes.
+ */
+static void connectivity_checks_after_new_session(bool_t reset) {
+	const int nb_addresses = 4;
+	ice_tester_agent_t controlling;
+	ice_tester_agent_t controlled;
+
+	ice_tester_agent_init(&controlling, IR_Controlling, nb_addresses);
+	ice_tester_agent_init(&controlled, IR_Controlled, nb_addresses);
+	ice_tester_run_connectivity_checks(&controlling, &controlled, nb_addresses);
+
+	if (reset) {
+		ice_session_reset(controlling.ice_session, IR_Controlling);
+		ice_session_reset(controlled.ice_session, IR_Controlled);
+		BC_ASSERT_PTR_NULL(controlling.cl->local_candidates);
+		BC_ASSERT_PTR_NULL(controlled.cl->local_candidates);
+		ice_tester_agent_gather(&controlling, nb_addresses);
+		ice_tester_agent_gather(&controlled, nb_addresses);
+	} else {
+		ice_session_restart(controlling.ice_session, IR_Controlling);
+		ice_session_restart(controlled.ice_session, IR_Controlled);
+		/* The local candidates are kept: gathering them again must not add duplicates. */
+		BC_ASSERT_PTR_NULL(ice_add_local_candidate(controlling.cl, "host", AF_INET, "127.0.0.1",
+		                                           rtp_session_get_local_port(controlling.session),
+		                                           ICE_RTP_COMPONENT_ID, NULL));
+		BC_ASSERT_EQUAL((int)bctbx_list_size(controlling.cl->local_candidates), 2 * nb_addresses, int, "%d");
+	}
+	BC_ASSERT_PTR_NULL(controlling.cl->remote_candidates);
+	BC_ASSERT_PTR_NULL(controlling.cl->check_list);
+	ice_tester_run_connectivity_checks(&controlling, &controlled, nb_addresses);
+
+	ice_tester_agent_uninit(&controlling);
+	ice_tester_agent_uninit(&controlled);
+}
+
+static void connectivity_checks_after_session_restart(void) {
+	connectivity_checks_after_new_session(FALSE);
+}
+
+static void connectivity_checks_after_session_reset(void) {
+	connectivity_checks_after_new_session(TRUE);
+}
+
+static test_t tests[] = {
+    TEST_NO_TAG("Connectivity checks with 1 address", connectivity_checks_1_address),
+    TEST_NO_TAG("Connectivity checks with 4 addresses", connectivity_checks_4_addresses),
+    TEST_NO_TAG("Connectivity checks with 8 addresses", connectivity_checks_8_addresses),
+    TEST_NO_TAG("Connectivity checks with 11 addresses", connectivity_checks_11_addresses),
+    TEST_NO_TAG("Connectivity checks after session restart", connectivity_checks_after_session_restart),
+    TEST_NO_TAG("Connectivity checks after session reset", connectivity_checks_after_session_reset),
+};
+
+test_suite_t ice_test_suite = {"ICE", tester_init, tester_cleanup, NULL, NULL, sizeof(tests) / sizeof(tests[0]), tests, 0};
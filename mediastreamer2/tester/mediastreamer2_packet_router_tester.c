@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of mediastreamer2
+ * (see https://gitlab.linphone.org/BC/public/mediastreamer2).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mediastreamer2/mediastream.h"
+#include "mediastreamer2/mspacketrouter.h"
+#include "mediastreamer2_tester.h"
+#include "mediastreamer2_tester_private.h"
+
+/*
+ * These tests drive the packet router directly, without ticker: RTP packets are put in its input queues, then its
+ * process() function is called and the packets forwarded to each output are counted.
+ */
+
+#define ROUTER_TESTER_PINS 4
+
+typedef struct _RouterTester {
+	MSFactory *factory;
+	MSFilter *router;
+	MSFilter *sources[ROUTER_TESTER_PINS];
+	MSFilter *sinks[ROUTER_TESTER_PINS];
+	RtpSession *session;
+	uint16_t seq[ROUTER_TESTER_PINS];
+	uint32_t ts[ROUTER_TESTER_PINS];
+} RouterTester;
+
+static RouterTester *router_tester_new(void) {
+	RouterTester *rt = ms_new0(RouterTester, 1);
+	MSPacketRouterMode mode = MS_PACKET_ROUTER_MODE_VIDEO;
+	bool_t enabled = TRUE;
+	int i;
+
+	rt->factory = ms_tester_factory_new();
+	rt->router = ms_factory_create_filter(rt->factory, MS_PACKET_ROUTER_ID);
+	ms_filter_call_method(rt->router, MS_PACKET_ROUTER_SET_ROUTING_MODE, &mode);
+	ms_filter_call_method(rt->router, MS_PACKET_ROUTER_SET_FULL_PACKET_MODE_ENABLED, &enabled);
+	/* Key frames are then detected with the frame marking extension, the packets need no real VP8 payload. */
+	ms_filter_call_method(rt->router, MS_PACKET_ROUTER_SET_END_TO_END_ENCRYPTION_ENABLED, &enabled);
+
+	for (i = 0; i < ROUTER_TESTER_PINS; i++) {
+		rt->sources[i] = ms_factory_create_filter(rt->factory, MS_VOID_SOURCE_ID);
+		rt->sinks[i] = ms_factory_create_filter(rt->factory, MS_VOID_SINK_ID);
+		ms_filter_link(rt->sources[i], 0, rt->router, i);
+		ms_filter_link(rt->router, i, rt->sinks[i], 0);
+		rt->seq[i] = (uint16_t)(1000 * (i + 1));
+		rt->ts[i] = 90000 * (i + 1);
+	}
+
+	rt->session = rtp_session_new(RTP_SESSION_SENDONLY);
+
+	return rt;
+}
+
+static void router_tester_destroy(RouterTester *rt) {
+	int i;
+
+	for (i = 0; i < ROUTER_TESTER_PINS; i++) {
+		ms_filter_unlink(rt->sources[i], 0, rt->router, i);
+		ms_filter_unlink(rt->router, i, rt->sinks[i], 0);
+		ms_filter_destroy(rt->sources[i]);
+		ms_filter_destroy(rt->sinks[i]);
+	}
+	ms_filter_destroy(rt->router);
+	rtp_session_destroy(rt->session);
+	ms_factory_destroy(rt->factory);
+	ms_free(rt);
+}
+
+static void router_tester_configure_output(RouterTester *rt, int output, int input) {
+	MSPacketRouterPinData pd = {0};
+
+	pd.input = input;
+	pd.output = output;
+	pd.self = -1;
+	pd.active_speaker_enabled = FALSE;
+	ms_filter_call_method(rt->router, MS_PACKET_ROUTER_CONFIGURE_OUTPUT, &pd);
+}
+
+static void router_tester_set_max_temporal_layer(RouterTester *rt, int output, int layer) {
+	MSPacketRouterTemporalLayerData data;
+
+	data.output = output;
+	data.max_temporal_layer = layer;
+	ms_filter_call_method(rt->router, MS_PACKET_ROUTER_SET_OUTPUT_MAX_TEMPORAL_LAYER, &data);
+}
+
+/* Queue one packet of the current frame of the input, the frame marking has the scalable form if tid >= 0. */
+static void router_tester_put_packet(RouterTester *rt, int input, bool_t start, bool_t end, bool_t key, int tid) {
+	mblk_t *m = rtp_session_create_packet_header(rt->session, 0);
+	uint8_t marker = 0;
+
+	rtp_set_seqnumber(m, rt->seq[input]++);
+	rtp_set_timestamp(m, rt->ts[input]);
+	rtp_set_markbit(m, end);
+	if (start) marker |= RTP_FRAME_MARKER_START;
+	if (end) marker |= RTP_FRAME_MARKER_END;
+	if (key) marker |= RTP_FRAME_MARKER_INDEPENDENT;
+	if (tid >= 0) {
+		marker |= (uint8_t)tid & RTP_FRAME_MARKER_TID_MASK;
+		if (tid > 0) marker |= RTP_FRAME_MARKER_DISCARDABLE | RTP_FRAME_MARKER_BASE_LAYER_SYNC;
+		rtp_add_scalable_frame_marker(m, RTP_EXTENSION_FRAME_MARKING, marker, 0, 0);
+	} else {
+		rtp_add_frame_marker(m, RTP_EXTENSION_FRAME_MARKING, marker);
+	}
+	ms_queue_put(rt->router->inputs[input], m);
+	if (end) rt->ts[input] += 3000;
+}
+
+/* Queue a whole frame made of two packets. */
+static void router_tester_put_frame(RouterTester *rt, int input, bool_t key, int tid) {
+	router_tester_put_packet(rt, input, TRUE, FALSE, key, tid);
+	router_tester_put_packet(rt, input, FALSE, TRUE, key, tid);
+}
+
+static int router_tester_count_output(RouterTester *rt, int output, int *max_tid) {
+	MSQueue *q = rt->router->outputs[output];
+	mblk_t *m;
+	int count = 0;
+
+	if (max_tid) *max_tid = -1;
+	while ((m = ms_queue_get(q)) != NULL) {
+		uint8_t marker = 0;
+
+		if (max_tid && rtp_get_scalable_frame_marker(m, RTP_EXTENSION_FRAME_MARKING, &marker, NULL, NULL)) {
+			*max_tid = MAX(*max_tid, marker & RTP_FRAME_MARKER_TID_MASK);
+		}
+		freemsg(m);
+		count++;
+	}
+	return count;
+}
+
+static void temporal_layer_forwarding(void) {
+	static const int pattern[] = {0, 2, 1, 2};
+	RouterTester *rt = router_tester_new();
+	int i, max_tid;
+
+	/* Three receivers of input 0: all the layers, the base layer only, and the two lowest layers. */
+	router_tester_configure_output(rt, 1, 0);
+	router_tester_configure_output(rt, 2, 0);
+	router_tester_configure_output(rt, 3, 0);
+	router_tester_set_max_temporal_layer(rt, 2, 0);
+	router_tester_set_max_temporal_layer(rt, 3, 1);
+
+	for (i = 0; i < 8; i++) {
+		router_tester_put_frame(rt, 0, i == 0, pattern[i % 4]);
+		ms_filter_process(rt->router);
+	}
+
+	BC_ASSERT_EQUAL(router_tester_count_output(rt, 1, &max_tid), 16, int, "%d");
+	BC_ASSERT_EQUAL(max_tid, 2, int, "%d");
+	BC_ASSERT_EQUAL(router_tester_count_output(rt, 2, &max_tid), 4, int, "%d");
+	BC_ASSERT_EQUAL(max_tid, 0, int, "%d");
+	BC_ASSERT_EQUAL(router_tester_count_output(rt, 3, &max_tid), 8, int, "%d");
+	BC_ASSERT_EQUAL(max_tid, 1, int, "%d");
+
+	/* The limit only applies from the next frame: a frame is never cut in the middle. */
+	router_tester_put_packet(rt, 0, TRUE, FALSE, FALSE, 2);
+	ms_filter_process(rt->router);
+	router_tester_set_max_temporal_layer(rt, 1, 0);
+	router_tester_put_packet(rt, 0, FALSE, TRUE, FALSE, 2);
+	router_tester_put_frame(rt, 0, FALSE, 2);
+	router_tester_put_frame(rt, 0, FALSE, 0);
+	ms_filter_process(rt->router);
+	BC_ASSERT_EQUAL(router_tester_count_output(rt, 1, NULL), 4, int, "%d");
+	BC_ASSERT_EQUAL(router_tester_count_output(rt, 2, NULL), 2, int, "%d");
+	BC_ASSERT_EQUAL(router_tester_count_output(rt, 3, NULL), 2, int, "%d");
+
+	/* Removing the limit forwards all the layers again. */
+	router_tester_set_max_temporal_layer(rt, 2, -1);
+	router_tester_put_frame(rt, 0, FALSE, 2);
+	ms_filter_process(rt->router);
+	BC_ASSERT_EQUAL(router_tester_count_output(rt, 2, NULL), 2, int, "%d");
+
+	router_tester_destroy(rt);
+}
+
+static void non_scalable_stream_forwarding(void) {
+	RouterTester *rt = router_tester_new();
+	int i;
+
+	/* A stream without the scalable form of the frame marking only has a base layer, nothing is dropped. */
+	router_tester_configure_output(rt, 1, 0);
+	router_tester_set_max_temporal_layer(rt, 1, 0);
+
+	for (i = 0; i < 4; i++) {
+		router_tester_put_frame(rt, 0, i == 0, -1);
+		ms_filter_process(rt->router);
+	}
+
+	BC_ASSERT_EQUAL(router_tester_count_output(rt, 1, NULL), 8, int, "%d");
+
+	router_tester_destroy(rt);
+}
+
+static test_t tests[] = {
+    TEST_NO_TAG("Temporal layer forwarding", temporal_layer_forwarding),
+    TEST_NO_TAG("Non-scalable stream forwarding", non_scalable_stream_forwarding),
+};
+
+test_suite_t packet_router_test_suite = {
+    "Packet router", NULL, NULL, NULL, NULL, sizeof(tests) / sizeof(tests[0]), tests, 0};
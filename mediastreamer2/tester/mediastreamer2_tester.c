@@ -110,6 +110,9 @@ void mediastreamer2_tester_init(void (*ftester_printf)(int level, const char *fm
 #ifdef VIDEO_ENABLED
 	bc_tester_add_suite(&video_stream_test_suite);
 	bc_tester_add_suite(&h26x_tools_test_suite);
+	bc_tester_add_suite(&vp8rtpfmt_test_suite);
+	bc_tester_add_suite(&packet_router_test_suite);
+	bc_tester_add_suite(&video_conference_test_suite);
 #ifdef QRCODE_ENABLED
 	bc_tester_add_suite(&qrcode_test_suite);
 #endif
@@ -121,6 +124,7 @@ void mediastreamer2_tester_init(void (*ftester_printf)(int level, const char *fm
 	bc_tester_add_suite(&neon_test_suite);
 #endif
 	bc_tester_add_suite(&text_stream_test_suite);
+	bc_tester_add_suite(&ice_test_suite);
 #ifdef HAVE_PCAP
 	bc_tester_add_suite(&codec_impl_test_suite);
 	bc_tester_add_suite(&jitterbuffer_test_suite);
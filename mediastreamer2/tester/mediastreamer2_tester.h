@@ -45,9 +45,13 @@ extern test_suite_t player_test_suite;
 extern test_suite_t recorder_test_suite;
 extern test_suite_t text_stream_test_suite;
 extern test_suite_t h26x_tools_test_suite;
+extern test_suite_t vp8rtpfmt_test_suite;
+extern test_suite_t packet_router_test_suite;
+extern test_suite_t video_conference_test_suite;
 extern test_suite_t double_encryption_test_suite;
 extern test_suite_t smff_test_suite;
 extern test_suite_t noise_suppression_test_suite;
+extern test_suite_t ice_test_suite;
 #ifdef HAVE_PCAP
 extern test_suite_t codec_impl_test_suite;
 extern test_suite_t jitterbuffer_test_suite;
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2010-2023 Belledonne Communications SARL.
+ *
+ * This file is part of mediastreamer2
+ * (see https://gitlab.linphone.org/BC/public/mediastreamer2).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "bctoolbox/tester.h"
+#include "mediastreamer2/mediastream.h"
+
+#include "mediastreamer2_tester_private.h"
+#include "voip/video-conference.h"
+
+using namespace ms2;
+
+namespace {
+
+/*
+ * Gives access to the member lists of the conference, so that endpoints can be declared without running their
+ * streams: only the bitrate requests are exercised.
+ */
+class VideoConferenceTester : public VideoConferenceAllToAll {
+public:
+	VideoConferenceTester(MSFactory *factory, const MSVideoConferenceParams *params)
+	    : VideoConferenceAllToAll(factory, params) {
+	}
+
+	~VideoConferenceTester() {
+		for (const auto &ep : mOwnedEndpoints) {
+			if (ep->mOutPin > -1) unconfigureOutput(ep->mOutPin);
+			video_stream_stop(ep->mSt);
+		}
+		bctbx_list_free(mMembers);
+		bctbx_list_free(mEndpoints);
+	}
+
+	// A participant sending its video labelled name.
+	VideoEndpoint *addSender(const std::string &name) {
+		VideoEndpoint *ep = createEndpoint(name);
+		ep->mPin = findFreeInputPin();
+		mMembers = bctbx_list_append(mMembers, ep);
+		return ep;
+	}
+
+	// A participant receiving the video labelled name, through a link of the given bandwidth.
+	VideoEndpoint *addReceiver(const std::string &name, int bandwidth) {
+		VideoEndpoint *ep = createEndpoint(name);
+		ep->mOutPin = findFreeOutputPin();
+		ep->mLastTmmbrReceived = bandwidth;
+		mEndpoints = bctbx_list_append(mEndpoints, ep);
+		connectEndpoint(ep);
+		return ep;
+	}
+
+private:
+	VideoEndpoint *createEndpoint(const std::string &name) {
+		auto ep = std::make_unique<VideoEndpoint>();
+		ep->mSt = video_stream_new(getMixer()->factory, -1, -1, FALSE);
+		ep->mName = name;
+		ep->mIsRemote = TRUE;
+		ep->mConference = (MSVideoConference *)this;
+		mOwnedEndpoints.push_back(std::move(ep));
+		return mOwnedEndpoints.back().get();
+	}
+
+	std::vector<std::unique_ptr<VideoEndpoint>> mOwnedEndpoints;
+};
+
+} // namespace
+
+static void bitrate_request_per_sender(void) {
+	MSFactory *factory = ms_tester_factory_new();
+	MSVideoConferenceParams params = {};
+	params.mode = MSConferenceModeRouterFullPacket;
+	params.codec_mime_type = "VP8";
+	auto conf = std::make_unique<VideoConferenceTester>(factory, &params);
+
+	// Alice's video is received through a good and a poor link, Bob's video through a medium one only.
+	VideoEndpoint *alice = conf->addSender("alice");
+	VideoEndpoint *bob = conf->addSender("bob");
+	VideoEndpoint *aliceFast = conf->addReceiver("alice", 2000000);
+	VideoEndpoint *aliceSlow = conf->addReceiver("alice", 100000);
+	VideoEndpoint *bobMedium = conf->addReceiver("bob", 500000);
+	BC_ASSERT_EQUAL(aliceFast->mSource, alice->mPin, int, "%d");
+	BC_ASSERT_EQUAL(aliceSlow->mSource, alice->mPin, int, "%d");
+	BC_ASSERT_EQUAL(bobMedium->mSource, bob->mPin, int, "%d");
+
+	// Each sender is requested the bitrate of its own receivers only.
+	conf->updateBitrateRequest();
+	BC_ASSERT_EQUAL(alice->mRequestedBitrate, 100000, int, "%d");
+	BC_ASSERT_EQUAL(bob->mRequestedBitrate, 500000, int, "%d");
+
+	// The poor link of one of Alice's receivers getting better raises Alice's bitrate, not Bob's.
+	aliceSlow->mLastTmmbrReceived = 1000000;
+	conf->updateBitrateRequest();
+	BC_ASSERT_EQUAL(alice->mRequestedBitrate, 1000000, int, "%d");
+	BC_ASSERT_EQUAL(bob->mRequestedBitrate, 500000, int, "%d");
+
+	// And Bob's receiver degrading only lowers Bob's bitrate.
+	bobMedium->mLastTmmbrReceived = 200000;
+	conf->updateBitrateRequest();
+	BC_ASSERT_EQUAL(alice->mRequestedBitrate, 1000000, int, "%d");
+	BC_ASSERT_EQUAL(bob->mRequestedBitrate, 200000, int, "%d");
+
+	conf.reset();
+	ms_factory_destroy(factory);
+}
+
+static test_t tests[] = {
+    TEST_NO_TAG("Bitrate request per sender", bitrate_request_per_sender),
+};
+
+test_suite_t video_conference_test_suite = {
+    "Video conference", NULL, NULL, NULL, NULL, sizeof(tests) / sizeof(tests[0]), tests, 0};
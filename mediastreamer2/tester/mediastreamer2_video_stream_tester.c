@@ -220,6 +220,10 @@ typedef struct _video_stream_tester_stats_t {
 
 	int number_of_framemarking_start;
 	int number_of_framemarking_end;
+	int number_of_framemarking_start_per_tid[RTP_FRAME_MARKER_TID_MASK + 1];
+	int number_of_framemarking_keyframe_not_in_base_layer;
+	int number_of_framemarking_layer_pattern_not_restarted;
+	bool_t framemarking_last_start_was_keyframe;
 
 } video_stream_tester_stats_t;
 
@@ -1428,14 +1432,23 @@ static void fec_video_stream_h264(void) {
 static void frame_marker_received(BCTBX_UNUSED(MSFilter *f), uint8_t marker, void *user_data) {
 	video_stream_tester_stats_t *stats = (video_stream_tester_stats_t *)user_data;
 	if (marker & RTP_FRAME_MARKER_START) {
+		int tid = marker & RTP_FRAME_MARKER_TID_MASK;
+		bool_t keyframe = (marker & RTP_FRAME_MARKER_INDEPENDENT) != 0;
+
 		stats->number_of_framemarking_start++;
+		stats->number_of_framemarking_start_per_tid[tid]++;
+		if (keyframe && tid != 0) stats->number_of_framemarking_keyframe_not_in_base_layer++;
+		/* With 3 layers, the pattern is 0, 2, 1, 2: the frame following a keyframe must be the second one. */
+		if (stats->framemarking_last_start_was_keyframe && !keyframe && tid != 2)
+			stats->number_of_framemarking_layer_pattern_not_restarted++;
+		stats->framemarking_last_start_was_keyframe = keyframe;
 	}
 	if (marker & RTP_FRAME_MARKER_END) {
 		stats->number_of_framemarking_end++;
 	}
 }
 
-static void basic_vp8_stream_with_frame_marking(void) {
+static void vp8_stream_with_frame_marking(int temporal_layers) {
 	video_stream_tester_t *marielle = video_stream_tester_new();
 	MSConnectionHelper ch;
 	bool_t activate = TRUE;
@@ -1444,6 +1457,7 @@ static void basic_vp8_stream_with_frame_marking(void) {
 
 	create_video_stream(marielle, VP8_PAYLOAD_TYPE);
 	video_stream_set_frame_marking_extension_id(marielle->vs, RTP_EXTENSION_FRAME_MARKING);
+	video_stream_set_temporal_layers(marielle->vs, temporal_layers);
 
 	RtpSession *session = ms_create_duplex_rtp_session("127.0.0.1", -1, -1, ms_factory_get_mtu(_factory));
 	int local_rtp = rtp_session_get_local_port(session);
@@ -1473,9 +1487,23 @@ static void basic_vp8_stream_with_frame_marking(void) {
 	                                   VP8_PAYLOAD_TYPE, 50, marielle->cam),
 	                0, int, "%d");
 
-	BC_ASSERT_TRUE(wait_for_until(&marielle->vs->ms, NULL, &marielle->stats.number_of_framemarking_start, 3, 5000));
+	BC_ASSERT_TRUE(wait_for_until(&marielle->vs->ms, NULL, &marielle->stats.number_of_framemarking_start,
+	                              temporal_layers > 1 ? 12 : 3, 5000));
 	BC_ASSERT_GREATER(marielle->stats.number_of_framemarking_end, 2, int, "%d");
 
+	if (temporal_layers > 1) {
+		/* Every layer is present and the keyframes, starting with the first one, are in the base layer. */
+		BC_ASSERT_GREATER(marielle->stats.number_of_framemarking_start_per_tid[0], 0, int, "%d");
+		BC_ASSERT_GREATER(marielle->stats.number_of_framemarking_start_per_tid[1], 0, int, "%d");
+		BC_ASSERT_GREATER(marielle->stats.number_of_framemarking_start_per_tid[2], 0, int, "%d");
+		BC_ASSERT_EQUAL(marielle->stats.number_of_framemarking_keyframe_not_in_base_layer, 0, int, "%d");
+		BC_ASSERT_EQUAL(marielle->stats.number_of_framemarking_layer_pattern_not_restarted, 0, int, "%d");
+	} else {
+		/* The non-scalable form carries no layer information. */
+		BC_ASSERT_EQUAL(marielle->stats.number_of_framemarking_start_per_tid[0],
+		                marielle->stats.number_of_framemarking_start, int, "%d");
+	}
+
 	ms_ticker_detach(ms_tester_ticker, rtp_receive);
 	ms_tester_destroy_ticker();
 
@@ -1492,6 +1520,14 @@ end:
 	video_stream_tester_destroy(marielle);
 }
 
+static void basic_vp8_stream_with_frame_marking(void) {
+	vp8_stream_with_frame_marking(1);
+}
+
+static void vp8_stream_with_temporal_layers(void) {
+	vp8_stream_with_frame_marking(3);
+}
+
 static test_t tests[] = {
     TEST_NO_TAG("Basic video stream VP8", basic_video_stream_vp8),
     TEST_NO_TAG("Basic video stream H264", basic_video_stream_all_h264_codec_combinations),
@@ -1520,6 +1556,7 @@ static test_t tests[] = {
     TEST_NO_TAG("FEC video stream VP8", fec_video_stream_vp8),
     TEST_NO_TAG("FEC video stream H264", fec_video_stream_h264),
     TEST_NO_TAG("Basic VP8 stream with frame marking", basic_vp8_stream_with_frame_marking),
+    TEST_NO_TAG("VP8 stream with temporal layers", vp8_stream_with_temporal_layers),
 };
 
 test_suite_t video_stream_test_suite = {
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2010-2022 Belledonne Communications SARL.
+ *
+ * This file is part of mediastreamer2
+ * (see https://gitlab.linphone.org/BC/public/mediastreamer2).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mediastreamer2/mscommon.h"
+#include "mediastreamer2_tester.h"
+#include "voip/vp8rtpfmt.h"
+
+#define FIRST_PARTITION_SIZE 100
+#define FRAME_SIZE 120000
+#define MAX_PAYLOAD_SIZE 1000
+#define MAX_PACKETS 256
+
+/*
+ * Build a VP8 key frame with two partitions: the frame header followed by a first partition that
+ * decodes to zeros (hence a single DCT partition), then the DCT partition filled with a pattern.
+ */
+static void build_key_frame(uint8_t *frame) {
+	uint32_t tag = (1 << 4) | (FIRST_PARTITION_SIZE << 5); /* key frame, version 0, show frame */
+	int i;
+
+	memset(frame, 0, FRAME_SIZE);
+	frame[0] = tag & 0xFF;
+	frame[1] = (tag >> 8) & 0xFF;
+	frame[2] = (tag >> 16) & 0xFF;
+	frame[3] = 0x9d; /* start code */
+	frame[4] = 0x01;
+	frame[5] = 0x2a;
+	frame[6] = 320 & 0xFF; /* width */
+	frame[7] = 320 >> 8;
+	frame[8] = 240 & 0xFF; /* height */
+	frame[9] = 240 >> 8;
+	for (i = 10 + FIRST_PARTITION_SIZE; i < FRAME_SIZE; i++) {
+		frame[i] = (uint8_t)(i * 7);
+	}
+}
+
+static Vp8RtpFmtPacket *create_partition_packet(const uint8_t *data, size_t size, uint8_t pid, bool_t marker) {
+	Vp8RtpFmtPacket *packet = ms_new0(Vp8RtpFmtPacket, 1);
+	packet->m = allocb(size, 0);
+	memcpy(packet->m->b_wptr, data, size);
+	packet->m->b_wptr += size;
+	mblk_set_timestamp_info(packet->m, 90000);
+	mblk_set_marker_info(packet->m, marker);
+	packet->pd = ms_new0(Vp8RtpFmtPayloadDescriptor, 1);
+	packet->pd->start_of_partition = TRUE;
+	packet->pd->pid = pid;
+	return packet;
+}
+
+/* Packetize the frame, return the number of RTP packets */
+static int pack_key_frame(const uint8_t *frame, mblk_t **packets) {
+	Vp8RtpFmtPackerCtx packer;
+	MSQueue q;
+	MSList *partitions = NULL;
+	mblk_t *m;
+	int nb_packets = 0;
+
+	ms_queue_init(&q);
+	partitions =
+	    bctbx_list_append(partitions, create_partition_packet(frame, 10 + FIRST_PARTITION_SIZE, 0, FALSE));
+	partitions = bctbx_list_append(partitions, create_partition_packet(frame + 10 + FIRST_PARTITION_SIZE,
+	                                                                   FRAME_SIZE - 10 - FIRST_PARTITION_SIZE, 1, TRUE));
+	vp8rtpfmt_packer_init(&packer, MAX_PAYLOAD_SIZE);
+	vp8rtpfmt_packer_process(&packer, partitions, &q);
+	vp8rtpfmt_packer_uninit(&packer);
+	while ((m = ms_queue_get(&q)) != NULL && nb_packets < MAX_PACKETS) {
+		packets[nb_packets++] = m;
+	}
+	return nb_packets;
+}
+
+/* Feed the packets in the given order, -1 entries are lost packets, and check whether the key frame is output. */
+static void unpack_key_frame(const int *order, int nb_packets, bool_t output_partitions, bool_t expect_frame) {
+	uint8_t *frame = ms_malloc(FRAME_SIZE);
+	mblk_t *packets[MAX_PACKETS];
+	Vp8RtpFmtUnpackerCtx unpacker;
+	Vp8RtpFmtFrameInfo frame_info;
+	MSQueue in, out;
+	int packed;
+	int i;
+
+	build_key_frame(frame);
+	packed = pack_key_frame(frame, packets);
+	BC_ASSERT_GREATER(packed, 100, int, "%d");
+	BC_ASSERT_EQUAL(packed, nb_packets, int, "%d");
+
+	ms_queue_init(&in);
+	ms_queue_init(&out);
+	for (i = 0; i < nb_packets; i++) {
+		if (order[i] >= 0) {
+			ms_queue_put(&in, packets[order[i]]);
+			packets[order[i]] = NULL;
+		}
+	}
+	for (i = 0; i < packed; i++) {
+		if (packets[i] != NULL) freemsg(packets[i]);
+	}
+
+	vp8rtpfmt_unpacker_init(&unpacker, NULL, FALSE, TRUE, output_partitions);
+	vp8rtpfmt_unpacker_feed(&unpacker, &in);
+	if (expect_frame) {
+		BC_ASSERT_EQUAL(vp8rtpfmt_unpacker_get_frame(&unpacker, &out, &frame_info), 0, int, "%d");
+		BC_ASSERT_TRUE(frame_info.keyframe);
+		if (output_partitions) {
+			mblk_t *first = ms_queue_get(&out);
+			mblk_t *second = ms_queue_get(&out);
+			BC_ASSERT_PTR_NOT_NULL(first);
+			BC_ASSERT_PTR_NOT_NULL(second);
+			if (first != NULL && second != NULL) {
+				BC_ASSERT_PTR_NULL(first->b_cont);
+				BC_ASSERT_PTR_NULL(second->b_cont);
+				BC_ASSERT_EQUAL(msgdsize(first), 10 + FIRST_PARTITION_SIZE, size_t, "%zu");
+				BC_ASSERT_EQUAL(msgdsize(second), FRAME_SIZE - 10 - FIRST_PARTITION_SIZE, size_t, "%zu");
+				BC_ASSERT_TRUE(memcmp(first->b_rptr, frame, 10 + FIRST_PARTITION_SIZE) == 0);
+				BC_ASSERT_TRUE(memcmp(second->b_rptr, frame + 10 + FIRST_PARTITION_SIZE,
+				                      FRAME_SIZE - 10 - FIRST_PARTITION_SIZE) == 0);
+				BC_ASSERT_TRUE(mblk_get_marker_info(second));
+			}
+			if (first) freemsg(first);
+			if (second) freemsg(second);
+		} else {
+			mblk_t *om = ms_queue_get(&out);
+			BC_ASSERT_PTR_NOT_NULL(om);
+			if (om != NULL) {
+				/* the whole frame is output in a single buffer */
+				BC_ASSERT_PTR_NULL(om->b_cont);
+				BC_ASSERT_EQUAL(msgdsize(om), FRAME_SIZE, size_t, "%zu");
+				BC_ASSERT_TRUE(memcmp(om->b_rptr, frame, FRAME_SIZE) == 0);
+				BC_ASSERT_TRUE(mblk_get_marker_info(om));
+				BC_ASSERT_EQUAL(mblk_get_timestamp_info(om), 90000, int, "%d");
+				freemsg(om);
+			}
+		}
+	} else {
+		BC_ASSERT_EQUAL(vp8rtpfmt_unpacker_get_frame(&unpacker, &out, &frame_info), -1, int, "%d");
+	}
+	BC_ASSERT_TRUE(ms_queue_empty(&out));
+	ms_queue_flush(&out);
+	vp8rtpfmt_unpacker_uninit(&unpacker);
+	ms_free(frame);
+}
+
+static int key_frame_packets_count(void) {
+	uint8_t *frame = ms_malloc(FRAME_SIZE);
+	mblk_t *packets[MAX_PACKETS];
+	int nb_packets;
+	int i;
+
+	build_key_frame(frame);
+	nb_packets = pack_key_frame(frame, packets);
+	for (i = 0; i < nb_packets; i++) {
+		freemsg(packets[i]);
+	}
+	ms_free(frame);
+	return nb_packets;
+}
+
+static void unpack_in_order(bool_t output_partitions) {
+	int order[MAX_PACKETS];
+	int nb_packets = key_frame_packets_count();
+	int i;
+
+	for (i = 0; i < nb_packets; i++) {
+		order[i] = i;
+	}
+	unpack_key_frame(order, nb_packets, output_partitions, TRUE);
+}
+
+static void unpack_frame_in_order(void) {
+	unpack_in_order(FALSE);
+}
+
+static void unpack_partitions_in_order(void) {
+	unpack_in_order(TRUE);
+}
+
+static void unpack_with_loss(int lost_index) {
+	int order[MAX_PACKETS];
+	int nb_packets = key_frame_packets_count();
+	int i;
+
+	for (i = 0; i < nb_packets; i++) {
+		order[i] = (i == lost_index) ? -1 : i;
+	}
+	unpack_key_frame(order, nb_packets, FALSE, FALSE);
+}
+
+static void unpack_first_packet_lost(void) {
+	unpack_with_loss(0);
+}
+
+static void unpack_middle_packet_lost(void) {
+	unpack_with_loss(key_frame_packets_count() / 2);
+}
+
+static void unpack_reordered_packets(void) {
+	int order[MAX_PACKETS];
+	int nb_packets = key_frame_packets_count();
+	int i;
+
+	for (i = 0; i < nb_packets; i++) {
+		order[i] = i;
+	}
+	order[nb_packets / 2] = nb_packets / 2 + 1;
+	order[nb_packets / 2 + 1] = nb_packets / 2;
+	unpack_key_frame(order, nb_packets, FALSE, FALSE);
+}
+
+static test_t tests[] = {
+    TEST_NO_TAG("Unpack frame in order", unpack_frame_in_order),
+    TEST_NO_TAG("Unpack partitions in order", unpack_partitions_in_order),
+    TEST_NO_TAG("Unpack with first packet lost", unpack_first_packet_lost),
+    TEST_NO_TAG("Unpack with middle packet lost", unpack_middle_packet_lost),
+    TEST_NO_TAG("Unpack reordered packets", unpack_reordered_packets),
+};
+
+test_suite_t vp8rtpfmt_test_suite = {
+    "VP8 RTP format", NULL, NULL, NULL, NULL, sizeof(tests) / sizeof(tests[0]), tests, 0};
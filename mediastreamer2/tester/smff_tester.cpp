@@ -319,10 +319,150 @@ static void append_with_empty_track(void) {
 	_write_append_and_read(true);
 }
 
+static void write_large_records(void) {
+	string fileName = testerRandomFileName("large-", ".smff");
+	SMFF::FileWriter fw;
+	const int numVideoRecords = 20;
+	const size_t recordSize = 100000; /* much more than a block of the asynchronous writer */
+	vector<uint8_t> buffer(recordSize);
+
+	BC_ASSERT_TRUE(fw.open(fileName, false) == 0);
+	TrackWriterInterface &tw = fw.addTrack(0, "av1", TrackInterface::MediaType::Video, 90000, 1).value();
+	for (int i = 0; i < numVideoRecords; ++i) {
+		RecordInterface rec;
+		for (size_t k = 0; k < recordSize; ++k)
+			buffer[k] = (uint8_t)(i + k);
+		rec.timestamp = (uint32_t)i * 3000;
+		rec.data.inputBuffer = buffer.data();
+		rec.size = recordSize;
+		tw.addRecord(rec);
+	}
+	fw.close();
+
+	SMFF::FileReader fr;
+	BC_ASSERT_TRUE(fr.open(fileName) == 0);
+	auto trackReaderList = fr.getTrackReaders();
+	if (BC_ASSERT_TRUE(trackReaderList.size() == 1)) {
+		TrackReaderInterface &tr = trackReaderList.front();
+		BC_ASSERT_EQUAL((int)dynamic_cast<SMFF::TrackReader &>(tr).getNumRecords(), numVideoRecords, int, "%i");
+		vector<uint8_t> readBuffer(recordSize);
+		for (int i = 0; i < numVideoRecords; ++i) {
+			RecordInterface rec;
+			rec.timestamp = (uint32_t)i * 3000;
+			rec.data.outputBuffer = readBuffer.data();
+			rec.size = readBuffer.size();
+			if (!BC_ASSERT_TRUE(tr.read(rec))) break;
+			BC_ASSERT_EQUAL((int)rec.size, (int)recordSize, int, "%i");
+			bool same = true;
+			for (size_t k = 0; k < recordSize && same; ++k)
+				same = readBuffer[k] == (uint8_t)(i + k);
+			BC_ASSERT_TRUE(same);
+			tr.next();
+		}
+	}
+	fr.close();
+}
+
+static void records_dropped_when_writer_is_late(void) {
+	string fileName = testerRandomFileName("dropped-", ".smff");
+	SMFF::FileWriter fw;
+	/* Less than a block and no periodic flush: nothing is written before close(), so the queue fills up. */
+	fw.setMaxPendingWriteSize(64);
+	fw.setFlushInterval(0);
+
+	BC_ASSERT_TRUE(fw.open(fileName, false) == 0);
+	TrackWriterInterface &tw = fw.addTrack(0, "opus", TrackInterface::MediaType::Audio, 48000, 2).value();
+	const vector<string> payloads = {string(20, 'a'), string(20, 'b'), string(20, 'c'), string(20, 'd'), "eeee"};
+	for (size_t i = 0; i < payloads.size(); ++i) {
+		RecordInterface rec;
+		rec.timestamp = (uint32_t)i * 960;
+		rec.data.inputBuffer = (const uint8_t *)payloads[i].c_str();
+		rec.size = payloads[i].size();
+		tw.addRecord(rec);
+	}
+	fw.close();
+
+	/* The fourth record did not fit in the queue and is missing, the others are intact. */
+	const vector<string> expected = {payloads[0], payloads[1], payloads[2], payloads[4]};
+	const vector<uint32_t> expectedTimestamps = {0, 960, 1920, 3840};
+	SMFF::FileReader fr;
+	BC_ASSERT_TRUE(fr.open(fileName) == 0);
+	auto trackReaderList = fr.getTrackReaders();
+	if (BC_ASSERT_TRUE(trackReaderList.size() == 1)) {
+		TrackReaderInterface &tr = trackReaderList.front();
+		BC_ASSERT_EQUAL((int)dynamic_cast<SMFF::TrackReader &>(tr).getNumRecords(), (int)expected.size(), int, "%i");
+		for (size_t i = 0; i < expected.size(); ++i) {
+			RecordInterface rec;
+			uint8_t buffer[40];
+			rec.timestamp = expectedTimestamps[i];
+			rec.data.outputBuffer = buffer;
+			rec.size = sizeof(buffer);
+			if (!BC_ASSERT_TRUE(tr.read(rec))) break;
+			BC_ASSERT_EQUAL((int)rec.size, (int)expected[i].size(), int, "%i");
+			BC_ASSERT_TRUE(memcmp(buffer, expected[i].c_str(), rec.size) == 0);
+			tr.next();
+		}
+	}
+	fr.close();
+}
+
+/* A file system failing the writes of record data, the root at the beginning of the file being still writable. */
+static bctbx_io_methods_t failingWriteMethods;
+static ssize_t (*standardWrite)(bctbx_vfs_file_t *pFile, const void *buf, size_t count, off_t offset);
+
+static ssize_t failing_write(bctbx_vfs_file_t *pFile, const void *buf, size_t count, off_t offset) {
+	if (offset == 0) return standardWrite(pFile, buf, count, offset);
+	return BCTBX_VFS_ERROR;
+}
+
+static int failing_write_open(BCTBX_UNUSED(bctbx_vfs_t *pVfs),
+                              bctbx_vfs_file_t *pFile,
+                              const char *fName,
+                              int openFlags) {
+	bctbx_vfs_t *standardVfs = bctbx_vfs_get_standard();
+	int ret = standardVfs->pFuncOpen(standardVfs, pFile, fName, openFlags);
+	if (ret == 0) {
+		failingWriteMethods = *pFile->pMethods;
+		standardWrite = pFile->pMethods->pFuncWrite;
+		failingWriteMethods.pFuncWrite = failing_write;
+		pFile->pMethods = &failingWriteMethods;
+	}
+	return ret;
+}
+
+static void file_invalid_when_records_are_not_written(void) {
+	string fileName = testerRandomFileName("failed-", ".smff");
+	bctbx_vfs_t failingWriteVfs = {"failing write", failing_write_open};
+	SMFF::FileWriter fw;
+
+	bctbx_vfs_set_default(&failingWriteVfs);
+	BC_ASSERT_TRUE(fw.open(fileName, false) == 0);
+	TrackWriterInterface &tw = fw.addTrack(0, "opus", TrackInterface::MediaType::Audio, 48000, 2).value();
+	for (int i = 0; i < 10; ++i) {
+		RecordInterface rec;
+		const string payload(20, (char)('a' + i));
+		rec.timestamp = (uint32_t)i * 960;
+		rec.data.inputBuffer = (const uint8_t *)payload.c_str();
+		rec.size = payload.size();
+		tw.addRecord(rec);
+	}
+	/* The records could not be written, so the file is not closed as a valid one. */
+	BC_ASSERT_EQUAL(fw.close(), -1, int, "%i");
+	bctbx_vfs_set_default(bctbx_vfs_get_standard());
+
+	SMFF::FileReader fr;
+	BC_ASSERT_TRUE(fr.open(fileName) != 0);
+	fr.close();
+}
+
 static test_t tests[] = {TEST_NO_TAG("Write and read", write_and_read),
                          TEST_NO_TAG("With 2 synchronized tracks.", two_synchronized_tracks),
                          TEST_NO_TAG("Write, append, and read", write_append_and_read),
-                         TEST_NO_TAG("Append with empty track", append_with_empty_track)};
+                         TEST_NO_TAG("Append with empty track", append_with_empty_track),
+                         TEST_NO_TAG("Write large records", write_large_records),
+                         TEST_NO_TAG("Records dropped when writer is late", records_dropped_when_writer_is_late),
+                         TEST_NO_TAG("File invalid when records are not written",
+                                     file_invalid_when_records_are_not_written)};
 
 test_suite_t smff_test_suite = {"Simple Multimedia File Format",  NULL,  NULL, NULL, NULL,
                                 sizeof(tests) / sizeof(tests[0]), tests, 0};
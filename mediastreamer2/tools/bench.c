@@ -18,17 +18,113 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+/*
+ * Headless load generator: runs N audio and M video calls over the loopback interface in a single process. Each call
+ * is made of two media streams (caller and callee) sending to each other. At the end of the run, a JSON report gives
+ * the throughput, the latency, the jitter buffer and ticker statistics of every stream, the CPU time spent in each
+ * filter type and the allocation rate, so that scaling regressions can be spotted by comparing two reports.
+ */
+
 #include <bctoolbox/defs.h>
+#include <bctoolbox/port.h>
 
+#include "mediastreamer2/mediastream.h"
+#include "mediastreamer2/msfactory.h"
+#include "mediastreamer2/msfileplayer.h"
 #include "mediastreamer2/msticker.h"
+#include "mediastreamer2/mswebcam.h"
 
-#include "mediastreamer2/msfileplayer.h"
-#include "mediastreamer2/msfilerec.h"
-#include "mediastreamer2/msrtp.h"
+#include "common.h"
 
 #include <signal.h>
 
-#define MAX_RTP_SIZE 1500
+#define BENCH_AUDIO_PAYLOAD_TYPE 96
+#define BENCH_VIDEO_PAYLOAD_TYPE 97
+#define BENCH_FEC_PAYLOAD_TYPE 98
+#define BENCH_ITERATE_INTERVAL_MS 50
+
+static const char *usage =
+    "mediastreamer2-bench\n"
+    "[ --help (display this help) ]\n"
+    "[ --audio <number of audio calls, each one needs --audio-file> (default 0) ]\n"
+    "[ --video <number of video calls> (default 0) ]\n"
+    "[ --audio-payload <payload name like 'audio/pcmu/8000'> (default audio/pcmu/8000) ]\n"
+    "[ --video-payload <payload name like 'video/vp8/90000'> (default video/vp8/90000) ]\n"
+    "[ --audio-file <wav file played in loop by every audio stream> ]\n"
+    "[ --camera <camera id> (default is the synthetic Mire camera) ]\n"
+    "[ --duration <seconds> (default 30) ]\n"
+    "[ --jitter <milliseconds> (jitter buffer size, default 60) ]\n"
+    "[ --srtp <suite> (AES_CM_128_HMAC_SHA1_80, AES_CM_128_HMAC_SHA1_32, AES_256_CM_HMAC_SHA1_80, AEAD_AES_128_GCM, "
+    "AEAD_AES_256_GCM) ]\n"
+    "[ --bundle (audio and video of a call share the same transport) ]\n"
+    "[ --fec (enable flexfec on video streams) ]\n"
+    "[ --nack (enable generic NACK and retransmissions on video streams) ]\n"
+    "[ --netsim-profile <none|lossy|jittery|mobile> ]\n"
+    "[ --netsim-bandwidth <bandwidth limit in bits/s> ]\n"
+    "[ --netsim-jitter-burst-density <0-10> ]\n"
+    "[ --netsim-jitter-strength <0-100> ]\n"
+    "[ --netsim-latency <latency in ms> ]\n"
+    "[ --netsim-lossrate <0-100> ]\n"
+    "[ --output <file> (JSON report, default is the standard output) ]\n"
+    "[ --verbose ]\n";
+
+typedef struct _BenchSrtpSuite {
+	const char *name;
+	MSCryptoSuite suite;
+	const char *caller_key;
+	const char *callee_key;
+} BenchSrtpSuite;
+
+static const BenchSrtpSuite bench_srtp_suites[] = {
+    {"AES_CM_128_HMAC_SHA1_80", MS_AES_128_SHA1_80, "JKUX/Z3WvRduXUFlQBg7R1cnmjxxA6Qmd3Wvm787",
+     "ztN0HAUTV7cZku51fn//rXwhSX1wOVqFSuPO/3xl"},
+    {"AES_CM_128_HMAC_SHA1_32", MS_AES_128_SHA1_32, "JKUX/Z3WvRduXUFlQBg7R1cnmjxxA6Qmd3Wvm787",
+     "ztN0HAUTV7cZku51fn//rXwhSX1wOVqFSuPO/3xl"},
+    {"AES_256_CM_HMAC_SHA1_80", MS_AES_256_SHA1_80, "93amcMzSk2GYCM1ZQzagR5b5OZKzhaOykcpKMcsTmP9rqpCtiKq7vod7mXw0wg==",
+     "ZoUg2M5UASJd5A7D5s/I1HjPfRKJukE6DPTfxyoqlEec3uIf2qblvh9YeidL9w=="},
+    {"AEAD_AES_128_GCM", MS_AEAD_AES_128_GCM, "av/yCHbZrC43jpsK090r3A87onwOkTN6E6mXNw==",
+     "JnTymAs4pGjuZLQbE7HV3W5g2rZH3vGK2b0SOQ=="},
+    {"AEAD_AES_256_GCM", MS_AEAD_AES_256_GCM, "gOs+WArpVmpQgDGYk2iOMuKTKhuo29wwv/DbY9Ds2Z80M6eNFdO+ioyd79s=",
+     "MZE0MUBErnwoJCe2PNBPXGhPSQtiZxZl6ihGuXm1waRRZWQiRjU6bhh6xDQ="},
+    {NULL, MS_CRYPTO_SUITE_INVALID, NULL, NULL}};
+
+typedef struct _BenchConfig {
+	int nb_audio;
+	int nb_video;
+	const char *audio_payload;
+	const char *video_payload;
+	const char *audio_file;
+	const char *camera;
+	int duration;
+	int jitter;
+	const BenchSrtpSuite *srtp;
+	bool_t bundle;
+	bool_t fec;
+	bool_t nack;
+	bool_t verbose;
+	OrtpNetworkSimulatorParams netsim;
+	const char *netsim_profile;
+	const char *output;
+} BenchConfig;
+
+/* One side of a call, and what was sampled from its ticker during the run. */
+typedef struct _BenchStream {
+	MediaStream *ms;
+	int call;
+	const char *side;
+	uint64_t last_late_event_time;
+	int late_events;
+	int max_late_ms;
+	double load_sum;
+	float max_load;
+	int load_samples;
+} BenchStream;
+
+typedef struct _BenchCall {
+	AudioStream *audio[2];
+	VideoStream *video[2];
+	RtpBundle *bundle[2];
+} BenchCall;
 
 static int run = 1;
 
@@ -36,310 +132,514 @@ static void stop(BCTBX_UNUSED(int signum)) {
 	run = 0;
 }
 
-struct test_session {
-	RtpSession *rtps;
-
-	MSFilter *fplayer;
-	MSFilter *encoder;
-	MSFilter *rtpsend;
-
-	MSFilter *rtprecv;
-	MSFilter *decoder;
-	MSFilter *frecorder;
-};
-
-struct bench_config {
-	int num_session;
-	int num_session_record;
-
-	int port_origin;
-	char *ip_destination;
-	int port_destination;
-
-	int payload;
-	int rate;
-	int ptime;
-	char *wavfile;
+#if defined(__GNUC__)
+#define BENCH_COUNT_ALLOCATIONS 1
+/* Everything allocated through bctoolbox (mblk_t, filters data, oRTP and mediastreamer2 objects) is counted. */
+static uint64_t allocation_count = 0;
+static uint64_t allocation_bytes = 0;
 
-	MSFactory *factory;
-	MSTicker *ticker;
-	bctbx_list_t *tsessions; /* list of struct test_session */
-};
-
-#define NUM_SESSION 50 /* num of session to start per block */
-#define NUM_SESSION_RECORD 1
-
-struct bench_config cfg[] = {
-    {NUM_SESSION, NUM_SESSION_RECORD, 8000, "127.0.0.1", 9000, 8, 8000, 20, "test1.wav", NULL, NULL, NULL},
-
-    {NUM_SESSION, NUM_SESSION_RECORD, 9000, "127.0.0.1", 8000, 8, 8000, 20, "test1.wav", NULL, NULL, NULL},
-
-    {NUM_SESSION, NUM_SESSION_RECORD, 10000, "127.0.0.1", 11000, 8, 8000, 20, "test1.wav", NULL, NULL, NULL},
-
-    {NUM_SESSION, NUM_SESSION_RECORD, 11000, "127.0.0.1", 10000, 8, 8000, 20, "test1.wav", NULL, NULL, NULL},
-
-    {0, 0, 0, "", 0, 0, 0, 0, NULL, NULL, NULL, NULL},
-};
+static void *bench_malloc(size_t sz) {
+	__atomic_fetch_add(&allocation_count, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&allocation_bytes, (uint64_t)sz, __ATOMIC_RELAXED);
+	return malloc(sz);
+}
 
-static void
-_rtp_session_resync_cb(RtpSession *s, BCTBX_UNUSED(void *arg1), BCTBX_UNUSED(void *arg2), BCTBX_UNUSED(void *arg3)) {
-	rtp_session_resync(s);
+static void *bench_realloc(void *ptr, size_t sz) {
+	__atomic_fetch_add(&allocation_count, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&allocation_bytes, (uint64_t)sz, __ATOMIC_RELAXED);
+	return realloc(ptr, sz);
 }
 
-static RtpSession *create_duplex_rtpsession(int locport) {
-	RtpSession *rtpr;
-	rtpr = rtp_session_new(RTP_SESSION_SENDRECV);
-	rtp_session_set_recv_buf_size(rtpr, MAX_RTP_SIZE);
-	rtp_session_set_scheduling_mode(rtpr, 0);
-	rtp_session_set_blocking_mode(rtpr, 0);
-	rtp_session_enable_adaptive_jitter_compensation(rtpr, FALSE);
-	rtp_session_set_symmetric_rtp(rtpr, TRUE);
-	rtp_session_set_local_addr(rtpr, "0.0.0.0", locport, locport + 1);
-	rtp_session_signal_connect(rtpr, "timestamp_jump", _rtp_session_resync_cb, NULL);
-	rtp_session_signal_connect(rtpr, "ssrc_changed", _rtp_session_resync_cb, NULL);
-	return rtpr;
+static void bench_free(void *ptr) {
+	free(ptr);
+}
+#endif
+
+static bool_t parse_netsim_profile(const char *name, OrtpNetworkSimulatorParams *params) {
+	if (strcmp(name, "none") == 0) {
+		params->enabled = FALSE;
+	} else if (strcmp(name, "lossy") == 0) {
+		params->enabled = TRUE;
+		params->loss_rate = 5;
+		params->consecutive_loss_probability = 0.3f;
+	} else if (strcmp(name, "jittery") == 0) {
+		params->enabled = TRUE;
+		params->max_bandwidth = 2000000;
+		params->jitter_burst_density = 1;
+		params->jitter_strength = 30;
+	} else if (strcmp(name, "mobile") == 0) {
+		params->enabled = TRUE;
+		params->max_bandwidth = 1500000;
+		params->loss_rate = 2;
+		params->latency = 80;
+		params->jitter_burst_density = 0.5f;
+		params->jitter_strength = 20;
+	} else {
+		return FALSE;
+	}
+	return TRUE;
 }
 
-static int init_bench(struct bench_config *bench) {
-	PayloadType *pt;
-	int pos;
-	int val;
-	int count;
-
-	bench->factory = ms_factory_new_with_voip();
-	bench->ticker = ms_ticker_new();
-
-	count = 0;
-	/* creates the couple of encoder/decoder */
-	pt = rtp_profile_get_payload(&av_profile, bench->payload);
-	if (pt == NULL) {
-		ms_error("audiostream.c: undefined payload type.");
-		return count;
+static bool_t parse_args(int argc, char *argv[], BenchConfig *cfg) {
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+			return FALSE;
+		} else if (strcmp(arg, "--bundle") == 0) {
+			cfg->bundle = TRUE;
+		} else if (strcmp(arg, "--fec") == 0) {
+			cfg->fec = TRUE;
+		} else if (strcmp(arg, "--nack") == 0) {
+			cfg->nack = TRUE;
+		} else if (strcmp(arg, "--verbose") == 0) {
+			cfg->verbose = TRUE;
+		} else if (i + 1 >= argc) {
+			ms_error("Missing value for option '%s'", arg);
+			return FALSE;
+		} else if (strcmp(arg, "--audio") == 0) {
+			cfg->nb_audio = atoi(argv[++i]);
+		} else if (strcmp(arg, "--video") == 0) {
+			cfg->nb_video = atoi(argv[++i]);
+		} else if (strcmp(arg, "--audio-payload") == 0) {
+			cfg->audio_payload = argv[++i];
+		} else if (strcmp(arg, "--video-payload") == 0) {
+			cfg->video_payload = argv[++i];
+		} else if (strcmp(arg, "--audio-file") == 0) {
+			cfg->audio_file = argv[++i];
+		} else if (strcmp(arg, "--camera") == 0) {
+			cfg->camera = argv[++i];
+		} else if (strcmp(arg, "--duration") == 0) {
+			cfg->duration = atoi(argv[++i]);
+		} else if (strcmp(arg, "--jitter") == 0) {
+			cfg->jitter = atoi(argv[++i]);
+		} else if (strcmp(arg, "--srtp") == 0) {
+			const BenchSrtpSuite *suite;
+			i++;
+			for (suite = bench_srtp_suites; suite->name != NULL; suite++) {
+				if (strcasecmp(suite->name, argv[i]) == 0) break;
+			}
+			if (suite->name == NULL) {
+				ms_error("Unknown SRTP suite '%s'", argv[i]);
+				return FALSE;
+			}
+			cfg->srtp = suite;
+		} else if (strcmp(arg, "--netsim-profile") == 0) {
+			cfg->netsim_profile = argv[++i];
+			if (!parse_netsim_profile(cfg->netsim_profile, &cfg->netsim)) {
+				ms_error("Unknown network simulator profile '%s'", cfg->netsim_profile);
+				return FALSE;
+			}
+		} else if (strcmp(arg, "--netsim-bandwidth") == 0) {
+			cfg->netsim.max_bandwidth = (float)atof(argv[++i]);
+			cfg->netsim.enabled = TRUE;
+		} else if (strcmp(arg, "--netsim-jitter-burst-density") == 0) {
+			cfg->netsim.jitter_burst_density = (float)atof(argv[++i]);
+			cfg->netsim.enabled = TRUE;
+		} else if (strcmp(arg, "--netsim-jitter-strength") == 0) {
+			cfg->netsim.jitter_strength = (float)atof(argv[++i]);
+			cfg->netsim.enabled = TRUE;
+		} else if (strcmp(arg, "--netsim-latency") == 0) {
+			cfg->netsim.latency = (uint32_t)atoi(argv[++i]);
+			cfg->netsim.enabled = TRUE;
+		} else if (strcmp(arg, "--netsim-lossrate") == 0) {
+			cfg->netsim.loss_rate = (float)atof(argv[++i]);
+			cfg->netsim.enabled = TRUE;
+		} else if (strcmp(arg, "--output") == 0) {
+			cfg->output = argv[++i];
+		} else {
+			ms_error("Unknown option '%s'", arg);
+			return FALSE;
+		}
 	}
-	if (pt->clock_rate != 8000 && pt->clock_rate != 16000 && pt->clock_rate != 32000) {
-		ms_error("audiostream.c: wrong rate.");
-		return count;
+	if (cfg->nb_audio < 0 || cfg->nb_video < 0 || cfg->nb_audio + cfg->nb_video == 0 || cfg->duration <= 0) {
+		ms_error("Nothing to run, set a number of --audio and/or --video calls");
+		return FALSE;
 	}
-	for (pos = 0; pos < bench->num_session; pos++) {
-		struct test_session *ts = (struct test_session *)ortp_malloc(sizeof(struct test_session));
-		memset(ts, 0, sizeof(struct test_session));
-
-		ts->rtps = create_duplex_rtpsession(bench->port_origin + pos * 2);
-		if (ts->rtps == NULL) {
-			ms_error("bench.c: cannot create rtp_session!");
-			ortp_free(ts);
-			return count;
-		}
+	if (cfg->nb_audio > 0 && cfg->audio_file == NULL) {
+		ms_error("Audio calls need an --audio-file to play");
+		return FALSE;
+	}
+	return TRUE;
+}
 
-		rtp_session_set_payload_type(ts->rtps, bench->payload);
-		rtp_session_set_remote_addr_full(ts->rtps, bench->ip_destination, bench->port_destination + pos * 2,
-		                                 bench->ip_destination, bench->port_destination + 1 + pos * 2);
-
-		ts->fplayer = ms_factory_create_filter(bench->factory, MS_FILE_PLAYER_ID);
-		if (strstr(bench->wavfile, ".au") == NULL)
-			ts->encoder = ms_factory_create_encoder(bench->factory, pt->mime_type);
-		ts->rtpsend = ms_factory_create_filter(bench->factory, MS_RTP_SEND_ID);
-
-		ts->rtprecv = ms_factory_create_filter(bench->factory, MS_RTP_RECV_ID);
-		ts->decoder = ms_factory_create_decoder(bench->factory, pt->mime_type);
-		ts->frecorder = ms_factory_create_filter(bench->factory, MS_FILE_REC_ID);
-
-		if ((ts->encoder == NULL && strstr(bench->wavfile, ".au") == NULL) || (ts->decoder == NULL)) {
-			ms_error("bench.c: No decoder available for payload %i.", bench->payload);
-			if (ts->fplayer) ms_filter_destroy(ts->fplayer);
-			if (ts->encoder) ms_filter_destroy(ts->encoder);
-			if (ts->rtpsend) ms_filter_destroy(ts->rtpsend);
-			if (ts->rtprecv) ms_filter_destroy(ts->rtprecv);
-			if (ts->decoder) ms_filter_destroy(ts->decoder);
-			if (ts->frecorder) ms_filter_destroy(ts->frecorder);
-			ortp_free(ts);
-			return count;
-		}
-		if (ts->fplayer == NULL) {
-			ms_error("bench.c: missing player filter.");
-			if (ts->fplayer) ms_filter_destroy(ts->fplayer);
-			if (ts->encoder) ms_filter_destroy(ts->encoder);
-			if (ts->rtpsend) ms_filter_destroy(ts->rtpsend);
-			if (ts->rtprecv) ms_filter_destroy(ts->rtprecv);
-			if (ts->decoder) ms_filter_destroy(ts->decoder);
-			if (ts->frecorder) ms_filter_destroy(ts->frecorder);
-			ortp_free(ts);
-			return count;
-		}
-		if (ts->frecorder == NULL) {
-			ms_error("bench.c: missing recorder filter.");
-			if (ts->fplayer) ms_filter_destroy(ts->fplayer);
-			if (ts->encoder) ms_filter_destroy(ts->encoder);
-			if (ts->rtpsend) ms_filter_destroy(ts->rtpsend);
-			if (ts->rtprecv) ms_filter_destroy(ts->rtprecv);
-			if (ts->decoder) ms_filter_destroy(ts->decoder);
-			if (ts->frecorder) ms_filter_destroy(ts->frecorder);
-			ortp_free(ts);
-			return count;
-		}
-		if (ts->rtpsend == NULL) {
-			ms_error("bench.c: missing rtpsend filter.");
-			if (ts->fplayer) ms_filter_destroy(ts->fplayer);
-			if (ts->encoder) ms_filter_destroy(ts->encoder);
-			if (ts->rtpsend) ms_filter_destroy(ts->rtpsend);
-			if (ts->rtprecv) ms_filter_destroy(ts->rtprecv);
-			if (ts->decoder) ms_filter_destroy(ts->decoder);
-			if (ts->frecorder) ms_filter_destroy(ts->frecorder);
-			ortp_free(ts);
-			return count;
-		}
-		if (ts->rtprecv == NULL) {
-			ms_error("bench.c: missing rtprecv filter.");
-			if (ts->fplayer) ms_filter_destroy(ts->fplayer);
-			if (ts->encoder) ms_filter_destroy(ts->encoder);
-			if (ts->rtpsend) ms_filter_destroy(ts->rtpsend);
-			if (ts->rtprecv) ms_filter_destroy(ts->rtprecv);
-			if (ts->decoder) ms_filter_destroy(ts->decoder);
-			if (ts->frecorder) ms_filter_destroy(ts->frecorder);
-			ortp_free(ts);
-			return count;
-		}
+static RtpProfile *create_profile(const BenchConfig *cfg) {
+	RtpProfile *profile = rtp_profile_new("Bench profile");
 
-		ms_filter_call_method(ts->rtpsend, MS_RTP_SEND_SET_SESSION, ts->rtps);
-		ms_filter_call_method(ts->rtprecv, MS_RTP_RECV_SET_SESSION, ts->rtps);
+	if (cfg->nb_audio > 0) {
+		rtp_profile_set_payload(profile, BENCH_AUDIO_PAYLOAD_TYPE, ms_tools_parse_custom_payload(cfg->audio_payload));
+	}
+	if (cfg->nb_video > 0) {
+		PayloadType *pt = ms_tools_parse_custom_payload(cfg->video_payload);
+		if (cfg->nack) payload_type_set_flag(pt, PAYLOAD_TYPE_RTCP_FEEDBACK_ENABLED);
+		rtp_profile_set_payload(profile, BENCH_VIDEO_PAYLOAD_TYPE, pt);
+		if (cfg->fec) rtp_profile_set_payload(profile, BENCH_FEC_PAYLOAD_TYPE, payload_type_clone(&payload_type_flexfec));
+	}
+	return profile;
+}
 
-		ms_filter_call_method(ts->rtprecv, MS_FILTER_SET_SAMPLE_RATE, &pt->clock_rate);
+static MSWebCam *get_camera(MSFactory *factory, const BenchConfig *cfg) {
+	MSWebCamManager *manager = ms_factory_get_web_cam_manager(factory);
+	MSWebCam *cam;
 
-		ms_filter_call_method(ts->frecorder, MS_FILTER_SET_SAMPLE_RATE, &pt->clock_rate);
+	if (cfg->camera != NULL) return ms_web_cam_manager_get_cam(manager, cfg->camera);
+	/* Use the synthetic moving picture so that the encoders have something realistic to compress. */
+	cam = ms_web_cam_manager_get_cam(manager, "Mire: Mire (synthetic moving picture)");
+	if (cam == NULL) {
+		cam = ms_web_cam_new(ms_mire_webcam_desc_get());
+		ms_web_cam_manager_add_cam(manager, cam);
+	}
+	return cam;
+}
 
-		val = ms_filter_call_method(ts->fplayer, MS_FILE_PLAYER_OPEN, (void *)bench->wavfile);
-		if (val != 0) {
-			ms_error("bench.c: Cannot open wav file (%s)", bench->wavfile);
-			if (ts->fplayer) ms_filter_destroy(ts->fplayer);
-			if (ts->encoder) ms_filter_destroy(ts->encoder);
-			if (ts->rtpsend) ms_filter_destroy(ts->rtpsend);
-			if (ts->rtprecv) ms_filter_destroy(ts->rtprecv);
-			if (ts->decoder) ms_filter_destroy(ts->decoder);
-			if (ts->frecorder) ms_filter_destroy(ts->frecorder);
-			ortp_free(ts);
-			return count;
-		}
+static void configure_stream(MediaStream *ms, const BenchConfig *cfg, bool_t caller) {
+	if (cfg->netsim.enabled) rtp_session_enable_network_simulation(ms->sessions.rtp_session, &cfg->netsim);
+	if (cfg->srtp) {
+		const char *send_key = caller ? cfg->srtp->caller_key : cfg->srtp->callee_key;
+		const char *recv_key = caller ? cfg->srtp->callee_key : cfg->srtp->caller_key;
+		ms_media_stream_sessions_set_srtp_send_key_b64(&ms->sessions, cfg->srtp->suite, send_key, MSSrtpKeySourceSDES);
+		ms_media_stream_sessions_set_srtp_recv_key_b64(&ms->sessions, cfg->srtp->suite, recv_key, MSSrtpKeySourceSDES);
+		ms_media_stream_sessions_set_encryption_mandatory(&ms->sessions, TRUE);
+	}
+}
 
-		val = 0;
-		ms_filter_call_method(ts->fplayer, MS_FILTER_GET_SAMPLE_RATE, &val);
-		if (val != pt->clock_rate) {
-			ms_error("bench.c: unsupported rate for wav file: codec=%i / file=%i", pt->clock_rate, val);
-			if (ts->fplayer) ms_filter_destroy(ts->fplayer);
-			if (ts->encoder) ms_filter_destroy(ts->encoder);
-			if (ts->rtpsend) ms_filter_destroy(ts->rtpsend);
-			if (ts->rtprecv) ms_filter_destroy(ts->rtprecv);
-			if (ts->decoder) ms_filter_destroy(ts->decoder);
-			if (ts->frecorder) ms_filter_destroy(ts->frecorder);
-			ortp_free(ts);
-			return count;
+static RtpBundle *bundle_for(BenchCall *call, int side, RtpSession *session) {
+	/* Bundled sessions multiplex RTCP on the RTP transport. */
+	rtp_session_enable_rtcp_mux(session, TRUE);
+	if (call->bundle[side] == NULL) {
+		call->bundle[side] = rtp_bundle_new();
+		rtp_bundle_set_mid_extension_id(call->bundle[side], RTP_EXTENSION_MID);
+	}
+	return call->bundle[side];
+}
+
+static bool_t start_call(
+    MSFactory *factory, RtpProfile *profile, MSWebCam *cam, const BenchConfig *cfg, BenchCall *call, int index) {
+	int side;
+
+	if (index < cfg->nb_audio) {
+		for (side = 0; side < 2; side++) {
+			call->audio[side] = audio_stream_new2(factory, "127.0.0.1", -1, -1);
+			configure_stream(&call->audio[side]->ms, cfg, side == 0);
+			if (cfg->bundle) {
+				RtpBundle *bundle = bundle_for(call, side, call->audio[side]->ms.sessions.rtp_session);
+				rtp_bundle_add_session(bundle, "as", call->audio[side]->ms.sessions.rtp_session);
+				rtp_bundle_set_primary_session(bundle, call->audio[side]->ms.sessions.rtp_session);
+			}
 		}
-		ms_filter_call_method(ts->fplayer, MS_FILTER_GET_NCHANNELS, &val);
-
-		if (val != 1) {
-			ms_error("bench.c: unsupported number of channel for wav file: codec=1 / file=%i", val);
-			if (ts->fplayer) ms_filter_destroy(ts->fplayer);
-			if (ts->encoder) ms_filter_destroy(ts->encoder);
-			if (ts->rtpsend) ms_filter_destroy(ts->rtpsend);
-			if (ts->rtprecv) ms_filter_destroy(ts->rtprecv);
-			if (ts->decoder) ms_filter_destroy(ts->decoder);
-			if (ts->frecorder) ms_filter_destroy(ts->frecorder);
-			ortp_free(ts);
-			return count;
+		for (side = 0; side < 2; side++) {
+			AudioStream *remote = call->audio[1 - side];
+			if (audio_stream_start_full(call->audio[side], profile, "127.0.0.1",
+			                            rtp_session_get_local_port(remote->ms.sessions.rtp_session), "127.0.0.1",
+			                            rtp_session_get_local_rtcp_port(remote->ms.sessions.rtp_session),
+			                            BENCH_AUDIO_PAYLOAD_TYPE, cfg->jitter, cfg->audio_file, NULL, NULL, NULL,
+			                            FALSE) != 0) {
+				ms_error("Could not start audio stream of call %d", index);
+				return FALSE;
+			}
+			if (call->audio[side]->soundread != NULL) {
+				int loop_interval = 0;
+				ms_filter_call_method(call->audio[side]->soundread, MS_FILE_PLAYER_LOOP, &loop_interval);
+			}
 		}
-		ms_filter_call_method_noarg(ts->fplayer, MS_FILE_PLAYER_START);
-
-		if (strstr(bench->wavfile, ".au") == NULL) {
-			ms_filter_link(ts->fplayer, 0, ts->encoder, 0);
-			ms_filter_link(ts->encoder, 0, ts->rtpsend, 0);
-		} else {
-			ms_filter_link(ts->fplayer, 0, ts->rtpsend, 0);
+	}
+	if (index < cfg->nb_video) {
+		for (side = 0; side < 2; side++) {
+			call->video[side] = video_stream_new2(factory, "127.0.0.1", -1, -1);
+			video_stream_set_display_filter_name(call->video[side], "MSExtDisplay");
+			video_stream_set_fallback_to_dummy_codec(call->video[side], TRUE);
+			configure_stream(&call->video[side]->ms, cfg, side == 0);
+			if (cfg->nack) {
+				RtpSession *session = call->video[side]->ms.sessions.rtp_session;
+				rtp_session_enable_avpf_feature(session, ORTP_AVPF_FEATURE_GENERIC_NACK, TRUE);
+				rtp_session_enable_avpf_feature(session, ORTP_AVPF_FEATURE_IMMEDIATE_NACK, TRUE);
+				video_stream_enable_retransmission_on_nack(call->video[side], TRUE);
+			}
+			/* Flexfec needs the video session to be part of a bundle, even when audio is not bundled. */
+			if (cfg->bundle || cfg->fec) {
+				RtpBundle *bundle = bundle_for(call, side, call->video[side]->ms.sessions.rtp_session);
+				rtp_bundle_add_session(bundle, "vs", call->video[side]->ms.sessions.rtp_session);
+				if (call->audio[side] == NULL || !cfg->bundle) {
+					rtp_bundle_set_primary_session(bundle, call->video[side]->ms.sessions.rtp_session);
+				}
+			}
 		}
-
-		ms_filter_link(ts->rtprecv, 0, ts->decoder, 0);
-		ms_filter_link(ts->decoder, 0, ts->frecorder, 0);
-
-		ms_ticker_attach(bench->ticker, ts->fplayer);
-		ms_ticker_attach(bench->ticker, ts->rtprecv);
-
-		if (pos < bench->num_session_record) {
-			char rec_file[128];
-			snprintf(rec_file, sizeof(rec_file), "rec_%s_%i.wav", bench->ip_destination,
-			         bench->port_destination + pos * 2);
-			ms_filter_call_method(ts->frecorder, MS_FILE_REC_OPEN, (void *)rec_file);
-			ms_filter_call_method_noarg(ts->frecorder, MS_FILE_REC_START);
+		for (side = 0; side < 2; side++) {
+			/* A bundled video stream shares the transport of the remote audio stream. */
+			RtpSession *remote = (cfg->bundle && call->audio[1 - side] != NULL)
+			                         ? call->audio[1 - side]->ms.sessions.rtp_session
+			                         : call->video[1 - side]->ms.sessions.rtp_session;
+			if (video_stream_start(call->video[side], profile, "127.0.0.1", rtp_session_get_local_port(remote),
+			                       "127.0.0.1", rtp_session_get_local_rtcp_port(remote), BENCH_VIDEO_PAYLOAD_TYPE,
+			                       cfg->jitter, cam) != 0) {
+				ms_error("Could not start video stream of call %d", index);
+				return FALSE;
+			}
+			if (cfg->fec) fec_params_update(call->video[side]->ms.fec_parameters, 4);
 		}
-
-		bench->tsessions = bctbx_list_append(bench->tsessions, (void *)ts);
-		count++;
 	}
-
-	return count;
+	return TRUE;
 }
 
-static int uninit_bench(struct bench_config *bench) {
-	bctbx_list_t *it;
-	for (it = bench->tsessions; it != NULL; it = bench->tsessions) {
-		struct test_session *ts = (struct test_session *)it->data;
-		bench->tsessions = bctbx_list_erase_link(bench->tsessions, it);
+static void stop_call(BenchCall *call) {
+	int side;
 
-		ms_ticker_detach(bench->ticker, ts->fplayer);
-		ms_ticker_detach(bench->ticker, ts->rtprecv);
-
-		ms_filter_call_method_noarg(ts->frecorder, MS_FILE_REC_CLOSE);
+	/* The video session goes first as it may use the transport of the audio one through the bundle. */
+	for (side = 0; side < 2; side++) {
+		if (call->video[side]) video_stream_stop(call->video[side]);
+		if (call->audio[side]) audio_stream_stop(call->audio[side]);
+		if (call->bundle[side]) rtp_bundle_delete(call->bundle[side]);
+	}
+}
 
-		if (strstr(bench->wavfile, ".au") == NULL) {
-			ms_filter_unlink(ts->fplayer, 0, ts->encoder, 0);
-			ms_filter_unlink(ts->encoder, 0, ts->rtpsend, 0);
-		} else {
-			ms_filter_unlink(ts->fplayer, 0, ts->rtpsend, 0);
-		}
+static void sample_stream(BenchStream *stream) {
+	MSTicker *ticker = stream->ms->sessions.ticker;
+	MSTickerLateEvent ev;
+	float load;
+
+	if (ticker == NULL) return;
+	load = ms_ticker_get_average_load(ticker);
+	stream->load_sum += load;
+	stream->load_samples++;
+	if (load > stream->max_load) stream->max_load = load;
+	ms_ticker_get_last_late_tick(ticker, &ev);
+	if (ev.time != 0 && ev.time != stream->last_late_event_time) {
+		stream->last_late_event_time = ev.time;
+		stream->late_events++;
+		if (ev.lateMs > stream->max_late_ms) stream->max_late_ms = ev.lateMs;
+	}
+}
 
-		ms_filter_unlink(ts->rtprecv, 0, ts->decoder, 0);
-		ms_filter_unlink(ts->decoder, 0, ts->frecorder, 0);
+static void add_stream(BenchStream *streams, int *nb_streams, MediaStream *ms, int call, const char *side) {
+	BenchStream *stream;
 
-		if (ts->fplayer) ms_filter_destroy(ts->fplayer);
-		if (ts->encoder) ms_filter_destroy(ts->encoder);
-		if (ts->rtpsend) ms_filter_destroy(ts->rtpsend);
+	if (ms == NULL) return;
+	stream = &streams[(*nb_streams)++];
+	memset(stream, 0, sizeof(*stream));
+	stream->ms = ms;
+	stream->call = call;
+	stream->side = side;
+}
 
-		if (ts->rtprecv) ms_filter_destroy(ts->rtprecv);
-		if (ts->decoder) ms_filter_destroy(ts->decoder);
-		if (ts->frecorder) ms_filter_destroy(ts->frecorder);
+static void print_stream_report(FILE *out, const BenchStream *stream, RtpProfile *profile, bool_t last) {
+	RtpSession *session = stream->ms->sessions.rtp_session;
+	const rtp_stats_t *stats = rtp_session_get_stats(session);
+	const jitter_stats_t *jitter = rtp_session_get_jitter_stats(session);
+	PayloadType *pt = rtp_profile_get_payload(profile, rtp_session_get_recv_payload_type(session));
+	int clock_rate = pt ? pt->clock_rate : 0;
+	MSSrtpCryptoStats crypto;
+
+	memset(&crypto, 0, sizeof(crypto));
+	ms_media_stream_sessions_get_srtp_crypto_stats(&stream->ms->sessions, MediaStreamSendRecv, &crypto);
+	fprintf(out, "\t\t{\n");
+	fprintf(out, "\t\t\t\"call\": %d,\n", stream->call);
+	fprintf(out, "\t\t\t\"type\": \"%s\",\n", ms_format_type_to_string(stream->ms->type));
+	fprintf(out, "\t\t\t\"side\": \"%s\",\n", stream->side);
+	fprintf(out, "\t\t\t\"ticker_load_mean\": %.2f,\n",
+	        stream->load_samples ? stream->load_sum / stream->load_samples : 0.0);
+	fprintf(out, "\t\t\t\"ticker_load_max\": %.2f,\n", stream->max_load);
+	fprintf(out, "\t\t\t\"ticker_late_events\": %d,\n", stream->late_events);
+	fprintf(out, "\t\t\t\"ticker_max_late_ms\": %d,\n", stream->max_late_ms);
+	fprintf(out, "\t\t\t\"packets_sent\": %llu,\n", (unsigned long long)stats->packet_sent);
+	fprintf(out, "\t\t\t\"packets_received\": %llu,\n", (unsigned long long)stats->packet_recv);
+	fprintf(out, "\t\t\t\"bytes_sent\": %llu,\n", (unsigned long long)stats->sent);
+	fprintf(out, "\t\t\t\"bytes_received\": %llu,\n", (unsigned long long)stats->recv);
+	fprintf(out, "\t\t\t\"packets_lost\": %lld,\n", (long long)stats->cum_packet_loss);
+	fprintf(out, "\t\t\t\"packets_late\": %llu,\n", (unsigned long long)stats->outoftime);
+	fprintf(out, "\t\t\t\"packets_discarded\": %llu,\n", (unsigned long long)stats->discarded);
+	fprintf(out, "\t\t\t\"packets_duplicated\": %llu,\n", (unsigned long long)stats->packet_dup_recv);
+	fprintf(out, "\t\t\t\"upload_kbps\": %.1f,\n", media_stream_get_up_bw(stream->ms) / 1000.0f);
+	fprintf(out, "\t\t\t\"download_kbps\": %.1f,\n", media_stream_get_down_bw(stream->ms) / 1000.0f);
+	fprintf(out, "\t\t\t\"round_trip_ms\": %.3f,\n", rtp_session_get_round_trip_propagation(session) * 1000.0f);
+	fprintf(out, "\t\t\t\"jitter_ms\": %.2f,\n", clock_rate ? jitter->jitter * 1000.0 / clock_rate : 0.0);
+	fprintf(out, "\t\t\t\"max_jitter_ms\": %.2f,\n", clock_rate ? jitter->max_jitter * 1000.0 / clock_rate : 0.0);
+	fprintf(out, "\t\t\t\"jitter_buffer_size_ms\": %.1f,\n", jitter->jitter_buffer_size_ms);
+	fprintf(out, "\t\t\t\"srtp_packets\": %llu,\n", (unsigned long long)crypto.packets);
+	fprintf(out, "\t\t\t\"srtp_bytes\": %llu,\n", (unsigned long long)crypto.bytes);
+	fprintf(out, "\t\t\t\"srtp_crypto_time_us\": %llu\n", (unsigned long long)crypto.crypto_time_us);
+	fprintf(out, "\t\t}%s\n", last ? "" : ",");
+}
 
-		ortp_free(ts);
+static void print_filters_report(FILE *out, MSFactory *factory, double duration_s) {
+	const bctbx_list_t *elem;
+
+	fprintf(out, "\t\"filters\": [\n");
+	for (elem = ms_factory_get_statistics(factory); elem != NULL; elem = elem->next) {
+		const MSFilterStats *stats = (const MSFilterStats *)elem->data;
+		const MSUBoxPlot *bp = &stats->bp_elapsed;
+		fprintf(out, "\t\t{\n");
+		fprintf(out, "\t\t\t\"name\": \"%s\",\n", stats->name);
+		fprintf(out, "\t\t\t\"instances\": %d,\n", stats->nb_creations);
+		fprintf(out, "\t\t\t\"process_calls\": %llu,\n", (unsigned long long)bp->count);
+		fprintf(out, "\t\t\t\"cpu_time_ms\": %.3f,\n", bp->sum / 1e6);
+		fprintf(out, "\t\t\t\"cpu_usage_percent\": %.3f,\n", duration_s > 0 ? bp->sum / 1e7 / duration_s : 0.0);
+		fprintf(out, "\t\t\t\"process_mean_us\": %.3f,\n", bp->mean / 1e3);
+		fprintf(out, "\t\t\t\"process_max_us\": %.3f\n", bp->max / 1e3);
+		fprintf(out, "\t\t}%s\n", elem->next ? "," : "");
 	}
+	fprintf(out, "\t],\n");
+}
 
-	ms_ticker_destroy(bench->ticker);
-	ms_factory_destroy(bench->factory);
-	return 0;
+static void print_report(FILE *out,
+                         const BenchConfig *cfg,
+                         MSFactory *factory,
+                         RtpProfile *profile,
+                         const BenchStream *streams,
+                         int nb_streams,
+                         double duration_s,
+                         uint64_t allocations,
+                         uint64_t allocated_bytes) {
+	uint64_t packets_sent = 0, packets_received = 0, bytes_sent = 0, bytes_received = 0;
+	int late_events = 0;
+	int i;
+
+	fprintf(out, "{\n");
+	fprintf(out, "\t\"config\": {\n");
+	fprintf(out, "\t\t\"audio_calls\": %d,\n", cfg->nb_audio);
+	fprintf(out, "\t\t\"video_calls\": %d,\n", cfg->nb_video);
+	fprintf(out, "\t\t\"audio_payload\": \"%s\",\n", cfg->audio_payload);
+	fprintf(out, "\t\t\"video_payload\": \"%s\",\n", cfg->video_payload);
+	fprintf(out, "\t\t\"srtp\": \"%s\",\n", cfg->srtp ? cfg->srtp->name : "none");
+	fprintf(out, "\t\t\"bundle\": %s,\n", cfg->bundle ? "true" : "false");
+	fprintf(out, "\t\t\"fec\": %s,\n", cfg->fec ? "true" : "false");
+	fprintf(out, "\t\t\"nack\": %s,\n", cfg->nack ? "true" : "false");
+	fprintf(out, "\t\t\"netsim\": \"%s\",\n",
+	        cfg->netsim_profile ? cfg->netsim_profile : (cfg->netsim.enabled ? "custom" : "none"));
+	fprintf(out, "\t\t\"jitter_ms\": %d,\n", cfg->jitter);
+	fprintf(out, "\t\t\"duration_s\": %.3f\n", duration_s);
+	fprintf(out, "\t},\n");
+
+	fprintf(out, "\t\"streams\": [\n");
+	for (i = 0; i < nb_streams; i++) {
+		const rtp_stats_t *stats = rtp_session_get_stats(streams[i].ms->sessions.rtp_session);
+		packets_sent += stats->packet_sent;
+		packets_received += stats->packet_recv;
+		bytes_sent += stats->sent;
+		bytes_received += stats->recv;
+		late_events += streams[i].late_events;
+		print_stream_report(out, &streams[i], profile, i == nb_streams - 1);
+	}
+	fprintf(out, "\t],\n");
+
+	print_filters_report(out, factory, duration_s);
+
+	fprintf(out, "\t\"totals\": {\n");
+	fprintf(out, "\t\t\"streams\": %d,\n", nb_streams);
+	fprintf(out, "\t\t\"packets_sent\": %llu,\n", (unsigned long long)packets_sent);
+	fprintf(out, "\t\t\"packets_received\": %llu,\n", (unsigned long long)packets_received);
+	fprintf(out, "\t\t\"packets_per_second\": %.1f,\n", (packets_sent + packets_received) / duration_s);
+	fprintf(out, "\t\t\"throughput_mbps\": %.3f,\n", (bytes_sent + bytes_received) * 8.0 / duration_s / 1e6);
+	fprintf(out, "\t\t\"ticker_late_events\": %d,\n", late_events);
+	if (allocations > 0) {
+		fprintf(out, "\t\t\"allocations\": %llu,\n", (unsigned long long)allocations);
+		fprintf(out, "\t\t\"allocations_per_second\": %.1f,\n", allocations / duration_s);
+		fprintf(out, "\t\t\"allocated_bytes_per_second\": %.1f\n", allocated_bytes / duration_s);
+	} else {
+		fprintf(out, "\t\t\"allocations\": null\n");
+	}
+	fprintf(out, "\t}\n");
+	fprintf(out, "}\n");
 }
 
-int main(BCTBX_UNUSED(int argc), BCTBX_UNUSED(char *argv[])) {
-	int pos;
-	int count;
-	ortp_init();
-	ortp_set_log_level_mask(ORTP_LOG_DOMAIN, ORTP_MESSAGE | ORTP_WARNING | ORTP_ERROR | ORTP_FATAL);
+int main(int argc, char *argv[]) {
+	BenchConfig cfg;
+	MSFactory *factory;
+	RtpProfile *profile;
+	MSWebCam *cam = NULL;
+	BenchCall *calls;
+	BenchStream *streams;
+	int nb_calls;
+	int nb_streams = 0;
+	uint64_t begin_ms;
+	uint64_t end_ms;
+	uint64_t allocations = 0;
+	uint64_t allocated_bytes = 0;
+	FILE *out = stdout;
+	int i;
+	int ret = 0;
+#ifdef BENCH_COUNT_ALLOCATIONS
+	BctoolboxMemoryFunctions memory_functions = {bench_malloc, bench_realloc, bench_free};
+
+	/* Must be done before anything is allocated through bctoolbox. */
+	bctbx_set_memory_functions(&memory_functions);
+#endif
+
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.audio_payload = "audio/pcmu/8000";
+	cfg.video_payload = "video/vp8/90000";
+	cfg.duration = 30;
+	cfg.jitter = 60;
+	cfg.netsim.mode = OrtpNetworkSimulatorOutbound;
+	if (!parse_args(argc, argv, &cfg)) {
+		printf("%s", usage);
+		return -1;
+	}
 
-	rtp_profile_set_payload(&av_profile, 115, &payload_type_lpc1015);
-	rtp_profile_set_payload(&av_profile, 110, &payload_type_speex_nb);
-	rtp_profile_set_payload(&av_profile, 111, &payload_type_speex_wb);
-	rtp_profile_set_payload(&av_profile, 112, &payload_type_ilbc);
+	ortp_init();
+	bctbx_set_log_level(NULL, cfg.verbose ? BCTBX_LOG_MESSAGE : BCTBX_LOG_WARNING);
+	bctbx_set_log_level(ORTP_LOG_DOMAIN, cfg.verbose ? BCTBX_LOG_MESSAGE : BCTBX_LOG_WARNING);
+	factory = ms_factory_new_with_voip();
+	ms_factory_enable_statistics(factory, TRUE);
+	profile = create_profile(&cfg);
+	if (cfg.nb_video > 0) cam = get_camera(factory, &cfg);
 
 	signal(SIGINT, stop);
 
-	count = 0;
-	for (pos = 0; cfg[pos].num_session != 0; pos++) {
-		count = count + init_bench(&cfg[pos]);
-		ms_sleep(10);
+	nb_calls = MAX(cfg.nb_audio, cfg.nb_video);
+	calls = ms_new0(BenchCall, nb_calls);
+	streams = ms_new0(BenchStream, nb_calls * 4);
+	for (i = 0; i < nb_calls; i++) {
+		if (!start_call(factory, profile, cam, &cfg, &calls[i], i)) {
+			ret = -1;
+			nb_calls = i + 1;
+			goto end;
+		}
+		add_stream(streams, &nb_streams, calls[i].audio[0] ? &calls[i].audio[0]->ms : NULL, i, "caller");
+		add_stream(streams, &nb_streams, calls[i].audio[1] ? &calls[i].audio[1]->ms : NULL, i, "callee");
+		add_stream(streams, &nb_streams, calls[i].video[0] ? &calls[i].video[0]->ms : NULL, i, "caller");
+		add_stream(streams, &nb_streams, calls[i].video[1] ? &calls[i].video[1]->ms : NULL, i, "callee");
 	}
-
-	ms_message("Number of session started: %i.", count);
-
-	while (run)
-		ms_sleep(1);
-
-	for (pos = 0; cfg[pos].num_session != 0; pos++) {
-		uninit_bench(&cfg[pos]);
+	ms_message("%d calls started, running for %d seconds.", nb_calls, cfg.duration);
+
+	/* Only what happens while the streams are running is measured, not their setup. */
+	ms_factory_reset_statistics(factory);
+#ifdef BENCH_COUNT_ALLOCATIONS
+	allocations = __atomic_load_n(&allocation_count, __ATOMIC_RELAXED);
+	allocated_bytes = __atomic_load_n(&allocation_bytes, __ATOMIC_RELAXED);
+#endif
+	begin_ms = bctbx_get_cur_time_ms();
+	while (run && bctbx_get_cur_time_ms() - begin_ms < (uint64_t)cfg.duration * 1000) {
+		for (i = 0; i < nb_streams; i++) {
+			media_stream_iterate(streams[i].ms);
+			sample_stream(&streams[i]);
+		}
+		ms_usleep(BENCH_ITERATE_INTERVAL_MS * 1000);
+	}
+	end_ms = bctbx_get_cur_time_ms();
+#ifdef BENCH_COUNT_ALLOCATIONS
+	allocations = __atomic_load_n(&allocation_count, __ATOMIC_RELAXED) - allocations;
+	allocated_bytes = __atomic_load_n(&allocation_bytes, __ATOMIC_RELAXED) - allocated_bytes;
+#endif
+
+	if (cfg.output != NULL) {
+		out = fopen(cfg.output, "w");
+		if (out == NULL) {
+			ms_error("Cannot open %s, writing the report on the standard output", cfg.output);
+			out = stdout;
+		}
 	}
+	print_report(out, &cfg, factory, profile, streams, nb_streams, (double)(end_ms - begin_ms) / 1000.0, allocations,
+	             allocated_bytes);
+	if (out != stdout) fclose(out);
 
-	return 0;
+end:
+	for (i = 0; i < nb_calls; i++) {
+		stop_call(&calls[i]);
+	}
+	ms_free(streams);
+	ms_free(calls);
+	rtp_profile_destroy(profile);
+	ms_factory_destroy(factory);
+	return ret;
 }
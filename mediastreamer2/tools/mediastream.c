@@ -1077,6 +1077,7 @@ void setup_media_streams(MediastreamDatas *args) {
 		if (args->enable_zrtp) {
 
 			MSZrtpParams params = {0};
+			params.factory = factory;
 			args->video->ms.sessions.zrtp_context = ms_zrtp_context_new(&(args->video->ms.sessions), &params);
 			video_stream_start_zrtp(args->video);
 		}
@@ -101,6 +101,10 @@ typedef struct rtp_audio_level {
 #define RTP_FRAME_MARKER_END (1 << 6)
 #define RTP_FRAME_MARKER_INDEPENDENT (1 << 5)
 #define RTP_FRAME_MARKER_DISCARDABLE (1 << 4)
+/* Scalable form only (the 4 lowest bits are reserved in the non-scalable form): the frame depends on the base layer
+ * only, and its temporal layer id (TID). */
+#define RTP_FRAME_MARKER_BASE_LAYER_SYNC (1 << 3)
+#define RTP_FRAME_MARKER_TID_MASK 0x07
 
 #define RTP_TIMESTAMP_IS_NEWER_THAN(ts1, ts2) ((uint32_t)((uint32_t)(ts1) - (uint32_t)(ts2)) < ((uint32_t)1 << 31))
 
@@ -176,6 +180,10 @@ ORTP_PUBLIC int rtp_get_mixer_to_client_audio_level(mblk_t *packet, int id, rtp_
 /* Frame marking api */
 ORTP_PUBLIC void rtp_add_frame_marker(mblk_t *packet, int id, uint8_t marker);
 ORTP_PUBLIC int rtp_get_frame_marker(const mblk_t *packet, int id, uint8_t *marker);
+ORTP_PUBLIC void
+rtp_add_scalable_frame_marker(mblk_t *packet, int id, uint8_t marker, uint8_t layer_id, uint8_t tl0picidx);
+ORTP_PUBLIC int rtp_get_scalable_frame_marker(
+    const mblk_t *packet, int id, uint8_t *marker, uint8_t *layer_id, uint8_t *tl0picidx);
 
 #ifdef __cplusplus
 }
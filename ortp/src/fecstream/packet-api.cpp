@@ -19,8 +19,94 @@
  */
 
 #include "packet-api.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ORTP_FEC_XOR_SSE2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ORTP_FEC_XOR_AVX2
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ORTP_FEC_XOR_NEON
+#endif
+
 using namespace ortp;
 
+namespace {
+
+typedef void (*XorFunction)(uint8_t *dst, const uint8_t *src, size_t size);
+
+void xorBytesScalar(uint8_t *dst, const uint8_t *src, size_t size) {
+	size_t i = 0;
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+		uint64_t a, b;
+		memcpy(&a, dst + i, sizeof(uint64_t));
+		memcpy(&b, src + i, sizeof(uint64_t));
+		a ^= b;
+		memcpy(dst + i, &a, sizeof(uint64_t));
+	}
+	for (; i < size; i++) {
+		dst[i] ^= src[i];
+	}
+}
+
+#ifdef ORTP_FEC_XOR_SSE2
+void xorBytesSse2(uint8_t *dst, const uint8_t *src, size_t size) {
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16) {
+		__m128i a = _mm_loadu_si128((const __m128i *)(dst + i));
+		__m128i b = _mm_loadu_si128((const __m128i *)(src + i));
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(a, b));
+	}
+	xorBytesScalar(dst + i, src + i, size - i);
+}
+#endif
+
+#ifdef ORTP_FEC_XOR_AVX2
+__attribute__((target("avx2"))) void xorBytesAvx2(uint8_t *dst, const uint8_t *src, size_t size) {
+	size_t i = 0;
+	for (; i + 32 <= size; i += 32) {
+		__m256i a = _mm256_loadu_si256((const __m256i *)(dst + i));
+		__m256i b = _mm256_loadu_si256((const __m256i *)(src + i));
+		_mm256_storeu_si256((__m256i *)(dst + i), _mm256_xor_si256(a, b));
+	}
+	xorBytesSse2(dst + i, src + i, size - i);
+}
+#endif
+
+#ifdef ORTP_FEC_XOR_NEON
+void xorBytesNeon(uint8_t *dst, const uint8_t *src, size_t size) {
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16) {
+		vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+	}
+	xorBytesScalar(dst + i, src + i, size - i);
+}
+#endif
+
+XorFunction selectXorFunction() {
+#ifdef ORTP_FEC_XOR_AVX2
+	if (__builtin_cpu_supports("avx2")) return xorBytesAvx2;
+#endif
+#if defined(ORTP_FEC_XOR_SSE2)
+	return xorBytesSse2;
+#elif defined(ORTP_FEC_XOR_NEON)
+	return xorBytesNeon;
+#else
+	return xorBytesScalar;
+#endif
+}
+
+/* XOR size bytes of src into dst, with the widest instruction set available on the running CPU. */
+void xorBytes(uint8_t *dst, const uint8_t *src, size_t size) {
+	static const XorFunction xorFunction = selectXorFunction();
+	xorFunction(dst, src, size);
+}
+
+} // namespace
+
 Bitstring::Bitstring() {
 	memset(&mBuffer[0], 0, 8);
 }
@@ -103,11 +189,7 @@ void FecSourcePacket::addPayload(const uint8_t *toAdd, size_t size) {
 	uint8_t *rptr = (uint8_t *)toAdd;
 	size_t currentSize = getPayloadBuffer(&wptr);
 	size_t minSize = (size < currentSize) ? size : currentSize;
-	for (size_t i = 0; i < minSize; i++) {
-		*wptr ^= *rptr;
-		wptr++;
-		rptr++;
-	}
+	xorBytes(wptr, rptr, minSize);
 }
 
 void FecSourcePacket::addPayload(FecSourcePacket const &other) {
@@ -193,6 +275,10 @@ FecRepairPacket::FecRepairPacket(
 	// writeD
 	*(uint8_t *)mPacket->b_wptr = mD;
 	mPacket->b_wptr += sizeof(uint8_t);
+
+	// Reserve room for a full size payload, so that the source payloads are accumulated without reallocation. The
+	// buffer is kept when the packet is reset for the next FEC block.
+	msgpullup(mPacket, msgdsize(mPacket) + UDP_MAX_SIZE);
 }
 
 FecRepairPacket::FecRepairPacket(const mblk_t *repairPacket) {
@@ -269,11 +355,7 @@ void FecRepairPacket::addPayload(FecSourcePacket const &sourcePacket) {
 	}
 	repairPayloadSize = repairPayloadStart(&repair_wptr);
 	size_t minSize = (repairPayloadSize > sourcePayloadSize) ? sourcePayloadSize : repairPayloadSize;
-	for (size_t i = 0; i < minSize; i++) {
-		*repair_wptr ^= *packet_rptr;
-		repair_wptr++;
-		packet_rptr++;
-	}
+	xorBytes(repair_wptr, packet_rptr, minSize);
 }
 
 void FecRepairPacket::add(FecSourcePacket const &sourcePacket) {
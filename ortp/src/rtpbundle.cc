@@ -128,6 +128,7 @@ void RtpBundleCxx::addSession(const std::string &mid, RtpSession *session) {
 		ortp_error("RtpBundle[%p]: Cannot add session (%p) as it is already in the bundle", this, session);
 
 	enterSession(session, mid);
+	publishFastPath();
 
 	if (!mPrimary) {
 		mPrimary = session;
@@ -210,6 +211,8 @@ void RtpBundleCxx::removeSessions(const std::string &mid) {
 			++it;
 		}
 	}
+
+	publishFastPath();
 }
 
 void RtpBundleCxx::removeSession(RtpSession *session) {
@@ -234,6 +237,8 @@ void RtpBundleCxx::removeSession(RtpSession *session) {
 			++it;
 		}
 	}
+
+	publishFastPath();
 }
 
 void RtpBundleCxx::clearSession(RtpSession *session) {
@@ -268,6 +273,8 @@ void RtpBundleCxx::clear() {
 
 	mSsrcToMid.clear();
 	mPrimary = nullptr;
+
+	replaceFastPath(nullptr);
 }
 
 void RtpBundleCxx::sessionModeUpdated(RtpSession *session, RtpSessionMode previousMode) {
@@ -320,6 +327,8 @@ void RtpBundleCxx::sessionModeUpdated(RtpSession *session, RtpSessionMode previo
 			             newMode);
 		}
 	}
+
+	publishFastPath();
 }
 
 RtpSession *RtpBundleCxx::getPrimarySession() const {
@@ -448,13 +457,19 @@ void RtpBundleCxx::checkForSessionSdesCallback(
 	}
 }
 
+std::string_view RtpBundleCxx::getRtpMid(const mblk_t *m) const {
+	uint8_t *data;
+	if (const size_t midSize = rtp_get_extension_header(m, mMidId != -1 ? mMidId : RTP_EXTENSION_MID, &data);
+	    midSize != static_cast<size_t>(-1)) {
+		return {reinterpret_cast<char *>(data), midSize};
+	}
+
+	return {};
+}
+
 std::string RtpBundleCxx::getMid(const mblk_t *m, bool isRtp) {
 	if (isRtp && rtp_get_extbit(m)) {
-		uint8_t *data;
-		if (const size_t midSize = rtp_get_extension_header(m, mMidId != -1 ? mMidId : RTP_EXTENSION_MID, &data);
-		    midSize != static_cast<size_t>(-1)) {
-			return {reinterpret_cast<char *>(data), midSize};
-		}
+		return std::string(getRtpMid(m));
 	} else {
 		if (rtcp_is_SDES(m)) {
 			// The checkForSessionSdesCallback() checks for presence of mid.
@@ -489,14 +504,72 @@ void RtpBundleCxx::updateBundleSession(BundleSession &session, const std::string
 	if (!mid.empty() && mid != session.mid.mid && sequenceNumber > session.mid.sequenceNumber) {
 		session.mid.mid = mid;
 		session.mid.sequenceNumber = sequenceNumber;
+		mFastPathDirty = true;
 		/* reflect the change into the RtpSession's own mid attribute. */
 		rtp_session_set_bundle(session.rtpSession, reinterpret_cast<RtpBundle *>(this), mid.c_str());
 	}
 }
 
+void RtpBundleCxx::publishFastPath() {
+	auto table = std::make_unique<FastPathTable>();
+	table->reserve(mSsrcToSession.size());
+
+	// std::map iterates in key order, the table is thus sorted by SSRC.
+	for (const auto &[ssrc, session] : mSsrcToSession) {
+		table->push_back({ssrc, session.rtpSession, session.mid.mid});
+	}
+
+	replaceFastPath(std::move(table));
+}
+
+void RtpBundleCxx::replaceFastPath(std::unique_ptr<const FastPathTable> table) {
+	mFastPath.store(table.get());
+	if (mCurrentFastPath) mRetiredFastPaths.push_back(std::move(mCurrentFastPath));
+	mCurrentFastPath = std::move(table);
+
+	// A reader counted after this point can only see the new table.
+	if (mFastPathReaders.load() == 0) mRetiredFastPaths.clear();
+	mFastPathDirty = false;
+}
+
+RtpSession *RtpBundleCxx::lookupFastPath(const mblk_t *m) const {
+	RtpSession *session = nullptr;
+
+	mFastPathReaders.fetch_add(1);
+	if (const FastPathTable *table = mFastPath.load(); table != nullptr) {
+		const uint32_t ssrc = rtp_get_ssrc(m);
+		const auto it = std::lower_bound(table->begin(), table->end(), ssrc, [](const FastPathEntry &entry,
+		                                                                        uint32_t value) {
+			return entry.ssrc < value;
+		});
+		if (it != table->end() && it->ssrc == ssrc) {
+			session = it->rtpSession;
+			// A MID that changed or that is learnt for the first time has to be handled by the slow path.
+			if (rtp_get_extbit(m)) {
+				if (const std::string_view mid = getRtpMid(m); !mid.empty() && mid != it->mid) session = nullptr;
+			}
+		}
+	}
+	mFastPathReaders.fetch_sub(1);
+
+	return session;
+}
+
 RtpSession *RtpBundleCxx::checkForSession(const mblk_t *m, bool isRtp, bool isOutgoing) {
+	// Fast path: most of the RTP packets come from an already assigned SSRC and carry the same MID, if any.
+	if (isRtp && rtp_get_version(m) == 2) {
+		if (RtpSession *session = lookupFastPath(m)) return session;
+	}
+
 	const std::lock_guard guard(mAssignmentMutex);
 
+	RtpSession *session = checkForSessionLocked(m, isRtp, isOutgoing);
+	if (mFastPathDirty) publishFastPath();
+
+	return session;
+}
+
+RtpSession *RtpBundleCxx::checkForSessionLocked(const mblk_t *m, bool isRtp, bool isOutgoing) {
 	// STUN packet, return the primary session.
 	if (isRtp && rtp_get_version(m) != 2) {
 		return mPrimary;
@@ -538,6 +611,7 @@ RtpSession *RtpBundleCxx::checkForSession(const mblk_t *m, bool isRtp, bool isOu
 				mSsrcToSession.erase(ssrc);
 				mSsrcToMid.erase(ssrc);
 				bundleSessionIt = mSsrcToSession.end();
+				mFastPathDirty = true;
 			}
 			/* For outgoing stream, we don't care: let's reuse the former RtpSession
 			 * to ensure continuity of sequence numbers.
@@ -586,6 +660,7 @@ RtpSession *RtpBundleCxx::checkForSession(const mblk_t *m, bool isRtp, bool isOu
 					// Assign the session to the incoming ssrc and remove this session from the assignment map.
 					mSsrcToSession.emplace(ssrc, BundleSession{{mid, 0}, session});
 					mWaitingForAssignment.erase(s);
+					mFastPathDirty = true;
 					return session;
 				}
 			}
@@ -640,6 +715,7 @@ RtpSession *RtpBundleCxx::checkForSession(const mblk_t *m, bool isRtp, bool isOu
 			// We do not use addSession as we already know it's ssrc
 			mSsrcToSession.emplace(isOutgoing ? newRtpSession->snd.ssrc : newRtpSession->rcv.ssrc,
 			                       BundleSession{{mid, 0}, newRtpSession});
+			mFastPathDirty = true;
 			if (newRtpSession->bundle == nullptr)
 				rtp_session_set_bundle(newRtpSession, reinterpret_cast<RtpBundle *>(this), mid.c_str());
 		}
@@ -700,16 +776,18 @@ std::optional<mblk_t *> RtpBundleCxx::dispatchRtcpMessage(mblk_t *m) {
 	// In order to avoid unnecessary split between SR and SDES of a same compound packet,
 	// each RTCP element belonging to same stream are aggregated.
 	m_rtcp = rtcp_parser_context_start(&rtcp_parser_ctx);
-	std::map<RtpSession *, mblk_t *> dispatchMap;
+	// A compound packet only has a few elements, a linear search is cheaper than a map.
+	std::vector<std::pair<RtpSession *, mblk_t *>> dispatchMap;
 	do {
 		mblk_t *tmp = dupmsg(const_cast<mblk_t *>(m_rtcp)); // const qualifier discarded intentionally.
 		tmp->b_wptr = tmp->b_rptr + rtcp_get_size(m_rtcp);
 
 		// some RTCP packet can be for multiple streams (e.g. BYE)
 		if (RtpSession *session = checkForSession(tmp, false)) {
-			auto &pendingMsg = dispatchMap[session];
-			if (pendingMsg == nullptr) pendingMsg = tmp;
-			else concatb(pendingMsg, tmp);
+			const auto pending = std::find_if(dispatchMap.begin(), dispatchMap.end(),
+			                                  [session](const auto &entry) { return entry.first == session; });
+			if (pending == dispatchMap.end()) dispatchMap.emplace_back(session, tmp);
+			else concatb(pending->second, tmp);
 		} else {
 			const rtcp_common_header_t *ch = rtcp_get_common_header(tmp);
 			ortp_warning("RtpBundle[%p]: Rctp msg (%d) ssrc=%u does not correspond to any sessions", this,
@@ -21,10 +21,14 @@
 #ifndef RTPBUNDLE_H
 #define RTPBUNDLE_H
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "ortp/rtpsession.h"
 
@@ -68,8 +72,23 @@ private:
 		RtpSession *rtpSession = nullptr;
 	};
 
+	struct FastPathEntry {
+		uint32_t ssrc;
+		RtpSession *rtpSession;
+		std::string mid;
+	};
+
+	// Immutable copy of mSsrcToSession sorted by SSRC.
+	using FastPathTable = std::vector<FastPathEntry>;
+
 	static void checkForSessionSdesCallback(void *, uint32_t, rtcp_sdes_type_t, const char *, uint8_t);
 	std::string getMid(const mblk_t *m, bool isRtp);
+	std::string_view getRtpMid(const mblk_t *m) const;
+
+	RtpSession *lookupFastPath(const mblk_t *m) const;
+	void publishFastPath();
+	void replaceFastPath(std::unique_ptr<const FastPathTable> table);
+	RtpSession *checkForSessionLocked(const mblk_t *m, bool isRtp, bool isOutgoing);
 
 	BundleSession *findReferredSession(const uint32_t referredSsrc);
 
@@ -101,6 +120,16 @@ private:
 
 	std::mutex mAssignmentMutex;
 
+	// Snapshot of the SSRC to session associations read without taking mAssignmentMutex by checkForSession() for RTP
+	// packets whose SSRC is known and MID unchanged. It is replaced (never modified) under mAssignmentMutex each time
+	// mSsrcToSession changes. Replaced tables are retired and only freed once no reader is counted in
+	// mFastPathReaders, so that a lookup started on the previous table can safely finish.
+	std::atomic<const FastPathTable *> mFastPath{nullptr};
+	mutable std::atomic<int> mFastPathReaders{0};
+	std::unique_ptr<const FastPathTable> mCurrentFastPath;
+	std::vector<std::unique_ptr<const FastPathTable>> mRetiredFastPaths;
+	bool mFastPathDirty = false;
+
 	std::string mSdesParseMid;
 	int mMidId = -1;
 };
@@ -32,8 +32,24 @@ void rtp_add_frame_marker(mblk_t *packet, int id, uint8_t marker) {
 	rtp_add_extension_header(packet, id, 1, &marker);
 }
 
+/**
+ * Add the frame marking header extension in its scalable form (3 bytes), which carries the base layer sync bit and the
+ * temporal layer id in the lowest bits of the marker.
+ * See https://datatracker.ietf.org/doc/html/draft-ietf-avtext-framemarking-13
+ * @param packet the RTP packet.
+ * @param id the identifier of the frame marking extension.
+ * @param marker the frame marker to add, including RTP_FRAME_MARKER_BASE_LAYER_SYNC and the TID.
+ * @param layer_id the spatial/quality layer id (LID), 0 for a stream with temporal layers only.
+ * @param tl0picidx the running index of the base temporal layer frames.
+ **/
+void rtp_add_scalable_frame_marker(mblk_t *packet, int id, uint8_t marker, uint8_t layer_id, uint8_t tl0picidx) {
+	uint8_t data[3] = {marker, layer_id, tl0picidx};
+	rtp_add_extension_header(packet, id, sizeof(data), data);
+}
+
 /**
  * Obtain the frame marker through the header extension.
+ * In the non-scalable form, the reserved bits are cleared.
  * See https://datatracker.ietf.org/doc/html/draft-ietf-avtext-framemarking-13
  * @param packet the RTP packet.
  * @param id the identifier of the frame marking extension.
@@ -44,8 +60,34 @@ int rtp_get_frame_marker(const mblk_t *packet, int id, uint8_t *marker) {
 	uint8_t *data;
 
 	int ret = rtp_get_extension_header(packet, id, &data);
-	if (ret != -1) {
-		*marker = *data;
+	if (ret > 0) {
+		*marker = (ret == 1) ? (*data & 0xF0) : *data;
+
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * Obtain the frame marker, the layer id and the TL0PICIDX through the header extension, if it has the scalable form.
+ * See https://datatracker.ietf.org/doc/html/draft-ietf-avtext-framemarking-13
+ * @param packet the RTP packet.
+ * @param id the identifier of the frame marking extension.
+ * @param marker the frame marker to set.
+ * @param layer_id if not NULL, set to the layer id (LID).
+ * @param tl0picidx if not NULL, set to the TL0PICIDX, or 0 if the sender omitted it.
+ * @return 1 if the frame marker is present in its scalable form, 0 otherwise.
+ **/
+int rtp_get_scalable_frame_marker(
+    const mblk_t *packet, int id, uint8_t *marker, uint8_t *layer_id, uint8_t *tl0picidx) {
+	uint8_t *data;
+
+	int ret = rtp_get_extension_header(packet, id, &data);
+	if (ret >= 2) {
+		*marker = data[0];
+		if (layer_id) *layer_id = data[1];
+		if (tl0picidx) *tl0picidx = (ret >= 3) ? data[2] : 0;
 
 		return 1;
 	}
@@ -18,6 +18,11 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include <bctoolbox/defs.h>
 
 #include "ortp/rtpsession.h"
@@ -412,6 +417,127 @@ static void look_out_for_outgoing_session_with_outgoing_callback_set() {
 	if (newSession != nullptr) rtp_session_destroy(newSession);
 }
 
+static void dispatch_throughput() {
+	RtpBundleCxx bundle;
+	const char *mids[] = {"audio", "video", "screenshare"};
+	const int payloadTypes[] = {90, 96, 97};
+	const uint32_t ssrcs[] = {1021991, 18173254, 78986545};
+	const int nbPackets = 1000000;
+
+	// One 5-tuple carrying the audio, video and screenshare of a participant.
+	RtpSession *sessions[3];
+	mblk_t *packets[3];
+	for (int i = 0; i < 3; i++) {
+		sessions[i] = rtp_session_new(RTP_SESSION_SENDRECV);
+		rtp_session_set_payload_type(sessions[i], payloadTypes[i]);
+		bundle.addSession(mids[i], sessions[i]);
+
+		packets[i] = rtp_session_create_packet_header(sessions[i], 0);
+		rtp_set_payload_type(packets[i], payloadTypes[i]);
+		rtp_set_ssrc(packets[i], ssrcs[i]);
+
+		// The first packet assigns the incoming SSRC to the session.
+		BC_ASSERT_PTR_EQUAL(bundle.checkForSession(packets[i], true), sessions[i]);
+	}
+
+	int misrouted = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < nbPackets; i++) {
+		if (bundle.checkForSession(packets[i % 3], true) != sessions[i % 3]) misrouted++;
+	}
+	auto end = std::chrono::steady_clock::now();
+	long elapsedUs = (long)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	ortp_message("Bundle dispatch of %d RTP packets took %li us (%.1f Mpackets/s)", nbPackets, elapsedUs,
+	             elapsedUs > 0 ? (double)nbPackets / (double)elapsedUs : 0.0);
+	BC_ASSERT_EQUAL(misrouted, 0, int, "%d");
+
+	bundle.clear();
+
+	for (int i = 0; i < 3; i++) {
+		freemsg(packets[i]);
+		rtp_session_destroy(sessions[i]);
+	}
+}
+
+static void dispatch_throughput_multithreaded() {
+	RtpBundleCxx bundle;
+	const char *mids[] = {"audio", "video", "screenshare"};
+	const int payloadTypes[] = {90, 96, 97};
+	const uint32_t ssrcs[] = {1021991, 18173254, 78986545};
+	const int nbThreads = 4;
+	const int nbPacketsPerThread = 250000;
+
+	RtpSession *sessions[3];
+	mblk_t *packets[3];
+	for (int i = 0; i < 3; i++) {
+		sessions[i] = rtp_session_new(RTP_SESSION_SENDRECV);
+		rtp_session_set_payload_type(sessions[i], payloadTypes[i]);
+		bundle.addSession(mids[i], sessions[i]);
+
+		packets[i] = rtp_session_create_packet_header(sessions[i], 0);
+		rtp_set_payload_type(packets[i], payloadTypes[i]);
+		rtp_set_ssrc(packets[i], ssrcs[i]);
+
+		BC_ASSERT_PTR_EQUAL(bundle.checkForSession(packets[i], true), sessions[i]);
+	}
+
+	// A session joining and leaving the bundle in a loop, so that the SSRC table is replaced while it is read.
+	RtpSession *joiningSession = rtp_session_new(RTP_SESSION_SENDRECV);
+	rtp_session_set_payload_type(joiningSession, 98);
+	bundle.addSession("data", joiningSession);
+	mblk_t *joiningPacket = rtp_session_create_packet_header(joiningSession, 0);
+	rtp_set_payload_type(joiningPacket, 98);
+	rtp_set_ssrc(joiningPacket, 4568721);
+	bundle.removeSession(joiningSession);
+
+	std::atomic<bool> stop{false};
+	int nbUpdates = 0, joiningMisrouted = 0;
+	std::thread updater([&]() {
+		while (!stop.load()) {
+			bundle.addSession("data", joiningSession);
+			if (bundle.checkForSession(joiningPacket, true) != joiningSession) joiningMisrouted++;
+			bundle.removeSession(joiningSession);
+			nbUpdates++;
+		}
+	});
+
+	std::vector<int> misrouted(nbThreads, 0);
+	std::vector<std::thread> receivers;
+	auto start = std::chrono::steady_clock::now();
+	for (int t = 0; t < nbThreads; t++) {
+		receivers.emplace_back([&, t]() {
+			for (int i = 0; i < nbPacketsPerThread; i++) {
+				if (bundle.checkForSession(packets[i % 3], true) != sessions[i % 3]) misrouted[t]++;
+			}
+		});
+	}
+	for (auto &receiver : receivers)
+		receiver.join();
+	auto end = std::chrono::steady_clock::now();
+	stop = true;
+	updater.join();
+
+	long elapsedUs = (long)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	ortp_message("Bundle dispatch of %d RTP packets from %d threads with %d concurrent updates took %li us (%.1f "
+	             "Mpackets/s)",
+	             nbThreads * nbPacketsPerThread, nbThreads, nbUpdates, elapsedUs,
+	             elapsedUs > 0 ? (double)(nbThreads * nbPacketsPerThread) / (double)elapsedUs : 0.0);
+	for (int t = 0; t < nbThreads; t++) {
+		BC_ASSERT_EQUAL(misrouted[t], 0, int, "%d");
+	}
+	BC_ASSERT_EQUAL(joiningMisrouted, 0, int, "%d");
+	BC_ASSERT_GREATER_STRICT(nbUpdates, 0, int, "%d");
+
+	bundle.clear();
+
+	freemsg(joiningPacket);
+	rtp_session_destroy(joiningSession);
+	for (int i = 0; i < 3; i++) {
+		freemsg(packets[i]);
+		rtp_session_destroy(sessions[i]);
+	}
+}
+
 static test_t tests[] = {
     TEST_NO_TAG("Add sessions", add_sessions),
     TEST_NO_TAG("Primary change", primary_change),
@@ -425,6 +551,8 @@ static test_t tests[] = {
     TEST_NO_TAG("Look for outgoing session", look_out_for_outgoing_session),
     TEST_NO_TAG("Look for outgoing session with outgoing callback set",
                 look_out_for_outgoing_session_with_outgoing_callback_set),
+    TEST_NO_TAG("Dispatch throughput", dispatch_throughput),
+    TEST_NO_TAG("Dispatch throughput from several threads", dispatch_throughput_multithreaded),
 };
 
 test_suite_t bundle_test_suite = {
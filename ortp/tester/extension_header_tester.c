@@ -583,6 +583,37 @@ static void insert_frame_marking_into_packet_with_payload_in_bundled_session(voi
 	insert_frame_marking_into_packet_base(TRUE, bundled_session);
 }
 
+static void insert_scalable_frame_marking_into_packet(void) {
+	int ret;
+	uint8_t result, layer_id, tl0picidx;
+	mblk_t *packet = rtp_session_create_packet_header(session, 0);
+	uint8_t marker = RTP_FRAME_MARKER_START | RTP_FRAME_MARKER_DISCARDABLE | RTP_FRAME_MARKER_BASE_LAYER_SYNC | 2;
+
+	rtp_add_scalable_frame_marker(packet, RTP_EXTENSION_FRAME_MARKING, marker, 0, 42);
+
+	BC_ASSERT_EQUAL(rtp_get_extension_header(packet, RTP_EXTENSION_FRAME_MARKING, NULL), 3, int, "%d");
+	ret = rtp_get_scalable_frame_marker(packet, RTP_EXTENSION_FRAME_MARKING, &result, &layer_id, &tl0picidx);
+	BC_ASSERT_EQUAL(ret, 1, int, "%d");
+	BC_ASSERT_EQUAL(result, marker, uint8_t, "%u");
+	BC_ASSERT_EQUAL(result & RTP_FRAME_MARKER_TID_MASK, 2, int, "%d");
+	BC_ASSERT_EQUAL(layer_id, 0, uint8_t, "%u");
+	BC_ASSERT_EQUAL(tl0picidx, 42, uint8_t, "%u");
+	ret = rtp_get_frame_marker(packet, RTP_EXTENSION_FRAME_MARKING, &result);
+	BC_ASSERT_EQUAL(ret, 1, int, "%d");
+	BC_ASSERT_EQUAL(result, marker, uint8_t, "%u");
+	freemsg(packet);
+
+	/* The non-scalable form carries no layer information, its reserved bits are ignored. */
+	packet = rtp_session_create_packet_header(session, 0);
+	rtp_add_frame_marker(packet, RTP_EXTENSION_FRAME_MARKING, marker);
+	ret = rtp_get_scalable_frame_marker(packet, RTP_EXTENSION_FRAME_MARKING, &result, &layer_id, &tl0picidx);
+	BC_ASSERT_EQUAL(ret, 0, int, "%d");
+	ret = rtp_get_frame_marker(packet, RTP_EXTENSION_FRAME_MARKING, &result);
+	BC_ASSERT_EQUAL(ret, 1, int, "%d");
+	BC_ASSERT_EQUAL(result, RTP_FRAME_MARKER_START | RTP_FRAME_MARKER_DISCARDABLE, uint8_t, "%u");
+	freemsg(packet);
+}
+
 static void padding_test(void) {
 	// packet with the header, ext are 1 : bar1, 2:foo, 3 padding bytes
 	uint8_t ext1[4] = {0x62, 0x61, 0x72, 0x31};       // extension with id 1 is "bar1"
@@ -913,6 +944,7 @@ static test_t tests[] = {
                 insert_frame_marking_into_packet_in_bundled_session),
     TEST_NO_TAG("Insert frame marking into a packet with payload in bundled session",
                 insert_frame_marking_into_packet_with_payload_in_bundled_session),
+    TEST_NO_TAG("Insert scalable frame marking into a packet", insert_scalable_frame_marking_into_packet),
     TEST_NO_TAG("Padding", padding_test),
     TEST_NO_TAG("Remap extension header ids from packet", remap_extension_header_ids_from_packet),
     TEST_NO_TAG("Adding existing extensions into packet", add_existing_extensions_to_packet)};
@@ -2,6 +2,7 @@
 #include "fecstream/fec-stream-stats.h"
 #include "fecstream/fecstream.h"
 #include "ortp_tester.h"
+#include <chrono>
 #include <numeric>
 
 using namespace ortp;
@@ -941,6 +942,62 @@ static void encoder_clear(void) {
 	rtp_session_destroy(session);
 }
 
+static void encoder_throughput_test(void) {
+	RtpSession *session = rtp_session_new(RTP_SESSION_SENDRECV);
+	FecParamsController params(200000);
+	FecEncoder encoder(&params);
+	encoder.init(session, session);
+	const uint8_t L = 5;
+	const uint8_t D = 5;
+	const size_t payloadSize = 1187; // HD video packet, odd size to exercise the tail of the XOR kernels
+	const int nbBlocks = 2000;
+	encoder.update(L, D, true);
+
+	std::vector<std::shared_ptr<FecSourcePacket>> sources;
+	for (int i = 0; i < L * D; i++) {
+		mblk_t *packet = newPacketWithLetter(session, i, 123456, 0, payloadSize + i);
+		uint8_t *payload = NULL;
+		size_t size = rtp_get_payload(packet, &payload);
+		for (size_t j = 0; j < size; j++) {
+			payload[j] = (uint8_t)((i * 31 + j * 7) & 0xff);
+		}
+		sources.push_back(std::make_shared<FecSourcePacket>(packet));
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	for (int block = 0; block < nbBlocks; block++) {
+		encoder.reset(0);
+		for (const auto &source : sources) {
+			encoder.add(*source);
+		}
+	}
+	auto end = std::chrono::steady_clock::now();
+	long elapsedUs = (long)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	// each source packet is added to one row and one column repair packet
+	double protectedBytes = 2.0 * nbBlocks * L * D * payloadSize;
+	ortp_message("FEC 2D encoding of %d blocks of %dx%d packets of %zu bytes took %li us (%.1f MB/s)", nbBlocks, L, D,
+	             payloadSize, elapsedUs, elapsedUs > 0 ? protectedBytes / (double)elapsedUs : 0.0);
+
+	// the repair packets of the last block are the XOR of the source packets they protect
+	for (int row = 0; row < D; row++) {
+		std::vector<uint8_t> expected;
+		for (int col = 0; col < L; col++) {
+			uint8_t *sourcePayload = NULL;
+			size_t sourceSize = sources.at(row * L + col)->getPayloadBuffer(&sourcePayload);
+			if (expected.size() < sourceSize) expected.resize(sourceSize, 0);
+			for (size_t j = 0; j < sourceSize; j++) {
+				expected[j] ^= sourcePayload[j];
+			}
+		}
+		uint8_t *repairPayload = NULL;
+		size_t repairSize = encoder.getRowRepair(row)->repairPayloadStart(&repairPayload);
+		BC_ASSERT_EQUAL(repairSize, expected.size(), size_t, "%zu");
+		BC_ASSERT_TRUE(memcmp(repairPayload, expected.data(), expected.size()) == 0);
+	}
+	sources.clear();
+	rtp_session_destroy(session);
+}
+
 static void overhead_estimation_test(void) {
 	Overhead overhead;
 	BC_ASSERT_EQUAL(overhead.computeOverheadEstimator(), 0., float, "%f");
@@ -1702,6 +1759,7 @@ static test_t tests[] = {
     TEST_NO_TAG("encoder fill", encoder_fill_test),
     TEST_NO_TAG("encoder reset", encoder_reset),
     TEST_NO_TAG("encoder clear", encoder_clear),
+    TEST_NO_TAG("encoder throughput", encoder_throughput_test),
 
     TEST_NO_TAG("overhead estimation", overhead_estimation_test),
 